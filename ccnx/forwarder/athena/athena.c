@@ -68,6 +68,7 @@
 #include <ccnx/forwarder/athena/athena_Control.h>
 #include <ccnx/forwarder/athena/athena_InterestControl.h>
 #include <ccnx/forwarder/athena/athena_LRUContentStore.h>
+#include <ccnx/forwarder/athena/athena_PacketDescriptor.h>
 
 #include <ccnx/common/ccnx_Interest.h>
 #include <ccnx/common/ccnx_InterestReturn.h>
@@ -79,6 +80,9 @@
 
 #include <parc/logging/parc_LogReporterTextStdout.h>
 
+// Milliseconds the forwarder waits for messages between checks on routes being loaded
+#define _AthenaRouteLoadPollTimeout 10
+
 static PARCLog *
 _athena_logger_create(void)
 {
@@ -108,9 +112,67 @@ _removeLink(void *context, PARCBitVector *linkVector)
     parcMemory_Deallocate(&linkVectorString);
 }
 
+static void
+_pitMeasurement(AthenaPIT_MeasurementCallbackContext context, const CCNxInterest *interest,
+                int linkId, bool satisfied, uint64_t responseTime)
+{
+    Athena *athena = (Athena *) context;
+
+    // Feed nexthop performance back to the strategy the interest was forwarded with
+    const CCNxName *ccnxName = ccnxInterest_GetName(interest);
+    if (ccnxName) {
+        AthenaForwardingStrategy *strategy = athenaFIB_GetStrategy(athena->athenaFIB, ccnxName);
+        if (satisfied) {
+            athenaForwardingStrategy_InterestSatisfied(strategy, ccnxName, linkId, responseTime);
+        } else {
+            athenaForwardingStrategy_InterestFailed(strategy, ccnxName, linkId);
+        }
+    }
+}
+
+static void _returnInterest(Athena *athena, CCNxInterest *interest, PARCBitVector *ingressVector,
+                            CCNxInterestReturn_ReturnCode returnCode, const char *returnCodeName);
+
+static void
+_pitEviction(AthenaPIT_EvictionCallbackContext context, CCNxInterest *interest, PARCBitVector *ingressVector)
+{
+    Athena *athena = (Athena *) context;
+
+    // The evicted interest may still be queued on a link that isn't accepting sends, so it's returned
+    // from a copy of its wire format rather than converted in place
+    PARCBuffer *wireFormatBuffer = athenaTransportLinkModule_CreateMessageBuffer(interest);
+    PARCBuffer *wireFormatCopy = parcBuffer_Copy(wireFormatBuffer);
+    parcBuffer_Release(&wireFormatBuffer);
+    parcBuffer_SetPosition(wireFormatCopy, 0);
+    CCNxMetaMessage *returnedInterest = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatCopy);
+    parcBuffer_Release(&wireFormatCopy);
+    if ((returnedInterest == NULL) || !athenaTransportLinkModule_DecodeMessage(returnedInterest)) {
+        parcLog_Error(athena->log, "Unable to copy an evicted Interest to return it as InterestReturn (code: Congestion).");
+        if (returnedInterest) {
+            ccnxMetaMessage_Release(&returnedInterest);
+        }
+        return;
+    }
+
+    // The PIT dropped the interest to make room for another, tell its senders to back off
+    _returnInterest(athena, returnedInterest, ingressVector, CCNxInterestReturn_ReturnCode_Congestion, "Congestion");
+    ccnxMetaMessage_Release(&returnedInterest);
+}
+
+static bool
+_releaseShapedInterest(AthenaTransportLinkAdapter_ReleaseInterestCallbackContext context, const CCNxInterest *interest,
+                       const PARCBitVector *egressVector)
+{
+    Athena *athena = (Athena *) context;
+
+    // Only send a held interest that is still pending, its response time is measured from now
+    return athenaPIT_InterestSent(athena->athenaPIT, interest, egressVector);
+}
+
 static void
 _athenaDestroy(Athena **athena)
 {
+    athenaInterestControl_CancelRouteLoad(*athena);
     ccnxName_Release(&((*athena)->athenaName));
     athenaTransportLinkAdapter_Destroy(&((*athena)->athenaTransportLinkAdapter));
     athenaContentStore_Release(&((*athena)->athenaContentStore));
@@ -137,6 +199,9 @@ athena_Create(size_t contentStoreSizeInMB)
 
     athena->athenaPIT = athenaPIT_Create();
     assertNotNull(athena->athenaPIT, "Failed to create PIT");
+    athenaPIT_SetMeasurementCallback(athena->athenaPIT, _pitMeasurement, athena);
+    athenaPIT_SetEvictionCallback(athena->athenaPIT, _pitEviction, athena);
+    athenaPIT_SetLinkQuotaExemptPrefix(athena->athenaPIT, athena->athenaName);
 
     AthenaLRUContentStoreConfig storeConfig;
     storeConfig.capacityInMB = contentStoreSizeInMB;
@@ -146,6 +211,7 @@ athena_Create(size_t contentStoreSizeInMB)
 
     athena->athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, athena);
     assertNotNull(athena->athenaTransportLinkAdapter, "Failed to create Transport Link Adapter");
+    athenaTransportLinkAdapter_SetReleaseInterestCallback(athena->athenaTransportLinkAdapter, _releaseShapedInterest, athena);
 
     athena->log = _athena_logger_create();
     athena->athenaState = Athena_Running;
@@ -175,6 +241,33 @@ _processControl(Athena *athena, CCNxControl *control, PARCBitVector *ingressVect
     athenaControl(athena, control, ingressVector);
 }
 
+//
+// Send an Interest back to where it came from as an InterestReturn with the given code.
+// NOTE: The Interest is modified in-place, it is an InterestReturn afterwards.
+//
+static void
+_returnInterest(Athena *athena, CCNxInterest *interest, PARCBitVector *ingressVector,
+                CCNxInterestReturn_ReturnCode returnCode, const char *returnCodeName)
+{
+    CCNxName *ccnxName = ccnxInterest_GetName(interest);
+    if (ccnxWireFormatMessage_ConvertInterestToInterestReturn(interest, returnCode)) {
+        parcLog_Debug(athena->log, "Returning Interest as InterestReturn (code: %s)", returnCodeName);
+        PARCBitVector *failedLinks = athenaTransportLinkAdapter_Send(athena->athenaTransportLinkAdapter, interest,
+                                                                     ingressVector);
+        if (failedLinks != NULL) {
+            parcBitVector_Release(&failedLinks);
+        }
+    } else {
+        if (ccnxName) {
+            const char *name = ccnxName_ToString(ccnxName);
+            parcLog_Error(athena->log, "Unable to return Interest (%s) as InterestReturn (code: %s).", name, returnCodeName);
+            parcMemory_Deallocate(&name);
+        } else {
+            parcLog_Error(athena->log, "Unable to return Interest () as InterestReturn (code: %s).", returnCodeName);
+        }
+    }
+}
+
 static void
 _processInterest(Athena *athena, CCNxInterest *interest, PARCBitVector *ingressVector)
 {
@@ -193,7 +286,8 @@ _processInterest(Athena *athena, CCNxInterest *interest, PARCBitVector *ingressV
                           athenaTransportLinkAdapter_LinkIdToName(athena->athenaTransportLinkAdapter, linkId));
             return;
         }
-        ccnxInterest_SetHopLimit(interest, hoplimit - 1);
+        // Patched in the received bytes too, which are forwarded without being encoded again
+        athenaTransportLinkModule_SetMessageHopLimit(interest, hoplimit - 1);
     }
 
     //
@@ -215,12 +309,16 @@ _processInterest(Athena *athena, CCNxInterest *interest, PARCBitVector *ingressV
     //
     // *   (2) add it to the PIT, if it was aggregated or there was an error we're done, otherwise we
     //         forward the interest.  The expectedReturnVector is populated with information we get from
-    //         the FIB and used to verify content objects ingress ports when they arrive.
+    //         the FIB and used to verify content objects ingress ports when they arrive.  If the PIT is
+    //         full, or the link it arrived on has its quota of entries pending, the interest is returned so
+    //         its sender backs off rather than waiting for it to time out.
     //
     PARCBitVector *expectedReturnVector;
     AthenaPITResolution result;
     if ((result = athenaPIT_AddInterest(athena->athenaPIT, interest, ingressVector, &expectedReturnVector)) != AthenaPITResolution_Forward) {
-        if (result == AthenaPITResolution_Error) {
+        if (result == AthenaPITResolution_Congested) {
+            _returnInterest(athena, interest, ingressVector, CCNxInterestReturn_ReturnCode_Congestion, "Congestion");
+        } else if (result == AthenaPITResolution_Error) {
             parcLog_Error(athena->log, "PIT resolution error");
         }
         return;
@@ -240,61 +338,57 @@ _processInterest(Athena *athena, CCNxInterest *interest, PARCBitVector *ingressV
     //         non-local interface so we need not check that here.
     //
     ccnxName = ccnxInterest_GetName(interest);
-    PARCBitVector *egressVector = athenaFIB_Lookup(athena->athenaFIB, ccnxName, ingressVector);
+    AthenaNexthopList *nexthops = athenaFIB_LookupNexthops(athena->athenaFIB, ccnxName, ingressVector);
+
+    if (nexthops != NULL) {
+        // Let the strategy bound to the name choose which of the nexthops we actually use.
+        PARCBitVector *egressVector;
+        if (athenaNexthopList_Size(nexthops) > 1) {
+            AthenaForwardingStrategy *strategy = athenaFIB_GetStrategy(athena->athenaFIB, ccnxName);
+            egressVector = athenaForwardingStrategy_SelectEgress(strategy, interest, nexthops);
+        } else {
+            egressVector = parcBitVector_Copy(athenaNexthopList_GetVector(nexthops));
+        }
+        athenaNexthopList_Release(&nexthops);
 
-    if (egressVector != NULL) {
         // If no links are in the egress vector the FIB returned, return a no route interest message
         if (parcBitVector_NumberOfBitsSet(egressVector) == 0) {
-            if (ccnxWireFormatMessage_ConvertInterestToInterestReturn(interest,
-                                                                      CCNxInterestReturn_ReturnCode_NoRoute)) {
-                // NOTE: The Interest has been modified in-place. It is now an InterestReturn.
-                parcLog_Debug(athena->log, "Returning Interest as InterestReturn (code: NoRoute)");
-                PARCBitVector *failedLinks = athenaTransportLinkAdapter_Send(athena->athenaTransportLinkAdapter,
-                                                                             interest, ingressVector);
-                if (failedLinks != NULL) {
-                    parcBitVector_Release(&failedLinks);
-                }
-            } else {
-                if (ccnxName) {
-                    const char *name = ccnxName_ToString(ccnxName);
-                    parcLog_Error(athena->log, "Unable to return Interest (%s) as InterestReturn (code: NoRoute).", name);
-                    parcMemory_Deallocate(&name);
-                } else {
-                    parcLog_Error(athena->log, "Unable to return Interest () as InterestReturn (code: NoRoute).");
-                }
-            }
+            _returnInterest(athena, interest, ingressVector, CCNxInterestReturn_ReturnCode_NoRoute, "NoRoute");
         } else {
+            // Pace the interest to the capacity its content objects have to return over.  The link adapter
+            // sends it later on links that are holding it, links without the capacity to spare refuse it.
+            size_t egressCount = parcBitVector_NumberOfBitsSet(egressVector);
             parcBitVector_SetVector(expectedReturnVector, egressVector);
-            PARCBitVector *failedLinks =
-                athenaTransportLinkAdapter_Send(athena->athenaTransportLinkAdapter, interest, egressVector);
+            PARCBitVector *congestedLinks =
+                athenaTransportLinkAdapter_ShapeInterest(athena->athenaTransportLinkAdapter, interest, egressVector);
+            size_t congestedCount = 0;
+            if (congestedLinks) {
+                congestedCount = parcBitVector_NumberOfBitsSet(congestedLinks);
+                parcBitVector_ClearVector(expectedReturnVector, congestedLinks);
+                parcBitVector_Release(&congestedLinks);
+            }
 
-            if (failedLinks) { // remove failed channels - client will resend interest unless we wish to optimize here
-                parcBitVector_ClearVector(expectedReturnVector, failedLinks);
-                parcBitVector_Release(&failedLinks);
+            if (congestedCount == egressCount) {
+                // Every link refused it, tell the sender to back off and remove the entry from the PIT.
+                _returnInterest(athena, interest, ingressVector, CCNxInterestReturn_ReturnCode_Congestion, "Congestion");
+                if (athenaPIT_RemoveInterest(athena->athenaPIT, interest, ingressVector) != true) {
+                    parcLog_Error(athena->log, "Unable to remove congested interest from the PIT.");
+                }
+            } else if (parcBitVector_NumberOfBitsSet(egressVector) > 0) {
+                PARCBitVector *failedLinks =
+                    athenaTransportLinkAdapter_Send(athena->athenaTransportLinkAdapter, interest, egressVector);
+
+                if (failedLinks) { // remove failed channels - client will resend interest unless we wish to optimize here
+                    parcBitVector_ClearVector(expectedReturnVector, failedLinks);
+                    parcBitVector_Release(&failedLinks);
+                }
             }
         }
         parcBitVector_Release(&egressVector);
     } else {
         // No FIB entry found, return a NoRoute interest return and remove the entry from the PIT.
 
-        if (ccnxWireFormatMessage_ConvertInterestToInterestReturn(interest,
-                                                                  CCNxInterestReturn_ReturnCode_NoRoute)) {
-            // NOTE: The Interest has been modified in-place. It is now an InterestReturn.
-            parcLog_Debug(athena->log, "Returning Interest as InterestReturn (code: NoRoute)");
-            PARCBitVector *failedLinks = athenaTransportLinkAdapter_Send(athena->athenaTransportLinkAdapter, interest,
-                                                                         ingressVector);
-            if (failedLinks != NULL) {
-                parcBitVector_Release(&failedLinks);
-            }
-        } else {
-            if (ccnxName) {
-                const char *name = ccnxName_ToString(ccnxName);
-                parcLog_Error(athena->log, "Unable to return Interest (%s) as InterestReturn (code: NoRoute).", name);
-                parcMemory_Deallocate(&name);
-            } else {
-                parcLog_Error(athena->log, "Unable to return Interest () as InterestReturn (code: NoRoute).");
-            }
-        }
+        _returnInterest(athena, interest, ingressVector, CCNxInterestReturn_ReturnCode_NoRoute, "NoRoute");
 
         if (athenaPIT_RemoveInterest(athena->athenaPIT, interest, ingressVector) != true) {
             if (ccnxName) {
@@ -318,11 +412,97 @@ _processInterest(Athena *athena, CCNxInterest *interest, PARCBitVector *ingressV
 static void
 _processInterestReturn(Athena *athena, CCNxInterestReturn *interestReturn, PARCBitVector *ingressVector)
 {
-    // We can ignore interest return messages and allow the PIT entry to timeout, or
     //
-    // Verify the return came from the next-hop where the interest was originally sent to
-    // if not, ignore
-    // otherwise, may try another forwarding path or clear the PIT state and forward the interest return on the reverse path
+    // *   (1) Verify the return came from a link the interest was originally sent to, if not, drop it
+    //
+    CCNxInterest *pendingInterest;
+    PARCBitVector *expectedReturnVector;
+    PARCBitVector *attemptedVector;
+    PARCBitVector *downstreamVector = athenaPIT_ReturnInterest(athena->athenaPIT, interestReturn, ingressVector,
+                                                               &pendingInterest, &expectedReturnVector,
+                                                               &attemptedVector);
+    if (downstreamVector == NULL) {
+        parcLog_Debug(athena->log, "InterestReturn did not match a pending interest on its ingress link. Message dropped.");
+        return;
+    }
+
+    parcLog_Debug(athena->log, "InterestReturn received (code: %d)", ccnxInterestReturn_GetReturnCode(interestReturn));
+
+    // Let the strategy know the link couldn't satisfy the interest
+    CCNxName *ccnxName = ccnxInterest_GetName(pendingInterest);
+    if (ccnxName) {
+        AthenaForwardingStrategy *strategy = athenaFIB_GetStrategy(athena->athenaFIB, ccnxName);
+        athenaForwardingStrategy_InterestFailed(strategy, ccnxName, parcBitVector_NextBitSet(ingressVector, 0));
+    }
+
+    //
+    // *   (2) If the interest is still outstanding on other links, wait for them to respond.
+    //         Otherwise, try the next FIB nexthop the interest hasn't been forwarded to yet.
+    //
+    if (parcBitVector_NumberOfBitsSet(expectedReturnVector) == 0) {
+        AthenaNexthopList *nexthops = NULL;
+        if (ccnxName) {
+            nexthops = athenaFIB_LookupNexthops(athena->athenaFIB, ccnxName, NULL);
+        }
+
+        if (nexthops != NULL) {
+            // Nexthops are tried in ascending cost order
+            for (size_t i = 0; (i < athenaNexthopList_Size(nexthops)) &&
+                 (parcBitVector_NumberOfBitsSet(expectedReturnVector) == 0); i++) {
+                int nextHop = athenaNexthopList_GetLinkId(nexthops, i);
+                if ((parcBitVector_Get(attemptedVector, nextHop) == 1) || (parcBitVector_Get(downstreamVector, nextHop) == 1)) {
+                    continue;
+                }
+                PARCBitVector *retryVector = parcBitVector_Create();
+                parcBitVector_Set(retryVector, nextHop);
+
+                parcLog_Debug(athena->log, "Retrying interest on %s",
+                              athenaTransportLinkAdapter_LinkIdToName(athena->athenaTransportLinkAdapter, nextHop));
+
+                // Retries are paced like any other forwarded interest.  A link that holds it sends it later,
+                // a link without the capacity to spare is passed over for the next nexthop.
+                PARCBitVector *congestedLinks =
+                    athenaTransportLinkAdapter_ShapeInterest(athena->athenaTransportLinkAdapter, pendingInterest, retryVector);
+                if (congestedLinks) {
+                    parcBitVector_Release(&congestedLinks);
+                } else if (parcBitVector_NumberOfBitsSet(retryVector) == 0) {
+                    parcBitVector_Set(expectedReturnVector, nextHop);
+                } else {
+                    PARCBitVector *failedLinks =
+                        athenaTransportLinkAdapter_Send(athena->athenaTransportLinkAdapter, pendingInterest, retryVector);
+                    if (failedLinks) {
+                        parcBitVector_Release(&failedLinks);
+                    } else {
+                        parcBitVector_SetVector(expectedReturnVector, retryVector);
+                        athenaPIT_InterestSent(athena->athenaPIT, pendingInterest, retryVector);
+                    }
+                }
+                parcBitVector_Release(&retryVector);
+            }
+            athenaNexthopList_Release(&nexthops);
+        }
+
+        //
+        // *   (3) All nexthops have been exhausted, return the InterestReturn on the reverse path
+        //         and clear the PIT state.
+        //
+        if (parcBitVector_NumberOfBitsSet(expectedReturnVector) == 0) {
+            const char *downstreamVectorString = parcBitVector_ToString(downstreamVector);
+            parcLog_Debug(athena->log, "InterestReturn forwarded to %s.", downstreamVectorString);
+            parcMemory_Deallocate(&downstreamVectorString);
+
+            PARCBitVector *failedLinks =
+                athenaTransportLinkAdapter_Send(athena->athenaTransportLinkAdapter, interestReturn, downstreamVector);
+            if (failedLinks) {
+                parcBitVector_Release(&failedLinks);
+            }
+            athenaPIT_RemoveInterest(athena->athenaPIT, pendingInterest, downstreamVector);
+        }
+    }
+
+    ccnxInterest_Release(&pendingInterest);
+    parcBitVector_Release(&attemptedVector);
+    parcBitVector_Release(&downstreamVector);
 }
 
 static PARCBuffer *
@@ -460,6 +640,55 @@ athena_ProcessMessage(Athena *athena, CCNxMetaMessage *ccnxMessage, PARCBitVecto
     }
 }
 
+// Decide from the wire format whether a received message can be dropped without decoding it
+static bool
+_dropUndecoded(Athena *athena, const AthenaPacketDescriptor *descriptor, PARCBitVector *ingressVector)
+{
+    if (descriptor->packetType == AthenaPacketDescriptor_PacketType_Interest) {
+        int linkId = parcBitVector_NextBitSet(ingressVector, 0);
+        if ((descriptor->hopLimit == 0) && athenaTransportLinkAdapter_IsNotLocal(athena->athenaTransportLinkAdapter, linkId)) {
+            parcLog_Error(athena->log,
+                          "Received a message with a hoplimit of zero from a non-local source (%s).",
+                          athenaTransportLinkAdapter_LinkIdToName(athena->athenaTransportLinkAdapter, linkId));
+            return true;
+        }
+    } else if (descriptor->packetType == AthenaPacketDescriptor_PacketType_ContentObject) {
+        // Nameless objects are matched on their hash, which needs the decoded message
+        if (athenaPacketDescriptor_HasName(descriptor) &&
+            (athenaPIT_MayMatchName(athena->athenaPIT, descriptor->name, descriptor->nameLength) == false)) {
+            parcLog_Debug(athena->log, "Dropping Content Object with no pending Interest.");
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+athena_ProcessWireFormatMessage(Athena *athena, CCNxMetaMessage *ccnxMessage, PARCBitVector *ingressVector)
+{
+    AthenaPacketDescriptor descriptor;
+    PARCBuffer *wireFormatBuffer = ccnxWireFormatMessage_GetWireFormatBuffer(ccnxMessage);
+
+    if (athenaPacketDescriptor_Parse(&descriptor, wireFormatBuffer)) {
+        if (descriptor.packetType == AthenaPacketDescriptor_PacketType_ContentObject) {
+            athenaTransportLinkAdapter_ContentObjectReceived(athena->athenaTransportLinkAdapter, ingressVector,
+                                                             descriptor.packetLength);
+        }
+        if (_dropUndecoded(athena, &descriptor, ingressVector)) {
+            athena->stats.numDroppedUndecoded++;
+            return;
+        }
+    }
+
+    if (athenaTransportLinkModule_DecodeMessage(ccnxMessage) == false) {
+        parcLog_Error(athena->log, "Failed to decode message received from %s.",
+                      athenaTransportLinkAdapter_LinkIdToName(athena->athenaTransportLinkAdapter,
+                                                              parcBitVector_NextBitSet(ingressVector, 0)));
+        return;
+    }
+    athena_ProcessMessage(athena, ccnxMessage, ingressVector);
+}
+
 void
 athena_EncodeMessage(CCNxMetaMessage *message)
 {
@@ -481,10 +710,13 @@ athena_ForwarderEngine(void *arg)
             CCNxMetaMessage *ccnxMessage;
             PARCBitVector *ingressVector;
             int receiveTimeout = -1; // block until message received
-            ccnxMessage = athenaTransportLinkAdapter_Receive(athena->athenaTransportLinkAdapter,
-                                                             &ingressVector, receiveTimeout);
+            if (athenaInterestControl_SwapLoadedRoutes(athena)) {
+                receiveTimeout = _AthenaRouteLoadPollTimeout; // check back on the routes being loaded
+            }
+            ccnxMessage = athenaTransportLinkAdapter_ReceiveWireFormat(athena->athenaTransportLinkAdapter,
+                                                                       &ingressVector, receiveTimeout);
             if (ccnxMessage) {
-                athena_ProcessMessage(athena, ccnxMessage, ingressVector);
+                athena_ProcessWireFormatMessage(athena, ccnxMessage, ingressVector);
 
                 parcBitVector_Release(&ingressVector);
                 ccnxMetaMessage_Release(&ccnxMessage);
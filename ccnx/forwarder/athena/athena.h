@@ -69,8 +69,10 @@
 #include <ccnx/forwarder/athena/athena_ContentStore.h>
 #include <ccnx/forwarder/athena/athena_PIT.h>
 #include <ccnx/forwarder/athena/athena_FIB.h>
+#include <ccnx/forwarder/athena/athena_ForwardingStrategies.h>
 
 #define AthenaDefaultConnectionURI "tcp://localhost:9695/Listener"
+#define AthenaDefaultLocalConnectionURI "unix://athena/listener"
 #define AthenaDefaultContentStoreSize 0
 #define AthenaDefaultListenerPort 9695
 
@@ -83,6 +85,13 @@ typedef enum {
     Athena_Running = 0x01
 } AthenaState;
 
+/**
+ * @typedef AthenaRouteLoad
+ * @brief routes from a load command being built off the forwarder thread
+ */
+struct athena_route_load;
+typedef struct athena_route_load AthenaRouteLoad;
+
 /**
  * @typedef Athena∫
  * @brief private data for Athena daemon
@@ -96,6 +105,8 @@ typedef struct Athena {
     AthenaContentStore *athenaContentStore;
     PARCLog *log;
     PARCOutputStream *configurationLog;
+    AthenaRouteLoad *routeLoad; // routes being loaded, NULL if none
+    AthenaBuiltInStrategyConfig strategyConfig; // clock and random source of the strategies bound by name
 
     struct {
         uint64_t numProcessedInterests;
@@ -103,6 +114,7 @@ typedef struct Athena {
         uint64_t numProcessedInterestReturns;
         uint64_t numProcessedControlMessages;
         uint64_t numProcessedManifests;
+        uint64_t numDroppedUndecoded; // turned away on their wire format, without being decoded
     } stats;
 } Athena;
 
@@ -130,6 +142,12 @@ typedef struct Athena {
 #define AthenaCommand_Quit   "quit"
 #define AthenaCommand_Run    "spawn"
 #define AthenaCommand_Stats  "stats"
+#define AthenaCommand_Strategy "strategy"
+#define AthenaCommand_Load   "load"
+#define AthenaCommand_Queue  "queue"
+#define AthenaCommand_Shape  "shape"
+#define AthenaCommand_Overflow "overflow"
+#define AthenaCommand_Quota  "quota"
 
 #define AthenaCommand_LogLevel  "level"
 #define AthenaCommand_LogDebug  "debug"
@@ -143,12 +161,18 @@ typedef struct Athena {
 #define CCNxNameAthenaCommand_LinkConnect        CCNxNameAthena_Link "/" AthenaCommand_Add    // create a connection to interface specified in payload, returns name
 #define CCNxNameAthenaCommand_LinkDisconnect     CCNxNameAthena_Link "/" AthenaCommand_Remove // remove a connection to interface specified in payload, by name
 #define CCNxNameAthenaCommand_LinkList           CCNxNameAthena_Link "/" AthenaCommand_List   // list interfaces
+#define CCNxNameAthenaCommand_LinkQueue          CCNxNameAthena_Link "/" AthenaCommand_Queue  // set the weight and queue limit of a link egress class
+#define CCNxNameAthenaCommand_LinkShape          CCNxNameAthena_Link "/" AthenaCommand_Shape  // set the bandwidth Interests sent on a link are paced to
 #define CCNxNameAthenaCommand_FIBLookup          CCNxNameAthena_FIB "/" AthenaCommand_Lookup                  // return current FIB contents for name in payload
 #define CCNxNameAthenaCommand_FIBList            CCNxNameAthena_FIB "/" AthenaCommand_List                    // list current FIB contents
 #define CCNxNameAthenaCommand_FIBAddRoute        CCNxNameAthena_FIB "/" AthenaCommand_Add                     // add route for arguments in payload
 #define CCNxNameAthenaCommand_FIBRemoveRoute     CCNxNameAthena_FIB "/" AthenaCommand_Remove                  // remove route for arguments in payload
+#define CCNxNameAthenaCommand_FIBSetStrategy     CCNxNameAthena_FIB "/" AthenaCommand_Strategy                // bind forwarding strategy for arguments in payload
+#define CCNxNameAthenaCommand_FIBLoad            CCNxNameAthena_FIB "/" AthenaCommand_Load                    // replace all routes with the routes in payload
 #define CCNxNameAthenaCommand_PITLookup          CCNxNameAthena_PIT "/" AthenaCommand_Lookup                  // return current PIT contents for name in payload
 #define CCNxNameAthenaCommand_PITList            CCNxNameAthena_PIT "/" AthenaCommand_List                    // list current PIT contents
+#define CCNxNameAthenaCommand_PITOverflow        CCNxNameAthena_PIT "/" AthenaCommand_Overflow                // set how the PIT handles new interests when it's full
+#define CCNxNameAthenaCommand_PITQuota           CCNxNameAthena_PIT "/" AthenaCommand_Quota                   // limit the PIT entries each ingress link may have pending
 #define CCNxNameAthenaCommand_ContentStoreResize CCNxNameAthena_ContentStore "/" AthenaCommand_Resize         // resize current content store to size in MB in payload
 #define CCNxNameAthenaCommand_Quit               CCNxNameAthena_Control "/" AthenaCommand_Quit                // ask the forwarder to exit
 #define CCNxNameAthenaCommand_Run                CCNxNameAthena_Control "/" AthenaCommand_Run                 // start a new forwarder instance
@@ -236,6 +260,34 @@ void athena_Release(Athena **athena);
  */
 void athena_ProcessMessage(Athena *athena, CCNxMetaMessage *ccnxMessage, PARCBitVector *ingressVector);
 
+/**
+ * @abstract process a CCNx message that hasn't been decoded yet
+ * @discussion
+ *
+ * Interests arriving on a non-local link with a hop limit of zero, and Content Objects no PIT entry
+ * can match by name, are dropped from their wire format.  Anything else is decoded and handed to
+ * athena_ProcessMessage.
+ *
+ * @param [in] athena forwarder context
+ * @param [in] ccnxMessage message as returned by athenaTransportLinkAdapter_ReceiveWireFormat
+ * @param [in] ingressVector link message was received from
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBitVector *ingressVector;
+ *     CCNxMetaMessage *ccnxMessage =
+ *         athenaTransportLinkAdapter_ReceiveWireFormat(athena->athenaTransportLinkAdapter, &ingressVector, -1);
+ *
+ *     athena_ProcessWireFormatMessage(athena, ccnxMessage, ingressVector);
+ *
+ *     ccnxMetaMessage_Release(&ccnxMessage);
+ *     parcBitVector_Release(&ingressVector);
+ * }
+ * @endcode
+ */
+void athena_ProcessWireFormatMessage(Athena *athena, CCNxMetaMessage *ccnxMessage, PARCBitVector *ingressVector);
+
 /**
  * @abstract encode message into wire format
  * @discussion
@@ -109,9 +109,12 @@ athenaControl(Athena *athena, CCNxControl *control, PARCBitVector *ingressVector
             char *prefixString = ccnxName_ToString(prefix);
             unsigned interface = parcBitVector_NextBitSet(egressVector, 0);
             if (operation == CPI_REGISTER_PREFIX) {
-                parcLog_Debug(athena->log, "Adding %s route to interface %d",
-                              prefixString, interface);
-                commandResult = athenaFIB_AddRoute(athena->athenaFIB, prefix, egressVector);
+                // CPI routes carry a cost but no weight, equal cost routes share load evenly
+                unsigned cost = cpiRouteEntry_GetCost(cpiRouteEntry);
+                parcLog_Debug(athena->log, "Adding %s route to interface %d (cost %u)",
+                              prefixString, interface, cost);
+                commandResult = athenaFIB_AddRouteWithCost(athena->athenaFIB, prefix, egressVector,
+                                                           cost, AthenaNexthop_DefaultWeight);
                 if (!commandResult) {
                     parcLog_Warning(athena->log, "Unable to add route %s to interface %d",
                                     prefixString, interface);
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <strings.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena_EgressScheduler.h>
+
+typedef struct athena_egress_entry {
+    CCNxMetaMessage *message;
+    size_t length;
+} _AthenaEgressEntry;
+
+/**
+ * @typedef _AthenaEgressQueue
+ * @brief Ring of queued messages for one class, grown on demand up to its limit
+ */
+typedef struct athena_egress_queue {
+    _AthenaEgressEntry *entry;
+    size_t head;
+    size_t count;
+    size_t capacity;
+    size_t queueLimit;
+    size_t weight;
+    size_t deficit; // bytes of credit carried between rounds
+    struct {
+        size_t sent;
+        size_t dropped;
+    } stats;
+} _AthenaEgressQueue;
+
+/**
+ * @typedef AthenaEgressScheduler
+ * @brief Class queues and the round robin position
+ */
+struct athena_egress_scheduler {
+    _AthenaEgressQueue queue[AthenaEgressClass_Count];
+    size_t depth;
+    AthenaEgressClass current; // class being serviced
+    bool credited;             // whether the current class has been credited this round
+};
+
+static const char *_athenaEgressClassNames[AthenaEgressClass_Count] = {
+    [AthenaEgressClass_Control] = "control",
+    [AthenaEgressClass_Interest] = "interest",
+    [AthenaEgressClass_InterestReturn] = "interestReturn",
+    [AthenaEgressClass_ContentObject] = "contentObject",
+};
+
+static void
+_athenaEgressScheduler_Finalize(AthenaEgressScheduler **schedulerPtr)
+{
+    AthenaEgressScheduler *scheduler = *schedulerPtr;
+    for (int i = 0; i < AthenaEgressClass_Count; i++) {
+        _AthenaEgressQueue *queue = &scheduler->queue[i];
+        for (size_t n = 0; n < queue->count; n++) {
+            ccnxMetaMessage_Release(&queue->entry[(queue->head + n) % queue->capacity].message);
+        }
+        if (queue->entry != NULL) {
+            parcMemory_Deallocate(&queue->entry);
+        }
+    }
+}
+
+parcObject_ExtendPARCObject(AthenaEgressScheduler, _athenaEgressScheduler_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementRelease(athenaEgressScheduler, AthenaEgressScheduler);
+
+AthenaEgressScheduler *
+athenaEgressScheduler_Create(void)
+{
+    AthenaEgressScheduler *result = parcObject_CreateInstance(AthenaEgressScheduler);
+    if (result != NULL) {
+        for (int i = 0; i < AthenaEgressClass_Count; i++) {
+            _AthenaEgressQueue *queue = &result->queue[i];
+            queue->entry = NULL;
+            queue->head = 0;
+            queue->count = 0;
+            queue->capacity = 0;
+            queue->queueLimit = AthenaEgressScheduler_DefaultQueueLimit;
+            queue->weight = AthenaEgressScheduler_DefaultWeight;
+            queue->deficit = 0;
+            queue->stats.sent = 0;
+            queue->stats.dropped = 0;
+        }
+        result->depth = 0;
+        result->current = AthenaEgressClass_Control;
+        result->credited = false;
+    }
+    return result;
+}
+
+AthenaEgressClass
+athenaEgressScheduler_Classify(CCNxMetaMessage *message)
+{
+    if (ccnxMetaMessage_IsInterest(message)) {
+        return AthenaEgressClass_Interest;
+    }
+    if (ccnxMetaMessage_IsInterestReturn(message)) {
+        return AthenaEgressClass_InterestReturn;
+    }
+    if (ccnxMetaMessage_IsControl(message)) {
+        return AthenaEgressClass_Control;
+    }
+    return AthenaEgressClass_ContentObject;
+}
+
+const char *
+athenaEgressScheduler_ClassName(AthenaEgressClass egressClass)
+{
+    assertTrue(egressClass < AthenaEgressClass_Count, "Invalid egress class %d", egressClass);
+    return _athenaEgressClassNames[egressClass];
+}
+
+bool
+athenaEgressScheduler_ClassFromName(const char *name, AthenaEgressClass *egressClass)
+{
+    for (int i = 0; i < AthenaEgressClass_Count; i++) {
+        if (strcasecmp(name, _athenaEgressClassNames[i]) == 0) {
+            *egressClass = (AthenaEgressClass) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+athenaEgressScheduler_Configure(AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass, size_t weight, size_t queueLimit)
+{
+    assertTrue(egressClass < AthenaEgressClass_Count, "Invalid egress class %d", egressClass);
+    scheduler->queue[egressClass].weight = weight ? weight : 1;
+    scheduler->queue[egressClass].queueLimit = queueLimit;
+}
+
+size_t
+athenaEgressScheduler_GetWeight(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass)
+{
+    return scheduler->queue[egressClass].weight;
+}
+
+size_t
+athenaEgressScheduler_GetQueueLimit(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass)
+{
+    return scheduler->queue[egressClass].queueLimit;
+}
+
+static bool
+_athenaEgressQueue_Grow(_AthenaEgressQueue *queue)
+{
+    size_t capacity = queue->capacity ? (queue->capacity * 2) : 16;
+    if (capacity > queue->queueLimit) {
+        capacity = queue->queueLimit;
+    }
+    _AthenaEgressEntry *entry = parcMemory_Allocate(capacity * sizeof(_AthenaEgressEntry));
+    if (entry == NULL) {
+        return false;
+    }
+
+    // Unwrap the ring into the new array
+    for (size_t n = 0; n < queue->count; n++) {
+        entry[n] = queue->entry[(queue->head + n) % queue->capacity];
+    }
+    if (queue->entry != NULL) {
+        parcMemory_Deallocate(&queue->entry);
+    }
+    queue->entry = entry;
+    queue->head = 0;
+    queue->capacity = capacity;
+    return true;
+}
+
+bool
+athenaEgressScheduler_Enqueue(AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass,
+                              CCNxMetaMessage *message, size_t length)
+{
+    assertTrue(egressClass < AthenaEgressClass_Count, "Invalid egress class %d", egressClass);
+    _AthenaEgressQueue *queue = &scheduler->queue[egressClass];
+
+    if (queue->count >= queue->queueLimit) {
+        queue->stats.dropped++;
+        return false;
+    }
+    if ((queue->count == queue->capacity) && (_athenaEgressQueue_Grow(queue) == false)) {
+        queue->stats.dropped++;
+        return false;
+    }
+
+    _AthenaEgressEntry *entry = &queue->entry[(queue->head + queue->count) % queue->capacity];
+    entry->message = ccnxMetaMessage_Acquire(message);
+    entry->length = length;
+    queue->count++;
+    scheduler->depth++;
+    return true;
+}
+
+static void
+_athenaEgressQueue_Pop(AthenaEgressScheduler *scheduler, _AthenaEgressQueue *queue)
+{
+    _AthenaEgressEntry *entry = &queue->entry[queue->head];
+    queue->deficit -= entry->length;
+    ccnxMetaMessage_Release(&entry->message);
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    scheduler->depth--;
+}
+
+static void
+_athenaEgressScheduler_NextClass(AthenaEgressScheduler *scheduler)
+{
+    scheduler->current = (AthenaEgressClass) ((scheduler->current + 1) % AthenaEgressClass_Count);
+    scheduler->credited = false;
+}
+
+size_t
+athenaEgressScheduler_Service(AthenaEgressScheduler *scheduler,
+                              AthenaEgressScheduler_SendMethod *sendMethod,
+                              AthenaEgressScheduler_SendMethodContext context)
+{
+    size_t sent = 0;
+
+    while (scheduler->depth > 0) {
+        _AthenaEgressQueue *queue = &scheduler->queue[scheduler->current];
+        if (queue->count == 0) {
+            queue->deficit = 0;
+            _athenaEgressScheduler_NextClass(scheduler);
+            continue;
+        }
+
+        if (scheduler->credited == false) {
+            queue->deficit += queue->weight * AthenaEgressScheduler_Quantum;
+            scheduler->credited = true;
+        }
+
+        while ((queue->count > 0) && (queue->entry[queue->head].length <= queue->deficit)) {
+            switch (sendMethod(context, queue->entry[queue->head].message)) {
+                case AthenaEgressScheduler_Sent:
+                    queue->stats.sent++;
+                    sent++;
+                    break;
+                case AthenaEgressScheduler_Failed:
+                    queue->stats.dropped++;
+                    break;
+                case AthenaEgressScheduler_Blocked:
+                    return sent; // resume with this message, keeping the class's credit
+            }
+            _athenaEgressQueue_Pop(scheduler, queue);
+        }
+
+        // An emptied class doesn't bank credit for later bursts
+        if (queue->count == 0) {
+            queue->deficit = 0;
+        }
+        _athenaEgressScheduler_NextClass(scheduler);
+    }
+    return sent;
+}
+
+size_t
+athenaEgressScheduler_Depth(const AthenaEgressScheduler *scheduler)
+{
+    return scheduler->depth;
+}
+
+size_t
+athenaEgressScheduler_GetQueueDepth(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass)
+{
+    return scheduler->queue[egressClass].count;
+}
+
+size_t
+athenaEgressScheduler_GetSentCount(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass)
+{
+    return scheduler->queue[egressClass].stats.sent;
+}
+
+size_t
+athenaEgressScheduler_GetDropCount(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass)
+{
+    return scheduler->queue[egressClass].stats.dropped;
+}
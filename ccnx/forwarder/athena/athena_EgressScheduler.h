@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_EgressScheduler_h
+#define libathena_EgressScheduler_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <ccnx/transport/common/transport_MetaMessage.h>
+
+/*
+ * Egress scheduler interfaces
+ *
+ *    athenaEgressScheduler_Create
+ *    athenaEgressScheduler_Release
+ *
+ *    athenaEgressScheduler_Classify
+ *    athenaEgressScheduler_ClassName
+ *    athenaEgressScheduler_ClassFromName
+ *    athenaEgressScheduler_Configure
+ *    athenaEgressScheduler_GetWeight
+ *    athenaEgressScheduler_GetQueueLimit
+ *    athenaEgressScheduler_Enqueue
+ *    athenaEgressScheduler_Service
+ *    athenaEgressScheduler_Depth
+ *    athenaEgressScheduler_GetQueueDepth
+ *    athenaEgressScheduler_GetSentCount
+ *    athenaEgressScheduler_GetDropCount
+ */
+
+/**
+ * @typedef AthenaEgressClass
+ * @brief Traffic classes a link's outgoing messages are queued in
+ */
+typedef enum {
+    AthenaEgressClass_Control = 0,
+    AthenaEgressClass_Interest = 1,
+    AthenaEgressClass_InterestReturn = 2,
+    AthenaEgressClass_ContentObject = 3,
+} AthenaEgressClass;
+
+#define AthenaEgressClass_Count 4
+
+/**
+ * Bytes a class is credited each round for each unit of its weight, about one MTU sized message.
+ */
+#define AthenaEgressScheduler_Quantum 1500
+
+/**
+ * Weight and queue limit (in messages) given to classes that haven't been configured.
+ */
+#define AthenaEgressScheduler_DefaultWeight 1
+#define AthenaEgressScheduler_DefaultQueueLimit 256
+
+/**
+ * @typedef AthenaEgressScheduler_SendResult
+ * @brief Outcome of handing a queued message to its link
+ */
+typedef enum {
+    AthenaEgressScheduler_Sent,    // the message was sent and is removed from its queue
+    AthenaEgressScheduler_Blocked, // the link can't take it now, it stays at the head of its queue
+    AthenaEgressScheduler_Failed,  // the send failed, the message is dropped
+} AthenaEgressScheduler_SendResult;
+
+typedef void *AthenaEgressScheduler_SendMethodContext;
+typedef AthenaEgressScheduler_SendResult (AthenaEgressScheduler_SendMethod)(AthenaEgressScheduler_SendMethodContext context,
+                                                                              CCNxMetaMessage *message);
+
+/**
+ * @typedef AthenaEgressScheduler
+ * @brief Per class message queues for one link, serviced in deficit round robin order
+ *
+ * Each round a class with queued messages is credited its weight times AthenaEgressScheduler_Quantum
+ * bytes and sends messages from the head of its queue while their length fits within its credit.
+ * Credit that isn't used is carried to the next round as long as the class has messages queued,
+ * so each class gets a share of the link proportional to its weight, whatever the size of its messages.
+ */
+struct athena_egress_scheduler;
+typedef struct athena_egress_scheduler AthenaEgressScheduler;
+
+/**
+ * @abstract Create a scheduler with empty queues and the default weights and queue limits
+ *
+ * @return pointer to a new scheduler, NULL on allocation failure
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaEgressScheduler *scheduler = athenaEgressScheduler_Create();
+ *     athenaEgressScheduler_Configure(scheduler, AthenaEgressClass_Interest, 4, 512);
+ *     athenaEgressScheduler_Release(&scheduler);
+ * }
+ * @endcode
+ */
+AthenaEgressScheduler *athenaEgressScheduler_Create(void);
+
+/**
+ * @abstract Release a scheduler reference, messages still queued are released with the last reference
+ *
+ * @param [in,out] schedulerPtr pointer to the reference, set to NULL on return
+ */
+void athenaEgressScheduler_Release(AthenaEgressScheduler **schedulerPtr);
+
+/**
+ * @abstract Return the class a message is queued in
+ * @discussion
+ *
+ * Manifests are queued with Content Objects.
+ *
+ * @param [in] message
+ * @return traffic class of the message
+ */
+AthenaEgressClass athenaEgressScheduler_Classify(CCNxMetaMessage *message);
+
+/**
+ * @abstract Return the name of a class, as used in link listings and control commands
+ *
+ * @param [in] egressClass
+ * @return "control", "interest", "interestReturn" or "contentObject"
+ */
+const char *athenaEgressScheduler_ClassName(AthenaEgressClass egressClass);
+
+/**
+ * @abstract Look up a class by name, ignoring case
+ *
+ * @param [in] name
+ * @param [out] egressClass set to the class if it was found
+ * @return true if the name is a class name
+ */
+bool athenaEgressScheduler_ClassFromName(const char *name, AthenaEgressClass *egressClass);
+
+/**
+ * @abstract Set the weight and queue limit of a class
+ * @discussion
+ *
+ * A weight of 0 is stored as 1, every class is serviced.  A queue limit of 0 disables queueing
+ * for the class, its messages are only sent when the link can take them immediately.  Lowering a
+ * limit doesn't drop messages that are already queued.
+ *
+ * @param [in] scheduler
+ * @param [in] egressClass
+ * @param [in] weight relative share of the link given to the class
+ * @param [in] queueLimit maximum number of messages queued in the class
+ */
+void athenaEgressScheduler_Configure(AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass, size_t weight, size_t queueLimit);
+
+/**
+ * @abstract Return the weight of a class
+ *
+ * @param [in] scheduler
+ * @param [in] egressClass
+ * @return weight, never 0
+ */
+size_t athenaEgressScheduler_GetWeight(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass);
+
+/**
+ * @abstract Return the queue limit of a class
+ *
+ * @param [in] scheduler
+ * @param [in] egressClass
+ * @return maximum number of messages queued in the class
+ */
+size_t athenaEgressScheduler_GetQueueLimit(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass);
+
+/**
+ * @abstract Queue a message at the tail of its class
+ *
+ * @param [in] scheduler
+ * @param [in] egressClass
+ * @param [in] message acquired by the scheduler if it's queued
+ * @param [in] length of the message's wire format, in bytes
+ * @return true if the message was queued, false if the class queue is full and the message was dropped
+ *
+ * Example:
+ * @code
+ * {
+ *     if (athenaEgressScheduler_Enqueue(scheduler, athenaEgressScheduler_Classify(message), message, length) == false) {
+ *         // dropped
+ *     }
+ * }
+ * @endcode
+ */
+bool athenaEgressScheduler_Enqueue(AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass,
+                                   CCNxMetaMessage *message, size_t length);
+
+/**
+ * @abstract Send queued messages in deficit round robin order until the queues are empty or the link blocks
+ * @discussion
+ *
+ * Each message is passed to sendMethod.  If it returns AthenaEgressScheduler_Blocked servicing stops
+ * and resumes with the same message, in the same round, on the next call.
+ *
+ * @param [in] scheduler
+ * @param [in] sendMethod called to send each message
+ * @param [in] context passed to sendMethod
+ * @return number of messages sent
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t sent = athenaEgressScheduler_Service(scheduler, _sendToLink, athenaTransportLink);
+ * }
+ * @endcode
+ */
+size_t athenaEgressScheduler_Service(AthenaEgressScheduler *scheduler,
+                                     AthenaEgressScheduler_SendMethod *sendMethod,
+                                     AthenaEgressScheduler_SendMethodContext context);
+
+/**
+ * @abstract Return the number of messages queued in all classes
+ *
+ * @param [in] scheduler
+ * @return number of queued messages
+ */
+size_t athenaEgressScheduler_Depth(const AthenaEgressScheduler *scheduler);
+
+/**
+ * @abstract Return the number of messages queued in a class
+ *
+ * @param [in] scheduler
+ * @param [in] egressClass
+ * @return number of queued messages
+ */
+size_t athenaEgressScheduler_GetQueueDepth(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass);
+
+/**
+ * @abstract Return the number of queued messages of a class that have been sent
+ *
+ * @param [in] scheduler
+ * @param [in] egressClass
+ * @return number of messages sent from the class queue
+ */
+size_t athenaEgressScheduler_GetSentCount(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass);
+
+/**
+ * @abstract Return the number of messages of a class dropped because its queue was full or their send failed
+ *
+ * @param [in] scheduler
+ * @param [in] egressClass
+ * @return number of messages dropped
+ */
+size_t athenaEgressScheduler_GetDropCount(const AthenaEgressScheduler *scheduler, AthenaEgressClass egressClass);
+#endif // libathena_EgressScheduler_h
@@ -59,23 +59,93 @@
 #include <config.h>
 
 #include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
 
 #include <ccnx/forwarder/athena/athena.h>
 #include <parc/algol/parc_BitVector.h>
 #include <parc/algol/parc_HashMap.h>
+#include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_TreeRedBlack.h>
 
 #include <ccnx/forwarder/athena/athena_FIB.h>
+#include <ccnx/forwarder/athena/athena_NexthopList.h>
+#include <ccnx/forwarder/athena/athena_ForwardingStrategies.h>
+
+/**
+ * @typedef AthenaFIBRoute
+ * @brief A prefix routed over a single link.  Each route is threaded onto the list of routes for its
+ *        prefix entry and onto the list of routes over its link, so removing a link only visits the
+ *        routes it carries, without name lookups.
+ */
+typedef struct athena_FIB_route {
+    struct athena_FIB_entry *entry;
+    int linkId;
+    struct athena_FIB_route *previousOnLink;
+    struct athena_FIB_route *nextOnLink;
+    struct athena_FIB_route *nextInEntry;
+} _AthenaFIBRoute;
+
+/**
+ * @typedef AthenaFIBLinkRoutes
+ * @brief Routes over a link, in the order they were added
+ */
+typedef struct athena_FIB_link_routes {
+    _AthenaFIBRoute *first;
+    _AthenaFIBRoute *last;
+} _AthenaFIBLinkRoutes;
+
+/**
+ * @typedef AthenaFIBEntry
+ * @brief Prefix table entry, the nexthops for a name and the routes that index them by link
+ */
+typedef struct athena_FIB_entry {
+    CCNxName *name;
+    AthenaNexthopList *nexthops;
+    _AthenaFIBRoute *routes;
+} _AthenaFIBEntry;
+
+static void
+_athenaFIBEntry_Destroy(_AthenaFIBEntry **entryHandle)
+{
+    _AthenaFIBEntry *entry = *entryHandle;
+    ccnxName_Release(&entry->name);
+    athenaNexthopList_Release(&entry->nexthops);
+}
+
+parcObject_ExtendPARCObject(_AthenaFIBEntry, _athenaFIBEntry_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static
+parcObject_ImplementAcquire(_athenaFIBEntry, _AthenaFIBEntry);
+
+static
+parcObject_ImplementRelease(_athenaFIBEntry, _AthenaFIBEntry);
+
+static _AthenaFIBEntry *
+_athenaFIBEntry_Create(const CCNxName *name)
+{
+    _AthenaFIBEntry *entry = parcObject_CreateInstance(_AthenaFIBEntry);
+    if (entry != NULL) {
+        entry->name = ccnxName_Acquire(name);
+        entry->nexthops = athenaNexthopList_Create();
+        entry->routes = NULL;
+    }
+    return entry;
+}
 
 /**
  * @typedef AthenaFIB
- * @brief FIB tables, tableByName (KEY == CCNxName, VALUE == PARCBitVector
- *                    listOfLinks (List ( index = linkId ) of lists (CCNxNames))
+ * @brief FIB tables, tableByName (KEY == CCNxName, VALUE == AthenaFIBEntry)
+ *                    linkRoutes (array ( index = linkId ) of lists of AthenaFIBRoutes)
+ *                    strategyByName (KEY == CCNxName, VALUE == AthenaForwardingStrategy)
  */
 struct athena_FIB {
     PARCHashMap *tableByName;
-    PARCList *listOfLinks;
-    PARCBitVector *defaultRoute;
+    _AthenaFIBLinkRoutes *linkRoutes;
+    size_t linkRoutesSize;
+    AthenaNexthopList *defaultRoute;
+    PARCHashMap *strategyByName;
+    AthenaForwardingStrategy *defaultStrategy;
 };
 
 /**
@@ -85,6 +155,8 @@ struct athena_FIB {
 struct athena_FIB_list_entry {
     CCNxName *name;
     int linkId;
+    uint32_t cost;
+    uint32_t weight;
 };
 
 CCNxName *
@@ -99,16 +171,40 @@ athenaFIBListEntry_GetLinkId(AthenaFIBListEntry *entry)
     return entry->linkId;
 }
 
+uint32_t
+athenaFIBListEntry_GetCost(AthenaFIBListEntry *entry)
+{
+    return entry->cost;
+}
+
+uint32_t
+athenaFIBListEntry_GetWeight(AthenaFIBListEntry *entry)
+{
+    return entry->weight;
+}
+
 
 static void
 _athenaFIB_Destroy(AthenaFIB **fib)
 {
     AthenaFIB *pFib = *fib;
+    for (size_t linkId = 0; linkId < pFib->linkRoutesSize; linkId++) {
+        _AthenaFIBRoute *route = pFib->linkRoutes[linkId].first;
+        while (route != NULL) {
+            _AthenaFIBRoute *next = route->nextOnLink;
+            parcMemory_Deallocate(&route);
+            route = next;
+        }
+    }
+    if (pFib->linkRoutes != NULL) {
+        parcMemory_Deallocate(&pFib->linkRoutes);
+    }
     parcHashMap_Release(&pFib->tableByName);
-    parcList_Release(&pFib->listOfLinks);
     if (pFib->defaultRoute != NULL) {
-        parcBitVector_Release(&pFib->defaultRoute);
+        athenaNexthopList_Release(&pFib->defaultRoute);
     }
+    parcHashMap_Release(&pFib->strategyByName);
+    athenaForwardingStrategy_Release(&pFib->defaultStrategy);
 }
 
 parcObject_ExtendPARCObject(AthenaFIB, _athenaFIB_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
@@ -119,191 +215,258 @@ parcObject_ImplementRelease(athenaFIB, AthenaFIB);
 
 AthenaFIB *
 athenaFIB_Create()
+{
+    return athenaFIB_CreateCapacity(0);
+}
+
+AthenaFIB *
+athenaFIB_CreateCapacity(size_t capacity)
 {
     AthenaFIB *newFIB = parcObject_CreateInstance(AthenaFIB);
     if (newFIB != NULL) {
-        newFIB->listOfLinks = parcList(parcArrayList_Create((void (*)(void**))parcList_Release), PARCArrayListAsPARCList);
-        newFIB->tableByName = parcHashMap_Create();
+        newFIB->linkRoutes = NULL;
+        newFIB->linkRoutesSize = 0;
+        newFIB->tableByName = (capacity > 0) ? parcHashMap_CreateCapacity(capacity) : parcHashMap_Create();
         newFIB->defaultRoute = NULL;
+        newFIB->strategyByName = parcHashMap_Create();
+        newFIB->defaultStrategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_MulticastImplementation, NULL);
     }
 
     return newFIB;
 }
 
-PARCBitVector *
-athenaFIB_Lookup(AthenaFIB *athenaFIB, const CCNxName *ccnxName, PARCBitVector *ingressVector)
+static bool
+_athenaFIB_IsDefaultPrefix(const CCNxName *ccnxName)
 {
-    CCNxName *name = ccnxName_Copy(ccnxName);
-    PARCBitVector *result = NULL;
+    if (ccnxName_GetSegmentCount(ccnxName) == 0) {
+        return true;
+    }
+    if (ccnxName_GetSegmentCount(ccnxName) == 1) {
+        CCNxNameSegment *segment = ccnxName_GetSegment(ccnxName, 0);
+        if ((ccnxNameSegment_GetType(segment) == CCNxNameLabelType_NAME) &&
+            (ccnxNameSegment_Length(segment) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Return the entry itself if it doesn't contain the ingress link, otherwise a copy with the ingress
+// link removed.  If the ingress link is the only nexthop in the entry there is nothing to return.
+static AthenaNexthopList *
+_athenaFIB_ExcludeIngress(const AthenaNexthopList *nexthops, int ingressLinkId)
+{
+    if ((ingressLinkId < 0) || (parcBitVector_Get(athenaNexthopList_GetVector(nexthops), ingressLinkId) != 1)) {
+        return athenaNexthopList_Acquire(nexthops);
+    }
+    if (athenaNexthopList_Size(nexthops) == 1) {
+        return NULL;
+    }
+    AthenaNexthopList *result = athenaNexthopList_Copy(nexthops);
+    athenaNexthopList_Clear(result, ingressLinkId);
+    return result;
+}
+
+AthenaNexthopList *
+athenaFIB_LookupNexthops(AthenaFIB *athenaFIB, const CCNxName *ccnxName, PARCBitVector *ingressVector)
+{
+    AthenaNexthopList *result = NULL;
+
+    int ingressLinkId = -1;
+    if (ingressVector != NULL) {
+        assertTrue(parcBitVector_NumberOfBitsSet(ingressVector) <= 1, "Ingress vector with more than one link set");
+        ingressLinkId = parcBitVector_NextBitSet(ingressVector, 0);
+    }
 
     // Return the longest prefix match which contains at least one link other than the ingress.
-    // If the result happens to contain the ingress link, make a copy and remove it before returning.
+    CCNxName *name = ccnxName_Copy(ccnxName);
     while ((ccnxName_GetSegmentCount(name) > 0) && (result == NULL)) {
-        result = (PARCBitVector *) parcHashMap_Get(athenaFIB->tableByName, (PARCObject *) name);
-        if (result) {
-            // If there's an ingressVector provided, return a copy of the result the ingress link cleared.
-            // If that would result in an empty vector, continue looking for a substring match.
-            if (ingressVector != NULL) {
-                assertTrue(parcBitVector_NumberOfBitsSet(ingressVector) <= 1, "Ingress vector with more than one link set");
-                if (parcBitVector_Contains(result, ingressVector)) {
-                    if (parcBitVector_NumberOfBitsSet(result) > 1) {
-                        result = parcBitVector_Copy(result);
-                        parcBitVector_ClearVector(result, ingressVector);
-                    } else { // ingress was only link, keep looking
-                        result = NULL;
-                        name = ccnxName_Trim(name, 1);
-                    }
-                    continue;
-                }
-            }
-            result = parcBitVector_Acquire(result);
+        _AthenaFIBEntry *entry = (_AthenaFIBEntry *) parcHashMap_Get(athenaFIB->tableByName, (PARCObject *) name);
+        if (entry != NULL) {
+            result = _athenaFIB_ExcludeIngress(entry->nexthops, ingressLinkId);
         }
         name = ccnxName_Trim(name, 1);
     }
     ccnxName_Release(&name);
 
     // The default route is outside of the Lookup table, so we need to check it independently
-    // and remove the ingress link if it's in the entry.
     if ((result == NULL) && (athenaFIB->defaultRoute != NULL)) {
-        if (ingressVector != NULL) {
-            if (parcBitVector_Contains(athenaFIB->defaultRoute, ingressVector)) {
-                // The ingress link is in the link vector list
-                // either make a copy and remove it, or return an empty egress
-                if (parcBitVector_NumberOfBitsSet(athenaFIB->defaultRoute) > 1) {
-                    result = parcBitVector_Copy(athenaFIB->defaultRoute);
-                    parcBitVector_ClearVector(result, ingressVector);
-                } else { // ingress was the only link
-                    result = NULL;
-                }
-            } else { // ingress was not in the default route
-                result = parcBitVector_Acquire(athenaFIB->defaultRoute);
-            }
-        } else { // no ingress vector was provided
-            result = parcBitVector_Acquire(athenaFIB->defaultRoute);
-        }
+        result = _athenaFIB_ExcludeIngress(athenaFIB->defaultRoute, ingressLinkId);
+    }
+
+    return result;
+}
+
+PARCBitVector *
+athenaFIB_Lookup(AthenaFIB *athenaFIB, const CCNxName *ccnxName, PARCBitVector *ingressVector)
+{
+    PARCBitVector *result = NULL;
+
+    AthenaNexthopList *nexthops = athenaFIB_LookupNexthops(athenaFIB, ccnxName, ingressVector);
+    if (nexthops != NULL) {
+        result = parcBitVector_Copy(athenaNexthopList_GetVector(nexthops));
+        athenaNexthopList_Release(&nexthops);
     }
 
     return result;
 }
 
+// Append a route for the entry to the routes over its link, growing the link index if needed
+static void
+_athenaFIB_AddLinkRoute(AthenaFIB *athenaFIB, _AthenaFIBEntry *entry, int linkId)
+{
+    if (linkId >= athenaFIB->linkRoutesSize) {
+        size_t newSize = (athenaFIB->linkRoutesSize > 0) ? athenaFIB->linkRoutesSize : 8;
+        while (newSize <= linkId) {
+            newSize *= 2;
+        }
+        _AthenaFIBLinkRoutes *newLinkRoutes = parcMemory_Reallocate(athenaFIB->linkRoutes, sizeof(_AthenaFIBLinkRoutes) * newSize);
+        assertNotNull(newLinkRoutes, "parcMemory_Reallocate failed to resize the FIB link index");
+        memset(&newLinkRoutes[athenaFIB->linkRoutesSize], 0, sizeof(_AthenaFIBLinkRoutes) * (newSize - athenaFIB->linkRoutesSize));
+        athenaFIB->linkRoutes = newLinkRoutes;
+        athenaFIB->linkRoutesSize = newSize;
+    }
+
+    _AthenaFIBRoute *route = parcMemory_AllocateAndClear(sizeof(_AthenaFIBRoute));
+    assertNotNull(route, "parcMemory_AllocateAndClear failed to create a FIB route");
+    route->entry = entry;
+    route->linkId = linkId;
+
+    _AthenaFIBLinkRoutes *linkRoutes = &athenaFIB->linkRoutes[linkId];
+    route->previousOnLink = linkRoutes->last;
+    if (linkRoutes->last != NULL) {
+        linkRoutes->last->nextOnLink = route;
+    } else {
+        linkRoutes->first = route;
+    }
+    linkRoutes->last = route;
+
+    route->nextInEntry = entry->routes;
+    entry->routes = route;
+}
+
+// Unthread a route from its entry and its link and free it.  An entry only has a route for each of
+// its nexthops so the walk of the entry's routes is short.
+static void
+_athenaFIB_RemoveLinkRoute(AthenaFIB *athenaFIB, _AthenaFIBRoute *route)
+{
+    _AthenaFIBRoute **routeHandle = &route->entry->routes;
+    while (*routeHandle != route) {
+        routeHandle = &(*routeHandle)->nextInEntry;
+    }
+    *routeHandle = route->nextInEntry;
+
+    _AthenaFIBLinkRoutes *linkRoutes = &athenaFIB->linkRoutes[route->linkId];
+    if (route->previousOnLink != NULL) {
+        route->previousOnLink->nextOnLink = route->nextOnLink;
+    } else {
+        linkRoutes->first = route->nextOnLink;
+    }
+    if (route->nextOnLink != NULL) {
+        route->nextOnLink->previousOnLink = route->previousOnLink;
+    } else {
+        linkRoutes->last = route->previousOnLink;
+    }
+
+    parcMemory_Deallocate(&route);
+}
+
+// Remove an entry that no longer has any nexthops from the prefix table
+static void
+_athenaFIB_RemoveEntry(AthenaFIB *athenaFIB, _AthenaFIBEntry *entry)
+{
+    // The table holds the only reference to the entry, keep it (and its name) alive across the removal
+    entry = _athenaFIBEntry_Acquire(entry);
+    parcHashMap_Remove(athenaFIB->tableByName, (PARCObject *) entry->name);
+    _athenaFIBEntry_Release(&entry);
+}
+
 bool
 athenaFIB_AddRoute(AthenaFIB *athenaFIB, const CCNxName *ccnxName, const PARCBitVector *ccnxLinkVector)
 {
-    PARCBitVector *linkV = NULL;
+    return athenaFIB_AddRouteWithCost(athenaFIB, ccnxName, ccnxLinkVector,
+                                      AthenaNexthop_DefaultCost, AthenaNexthop_DefaultWeight);
+}
 
+bool
+athenaFIB_AddRouteWithCost(AthenaFIB *athenaFIB, const CCNxName *ccnxName, const PARCBitVector *ccnxLinkVector,
+                           uint32_t cost, uint32_t weight)
+{
     // Check if this is a mapping for the default route
-    if (ccnxName_GetSegmentCount(ccnxName) == 1) {
-        CCNxNameSegment *segment = ccnxName_GetSegment(ccnxName, 0);
-        if ((ccnxNameSegment_GetType(segment) == CCNxNameLabelType_NAME) &&
-            (ccnxNameSegment_Length(segment) == 0)) {
-            if (athenaFIB->defaultRoute == NULL) {
-                athenaFIB->defaultRoute = parcBitVector_Create();
-            }
-            linkV = athenaFIB->defaultRoute;
+    if (_athenaFIB_IsDefaultPrefix(ccnxName)) {
+        if (athenaFIB->defaultRoute == NULL) {
+            athenaFIB->defaultRoute = athenaNexthopList_Create();
         }
+        for (int bit = 0; (bit = parcBitVector_NextBitSet(ccnxLinkVector, bit)) >= 0; bit++) {
+            athenaNexthopList_Set(athenaFIB->defaultRoute, bit, cost, weight);
+        }
+        return true;
     }
 
-    if (linkV == NULL) { // It's not the default link
-        // for each bit in the link vector, add an entry for the name in the list of links for future
-        // cleanup
-        for (int i = 0, bit = 0; i < parcBitVector_NumberOfBitsSet(ccnxLinkVector); ++i, ++bit) {
-            bit = parcBitVector_NextBitSet(ccnxLinkVector, bit);
-            if (bit >= parcList_Size(athenaFIB->listOfLinks)) {
-                //Expand the list if needed
-                for (size_t j = parcList_Size(athenaFIB->listOfLinks); j <= bit; ++j) {
-                    parcList_Add(athenaFIB->listOfLinks, NULL);
-                }
-            }
-            PARCList *nameList = parcList_GetAtIndex((PARCList *) athenaFIB->listOfLinks, bit);
-            if (nameList == NULL) {
-                nameList = parcList(parcArrayList_Create((void (*)(void **))ccnxName_Release), PARCArrayListAsPARCList);
-                parcList_SetAtIndex(athenaFIB->listOfLinks, bit, (PARCObject *) nameList);
-                parcList_Add(nameList, (PARCObject *) ccnxName_Acquire(ccnxName));
-            } else {
-                // Make sure the entry is only added once to the list
-                bool found = false;
-                for (int j = 0; (j < parcList_Size(nameList)) && !found; ++j) {
-                    CCNxName *key = (CCNxName *) parcList_GetAtIndex(nameList, j);
-                    if (ccnxName_Equals(ccnxName, key)) {
-                        found = true;
-                    }
-                }
-                if (!found) {
-                    parcList_Add(nameList, (PARCObject *) ccnxName_Acquire(ccnxName));
-                }
-            }
-        }
+    _AthenaFIBEntry *entry = (_AthenaFIBEntry *) parcHashMap_Get(athenaFIB->tableByName, (PARCObject *) ccnxName);
+    if (entry == NULL) {
+        _AthenaFIBEntry *newEntry = _athenaFIBEntry_Create(ccnxName);
+        entry = newEntry;
+        parcHashMap_Put(athenaFIB->tableByName, (PARCObject *) ccnxName, (PARCObject *) newEntry);
+        _athenaFIBEntry_Release(&newEntry);
+    }
 
-        // Now add the actual fib mapping
-        linkV = (PARCBitVector *) parcHashMap_Get(athenaFIB->tableByName, (PARCObject *) ccnxName);
-        if (linkV == NULL) {
-            PARCBitVector *newLinkV = parcBitVector_Create();
-            linkV = newLinkV;
-            parcHashMap_Put(athenaFIB->tableByName, (PARCObject *) ccnxName, (PARCObject *) newLinkV);
-            parcBitVector_Release(&newLinkV);
+    for (int bit = 0; (bit = parcBitVector_NextBitSet(ccnxLinkVector, bit)) >= 0; bit++) {
+        // An entry has a route on a link exactly when the link is one of its nexthops
+        if (parcBitVector_Get(athenaNexthopList_GetVector(entry->nexthops), bit) != 1) {
+            _athenaFIB_AddLinkRoute(athenaFIB, entry, bit);
         }
+        athenaNexthopList_Set(entry->nexthops, bit, cost, weight);
     }
 
-    parcBitVector_SetVector(linkV, ccnxLinkVector);
-
     return true;
 }
 
+// Remove the links from the nexthops, returning true if any of them were present
+static bool
+_athenaFIB_ClearNexthops(AthenaNexthopList *nexthops, const PARCBitVector *ccnxLinkVector)
+{
+    bool result = false;
+    for (int bit = 0; (bit = parcBitVector_NextBitSet(ccnxLinkVector, bit)) >= 0; bit++) {
+        if (athenaNexthopList_Clear(nexthops, bit)) {
+            result = true;
+        }
+    }
+    return result;
+}
+
 bool
 athenaFIB_DeleteRoute(AthenaFIB *athenaFIB, const CCNxName *ccnxName, const PARCBitVector *ccnxLinkVector)
 {
     bool result = false;
 
     // Check if this is a mapping for the default route
-    if (ccnxName_GetSegmentCount(ccnxName) == 1) {
-        CCNxNameSegment *segment = ccnxName_GetSegment(ccnxName, 0);
-        if ((ccnxNameSegment_GetType(segment) == CCNxNameLabelType_NAME) &&
-            (ccnxNameSegment_Length(segment) == 0)) {
-            if (athenaFIB->defaultRoute != NULL) {
-                PARCBitVector *linkSet = parcBitVector_And(athenaFIB->defaultRoute, ccnxLinkVector);
-                if (parcBitVector_NumberOfBitsSet(linkSet) > 0) {
-                    parcBitVector_ClearVector(athenaFIB->defaultRoute, ccnxLinkVector);
-                    result = true;
-                }
-                parcBitVector_Release(&linkSet);
-                if (parcBitVector_NumberOfBitsSet(athenaFIB->defaultRoute) == 0) {
-                    parcBitVector_Release(&(athenaFIB->defaultRoute));
-                    athenaFIB->defaultRoute = NULL;
-                }
+    if (_athenaFIB_IsDefaultPrefix(ccnxName)) {
+        if (athenaFIB->defaultRoute != NULL) {
+            result = _athenaFIB_ClearNexthops(athenaFIB->defaultRoute, ccnxLinkVector);
+            if (athenaNexthopList_Size(athenaFIB->defaultRoute) == 0) {
+                athenaNexthopList_Release(&(athenaFIB->defaultRoute));
+                athenaFIB->defaultRoute = NULL;
             }
-            return result;
         }
+        return result;
     }
 
-    PARCBitVector *linkV = athenaFIB_Lookup(athenaFIB, ccnxName, NULL);
-    if (linkV != NULL) {
-        // Only clear bits if the link sets intersect
-        PARCBitVector *linkSet = parcBitVector_And(linkV, ccnxLinkVector);
-        if (parcBitVector_NumberOfBitsSet(linkSet) > 0) {
-            parcBitVector_ClearVector(linkV, ccnxLinkVector);
-            if (parcBitVector_NumberOfBitsSet(linkV) == 0) {
-                parcHashMap_Remove(athenaFIB->tableByName, (PARCObject *) ccnxName);
-            }
-            //
-            // Traverse each referenced interface list and remove the route if a reference is found there.
-            //
-            for (int bit = 0; (bit = parcBitVector_NextBitSet(ccnxLinkVector, bit)) >= 0; bit++) {
-                PARCList *nameList = parcList_GetAtIndex((PARCList *) athenaFIB->listOfLinks, bit);
-                if (nameList) {
-                    for (int j = 0; j < parcList_Size(nameList); ++j) {
-                        CCNxName *key = (CCNxName *) parcList_GetAtIndex(nameList, j);
-                        if (ccnxName_Equals(ccnxName, key)) {
-                            parcList_RemoveAtIndex(nameList, j);
-                            ccnxName_Release(&key);
-                            break;
-                        }
-                    }
-                }
+    _AthenaFIBEntry *entry = (_AthenaFIBEntry *) parcHashMap_Get(athenaFIB->tableByName, (PARCObject *) ccnxName);
+    if (entry != NULL) {
+        _AthenaFIBRoute *route = entry->routes;
+        while (route != NULL) {
+            _AthenaFIBRoute *next = route->nextInEntry;
+            if (parcBitVector_Get(ccnxLinkVector, route->linkId) == 1) {
+                athenaNexthopList_Clear(entry->nexthops, route->linkId);
+                _athenaFIB_RemoveLinkRoute(athenaFIB, route);
+                result = true;
             }
-            result = true;
+            route = next;
+        }
+        if (athenaNexthopList_Size(entry->nexthops) == 0) {
+            _athenaFIB_RemoveEntry(athenaFIB, entry);
         }
-        parcBitVector_Release(&linkSet);
-        parcBitVector_Release(&linkV);
     }
 
     return result;
@@ -314,29 +477,160 @@ athenaFIB_RemoveLink(AthenaFIB *athenaFIB, const PARCBitVector *ccnxLinkVector)
 {
     bool result = true;
 
-    for (int i = 0, bit = 0; i < parcBitVector_NumberOfBitsSet(ccnxLinkVector); ++i) {
-        bit = parcBitVector_NextBitSet(ccnxLinkVector, bit);
-        if (parcList_Size(athenaFIB->listOfLinks) <= bit) {
+    // Visit only the routes carried by each link, in time linear in their number
+    for (int bit = 0; (bit = parcBitVector_NextBitSet(ccnxLinkVector, bit)) >= 0; bit++) {
+        if (bit >= athenaFIB->linkRoutesSize) {
             break;
         }
-        PARCList *nameList = parcList_GetAtIndex(athenaFIB->listOfLinks, bit);
-        if (nameList != NULL) {
-            while (parcList_Size(nameList)) {
-                CCNxName *key = (CCNxName *) parcList_GetAtIndex(nameList, 0);
-                athenaFIB_DeleteRoute(athenaFIB, key, ccnxLinkVector);
+        _AthenaFIBLinkRoutes *linkRoutes = &athenaFIB->linkRoutes[bit];
+        while (linkRoutes->first != NULL) {
+            _AthenaFIBEntry *entry = linkRoutes->first->entry;
+            athenaNexthopList_Clear(entry->nexthops, bit);
+            _athenaFIB_RemoveLinkRoute(athenaFIB, linkRoutes->first);
+            if (athenaNexthopList_Size(entry->nexthops) == 0) {
+                _athenaFIB_RemoveEntry(athenaFIB, entry);
             }
-            parcList_Clear(nameList);
-            result = true;
         }
     }
     if (athenaFIB->defaultRoute) {
-        parcBitVector_ClearVector(athenaFIB->defaultRoute, ccnxLinkVector);
-        if (parcBitVector_NumberOfBitsSet(athenaFIB->defaultRoute) == 0) {
-            parcBitVector_Release(&(athenaFIB->defaultRoute));
+        _athenaFIB_ClearNexthops(athenaFIB->defaultRoute, ccnxLinkVector);
+        if (athenaNexthopList_Size(athenaFIB->defaultRoute) == 0) {
+            athenaNexthopList_Release(&(athenaFIB->defaultRoute));
             athenaFIB->defaultRoute = NULL;
         }
     }
 
+    // Strategies forget the links, their ids are reused by links opened later
+    for (int bit = 0; (bit = parcBitVector_NextBitSet(ccnxLinkVector, bit)) >= 0; bit++) {
+        athenaForwardingStrategy_LinkRemoved(athenaFIB->defaultStrategy, bit);
+        PARCIterator *it = parcHashMap_CreateValueIterator(athenaFIB->strategyByName);
+        while (parcIterator_HasNext(it)) {
+            athenaForwardingStrategy_LinkRemoved((AthenaForwardingStrategy *) parcIterator_Next(it), bit);
+        }
+        parcIterator_Release(&it);
+    }
+
+    return result;
+}
+
+ssize_t
+athenaFIB_LoadRoutes(AthenaFIB *athenaFIB, const char *routes,
+                     AthenaFIB_LinkResolver *resolver, AthenaFIB_LinkResolverContext context, size_t *errorLine)
+{
+    ssize_t result = 0;
+    size_t lineNumber = 0;
+    PARCBitVector *linkVector = parcBitVector_Create();
+
+    // Routes usually arrive grouped by link, so remember the last link name resolved
+    char lastLinkName[MAXPATHLEN] = "";
+    int lastLinkId = -1;
+
+    const char *line = routes;
+    while ((line != NULL) && (*line != '\0')) {
+        const char *next = strchr(line, '\n');
+        size_t length = (next != NULL) ? (size_t) (next - line) : strlen(line);
+        lineNumber++;
+
+        char routeLine[MAXPATHLEN];
+        if (length >= sizeof(routeLine)) {
+            result = -1;
+            break;
+        }
+        memcpy(routeLine, line, length);
+        routeLine[length] = '\0';
+        line = (next != NULL) ? next + 1 : NULL;
+
+        // "<prefix> <linkName> [<cost> [<weight>]]", blank lines and lines starting with # are skipped
+        char prefix[MAXPATHLEN];
+        char linkName[MAXPATHLEN];
+        unsigned cost = AthenaNexthop_DefaultCost;
+        unsigned weight = AthenaNexthop_DefaultWeight;
+        int numberOfArguments = sscanf(routeLine, "%s %s %u %u", prefix, linkName, &cost, &weight);
+        if ((numberOfArguments <= 0) || (prefix[0] == '#')) {
+            continue;
+        }
+        if (numberOfArguments < 2) {
+            result = -1;
+            break;
+        }
+
+        if (strcmp(linkName, lastLinkName) != 0) {
+            lastLinkId = resolver(context, linkName);
+            strcpy(lastLinkName, linkName);
+        }
+        if (lastLinkId < 0) {
+            result = -1;
+            break;
+        }
+
+        CCNxName *prefixName = ccnxName_CreateFromCString(prefix);
+        if (prefixName == NULL) {
+            result = -1;
+            break;
+        }
+        parcBitVector_Set(linkVector, lastLinkId);
+        athenaFIB_AddRouteWithCost(athenaFIB, prefixName, linkVector, cost, weight);
+        parcBitVector_Clear(linkVector, lastLinkId);
+        ccnxName_Release(&prefixName);
+        result++;
+    }
+
+    parcBitVector_Release(&linkVector);
+    if ((result < 0) && (errorLine != NULL)) {
+        *errorLine = lineNumber;
+    }
+    return result;
+}
+
+void
+athenaFIB_SwapRoutes(AthenaFIB *athenaFIB, AthenaFIB *routes)
+{
+    PARCHashMap *tableByName = athenaFIB->tableByName;
+    _AthenaFIBLinkRoutes *linkRoutes = athenaFIB->linkRoutes;
+    size_t linkRoutesSize = athenaFIB->linkRoutesSize;
+    AthenaNexthopList *defaultRoute = athenaFIB->defaultRoute;
+
+    athenaFIB->tableByName = routes->tableByName;
+    athenaFIB->linkRoutes = routes->linkRoutes;
+    athenaFIB->linkRoutesSize = routes->linkRoutesSize;
+    athenaFIB->defaultRoute = routes->defaultRoute;
+
+    routes->tableByName = tableByName;
+    routes->linkRoutes = linkRoutes;
+    routes->linkRoutesSize = linkRoutesSize;
+    routes->defaultRoute = defaultRoute;
+}
+
+bool
+athenaFIB_SetStrategy(AthenaFIB *athenaFIB, const CCNxName *ccnxName, AthenaForwardingStrategy *strategy)
+{
+    if (_athenaFIB_IsDefaultPrefix(ccnxName)) {
+        athenaForwardingStrategy_Release(&athenaFIB->defaultStrategy);
+        athenaFIB->defaultStrategy = athenaForwardingStrategy_Acquire(strategy);
+    } else {
+        parcHashMap_Put(athenaFIB->strategyByName, (PARCObject *) ccnxName, (PARCObject *) strategy);
+    }
+    return true;
+}
+
+AthenaForwardingStrategy *
+athenaFIB_GetStrategy(AthenaFIB *athenaFIB, const CCNxName *ccnxName)
+{
+    AthenaForwardingStrategy *result = NULL;
+
+    // Most deployments only set the default strategy, avoid the name walk for them.
+    if (parcHashMap_Size(athenaFIB->strategyByName) > 0) {
+        CCNxName *name = ccnxName_Copy(ccnxName);
+        while ((ccnxName_GetSegmentCount(name) > 0) && (result == NULL)) {
+            result = (AthenaForwardingStrategy *) parcHashMap_Get(athenaFIB->strategyByName, (PARCObject *) name);
+            name = ccnxName_Trim(name, 1);
+        }
+        ccnxName_Release(&name);
+    }
+
+    if (result == NULL) {
+        result = athenaFIB->defaultStrategy;
+    }
     return result;
 }
 
@@ -355,13 +649,22 @@ static
 parcObject_ImplementRelease(_athenaFIBListEntry, AthenaFIBListEntry);
 
 static AthenaFIBListEntry *
-_athenaFIBListEntry_Create(const CCNxName *name, int linkId)
+_athenaFIBListEntry_Create(const CCNxName *name, const AthenaNexthopList *nexthops, int linkId)
 {
     AthenaFIBListEntry *entry = parcObject_CreateInstance(AthenaFIBListEntry);
 
     if (entry != NULL) {
         entry->name = ccnxName_Acquire(name);
         entry->linkId = linkId;
+        entry->cost = AthenaNexthop_DefaultCost;
+        entry->weight = AthenaNexthop_DefaultWeight;
+        for (size_t i = 0; i < athenaNexthopList_Size(nexthops); i++) {
+            if (athenaNexthopList_GetLinkId(nexthops, i) == linkId) {
+                entry->cost = athenaNexthopList_GetCost(nexthops, i);
+                entry->weight = athenaNexthopList_GetWeight(nexthops, i);
+                break;
+            }
+        }
     }
 
     return entry;
@@ -376,20 +679,17 @@ athenaFIB_CreateEntryList(AthenaFIB *athenaFIB)
 
     if (athenaFIB->defaultRoute != NULL) {
         CCNxName *defaultPrefix = ccnxName_CreateFromCString("ccnx:/");
-        for (int bit = 0; (bit = parcBitVector_NextBitSet(athenaFIB->defaultRoute, bit)) >= 0; bit++) {
-            AthenaFIBListEntry *entry = _athenaFIBListEntry_Create(defaultPrefix, bit);
+        const PARCBitVector *defaultVector = athenaNexthopList_GetVector(athenaFIB->defaultRoute);
+        for (int bit = 0; (bit = parcBitVector_NextBitSet(defaultVector, bit)) >= 0; bit++) {
+            AthenaFIBListEntry *entry = _athenaFIBListEntry_Create(defaultPrefix, athenaFIB->defaultRoute, bit);
             parcList_Add(result, entry);
         }
         ccnxName_Release(&defaultPrefix);
     }
-    for (size_t i = 0; i < parcList_Size(athenaFIB->listOfLinks); ++i) {
-        PARCList *linksForId = parcList_GetAtIndex(athenaFIB->listOfLinks, i);
-        if (linksForId != NULL) {
-            for (size_t j = 0; j < parcList_Size(linksForId); ++j) {
-                CCNxName *name = parcList_GetAtIndex(linksForId, j);
-                AthenaFIBListEntry *entry = _athenaFIBListEntry_Create(name, (int) i);
-                parcList_Add(result, entry);
-            }
+    for (size_t i = 0; i < athenaFIB->linkRoutesSize; ++i) {
+        for (_AthenaFIBRoute *route = athenaFIB->linkRoutes[i].first; route != NULL; route = route->nextOnLink) {
+            AthenaFIBListEntry *entry = _athenaFIBListEntry_Create(route->entry->name, route->entry->nexthops, (int) i);
+            parcList_Add(result, entry);
         }
     }
     return result;
@@ -59,26 +59,40 @@
 #ifndef libathena_athena_FIB_h
 #define libathena_athena_FIB_h
 
+#include <sys/types.h>
+
 #include <parc/algol/parc_BitVector.h>
 
 #include <ccnx/transport/common/transport_MetaMessage.h>
 
+#include <ccnx/forwarder/athena/athena_NexthopList.h>
+#include <ccnx/forwarder/athena/athena_ForwardingStrategy.h>
+
 /*
  * FIB interfaces
  *
  *    athenaFIB_Create
+ *    athenaFIB_CreateCapacity
  *    athenaFIB_Release
  *
  *    athenaFIB_RemoveLink
  *
  *    athenaFIB_Lookup
+ *    athenaFIB_LookupNexthops
  *    athenaFIB_DeleteRoute
  *    athenaFIB_AddRoute
+ *    athenaFIB_AddRouteWithCost
+ *
+ *    athenaFIB_LoadRoutes
+ *    athenaFIB_SwapRoutes
+ *
+ *    athenaFIB_SetStrategy
+ *    athenaFIB_GetStrategy
  */
 
 /**
  * @typedef AthenaFIB
- * @brief FIB table, KEY == tlvName, VALUE == AthenaFIBEntry
+ * @brief FIB table, KEY == tlvName, VALUE == AthenaNexthopList
  */
 struct athena_FIB;
 typedef struct athena_FIB AthenaFIB;
@@ -90,11 +104,22 @@ typedef struct athena_FIB AthenaFIB;
 struct athena_FIB_list_entry;
 typedef struct athena_FIB_list_entry AthenaFIBListEntry;
 
+/**
+ * @typedef AthenaFIB_LinkResolver
+ * @brief Map a link name to its link id while loading routes, -1 if the link is unknown
+ */
+typedef void *AthenaFIB_LinkResolverContext;
+typedef int (AthenaFIB_LinkResolver)(AthenaFIB_LinkResolverContext context, const char *linkName);
+
 
 CCNxName *athenaFIBListEntry_GetName(AthenaFIBListEntry *entry);
 
 int athenaFIBListEntry_GetLinkId(AthenaFIBListEntry *entry);
 
+uint32_t athenaFIBListEntry_GetCost(AthenaFIBListEntry *entry);
+
+uint32_t athenaFIBListEntry_GetWeight(AthenaFIBListEntry *entry);
+
 /**
  * @abstract Create a FIB table
  * @discussion
@@ -113,6 +138,24 @@ int athenaFIBListEntry_GetLinkId(AthenaFIBListEntry *entry);
  */
 AthenaFIB *athenaFIB_Create();
 
+/**
+ * @abstract Create a FIB table sized for a number of routes
+ * @discussion
+ *
+ * Sizing the table up front avoids growing it repeatedly while a large route table is loaded.
+ *
+ * @param [in] capacity expected number of route prefixes, 0 for the default size
+ * @return pointer to a FIB instance
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaFIB *athenaFIB = athenaFIB_CreateCapacity(500000);
+ * }
+ * @endcode
+ */
+AthenaFIB *athenaFIB_CreateCapacity(size_t capacity);
+
 /**
  * @abstract Release a FIB
  * @discussion
@@ -176,10 +219,37 @@ bool athenaFIB_RemoveLink(AthenaFIB *athenaFIB, const PARCBitVector *ccnxLinkVec
  */
 PARCBitVector *athenaFIB_Lookup(AthenaFIB *athenaFIB, const CCNxName *ccnxName, PARCBitVector *ingressVector);
 
+/**
+ * @abstract lookup the ordered nexthops for a name in the FIB
+ * @discussion
+ *
+ * Same matching as athenaFIB_Lookup, but the nexthops are returned in ascending cost order along
+ * with their costs and weights, so a forwarding strategy can rank or weight them.
+ *
+ * @param [in] athenaFIB
+ * @param [in] ccnxName
+ * @param [in] ingressVector origin of message, excluded from the result
+ * @return nexthop list, NULL if there is no route, must be released by the caller
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaNexthopList *nexthops = athenaFIB_LookupNexthops(athenaFIB, ccnxName, ingressVector);
+ *     if (nexthops != NULL) {
+ *         int preferredLinkId = athenaNexthopList_GetLinkId(nexthops, 0);
+ *         athenaNexthopList_Release(&nexthops);
+ *     }
+ * }
+ * @endcode
+ */
+AthenaNexthopList *athenaFIB_LookupNexthops(AthenaFIB *athenaFIB, const CCNxName *ccnxName, PARCBitVector *ingressVector);
+
 /**
  * @abstract add route to FIB
  * @discussion
  *
+ * The links are added with the default cost and weight, see athenaFIB_AddRouteWithCost.
+ *
  * @param [in] athenaFIB
  * @param [in] ccnxName
  * @param [in] ccnxLinkVector
@@ -201,6 +271,87 @@ PARCBitVector *athenaFIB_Lookup(AthenaFIB *athenaFIB, const CCNxName *ccnxName,
  */
 bool athenaFIB_AddRoute(AthenaFIB *athenaFIB, const CCNxName *ccnxName, const PARCBitVector *ccnxLinkVector);
 
+/**
+ * @abstract add route to FIB with a nexthop cost and weight
+ * @discussion
+ *
+ * Each link in the vector becomes a nexthop for the name with the given cost and weight.  Adding
+ * a link that is already a nexthop for the name replaces its cost and weight.
+ *
+ * @param [in] athenaFIB
+ * @param [in] ccnxName
+ * @param [in] ccnxLinkVector
+ * @param [in] cost lower cost nexthops are preferred
+ * @param [in] weight relative share of the load among nexthops of equal cost
+ * @return true if successful
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *ccnxName = ccnxName_CreateFromURI("lci:/ccnx/tutorial");
+ *     PARCBitVector *egressLinks = parcBitVector_Create();
+ *     parcBitVector_Set(egressLinks, 3);
+ *     athenaFIB_AddRouteWithCost(athenaFIB, ccnxName, egressLinks, 10, 2);
+ *     parcBitVector_Release(&egressLinks);
+ *     ccnxName_Release(&ccnxName);
+ * }
+ * @endcode
+ */
+bool athenaFIB_AddRouteWithCost(AthenaFIB *athenaFIB, const CCNxName *ccnxName, const PARCBitVector *ccnxLinkVector,
+                                uint32_t cost, uint32_t weight);
+
+/**
+ * @abstract add a set of routes to the FIB
+ * @discussion
+ *
+ * Routes are given one per line as "<prefix> <linkName> [<cost> [<weight>]]", blank lines and
+ * lines starting with '#' are ignored.  Loading stops at the first line that can't be parsed or
+ * names an unknown link, routes added before it are kept.  Loading into a FIB created for the
+ * purpose and then swapping it in with athenaFIB_SwapRoutes leaves the active FIB untouched
+ * until the whole set has loaded.
+ *
+ * @param [in] athenaFIB
+ * @param [in] routes nul terminated route text
+ * @param [in] resolver maps link names to link ids
+ * @param [in] context passed to the resolver
+ * @param [out] errorLine if not NULL, set to the line number of the failing line on error
+ * @return number of routes added, -1 on error
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaFIB *newFIB = athenaFIB_CreateCapacity(routeCount);
+ *     size_t errorLine;
+ *     if (athenaFIB_LoadRoutes(newFIB, routes, _resolveLinkName, adapter, &errorLine) >= 0) {
+ *         athenaFIB_SwapRoutes(athenaFIB, newFIB);
+ *     }
+ *     athenaFIB_Release(&newFIB);
+ * }
+ * @endcode
+ */
+ssize_t athenaFIB_LoadRoutes(AthenaFIB *athenaFIB, const char *routes,
+                             AthenaFIB_LinkResolver *resolver, AthenaFIB_LinkResolverContext context, size_t *errorLine);
+
+/**
+ * @abstract exchange the routes of two FIBs
+ * @discussion
+ *
+ * The route tables are exchanged in constant time, forwarding strategies stay bound to the FIB
+ * they were set on.  After the swap the routes FIB holds the previous routes of athenaFIB.
+ *
+ * @param [in] athenaFIB the FIB in use
+ * @param [in] routes FIB holding the replacement routes
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaFIB_SwapRoutes(athena->athenaFIB, newFIB);
+ *     athenaFIB_Release(&newFIB); // release the previous routes
+ * }
+ * @endcode
+ */
+void athenaFIB_SwapRoutes(AthenaFIB *athenaFIB, AthenaFIB *routes);
+
 /**
  * @abstract remove route to link from FIB
  * @discussion
@@ -224,6 +375,50 @@ bool athenaFIB_AddRoute(AthenaFIB *athenaFIB, const CCNxName *ccnxName, const PA
  */
 bool athenaFIB_DeleteRoute(AthenaFIB *athenaFIB, const CCNxName *ccnxName, const PARCBitVector *ccnxLinkVector);
 
+/**
+ * @abstract bind a forwarding strategy to a FIB prefix
+ * @discussion
+ *
+ * Interests are forwarded using the strategy bound to the longest prefix of their name.  Binding a
+ * strategy to the default prefix (ccnx:/) changes the strategy used for all other names, which is
+ * multicast unless set otherwise.  The FIB acquires its own reference to the strategy.
+ *
+ * @param [in] athenaFIB
+ * @param [in] ccnxName prefix to bind the strategy to
+ * @param [in] strategy
+ * @return true if successful
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *ccnxName = ccnxName_CreateFromURI("lci:/ccnx/tutorial");
+ *     AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_BestRouteImplementation, NULL);
+ *     athenaFIB_SetStrategy(athenaFIB, ccnxName, strategy);
+ *     athenaForwardingStrategy_Release(&strategy);
+ *     ccnxName_Release(&ccnxName);
+ * }
+ * @endcode
+ */
+bool athenaFIB_SetStrategy(AthenaFIB *athenaFIB, const CCNxName *ccnxName, AthenaForwardingStrategy *strategy);
+
+/**
+ * @abstract find the forwarding strategy for a name
+ * @discussion
+ *
+ * @param [in] athenaFIB
+ * @param [in] ccnxName
+ * @return the strategy bound to the longest matching prefix, owned by the FIB
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaForwardingStrategy *strategy = athenaFIB_GetStrategy(athenaFIB, ccnxName);
+ *     PARCBitVector *egressVector = athenaForwardingStrategy_SelectEgress(strategy, interest, nexthops);
+ * }
+ * @endcode
+ */
+AthenaForwardingStrategy *athenaFIB_GetStrategy(AthenaFIB *athenaFIB, const CCNxName *ccnxName);
+
 /**
  * @abstract retrieve the entry list for the FIB.
  * @discussion
@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena_ForwardingStrategies.h>
+
+static PARCBitVector *
+_athenaForwardingStrategy_SingleLink(int linkId)
+{
+    PARCBitVector *result = parcBitVector_Create();
+    if (linkId >= 0) {
+        parcBitVector_Set(result, linkId);
+    }
+    return result;
+}
+
+// The number of nexthops sharing the lowest cost, they lead the list
+static size_t
+_athenaForwardingStrategy_LowestCostCount(const AthenaNexthopList *nexthops)
+{
+    size_t count = athenaNexthopList_Size(nexthops);
+    size_t result = 0;
+    while ((result < count) &&
+           (athenaNexthopList_GetCost(nexthops, result) == athenaNexthopList_GetCost(nexthops, 0))) {
+        result++;
+    }
+    return result;
+}
+
+//
+// Multicast
+//
+static PARCBitVector *
+_athenaMulticastStrategy_SelectEgress(AthenaForwardingStrategyImplementation *strategy, const CCNxInterest *interest, const AthenaNexthopList *nexthops)
+{
+    return parcBitVector_Copy(athenaNexthopList_GetVector(nexthops));
+}
+
+AthenaForwardingStrategyInterface AthenaForwardingStrategy_MulticastImplementation = {
+    .name         = "multicast",
+    .description  = "AthenaForwardingStrategy_MulticastImplementation 20160301",
+    .create       = NULL,
+    .release      = NULL,
+
+    .selectEgress = _athenaMulticastStrategy_SelectEgress
+};
+
+//
+// Best route
+//
+static PARCBitVector *
+_athenaBestRouteStrategy_SelectEgress(AthenaForwardingStrategyImplementation *strategy, const CCNxInterest *interest, const AthenaNexthopList *nexthops)
+{
+    if (athenaNexthopList_Size(nexthops) == 0) {
+        return parcBitVector_Create();
+    }
+    return _athenaForwardingStrategy_SingleLink(athenaNexthopList_GetLinkId(nexthops, 0));
+}
+
+AthenaForwardingStrategyInterface AthenaForwardingStrategy_BestRouteImplementation = {
+    .name         = "best-route",
+    .description  = "AthenaForwardingStrategy_BestRouteImplementation 20160301",
+    .create       = NULL,
+    .release      = NULL,
+
+    .selectEgress = _athenaBestRouteStrategy_SelectEgress
+};
+
+//
+// Round robin load balance
+//
+typedef struct athena_loadbalance_strategy {
+    int lastLinkId;
+} _AthenaLoadBalanceStrategy;
+
+parcObject_ExtendPARCObject(_AthenaLoadBalanceStrategy, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static AthenaForwardingStrategyImplementation *
+_athenaLoadBalanceStrategy_Create(AthenaForwardingStrategyConfig *config)
+{
+    _AthenaLoadBalanceStrategy *result = parcObject_CreateInstance(_AthenaLoadBalanceStrategy);
+    if (result != NULL) {
+        result->lastLinkId = -1;
+    }
+    return result;
+}
+
+static PARCBitVector *
+_athenaLoadBalanceStrategy_SelectEgress(AthenaForwardingStrategyImplementation *strategy, const CCNxInterest *interest, const AthenaNexthopList *nexthops)
+{
+    _AthenaLoadBalanceStrategy *loadBalance = (_AthenaLoadBalanceStrategy *) strategy;
+
+    // Equal cost nexthops are in link id order, take the first one after the last used
+    size_t lowestCostCount = _athenaForwardingStrategy_LowestCostCount(nexthops);
+    if (lowestCostCount == 0) {
+        return parcBitVector_Create();
+    }
+    int linkId = athenaNexthopList_GetLinkId(nexthops, 0); // wrap around to the first nexthop
+    for (size_t i = 0; i < lowestCostCount; i++) {
+        if (athenaNexthopList_GetLinkId(nexthops, i) > loadBalance->lastLinkId) {
+            linkId = athenaNexthopList_GetLinkId(nexthops, i);
+            break;
+        }
+    }
+    loadBalance->lastLinkId = linkId;
+
+    return _athenaForwardingStrategy_SingleLink(linkId);
+}
+
+AthenaForwardingStrategyInterface AthenaForwardingStrategy_LoadBalanceImplementation = {
+    .name         = "load-balance",
+    .description  = "AthenaForwardingStrategy_LoadBalanceImplementation 20160301",
+    .create       = _athenaLoadBalanceStrategy_Create,
+    .release      = NULL,
+
+    .selectEgress = _athenaLoadBalanceStrategy_SelectEgress
+};
+
+//
+// Random
+//
+typedef struct athena_random_strategy {
+    AthenaForwardingStrategy_RandomCallback *random;
+    void *randomContext;
+} _AthenaRandomStrategy;
+
+parcObject_ExtendPARCObject(_AthenaRandomStrategy, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static AthenaForwardingStrategyImplementation *
+_athenaRandomStrategy_Create(AthenaForwardingStrategyConfig *config)
+{
+    AthenaBuiltInStrategyConfig *builtInConfig = (AthenaBuiltInStrategyConfig *) config;
+
+    _AthenaRandomStrategy *result = parcObject_CreateInstance(_AthenaRandomStrategy);
+    if (result != NULL) {
+        result->random = NULL;
+        result->randomContext = NULL;
+        if ((builtInConfig != NULL) && (builtInConfig->random != NULL)) {
+            result->random = builtInConfig->random;
+            result->randomContext = builtInConfig->randomContext;
+        }
+    }
+    return result;
+}
+
+static PARCBitVector *
+_athenaRandomStrategy_SelectEgress(AthenaForwardingStrategyImplementation *strategy, const CCNxInterest *interest, const AthenaNexthopList *nexthops)
+{
+    _AthenaRandomStrategy *randomStrategy = (_AthenaRandomStrategy *) strategy;
+
+    size_t lowestCostCount = _athenaForwardingStrategy_LowestCostCount(nexthops);
+    if (lowestCostCount == 0) {
+        return parcBitVector_Create();
+    }
+
+    uint64_t totalWeight = 0;
+    for (size_t i = 0; i < lowestCostCount; i++) {
+        totalWeight += athenaNexthopList_GetWeight(nexthops, i);
+    }
+
+    uint64_t choice = randomStrategy->random ? randomStrategy->random(randomStrategy->randomContext) : (uint64_t) random();
+    choice %= totalWeight;
+    size_t index = 0;
+    while (choice >= athenaNexthopList_GetWeight(nexthops, index)) {
+        choice -= athenaNexthopList_GetWeight(nexthops, index);
+        index++;
+    }
+
+    return _athenaForwardingStrategy_SingleLink(athenaNexthopList_GetLinkId(nexthops, index));
+}
+
+AthenaForwardingStrategyInterface AthenaForwardingStrategy_RandomImplementation = {
+    .name         = "random",
+    .description  = "AthenaForwardingStrategy_RandomImplementation 20160301",
+    .create       = _athenaRandomStrategy_Create,
+    .release      = NULL,
+
+    .selectEgress = _athenaRandomStrategy_SelectEgress
+};
+
+//
+// Adaptive
+//
+// Response times are tracked per nexthop link following RFC 6298 (SRTT/RTTVAR/RTO), the loss
+// estimate is an exponentially weighted average of failures in 1/1024ths.  The reported names are
+// not used, measurements are shared by all of the prefixes an instance is bound to.
+//
+#define ADAPTIVE_PROBE_INTERVAL 16      // every Nth Interest is also sent to an alternate nexthop
+#define ADAPTIVE_INITIAL_RTO    1000    // milliseconds
+#define ADAPTIVE_MIN_RTO        20
+#define ADAPTIVE_MAX_RTO        60000
+#define ADAPTIVE_LOSS_SCALE     1024
+
+typedef struct athena_adaptive_nexthop {
+    bool measured;
+    uint64_t srtt;
+    uint64_t rttvar;
+    uint64_t rto;
+    uint32_t loss;
+    bool pending;            // Interests have been sent since the last response
+    uint64_t pendingSince;   // time of the oldest Interest sent since the last response
+    uint64_t suspendedUntil; // passed over as the preferred nexthop until this time
+} _AthenaAdaptiveNexthop;
+
+typedef struct athena_adaptive_strategy {
+    PARCClock *clock;
+    _AthenaAdaptiveNexthop *nexthop; // indexed by link id
+    size_t nexthopCount;
+    uint64_t interestCount;
+    int lastProbeLinkId;
+} _AthenaAdaptiveStrategy;
+
+static void
+_athenaAdaptiveStrategy_Finalize(_AthenaAdaptiveStrategy **strategyPtr)
+{
+    _AthenaAdaptiveStrategy *adaptive = *strategyPtr;
+    parcClock_Release(&adaptive->clock);
+    if (adaptive->nexthop != NULL) {
+        parcMemory_Deallocate(&adaptive->nexthop);
+    }
+}
+
+parcObject_ExtendPARCObject(_AthenaAdaptiveStrategy, _athenaAdaptiveStrategy_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static AthenaForwardingStrategyImplementation *
+_athenaAdaptiveStrategy_Create(AthenaForwardingStrategyConfig *config)
+{
+    AthenaBuiltInStrategyConfig *adaptiveConfig = (AthenaBuiltInStrategyConfig *) config;
+
+    _AthenaAdaptiveStrategy *result = parcObject_CreateInstance(_AthenaAdaptiveStrategy);
+    if (result != NULL) {
+        if ((adaptiveConfig != NULL) && (adaptiveConfig->clock != NULL)) {
+            result->clock = parcClock_Acquire(adaptiveConfig->clock);
+        } else {
+            result->clock = parcClock_Monotonic();
+        }
+        result->nexthop = NULL;
+        result->nexthopCount = 0;
+        result->interestCount = 0;
+        result->lastProbeLinkId = -1;
+    }
+    return result;
+}
+
+static _AthenaAdaptiveNexthop *
+_athenaAdaptiveStrategy_GetNexthop(_AthenaAdaptiveStrategy *adaptive, int linkId)
+{
+    if (linkId >= adaptive->nexthopCount) {
+        size_t newCount = (size_t) linkId + 1;
+        _AthenaAdaptiveNexthop *nexthop = parcMemory_AllocateAndClear(newCount * sizeof(_AthenaAdaptiveNexthop));
+        assertNotNull(nexthop, "parcMemory_AllocateAndClear(%zu) returned NULL", newCount * sizeof(_AthenaAdaptiveNexthop));
+        for (size_t i = adaptive->nexthopCount; i < newCount; i++) {
+            nexthop[i].rto = ADAPTIVE_INITIAL_RTO;
+        }
+        if (adaptive->nexthop != NULL) {
+            memcpy(nexthop, adaptive->nexthop, adaptive->nexthopCount * sizeof(_AthenaAdaptiveNexthop));
+            parcMemory_Deallocate(&adaptive->nexthop);
+        }
+        adaptive->nexthop = nexthop;
+        adaptive->nexthopCount = newCount;
+    }
+    return &adaptive->nexthop[linkId];
+}
+
+// Expected cost of using a nexthop, unmeasured nexthops rank behind measured ones
+static uint64_t
+_athenaAdaptiveStrategy_Cost(const _AthenaAdaptiveNexthop *nexthop)
+{
+    uint64_t rtt = nexthop->measured ? nexthop->srtt : nexthop->rto;
+    return rtt + (rtt * 4 * nexthop->loss) / ADAPTIVE_LOSS_SCALE;
+}
+
+static void
+_athenaAdaptiveStrategy_AddLoss(_AthenaAdaptiveNexthop *nexthop)
+{
+    nexthop->loss = (nexthop->loss * 7 + ADAPTIVE_LOSS_SCALE) / 8;
+}
+
+// The next nexthop after the last one probed, wrapping around, other than the preferred one
+static int
+_athenaAdaptiveStrategy_NextProbe(const PARCBitVector *nexthopVector, int lastProbeLinkId, int preferredLinkId)
+{
+    int linkId = parcBitVector_NextBitSet(nexthopVector, lastProbeLinkId + 1);
+    if (linkId == preferredLinkId) {
+        linkId = parcBitVector_NextBitSet(nexthopVector, linkId + 1);
+    }
+    if (linkId < 0) {
+        linkId = parcBitVector_NextBitSet(nexthopVector, 0);
+        if (linkId == preferredLinkId) {
+            linkId = parcBitVector_NextBitSet(nexthopVector, linkId + 1);
+        }
+    }
+    return linkId;
+}
+
+static PARCBitVector *
+_athenaAdaptiveStrategy_SelectEgress(AthenaForwardingStrategyImplementation *strategy, const CCNxInterest *interest, const AthenaNexthopList *nexthops)
+{
+    _AthenaAdaptiveStrategy *adaptive = (_AthenaAdaptiveStrategy *) strategy;
+    uint64_t now = parcClock_GetTime(adaptive->clock);
+
+    int bestLinkId = -1;
+    uint64_t bestCost = UINT64_MAX;
+    int fallbackLinkId = -1;
+    uint64_t fallbackCost = UINT64_MAX;
+
+    // Nexthops are visited in FIB cost order, so measurement ties go to the lower cost nexthop
+    for (size_t i = 0; i < athenaNexthopList_Size(nexthops); i++) {
+        int linkId = athenaNexthopList_GetLinkId(nexthops, i);
+        _AthenaAdaptiveNexthop *nexthop = _athenaAdaptiveStrategy_GetNexthop(adaptive, linkId);
+
+        // No response within the retransmission timeout, count a loss and back off
+        if (nexthop->pending && ((now - nexthop->pendingSince) > nexthop->rto)) {
+            _athenaAdaptiveStrategy_AddLoss(nexthop);
+            nexthop->rto = (nexthop->rto * 2 > ADAPTIVE_MAX_RTO) ? ADAPTIVE_MAX_RTO : nexthop->rto * 2;
+            nexthop->suspendedUntil = now + nexthop->rto;
+            nexthop->pending = false;
+        }
+
+        uint64_t cost = _athenaAdaptiveStrategy_Cost(nexthop);
+        if (cost < fallbackCost) {
+            fallbackCost = cost;
+            fallbackLinkId = linkId;
+        }
+        if ((nexthop->suspendedUntil <= now) && (cost < bestCost)) {
+            bestCost = cost;
+            bestLinkId = linkId;
+        }
+    }
+
+    // Every nexthop is suspended, use the least bad one rather than dropping the Interest
+    if (bestLinkId < 0) {
+        bestLinkId = fallbackLinkId;
+    }
+
+    PARCBitVector *result = _athenaForwardingStrategy_SingleLink(bestLinkId);
+
+    // Periodically probe the other nexthops in turn so their measurements stay current
+    if ((++adaptive->interestCount % ADAPTIVE_PROBE_INTERVAL) == 0) {
+        int probeLinkId = _athenaAdaptiveStrategy_NextProbe(athenaNexthopList_GetVector(nexthops), adaptive->lastProbeLinkId, bestLinkId);
+        if (probeLinkId >= 0) {
+            parcBitVector_Set(result, probeLinkId);
+            adaptive->lastProbeLinkId = probeLinkId;
+        }
+    }
+
+    for (int linkId = 0; (linkId = parcBitVector_NextBitSet(result, linkId)) >= 0; linkId++) {
+        _AthenaAdaptiveNexthop *nexthop = _athenaAdaptiveStrategy_GetNexthop(adaptive, linkId);
+        if (!nexthop->pending) {
+            nexthop->pending = true;
+            nexthop->pendingSince = now;
+        }
+    }
+
+    return result;
+}
+
+static void
+_athenaAdaptiveStrategy_InterestSatisfied(AthenaForwardingStrategyImplementation *strategy, const CCNxName *name, int linkId, uint64_t responseTime)
+{
+    _AthenaAdaptiveStrategy *adaptive = (_AthenaAdaptiveStrategy *) strategy;
+    _AthenaAdaptiveNexthop *nexthop = _athenaAdaptiveStrategy_GetNexthop(adaptive, linkId);
+
+    if (nexthop->measured) {
+        uint64_t delta = (nexthop->srtt > responseTime) ? nexthop->srtt - responseTime : responseTime - nexthop->srtt;
+        nexthop->rttvar = (nexthop->rttvar * 3 + delta) / 4;
+        nexthop->srtt = (nexthop->srtt * 7 + responseTime) / 8;
+    } else {
+        nexthop->srtt = responseTime;
+        nexthop->rttvar = responseTime / 2;
+        nexthop->measured = true;
+    }
+
+    nexthop->rto = nexthop->srtt + 4 * nexthop->rttvar;
+    if (nexthop->rto < ADAPTIVE_MIN_RTO) {
+        nexthop->rto = ADAPTIVE_MIN_RTO;
+    } else if (nexthop->rto > ADAPTIVE_MAX_RTO) {
+        nexthop->rto = ADAPTIVE_MAX_RTO;
+    }
+
+    nexthop->loss = (nexthop->loss * 7) / 8;
+    nexthop->pending = false;
+    nexthop->suspendedUntil = 0;
+}
+
+static void
+_athenaAdaptiveStrategy_LinkRemoved(AthenaForwardingStrategyImplementation *strategy, int linkId)
+{
+    _AthenaAdaptiveStrategy *adaptive = (_AthenaAdaptiveStrategy *) strategy;
+
+    // The link id may be given to a new link, which mustn't inherit this one's measurements
+    if ((linkId >= 0) && (linkId < adaptive->nexthopCount)) {
+        memset(&adaptive->nexthop[linkId], 0, sizeof(_AthenaAdaptiveNexthop));
+        adaptive->nexthop[linkId].rto = ADAPTIVE_INITIAL_RTO;
+    }
+}
+
+static void
+_athenaAdaptiveStrategy_InterestFailed(AthenaForwardingStrategyImplementation *strategy, const CCNxName *name, int linkId)
+{
+    _AthenaAdaptiveStrategy *adaptive = (_AthenaAdaptiveStrategy *) strategy;
+    _AthenaAdaptiveNexthop *nexthop = _athenaAdaptiveStrategy_GetNexthop(adaptive, linkId);
+
+    _athenaAdaptiveStrategy_AddLoss(nexthop);
+    nexthop->pending = false;
+}
+
+AthenaForwardingStrategyInterface AthenaForwardingStrategy_AdaptiveImplementation = {
+    .name              = "adaptive",
+    .description       = "AthenaForwardingStrategy_AdaptiveImplementation 20160301",
+    .create            = _athenaAdaptiveStrategy_Create,
+    .release           = NULL,
+
+    .selectEgress      = _athenaAdaptiveStrategy_SelectEgress,
+    .interestSatisfied = _athenaAdaptiveStrategy_InterestSatisfied,
+    .interestFailed    = _athenaAdaptiveStrategy_InterestFailed,
+    .linkRemoved       = _athenaAdaptiveStrategy_LinkRemoved
+};
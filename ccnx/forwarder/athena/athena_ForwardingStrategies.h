@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_ForwardingStrategies_h
+#define libathena_ForwardingStrategies_h
+
+#include <parc/algol/parc_Clock.h>
+
+#include <ccnx/forwarder/athena/athena_ForwardingStrategyInterface.h>
+
+/**
+ * Forward on every nexthop, the forwarder default.
+ */
+extern AthenaForwardingStrategyInterface AthenaForwardingStrategy_MulticastImplementation;
+
+/**
+ * Forward on the single lowest cost nexthop only, the remaining nexthops are tried
+ * as the preferred one returns the Interest.
+ */
+extern AthenaForwardingStrategyInterface AthenaForwardingStrategy_BestRouteImplementation;
+
+/**
+ * Forward each Interest on one of the lowest cost nexthops, rotating through them in turn.
+ */
+extern AthenaForwardingStrategyInterface AthenaForwardingStrategy_LoadBalanceImplementation;
+
+/**
+ * Forward each Interest on one randomly chosen nexthop of the lowest cost, in proportion to
+ * the nexthop weights (weighted ECMP).
+ */
+extern AthenaForwardingStrategyInterface AthenaForwardingStrategy_RandomImplementation;
+
+/**
+ * Forward each Interest on the nexthop with the lowest smoothed response time, adjusted for loss,
+ * periodically probing one of the other nexthops.  A nexthop that doesn't respond within its
+ * retransmission timeout is passed over until the timeout has elapsed again.
+ *
+ * Measurements are kept per nexthop link by each strategy instance, and shared by every prefix the
+ * instance is bound to.  Prefixes whose content is served from different places should each be bound
+ * to an instance of their own.  A link's measurements are dropped when the link is removed.
+ */
+extern AthenaForwardingStrategyInterface AthenaForwardingStrategy_AdaptiveImplementation;
+
+/**
+ * Source of the random strategy's choices, returning uniformly distributed 64 bit values.
+ */
+typedef uint64_t (AthenaForwardingStrategy_RandomCallback)(void *context);
+
+/**
+ * Optional configuration of the built-in strategies, each uses only the parts it needs.  The
+ * adaptive strategy measures response times on the clock, the monotonic clock is used if none is
+ * provided.  The random strategy draws from the random callback, random() is used if none is
+ * provided.
+ */
+typedef struct athena_builtin_strategy_config {
+    PARCClock *clock;
+    AthenaForwardingStrategy_RandomCallback *random;
+    void *randomContext;
+} AthenaBuiltInStrategyConfig;
+
+#endif // libathena_ForwardingStrategies_h
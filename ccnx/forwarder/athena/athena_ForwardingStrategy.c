@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <string.h>
+
+#include <parc/algol/parc_Object.h>
+
+#include <ccnx/forwarder/athena/athena_ForwardingStrategy.h>
+#include <ccnx/forwarder/athena/athena_ForwardingStrategies.h>
+
+/**
+ * @typedef AthenaForwardingStrategy
+ * @brief Forwarding strategy instance private data
+ */
+struct athena_forwardingstrategy {
+    AthenaForwardingStrategyInterface *interface;   // The functions to use to access the implementation.
+    AthenaForwardingStrategyImplementation *impl;   // The implementation itself, local data, etc.
+};
+
+static AthenaForwardingStrategyInterface *_athenaForwardingStrategy_BuiltIn[] = {
+    &AthenaForwardingStrategy_MulticastImplementation,
+    &AthenaForwardingStrategy_BestRouteImplementation,
+    &AthenaForwardingStrategy_LoadBalanceImplementation,
+    &AthenaForwardingStrategy_RandomImplementation,
+    &AthenaForwardingStrategy_AdaptiveImplementation,
+    NULL
+};
+
+static void
+_athenaForwardingStrategy_Finalize(AthenaForwardingStrategy **strategyPtr)
+{
+    AthenaForwardingStrategy *strategy = *strategyPtr;
+    if (strategy->impl != NULL) {
+        if (strategy->interface->release != NULL) {
+            strategy->interface->release(&strategy->impl);
+        } else {
+            parcObject_Release((PARCObject **) &strategy->impl);
+        }
+    }
+}
+
+parcObject_ImplementAcquire(athenaForwardingStrategy, AthenaForwardingStrategy);
+
+parcObject_ImplementRelease(athenaForwardingStrategy, AthenaForwardingStrategy);
+
+parcObject_ExtendPARCObject(AthenaForwardingStrategy, _athenaForwardingStrategy_Finalize, NULL, NULL,
+                            NULL, NULL, NULL, NULL);
+
+AthenaForwardingStrategy *
+athenaForwardingStrategy_Create(AthenaForwardingStrategyInterface *interface, AthenaForwardingStrategyConfig *config)
+{
+    AthenaForwardingStrategy *result = parcObject_CreateInstance(AthenaForwardingStrategy);
+    if (result != NULL) {
+        result->interface = interface;
+        result->impl = NULL;
+        if (interface->create != NULL) {
+            result->impl = interface->create(config);
+        }
+    }
+
+    return result;
+}
+
+const char *
+athenaForwardingStrategy_GetName(const AthenaForwardingStrategy *strategy)
+{
+    return strategy->interface->name;
+}
+
+PARCBitVector *
+athenaForwardingStrategy_SelectEgress(AthenaForwardingStrategy *strategy, const CCNxInterest *interest, const AthenaNexthopList *nexthops)
+{
+    if (strategy->interface->selectEgress == NULL) {
+        return parcBitVector_Copy(athenaNexthopList_GetVector(nexthops));
+    }
+
+    return strategy->interface->selectEgress(strategy->impl, interest, nexthops);
+}
+
+void
+athenaForwardingStrategy_InterestSatisfied(AthenaForwardingStrategy *strategy, const CCNxName *name, int linkId, uint64_t responseTime)
+{
+    if (strategy->interface->interestSatisfied != NULL) {
+        strategy->interface->interestSatisfied(strategy->impl, name, linkId, responseTime);
+    }
+}
+
+void
+athenaForwardingStrategy_InterestFailed(AthenaForwardingStrategy *strategy, const CCNxName *name, int linkId)
+{
+    if (strategy->interface->interestFailed != NULL) {
+        strategy->interface->interestFailed(strategy->impl, name, linkId);
+    }
+}
+
+void
+athenaForwardingStrategy_LinkRemoved(AthenaForwardingStrategy *strategy, int linkId)
+{
+    if (strategy->interface->linkRemoved != NULL) {
+        strategy->interface->linkRemoved(strategy->impl, linkId);
+    }
+}
+
+AthenaForwardingStrategyInterface *
+athenaForwardingStrategy_LookupInterface(const char *name)
+{
+    for (int i = 0; _athenaForwardingStrategy_BuiltIn[i] != NULL; i++) {
+        if (strcasecmp(_athenaForwardingStrategy_BuiltIn[i]->name, name) == 0) {
+            return _athenaForwardingStrategy_BuiltIn[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_ForwardingStrategy_h
+#define libathena_ForwardingStrategy_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_BitVector.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+
+#include <ccnx/forwarder/athena/athena_ForwardingStrategyInterface.h>
+
+/*
+ * Forwarding strategy interfaces
+ *
+ *    athenaForwardingStrategy_Create
+ *    athenaForwardingStrategy_Acquire
+ *    athenaForwardingStrategy_Release
+ *
+ *    athenaForwardingStrategy_GetName
+ *    athenaForwardingStrategy_SelectEgress
+ *    athenaForwardingStrategy_InterestSatisfied
+ *    athenaForwardingStrategy_InterestFailed
+ *    athenaForwardingStrategy_LinkRemoved
+ *
+ *    athenaForwardingStrategy_LookupInterface
+ */
+
+/**
+ * @typedef AthenaForwardingStrategy
+ * @brief Forwarding strategy instance private data
+ */
+typedef struct athena_forwardingstrategy AthenaForwardingStrategy;
+
+/**
+ * @abstract Create a new forwarding strategy instance
+ * @discussion
+ *
+ * A strategy decides which of the nexthops the FIB returned for a name an Interest is actually
+ * forwarded on.  Each FIB prefix a strategy is bound to gets its own instance so that any state
+ * the strategy keeps (e.g. round robin position) is tracked per prefix.
+ *
+ * @param [in] interface the strategy implementation
+ * @param [in] config a pointer to implementation-specific configuration information, can be NULL
+ * @return pointer to the new strategy instance
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_BestRouteImplementation, NULL);
+ *     athenaForwardingStrategy_Release(&strategy);
+ * }
+ * @endcode
+ */
+AthenaForwardingStrategy *athenaForwardingStrategy_Create(AthenaForwardingStrategyInterface *interface, AthenaForwardingStrategyConfig *config);
+
+/**
+ * @abstract Acquire a reference to a forwarding strategy instance
+ *
+ * @param [in] strategy
+ * @return the same value as @p strategy
+ */
+AthenaForwardingStrategy *athenaForwardingStrategy_Acquire(const AthenaForwardingStrategy *strategy);
+
+/**
+ * @abstract Release a forwarding strategy instance
+ *
+ * @param [in,out] strategy
+ */
+void athenaForwardingStrategy_Release(AthenaForwardingStrategy **strategy);
+
+/**
+ * @abstract Return the name the strategy implementation is bound by
+ *
+ * @param [in] strategy
+ * @return the strategy name, e.g. "multicast"
+ */
+const char *athenaForwardingStrategy_GetName(const AthenaForwardingStrategy *strategy);
+
+/**
+ * @abstract Select the links an Interest is to be forwarded on
+ * @discussion
+ *
+ * The returned vector is a subset of the nexthops provided by the FIB, which are ordered by
+ * ascending cost and carry a weight for sharing load between equal cost nexthops.  If the
+ * implementation does not provide a selection function all nexthops are returned.
+ *
+ * @param [in] strategy
+ * @param [in] interest the Interest being forwarded
+ * @param [in] nexthops the nexthops the FIB returned for the Interest name, less the ingress link
+ * @return vector of links to forward the Interest on, must be released by the caller
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaNexthopList *nexthops = athenaFIB_LookupNexthops(athenaFIB, ccnxName, ingressVector);
+ *     AthenaForwardingStrategy *strategy = athenaFIB_GetStrategy(athenaFIB, ccnxName);
+ *     PARCBitVector *egressVector = athenaForwardingStrategy_SelectEgress(strategy, interest, nexthops);
+ *     athenaNexthopList_Release(&nexthops);
+ *     ...
+ *     parcBitVector_Release(&egressVector);
+ * }
+ * @endcode
+ */
+PARCBitVector *athenaForwardingStrategy_SelectEgress(AthenaForwardingStrategy *strategy, const CCNxInterest *interest, const AthenaNexthopList *nexthops);
+
+/**
+ * @abstract Report that a nexthop satisfied an Interest forwarded to it
+ * @discussion
+ *
+ * Called when a Content Object arriving from a link the Interest was forwarded on satisfies the
+ * PIT entry.  Strategies that don't adapt to nexthop performance can ignore these reports.
+ *
+ * @param [in] strategy
+ * @param [in] name the name of the satisfied Interest
+ * @param [in] linkId the nexthop the Content Object arrived on
+ * @param [in] responseTime milliseconds between the PIT entry being created and satisfied
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaForwardingStrategy_InterestSatisfied(strategy, name, linkId, 12);
+ * }
+ * @endcode
+ */
+void athenaForwardingStrategy_InterestSatisfied(AthenaForwardingStrategy *strategy, const CCNxName *name, int linkId, uint64_t responseTime);
+
+/**
+ * @abstract Report that a nexthop failed to satisfy an Interest forwarded to it
+ * @discussion
+ *
+ * Called when the PIT entry expires while the Interest is still outstanding on the link, or the
+ * link returns the Interest with an InterestReturn.
+ *
+ * @param [in] strategy
+ * @param [in] name the name of the failed Interest
+ * @param [in] linkId the nexthop that failed
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaForwardingStrategy_InterestFailed(strategy, name, linkId);
+ * }
+ * @endcode
+ */
+void athenaForwardingStrategy_InterestFailed(AthenaForwardingStrategy *strategy, const CCNxName *name, int linkId);
+
+/**
+ * @abstract Report that a link has been removed
+ * @discussion
+ *
+ * Strategies that keep state for their nexthops drop what they know of the link, so that a link
+ * opened later with the same link id starts out unmeasured.
+ *
+ * @param [in] strategy
+ * @param [in] linkId the link that was removed
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaForwardingStrategy_LinkRemoved(strategy, linkId);
+ * }
+ * @endcode
+ */
+void athenaForwardingStrategy_LinkRemoved(AthenaForwardingStrategy *strategy, int linkId);
+
+/**
+ * @abstract Find a built-in strategy implementation by name
+ *
+ * @param [in] name strategy name ("multicast", "best-route", "load-balance", "random" or "adaptive")
+ * @return the strategy implementation, or NULL if the name is unknown
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaForwardingStrategyInterface *interface = athenaForwardingStrategy_LookupInterface("best-route");
+ *     if (interface != NULL) {
+ *         AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(interface, NULL);
+ *         athenaFIB_SetStrategy(athenaFIB, prefix, strategy);
+ *         athenaForwardingStrategy_Release(&strategy);
+ *     }
+ * }
+ * @endcode
+ */
+AthenaForwardingStrategyInterface *athenaForwardingStrategy_LookupInterface(const char *name);
+#endif // libathena_ForwardingStrategy_h
@@ -0,0 +1,771 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena_IOUring.h>
+
+#ifdef HAVE_LINUX_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/*
+ * The ring is driven with raw system calls against the kernel ABI in <linux/io_uring.h>.  Only the
+ * forwarder thread touches a ring, the kernel is the other party to each queue.  Sends waiting to be
+ * submitted are kept on a list rather than in the submission queue, so that a receive can be posted
+ * again without landing in the middle of a chain of linked stream sends.
+ */
+#define _ATHENA_IOURING_ENTRIES 256
+#define _ATHENA_IOURING_BUFFER_GROUP 0
+
+// user_data of the receive and of cancellations, sends carry the address of their _AthenaIOUringSend
+#define _ATHENA_IOURING_RECEIVE ((uint64_t) 0)
+#define _ATHENA_IOURING_CANCEL ((uint64_t) 1)
+
+typedef struct _AthenaIOUringSend {
+    PARCBuffer *buffer;
+    struct msghdr header;
+    struct iovec iov;
+    struct sockaddr_storage peerAddress;
+    struct _AthenaIOUringSend *next; // free list, or list of sends waiting to be submitted
+} _AthenaIOUringSend;
+
+struct AthenaIOUring {
+    int ringFd;
+    int fd;
+    bool stream;
+
+    // Submission queue
+    void *ringMemory;
+    size_t ringMemorySize;
+    unsigned *sqHead;
+    unsigned *sqTail;
+    unsigned *sqArray;
+    unsigned sqMask;
+    unsigned sqEntries;
+    unsigned sqLocalTail; // entries written but not yet published to the kernel
+    struct io_uring_sqe *sqes;
+    size_t sqesSize;
+
+    // Completion queue
+    unsigned *cqHead;
+    unsigned *cqTail;
+    unsigned cqMask;
+    struct io_uring_cqe *cqes;
+
+    // Receive buffers provided to the kernel
+    struct io_uring_buf_ring *bufferRing;
+    size_t bufferRingSize;
+    uint8_t *buffers;
+    unsigned bufferCount;
+    size_t bufferSize;
+    uint16_t bufferTail;
+
+    // Receive
+    AthenaIOUring_ReceiveCallback *callback;
+    void *context;
+    struct msghdr receiveHeader;
+    bool receiveArmed;
+
+    // Sends
+    _AthenaIOUringSend *sendPool;
+    _AthenaIOUringSend *freeSends;
+    _AthenaIOUringSend *pendingHead;
+    _AthenaIOUringSend *pendingTail;
+    unsigned sendsPending;
+    unsigned sendsInFlight;
+    size_t sendFailures;
+};
+
+static int
+_enter(AthenaIOUring *athenaIOUring, unsigned waitFor)
+{
+    // Publish written entries, then have the kernel consume everything it hasn't
+    __atomic_store_n(athenaIOUring->sqTail, athenaIOUring->sqLocalTail, __ATOMIC_RELEASE);
+    unsigned toSubmit = athenaIOUring->sqLocalTail - __atomic_load_n(athenaIOUring->sqHead, __ATOMIC_ACQUIRE);
+    if ((toSubmit == 0) && (waitFor == 0)) {
+        return 0;
+    }
+
+    int result;
+    do {
+        result = (int) syscall(__NR_io_uring_enter, athenaIOUring->ringFd, toSubmit, waitFor,
+                               waitFor ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    } while ((result == -1) && (errno == EINTR));
+    return result;
+}
+
+static struct io_uring_sqe *
+_getSqe(AthenaIOUring *athenaIOUring)
+{
+    unsigned head = __atomic_load_n(athenaIOUring->sqHead, __ATOMIC_ACQUIRE);
+    if ((athenaIOUring->sqLocalTail - head) == athenaIOUring->sqEntries) {
+        // Without a polling thread the kernel consumes every published entry on enter
+        if (_enter(athenaIOUring, 0) == -1) {
+            return NULL;
+        }
+        head = __atomic_load_n(athenaIOUring->sqHead, __ATOMIC_ACQUIRE);
+        if ((athenaIOUring->sqLocalTail - head) == athenaIOUring->sqEntries) {
+            errno = EBUSY;
+            return NULL;
+        }
+    }
+    unsigned index = athenaIOUring->sqLocalTail & athenaIOUring->sqMask;
+    struct io_uring_sqe *sqe = &athenaIOUring->sqes[index];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    athenaIOUring->sqArray[index] = index;
+    athenaIOUring->sqLocalTail++;
+    return sqe;
+}
+
+static size_t
+_receiveBufferSize(const AthenaIOUring *athenaIOUring)
+{
+    // A multishot recvmsg places its header and the peer's address ahead of the payload
+    if (athenaIOUring->stream) {
+        return athenaIOUring->bufferSize;
+    }
+    return sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_storage) + athenaIOUring->bufferSize;
+}
+
+static void
+_provideBuffer(AthenaIOUring *athenaIOUring, uint16_t bufferId)
+{
+    struct io_uring_buf *buf = &athenaIOUring->bufferRing->bufs[athenaIOUring->bufferTail & (athenaIOUring->bufferCount - 1)];
+    buf->addr = (uint64_t) (uintptr_t) (athenaIOUring->buffers + (bufferId * _receiveBufferSize(athenaIOUring)));
+    buf->len = (uint32_t) _receiveBufferSize(athenaIOUring);
+    buf->bid = bufferId;
+    athenaIOUring->bufferTail++;
+}
+
+static void
+_publishBuffers(AthenaIOUring *athenaIOUring)
+{
+    __atomic_store_n(&athenaIOUring->bufferRing->tail, athenaIOUring->bufferTail, __ATOMIC_RELEASE);
+}
+
+static int
+_postReceive(AthenaIOUring *athenaIOUring)
+{
+    struct io_uring_sqe *sqe = _getSqe(athenaIOUring);
+    if (sqe == NULL) {
+        return -1;
+    }
+    if (athenaIOUring->stream) {
+        sqe->opcode = IORING_OP_RECV;
+    } else {
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->addr = (uint64_t) (uintptr_t) &athenaIOUring->receiveHeader;
+        sqe->len = 1;
+    }
+    sqe->fd = athenaIOUring->fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = _ATHENA_IOURING_BUFFER_GROUP;
+    sqe->user_data = _ATHENA_IOURING_RECEIVE;
+    athenaIOUring->receiveArmed = true;
+    return 0;
+}
+
+static void
+_completeSend(AthenaIOUring *athenaIOUring, _AthenaIOUringSend *send, int result)
+{
+    if ((result < 0) || (athenaIOUring->stream && ((size_t) result != send->iov.iov_len))) {
+        athenaIOUring->sendFailures++;
+    }
+    parcBuffer_Release(&send->buffer);
+    send->next = athenaIOUring->freeSends;
+    athenaIOUring->freeSends = send;
+}
+
+static void
+_deliver(AthenaIOUring *athenaIOUring, const uint8_t *buffer, int length)
+{
+    if (athenaIOUring->stream) {
+        athenaIOUring->callback(athenaIOUring->context, buffer, (size_t) length, NULL, 0, 0);
+        return;
+    }
+
+    struct msghdr *receiveHeader = &athenaIOUring->receiveHeader;
+    const struct io_uring_recvmsg_out *out = (const struct io_uring_recvmsg_out *) buffer;
+    size_t payloadOffset = sizeof(struct io_uring_recvmsg_out) + receiveHeader->msg_namelen + receiveHeader->msg_controllen;
+    if ((size_t) length < payloadOffset) {
+        return;
+    }
+
+    // Datagrams larger than a receive buffer are dropped, as they would be by recv(2) into an mtu sized buffer
+    if (out->flags & MSG_TRUNC) {
+        return;
+    }
+    const struct sockaddr *peerAddress = (const struct sockaddr *) (buffer + sizeof(struct io_uring_recvmsg_out));
+    socklen_t peerAddressLength = (out->namelen < receiveHeader->msg_namelen) ? out->namelen : receiveHeader->msg_namelen;
+    athenaIOUring->callback(athenaIOUring->context, buffer + payloadOffset, out->payloadlen,
+                            peerAddress, peerAddressLength, 0);
+}
+
+static void
+_reapReceive(AthenaIOUring *athenaIOUring, const struct io_uring_cqe *cqe, bool *repost)
+{
+    bool more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+
+    if (cqe->flags & IORING_CQE_F_BUFFER) {
+        uint16_t bufferId = (uint16_t) (cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        if (athenaIOUring->callback && (cqe->res >= 0)) {
+            _deliver(athenaIOUring, athenaIOUring->buffers + (bufferId * _receiveBufferSize(athenaIOUring)), cqe->res);
+        }
+        _provideBuffer(athenaIOUring, bufferId);
+    } else if (athenaIOUring->callback && athenaIOUring->stream && (cqe->res == 0)) {
+        // End of stream
+        athenaIOUring->callback(athenaIOUring->context, NULL, 0, NULL, 0, 0);
+    }
+
+    if (more) {
+        return;
+    }
+    athenaIOUring->receiveArmed = false;
+    if (athenaIOUring->callback == NULL) {
+        return;
+    }
+
+    // The kernel ends a multishot receive when it runs out of buffers, post it again once they've been returned
+    if ((cqe->res == -ENOBUFS) || ((cqe->res > 0) && (cqe->flags & IORING_CQE_F_BUFFER))) {
+        *repost = true;
+    } else if (cqe->res < 0) {
+        athenaIOUring->callback(athenaIOUring->context, NULL, 0, NULL, 0, -cqe->res);
+    }
+}
+
+static size_t
+_reap(AthenaIOUring *athenaIOUring)
+{
+    bool repost = false;
+    size_t count = 0;
+
+    unsigned head = *athenaIOUring->cqHead;
+    unsigned tail = __atomic_load_n(athenaIOUring->cqTail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        struct io_uring_cqe *cqe = &athenaIOUring->cqes[head & athenaIOUring->cqMask];
+        if (cqe->user_data == _ATHENA_IOURING_RECEIVE) {
+            _reapReceive(athenaIOUring, cqe, &repost);
+        } else if (cqe->user_data != _ATHENA_IOURING_CANCEL) {
+            athenaIOUring->sendsInFlight--;
+            _completeSend(athenaIOUring, (_AthenaIOUringSend *) (uintptr_t) cqe->user_data, cqe->res);
+        }
+        head++;
+        count++;
+        if (head == tail) {
+            __atomic_store_n(athenaIOUring->cqHead, head, __ATOMIC_RELEASE);
+            tail = __atomic_load_n(athenaIOUring->cqTail, __ATOMIC_ACQUIRE);
+        }
+    }
+    __atomic_store_n(athenaIOUring->cqHead, head, __ATOMIC_RELEASE);
+    _publishBuffers(athenaIOUring);
+
+    if (repost && (athenaIOUring->receiveArmed == false)) {
+        _postReceive(athenaIOUring);
+    }
+    return count;
+}
+
+static void
+_cancelAll(AthenaIOUring *athenaIOUring)
+{
+    // Sends that never reached the kernel are simply dropped
+    while (athenaIOUring->pendingHead) {
+        _AthenaIOUringSend *send = athenaIOUring->pendingHead;
+        athenaIOUring->pendingHead = send->next;
+        _completeSend(athenaIOUring, send, -ECANCELED);
+    }
+    athenaIOUring->pendingTail = NULL;
+    athenaIOUring->sendsPending = 0;
+    athenaIOUring->callback = NULL;
+
+    if (athenaIOUring->receiveArmed || athenaIOUring->sendsInFlight) {
+        struct io_uring_sqe *sqe = _getSqe(athenaIOUring);
+        if (sqe) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = athenaIOUring->fd;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+            sqe->user_data = _ATHENA_IOURING_CANCEL;
+        }
+    }
+
+    // The kernel may still reference send buffers and the receive header until each request completes
+    while (athenaIOUring->receiveArmed || athenaIOUring->sendsInFlight) {
+        if (_enter(athenaIOUring, 1) == -1) {
+            break;
+        }
+        _reap(athenaIOUring);
+    }
+}
+
+static void
+_athenaIOUring_Finalize(AthenaIOUring **athenaIOUringPtr)
+{
+    AthenaIOUring *athenaIOUring = *athenaIOUringPtr;
+
+    if (athenaIOUring->ringMemory) {
+        _cancelAll(athenaIOUring);
+        munmap(athenaIOUring->ringMemory, athenaIOUring->ringMemorySize);
+    }
+    if (athenaIOUring->sqes) {
+        munmap(athenaIOUring->sqes, athenaIOUring->sqesSize);
+    }
+    if (athenaIOUring->bufferRing) {
+        munmap(athenaIOUring->bufferRing, athenaIOUring->bufferRingSize);
+    }
+    if (athenaIOUring->ringFd != -1) {
+        close(athenaIOUring->ringFd);
+    }
+    if (athenaIOUring->fd != -1) {
+        close(athenaIOUring->fd);
+    }
+    if (athenaIOUring->buffers) {
+        parcMemory_Deallocate(&athenaIOUring->buffers);
+    }
+    if (athenaIOUring->sendPool) {
+        parcMemory_Deallocate(&athenaIOUring->sendPool);
+    }
+}
+
+parcObject_ExtendPARCObject(AthenaIOUring, _athenaIOUring_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(athenaIOUring, AthenaIOUring);
+
+parcObject_ImplementRelease(athenaIOUring, AthenaIOUring);
+
+//
+// Multishot receives with provided buffer rings arrived in Linux 6.0, along with zero copy sends.  There's
+// no probe for multishot support itself, so the zero copy send opcode stands in for it.
+//
+static bool
+_kernelSupported(int ringFd)
+{
+    size_t probeSize = sizeof(struct io_uring_probe) + (IORING_OP_LAST * sizeof(struct io_uring_probe_op));
+    struct io_uring_probe *probe = parcMemory_AllocateAndClear(probeSize);
+    assertNotNull(probe, "parcMemory_AllocateAndClear failed to allocate an io_uring probe");
+
+    bool supported = false;
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) == 0) {
+        supported = (probe->last_op >= IORING_OP_SEND_ZC) &&
+                    (probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED) &&
+                    (probe->ops[IORING_OP_RECVMSG].flags & IO_URING_OP_SUPPORTED) &&
+                    (probe->ops[IORING_OP_SENDMSG].flags & IO_URING_OP_SUPPORTED);
+    }
+    parcMemory_Deallocate(&probe);
+    return supported;
+}
+
+static bool
+_mapRings(AthenaIOUring *athenaIOUring, struct io_uring_params *params)
+{
+    size_t sqSize = params->sq_off.array + (params->sq_entries * sizeof(unsigned));
+    size_t cqSize = params->cq_off.cqes + (params->cq_entries * sizeof(struct io_uring_cqe));
+    athenaIOUring->ringMemorySize = (sqSize > cqSize) ? sqSize : cqSize;
+
+    void *ringMemory = mmap(NULL, athenaIOUring->ringMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            athenaIOUring->ringFd, IORING_OFF_SQ_RING);
+    if (ringMemory == MAP_FAILED) {
+        return false;
+    }
+    athenaIOUring->ringMemory = ringMemory;
+
+    athenaIOUring->sqesSize = params->sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(NULL, athenaIOUring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      athenaIOUring->ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    athenaIOUring->sqes = sqes;
+
+    uint8_t *base = ringMemory;
+    athenaIOUring->sqHead = (unsigned *) (base + params->sq_off.head);
+    athenaIOUring->sqTail = (unsigned *) (base + params->sq_off.tail);
+    athenaIOUring->sqArray = (unsigned *) (base + params->sq_off.array);
+    athenaIOUring->sqMask = *(unsigned *) (base + params->sq_off.ring_mask);
+    athenaIOUring->sqEntries = params->sq_entries;
+    athenaIOUring->sqLocalTail = *athenaIOUring->sqTail;
+    athenaIOUring->cqHead = (unsigned *) (base + params->cq_off.head);
+    athenaIOUring->cqTail = (unsigned *) (base + params->cq_off.tail);
+    athenaIOUring->cqMask = *(unsigned *) (base + params->cq_off.ring_mask);
+    athenaIOUring->cqes = (struct io_uring_cqe *) (base + params->cq_off.cqes);
+    return true;
+}
+
+static bool
+_registerBuffers(AthenaIOUring *athenaIOUring, unsigned bufferCount)
+{
+    athenaIOUring->bufferCount = 1;
+    while (athenaIOUring->bufferCount < bufferCount) {
+        athenaIOUring->bufferCount <<= 1;
+    }
+
+    athenaIOUring->bufferRingSize = athenaIOUring->bufferCount * sizeof(struct io_uring_buf);
+    void *bufferRing = mmap(NULL, athenaIOUring->bufferRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bufferRing == MAP_FAILED) {
+        return false;
+    }
+    athenaIOUring->bufferRing = bufferRing;
+
+    athenaIOUring->buffers = parcMemory_Allocate(athenaIOUring->bufferCount * _receiveBufferSize(athenaIOUring));
+    assertNotNull(athenaIOUring->buffers, "parcMemory_Allocate failed to allocate io_uring receive buffers");
+
+    struct io_uring_buf_reg registration = {
+        .ring_addr = (uint64_t) (uintptr_t) bufferRing,
+        .ring_entries = athenaIOUring->bufferCount,
+        .bgid = _ATHENA_IOURING_BUFFER_GROUP,
+    };
+    if (syscall(__NR_io_uring_register, athenaIOUring->ringFd, IORING_REGISTER_PBUF_RING, &registration, 1) != 0) {
+        return false;
+    }
+
+    for (unsigned bufferId = 0; bufferId < athenaIOUring->bufferCount; bufferId++) {
+        _provideBuffer(athenaIOUring, (uint16_t) bufferId);
+    }
+    _publishBuffers(athenaIOUring);
+    return true;
+}
+
+AthenaIOUring *
+athenaIOUring_Create(int fd, bool stream, unsigned bufferCount, size_t bufferSize)
+{
+    if ((bufferCount == 0) || (bufferCount > 32768) || (bufferSize == 0)) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    AthenaIOUring *athenaIOUring = parcObject_CreateAndClearInstance(AthenaIOUring);
+    assertNotNull(athenaIOUring, "parcObject_CreateAndClearInstance failed to create a new AthenaIOUring");
+    athenaIOUring->ringFd = -1;
+    athenaIOUring->fd = -1;
+    athenaIOUring->stream = stream;
+    athenaIOUring->bufferSize = bufferSize;
+    athenaIOUring->receiveHeader.msg_namelen = sizeof(struct sockaddr_storage);
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_SUBMIT_ALL;
+    athenaIOUring->ringFd = (int) syscall(__NR_io_uring_setup, _ATHENA_IOURING_ENTRIES, &params);
+    if ((athenaIOUring->ringFd == -1) && (errno == EINVAL)) { // setup flags are only advisory
+        memset(&params, 0, sizeof(params));
+        athenaIOUring->ringFd = (int) syscall(__NR_io_uring_setup, _ATHENA_IOURING_ENTRIES, &params);
+    }
+    if (athenaIOUring->ringFd == -1) {
+        int savedErrno = errno;
+        athenaIOUring_Release(&athenaIOUring);
+        errno = savedErrno;
+        return NULL;
+    }
+
+    if (((params.features & IORING_FEAT_SINGLE_MMAP) == 0) || (_kernelSupported(athenaIOUring->ringFd) == false)) {
+        athenaIOUring_Release(&athenaIOUring);
+        errno = ENOTSUP;
+        return NULL;
+    }
+
+    if ((_mapRings(athenaIOUring, &params) == false) || (_registerBuffers(athenaIOUring, bufferCount) == false)) {
+        int savedErrno = errno;
+        athenaIOUring_Release(&athenaIOUring);
+        errno = savedErrno;
+        return NULL;
+    }
+
+    // Sends still in flight when the link using the ring closes its socket need it to stay open
+    athenaIOUring->fd = dup(fd);
+    if (athenaIOUring->fd == -1) {
+        int savedErrno = errno;
+        athenaIOUring_Release(&athenaIOUring);
+        errno = savedErrno;
+        return NULL;
+    }
+
+    // One send per completion queue entry bounds the sends that can be outstanding
+    unsigned sendCount = params.cq_entries;
+    athenaIOUring->sendPool = parcMemory_AllocateAndClear(sendCount * sizeof(_AthenaIOUringSend));
+    assertNotNull(athenaIOUring->sendPool, "parcMemory_AllocateAndClear failed to allocate io_uring sends");
+    for (unsigned i = 0; i < sendCount; i++) {
+        athenaIOUring->sendPool[i].next = athenaIOUring->freeSends;
+        athenaIOUring->freeSends = &athenaIOUring->sendPool[i];
+    }
+
+    return athenaIOUring;
+}
+
+int
+athenaIOUring_GetEventFd(const AthenaIOUring *athenaIOUring)
+{
+    return athenaIOUring->ringFd;
+}
+
+int
+athenaIOUring_Receive(AthenaIOUring *athenaIOUring, AthenaIOUring_ReceiveCallback *callback, void *context)
+{
+    athenaIOUring->callback = callback;
+    athenaIOUring->context = context;
+    if (athenaIOUring->receiveArmed) {
+        return 0;
+    }
+    if (_postReceive(athenaIOUring) == -1) {
+        return -1;
+    }
+    return (_enter(athenaIOUring, 0) == -1) ? -1 : 0;
+}
+
+void
+athenaIOUring_StopReceive(AthenaIOUring *athenaIOUring)
+{
+    athenaIOUring->callback = NULL;
+    athenaIOUring->context = NULL;
+    if (athenaIOUring->receiveArmed) {
+        struct io_uring_sqe *sqe = _getSqe(athenaIOUring);
+        if (sqe) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = _ATHENA_IOURING_RECEIVE;
+            sqe->user_data = _ATHENA_IOURING_CANCEL;
+            _enter(athenaIOUring, 0);
+        }
+    }
+}
+
+int
+athenaIOUring_Submit(AthenaIOUring *athenaIOUring)
+{
+    int submitted = 0;
+
+    // A stream's sends go out as one linked chain at a time, so the kernel can't reorder them.
+    while (athenaIOUring->pendingHead && ((athenaIOUring->stream == false) || (athenaIOUring->sendsInFlight == 0))) {
+        struct io_uring_sqe *previous = NULL;
+        unsigned space = athenaIOUring->sqEntries - (athenaIOUring->sqLocalTail - __atomic_load_n(athenaIOUring->sqHead, __ATOMIC_ACQUIRE));
+        for (; (space > 0) && athenaIOUring->pendingHead; space--) {
+            _AthenaIOUringSend *send = athenaIOUring->pendingHead;
+            struct io_uring_sqe *sqe = _getSqe(athenaIOUring);
+            athenaIOUring->pendingHead = send->next;
+            athenaIOUring->sendsPending--;
+
+            sqe->opcode = IORING_OP_SENDMSG;
+            sqe->fd = athenaIOUring->fd;
+            sqe->addr = (uint64_t) (uintptr_t) &send->header;
+            sqe->len = 1;
+            sqe->msg_flags = MSG_NOSIGNAL | (athenaIOUring->stream ? MSG_WAITALL : 0);
+            sqe->user_data = (uint64_t) (uintptr_t) send;
+            if (athenaIOUring->stream && previous) {
+                previous->flags |= IOSQE_IO_LINK;
+            }
+            previous = sqe;
+            athenaIOUring->sendsInFlight++;
+            submitted++;
+        }
+        if (athenaIOUring->pendingHead == NULL) {
+            athenaIOUring->pendingTail = NULL;
+        }
+        if (_enter(athenaIOUring, 0) == -1) {
+            return -1;
+        }
+    }
+
+    // Anything else written to the queue, such as a receive
+    if (_enter(athenaIOUring, 0) == -1) {
+        return -1;
+    }
+    return submitted;
+}
+
+int
+athenaIOUring_Send(AthenaIOUring *athenaIOUring, PARCBuffer *buffer,
+                   const struct sockaddr *peerAddress, socklen_t peerAddressLength)
+{
+    if (peerAddressLength > sizeof(struct sockaddr_storage)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Every send is outstanding, as when a socket's send buffer is full the message is dropped
+    if (athenaIOUring->freeSends == NULL) {
+        athenaIOUring_Reap(athenaIOUring);
+        if (athenaIOUring->freeSends == NULL) {
+            athenaIOUring->sendFailures++;
+            errno = ENOBUFS;
+            return -1;
+        }
+    }
+
+    _AthenaIOUringSend *send = athenaIOUring->freeSends;
+    athenaIOUring->freeSends = send->next;
+
+    send->buffer = parcBuffer_Acquire(buffer);
+    size_t length = parcBuffer_Remaining(buffer);
+    send->iov.iov_base = parcBuffer_Overlay(buffer, 0);
+    send->iov.iov_len = length;
+    memset(&send->header, 0, sizeof(send->header));
+    send->header.msg_iov = &send->iov;
+    send->header.msg_iovlen = 1;
+    if (peerAddress) {
+        memcpy(&send->peerAddress, peerAddress, peerAddressLength);
+        send->header.msg_name = &send->peerAddress;
+        send->header.msg_namelen = peerAddressLength;
+    }
+
+    send->next = NULL;
+    if (athenaIOUring->pendingTail) {
+        athenaIOUring->pendingTail->next = send;
+    } else {
+        athenaIOUring->pendingHead = send;
+    }
+    athenaIOUring->pendingTail = send;
+    athenaIOUring->sendsPending++;
+
+    // Don't let a burst of sends hold more than a queue's worth back
+    if (athenaIOUring->sendsPending >= athenaIOUring->sqEntries) {
+        athenaIOUring_Submit(athenaIOUring);
+    }
+    return 0;
+}
+
+size_t
+athenaIOUring_Reap(AthenaIOUring *athenaIOUring)
+{
+    // A receive callback may drop the last outside reference to the ring
+    athenaIOUring_Acquire(athenaIOUring);
+    size_t count = _reap(athenaIOUring);
+    athenaIOUring_Submit(athenaIOUring);
+    athenaIOUring_Release(&athenaIOUring);
+    return count;
+}
+
+size_t
+athenaIOUring_GetSendFailures(const AthenaIOUring *athenaIOUring)
+{
+    return athenaIOUring->sendFailures;
+}
+
+#else // HAVE_LINUX_IO_URING
+
+AthenaIOUring *
+athenaIOUring_Create(int fd, bool stream, unsigned bufferCount, size_t bufferSize)
+{
+    errno = ENOTSUP;
+    return NULL;
+}
+
+AthenaIOUring *
+athenaIOUring_Acquire(const AthenaIOUring *athenaIOUring)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+void
+athenaIOUring_Release(AthenaIOUring **athenaIOUring)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+int
+athenaIOUring_GetEventFd(const AthenaIOUring *athenaIOUring)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+int
+athenaIOUring_Receive(AthenaIOUring *athenaIOUring, AthenaIOUring_ReceiveCallback *callback, void *context)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+void
+athenaIOUring_StopReceive(AthenaIOUring *athenaIOUring)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+int
+athenaIOUring_Send(AthenaIOUring *athenaIOUring, PARCBuffer *buffer,
+                   const struct sockaddr *peerAddress, socklen_t peerAddressLength)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+int
+athenaIOUring_Submit(AthenaIOUring *athenaIOUring)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+size_t
+athenaIOUring_Reap(AthenaIOUring *athenaIOUring)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+size_t
+athenaIOUring_GetSendFailures(const AthenaIOUring *athenaIOUring)
+{
+    trapNotImplemented("io_uring is not supported on this platform");
+}
+
+#endif // HAVE_LINUX_IO_URING
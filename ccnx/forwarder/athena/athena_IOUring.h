@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_IOUring
+#define libathena_IOUring
+
+#include <stdbool.h>
+#include <sys/socket.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+/*
+ * An io_uring based I/O engine for socket links.
+ *
+ * Each ring services a single socket.  Receives are posted once as a multishot request drawing from a
+ * ring of provided buffers, so a busy socket delivers a stream of completions without a system call per
+ * message.  Sends are queued as submission entries and handed to the kernel in batches when the owning
+ * link module submits, typically once per adapter poll.  Sends on a stream socket are linked so that the
+ * kernel issues them in order.
+ *
+ * The ring's file descriptor becomes readable when completions are waiting, and is registered as the
+ * link's event fd so that completions are reaped from the forwarder's own polling loop.
+ *
+ * io_uring is optional.  When the kernel, or the build platform, doesn't support it athenaIOUring_Create
+ * fails and link modules fall back to their poll based implementations.
+ */
+
+/**
+ * @typedef AthenaIOUring
+ * @brief io_uring engine instance private data
+ */
+typedef struct AthenaIOUring AthenaIOUring;
+
+/**
+ * @typedef AthenaIOUring_ReceiveCallback
+ * @brief Called for each message (datagram) or chunk (stream) received on the ring's socket
+ *
+ * The data is only valid for the duration of the call.  A zero length with a zero error marks the end of
+ * a stream, a non-zero error means that receiving has stopped.
+ */
+typedef void (AthenaIOUring_ReceiveCallback)(void *context, const uint8_t *data, size_t length,
+                                             const struct sockaddr *peerAddress, socklen_t peerAddressLength,
+                                             int error);
+
+/**
+ * @abstract create a new io_uring engine for a socket
+ * @discussion
+ *
+ * The socket must already be bound, or connected.  Receiving begins when athenaIOUring_Receive is called.
+ *
+ * @param [in] fd socket serviced by the ring
+ * @param [in] stream true for a stream socket, false for a datagram socket
+ * @param [in] bufferCount number of receive buffers provided to the kernel, rounded up to a power of two
+ * @param [in] bufferSize size of each receive buffer, the largest datagram that can be received
+ * @return pointer to new instance, or NULL with errno set if io_uring is not available
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaIOUring *athenaIOUring = athenaIOUring_Create(fd, false, 64, 65536);
+ *     if (athenaIOUring == NULL) {
+ *         // fall back to poll(2) and recv(2)
+ *     }
+ * }
+ * @endcode
+ */
+AthenaIOUring *athenaIOUring_Create(int fd, bool stream, unsigned bufferCount, size_t bufferSize);
+
+/**
+ * @abstract obtain a new reference to an io_uring engine
+ * @discussion
+ *
+ * @param [in] athenaIOUring instance to acquire a reference to
+ * @return pointer to new reference
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaIOUring *newReference = athenaIOUring_Acquire(athenaIOUring);
+ * }
+ * @endcode
+ */
+AthenaIOUring *athenaIOUring_Acquire(const AthenaIOUring *athenaIOUring);
+
+/**
+ * @abstract release an io_uring engine reference
+ * @discussion
+ *
+ * When the last reference is released outstanding requests are cancelled, and waited for, before
+ * the ring is torn down.  The ring holds its own duplicate of the socket's descriptor, closing the
+ * socket that was passed to athenaIOUring_Create is up to the caller.
+ *
+ * @param [in] athenaIOUring instance to release
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaIOUring_Release(&athenaIOUring);
+ * }
+ * @endcode
+ */
+void athenaIOUring_Release(AthenaIOUring **athenaIOUring);
+
+/**
+ * @abstract return the ring's file descriptor, readable when there are completions to reap
+ * @discussion
+ *
+ * @param [in] athenaIOUring instance
+ * @return file descriptor
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaTransportLink_SetEventFd(athenaTransportLink, athenaIOUring_GetEventFd(athenaIOUring));
+ * }
+ * @endcode
+ */
+int athenaIOUring_GetEventFd(const AthenaIOUring *athenaIOUring);
+
+/**
+ * @abstract start receiving on the ring's socket
+ * @discussion
+ *
+ * The callback is invoked from athenaIOUring_Reap.  If the kernel stops the multishot receive because it
+ * ran out of buffers it is posted again once buffers have been returned.
+ *
+ * @param [in] athenaIOUring instance
+ * @param [in] callback called with each received message
+ * @param [in] context passed to the callback
+ * @return 0 on success, -1 with errno set on failure
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaIOUring_Receive(athenaIOUring, _receiveCallback, athenaTransportLink);
+ * }
+ * @endcode
+ */
+int athenaIOUring_Receive(AthenaIOUring *athenaIOUring, AthenaIOUring_ReceiveCallback *callback, void *context);
+
+/**
+ * @abstract stop delivering received messages
+ * @discussion
+ *
+ * Cancels the outstanding receive.  Any completions still to be reaped are discarded.
+ *
+ * @param [in] athenaIOUring instance
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaIOUring_StopReceive(athenaIOUring);
+ * }
+ * @endcode
+ */
+void athenaIOUring_StopReceive(AthenaIOUring *athenaIOUring);
+
+/**
+ * @abstract queue a buffer to be sent
+ * @discussion
+ *
+ * A reference to the buffer is held until the kernel has completed the send.  The buffer's contents,
+ * from its position to its limit, must not be modified in the mean time.  The send is not issued until
+ * athenaIOUring_Submit is called, or the submission queue fills.  If the ring already has as many sends
+ * outstanding as it can track, because the socket isn't draining, the send fails with ENOBUFS.
+ *
+ * @param [in] athenaIOUring instance
+ * @param [in] buffer message to send
+ * @param [in] peerAddress destination for an unconnected datagram socket, otherwise NULL
+ * @param [in] peerAddressLength length of the destination address
+ * @return 0 on success, -1 with errno set on failure
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaIOUring_Send(athenaIOUring, wireFormatBuffer, (struct sockaddr *) &peerAddress, peerAddressLength);
+ * }
+ * @endcode
+ */
+int athenaIOUring_Send(AthenaIOUring *athenaIOUring, PARCBuffer *buffer,
+                       const struct sockaddr *peerAddress, socklen_t peerAddressLength);
+
+/**
+ * @abstract hand queued requests to the kernel
+ * @discussion
+ *
+ * On a stream socket sends queued after a batch that is still in flight are held back until that batch
+ * completes, to preserve their order.
+ *
+ * @param [in] athenaIOUring instance
+ * @return number of requests submitted, or -1 with errno set on failure
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaIOUring_Submit(athenaIOUring);
+ * }
+ * @endcode
+ */
+int athenaIOUring_Submit(AthenaIOUring *athenaIOUring);
+
+/**
+ * @abstract process completed requests without blocking
+ * @discussion
+ *
+ * Invokes the receive callback for received messages, releases the buffers of completed sends,
+ * returns consumed receive buffers to the kernel, and submits any queued requests.
+ *
+ * @param [in] athenaIOUring instance
+ * @return number of completions processed
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaIOUring_Reap(athenaIOUring);
+ * }
+ * @endcode
+ */
+size_t athenaIOUring_Reap(AthenaIOUring *athenaIOUring);
+
+/**
+ * @abstract return the number of sends that failed, or were not issued, since the ring was created
+ * @discussion
+ *
+ * @param [in] athenaIOUring instance
+ * @return count of failed sends
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t failures = athenaIOUring_GetSendFailures(athenaIOUring);
+ * }
+ * @endcode
+ */
+size_t athenaIOUring_GetSendFailures(const AthenaIOUring *athenaIOUring);
+#endif // libathena_IOUring
@@ -66,6 +66,7 @@
 #include <pthread.h>
 #include <sys/param.h>
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "athena_InterestControl.h"
 
@@ -141,6 +142,8 @@ _create_stats_response(Athena *athena, CCNxName *ccnxName)
                         athena->stats.numProcessedControlMessages);
     parcJSON_AddInteger(json, "numProcessedInterestReturns",
                         athena->stats.numProcessedInterestReturns);
+    parcJSON_AddInteger(json, "numDroppedUndecoded",
+                        athena->stats.numDroppedUndecoded);
 
     char *jsonString = parcJSON_ToString(json);
 
@@ -356,6 +359,64 @@ _Control_Command(Athena *athena, CCNxInterest *interest)
     return responseMessage;
 }
 
+static CCNxMetaMessage *
+_PIT_Command_Overflow(Athena *athena, CCNxName *ccnxName, CCNxInterest *interest)
+{
+    // Overflow arguments "<reject|evictOldest|evictSoonestExpiring>"
+    char *arguments = _get_arguments(interest);
+    if (arguments == NULL) {
+        return _create_response(athena, ccnxName, "Expected <reject|evictOldest|evictSoonestExpiring> argument");
+    }
+
+    CCNxMetaMessage *responseMessage;
+    AthenaPITOverflowPolicy policy;
+    if (athenaPIT_OverflowPolicyFromName(arguments, &policy)) {
+        athenaPIT_SetOverflowPolicy(athena->athenaPIT, policy);
+        athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s", arguments);
+        responseMessage = _create_response(athena, ccnxName, "PIT overflow policy set to %s", athenaPIT_OverflowPolicyName(policy));
+    } else {
+        responseMessage = _create_response(athena, ccnxName, "Unknown PIT overflow policy %s", arguments);
+    }
+
+    parcMemory_Deallocate(&arguments);
+    return responseMessage;
+}
+
+static CCNxMetaMessage *
+_PIT_Command_Quota(Athena *athena, CCNxName *ccnxName, CCNxInterest *interest)
+{
+    // Quota arguments "<none|static|proportional> [<limit>]", static limits are in entries, proportional ones
+    // in percent of each active link's share of the PIT
+    char *arguments = _get_arguments(interest);
+    if (arguments == NULL) {
+        return _create_response(athena, ccnxName, "Expected <none|static|proportional> [<limit>] arguments");
+    }
+
+    char modeName[MAXPATHLEN];
+    size_t limit = 100;
+    int argumentCount = sscanf(arguments, "%s %zu", modeName, &limit);
+
+    CCNxMetaMessage *responseMessage;
+    if ((argumentCount >= 1) && (strcasecmp(modeName, "none") == 0)) {
+        athenaPIT_SetLinkQuota(athena->athenaPIT, AthenaPITLinkQuotaMode_None, 0);
+        athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s", arguments);
+        responseMessage = _create_response(athena, ccnxName, "PIT link quota removed");
+    } else if ((argumentCount == 2) && (strcasecmp(modeName, "static") == 0)) {
+        athenaPIT_SetLinkQuota(athena->athenaPIT, AthenaPITLinkQuotaMode_Static, limit);
+        athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s", arguments);
+        responseMessage = _create_response(athena, ccnxName, "PIT link quota set to %zu entries", limit);
+    } else if ((argumentCount >= 1) && (strcasecmp(modeName, "proportional") == 0)) {
+        athenaPIT_SetLinkQuota(athena->athenaPIT, AthenaPITLinkQuotaMode_Proportional, limit);
+        athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s", arguments);
+        responseMessage = _create_response(athena, ccnxName, "PIT link quota set to %zu%% of each active link's share", limit);
+    } else {
+        responseMessage = _create_response(athena, ccnxName, "Expected <none|static|proportional> [<limit>] arguments");
+    }
+
+    parcMemory_Deallocate(&arguments);
+    return responseMessage;
+}
+
 static CCNxMetaMessage *
 _PIT_Command(Athena *athena, CCNxInterest *interest)
 {
@@ -382,6 +443,10 @@ _PIT_Command(Athena *athena, CCNxInterest *interest)
             }
             parcList_Release(&pitEntries);
             responseMessage = _create_response(athena, ccnxName, "PIT listed on forwarder output log.");
+        } else if (strcasecmp(command, AthenaCommand_Overflow) == 0) {
+            responseMessage = _PIT_Command_Overflow(athena, ccnxName, interest);
+        } else if (strcasecmp(command, AthenaCommand_Quota) == 0) {
+            responseMessage = _PIT_Command_Quota(athena, ccnxName, interest);
         } else {
             responseMessage = _create_response(athena, ccnxName, "Unknown command: %s", command);
         }
@@ -439,6 +504,8 @@ _create_FIBList_response(Athena *athena, CCNxName *ccnxName, PARCList *fibEntryL
                 PARCJSON *jsonItem = parcJSON_Create();
                 parcJSON_AddString(jsonItem, JSON_KEY_NAME, prefix);
                 parcJSON_AddString(jsonItem, JSON_KEY_LINK, linkName);
+                parcJSON_AddInteger(jsonItem, JSON_KEY_COST, athenaFIBListEntry_GetCost(entry));
+                parcJSON_AddInteger(jsonItem, JSON_KEY_WEIGHT, athenaFIBListEntry_GetWeight(entry));
 
                 PARCJSONValue *jsonItemValue = parcJSONValue_CreateFromJSON(jsonItem);
                 parcJSON_Release(&jsonItem);
@@ -455,6 +522,8 @@ _create_FIBList_response(Athena *athena, CCNxName *ccnxName, PARCList *fibEntryL
                 PARCJSON *jsonItem = parcJSON_Create();
                 parcJSON_AddString(jsonItem, JSON_KEY_NAME, "");
                 parcJSON_AddString(jsonItem, JSON_KEY_LINK, linkName);
+                parcJSON_AddInteger(jsonItem, JSON_KEY_COST, athenaFIBListEntry_GetCost(entry));
+                parcJSON_AddInteger(jsonItem, JSON_KEY_WEIGHT, athenaFIBListEntry_GetWeight(entry));
 
                 PARCJSONValue *jsonItemValue = parcJSONValue_CreateFromJSON(jsonItem);
                 parcJSON_Release(&jsonItem);
@@ -490,6 +559,218 @@ _create_FIBList_response(Athena *athena, CCNxName *ccnxName, PARCList *fibEntryL
     return result;
 }
 
+static CCNxMetaMessage *
+_FIB_Command_Strategy(Athena *athena, CCNxName *ccnxName, CCNxInterest *interest)
+{
+    CCNxMetaMessage *responseMessage;
+
+    char *arguments = _get_arguments(interest);
+    if (arguments == NULL) {
+        return _create_response(athena, ccnxName, "No prefix or strategy arguments given to %s command", AthenaCommand_Strategy);
+    }
+
+    // Strategy arguments "<prefix> <strategyName>"
+    char prefix[MAXPATHLEN];
+    char strategyName[MAXPATHLEN];
+    if (sscanf(arguments, "%s %s", prefix, strategyName) != 2) {
+        responseMessage = _create_response(athena, ccnxName, "Expected <prefix> <strategy> arguments");
+        parcMemory_Deallocate(&arguments);
+        return responseMessage;
+    }
+    parcMemory_Deallocate(&arguments);
+
+    AthenaForwardingStrategyInterface *strategyInterface = athenaForwardingStrategy_LookupInterface(strategyName);
+    if (strategyInterface == NULL) {
+        return _create_response(athena, ccnxName, "Unknown strategy %s", strategyName);
+    }
+
+    CCNxName *prefixName = ccnxName_CreateFromCString(prefix);
+    if (prefixName == NULL) {
+        return _create_response(athena, ccnxName, "Unable to parse prefix %s", prefix);
+    }
+
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(strategyInterface, &athena->strategyConfig);
+    if (athenaFIB_SetStrategy(athena->athenaFIB, prefixName, strategy)) {
+        char *strategyPrefix = ccnxName_ToString(prefixName);
+        responseMessage = _create_response(athena, ccnxName, "strategy %s -> %s", strategyPrefix, strategyInterface->name);
+        athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s %s", strategyPrefix, strategyInterface->name);
+        parcMemory_Deallocate(&strategyPrefix);
+    } else {
+        responseMessage = _create_response(athena, ccnxName, "%s failed", AthenaCommand_Strategy);
+    }
+    athenaForwardingStrategy_Release(&strategy);
+    ccnxName_Release(&prefixName);
+
+    return responseMessage;
+}
+
+/**
+ * @typedef AthenaRouteLoad
+ * @brief Routes given to a load command, built into a FIB on their own thread
+ */
+struct athena_route_load {
+    pthread_t thread;
+    bool started;
+    pthread_mutex_t lock;
+    bool finished;
+    char *routes;
+    char **linkNames;   // names of the links open when the load started, indexed by link id
+    int linkNamesSize;
+    AthenaFIB *routeFIB;
+    ssize_t loaded;
+    size_t errorLine;
+};
+
+static void
+_athenaRouteLoad_Destroy(AthenaRouteLoad **routeLoadPtr)
+{
+    AthenaRouteLoad *routeLoad = *routeLoadPtr;
+
+    if (routeLoad->started) {
+        pthread_join(routeLoad->thread, NULL);
+    }
+    pthread_mutex_destroy(&routeLoad->lock);
+    for (int linkId = 0; linkId < routeLoad->linkNamesSize; linkId++) {
+        if (routeLoad->linkNames[linkId]) {
+            parcMemory_Deallocate(&routeLoad->linkNames[linkId]);
+        }
+    }
+    if (routeLoad->linkNames) {
+        parcMemory_Deallocate(&routeLoad->linkNames);
+    }
+    if (routeLoad->routeFIB) {
+        athenaFIB_Release(&routeLoad->routeFIB);
+    }
+    parcMemory_Deallocate(&routeLoad->routes);
+    parcMemory_Deallocate(routeLoadPtr);
+}
+
+// The adapter belongs to the forwarder thread, so routes are resolved against the links open at the start
+static int
+_FIB_ResolveLinkName(AthenaFIB_LinkResolverContext context, const char *linkName)
+{
+    AthenaRouteLoad *routeLoad = (AthenaRouteLoad *) context;
+    for (int linkId = 0; linkId < routeLoad->linkNamesSize; linkId++) {
+        if (routeLoad->linkNames[linkId] && (strcmp(routeLoad->linkNames[linkId], linkName) == 0)) {
+            return linkId;
+        }
+    }
+    return -1;
+}
+
+static void *
+_FIB_BuildRoutes(void *arg)
+{
+    AthenaRouteLoad *routeLoad = (AthenaRouteLoad *) arg;
+
+    size_t routeCount = 1;
+    for (const char *c = routeLoad->routes; (c = strchr(c, '\n')) != NULL; c++) {
+        routeCount++;
+    }
+    AthenaFIB *routeFIB = athenaFIB_CreateCapacity(routeCount);
+    ssize_t loaded = athenaFIB_LoadRoutes(routeFIB, routeLoad->routes, _FIB_ResolveLinkName, routeLoad, &routeLoad->errorLine);
+
+    pthread_mutex_lock(&routeLoad->lock);
+    routeLoad->routeFIB = routeFIB;
+    routeLoad->loaded = loaded;
+    routeLoad->finished = true;
+    pthread_mutex_unlock(&routeLoad->lock);
+
+    return NULL;
+}
+
+static CCNxMetaMessage *
+_FIB_Command_Load(Athena *athena, CCNxName *ccnxName, CCNxInterest *interest)
+{
+    if (athena->routeLoad) {
+        return _create_response(athena, ccnxName, "%s already in progress", AthenaCommand_Load);
+    }
+
+    // The routes themselves are the payload, the forwarder doesn't open files on behalf of its peers
+    char *routes = _get_arguments(interest);
+    if (routes == NULL) {
+        return _create_response(athena, ccnxName, "No routes given to %s command", AthenaCommand_Load);
+    }
+
+    AthenaRouteLoad *routeLoad = parcMemory_AllocateAndClear(sizeof(AthenaRouteLoad));
+    assertNotNull(routeLoad, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(AthenaRouteLoad));
+    routeLoad->routes = routes;
+    pthread_mutex_init(&routeLoad->lock, NULL);
+
+    int linkIdLimit = athenaTransportLinkAdapter_LinkIdLimit(athena->athenaTransportLinkAdapter);
+    if (linkIdLimit > 0) {
+        routeLoad->linkNames = parcMemory_AllocateAndClear(linkIdLimit * sizeof(char *));
+        assertNotNull(routeLoad->linkNames, "parcMemory_AllocateAndClear(%zu) returned NULL", linkIdLimit * sizeof(char *));
+        routeLoad->linkNamesSize = linkIdLimit;
+    }
+    for (int linkId = 0; linkId < linkIdLimit; linkId++) {
+        const char *linkName = athenaTransportLinkAdapter_LinkIdToName(athena->athenaTransportLinkAdapter, linkId);
+        if (linkName) {
+            routeLoad->linkNames[linkId] = parcMemory_StringDuplicate(linkName, strlen(linkName));
+        }
+    }
+
+    // Build the new routes aside and swap them in whole from the forwarder thread once built
+    if (pthread_create(&routeLoad->thread, NULL, _FIB_BuildRoutes, routeLoad) != 0) {
+        _athenaRouteLoad_Destroy(&routeLoad);
+        return _create_response(athena, ccnxName, "%s failed to start: %s", AthenaCommand_Load, strerror(errno));
+    }
+    routeLoad->started = true;
+    athena->routeLoad = routeLoad;
+
+    return _create_response(athena, ccnxName, "%s started", AthenaCommand_Load);
+}
+
+bool
+athenaInterestControl_SwapLoadedRoutes(Athena *athena)
+{
+    AthenaRouteLoad *routeLoad = athena->routeLoad;
+    if (routeLoad == NULL) {
+        return false;
+    }
+
+    pthread_mutex_lock(&routeLoad->lock);
+    bool finished = routeLoad->finished;
+    pthread_mutex_unlock(&routeLoad->lock);
+    if (!finished) {
+        return true;
+    }
+    athena->routeLoad = NULL;
+
+    if (routeLoad->loaded < 0) {
+        parcLog_Error(athena->log, "%s failed, invalid route at line %zu", AthenaCommand_Load, routeLoad->errorLine);
+    } else {
+        // Drop routes to links that were closed, or whose id was reused, while the routes were built
+        PARCBitVector *closedLinks = parcBitVector_Create();
+        for (int linkId = 0; linkId < routeLoad->linkNamesSize; linkId++) {
+            if (routeLoad->linkNames[linkId]) {
+                const char *linkName = athenaTransportLinkAdapter_LinkIdToName(athena->athenaTransportLinkAdapter, linkId);
+                if ((linkName == NULL) || (strcmp(linkName, routeLoad->linkNames[linkId]) != 0)) {
+                    parcBitVector_Set(closedLinks, linkId);
+                }
+            }
+        }
+        if (parcBitVector_NumberOfBitsSet(closedLinks) > 0) {
+            athenaFIB_RemoveLink(routeLoad->routeFIB, closedLinks);
+        }
+        parcBitVector_Release(&closedLinks);
+
+        athenaFIB_SwapRoutes(athena->athenaFIB, routeLoad->routeFIB);
+        parcLog_Info(athena->log, "%s %zd routes", AthenaCommand_Load, routeLoad->loaded);
+    }
+    _athenaRouteLoad_Destroy(&routeLoad);
+
+    return false;
+}
+
+void
+athenaInterestControl_CancelRouteLoad(Athena *athena)
+{
+    if (athena->routeLoad) {
+        _athenaRouteLoad_Destroy(&athena->routeLoad);
+    }
+}
+
 static CCNxMetaMessage *
 _FIB_Command(Athena *athena, CCNxInterest *interest, PARCBitVector *ingress)
 {
@@ -515,11 +796,14 @@ _FIB_Command(Athena *athena, CCNxInterest *interest, PARCBitVector *ingress)
 
             char linkName[MAXPATHLEN];
             char prefix[MAXPATHLEN];
+            unsigned cost = AthenaNexthop_DefaultCost;
+            unsigned weight = AthenaNexthop_DefaultWeight;
             PARCBitVector *linkVector;
 
-            // {Add,Remove} Route arguments "<prefix> [<linkName>]", if linkName not specified, use the incoming link id ([de-]registration)
-            int numberOfArguments = sscanf(arguments, "%s %s", prefix, linkName);
-            if (numberOfArguments == 2) {
+            // {Add,Remove} Route arguments "<prefix> [<linkName> [<cost> [<weight>]]]", if linkName not specified,
+            // use the incoming link id ([de-]registration)
+            int numberOfArguments = sscanf(arguments, "%s %s %u %u", prefix, linkName, &cost, &weight);
+            if (numberOfArguments >= 2) {
                 int linkId = athenaTransportLinkAdapter_LinkNameToId(athena->athenaTransportLinkAdapter, linkName);
                 if (linkId == -1) {
                     responseMessage = _create_response(athena, ccnxName, "Unknown linkName %s", linkName);
@@ -549,7 +833,7 @@ _FIB_Command(Athena *athena, CCNxInterest *interest, PARCBitVector *ingress)
 
             int result = false;
             if (strcasecmp(command, AthenaCommand_Add) == 0) {
-                result = athenaFIB_AddRoute(athena->athenaFIB, prefixName, linkVector);
+                result = athenaFIB_AddRouteWithCost(athena->athenaFIB, prefixName, linkVector, cost, weight);
             } else if (strcasecmp(command, AthenaCommand_Remove) == 0) {
                 result = athenaFIB_DeleteRoute(athena->athenaFIB, prefixName, linkVector);
             }
@@ -567,6 +851,10 @@ _FIB_Command(Athena *athena, CCNxInterest *interest, PARCBitVector *ingress)
             ccnxName_Release(&prefixName);
 
             parcMemory_Deallocate(&arguments);
+        } else if (strcasecmp(command, AthenaCommand_Strategy) == 0) {
+            responseMessage = _FIB_Command_Strategy(athena, ccnxName, interest);
+        } else if (strcasecmp(command, AthenaCommand_Load) == 0) {
+            responseMessage = _FIB_Command_Load(athena, ccnxName, interest);
         } else if (strcasecmp(command, AthenaCommand_List) == 0) {
             // Need to create the response here because as the FIB doesn't know the linkName
             parcLog_Debug(athena->log, "FIB List command invoked");
@@ -582,6 +870,59 @@ _FIB_Command(Athena *athena, CCNxInterest *interest, PARCBitVector *ingress)
     return responseMessage;
 }
 
+static CCNxMetaMessage *
+_TransportLinkAdapter_Command_Queue(Athena *athena, CCNxName *ccnxName, const char *arguments)
+{
+    // Queue arguments "<linkName|default> <class> <weight> <queueLimit>"
+    char linkName[MAXPATHLEN];
+    char className[MAXPATHLEN];
+    size_t weight;
+    size_t queueLimit;
+    if (sscanf(arguments, "%s %s %zu %zu", linkName, className, &weight, &queueLimit) != 4) {
+        return _create_response(athena, ccnxName, "Expected <linkName|default> <class> <weight> <queueLimit> arguments");
+    }
+
+    AthenaEgressClass egressClass;
+    if (athenaEgressScheduler_ClassFromName(className, &egressClass) == false) {
+        return _create_response(athena, ccnxName, "Unknown egress class %s", className);
+    }
+
+    const char *configuredLink = (strcasecmp(linkName, "default") == 0) ? NULL : linkName;
+    if (athenaTransportLinkAdapter_SetEgressClass(athena->athenaTransportLinkAdapter, configuredLink,
+                                                  egressClass, weight, queueLimit) != 0) {
+        return _create_response(athena, ccnxName, "Unknown linkName %s", linkName);
+    }
+
+    athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s", arguments);
+    return _create_response(athena, ccnxName, "%s %s weight %zu queue limit %zu", linkName,
+                            athenaEgressScheduler_ClassName(egressClass), weight, queueLimit);
+}
+
+static CCNxMetaMessage *
+_TransportLinkAdapter_Command_Shape(Athena *athena, CCNxName *ccnxName, const char *arguments)
+{
+    // Shape arguments "<linkName|default> <bitsPerSecond> [<maxDelay>]", a bandwidth of 0 disables shaping
+    char linkName[MAXPATHLEN];
+    uint64_t bandwidth;
+    uint64_t maxDelay = AthenaInterestShaper_DefaultMaxDelay;
+    if (sscanf(arguments, "%s %" SCNu64 " %" SCNu64, linkName, &bandwidth, &maxDelay) < 2) {
+        return _create_response(athena, ccnxName, "Expected <linkName|default> <bitsPerSecond> [<maxDelay>] arguments");
+    }
+
+    const char *configuredLink = (strcasecmp(linkName, "default") == 0) ? NULL : linkName;
+    if (athenaTransportLinkAdapter_SetInterestShaping(athena->athenaTransportLinkAdapter, configuredLink,
+                                                      bandwidth, maxDelay) != 0) {
+        return _create_response(athena, ccnxName, "Unknown linkName %s", linkName);
+    }
+
+    athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s", arguments);
+    if (bandwidth == 0) {
+        return _create_response(athena, ccnxName, "%s Interest shaping disabled", linkName);
+    }
+    return _create_response(athena, ccnxName, "%s Interests shaped to %" PRIu64 " bits per second, held up to %" PRIu64 " ms",
+                            linkName, bandwidth, maxDelay);
+}
+
 static CCNxMetaMessage *
 _TransportLinkAdapter_Command(Athena *athena, CCNxInterest *interest)
 {
@@ -629,6 +970,10 @@ _TransportLinkAdapter_Command(Athena *athena, CCNxInterest *interest)
                     athenaInterestControl_LogConfigurationChange(athena, ccnxName, "%s", arguments);
                 }
             }
+        } else if (strcasecmp(command, AthenaCommand_Queue) == 0) {
+            responseMessage = _TransportLinkAdapter_Command_Queue(athena, ccnxName, arguments);
+        } else if (strcasecmp(command, AthenaCommand_Shape) == 0) {
+            responseMessage = _TransportLinkAdapter_Command_Shape(athena, ccnxName, arguments);
         } else {
             responseMessage = _create_response(athena, ccnxName, "Unknown TransportLinkAdapter command %s", command);
         }
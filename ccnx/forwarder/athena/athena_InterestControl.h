@@ -66,6 +66,8 @@
 #define JSON_KEY_RESULT "result"
 #define JSON_KEY_NAME "name"
 #define JSON_KEY_LINK "link"
+#define JSON_KEY_COST "cost"
+#define JSON_KEY_WEIGHT "weight"
 
 /**
  * @abstract process a CCNx interest control message
@@ -114,4 +116,41 @@ int athenaInterestControl(Athena *athena, CCNxInterest *interest, PARCBitVector
  * @endcode
  */
 void athenaInterestControl_LogConfigurationChange(Athena *athena, CCNxName *ccnxName, const char *format, ...);
+
+/**
+ * @abstract swap in the routes of a finished load command
+ * @discussion
+ *
+ * Load commands build their routes on a thread of their own.  Called from the forwarder thread,
+ * this replaces the FIB's routes once they're built, leaving out routes to links closed in the
+ * meantime.
+ *
+ * @param [in] athena forwarder context
+ * @return true if routes are still being built
+ *
+ * Example:
+ * @code
+ * {
+ *     int receiveTimeout = athenaInterestControl_SwapLoadedRoutes(athena) ? 10 : -1;
+ *     ccnxMessage = athenaTransportLinkAdapter_ReceiveWireFormat(athena->athenaTransportLinkAdapter,
+ *                                                                &ingressVector, receiveTimeout);
+ * }
+ * @endcode
+ */
+bool athenaInterestControl_SwapLoadedRoutes(Athena *athena);
+
+/**
+ * @abstract wait for a load command's routes to be built and discard them
+ * @discussion
+ *
+ * @param [in] athena forwarder context
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaInterestControl_CancelRouteLoad(athena);
+ * }
+ * @endcode
+ */
+void athenaInterestControl_CancelRouteLoad(Athena *athena);
 #endif // libathena_InterestControl_h
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena_InterestShaper.h>
+
+//
+// Credit is kept in bit-milliseconds per second, the unit elapsed milliseconds times the bandwidth
+// in bits per second come to, so it's refilled without any division.
+//
+#define _CREDIT_PER_BYTE (8 * 1000)
+
+/**
+ * @typedef AthenaInterestShaper
+ * @brief Token bucket and the ring of held Interests
+ */
+struct athena_interest_shaper {
+    uint64_t bandwidth; // bits per second, 0 when disabled
+    uint64_t maxDelay;  // milliseconds
+    size_t objectSize;  // moving average of the Content Object sizes, in bytes
+    uint64_t credit;
+    uint64_t lastRefill;
+    bool refilled;      // whether lastRefill has been set
+    CCNxMetaMessage **held;
+    size_t head;
+    size_t count;
+    size_t capacity;
+    struct {
+        size_t forwarded;
+        size_t held;
+        size_t congested;
+    } stats;
+};
+
+static void
+_athenaInterestShaper_Finalize(AthenaInterestShaper **shaperPtr)
+{
+    AthenaInterestShaper *shaper = *shaperPtr;
+    for (size_t n = 0; n < shaper->count; n++) {
+        ccnxMetaMessage_Release(&shaper->held[(shaper->head + n) % shaper->capacity]);
+    }
+    if (shaper->held != NULL) {
+        parcMemory_Deallocate(&shaper->held);
+    }
+}
+
+parcObject_ExtendPARCObject(AthenaInterestShaper, _athenaInterestShaper_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementRelease(athenaInterestShaper, AthenaInterestShaper);
+
+AthenaInterestShaper *
+athenaInterestShaper_Create(void)
+{
+    AthenaInterestShaper *result = parcObject_CreateInstance(AthenaInterestShaper);
+    if (result != NULL) {
+        result->bandwidth = 0;
+        result->maxDelay = AthenaInterestShaper_DefaultMaxDelay;
+        result->objectSize = AthenaInterestShaper_DefaultObjectSize;
+        result->credit = 0;
+        result->lastRefill = 0;
+        result->refilled = false;
+        result->held = NULL;
+        result->head = 0;
+        result->count = 0;
+        result->capacity = 0;
+        result->stats.forwarded = 0;
+        result->stats.held = 0;
+        result->stats.congested = 0;
+    }
+    return result;
+}
+
+static uint64_t
+_athenaInterestShaper_Cost(const AthenaInterestShaper *shaper)
+{
+    return (uint64_t) shaper->objectSize * _CREDIT_PER_BYTE;
+}
+
+// The bucket holds a burst worth of the link's capacity, and at least enough for one Interest
+static uint64_t
+_athenaInterestShaper_BucketSize(const AthenaInterestShaper *shaper)
+{
+    uint64_t bucketSize = shaper->bandwidth * AthenaInterestShaper_Burst;
+    uint64_t cost = _athenaInterestShaper_Cost(shaper);
+    return (bucketSize > cost) ? bucketSize : cost;
+}
+
+static void
+_athenaInterestShaper_Refill(AthenaInterestShaper *shaper, uint64_t now)
+{
+    uint64_t bucketSize = _athenaInterestShaper_BucketSize(shaper);
+    if (shaper->refilled == false) {
+        shaper->credit = bucketSize;
+        shaper->refilled = true;
+    } else if (now > shaper->lastRefill) {
+        uint64_t elapsed = now - shaper->lastRefill;
+        if (elapsed > AthenaInterestShaper_Burst) { // a full bucket is reached by then, avoid overflowing
+            elapsed = AthenaInterestShaper_Burst;
+        }
+        shaper->credit += elapsed * shaper->bandwidth;
+    }
+    if (shaper->credit > bucketSize) {
+        shaper->credit = bucketSize;
+    }
+    shaper->lastRefill = now;
+}
+
+void
+athenaInterestShaper_SetBandwidth(AthenaInterestShaper *shaper, uint64_t bitsPerSecond)
+{
+    shaper->bandwidth = bitsPerSecond;
+    shaper->refilled = false; // start again with a full bucket
+}
+
+uint64_t
+athenaInterestShaper_GetBandwidth(const AthenaInterestShaper *shaper)
+{
+    return shaper->bandwidth;
+}
+
+void
+athenaInterestShaper_SetMaxDelay(AthenaInterestShaper *shaper, uint64_t maxDelay)
+{
+    shaper->maxDelay = maxDelay;
+}
+
+uint64_t
+athenaInterestShaper_GetMaxDelay(const AthenaInterestShaper *shaper)
+{
+    return shaper->maxDelay;
+}
+
+void
+athenaInterestShaper_ContentObjectReceived(AthenaInterestShaper *shaper, size_t length)
+{
+    shaper->objectSize = (shaper->objectSize * 7 + length) / 8;
+    if (shaper->objectSize == 0) {
+        shaper->objectSize = 1;
+    }
+}
+
+size_t
+athenaInterestShaper_GetObjectSize(const AthenaInterestShaper *shaper)
+{
+    return shaper->objectSize;
+}
+
+static bool
+_athenaInterestShaper_Hold(AthenaInterestShaper *shaper, CCNxMetaMessage *interest)
+{
+    if (shaper->count == shaper->capacity) {
+        size_t capacity = shaper->capacity ? (shaper->capacity * 2) : 16;
+        CCNxMetaMessage **held = parcMemory_Allocate(capacity * sizeof(CCNxMetaMessage *));
+        if (held == NULL) {
+            return false;
+        }
+        // Unwrap the ring into the new array
+        for (size_t n = 0; n < shaper->count; n++) {
+            held[n] = shaper->held[(shaper->head + n) % shaper->capacity];
+        }
+        if (shaper->held != NULL) {
+            parcMemory_Deallocate(&shaper->held);
+        }
+        shaper->held = held;
+        shaper->head = 0;
+        shaper->capacity = capacity;
+    }
+    shaper->held[(shaper->head + shaper->count) % shaper->capacity] = ccnxMetaMessage_Acquire(interest);
+    shaper->count++;
+    return true;
+}
+
+AthenaInterestShaperResult
+athenaInterestShaper_Admit(AthenaInterestShaper *shaper, CCNxMetaMessage *interest, uint64_t now)
+{
+    if (shaper->bandwidth == 0) {
+        shaper->stats.forwarded++;
+        return AthenaInterestShaper_Forward;
+    }
+
+    _athenaInterestShaper_Refill(shaper, now);
+    uint64_t cost = _athenaInterestShaper_Cost(shaper);
+    if ((shaper->count == 0) && (shaper->credit >= cost)) {
+        shaper->credit -= cost;
+        shaper->stats.forwarded++;
+        return AthenaInterestShaper_Forward;
+    }
+
+    // Time until the bucket has filled enough for the Interests already held and this one
+    uint64_t needed = (shaper->count + 1) * cost;
+    uint64_t delay = 0;
+    if (needed > shaper->credit) {
+        delay = (needed - shaper->credit + shaper->bandwidth - 1) / shaper->bandwidth;
+    }
+    if ((delay > shaper->maxDelay) || (shaper->count >= AthenaInterestShaper_QueueLimit) ||
+        (_athenaInterestShaper_Hold(shaper, interest) == false)) {
+        shaper->stats.congested++;
+        return AthenaInterestShaper_Congested;
+    }
+    shaper->stats.held++;
+    return AthenaInterestShaper_Held;
+}
+
+CCNxMetaMessage *
+athenaInterestShaper_Next(AthenaInterestShaper *shaper, uint64_t now)
+{
+    if (shaper->count == 0) {
+        return NULL;
+    }
+    if (shaper->bandwidth != 0) {
+        _athenaInterestShaper_Refill(shaper, now);
+        uint64_t cost = _athenaInterestShaper_Cost(shaper);
+        if (shaper->credit < cost) {
+            return NULL;
+        }
+        shaper->credit -= cost;
+    }
+
+    CCNxMetaMessage *interest = shaper->held[shaper->head];
+    shaper->head = (shaper->head + 1) % shaper->capacity;
+    shaper->count--;
+    return interest;
+}
+
+int64_t
+athenaInterestShaper_TimeUntilNext(AthenaInterestShaper *shaper, uint64_t now)
+{
+    if (shaper->count == 0) {
+        return -1;
+    }
+    if (shaper->bandwidth == 0) {
+        return 0;
+    }
+    _athenaInterestShaper_Refill(shaper, now);
+    uint64_t cost = _athenaInterestShaper_Cost(shaper);
+    if (shaper->credit >= cost) {
+        return 0;
+    }
+    return (int64_t) ((cost - shaper->credit + shaper->bandwidth - 1) / shaper->bandwidth);
+}
+
+size_t
+athenaInterestShaper_Depth(const AthenaInterestShaper *shaper)
+{
+    return shaper->count;
+}
+
+size_t
+athenaInterestShaper_GetForwardedCount(const AthenaInterestShaper *shaper)
+{
+    return shaper->stats.forwarded;
+}
+
+size_t
+athenaInterestShaper_GetHeldCount(const AthenaInterestShaper *shaper)
+{
+    return shaper->stats.held;
+}
+
+size_t
+athenaInterestShaper_GetCongestedCount(const AthenaInterestShaper *shaper)
+{
+    return shaper->stats.congested;
+}
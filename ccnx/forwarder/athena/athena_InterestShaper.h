@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_InterestShaper_h
+#define libathena_InterestShaper_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <ccnx/transport/common/transport_MetaMessage.h>
+
+/*
+ * Interest shaper interfaces
+ *
+ *    athenaInterestShaper_Create
+ *    athenaInterestShaper_Release
+ *
+ *    athenaInterestShaper_SetBandwidth
+ *    athenaInterestShaper_GetBandwidth
+ *    athenaInterestShaper_SetMaxDelay
+ *    athenaInterestShaper_GetMaxDelay
+ *    athenaInterestShaper_ContentObjectReceived
+ *    athenaInterestShaper_GetObjectSize
+ *    athenaInterestShaper_Admit
+ *    athenaInterestShaper_Next
+ *    athenaInterestShaper_TimeUntilNext
+ *    athenaInterestShaper_Depth
+ *    athenaInterestShaper_GetForwardedCount
+ *    athenaInterestShaper_GetHeldCount
+ *    athenaInterestShaper_GetCongestedCount
+ */
+
+/**
+ * Content Object size, in bytes, expected in return for each Interest until responses have been measured.
+ */
+#define AthenaInterestShaper_DefaultObjectSize 1500
+
+/**
+ * Milliseconds of link capacity that can be spent in a single burst of Interests.
+ */
+#define AthenaInterestShaper_Burst 50
+
+/**
+ * Milliseconds an Interest can be held waiting for capacity before it's refused instead.
+ */
+#define AthenaInterestShaper_DefaultMaxDelay 100
+
+/**
+ * Maximum number of Interests held by a shaper.
+ */
+#define AthenaInterestShaper_QueueLimit 4096
+
+/**
+ * @typedef AthenaInterestShaperResult
+ * @brief What to do with an Interest that has been offered to a link's shaper
+ */
+typedef enum {
+    AthenaInterestShaper_Forward,   // the link has capacity for the response, send the Interest now
+    AthenaInterestShaper_Held,      // the shaper holds the Interest until the link has capacity for its response
+    AthenaInterestShaper_Congested, // the link can't take the response within the maximum delay, refuse the Interest
+} AthenaInterestShaperResult;
+
+/**
+ * @typedef AthenaInterestShaper
+ * @brief Paces the Interests sent on a link to the rate its Content Objects can come back at
+ *
+ * Each Interest sent is charged the average size of the Content Objects received on the link against
+ * a token bucket filled at the link's bandwidth, so the traffic the Interests draw back stays under the
+ * link's capacity.  Interests that arrive while the bucket is empty are held, in order, until it has
+ * filled enough for them, or are refused if that would take longer than the maximum delay.
+ */
+struct athena_interest_shaper;
+typedef struct athena_interest_shaper AthenaInterestShaper;
+
+/**
+ * @abstract Create a shaper that forwards every Interest until it's given a bandwidth
+ *
+ * @return pointer to a new shaper, NULL on allocation failure
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaInterestShaper *shaper = athenaInterestShaper_Create();
+ *     athenaInterestShaper_SetBandwidth(shaper, 10000000);
+ *     athenaInterestShaper_Release(&shaper);
+ * }
+ * @endcode
+ */
+AthenaInterestShaper *athenaInterestShaper_Create(void);
+
+/**
+ * @abstract Release a shaper reference, Interests still held are released with the last reference
+ *
+ * @param [in,out] shaperPtr pointer to the reference, set to NULL on return
+ */
+void athenaInterestShaper_Release(AthenaInterestShaper **shaperPtr);
+
+/**
+ * @abstract Set the link bandwidth Interests are paced to
+ * @discussion
+ *
+ * A bandwidth of 0 disables shaping, held Interests are then released on the next call to athenaInterestShaper_Next.
+ *
+ * @param [in] shaper
+ * @param [in] bitsPerSecond capacity of the link in the direction responses arrive in
+ */
+void athenaInterestShaper_SetBandwidth(AthenaInterestShaper *shaper, uint64_t bitsPerSecond);
+
+/**
+ * @abstract Return the link bandwidth Interests are paced to
+ *
+ * @param [in] shaper
+ * @return bits per second, 0 if shaping is disabled
+ */
+uint64_t athenaInterestShaper_GetBandwidth(const AthenaInterestShaper *shaper);
+
+/**
+ * @abstract Set how long an Interest can be held before it's refused instead
+ *
+ * @param [in] shaper
+ * @param [in] maxDelay milliseconds, 0 refuses Interests the link has no immediate capacity for
+ */
+void athenaInterestShaper_SetMaxDelay(AthenaInterestShaper *shaper, uint64_t maxDelay);
+
+/**
+ * @abstract Return how long an Interest can be held before it's refused instead
+ *
+ * @param [in] shaper
+ * @return milliseconds
+ */
+uint64_t athenaInterestShaper_GetMaxDelay(const AthenaInterestShaper *shaper);
+
+/**
+ * @abstract Account for a Content Object received on the link
+ * @discussion
+ *
+ * The size charged for each Interest is a moving average of the sizes reported here.
+ *
+ * @param [in] shaper
+ * @param [in] length of the Content Object's wire format, in bytes
+ */
+void athenaInterestShaper_ContentObjectReceived(AthenaInterestShaper *shaper, size_t length);
+
+/**
+ * @abstract Return the Content Object size each Interest is charged
+ *
+ * @param [in] shaper
+ * @return average Content Object size, in bytes
+ */
+size_t athenaInterestShaper_GetObjectSize(const AthenaInterestShaper *shaper);
+
+/**
+ * @abstract Offer an Interest to be sent on the link
+ *
+ * @param [in] shaper
+ * @param [in] interest acquired by the shaper if it's held
+ * @param [in] now current time, in milliseconds
+ * @return AthenaInterestShaper_Forward, AthenaInterestShaper_Held or AthenaInterestShaper_Congested
+ *
+ * Example:
+ * @code
+ * {
+ *     switch (athenaInterestShaper_Admit(shaper, interest, parcClock_GetTime(clock))) {
+ *         case AthenaInterestShaper_Forward: // send it
+ *         case AthenaInterestShaper_Held: // sent later, as it's returned from athenaInterestShaper_Next
+ *         case AthenaInterestShaper_Congested: // return it to the sender
+ *     }
+ * }
+ * @endcode
+ */
+AthenaInterestShaperResult athenaInterestShaper_Admit(AthenaInterestShaper *shaper, CCNxMetaMessage *interest, uint64_t now);
+
+/**
+ * @abstract Return the next held Interest if the link now has capacity for it
+ *
+ * @param [in] shaper
+ * @param [in] now current time, in milliseconds
+ * @return Interest to send, which the caller must release, or NULL
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxMetaMessage *interest;
+ *     while ((interest = athenaInterestShaper_Next(shaper, now)) != NULL) {
+ *         // send it
+ *         ccnxMetaMessage_Release(&interest);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxMetaMessage *athenaInterestShaper_Next(AthenaInterestShaper *shaper, uint64_t now);
+
+/**
+ * @abstract Return how long until the next held Interest can be sent
+ *
+ * @param [in] shaper
+ * @param [in] now current time, in milliseconds
+ * @return milliseconds, 0 if it can be sent now, -1 if no Interests are held
+ */
+int64_t athenaInterestShaper_TimeUntilNext(AthenaInterestShaper *shaper, uint64_t now);
+
+/**
+ * @abstract Return the number of Interests held
+ *
+ * @param [in] shaper
+ * @return number of held Interests
+ */
+size_t athenaInterestShaper_Depth(const AthenaInterestShaper *shaper);
+
+/**
+ * @abstract Return the number of Interests forwarded as soon as they were offered
+ *
+ * @param [in] shaper
+ * @return number of Interests
+ */
+size_t athenaInterestShaper_GetForwardedCount(const AthenaInterestShaper *shaper);
+
+/**
+ * @abstract Return the number of Interests held before they were forwarded
+ *
+ * @param [in] shaper
+ * @return number of Interests
+ */
+size_t athenaInterestShaper_GetHeldCount(const AthenaInterestShaper *shaper);
+
+/**
+ * @abstract Return the number of Interests refused because the link had no capacity for them
+ *
+ * @param [in] shaper
+ * @return number of Interests
+ */
+size_t athenaInterestShaper_GetCongestedCount(const AthenaInterestShaper *shaper);
+#endif // libathena_InterestShaper_h
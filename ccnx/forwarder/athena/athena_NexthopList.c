@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <string.h>
+#include <sys/types.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena_NexthopList.h>
+
+typedef struct athena_nexthop {
+    int linkId;
+    uint32_t cost;
+    uint32_t weight;
+} _AthenaNexthop;
+
+/**
+ * @typedef AthenaNexthopList
+ * @brief Nexthop array in ascending (cost, linkId) order, plus the same links as a vector
+ */
+struct athena_nexthop_list {
+    _AthenaNexthop *nexthop;
+    size_t count;
+    size_t capacity;
+    PARCBitVector *linkVector;
+};
+
+static void
+_athenaNexthopList_Finalize(AthenaNexthopList **nexthopsPtr)
+{
+    AthenaNexthopList *nexthops = *nexthopsPtr;
+    if (nexthops->nexthop != NULL) {
+        parcMemory_Deallocate(&nexthops->nexthop);
+    }
+    parcBitVector_Release(&nexthops->linkVector);
+}
+
+parcObject_ExtendPARCObject(AthenaNexthopList, _athenaNexthopList_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(athenaNexthopList, AthenaNexthopList);
+
+parcObject_ImplementRelease(athenaNexthopList, AthenaNexthopList);
+
+AthenaNexthopList *
+athenaNexthopList_Create(void)
+{
+    AthenaNexthopList *result = parcObject_CreateInstance(AthenaNexthopList);
+    if (result != NULL) {
+        result->nexthop = NULL;
+        result->count = 0;
+        result->capacity = 0;
+        result->linkVector = parcBitVector_Create();
+    }
+    return result;
+}
+
+AthenaNexthopList *
+athenaNexthopList_Copy(const AthenaNexthopList *nexthops)
+{
+    AthenaNexthopList *result = parcObject_CreateInstance(AthenaNexthopList);
+    if (result != NULL) {
+        result->nexthop = NULL;
+        result->count = nexthops->count;
+        result->capacity = nexthops->count;
+        if (nexthops->count > 0) {
+            result->nexthop = parcMemory_Allocate(nexthops->count * sizeof(_AthenaNexthop));
+            assertNotNull(result->nexthop, "parcMemory_Allocate(%zu) returned NULL", nexthops->count * sizeof(_AthenaNexthop));
+            memcpy(result->nexthop, nexthops->nexthop, nexthops->count * sizeof(_AthenaNexthop));
+        }
+        result->linkVector = parcBitVector_Copy(nexthops->linkVector);
+    }
+    return result;
+}
+
+static ssize_t
+_athenaNexthopList_Find(const AthenaNexthopList *nexthops, int linkId)
+{
+    for (size_t i = 0; i < nexthops->count; i++) {
+        if (nexthops->nexthop[i].linkId == linkId) {
+            return (ssize_t) i;
+        }
+    }
+    return -1;
+}
+
+static void
+_athenaNexthopList_RemoveAtIndex(AthenaNexthopList *nexthops, size_t index)
+{
+    memmove(&nexthops->nexthop[index], &nexthops->nexthop[index + 1],
+            (nexthops->count - index - 1) * sizeof(_AthenaNexthop));
+    nexthops->count--;
+}
+
+void
+athenaNexthopList_Set(AthenaNexthopList *nexthops, int linkId, uint32_t cost, uint32_t weight)
+{
+    assertTrue(linkId >= 0, "Invalid nexthop link id %d", linkId);
+
+    // Changing an existing nexthop may change its rank, take it out and re-insert it
+    ssize_t existing = _athenaNexthopList_Find(nexthops, linkId);
+    if (existing >= 0) {
+        _athenaNexthopList_RemoveAtIndex(nexthops, (size_t) existing);
+    }
+
+    if (nexthops->count == nexthops->capacity) {
+        size_t newCapacity = (nexthops->capacity == 0) ? 4 : nexthops->capacity * 2;
+        _AthenaNexthop *newArray = parcMemory_Allocate(newCapacity * sizeof(_AthenaNexthop));
+        assertNotNull(newArray, "parcMemory_Allocate(%zu) returned NULL", newCapacity * sizeof(_AthenaNexthop));
+        if (nexthops->nexthop != NULL) {
+            memcpy(newArray, nexthops->nexthop, nexthops->count * sizeof(_AthenaNexthop));
+            parcMemory_Deallocate(&nexthops->nexthop);
+        }
+        nexthops->nexthop = newArray;
+        nexthops->capacity = newCapacity;
+    }
+
+    size_t index = 0;
+    while ((index < nexthops->count) &&
+           ((nexthops->nexthop[index].cost < cost) ||
+            ((nexthops->nexthop[index].cost == cost) && (nexthops->nexthop[index].linkId < linkId)))) {
+        index++;
+    }
+    memmove(&nexthops->nexthop[index + 1], &nexthops->nexthop[index], (nexthops->count - index) * sizeof(_AthenaNexthop));
+    nexthops->nexthop[index].linkId = linkId;
+    nexthops->nexthop[index].cost = cost;
+    nexthops->nexthop[index].weight = (weight == 0) ? 1 : weight;
+    nexthops->count++;
+
+    parcBitVector_Set(nexthops->linkVector, linkId);
+}
+
+bool
+athenaNexthopList_Clear(AthenaNexthopList *nexthops, int linkId)
+{
+    ssize_t existing = _athenaNexthopList_Find(nexthops, linkId);
+    if (existing < 0) {
+        return false;
+    }
+    _athenaNexthopList_RemoveAtIndex(nexthops, (size_t) existing);
+    parcBitVector_Clear(nexthops->linkVector, linkId);
+    return true;
+}
+
+size_t
+athenaNexthopList_Size(const AthenaNexthopList *nexthops)
+{
+    return nexthops->count;
+}
+
+int
+athenaNexthopList_GetLinkId(const AthenaNexthopList *nexthops, size_t index)
+{
+    assertTrue(index < nexthops->count, "Nexthop index %zu out of range", index);
+    return nexthops->nexthop[index].linkId;
+}
+
+uint32_t
+athenaNexthopList_GetCost(const AthenaNexthopList *nexthops, size_t index)
+{
+    assertTrue(index < nexthops->count, "Nexthop index %zu out of range", index);
+    return nexthops->nexthop[index].cost;
+}
+
+uint32_t
+athenaNexthopList_GetWeight(const AthenaNexthopList *nexthops, size_t index)
+{
+    assertTrue(index < nexthops->count, "Nexthop index %zu out of range", index);
+    return nexthops->nexthop[index].weight;
+}
+
+const PARCBitVector *
+athenaNexthopList_GetVector(const AthenaNexthopList *nexthops)
+{
+    return nexthops->linkVector;
+}
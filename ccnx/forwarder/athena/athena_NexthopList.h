@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_NexthopList_h
+#define libathena_NexthopList_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <parc/algol/parc_BitVector.h>
+
+/*
+ * Nexthop list interfaces
+ *
+ *    athenaNexthopList_Create
+ *    athenaNexthopList_Acquire
+ *    athenaNexthopList_Release
+ *    athenaNexthopList_Copy
+ *
+ *    athenaNexthopList_Set
+ *    athenaNexthopList_Clear
+ *    athenaNexthopList_Size
+ *    athenaNexthopList_GetLinkId
+ *    athenaNexthopList_GetCost
+ *    athenaNexthopList_GetWeight
+ *    athenaNexthopList_GetVector
+ */
+
+/**
+ * Cost and weight given to nexthops added without one.
+ */
+#define AthenaNexthop_DefaultCost 1
+#define AthenaNexthop_DefaultWeight 1
+
+/**
+ * @typedef AthenaNexthopList
+ * @brief Links a FIB prefix forwards to, ordered by ascending cost
+ *
+ * Each nexthop carries a cost, used to rank nexthops, and a weight, used to share load between
+ * nexthops of the same rank.  Nexthops of equal cost are ordered by link id.
+ */
+struct athena_nexthop_list;
+typedef struct athena_nexthop_list AthenaNexthopList;
+
+/**
+ * @abstract Create an empty nexthop list
+ *
+ * @return pointer to a new nexthop list, NULL on allocation failure
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaNexthopList *nexthops = athenaNexthopList_Create();
+ *     athenaNexthopList_Set(nexthops, 3, 10, 1);
+ *     athenaNexthopList_Release(&nexthops);
+ * }
+ * @endcode
+ */
+AthenaNexthopList *athenaNexthopList_Create(void);
+
+/**
+ * @abstract Acquire a reference to a nexthop list
+ *
+ * @param [in] nexthops
+ * @return the acquired reference
+ */
+AthenaNexthopList *athenaNexthopList_Acquire(const AthenaNexthopList *nexthops);
+
+/**
+ * @abstract Release a nexthop list reference
+ *
+ * @param [in,out] nexthopsPtr pointer to the reference, set to NULL on return
+ */
+void athenaNexthopList_Release(AthenaNexthopList **nexthopsPtr);
+
+/**
+ * @abstract Create an independent copy of a nexthop list
+ *
+ * @param [in] nexthops
+ * @return the new copy, must be released by the caller
+ */
+AthenaNexthopList *athenaNexthopList_Copy(const AthenaNexthopList *nexthops);
+
+/**
+ * @abstract Add a nexthop, or change the cost and weight of an existing one
+ * @discussion
+ *
+ * The list is kept in ascending cost order.  A weight of 0 is stored as 1, every nexthop
+ * receives some share of the load.
+ *
+ * @param [in] nexthops
+ * @param [in] linkId
+ * @param [in] cost lower cost nexthops are preferred
+ * @param [in] weight relative share of the load among nexthops of equal cost
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaNexthopList_Set(nexthops, 3, 10, 2); // link 3 takes twice the load of link 5
+ *     athenaNexthopList_Set(nexthops, 5, 10, 1);
+ *     athenaNexthopList_Set(nexthops, 7, 20, 1); // link 7 is the backup
+ * }
+ * @endcode
+ */
+void athenaNexthopList_Set(AthenaNexthopList *nexthops, int linkId, uint32_t cost, uint32_t weight);
+
+/**
+ * @abstract Remove a nexthop
+ *
+ * @param [in] nexthops
+ * @param [in] linkId
+ * @return true if the link was a nexthop in the list
+ */
+bool athenaNexthopList_Clear(AthenaNexthopList *nexthops, int linkId);
+
+/**
+ * @abstract Return the number of nexthops in the list
+ *
+ * @param [in] nexthops
+ * @return number of nexthops
+ */
+size_t athenaNexthopList_Size(const AthenaNexthopList *nexthops);
+
+/**
+ * @abstract Return the link id of the nexthop at the given rank
+ *
+ * @param [in] nexthops
+ * @param [in] index position in the list, 0 is the lowest cost nexthop
+ * @return link id
+ */
+int athenaNexthopList_GetLinkId(const AthenaNexthopList *nexthops, size_t index);
+
+/**
+ * @abstract Return the cost of the nexthop at the given rank
+ *
+ * @param [in] nexthops
+ * @param [in] index position in the list
+ * @return cost
+ */
+uint32_t athenaNexthopList_GetCost(const AthenaNexthopList *nexthops, size_t index);
+
+/**
+ * @abstract Return the weight of the nexthop at the given rank
+ *
+ * @param [in] nexthops
+ * @param [in] index position in the list
+ * @return weight, never 0
+ */
+uint32_t athenaNexthopList_GetWeight(const AthenaNexthopList *nexthops, size_t index);
+
+/**
+ * @abstract Return the nexthop links as a vector
+ * @discussion
+ *
+ * The vector is owned by the list and stays in step with it, callers that keep it past changes
+ * to the list need to copy it.
+ *
+ * @param [in] nexthops
+ * @return vector of the nexthop link ids
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBitVector *egressVector = parcBitVector_Acquire(athenaNexthopList_GetVector(nexthops));
+ * }
+ * @endcode
+ */
+const PARCBitVector *athenaNexthopList_GetVector(const AthenaNexthopList *nexthops);
+#endif // libathena_NexthopList_h
@@ -60,15 +60,19 @@
 #include <config.h>
 
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "athena.h"
 #include "athena_PIT.h"
+#include "athena_PacketDescriptor.h"
 
 #include <ccnx/common/ccnx_NameSegmentNumber.h>
 #include <ccnx/common/ccnx_WireFormatMessage.h>
 #include <ccnx/common/ccnx_ContentObject.h>
 
 #include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_JSON.h>
 #include <parc/algol/parc_HashMap.h>
 #include <parc/algol/parc_ArrayList.h>
@@ -80,6 +84,13 @@
 
 #define DEFAULT_CAPACITY 100000
 
+// Counters of the pending name filter, must be a power of two
+#define NAME_FILTER_SIZE 65536
+
+// Name filter states of an entry that doesn't hold a counter
+#define _NameFilter_None     -1 // nameless entry, or no longer in the table
+#define _NameFilter_Unhashed -2 // the Interest had no wire format name to hash
+
 static const char *_athenaPIT_Name = "AthenaPIT 20150913";
 
 typedef struct _time {
@@ -141,6 +152,99 @@ _time_Get(_Time *time)
     return time->value;
 }
 
+/**
+ * @typedef AthenaPITLinkNode
+ * @brief Membership of a PIT entry in the list of entries pending on one of its ingress links.  Nodes
+ *        are threaded onto both the link's list and the entry's list so that removing a link only
+ *        visits the entries pending on it, without rebuilding their keys.
+ */
+typedef struct athena_pitLinkNode {
+    struct athena_pitEntry *entry;
+    int linkId;
+    struct athena_pitLinkNode *previousOnLink;
+    struct athena_pitLinkNode *nextOnLink;
+    struct athena_pitLinkNode *nextInEntry;
+} _AthenaPITLinkNode;
+
+/**
+ * @typedef AthenaPITSendTimes
+ * @brief Times an interest was last sent on the links it was retried on, or released to after being held.
+ *        Links without a time were sent the interest when its entry was created.  Shared with the
+ *        nameless entry for the same interest, like the egress vector.
+ */
+typedef struct athena_pitSendTime {
+    int linkId;
+    uint64_t time;
+} _AthenaPITSendTime;
+
+typedef struct athena_pitSendTimes {
+    _AthenaPITSendTime *times;
+    size_t count;
+    size_t size;
+} _AthenaPITSendTimes;
+
+static void
+_athenaPITSendTimes_Destroy(_AthenaPITSendTimes **sendTimesHandle)
+{
+    _AthenaPITSendTimes *sendTimes = *sendTimesHandle;
+    if (sendTimes->times != NULL) {
+        parcMemory_Deallocate(&sendTimes->times);
+    }
+}
+
+parcObject_ExtendPARCObject(_AthenaPITSendTimes, _athenaPITSendTimes_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static
+parcObject_ImplementRelease(_athenaPITSendTimes, _AthenaPITSendTimes);
+
+static
+parcObject_ImplementAcquire(_athenaPITSendTimes, _AthenaPITSendTimes);
+
+static _AthenaPITSendTimes *
+_athenaPITSendTimes_Create(void)
+{
+    _AthenaPITSendTimes *sendTimes = parcObject_CreateInstance(_AthenaPITSendTimes);
+    if (sendTimes != NULL) {
+        sendTimes->times = NULL;
+        sendTimes->count = 0;
+        sendTimes->size = 0;
+    }
+    return sendTimes;
+}
+
+static void
+_athenaPITSendTimes_Set(_AthenaPITSendTimes *sendTimes, int linkId, uint64_t time)
+{
+    for (size_t i = 0; i < sendTimes->count; i++) {
+        if (sendTimes->times[i].linkId == linkId) {
+            sendTimes->times[i].time = time;
+            return;
+        }
+    }
+    if (sendTimes->count == sendTimes->size) {
+        size_t newSize = (sendTimes->size > 0) ? (sendTimes->size * 2) : 2;
+        _AthenaPITSendTime *newTimes = parcMemory_Reallocate(sendTimes->times, sizeof(_AthenaPITSendTime) * newSize);
+        assertNotNull(newTimes, "parcMemory_Reallocate failed to resize the PIT send times");
+        sendTimes->times = newTimes;
+        sendTimes->size = newSize;
+    }
+    sendTimes->times[sendTimes->count].linkId = linkId;
+    sendTimes->times[sendTimes->count].time = time;
+    sendTimes->count++;
+}
+
+// Return the time the interest was sent on the link, or defaultTime if it wasn't recorded
+static uint64_t
+_athenaPITSendTimes_Get(const _AthenaPITSendTimes *sendTimes, int linkId, uint64_t defaultTime)
+{
+    for (size_t i = 0; i < sendTimes->count; i++) {
+        if (sendTimes->times[i].linkId == linkId) {
+            return sendTimes->times[i].time;
+        }
+    }
+    return defaultTime;
+}
+
 /**
  * @typedef AthenaPITEntry
  * @brief PIT table entry, vector of links to forward to and expiration
@@ -150,8 +254,15 @@ typedef struct athena_pitEntry {
     CCNxInterest *ccnxMessage;
     PARCBitVector *ingress;
     PARCBitVector *egress; // FIB egress at entry, used to validate return of content on expected link
+    PARCBitVector *returned; // links that have answered with an InterestReturn
+    _AthenaPITSendTimes *sendTimes; // when the interest was sent on links it wasn't sent on at creation
     _Time *expiration; // not predecessor lifetime, but longest for all
     _Time *creationTime; // not predecessor lifetime, but longest for all
+    _AthenaPITLinkNode *linkNodes; // one for each ingress link while the entry is in the table
+    int nameFilterSlot; // counter held in the name filter, or a _NameFilter state
+    bool twin; // the nameless entry made alongside a named one, not counted in its links' pending counts
+    struct athena_pitEntry *older; // neighbours in the PIT's list of entries in the order they were added
+    struct athena_pitEntry *newer;
 } _AthenaPITEntry;
 
 static void
@@ -163,6 +274,8 @@ _athenaPITEntry_Destroy(_AthenaPITEntry**entryHandle)
         ccnxMetaMessage_Release(&entry->ccnxMessage);
         parcBitVector_Release(&entry->ingress);
         parcBitVector_Release(&entry->egress);
+        parcBitVector_Release(&entry->returned);
+        _athenaPITSendTimes_Release(&entry->sendTimes);
         _time_Release(&entry->expiration);
         _time_Release(&entry->creationTime);
     }
@@ -205,6 +318,7 @@ _athenaPITEntry_Create(const PARCBuffer *key,
                        const CCNxInterest *message,
                        const PARCBitVector *ingress,
                        const PARCBitVector *egress,
+                       _AthenaPITSendTimes *sendTimes,
                        time_t expiration,
                        time_t creationTime)
 {
@@ -214,8 +328,15 @@ _athenaPITEntry_Create(const PARCBuffer *key,
         entry->ccnxMessage = ccnxMetaMessage_Acquire(message);
         entry->ingress = parcBitVector_Copy(ingress);
         entry->egress = parcBitVector_Acquire(egress);
+        entry->returned = parcBitVector_Create();
+        entry->sendTimes = _athenaPITSendTimes_Acquire(sendTimes);
         entry->expiration = _time_Create(expiration);
         entry->creationTime = _time_Create(creationTime);
+        entry->linkNodes = NULL;
+        entry->nameFilterSlot = _NameFilter_None;
+        entry->twin = false;
+        entry->older = NULL;
+        entry->newer = NULL;
     }
 
     return entry;
@@ -227,6 +348,13 @@ _athenaPITEntry_Age(_AthenaPITEntry *entry, uint64_t now)
     return now - _time_Get(entry->creationTime);
 }
 
+// Time since the interest was last sent on the link, so a response to a retry isn't charged the failed attempts
+static uint64_t
+_athenaPITEntry_ResponseTime(_AthenaPITEntry *entry, int linkId, uint64_t now)
+{
+    return now - _athenaPITSendTimes_Get(entry->sendTimes, linkId, _time_Get(entry->creationTime));
+}
+
 #define LATENCY_ARRAY_SIZE 100
 
 struct athena_pit {
@@ -234,14 +362,40 @@ struct athena_pit {
 
     PARCHashMap *entryTable;
 
-    PARCList *linkCleanupList;
+    _AthenaPITLinkNode **linkIndex; // index = linkId, list of entries pending on the link
+    size_t *linkPendingCount; // index = linkId, length of the link's list
+    size_t linkIndexSize;
+    size_t activeLinkCount; // links with entries pending
+
+    AthenaPITLinkQuotaMode linkQuotaMode;
+    size_t linkQuotaLimit;
+    CCNxName *linkQuotaExemptPrefix; // interests under it are never refused by the link quota
 
     PARCTreeMap *timeoutTable;
 
+    // Entries in the table in the order they were added, the oldest is evicted first by EvictOldest
+    _AthenaPITEntry *oldestEntry;
+    _AthenaPITEntry *newestEntry;
+
+    AthenaPITOverflowPolicy overflowPolicy;
+
+    // Counts of named entries by a hash of their wire format name, so that content nobody asked for
+    // can be turned away before it's decoded.  Entries without a hash make the filter inconclusive.
+    uint32_t *nameFilter;
+    size_t nameFilterUnhashed;
+
     PARCClock *clock;
 
+    AthenaPIT_MeasurementCallback *measurementCallback;
+    AthenaPIT_MeasurementCallbackContext measurementContext;
+
+    AthenaPIT_EvictionCallback *evictionCallback;
+    AthenaPIT_EvictionCallbackContext evictionContext;
+
     // Stats
     size_t interestCount;
+    size_t overflowCount[AthenaPITOverflowPolicy_Count];
+    size_t linkQuotaRejectCount;
     time_t latencySum;
     time_t latencyArray[LATENCY_ARRAY_SIZE];
     size_t latencyArrayIndex;
@@ -253,9 +407,25 @@ _athenaPIT_Destroy(AthenaPIT **pitHandle)
 {
     AthenaPIT *pit = *pitHandle;
     if (pit != NULL) {
+        for (size_t linkId = 0; linkId < pit->linkIndexSize; linkId++) {
+            _AthenaPITLinkNode *node = pit->linkIndex[linkId];
+            while (node != NULL) {
+                _AthenaPITLinkNode *next = node->nextOnLink;
+                node->entry->linkNodes = NULL;
+                parcMemory_Deallocate(&node);
+                node = next;
+            }
+        }
+        if (pit->linkIndex != NULL) {
+            parcMemory_Deallocate(&pit->linkIndex);
+            parcMemory_Deallocate(&pit->linkPendingCount);
+        }
+        parcMemory_Deallocate(&pit->nameFilter);
+        if (pit->linkQuotaExemptPrefix != NULL) {
+            ccnxName_Release(&pit->linkQuotaExemptPrefix);
+        }
         parcHashMap_Release(&pit->entryTable);
         parcTreeMap_Release(&pit->timeoutTable);
-        parcList_Release(&pit->linkCleanupList);
         parcClock_Release(&pit->clock);
     }
 }
@@ -274,11 +444,31 @@ athenaPIT_CreateCapacity(size_t capacity)
     if (pit != NULL) {
         pit->entryTable = parcHashMap_Create();
         pit->timeoutTable = parcTreeMap_Create();
-        pit->linkCleanupList = parcList(parcArrayList_Create((void (*)(void**))parcTreeMap_Release), PARCArrayListAsPARCList);
+        pit->oldestEntry = NULL;
+        pit->newestEntry = NULL;
+        pit->overflowPolicy = AthenaPITOverflowPolicy_Reject;
+        pit->linkIndex = NULL;
+        pit->linkPendingCount = NULL;
+        pit->linkIndexSize = 0;
+        pit->activeLinkCount = 0;
+        pit->linkQuotaMode = AthenaPITLinkQuotaMode_None;
+        pit->linkQuotaLimit = 0;
+        pit->linkQuotaExemptPrefix = NULL;
+        pit->nameFilter = parcMemory_AllocateAndClear(sizeof(uint32_t) * NAME_FILTER_SIZE);
+        assertNotNull(pit->nameFilter, "parcMemory_AllocateAndClear failed to create the PIT name filter");
+        pit->nameFilterUnhashed = 0;
         pit->clock = parcClock_Monotonic();
         pit->capacity = capacity;
+        pit->measurementCallback = NULL;
+        pit->measurementContext = NULL;
+        pit->evictionCallback = NULL;
+        pit->evictionContext = NULL;
 
         pit->interestCount = 0;
+        for (size_t i = 0; i < AthenaPITOverflowPolicy_Count; ++i) {
+            pit->overflowCount[i] = 0;
+        }
+        pit->linkQuotaRejectCount = 0;
         pit->latencyArrayIndex = 0;
         pit->latencyArrayCount = 0;
         pit->latencySum = 0;
@@ -383,89 +573,186 @@ _athenaPIT_removeInterestFromTimeoutTable(AthenaPIT *athenaPIT, const _AthenaPIT
     return result;
 }
 
-static void
-_athenaPIT_addInterestToLinkCleanupList(AthenaPIT *athenaPIT, const PARCBitVector *links, const _AthenaPITEntry *entry)
+static size_t
+_athenaPIT_NameFilterSlot(const uint8_t *name, size_t nameLength)
 {
-    // for each bit in the link vector, add an entry for the interest in the list of links for future
-    // cleanup
-    for (int i = 0, bit = 0; i < parcBitVector_NumberOfBitsSet(links); ++i, ++bit) {
-        bit = parcBitVector_NextBitSet(links, bit);
+    return parcHashCode_Hash(name, nameLength) & (NAME_FILTER_SIZE - 1);
+}
 
-        if (bit >= parcList_Size(athenaPIT->linkCleanupList)) {
-            //Expand the list if needed
-            for (size_t j = parcList_Size(athenaPIT->linkCleanupList); j <= bit; ++j) {
-                parcList_Add(athenaPIT->linkCleanupList, NULL);
-            }
-        }
+// Count a named entry in the name filter, by the name in its Interest's wire format
+static void
+_athenaPIT_NameFilterAdd(AthenaPIT *athenaPIT, _AthenaPITEntry *entry)
+{
+    AthenaPacketDescriptor descriptor;
+    PARCBuffer *wireFormatBuffer = ccnxWireFormatMessage_GetWireFormatBuffer(entry->ccnxMessage);
 
-        // Use the ingress link bit as an index into the ingressLinks array
-        PARCTreeMap *entryMap =
-            (PARCTreeMap *) parcList_GetAtIndex((PARCList *) athenaPIT->linkCleanupList, bit);
-        if (entryMap == NULL) {
-            // No map to store interests yet for this link so we'll need to add one
-            entryMap = parcTreeMap_Create();
-            parcList_SetAtIndex(athenaPIT->linkCleanupList, bit, (PARCObject *) entryMap);
-        }
+    if ((wireFormatBuffer != NULL) && athenaPacketDescriptor_Parse(&descriptor, wireFormatBuffer) &&
+        athenaPacketDescriptor_HasName(&descriptor)) {
+        entry->nameFilterSlot = (int) _athenaPIT_NameFilterSlot(descriptor.name, descriptor.nameLength);
+        athenaPIT->nameFilter[entry->nameFilterSlot]++;
+    } else {
+        entry->nameFilterSlot = _NameFilter_Unhashed;
+        athenaPIT->nameFilterUnhashed++;
+    }
+}
 
-        // Store the interest in the link's hash map
-        PARCBuffer *keyBuffer = _athenaPIT_acquireInterestKey(entry->ccnxMessage);
-        parcTreeMap_Put(entryMap, keyBuffer, entry);
+// Uncount an entry leaving the table, entries that were never counted are ignored
+static void
+_athenaPIT_NameFilterRemove(AthenaPIT *athenaPIT, _AthenaPITEntry *entry)
+{
+    if (entry->nameFilterSlot == _NameFilter_Unhashed) {
+        athenaPIT->nameFilterUnhashed--;
+    } else if (entry->nameFilterSlot != _NameFilter_None) {
+        athenaPIT->nameFilter[entry->nameFilterSlot]--;
+    }
+    entry->nameFilterSlot = _NameFilter_None;
+}
 
-        parcBuffer_Release(&keyBuffer);
+// Append an entry put in the table to the age list
+static void
+_athenaPIT_AgeListAdd(AthenaPIT *athenaPIT, _AthenaPITEntry *entry)
+{
+    entry->older = athenaPIT->newestEntry;
+    entry->newer = NULL;
+    if (athenaPIT->newestEntry != NULL) {
+        athenaPIT->newestEntry->newer = entry;
+    } else {
+        athenaPIT->oldestEntry = entry;
     }
+    athenaPIT->newestEntry = entry;
 }
 
+// Unlink an entry leaving the table from the age list, entries that aren't in the list are ignored
 static void
-_athenaPIT_removeInterestFromCleanupList(AthenaPIT *athenaPIT, const PARCBitVector  *links, PARCObject *key)
+_athenaPIT_AgeListRemove(AthenaPIT *athenaPIT, _AthenaPITEntry *entry)
 {
-    int numberOfBitsSet = (int) parcList_Size(athenaPIT->linkCleanupList);
-    if (links != NULL) {
-        numberOfBitsSet = parcBitVector_NumberOfBitsSet(links);
+    if ((entry->older == NULL) && (athenaPIT->oldestEntry != entry)) {
+        return;
     }
 
-    for (int i = 0, bit = 0; i < numberOfBitsSet; ++i, ++bit) {
-        if (links != NULL) {
-            bit = parcBitVector_NextBitSet(links, bit);
-        }
-        if (parcList_Size(athenaPIT->linkCleanupList) > bit) {
-            PARCTreeMap *entryMap =
-                (PARCTreeMap *) parcList_GetAtIndex(athenaPIT->linkCleanupList, bit);
-            if (entryMap != NULL) {
-                _AthenaPITEntry *entry = (_AthenaPITEntry *) parcTreeMap_Remove(entryMap, key);
-                if (entry != NULL) {
-                    parcBitVector_Clear(entry->ingress, bit);
-                    _athenaPITEntry_Release(&entry);
-                }
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    } else {
+        athenaPIT->oldestEntry = entry->newer;
+    }
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    } else {
+        athenaPIT->newestEntry = entry->older;
+    }
+    entry->older = NULL;
+    entry->newer = NULL;
+}
+
+// Add the entry to the list of entries pending on each of the links, growing the link index if needed.
+// The caller ensures the entry isn't already indexed on any of the links.
+static void
+_athenaPIT_IndexEntry(AthenaPIT *athenaPIT, _AthenaPITEntry *entry, const PARCBitVector *links)
+{
+    for (int linkId = 0; (linkId = parcBitVector_NextBitSet(links, linkId)) >= 0; linkId++) {
+        if (linkId >= athenaPIT->linkIndexSize) {
+            size_t newSize = (athenaPIT->linkIndexSize > 0) ? athenaPIT->linkIndexSize : 8;
+            while (newSize <= linkId) {
+                newSize *= 2;
             }
+            _AthenaPITLinkNode **newLinkIndex = parcMemory_Reallocate(athenaPIT->linkIndex, sizeof(_AthenaPITLinkNode *) * newSize);
+            assertNotNull(newLinkIndex, "parcMemory_Reallocate failed to resize the PIT link index");
+            memset(&newLinkIndex[athenaPIT->linkIndexSize], 0, sizeof(_AthenaPITLinkNode *) * (newSize - athenaPIT->linkIndexSize));
+            size_t *newLinkPendingCount = parcMemory_Reallocate(athenaPIT->linkPendingCount, sizeof(size_t) * newSize);
+            assertNotNull(newLinkPendingCount, "parcMemory_Reallocate failed to resize the PIT link pending counts");
+            memset(&newLinkPendingCount[athenaPIT->linkIndexSize], 0, sizeof(size_t) * (newSize - athenaPIT->linkIndexSize));
+            athenaPIT->linkIndex = newLinkIndex;
+            athenaPIT->linkPendingCount = newLinkPendingCount;
+            athenaPIT->linkIndexSize = newSize;
+        }
+
+        _AthenaPITLinkNode *node = parcMemory_AllocateAndClear(sizeof(_AthenaPITLinkNode));
+        assertNotNull(node, "parcMemory_AllocateAndClear failed to create a PIT link node");
+        node->entry = entry;
+        node->linkId = linkId;
+
+        node->nextOnLink = athenaPIT->linkIndex[linkId];
+        if (node->nextOnLink != NULL) {
+            node->nextOnLink->previousOnLink = node;
+        }
+        athenaPIT->linkIndex[linkId] = node;
+        if ((entry->twin == false) && (athenaPIT->linkPendingCount[linkId]++ == 0)) {
+            athenaPIT->activeLinkCount++;
         }
+
+        node->nextInEntry = entry->linkNodes;
+        entry->linkNodes = node;
     }
 }
 
-static bool
-_athenaPIT_RemoveInterestFromMap(AthenaPIT *athenaPIT, CCNxInterest *interest, const PARCBitVector *link)
+// Unthread a node from its entry and its link and free it.  An entry only has a node for each of its
+// ingress links so the walk of the entry's nodes is short.
+static void
+_athenaPIT_RemoveLinkNode(AthenaPIT *athenaPIT, _AthenaPITLinkNode *node)
 {
-    bool result = false;
-
-    PARCBuffer *key = _athenaPIT_acquireInterestKey(interest);
+    _AthenaPITLinkNode **nodeHandle = &node->entry->linkNodes;
+    while (*nodeHandle != node) {
+        nodeHandle = &(*nodeHandle)->nextInEntry;
+    }
+    *nodeHandle = node->nextInEntry;
 
-    _AthenaPITEntry *entry = (_AthenaPITEntry *) parcHashMap_Get(athenaPIT->entryTable, key);
+    if (node->previousOnLink != NULL) {
+        node->previousOnLink->nextOnLink = node->nextOnLink;
+    } else {
+        athenaPIT->linkIndex[node->linkId] = node->nextOnLink;
+    }
+    if (node->nextOnLink != NULL) {
+        node->nextOnLink->previousOnLink = node->previousOnLink;
+    }
+    if ((node->entry->twin == false) && (--athenaPIT->linkPendingCount[node->linkId] == 0)) {
+        athenaPIT->activeLinkCount--;
+    }
 
-    if (entry != NULL) {
-        if (link != NULL) {
-            parcBitVector_ClearVector(entry->ingress, link);
-        } else {
-            parcBitVector_Release(&entry->ingress);
-            entry->ingress = parcBitVector_Create();
-        }
+    parcMemory_Deallocate(&node);
+}
 
-        if (parcBitVector_NumberOfBitsSet(entry->ingress) == 0) {
-            result = parcHashMap_Remove(athenaPIT->entryTable, key);
+// Remove the entry from the lists of the links, or from all of its links if links is NULL
+static void
+_athenaPIT_UnindexEntry(AthenaPIT *athenaPIT, _AthenaPITEntry *entry, const PARCBitVector *links)
+{
+    _AthenaPITLinkNode *node = entry->linkNodes;
+    while (node != NULL) {
+        _AthenaPITLinkNode *next = node->nextInEntry;
+        if ((links == NULL) || (parcBitVector_Get(links, node->linkId) == 1)) {
+            _athenaPIT_RemoveLinkNode(athenaPIT, node);
         }
+        node = next;
     }
+}
 
-    parcBuffer_Release(&key);
+// Remove the entry from the table and the link index.  By the time an entry's timeout is processed it
+// may already have been removed, and its key reused by a newer entry, so only remove it if it's still
+// the entry in the table.
+static void
+_athenaPIT_RemoveEntry(AthenaPIT *athenaPIT, _AthenaPITEntry *entry)
+{
+    _athenaPIT_UnindexEntry(athenaPIT, entry, NULL);
+    if (parcHashMap_Get(athenaPIT->entryTable, entry->key) == entry) {
+        parcHashMap_Remove(athenaPIT->entryTable, entry->key);
+    }
+    _athenaPIT_NameFilterRemove(athenaPIT, entry);
+    _athenaPIT_AgeListRemove(athenaPIT, entry);
+}
 
-    return result;
+// Report each link the interest is still outstanding on as having failed to respond. The egress
+// vector is shared with any nameless entry for the same interest, so clear it to report only once.
+static void
+_athenaPIT_ReportExpired(AthenaPIT *pit, _AthenaPITEntry *entry, uint64_t now)
+{
+    if ((pit->measurementCallback != NULL) && (parcBitVector_NumberOfBitsSet(entry->egress) > 0)) {
+        PARCBitVector *outstanding = parcBitVector_Copy(entry->egress);
+        for (int linkId = 0; (linkId = parcBitVector_NextBitSet(outstanding, linkId)) >= 0; linkId++) {
+            pit->measurementCallback(pit->measurementContext, entry->ccnxMessage, linkId, false,
+                                     _athenaPITEntry_Age(entry, now));
+        }
+        parcBitVector_ClearVector(entry->egress, outstanding);
+        parcBitVector_Release(&outstanding);
+    }
 }
 
 static void
@@ -486,10 +773,10 @@ _athenaPIT_PurgeExpired(AthenaPIT *pit)
             _AthenaPITEntry *entry = (_AthenaPITEntry *) parcIterator_Next(it);
             // Necessary because the entry's expiration time may have been increased since being added to the list
             if (_time_Compare(now, entry->expiration) > 0) {
-                _athenaPIT_RemoveInterestFromMap(pit, entry->ccnxMessage, entry->ingress);
-                PARCBuffer *nameKey = _athenaPIT_acquireInterestKey(entry->ccnxMessage);
-                _athenaPIT_removeInterestFromCleanupList(pit, entry->ingress, nameKey);
-                parcBuffer_Release(&nameKey);
+                if (parcHashMap_Get(pit->entryTable, entry->key) == entry) {
+                    _athenaPIT_ReportExpired(pit, entry, _time_Get(now));
+                }
+                _athenaPIT_RemoveEntry(pit, entry);
             }
         }
         parcIterator_Release(&it);
@@ -500,6 +787,127 @@ _athenaPIT_PurgeExpired(AthenaPIT *pit)
     _time_Release(&now);
 }
 
+// Return the entry in the table that expires first.  Any timeout table entry no longer in the table
+// is discarded on the way.
+static _AthenaPITEntry *
+_athenaPIT_SoonestExpiring(AthenaPIT *pit)
+{
+    _AthenaPITEntry *result = NULL;
+
+    while ((result == NULL) && (parcTreeMap_Size(pit->timeoutTable) > 0)) {
+        _Time *timeKey = _time_Acquire(parcTreeMap_GetFirstKey(pit->timeoutTable));
+        PARCLinkedList *entryList = (PARCLinkedList *) parcTreeMap_Get(pit->timeoutTable, timeKey);
+
+        _AthenaPITEntry *entry = (_AthenaPITEntry *) parcLinkedList_GetFirst(entryList);
+        if (parcHashMap_Get(pit->entryTable, entry->key) == entry) {
+            result = entry;
+        } else {
+            entry = (_AthenaPITEntry *) parcLinkedList_RemoveFirst(entryList);
+            _athenaPITEntry_Release(&entry);
+            if (parcLinkedList_IsEmpty(entryList)) {
+                parcTreeMap_RemoveAndRelease(pit->timeoutTable, timeKey);
+            }
+        }
+        _time_Release(&timeKey);
+    }
+
+    return result;
+}
+
+// Return the other entry made for the same interest, the nameless entry of a named interest with a
+// ContentObjectHashRestriction or the named entry of such a nameless entry.  Both were created sharing
+// an egress vector, which tells them apart from an entry a later interest made with the same key.
+static _AthenaPITEntry *
+_athenaPIT_Twin(AthenaPIT *pit, const _AthenaPITEntry *entry)
+{
+    const PARCBuffer *contentId = ccnxInterest_GetContentObjectHashRestriction(entry->ccnxMessage);
+    if (contentId == NULL) {
+        return NULL;
+    }
+
+    PARCBuffer *key = _athenaPIT_createCompoundKey(NULL, contentId, NULL);
+    if (parcBuffer_Equals(key, entry->key)) {
+        parcBuffer_Release(&key);
+        key = _athenaPIT_acquireInterestKey(entry->ccnxMessage);
+    }
+    _AthenaPITEntry *twin = (_AthenaPITEntry *) parcHashMap_Get(pit->entryTable, key);
+    parcBuffer_Release(&key);
+
+    if ((twin == entry) || ((twin != NULL) && (twin->egress != entry->egress))) {
+        twin = NULL;
+    }
+    return twin;
+}
+
+static void
+_athenaPIT_Evict(AthenaPIT *pit, _AthenaPITEntry *entry)
+{
+    // Only named entries are counted as pending interests, a nameless entry duplicates its named one
+    if (entry->nameFilterSlot != _NameFilter_None) {
+        pit->interestCount -= parcBitVector_NumberOfBitsSet(entry->ingress);
+    }
+    _athenaPIT_removeInterestFromTimeoutTable(pit, entry);
+    _athenaPIT_RemoveEntry(pit, entry);
+}
+
+// Called when a new entry is needed, the table is at capacity and no entries have expired.  Applies the
+// overflow policy, returning true if an entry was evicted to make room.
+static bool
+_athenaPIT_Overflow(AthenaPIT *pit)
+{
+    _AthenaPITEntry *victim = NULL;
+
+    switch (pit->overflowPolicy) {
+        case AthenaPITOverflowPolicy_EvictOldest:
+            victim = pit->oldestEntry;
+            break;
+        case AthenaPITOverflowPolicy_EvictSoonestExpiring:
+            victim = _athenaPIT_SoonestExpiring(pit);
+            break;
+        default:
+            break;
+    }
+
+    if (victim == NULL) {
+        pit->overflowCount[AthenaPITOverflowPolicy_Reject]++;
+        return false;
+    }
+
+    victim = _athenaPITEntry_Acquire(victim);
+    PARCBitVector *evictedIngress = parcBitVector_Copy(victim->ingress);
+
+    // Evicting half of an interest would leave the other half pending with no one told it was dropped
+    _AthenaPITEntry *twin = _athenaPIT_Twin(pit, victim);
+    if (twin != NULL) {
+        twin = _athenaPITEntry_Acquire(twin);
+        parcBitVector_SetVector(evictedIngress, twin->ingress);
+        _athenaPIT_Evict(pit, twin);
+        _athenaPITEntry_Release(&twin);
+    }
+    _athenaPIT_Evict(pit, victim);
+
+    if ((pit->evictionCallback != NULL) && (parcBitVector_NumberOfBitsSet(evictedIngress) > 0)) {
+        pit->evictionCallback(pit->evictionContext, victim->ccnxMessage, evictedIngress);
+    }
+    parcBitVector_Release(&evictedIngress);
+    _athenaPITEntry_Release(&victim);
+
+    pit->overflowCount[pit->overflowPolicy]++;
+    return true;
+}
+
+// Interests to the forwarder itself are exempt from the link quota, so that it can still be managed
+// from a link that is flooding the PIT
+static bool
+_athenaPIT_LinkQuotaExempt(const AthenaPIT *athenaPIT, const CCNxInterest *ccnxInterestMessage)
+{
+    if ((athenaPIT->linkQuotaMode == AthenaPITLinkQuotaMode_None) || (athenaPIT->linkQuotaExemptPrefix == NULL)) {
+        return false;
+    }
+    CCNxName *name = ccnxInterest_GetName(ccnxInterestMessage);
+    return (name != NULL) && ccnxName_StartsWith(name, athenaPIT->linkQuotaExemptPrefix);
+}
+
 static void
 _athenaPIT_AddLifetimeStat(AthenaPIT *pit, time_t latencyEntry)
 {
@@ -531,23 +939,33 @@ athenaPIT_AddInterest(AthenaPIT *athenaPIT,
     _AthenaPITEntry *entry = (_AthenaPITEntry *) parcHashMap_Get(athenaPIT->entryTable, key);
 
     if (entry == NULL) { // New PIT entry
-        // Make sure we don't exceed our desired limit
-        if (parcHashMap_Size(athenaPIT->entryTable) >= athenaPIT->capacity) {
-            // Try and free up some entries
+        // Only a new entry is held against the links' quota, aggregated and duplicate interests don't add one
+        bool congested = (_athenaPIT_LinkQuotaExempt(athenaPIT, ccnxInterestMessage) == false) &&
+                         (athenaPIT_CheckLinkQuota(athenaPIT, ingressVector) == false);
+        if ((congested == false) && (parcHashMap_Size(athenaPIT->entryTable) >= athenaPIT->capacity)) {
+            // Try and free up some entries, then fall back on the overflow policy
             _athenaPIT_PurgeExpired(athenaPIT);
+            if (parcHashMap_Size(athenaPIT->entryTable) >= athenaPIT->capacity) {
+                congested = (_athenaPIT_Overflow(athenaPIT) == false);
+            }
         }
 
-        if (parcHashMap_Size(athenaPIT->entryTable) < athenaPIT->capacity) {
+        if (congested) {
+            result = AthenaPITResolution_Congested;
+        } else if (parcHashMap_Size(athenaPIT->entryTable) < athenaPIT->capacity) {
             PARCBitVector *newEgressVector = parcBitVector_Create();
+            _AthenaPITSendTimes *newSendTimes = _athenaPITSendTimes_Create();
 
             // Add the default entry which contains the Interest name
             _AthenaPITEntry *newEntry =
-                _athenaPITEntry_Create(key, ccnxInterestMessage, ingressVector, newEgressVector, expiration, now);
+                _athenaPITEntry_Create(key, ccnxInterestMessage, ingressVector, newEgressVector, newSendTimes, expiration, now);
 
             parcHashMap_Put(athenaPIT->entryTable, key, newEntry);
+            _athenaPIT_NameFilterAdd(athenaPIT, newEntry);
+            _athenaPIT_AgeListAdd(athenaPIT, newEntry);
             ++athenaPIT->interestCount;
 
-            _athenaPIT_addInterestToLinkCleanupList(athenaPIT, ingressVector, newEntry);
+            _athenaPIT_IndexEntry(athenaPIT, newEntry, ingressVector);
             _athenaPIT_addInterestToTimeoutTable(athenaPIT, expiration, newEntry);
 
             entry = newEntry;
@@ -558,10 +976,13 @@ athenaPIT_AddInterest(AthenaPIT *athenaPIT,
                 PARCBuffer *namelessKey = _athenaPIT_createCompoundKey(NULL, contentId, NULL);
 
                 _AthenaPITEntry *namelessEntry =
-                        _athenaPITEntry_Create(namelessKey, ccnxInterestMessage, ingressVector, newEgressVector, expiration, now);
+                        _athenaPITEntry_Create(namelessKey, ccnxInterestMessage, ingressVector, newEgressVector, newSendTimes,
+                                               expiration, now);
+                namelessEntry->twin = true;
                 parcHashMap_Put(athenaPIT->entryTable, namelessKey, namelessEntry);
+                _athenaPIT_AgeListAdd(athenaPIT, namelessEntry);
 
-                _athenaPIT_addInterestToLinkCleanupList(athenaPIT, ingressVector, namelessEntry);
+                _athenaPIT_IndexEntry(athenaPIT, namelessEntry, ingressVector);
                 _athenaPIT_addInterestToTimeoutTable(athenaPIT, expiration, namelessEntry);
 
                 _athenaPITEntry_Release(&namelessEntry);
@@ -570,6 +991,7 @@ athenaPIT_AddInterest(AthenaPIT *athenaPIT,
 
             _athenaPITEntry_Release(&newEntry);
             parcBitVector_Release(&newEgressVector);
+            _athenaPITSendTimes_Release(&newSendTimes);
             result = AthenaPITResolution_Forward;
         }
     } else if (parcBitVector_Contains(entry->ingress, ingressVector)) {
@@ -588,10 +1010,14 @@ athenaPIT_AddInterest(AthenaPIT *athenaPIT,
             _athenaPIT_addInterestToTimeoutTable(athenaPIT, expiration, entry);
         }
 
+        PARCBitVector *newIngress = parcBitVector_Copy(ingressVector);
+        parcBitVector_ClearVector(newIngress, entry->ingress);
+        _athenaPIT_IndexEntry(athenaPIT, entry, newIngress);
+        parcBitVector_Release(&newIngress);
+
         parcBitVector_SetVector(entry->ingress, ingressVector);
 
         ++athenaPIT->interestCount;
-        _athenaPIT_addInterestToLinkCleanupList(athenaPIT, ingressVector, entry);
 
         result = AthenaPITResolution_Aggregated;
     }
@@ -625,15 +1051,17 @@ athenaPIT_RemoveInterest(AthenaPIT *athenaPIT,
         parcBitVector_ClearVector(entry->ingress, clearVector);
 
         size_t nPostEntries = parcBitVector_NumberOfBitsSet(entry->ingress);
+        _athenaPIT_UnindexEntry(athenaPIT, entry, clearVector);
         if (nPostEntries == 0) {
             parcHashMap_Remove(athenaPIT->entryTable, key);
+            _athenaPIT_NameFilterRemove(athenaPIT, entry);
+            _athenaPIT_AgeListRemove(athenaPIT, entry);
+            _athenaPIT_removeInterestFromTimeoutTable(athenaPIT, entry);
         }
 
         athenaPIT->interestCount -= (nPreEntries - nPostEntries);
         _athenaPITEntry_Release(&entry);
 
-        _athenaPIT_removeInterestFromCleanupList(athenaPIT, clearVector, key);
-
         if (nPostEntries < nPreEntries) {
             result = true;
         }
@@ -646,8 +1074,55 @@ athenaPIT_RemoveInterest(AthenaPIT *athenaPIT,
     return result;
 }
 
+PARCBitVector *
+athenaPIT_ReturnInterest(AthenaPIT *athenaPIT,
+                         const CCNxInterestReturn *interestReturn,
+                         const PARCBitVector *returnVector,
+                         CCNxInterest **pendingInterest,
+                         PARCBitVector **expectedReturnVector,
+                         PARCBitVector **attemptedVector)
+{
+    PARCBitVector *result = NULL;
+
+    // The InterestReturn carries the original interest fields, so it resolves to the same key
+    PARCBuffer *key = _athenaPIT_acquireInterestKey(interestReturn);
+    _AthenaPITEntry *entry = (_AthenaPITEntry *) parcHashMap_Get(athenaPIT->entryTable, key);
+    parcBuffer_Release(&key);
+
+    // Only accept returns from a link we're still expecting a response from
+    if ((entry != NULL) && parcBitVector_Contains(entry->egress, returnVector)) {
+        parcBitVector_ClearVector(entry->egress, returnVector);
+        parcBitVector_SetVector(entry->returned, returnVector);
+
+        *pendingInterest = ccnxMetaMessage_Acquire(entry->ccnxMessage);
+        *expectedReturnVector = entry->egress;
+        *attemptedVector = parcBitVector_Or(entry->egress, entry->returned);
+        result = parcBitVector_Copy(entry->ingress);
+    }
+
+    return result;
+}
+
+bool
+athenaPIT_InterestSent(AthenaPIT *athenaPIT, const CCNxInterest *ccnxInterestMessage, const PARCBitVector *egressVector)
+{
+    PARCBuffer *key = _athenaPIT_acquireInterestKey(ccnxInterestMessage);
+    _AthenaPITEntry *entry = (_AthenaPITEntry *) parcHashMap_Get(athenaPIT->entryTable, key);
+    parcBuffer_Release(&key);
+
+    if (entry == NULL) {
+        return false;
+    }
+
+    uint64_t now = parcClock_GetTime(athenaPIT->clock);
+    for (int linkId = 0; (linkId = parcBitVector_NextBitSet(egressVector, linkId)) >= 0; linkId++) {
+        _athenaPITSendTimes_Set(entry->sendTimes, linkId, now);
+    }
+    return true;
+}
+
 static void
-_athenaPIT_LookupKey(AthenaPIT *athenaPIT, PARCBuffer *key, PARCBitVector *egressVector)
+_athenaPIT_LookupKey(AthenaPIT *athenaPIT, PARCBuffer *key, const PARCBitVector *ingressVector, PARCBitVector *egressVector)
 {
     _AthenaPITEntry *entry = (_AthenaPITEntry *) parcHashMap_Get(athenaPIT->entryTable, key);
 
@@ -655,10 +1130,23 @@ _athenaPIT_LookupKey(AthenaPIT *athenaPIT, PARCBuffer *key, PARCBitVector *egres
     if (entry != NULL) {
         uint64_t now = parcClock_GetTime(athenaPIT->clock);
         _athenaPIT_AddLifetimeStat(athenaPIT, _athenaPITEntry_Age(entry, now));
+
+        // Report the response time of the link that satisfied the interest, if we forwarded it there.
+        // The egress vector is shared with any nameless entry for the same interest, clear the link
+        // so the response is only reported once.
+        if ((athenaPIT->measurementCallback != NULL) && (ingressVector != NULL) &&
+            parcBitVector_Contains(entry->egress, ingressVector)) {
+            int linkId = parcBitVector_NextBitSet(ingressVector, 0);
+            athenaPIT->measurementCallback(athenaPIT->measurementContext, entry->ccnxMessage, linkId, true,
+                                           _athenaPITEntry_ResponseTime(entry, linkId, now));
+            parcBitVector_ClearVector(entry->egress, ingressVector);
+        }
         parcBitVector_SetVector(egressVector, entry->ingress);
 
         // Remove Match
-        _athenaPIT_removeInterestFromCleanupList(athenaPIT, entry->ingress, key);
+        _athenaPIT_UnindexEntry(athenaPIT, entry, NULL);
+        _athenaPIT_NameFilterRemove(athenaPIT, entry);
+        _athenaPIT_AgeListRemove(athenaPIT, entry);
         parcHashMap_Remove(athenaPIT->entryTable, key);
         _athenaPIT_removeInterestFromTimeoutTable(athenaPIT, entry);
         athenaPIT->interestCount -= parcBitVector_NumberOfBitsSet(egressVector);
@@ -680,7 +1168,7 @@ athenaPIT_Match(AthenaPIT *athenaPIT,
     // Match based on Name & Content Id Restriction & Key Id
     if ((contentId != NULL) && (keyId != NULL)) {
         key = _athenaPIT_createCompoundKey(name, contentId, keyId);
-        _athenaPIT_LookupKey(athenaPIT, key, result);
+        _athenaPIT_LookupKey(athenaPIT, key, ingressVector, result);
         parcBuffer_Release(&key);
     }
 
@@ -690,59 +1178,202 @@ athenaPIT_Match(AthenaPIT *athenaPIT,
     // hashable, we need to support this case.
     if (contentId != NULL) {
         key = _athenaPIT_createCompoundKey(name, contentId, NULL);
-        _athenaPIT_LookupKey(athenaPIT, key, result);
+        _athenaPIT_LookupKey(athenaPIT, key, ingressVector, result);
         parcBuffer_Release(&key);
     }
 
     // Match based on Name & Key Id
     if (keyId != NULL) {
         key = _athenaPIT_createCompoundKey(name, NULL, keyId);
-        _athenaPIT_LookupKey(athenaPIT, key, result);
+        _athenaPIT_LookupKey(athenaPIT, key, ingressVector, result);
         parcBuffer_Release(&key);
     }
 
     // Match based on Name only
     key = _athenaPIT_createCompoundKey(name, NULL, NULL);
-    _athenaPIT_LookupKey(athenaPIT, key, result);
+    _athenaPIT_LookupKey(athenaPIT, key, ingressVector, result);
     parcBuffer_Release(&key);
 
     return result;
 }
 
-bool
-athenaPIT_RemoveLink(AthenaPIT *athenaPIT, const PARCBitVector *ccnxLinkVector)
+void
+athenaPIT_SetMeasurementCallback(AthenaPIT *athenaPIT, AthenaPIT_MeasurementCallback *callback,
+                                 AthenaPIT_MeasurementCallbackContext context)
 {
-    bool result = true;
+    athenaPIT->measurementCallback = callback;
+    athenaPIT->measurementContext = context;
+}
 
-    for (int i = 0, bit = 0; i < parcBitVector_NumberOfBitsSet(ccnxLinkVector); ++i, bit++) {
-        bit = parcBitVector_NextBitSet(ccnxLinkVector, bit);
-        if (parcList_Size(athenaPIT->linkCleanupList) <= bit) {
-            break;
+void
+athenaPIT_SetEvictionCallback(AthenaPIT *athenaPIT, AthenaPIT_EvictionCallback *callback,
+                              AthenaPIT_EvictionCallbackContext context)
+{
+    athenaPIT->evictionCallback = callback;
+    athenaPIT->evictionContext = context;
+}
+
+void
+athenaPIT_SetClock(AthenaPIT *athenaPIT, PARCClock *clock)
+{
+    PARCClock *previous = athenaPIT->clock;
+    athenaPIT->clock = parcClock_Acquire(clock);
+    parcClock_Release(&previous);
+}
+
+static const char *_athenaPIT_OverflowPolicyNames[AthenaPITOverflowPolicy_Count] = {
+    "reject",
+    "evictOldest",
+    "evictSoonestExpiring",
+};
+
+void
+athenaPIT_SetOverflowPolicy(AthenaPIT *athenaPIT, AthenaPITOverflowPolicy policy)
+{
+    assertTrue(policy < AthenaPITOverflowPolicy_Count, "Invalid PIT overflow policy %d", policy);
+    athenaPIT->overflowPolicy = policy;
+}
+
+AthenaPITOverflowPolicy
+athenaPIT_GetOverflowPolicy(const AthenaPIT *athenaPIT)
+{
+    return athenaPIT->overflowPolicy;
+}
+
+const char *
+athenaPIT_OverflowPolicyName(AthenaPITOverflowPolicy policy)
+{
+    assertTrue(policy < AthenaPITOverflowPolicy_Count, "Invalid PIT overflow policy %d", policy);
+    return _athenaPIT_OverflowPolicyNames[policy];
+}
+
+bool
+athenaPIT_OverflowPolicyFromName(const char *name, AthenaPITOverflowPolicy *policy)
+{
+    for (int i = 0; i < AthenaPITOverflowPolicy_Count; i++) {
+        if (strcasecmp(name, _athenaPIT_OverflowPolicyNames[i]) == 0) {
+            *policy = (AthenaPITOverflowPolicy) i;
+            return true;
         }
+    }
+    return false;
+}
+
+size_t
+athenaPIT_GetOverflowCount(const AthenaPIT *athenaPIT, AthenaPITOverflowPolicy policy)
+{
+    assertTrue(policy < AthenaPITOverflowPolicy_Count, "Invalid PIT overflow policy %d", policy);
+    return athenaPIT->overflowCount[policy];
+}
+
+void
+athenaPIT_SetLinkQuota(AthenaPIT *athenaPIT, AthenaPITLinkQuotaMode mode, size_t limit)
+{
+    athenaPIT->linkQuotaMode = mode;
+    athenaPIT->linkQuotaLimit = limit;
+}
+
+void
+athenaPIT_SetLinkQuotaExemptPrefix(AthenaPIT *athenaPIT, const CCNxName *prefix)
+{
+    if (athenaPIT->linkQuotaExemptPrefix != NULL) {
+        ccnxName_Release(&athenaPIT->linkQuotaExemptPrefix);
+    }
+    if (prefix != NULL) {
+        athenaPIT->linkQuotaExemptPrefix = ccnxName_Acquire(prefix);
+    }
+}
+
+size_t
+athenaPIT_GetLinkQuota(const AthenaPIT *athenaPIT, int linkId)
+{
+    if (athenaPIT->linkQuotaMode == AthenaPITLinkQuotaMode_None) {
+        return SIZE_MAX;
+    }
 
-        PARCTreeMap *interestMap =
-            parcList_GetAtIndex(athenaPIT->linkCleanupList, bit);
-        if (interestMap == NULL) {
-            continue;
+    size_t result = athenaPIT->linkQuotaLimit;
+    if (athenaPIT->linkQuotaMode == AthenaPITLinkQuotaMode_Proportional) {
+        // Share the capacity with the active links, counting this one if it has nothing pending yet
+        size_t sharingLinks = athenaPIT->activeLinkCount;
+        if (athenaPIT_GetLinkPendingCount(athenaPIT, linkId) == 0) {
+            sharingLinks++;
         }
+        result = (athenaPIT->capacity / sharingLinks) * athenaPIT->linkQuotaLimit / 100;
+    }
 
-        PARCList*valueList = parcTreeMap_AcquireValues(interestMap);
-        for (size_t i = 0; i < parcList_Size(valueList); ++i) {
-            _AthenaPITEntry *entry = (_AthenaPITEntry *) parcList_GetAtIndex(valueList, i);
-            CCNxInterest *interest = entry->ccnxMessage;
-            _athenaPIT_RemoveInterestFromMap(athenaPIT, interest, ccnxLinkVector);
-            result = true;
+    return (result > 0) ? result : 1;
+}
+
+size_t
+athenaPIT_GetLinkPendingCount(const AthenaPIT *athenaPIT, int linkId)
+{
+    if ((linkId < 0) || (linkId >= athenaPIT->linkIndexSize)) {
+        return 0;
+    }
+    return athenaPIT->linkPendingCount[linkId];
+}
+
+bool
+athenaPIT_CheckLinkQuota(AthenaPIT *athenaPIT, const PARCBitVector *ingressVector)
+{
+    if (athenaPIT->linkQuotaMode == AthenaPITLinkQuotaMode_None) {
+        return true;
+    }
+
+    for (int linkId = 0; (linkId = parcBitVector_NextBitSet(ingressVector, linkId)) >= 0; linkId++) {
+        if (athenaPIT_GetLinkPendingCount(athenaPIT, linkId) >= athenaPIT_GetLinkQuota(athenaPIT, linkId)) {
+            athenaPIT->linkQuotaRejectCount++;
+            return false;
         }
-        parcList_Release(&valueList);
+    }
+    return true;
+}
 
-        parcList_SetAtIndex(athenaPIT->linkCleanupList, bit, NULL);
+size_t
+athenaPIT_GetLinkQuotaRejectCount(const AthenaPIT *athenaPIT)
+{
+    return athenaPIT->linkQuotaRejectCount;
+}
+
+bool
+athenaPIT_RemoveLink(AthenaPIT *athenaPIT, const PARCBitVector *ccnxLinkVector)
+{
+    bool result = true;
 
-        parcTreeMap_Release(&interestMap);
+    // Visit only the entries pending on each link, in time linear in their number
+    for (int linkId = 0; (linkId = parcBitVector_NextBitSet(ccnxLinkVector, linkId)) >= 0; linkId++) {
+        if (linkId >= athenaPIT->linkIndexSize) {
+            break;
+        }
+        while (athenaPIT->linkIndex[linkId] != NULL) {
+            _AthenaPITEntry *entry = _athenaPITEntry_Acquire(athenaPIT->linkIndex[linkId]->entry);
+            _athenaPIT_RemoveLinkNode(athenaPIT, athenaPIT->linkIndex[linkId]);
+            parcBitVector_Clear(entry->ingress, linkId);
+
+            // Take the entry out of the timeout table too, so its expiry isn't reported against links
+            // that may since have been given the removed link's id
+            if (entry->linkNodes == NULL) {
+                parcHashMap_Remove(athenaPIT->entryTable, entry->key);
+                _athenaPIT_NameFilterRemove(athenaPIT, entry);
+                _athenaPIT_AgeListRemove(athenaPIT, entry);
+                _athenaPIT_removeInterestFromTimeoutTable(athenaPIT, entry);
+            }
+            _athenaPITEntry_Release(&entry);
+        }
     }
 
     return result;
 }
 
+bool
+athenaPIT_MayMatchName(const AthenaPIT *athenaPIT, const uint8_t *name, size_t nameLength)
+{
+    if (athenaPIT->nameFilterUnhashed > 0) {
+        return true;
+    }
+    return athenaPIT->nameFilter[_athenaPIT_NameFilterSlot(name, nameLength)] > 0;
+}
+
 size_t
 athenaPIT_GetNumberOfTableEntries(const AthenaPIT *athenaPIT)
 {
@@ -792,6 +1423,13 @@ _createStatSizeResponsePayload(const AthenaPIT *athenaPIT, PARCClock *clock, CCN
     parcJSON_AddInteger(json, "time", parcClock_GetTime(clock));
     parcJSON_AddInteger(json, "numEntries", athenaPIT_GetNumberOfTableEntries(athenaPIT));
     parcJSON_AddInteger(json, "numPendingEntries", athenaPIT_GetNumberOfPendingInterests(athenaPIT));
+    parcJSON_AddString(json, "overflowPolicy", athenaPIT_OverflowPolicyName(athenaPIT->overflowPolicy));
+    parcJSON_AddInteger(json, "overflowRejected", athenaPIT->overflowCount[AthenaPITOverflowPolicy_Reject]);
+    parcJSON_AddInteger(json, "overflowEvictedOldest", athenaPIT->overflowCount[AthenaPITOverflowPolicy_EvictOldest]);
+    parcJSON_AddInteger(json, "overflowEvictedSoonestExpiring",
+                        athenaPIT->overflowCount[AthenaPITOverflowPolicy_EvictSoonestExpiring]);
+    parcJSON_AddInteger(json, "activeLinks", athenaPIT->activeLinkCount);
+    parcJSON_AddInteger(json, "linkQuotaRejected", athenaPIT_GetLinkQuotaRejectCount(athenaPIT));
 
     char *jsonString = parcJSON_ToString(json);
 
@@ -60,9 +60,11 @@
 #define libathena_athena_pit_h
 
 #include <parc/algol/parc_BitVector.h>
+#include <parc/algol/parc_Clock.h>
 
 #include <ccnx/common/ccnx_ContentObject.h>
 #include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_InterestReturn.h>
 
 #include <ccnx/transport/common/transport_MetaMessage.h>
 
@@ -76,7 +78,26 @@
  *
  *    athenaPIT_AddInterest
  *    athenaPIT_RemoveInterest
+ *    athenaPIT_ReturnInterest
+ *    athenaPIT_InterestSent
  *    athenaPIT_RemoveLink
+ *
+ *    athenaPIT_SetMeasurementCallback
+ *    athenaPIT_SetEvictionCallback
+ *    athenaPIT_SetClock
+ *
+ *    athenaPIT_SetOverflowPolicy
+ *    athenaPIT_GetOverflowPolicy
+ *    athenaPIT_OverflowPolicyName
+ *    athenaPIT_OverflowPolicyFromName
+ *    athenaPIT_GetOverflowCount
+ *
+ *    athenaPIT_SetLinkQuota
+ *    athenaPIT_SetLinkQuotaExemptPrefix
+ *    athenaPIT_GetLinkQuota
+ *    athenaPIT_GetLinkPendingCount
+ *    athenaPIT_CheckLinkQuota
+ *    athenaPIT_GetLinkQuotaRejectCount
  */
 
 /**
@@ -93,9 +114,60 @@ typedef struct athena_pit AthenaPIT;
 typedef enum AthenaPITResolution {
     AthenaPITResolution_Forward,
     AthenaPITResolution_Aggregated,
+    AthenaPITResolution_Congested, // the PIT or the link quota is full, the interest should be returned to tell its sender to back off
     AthenaPITResolution_Error = -1
 } AthenaPITResolution;
 
+/**
+ * @typedef AthenaPITOverflowPolicy
+ * @brief How room is made for a new entry when the PIT is at capacity and none of its entries have expired
+ */
+typedef enum AthenaPITOverflowPolicy {
+    AthenaPITOverflowPolicy_Reject = 0,              // the interest isn't added, AthenaPITResolution_Congested is returned
+    AthenaPITOverflowPolicy_EvictOldest = 1,         // the entry that was added first is removed
+    AthenaPITOverflowPolicy_EvictSoonestExpiring = 2 // the entry that will expire first is removed
+} AthenaPITOverflowPolicy;
+
+#define AthenaPITOverflowPolicy_Count 3
+
+/**
+ * @typedef AthenaPITLinkQuotaMode
+ * @brief How the number of entries an ingress link may have pending in the PIT is limited
+ */
+typedef enum AthenaPITLinkQuotaMode {
+    AthenaPITLinkQuotaMode_None = 0,        // links may fill the PIT
+    AthenaPITLinkQuotaMode_Static = 1,      // each link may have up to limit entries pending
+    AthenaPITLinkQuotaMode_Proportional = 2 // each link may have up to limit percent of its share of the capacity
+} AthenaPITLinkQuotaMode;
+
+/**
+ * @typedef AthenaPIT_MeasurementCallbackContext
+ * @brief Context passed back to the measurement callback
+ */
+typedef void *AthenaPIT_MeasurementCallbackContext;
+
+/**
+ * @typedef AthenaPIT_MeasurementCallback
+ * @brief Called for each link an Interest was forwarded on, when the PIT entry is satisfied by a
+ * Content Object arriving on the link (satisfied == true, responseTime is the entry age in
+ * milliseconds) or expires with the Interest still outstanding on the link (satisfied == false).
+ */
+typedef void (AthenaPIT_MeasurementCallback)(AthenaPIT_MeasurementCallbackContext context, const CCNxInterest *interest,
+                                             int linkId, bool satisfied, uint64_t responseTime);
+
+/**
+ * @typedef AthenaPIT_EvictionCallbackContext
+ * @brief Context passed back to the eviction callback
+ */
+typedef void *AthenaPIT_EvictionCallbackContext;
+
+/**
+ * @typedef AthenaPIT_EvictionCallback
+ * @brief Called when the overflow policy evicts an Interest, with the links it was pending on.
+ */
+typedef void (AthenaPIT_EvictionCallback)(AthenaPIT_EvictionCallbackContext context, CCNxInterest *interest,
+                                          PARCBitVector *ingressVector);
+
 /**
  * @abstract Create a PIT table with the default entry limit.
  * @discussion
@@ -160,7 +232,9 @@ void athenaPIT_Release(AthenaPIT **athenaPIT);
  * @param [in] ccnxInterestMessage
  * @param [in] ingressVector
  * @param [out] expectedReturnVector
- * @return AthenaPITResolution_Aggregated if aggregated, AthenaPITResolution_Forward if it needs to be forwarded, AthenaPITResolution_Error on error.
+ * @return AthenaPITResolution_Aggregated if aggregated, AthenaPITResolution_Forward if it needs to be forwarded,
+ *         AthenaPITResolution_Congested if it needed a new entry and an ingress link is at its quota or the PIT is full
+ *         and its overflow policy rejected it, AthenaPITResolution_Error on error.
  *
  * Example:
  * @code
@@ -196,6 +270,74 @@ bool athenaPIT_RemoveInterest(AthenaPIT *athenaPIT,
                               const CCNxInterest *ccnxInterestMessage,
                               const PARCBitVector *ingressVector);
 
+/**
+ * @abstract Account for an InterestReturn received for a pending interest
+ * @discussion
+ *
+ * Verifies that the InterestReturn arrived from a link the pending interest was forwarded to.
+ * If so, that link is removed from the entry's expected return vector and remembered so that
+ * the interest is not retried on it again.  The caller may then either wait for the remaining
+ * upstream links, retry the pending interest on an untried link (adding it to expectedReturnVector),
+ * or return the InterestReturn downstream and remove the entry.
+ *
+ * @param [in] athenaPIT
+ * @param [in] interestReturn InterestReturn that was received
+ * @param [in] returnVector link the InterestReturn was received from
+ * @param [out] pendingInterest the interest that was originally forwarded, must be released by the caller
+ * @param [out] expectedReturnVector links the interest is still outstanding on
+ * @param [out] attemptedVector links the interest has been forwarded to, must be released by the caller
+ * @return vector of downstream links for the entry, NULL if the return was not expected
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxInterest *pendingInterest;
+ *     PARCBitVector *expectedReturnVector;
+ *     PARCBitVector *attemptedVector;
+ *     PARCBitVector *downstreamVector = athenaPIT_ReturnInterest(athenaPIT, interestReturn, ingressVector,
+ *                                                                &pendingInterest, &expectedReturnVector,
+ *                                                                &attemptedVector);
+ *     if (downstreamVector) {
+ *         ...
+ *         ccnxInterest_Release(&pendingInterest);
+ *         parcBitVector_Release(&attemptedVector);
+ *         parcBitVector_Release(&downstreamVector);
+ *     }
+ * }
+ * @endcode
+ */
+PARCBitVector *athenaPIT_ReturnInterest(AthenaPIT *athenaPIT,
+                                        const CCNxInterestReturn *interestReturn,
+                                        const PARCBitVector *returnVector,
+                                        CCNxInterest **pendingInterest,
+                                        PARCBitVector **expectedReturnVector,
+                                        PARCBitVector **attemptedVector);
+
+/**
+ * @abstract Record that a pending interest was sent on links after its entry was created
+ * @discussion
+ *
+ * The response time reported to the measurement callback is measured from when the interest was sent
+ * on the link that answered.  Interests forwarded as soon as they are added don't need to be recorded,
+ * their entry's creation time is used, but retries on other links and interests that were held before
+ * being sent should be, so the time they weren't outstanding on the link isn't charged to it.
+ *
+ * @param [in] athenaPIT
+ * @param [in] ccnxInterestMessage the pending interest
+ * @param [in] egressVector links the interest was sent on
+ * @return false if the interest is no longer pending
+ *
+ * Example:
+ * @code
+ * {
+ *     if (athenaPIT_InterestSent(athenaPIT, pendingInterest, retryVector) == false) {
+ *         // satisfied, expired or evicted while it was held
+ *     }
+ * }
+ * @endcode
+ */
+bool athenaPIT_InterestSent(AthenaPIT *athenaPIT, const CCNxInterest *ccnxInterestMessage, const PARCBitVector *egressVector);
+
 /**
  * @abstract get the delivery vector in the PIT for a message
  * @discussion
@@ -223,6 +365,34 @@ PARCBitVector *athenaPIT_Match(AthenaPIT *athenaPIT,
                                const PARCBuffer *contentId,
                                const PARCBitVector *ingressVector);
 
+/**
+ * @abstract check if a content name could match any entry in the PIT
+ * @discussion
+ *
+ * Named entries are counted by a hash of the name in their Interest's wire format, so a message can
+ * be tested before it's decoded.  A false result means no entry has the name and the message can be
+ * dropped; true may be a false positive, and is always returned while the PIT holds Interests that
+ * were never encoded.
+ *
+ * @param [in] athenaPIT
+ * @param [in] name wire format value of the message's name TLV
+ * @param [in] nameLength length of the name value
+ * @return false if no entry in the PIT has the name
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaPacketDescriptor descriptor;
+ *     if (athenaPacketDescriptor_Parse(&descriptor, wireFormatBuffer) && athenaPacketDescriptor_HasName(&descriptor)) {
+ *         if (athenaPIT_MayMatchName(athenaPIT, descriptor.name, descriptor.nameLength) == false) {
+ *             // unsolicited
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+bool athenaPIT_MayMatchName(const AthenaPIT *athenaPIT, const uint8_t *name, size_t nameLength);
+
 /**
  * @abstract Remove the specified link from any and all PIT entries.
  * @discussion
@@ -245,6 +415,232 @@ PARCBitVector *athenaPIT_Match(AthenaPIT *athenaPIT,
  */
 bool athenaPIT_RemoveLink(AthenaPIT *athenaPIT, const PARCBitVector *ccnxLinkVector);
 
+/**
+ * @abstract Register a function to receive per link response time and expiration reports
+ * @discussion
+ *
+ * Only a single callback is supported, setting a new one replaces the previous one.  Passing NULL
+ * disables reporting.
+ *
+ * @param [in] athenaPIT
+ * @param [in] callback
+ * @param [in] context passed to the callback
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPIT_SetMeasurementCallback(athenaPIT, _measurementCallback, athena);
+ * }
+ * @endcode
+ */
+void athenaPIT_SetMeasurementCallback(AthenaPIT *athenaPIT, AthenaPIT_MeasurementCallback *callback,
+                                      AthenaPIT_MeasurementCallbackContext context);
+
+/**
+ * @abstract Register a function to be told of the Interests the overflow policy evicts
+ * @discussion
+ *
+ * The callback is made from athenaPIT_AddInterest once the evicted Interest has been removed, so that
+ * it can be returned to the links it was pending on.  Only a single callback is supported, setting a
+ * new one replaces the previous one.  Passing NULL disables reporting.
+ *
+ * @param [in] athenaPIT
+ * @param [in] callback
+ * @param [in] context passed to the callback
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPIT_SetEvictionCallback(athenaPIT, _evictionCallback, athena);
+ * }
+ * @endcode
+ */
+void athenaPIT_SetEvictionCallback(AthenaPIT *athenaPIT, AthenaPIT_EvictionCallback *callback,
+                                   AthenaPIT_EvictionCallbackContext context);
+
+/**
+ * @abstract Replace the clock used to time Interest lifetimes and response times
+ * @discussion
+ *
+ * The PIT uses the monotonic clock by default.  A different clock can be provided to run the PIT
+ * on simulated time, it should be set before any Interests are added since the expiration times
+ * of pending entries are not converted.
+ *
+ * @param [in] athenaPIT
+ * @param [in] clock millisecond clock, a reference is acquired
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPIT_SetClock(athenaPIT, virtualClock);
+ * }
+ * @endcode
+ */
+void athenaPIT_SetClock(AthenaPIT *athenaPIT, PARCClock *clock);
+
+/**
+ * @abstract Set how a new interest is handled when the PIT is full
+ * @discussion
+ *
+ * When a new entry is needed and the PIT is at capacity, expired entries are purged first.  If that
+ * doesn't free any room the overflow policy either rejects the interest, so that it can be returned
+ * with a Congestion code, or evicts an existing entry in its place.  An evicted interest is removed along
+ * with the nameless entry made for its ContentObjectHashRestriction, and reported to the eviction callback
+ * so that it can be returned downstream.  The default policy is AthenaPITOverflowPolicy_Reject.
+ *
+ * @param [in] athenaPIT
+ * @param [in] policy
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPIT_SetOverflowPolicy(athenaPIT, AthenaPITOverflowPolicy_EvictSoonestExpiring);
+ * }
+ * @endcode
+ */
+void athenaPIT_SetOverflowPolicy(AthenaPIT *athenaPIT, AthenaPITOverflowPolicy policy);
+
+/**
+ * @abstract Return the policy applied when the PIT is full
+ *
+ * @param [in] athenaPIT
+ * @return the overflow policy
+ */
+AthenaPITOverflowPolicy athenaPIT_GetOverflowPolicy(const AthenaPIT *athenaPIT);
+
+/**
+ * @abstract Return the name of an overflow policy, as used in PIT stats and control commands
+ *
+ * @param [in] policy
+ * @return "reject", "evictOldest" or "evictSoonestExpiring"
+ */
+const char *athenaPIT_OverflowPolicyName(AthenaPITOverflowPolicy policy);
+
+/**
+ * @abstract Look up an overflow policy by name, ignoring case
+ *
+ * @param [in] name
+ * @param [out] policy set to the policy if it was found
+ * @return true if the name is a policy name
+ */
+bool athenaPIT_OverflowPolicyFromName(const char *name, AthenaPITOverflowPolicy *policy);
+
+/**
+ * @abstract Return the number of times the PIT overflowed and was handled as the policy specifies
+ * @discussion
+ *
+ * For AthenaPITOverflowPolicy_Reject this is the number of interests rejected, for the eviction
+ * policies the number of entries evicted.  An eviction policy that finds nothing to evict rejects
+ * the interest instead, which is counted as a rejection.
+ *
+ * @param [in] athenaPIT
+ * @param [in] policy
+ * @return count of overflows handled by the policy
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t rejected = athenaPIT_GetOverflowCount(athenaPIT, AthenaPITOverflowPolicy_Reject);
+ * }
+ * @endcode
+ */
+size_t athenaPIT_GetOverflowCount(const AthenaPIT *athenaPIT, AthenaPITOverflowPolicy policy);
+
+/**
+ * @abstract Limit the number of entries each ingress link may have pending
+ * @discussion
+ *
+ * With AthenaPITLinkQuotaMode_Static each link may have up to limit entries pending.  With
+ * AthenaPITLinkQuotaMode_Proportional the capacity is shared evenly between the links with entries
+ * pending, counting the link being checked, and each may have up to limit percent of its share, so
+ * 100 is a strictly even split and larger values let lightly loaded PITs absorb bursts.  A quota is
+ * never less than 1.
+ *
+ * The quota is applied by athenaPIT_AddInterest when an interest needs a new entry, interests that
+ * are aggregated or duplicate an entry are always accepted.  An interest with a content object hash
+ * restriction is counted once, although it holds a second entry without a name.
+ *
+ * @param [in] athenaPIT
+ * @param [in] mode AthenaPITLinkQuotaMode_None, the default, removes the quota
+ * @param [in] limit entries or percent, depending on the mode
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPIT_SetLinkQuota(athenaPIT, AthenaPITLinkQuotaMode_Proportional, 200);
+ * }
+ * @endcode
+ */
+void athenaPIT_SetLinkQuota(AthenaPIT *athenaPIT, AthenaPITLinkQuotaMode mode, size_t limit);
+
+/**
+ * @abstract Exempt interests under a prefix from the link quota
+ * @discussion
+ *
+ * Used to keep the forwarder's control interests from being refused on a link that has reached its
+ * quota.  Only a single prefix is supported, setting a new one replaces the previous one.  Passing NULL
+ * removes the exemption.
+ *
+ * @param [in] athenaPIT
+ * @param [in] prefix name prefix of the exempt interests, or NULL
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPIT_SetLinkQuotaExemptPrefix(athenaPIT, athena->athenaName);
+ * }
+ * @endcode
+ */
+void athenaPIT_SetLinkQuotaExemptPrefix(AthenaPIT *athenaPIT, const CCNxName *prefix);
+
+/**
+ * @abstract Return the number of entries a link may currently have pending
+ *
+ * @param [in] athenaPIT
+ * @param [in] linkId
+ * @return the link's quota, SIZE_MAX if there is none
+ */
+size_t athenaPIT_GetLinkQuota(const AthenaPIT *athenaPIT, int linkId);
+
+/**
+ * @abstract Return the number of entries pending on a link
+ *
+ * @param [in] athenaPIT
+ * @param [in] linkId
+ * @return number of entries with the link in their ingress vector
+ */
+size_t athenaPIT_GetLinkPendingCount(const AthenaPIT *athenaPIT, int linkId);
+
+/**
+ * @abstract Check that the links an interest arrived on are within their quota
+ * @discussion
+ *
+ * Called by athenaPIT_AddInterest before it adds a new entry for an interest, so that a link flooding
+ * the PIT can't take it from the others.  Interests that are refused are counted.
+ *
+ * @param [in] athenaPIT
+ * @param [in] ingressVector links the interest arrived on
+ * @return false if any of the links has reached its quota
+ *
+ * Example:
+ * @code
+ * {
+ *     if (athenaPIT_CheckLinkQuota(athenaPIT, ingressVector) == false) {
+ *         // a new interest from these links would be returned with a Congestion code
+ *     }
+ * }
+ * @endcode
+ */
+bool athenaPIT_CheckLinkQuota(AthenaPIT *athenaPIT, const PARCBitVector *ingressVector);
+
+/**
+ * @abstract Return the number of interests refused by athenaPIT_CheckLinkQuota
+ *
+ * @param [in] athenaPIT
+ * @return count of refused interests
+ */
+size_t athenaPIT_GetLinkQuotaRejectCount(const AthenaPIT *athenaPIT);
+
 /**
  * @abstract Get the current number of PIT table entries.
  * @discussion
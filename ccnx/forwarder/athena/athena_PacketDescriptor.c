@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <ccnx/forwarder/athena/athena_PacketDescriptor.h>
+
+/*
+ * CCNx 1.0 wire format constants, see the CCNx messages in TLV format specification.
+ */
+#define _FixedHeaderLength              8
+#define _FixedHeader_Version            1
+#define _TLVHeaderLength                4
+#define _FixedHeader_HopLimitOffset     4
+
+#define _HopByHop_InterestLifetime      0x0001
+
+#define _MessageType_Interest           0x0001
+
+#define _Message_Name                   0x0000
+#define _Interest_KeyIdRestriction      0x0002
+#define _Interest_ObjectHashRestriction 0x0003
+
+static inline uint16_t
+_readUint16(const uint8_t *bytes)
+{
+    return (uint16_t) ((bytes[0] << 8) | bytes[1]);
+}
+
+// Read from the start of the buffer, its position may have been left anywhere by a decoder
+static inline uint8_t *
+_packetStart(const PARCBuffer *wireFormatBuffer)
+{
+    return parcByteArray_Array(parcBuffer_Array(wireFormatBuffer)) + parcBuffer_ArrayOffset(wireFormatBuffer);
+}
+
+bool
+athenaPacketDescriptor_ParseArray(AthenaPacketDescriptor *descriptor, const uint8_t *packet, size_t length)
+{
+    memset(descriptor, 0, sizeof(AthenaPacketDescriptor));
+
+    if (length < _FixedHeaderLength) {
+        return false;
+    }
+    descriptor->version = packet[0];
+    descriptor->packetType = packet[1];
+    descriptor->packetLength = _readUint16(&packet[2]);
+    descriptor->hopLimitOffset = _FixedHeader_HopLimitOffset;
+    descriptor->hopLimit = packet[descriptor->hopLimitOffset];
+    descriptor->headerLength = packet[7];
+
+    if (descriptor->version != _FixedHeader_Version) {
+        return false;
+    }
+    if ((descriptor->packetLength > length) || (descriptor->headerLength < _FixedHeaderLength) ||
+        (descriptor->headerLength + _TLVHeaderLength > descriptor->packetLength)) {
+        return false;
+    }
+
+    // Hop-by-hop headers, of which only the Interest lifetime is of interest
+    size_t offset = _FixedHeaderLength;
+    while (offset < descriptor->headerLength) {
+        if (offset + _TLVHeaderLength > descriptor->headerLength) {
+            return false;
+        }
+        uint16_t type = _readUint16(&packet[offset]);
+        size_t valueLength = _readUint16(&packet[offset + 2]);
+        offset += _TLVHeaderLength;
+        if (offset + valueLength > descriptor->headerLength) {
+            return false;
+        }
+        if ((type == _HopByHop_InterestLifetime) && (valueLength > 0) && (valueLength <= sizeof(uint64_t))) {
+            descriptor->hasLifetime = true;
+            descriptor->lifetime = 0;
+            for (size_t i = 0; i < valueLength; i++) {
+                descriptor->lifetime = (descriptor->lifetime << 8) | packet[offset + i];
+            }
+        }
+        offset += valueLength;
+    }
+
+    // The message TLV, validation TLVs that may follow it are not examined
+    descriptor->messageType = _readUint16(&packet[offset]);
+    size_t messageEnd = offset + _TLVHeaderLength + _readUint16(&packet[offset + 2]);
+    if (messageEnd > descriptor->packetLength) {
+        return false;
+    }
+    offset += _TLVHeaderLength;
+
+    while (offset < messageEnd) {
+        if (offset + _TLVHeaderLength > messageEnd) {
+            return false;
+        }
+        uint16_t type = _readUint16(&packet[offset]);
+        size_t valueLength = _readUint16(&packet[offset + 2]);
+        offset += _TLVHeaderLength;
+        if (offset + valueLength > messageEnd) {
+            return false;
+        }
+        if (type == _Message_Name) {
+            descriptor->name = &packet[offset];
+            descriptor->nameLength = valueLength;
+        } else if (descriptor->messageType == _MessageType_Interest) {
+            if (type == _Interest_KeyIdRestriction) {
+                descriptor->keyIdRestriction = &packet[offset];
+                descriptor->keyIdRestrictionLength = valueLength;
+            } else if (type == _Interest_ObjectHashRestriction) {
+                descriptor->objectHashRestriction = &packet[offset];
+                descriptor->objectHashRestrictionLength = valueLength;
+            }
+        }
+        offset += valueLength;
+    }
+    return true;
+}
+
+bool
+athenaPacketDescriptor_Parse(AthenaPacketDescriptor *descriptor, const PARCBuffer *wireFormatBuffer)
+{
+    return athenaPacketDescriptor_ParseArray(descriptor, _packetStart(wireFormatBuffer), parcBuffer_Limit(wireFormatBuffer));
+}
+
+bool
+athenaPacketDescriptor_HasName(const AthenaPacketDescriptor *descriptor)
+{
+    return descriptor->name != NULL;
+}
+
+bool
+athenaPacketDescriptor_SetHopLimitArray(uint8_t *packet, size_t length, uint8_t hopLimit)
+{
+    if ((length < _FixedHeaderLength) || (packet[0] != _FixedHeader_Version)) {
+        return false;
+    }
+    packet[_FixedHeader_HopLimitOffset] = hopLimit;
+    return true;
+}
+
+bool
+athenaPacketDescriptor_SetHopLimit(PARCBuffer *wireFormatBuffer, uint8_t hopLimit)
+{
+    return athenaPacketDescriptor_SetHopLimitArray(_packetStart(wireFormatBuffer), parcBuffer_Limit(wireFormatBuffer), hopLimit);
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_PacketDescriptor_h
+#define libathena_PacketDescriptor_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+/*
+ * A descriptor is filled in from the fixed header and the top level TLVs of a CCNx 1.0 packet
+ * without decoding it into a dictionary.  The forwarder uses it to make its early decisions
+ * (hop limit, unsolicited content) on a received wire buffer, and only fully decodes the messages
+ * it keeps.
+ */
+
+/**
+ * @typedef AthenaPacketDescriptor_PacketType
+ * @brief Packet types carried in the fixed header
+ */
+typedef enum {
+    AthenaPacketDescriptor_PacketType_Interest = 0x00,
+    AthenaPacketDescriptor_PacketType_ContentObject = 0x01,
+    AthenaPacketDescriptor_PacketType_InterestReturn = 0x02,
+    AthenaPacketDescriptor_PacketType_Control = 0xA4
+} AthenaPacketDescriptor_PacketType;
+
+/**
+ * @typedef AthenaPacketDescriptor
+ * @brief Fields of a wire format packet, referring into the buffer it was parsed from
+ *
+ * Pointers are only valid while the parsed buffer is.  Optional fields that aren't in the packet
+ * have a NULL pointer and a zero length.
+ */
+typedef struct athena_packet_descriptor {
+    uint8_t version;
+    uint8_t packetType;              // AthenaPacketDescriptor_PacketType
+    uint8_t hopLimit;                // only meaningful for Interests and Interest Returns
+    size_t hopLimitOffset;           // offset of the hop limit byte in the packet
+    size_t packetLength;
+    size_t headerLength;             // fixed header and hop-by-hop headers
+    uint16_t messageType;            // type of the CCNx message TLV
+    const uint8_t *name;             // value of the name TLV
+    size_t nameLength;
+    bool hasLifetime;
+    uint64_t lifetime;               // Interest lifetime hop-by-hop header, in milliseconds
+    const uint8_t *keyIdRestriction; // value of the Interest KeyId restriction TLV
+    size_t keyIdRestrictionLength;
+    const uint8_t *objectHashRestriction; // value of the Interest content object hash restriction TLV
+    size_t objectHashRestrictionLength;
+} AthenaPacketDescriptor;
+
+/**
+ * @abstract Parse a wire format buffer into a descriptor
+ * @discussion
+ *
+ * Only the fixed header, the hop-by-hop headers and the TLVs directly inside the message TLV are
+ * read, nothing is copied or allocated.  The packet is read from the start of the buffer whatever
+ * its position, which is not changed.  A packet passing this check may still fail a full decode,
+ * for example on a malformed name segment.
+ *
+ * @param [out] descriptor filled in on success
+ * @param [in] wireFormatBuffer holding one packet between its start and limit
+ * @return true if the packet's framing is consistent
+ * @return false if the packet is truncated, has an unknown version or its TLVs overrun
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaPacketDescriptor descriptor;
+ *     if (athenaPacketDescriptor_Parse(&descriptor, wireFormatBuffer)) {
+ *         if (descriptor.packetType == AthenaPacketDescriptor_PacketType_Interest) {
+ *             ...
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+bool athenaPacketDescriptor_Parse(AthenaPacketDescriptor *descriptor, const PARCBuffer *wireFormatBuffer);
+
+/**
+ * @abstract Parse a packet held in contiguous memory
+ *
+ * @param [out] descriptor filled in on success
+ * @param [in] packet first byte of the fixed header
+ * @param [in] length number of bytes available at packet
+ * @return true if the packet's framing is consistent
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaPacketDescriptor descriptor;
+ *     bool valid = athenaPacketDescriptor_ParseArray(&descriptor, datagram, datagramLength);
+ * }
+ * @endcode
+ */
+bool athenaPacketDescriptor_ParseArray(AthenaPacketDescriptor *descriptor, const uint8_t *packet, size_t length);
+
+/**
+ * @abstract Determine if a descriptor's packet carries a name
+ *
+ * @param [in] descriptor
+ * @return true if the message has a name TLV
+ *
+ * Example:
+ * @code
+ * {
+ *     if (athenaPacketDescriptor_HasName(&descriptor)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool athenaPacketDescriptor_HasName(const AthenaPacketDescriptor *descriptor);
+
+/**
+ * @abstract Rewrite the hop limit in the fixed header of a wire format buffer
+ * @discussion
+ *
+ * The byte is changed in place, the rest of the packet is left as it is and nothing is re-encoded.
+ *
+ * @param [in,out] wireFormatBuffer holding one packet from its start
+ * @param [in] hopLimit new hop limit
+ * @return false if the buffer doesn't start with a version 1 fixed header
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPacketDescriptor_SetHopLimit(wireFormatBuffer, descriptor.hopLimit - 1);
+ * }
+ * @endcode
+ */
+bool athenaPacketDescriptor_SetHopLimit(PARCBuffer *wireFormatBuffer, uint8_t hopLimit);
+
+/**
+ * @abstract Rewrite the hop limit in the fixed header of a packet held in memory
+ *
+ * @param [in,out] packet first byte of the fixed header
+ * @param [in] length number of bytes available at packet, at least the fixed header
+ * @param [in] hopLimit new hop limit
+ * @return false if the memory doesn't start with a version 1 fixed header
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaPacketDescriptor_SetHopLimitArray(iov[0].iov_base, iov[0].iov_len, hopLimit);
+ * }
+ * @endcode
+ */
+bool athenaPacketDescriptor_SetHopLimitArray(uint8_t *packet, size_t length, uint8_t hopLimit);
+#endif // libathena_PacketDescriptor_h
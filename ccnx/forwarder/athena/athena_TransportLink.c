@@ -310,6 +310,23 @@ void
 athenaTransportLink_SetEventFd(AthenaTransportLink *athenaTransportLink, int eventFd)
 {
     athenaTransportLink->eventFd = eventFd;
+    athenaTransportLink->linkFlags &= ~AthenaTransportLinkFlag_SendPollable;
+}
+
+void
+athenaTransportLink_SetSendPollable(AthenaTransportLink *athenaTransportLink, bool sendPollable)
+{
+    if (sendPollable == true) {
+        athenaTransportLink->linkFlags |= AthenaTransportLinkFlag_SendPollable;
+    } else {
+        athenaTransportLink->linkFlags &= ~AthenaTransportLinkFlag_SendPollable;
+    }
+}
+
+bool
+athenaTransportLink_IsSendPollable(AthenaTransportLink *athenaTransportLink)
+{
+    return (athenaTransportLink->linkFlags & AthenaTransportLinkFlag_SendPollable) != 0;
 }
 
 int
@@ -120,7 +120,8 @@ typedef void *AthenaTransportLink_AddLinkCallbackContext;
 typedef enum {
     AthenaTransportLinkFlag_None          = 0x00,
     AthenaTransportLinkFlag_IsNotRoutable = 0x01,
-    AthenaTransportLinkFlag_IsLocal       = 0x02
+    AthenaTransportLinkFlag_IsLocal       = 0x02,
+    AthenaTransportLinkFlag_SendPollable  = 0x04  // the event fd is the descriptor the link sends on
 } AthenaTransportLinkFlag;
 
 #define AthenaTransportLink_ForcedLocal  1
@@ -432,6 +433,8 @@ int athenaTransportLink_GetEventFd(AthenaTransportLink *athenaTransportLink);
  * @abstract allow the transport link adapter to poll events for the link
  * @discussion
  *
+ * Setting the event fd clears the link's send pollable flag, see athenaTransportLink_SetSendPollable.
+ *
  * @param [in] athenaTransportLink link adapter instance
  * @param [in] fd file descriptor to poll, -1 if polling is to be performed locally
  *
@@ -444,6 +447,43 @@ int athenaTransportLink_GetEventFd(AthenaTransportLink *athenaTransportLink);
  */
 void athenaTransportLink_SetEventFd(AthenaTransportLink *athenaTransportLink, int eventFd);
 
+/**
+ * @abstract mark the link's event fd as the descriptor it sends on
+ * @discussion
+ *
+ * The transport link adapter then waits for POLLOUT on the event fd to resume sending messages
+ * queued while the link was blocked.  Links whose event fd only signals receives (e.g. an eventfd
+ * or a pipe from a receive thread) are retried on a timer instead.
+ *
+ * @param [in] athenaTransportLink link instance
+ * @param [in] sendPollable true if POLLOUT on the event fd says the link can send
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+ *     athenaTransportLink_SetSendPollable(athenaTransportLink, true);
+ * }
+ * @endcode
+ */
+void athenaTransportLink_SetSendPollable(AthenaTransportLink *athenaTransportLink, bool sendPollable);
+
+/**
+ * @abstract tell us if POLLOUT on the link's event fd says the link can send
+ * @discussion
+ *
+ * @param [in] athenaTransportLink link instance
+ * @return true if the event fd is the descriptor the link sends on
+ *
+ * Example:
+ * @code
+ * {
+ *     bool pollable = athenaTransportLink_IsSendPollable(athenaTransportLink);
+ * }
+ * @endcode
+ */
+bool athenaTransportLink_IsSendPollable(AthenaTransportLink *athenaTransportLink);
+
 /**
  * @abstract set a flag on the link
  * @discussion
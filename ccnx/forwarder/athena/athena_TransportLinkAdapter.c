@@ -112,11 +112,37 @@
 #include <ccnx/forwarder/athena/athena.h>
 #include <ccnx/forwarder/athena/athena_TransportLinkAdapter.h>
 
+#include <parc/algol/parc_Clock.h>
+#include <parc/algol/parc_Hash.h>
+#include <parc/algol/parc_HashCodeTable.h>
 #include <parc/logging/parc_LogReporterTextStdout.h>
 
 
 typedef PARCArrayList *(*ModuleInit)(void);
 
+/**
+ * @typedef _AthenaLinkRegistration
+ * @brief Where a registered link lives in the adapter's lists, indexed by link name
+ */
+typedef struct _AthenaLinkRegistration {
+    AthenaTransportLink *athenaTransportLink;
+    int linkId;      // instanceList index, -1 for listeners
+    int pollfdIndex; // pollfd list index, -1 if the link has no event fd
+} _AthenaLinkRegistration;
+
+/**
+ * @typedef _AthenaSlotList
+ * @brief Min-heap of vacated list indexes available for reuse, the lowest is reused first
+ */
+typedef struct _AthenaSlotList {
+    int *slots;
+    int count;
+    int capacity;
+} _AthenaSlotList;
+
+#define EGRESS_RETRY_MIN_TIMEOUT 1  // ms, first wait before retrying queued messages on links that can't be polled
+#define EGRESS_RETRY_MAX_TIMEOUT 64 // ms, longest wait the retries back off to
+
 /**
  * @typedef AthenaTransportLinkAdapter
  * @brief Link Adapter Transport private data
@@ -125,6 +151,9 @@ struct AthenaTransportLinkAdapter {
     PARCArrayList *moduleList;   // list of available AthenaTransportLinkModule link modules
     PARCArrayList *instanceList; // list of active AthenaTransportLink instances
     PARCArrayList *listenerList; // list of listening AthenaTransportLink instances
+    PARCHashCodeTable *linkNameTable; // link name to _AthenaLinkRegistration for all registered links
+    _AthenaSlotList freeLinkIds; // vacated instanceList indexes
+    _AthenaSlotList freePollfdSlots; // vacated pollfd list indexes
     struct pollfd *pollfdReceiveList;
     struct pollfd *pollfdSendList;
     AthenaTransportLink **pollfdTransportLink;
@@ -132,6 +161,24 @@ struct AthenaTransportLinkAdapter {
     void (*removeLink)(AthenaTransportLinkAdapter_RemoveLinkCallbackContext removeLinkContext, PARCBitVector *parcBitVector);
     AthenaTransportLinkAdapter_RemoveLinkCallbackContext removeLinkContext;
     int nextLinkToRead;
+    AthenaEgressScheduler **egressScheduler; // egress queues of each routable link, indexed by link id
+    int egressSchedulerSize;
+    size_t egressQueued; // messages queued on all links
+    int egressRetryTimeout; // ms, wait before retrying queued messages on links that can't be polled
+    struct {
+        size_t weight;
+        size_t queueLimit;
+    } egressDefault[AthenaEgressClass_Count]; // class settings given to new links
+    AthenaInterestShaper **interestShaper; // Interest shapers of each routable link, indexed by link id
+    int interestShaperSize;
+    size_t interestsHeld; // Interests held by the shapers of all links
+    AthenaTransportLinkAdapter_ReleaseInterestCallback *releaseInterest;
+    AthenaTransportLinkAdapter_ReleaseInterestCallbackContext releaseInterestContext;
+    struct {
+        uint64_t bandwidth;
+        uint64_t maxDelay;
+    } shapingDefault; // shaper settings given to new links
+    PARCClock *clock;
     PARCLog *log;
     struct {
         size_t messageSent;
@@ -140,13 +187,191 @@ struct AthenaTransportLinkAdapter {
         size_t messageSend_LinkDoesNotExist;
         size_t messageSend_LinkNotAcceptingSendRequests;
         size_t messageSend_LinkSendFailed;
+        size_t messageSend_WireFormatPrepared; // shared encodings created for sends to several links
+        size_t messageSend_WireFormatShared; // link sends that used a shared encoding
+        size_t messageSend_Queued; // messages queued because their link was busy
+        size_t messageSend_QueueFull; // messages dropped because their class queue was full
+        size_t messageSend_InterestShaped; // Interests held until their link had capacity for the response
+        size_t messageSend_InterestCongested; // Interests refused for lack of capacity on their link
+        size_t messageSend_InterestNotPending; // held Interests dropped because they were no longer pending
         size_t messageReceived;
         size_t messageReceive_Attempted;
         size_t messageReceive_LinkDoesNotExist;
         size_t messageReceive_NoMessage;
+        size_t messageReceive_DecodeFailed;
     } stats;
 };
 
+static void
+_slotList_Push(_AthenaSlotList *slotList, int slot)
+{
+    if (slotList->count == slotList->capacity) {
+        int capacity = slotList->capacity ? (slotList->capacity * 2) : 16;
+        int *slots = parcMemory_Reallocate(slotList->slots, sizeof(int) * capacity);
+        assertNotNull(slots, "parcMemory_Reallocate failed to resize a free slot list");
+        slotList->slots = slots;
+        slotList->capacity = capacity;
+    }
+
+    // Sift the new slot up past any larger parents
+    int index = slotList->count++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (slotList->slots[parent] <= slot) {
+            break;
+        }
+        slotList->slots[index] = slotList->slots[parent];
+        index = parent;
+    }
+    slotList->slots[index] = slot;
+}
+
+static int
+_slotList_Pop(_AthenaSlotList *slotList)
+{
+    if (slotList->count == 0) {
+        return -1;
+    }
+    int result = slotList->slots[0];
+
+    // Sift the last slot down from the root past any smaller children
+    int last = slotList->slots[--slotList->count];
+    int index = 0;
+    while (true) {
+        int child = (2 * index) + 1;
+        if (child >= slotList->count) {
+            break;
+        }
+        if (((child + 1) < slotList->count) && (slotList->slots[child + 1] < slotList->slots[child])) {
+            child++;
+        }
+        if (last <= slotList->slots[child]) {
+            break;
+        }
+        slotList->slots[index] = slotList->slots[child];
+        index = child;
+    }
+    if (slotList->count > 0) {
+        slotList->slots[index] = last;
+    }
+    return result;
+}
+
+static void
+_slotList_Release(_AthenaSlotList *slotList)
+{
+    if (slotList->slots) {
+        parcMemory_Deallocate(&slotList->slots);
+    }
+    slotList->count = 0;
+    slotList->capacity = 0;
+}
+
+static bool
+_linkNameEquals(const void *a, const void *b)
+{
+    return strcmp((const char *) a, (const char *) b) == 0;
+}
+
+static HashCodeType
+_linkNameHashCode(const void *a)
+{
+    return (HashCodeType) parcHash64_Data(a, strlen((const char *) a));
+}
+
+static void
+_linkRegistration_Destroy(void **registration)
+{
+    parcMemory_Deallocate(registration);
+}
+
+static AthenaEgressScheduler *
+_egressScheduler(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int linkId)
+{
+    if (linkId < athenaTransportLinkAdapter->egressSchedulerSize) {
+        return athenaTransportLinkAdapter->egressScheduler[linkId];
+    }
+    return NULL;
+}
+
+static void
+_egressScheduler_Attach(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int linkId)
+{
+    if (linkId >= athenaTransportLinkAdapter->egressSchedulerSize) {
+        int size = linkId + 1;
+        AthenaEgressScheduler **egressScheduler = parcMemory_Reallocate(athenaTransportLinkAdapter->egressScheduler,
+                                                                        sizeof(AthenaEgressScheduler *) * size);
+        assertNotNull(egressScheduler, "parcMemory_Reallocate failed to resize the egress scheduler list");
+        for (int index = athenaTransportLinkAdapter->egressSchedulerSize; index < size; index++) {
+            egressScheduler[index] = NULL;
+        }
+        athenaTransportLinkAdapter->egressScheduler = egressScheduler;
+        athenaTransportLinkAdapter->egressSchedulerSize = size;
+    }
+
+    AthenaEgressScheduler *scheduler = athenaEgressScheduler_Create();
+    assertNotNull(scheduler, "athenaEgressScheduler_Create failed to create a link egress scheduler");
+    for (int egressClass = 0; egressClass < AthenaEgressClass_Count; egressClass++) {
+        athenaEgressScheduler_Configure(scheduler, egressClass,
+                                        athenaTransportLinkAdapter->egressDefault[egressClass].weight,
+                                        athenaTransportLinkAdapter->egressDefault[egressClass].queueLimit);
+    }
+    athenaTransportLinkAdapter->egressScheduler[linkId] = scheduler;
+}
+
+static void
+_egressScheduler_Detach(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int linkId)
+{
+    AthenaEgressScheduler *scheduler = _egressScheduler(athenaTransportLinkAdapter, linkId);
+    if (scheduler) {
+        athenaTransportLinkAdapter->egressQueued -= athenaEgressScheduler_Depth(scheduler);
+        athenaEgressScheduler_Release(&scheduler);
+        athenaTransportLinkAdapter->egressScheduler[linkId] = NULL;
+    }
+}
+
+static AthenaInterestShaper *
+_interestShaper(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int linkId)
+{
+    if ((linkId >= 0) && (linkId < athenaTransportLinkAdapter->interestShaperSize)) {
+        return athenaTransportLinkAdapter->interestShaper[linkId];
+    }
+    return NULL;
+}
+
+static void
+_interestShaper_Attach(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int linkId)
+{
+    if (linkId >= athenaTransportLinkAdapter->interestShaperSize) {
+        int size = linkId + 1;
+        AthenaInterestShaper **interestShaper = parcMemory_Reallocate(athenaTransportLinkAdapter->interestShaper,
+                                                                      sizeof(AthenaInterestShaper *) * size);
+        assertNotNull(interestShaper, "parcMemory_Reallocate failed to resize the Interest shaper list");
+        for (int index = athenaTransportLinkAdapter->interestShaperSize; index < size; index++) {
+            interestShaper[index] = NULL;
+        }
+        athenaTransportLinkAdapter->interestShaper = interestShaper;
+        athenaTransportLinkAdapter->interestShaperSize = size;
+    }
+
+    AthenaInterestShaper *shaper = athenaInterestShaper_Create();
+    assertNotNull(shaper, "athenaInterestShaper_Create failed to create a link Interest shaper");
+    athenaInterestShaper_SetBandwidth(shaper, athenaTransportLinkAdapter->shapingDefault.bandwidth);
+    athenaInterestShaper_SetMaxDelay(shaper, athenaTransportLinkAdapter->shapingDefault.maxDelay);
+    athenaTransportLinkAdapter->interestShaper[linkId] = shaper;
+}
+
+static void
+_interestShaper_Detach(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int linkId)
+{
+    AthenaInterestShaper *shaper = _interestShaper(athenaTransportLinkAdapter, linkId);
+    if (shaper) {
+        athenaTransportLinkAdapter->interestsHeld -= athenaInterestShaper_Depth(shaper);
+        athenaInterestShaper_Release(&shaper);
+        athenaTransportLinkAdapter->interestShaper[linkId] = NULL;
+    }
+}
+
 void
 athenaTransportLinkAdapter_Destroy(AthenaTransportLinkAdapter **athenaTransportLinkAdapter)
 {
@@ -169,6 +394,22 @@ athenaTransportLinkAdapter_Destroy(AthenaTransportLinkAdapter **athenaTransportL
     parcArrayList_Destroy(&((*athenaTransportLinkAdapter)->moduleList));
     parcArrayList_Destroy(&((*athenaTransportLinkAdapter)->instanceList));
     parcArrayList_Destroy(&((*athenaTransportLinkAdapter)->listenerList));
+    parcHashCodeTable_Destroy(&((*athenaTransportLinkAdapter)->linkNameTable));
+    for (int linkId = 0; linkId < (*athenaTransportLinkAdapter)->egressSchedulerSize; linkId++) {
+        _egressScheduler_Detach(*athenaTransportLinkAdapter, linkId);
+    }
+    if ((*athenaTransportLinkAdapter)->egressScheduler) {
+        parcMemory_Deallocate(&((*athenaTransportLinkAdapter)->egressScheduler));
+    }
+    for (int linkId = 0; linkId < (*athenaTransportLinkAdapter)->interestShaperSize; linkId++) {
+        _interestShaper_Detach(*athenaTransportLinkAdapter, linkId);
+    }
+    if ((*athenaTransportLinkAdapter)->interestShaper) {
+        parcMemory_Deallocate(&((*athenaTransportLinkAdapter)->interestShaper));
+    }
+    parcClock_Release(&((*athenaTransportLinkAdapter)->clock));
+    _slotList_Release(&((*athenaTransportLinkAdapter)->freeLinkIds));
+    _slotList_Release(&((*athenaTransportLinkAdapter)->freePollfdSlots));
     if ((*athenaTransportLinkAdapter)->pollfdReceiveList) {
         parcMemory_Deallocate(&((*athenaTransportLinkAdapter)->pollfdReceiveList));
         parcMemory_Deallocate(&((*athenaTransportLinkAdapter)->pollfdSendList));
@@ -203,10 +444,19 @@ athenaTransportLinkAdapter_Create(void (*removeLinkCallback)(void *removeLinkCon
     athenaTransportLinkAdapter->moduleList = parcArrayList_Create((void (*)(void **))athenaTransportLinkModule_Destroy);
     athenaTransportLinkAdapter->instanceList = parcArrayList_Create(NULL);
     athenaTransportLinkAdapter->listenerList = parcArrayList_Create(NULL);
+    athenaTransportLinkAdapter->linkNameTable = parcHashCodeTable_Create(_linkNameEquals, _linkNameHashCode, NULL, _linkRegistration_Destroy);
     athenaTransportLinkAdapter->nextLinkToRead = 0;
     athenaTransportLinkAdapter->pollfdListSize = 0;
     athenaTransportLinkAdapter->removeLink = removeLinkCallback;
     athenaTransportLinkAdapter->removeLinkContext = removeLinkContext;
+    for (int egressClass = 0; egressClass < AthenaEgressClass_Count; egressClass++) {
+        athenaTransportLinkAdapter->egressDefault[egressClass].weight = AthenaEgressScheduler_DefaultWeight;
+        athenaTransportLinkAdapter->egressDefault[egressClass].queueLimit = AthenaEgressScheduler_DefaultQueueLimit;
+    }
+    athenaTransportLinkAdapter->egressRetryTimeout = EGRESS_RETRY_MIN_TIMEOUT;
+    athenaTransportLinkAdapter->shapingDefault.bandwidth = 0;
+    athenaTransportLinkAdapter->shapingDefault.maxDelay = AthenaInterestShaper_DefaultMaxDelay;
+    athenaTransportLinkAdapter->clock = parcClock_Monotonic();
     athenaTransportLinkAdapter->log = _parc_logger_create();
 
     return athenaTransportLinkAdapter;
@@ -228,61 +478,55 @@ _LookupModule(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, const char
     return NULL;
 }
 
-static void
+static int
 _add_to_pollfdList(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, AthenaTransportLink *newTransportLink, int eventFd)
 {
-    int index;
-
     // Check for an existing availble slot
-    for (index = 0; index < athenaTransportLinkAdapter->pollfdListSize; index++) {
-        if (athenaTransportLinkAdapter->pollfdTransportLink[index] == NULL) {
-            athenaTransportLinkAdapter->pollfdTransportLink[index] = newTransportLink;
-            athenaTransportLinkAdapter->pollfdReceiveList[index].fd = eventFd;
-            athenaTransportLinkAdapter->pollfdReceiveList[index].events = POLLIN;
-            athenaTransportLinkAdapter->pollfdSendList[index].fd = eventFd;
-            athenaTransportLinkAdapter->pollfdSendList[index].events = POLLOUT;
-            return;
-        }
-    }
-
-    // Create a new entry
-    if (index == athenaTransportLinkAdapter->pollfdListSize) {
-        struct pollfd *newReceiveList;
-        newReceiveList = parcMemory_Reallocate(athenaTransportLinkAdapter->pollfdReceiveList, sizeof(struct pollfd) * (index + 1));
-        assertNotNull(newReceiveList, "parcMemory_Reallocate failed to resize the pollfdReceiveList");
-        athenaTransportLinkAdapter->pollfdReceiveList = newReceiveList;
-
-        struct pollfd *newSendList;
-        newSendList = parcMemory_Reallocate(athenaTransportLinkAdapter->pollfdSendList, sizeof(struct pollfd) * (index + 1));
-        assertNotNull(newSendList, "parcMemory_Reallocate failed to resize the pollfdSendList");
-        athenaTransportLinkAdapter->pollfdSendList = newSendList;
-
-        AthenaTransportLink **newPollFdTransportLink = parcMemory_Reallocate(athenaTransportLinkAdapter->pollfdTransportLink,
-                                                                             sizeof(AthenaTransportLink *) * (index + 1));
-        assertNotNull(newPollFdTransportLink, "parcMemory_Reallocate failed to resize the pollfdTransportLink list");
-        athenaTransportLinkAdapter->pollfdTransportLink = newPollFdTransportLink;
-
-        athenaTransportLinkAdapter->pollfdListSize = index + 1;
+    int index = _slotList_Pop(&athenaTransportLinkAdapter->freePollfdSlots);
+    if (index != -1) {
         athenaTransportLinkAdapter->pollfdTransportLink[index] = newTransportLink;
         athenaTransportLinkAdapter->pollfdReceiveList[index].fd = eventFd;
         athenaTransportLinkAdapter->pollfdReceiveList[index].events = POLLIN;
         athenaTransportLinkAdapter->pollfdSendList[index].fd = eventFd;
         athenaTransportLinkAdapter->pollfdSendList[index].events = POLLOUT;
+        return index;
     }
+
+    // Create a new entry
+    index = athenaTransportLinkAdapter->pollfdListSize;
+    struct pollfd *newReceiveList;
+    newReceiveList = parcMemory_Reallocate(athenaTransportLinkAdapter->pollfdReceiveList, sizeof(struct pollfd) * (index + 1));
+    assertNotNull(newReceiveList, "parcMemory_Reallocate failed to resize the pollfdReceiveList");
+    athenaTransportLinkAdapter->pollfdReceiveList = newReceiveList;
+
+    struct pollfd *newSendList;
+    newSendList = parcMemory_Reallocate(athenaTransportLinkAdapter->pollfdSendList, sizeof(struct pollfd) * (index + 1));
+    assertNotNull(newSendList, "parcMemory_Reallocate failed to resize the pollfdSendList");
+    athenaTransportLinkAdapter->pollfdSendList = newSendList;
+
+    AthenaTransportLink **newPollFdTransportLink = parcMemory_Reallocate(athenaTransportLinkAdapter->pollfdTransportLink,
+                                                                         sizeof(AthenaTransportLink *) * (index + 1));
+    assertNotNull(newPollFdTransportLink, "parcMemory_Reallocate failed to resize the pollfdTransportLink list");
+    athenaTransportLinkAdapter->pollfdTransportLink = newPollFdTransportLink;
+
+    athenaTransportLinkAdapter->pollfdListSize = index + 1;
+    athenaTransportLinkAdapter->pollfdTransportLink[index] = newTransportLink;
+    athenaTransportLinkAdapter->pollfdReceiveList[index].fd = eventFd;
+    athenaTransportLinkAdapter->pollfdReceiveList[index].events = POLLIN;
+    athenaTransportLinkAdapter->pollfdSendList[index].fd = eventFd;
+    athenaTransportLinkAdapter->pollfdSendList[index].events = POLLOUT;
+    return index;
 }
 
 static void
-_remove_from_pollfdList(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, AthenaTransportLink *athenaTransportLink)
+_remove_from_pollfdList(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int index)
 {
-    for (int index = 0; index < athenaTransportLinkAdapter->pollfdListSize; index++) {
-        if (athenaTransportLinkAdapter->pollfdTransportLink[index] == athenaTransportLink) {
-            athenaTransportLinkAdapter->pollfdTransportLink[index] = NULL; // disable link callback
-            athenaTransportLinkAdapter->pollfdReceiveList[index].fd = -1; // disable polling
-            athenaTransportLinkAdapter->pollfdReceiveList[index].events = 0;
-            athenaTransportLinkAdapter->pollfdSendList[index].fd = -1; // disable polling
-            athenaTransportLinkAdapter->pollfdSendList[index].events = 0;
-        }
-    }
+    athenaTransportLinkAdapter->pollfdTransportLink[index] = NULL; // disable link callback
+    athenaTransportLinkAdapter->pollfdReceiveList[index].fd = -1; // disable polling
+    athenaTransportLinkAdapter->pollfdReceiveList[index].events = 0;
+    athenaTransportLinkAdapter->pollfdSendList[index].fd = -1; // disable polling
+    athenaTransportLinkAdapter->pollfdSendList[index].events = 0;
+    _slotList_Push(&athenaTransportLinkAdapter->freePollfdSlots, index);
 }
 
 /**
@@ -298,7 +542,8 @@ _remove_from_pollfdList(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
  *
  * New routable links are placed into instanceList slots that have previously been vacated before being added
  * to the end of the instanceList.  This is in order to keep bit vectors that are based on the instanceList as
- * small as is necessary.
+ * small as is necessary.  Name collisions are found through the link name table and vacated slots are kept
+ * on a free list, so adding a link does not scan the existing links.
  *
  * @param [in] athenaTransportLinkAdapter link adapter instance
  * @param [in] linkInstance instance structure created by the link specific module
@@ -313,56 +558,47 @@ _remove_from_pollfdList(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
 static int
 _athenaTransportLinkAdapter_AddLink(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, AthenaTransportLink *newTransportLink)
 {
-    int linkId = -1;
+    const char *linkName = athenaTransportLink_GetName(newTransportLink);
 
-    // Check for existing linkName in listenerList
-    if (athenaTransportLinkAdapter->listenerList) {
-        for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->listenerList); index++) {
-            AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->listenerList, index);
-            if (strcmp(athenaTransportLink_GetName(athenaTransportLink), athenaTransportLink_GetName(newTransportLink)) == 0) {
-                errno = EADDRINUSE; // name is already in listenerList
-                return -1;
-            }
-        }
+    // Check for existing linkName among all registered links
+    if (parcHashCodeTable_Get(athenaTransportLinkAdapter->linkNameTable, linkName)) {
+        errno = EADDRINUSE; // name is already registered
+        return -1;
     }
 
-    // Check for existing linkName in the instanceList
-    if (athenaTransportLinkAdapter->instanceList) {
-        for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->instanceList); index++) {
-            AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, index);
-            if (athenaTransportLink) {
-                if (strcmp(athenaTransportLink_GetName(athenaTransportLink), athenaTransportLink_GetName(newTransportLink)) == 0) {
-                    errno = EADDRINUSE; // name is already in instanceList
-                    return -1;
-                }
-            } else {
-                // remember the first available index found along the way
-                if (linkId == -1) {
-                    linkId = index;
-                }
-            }
-        }
-    }
+    _AthenaLinkRegistration *registration = parcMemory_AllocateAndClear(sizeof(_AthenaLinkRegistration));
+    assertNotNull(registration, "parcMemory_AllocateAndClear failed to create a new link registration");
+    registration->athenaTransportLink = newTransportLink;
+    registration->linkId = -1;
+    registration->pollfdIndex = -1;
 
     // Add to listenerList or instanceList
     athenaTransportLink_Acquire(newTransportLink);
     if (athenaTransportLink_IsNotRoutable(newTransportLink)) { // listener
         bool result = parcArrayList_Add(athenaTransportLinkAdapter->listenerList, newTransportLink);
         assertTrue(result, "parcArrayList_Add failed to add new listener");
-    } else { // routable link, add to instances using the last available id if one was seen
+    } else { // routable link, add to instances using a vacated id if one is available
+        int linkId = _slotList_Pop(&athenaTransportLinkAdapter->freeLinkIds);
         if (linkId != -1) {
             parcArrayList_Set(athenaTransportLinkAdapter->instanceList, linkId, newTransportLink);
         } else {
+            linkId = (int) parcArrayList_Size(athenaTransportLinkAdapter->instanceList);
             bool result = parcArrayList_Add(athenaTransportLinkAdapter->instanceList, newTransportLink);
             assertTrue(result, "parcArrayList_Add failed to add new link instance");
         }
+        registration->linkId = linkId;
+        _egressScheduler_Attach(athenaTransportLinkAdapter, linkId);
+        _interestShaper_Attach(athenaTransportLinkAdapter, linkId);
     }
 
     // If any transport link has a registered file descriptor add it to the general polling list.
     int eventFd = athenaTransportLink_GetEventFd(newTransportLink);
     if (eventFd != -1) {
-        _add_to_pollfdList(athenaTransportLinkAdapter, newTransportLink, eventFd);
+        registration->pollfdIndex = _add_to_pollfdList(athenaTransportLinkAdapter, newTransportLink, eventFd);
     }
+
+    bool result = parcHashCodeTable_Add(athenaTransportLinkAdapter->linkNameTable, (void *) linkName, registration);
+    assertTrue(result, "parcHashCodeTable_Add failed to register new link");
     return 0;
 }
 
@@ -388,40 +624,38 @@ _athenaTransportLinkAdapter_AddLink(AthenaTransportLinkAdapter *athenaTransportL
 static void
 _athenaTransportLinkAdapter_RemoveLink(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, AthenaTransportLink *athenaTransportLink)
 {
-    int linkId = -1;
+    const char *linkName = athenaTransportLink_GetName(athenaTransportLink);
+    _AthenaLinkRegistration *registration = parcHashCodeTable_Get(athenaTransportLinkAdapter->linkNameTable, linkName);
 
-    // if this is a listener it can simply be removed
-    if (athenaTransportLink_IsNotRoutable(athenaTransportLink)) {
-        if (athenaTransportLinkAdapter->listenerList) {
-            for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->listenerList); index++) {
-                AthenaTransportLink *transportLink = parcArrayList_Get(athenaTransportLinkAdapter->listenerList, index);
-                if (athenaTransportLink == transportLink) {
-                    parcArrayList_RemoveAtIndex(athenaTransportLinkAdapter->listenerList, index);
-                    _remove_from_pollfdList(athenaTransportLinkAdapter, athenaTransportLink);
-                    parcLog_Debug(athenaTransportLinkAdapter_GetLogger(athenaTransportLinkAdapter), "listener removed: %s",
-                                  athenaTransportLink_GetName(athenaTransportLink));
-                    athenaTransportLink_Release(&athenaTransportLink);
-                    return;
-                }
-            }
-        }
+    assertTrue(registration && (registration->athenaTransportLink == athenaTransportLink),
+               "Attempt to remove link not found in link adapter lists");
+
+    int linkId = registration->linkId;
+    if (registration->pollfdIndex != -1) {
+        _remove_from_pollfdList(athenaTransportLinkAdapter, registration->pollfdIndex);
     }
+    parcHashCodeTable_Del(athenaTransportLinkAdapter->linkNameTable, linkName);
 
-    // Remove from our internal instance list.
-    // The index entry remains to be reused by links that are added in the future.
-    if (athenaTransportLinkAdapter->instanceList) {
-        for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->instanceList); index++) {
-            AthenaTransportLink *transportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, index);
+    // if this is a listener it can simply be removed
+    if (linkId == -1) {
+        for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->listenerList); index++) {
+            AthenaTransportLink *transportLink = parcArrayList_Get(athenaTransportLinkAdapter->listenerList, index);
             if (athenaTransportLink == transportLink) {
-                parcArrayList_Set(athenaTransportLinkAdapter->instanceList, index, NULL);
-                _remove_from_pollfdList(athenaTransportLinkAdapter, athenaTransportLink);
-                linkId = index;
+                parcArrayList_RemoveAtIndex(athenaTransportLinkAdapter->listenerList, index);
                 break;
             }
         }
+        parcLog_Debug(athenaTransportLinkAdapter_GetLogger(athenaTransportLinkAdapter), "listener removed: %s",
+                      athenaTransportLink_GetName(athenaTransportLink));
+        athenaTransportLink_Release(&athenaTransportLink);
+        return;
     }
 
-    assertFalse(linkId == -1, "Attempt to remove link not found in link adapter lists");
+    // Remove from our internal instance list, dropping anything still queued for it.
+    // The index entry remains to be reused by links that are added in the future.
+    parcArrayList_Set(athenaTransportLinkAdapter->instanceList, linkId, NULL);
+    _egressScheduler_Detach(athenaTransportLinkAdapter, linkId);
+    _interestShaper_Detach(athenaTransportLinkAdapter, linkId);
 
     // Callback to notify that the link has been removed and references need to be dropped.
     PARCBitVector *linkVector = parcBitVector_Create();
@@ -431,6 +665,7 @@ _athenaTransportLinkAdapter_RemoveLink(AthenaTransportLinkAdapter *athenaTranspo
 
     // we assume all references to the linkId associated with this instance have been
     // cleared from the PIT and FIB when removeLink returns.
+    _slotList_Push(&athenaTransportLinkAdapter->freeLinkIds, linkId);
 
     parcLog_Debug(athenaTransportLinkAdapter_GetLogger(athenaTransportLinkAdapter),
                   "link removed: %s", athenaTransportLink_GetName(athenaTransportLink));
@@ -653,6 +888,207 @@ athenaTransportLinkAdapter_Open(AthenaTransportLinkAdapter *athenaTransportLinkA
     return athenaTransportLink_GetName(athenaTransportLink);
 }
 
+//
+// A send refused for lack of socket or ring space can be retried once the link is writable again
+//
+static bool
+_sendWouldBlock(int error)
+{
+    return (error == EAGAIN) || (error == EWOULDBLOCK) || (error == ENOBUFS) || (error == EINTR);
+}
+
+typedef struct _AthenaEgressContext {
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter;
+    AthenaTransportLink *athenaTransportLink;
+} _AthenaEgressContext;
+
+static AthenaEgressScheduler_SendResult
+_egressSend(AthenaEgressScheduler_SendMethodContext context, CCNxMetaMessage *ccnxMetaMessage)
+{
+    _AthenaEgressContext *egressContext = (_AthenaEgressContext *) context;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = egressContext->athenaTransportLinkAdapter;
+
+    if (!(athenaTransportLink_GetEvent(egressContext->athenaTransportLink) & AthenaTransportLinkEvent_Send)) {
+        return AthenaEgressScheduler_Blocked;
+    }
+    if (athenaTransportLink_Send(egressContext->athenaTransportLink, ccnxMetaMessage) == 0) {
+        athenaTransportLinkAdapter->stats.messageSent++;
+        return AthenaEgressScheduler_Sent;
+    }
+    if (_sendWouldBlock(errno)) {
+        return AthenaEgressScheduler_Blocked;
+    }
+    athenaTransportLinkAdapter->stats.messageSend_LinkSendFailed++;
+    return AthenaEgressScheduler_Failed;
+}
+
+static void
+_egressService(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, AthenaTransportLink *athenaTransportLink,
+               AthenaEgressScheduler *scheduler)
+{
+    _AthenaEgressContext context = {
+        .athenaTransportLinkAdapter = athenaTransportLinkAdapter,
+        .athenaTransportLink = athenaTransportLink,
+    };
+    size_t depth = athenaEgressScheduler_Depth(scheduler);
+    athenaEgressScheduler_Service(scheduler, _egressSend, &context);
+    if (athenaEgressScheduler_Depth(scheduler) < depth) {
+        athenaTransportLinkAdapter->egressQueued -= depth - athenaEgressScheduler_Depth(scheduler);
+        athenaTransportLinkAdapter->egressRetryTimeout = EGRESS_RETRY_MIN_TIMEOUT;
+    }
+}
+
+static bool
+_egressEnqueue(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, AthenaEgressScheduler *scheduler,
+               CCNxMetaMessage *ccnxMetaMessage)
+{
+    // A queued message is sent after the caller has moved on, it needs an encoding of its own
+    athenaTransportLinkModule_PrepareMessageBuffer(ccnxMetaMessage);
+    size_t length = parcBuffer_Limit(ccnxWireFormatMessage_GetWireFormatBuffer(ccnxMetaMessage));
+
+    if (athenaEgressScheduler_Enqueue(scheduler, athenaEgressScheduler_Classify(ccnxMetaMessage), ccnxMetaMessage, length)) {
+        athenaTransportLinkAdapter->stats.messageSend_Queued++;
+        athenaTransportLinkAdapter->egressQueued++;
+        return true;
+    }
+    athenaTransportLinkAdapter->stats.messageSend_QueueFull++;
+    return false;
+}
+
+//
+// Drain the egress queues of links that have become writable
+//
+static void
+_athenaTransportLinkAdapter_ServiceEgress(AthenaTransportLinkAdapter *athenaTransportLinkAdapter)
+{
+    if (athenaTransportLinkAdapter->egressQueued == 0) {
+        return;
+    }
+    int retryTimeout = athenaTransportLinkAdapter->egressRetryTimeout;
+    for (int linkId = 0; linkId < athenaTransportLinkAdapter->egressSchedulerSize; linkId++) {
+        AthenaEgressScheduler *scheduler = athenaTransportLinkAdapter->egressScheduler[linkId];
+        if (scheduler && athenaEgressScheduler_Depth(scheduler)) {
+            AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, linkId);
+            if (athenaTransportLink && (athenaTransportLink_GetEvent(athenaTransportLink) & AthenaTransportLinkEvent_Send)) {
+                _egressService(athenaTransportLinkAdapter, athenaTransportLink, scheduler);
+            }
+        }
+    }
+
+    // Back off the retries while nothing queued gets sent, they start over once something does
+    if (athenaTransportLinkAdapter->egressQueued && (athenaTransportLinkAdapter->egressRetryTimeout == retryTimeout)) {
+        athenaTransportLinkAdapter->egressRetryTimeout = retryTimeout * 2;
+        if (athenaTransportLinkAdapter->egressRetryTimeout > EGRESS_RETRY_MAX_TIMEOUT) {
+            athenaTransportLinkAdapter->egressRetryTimeout = EGRESS_RETRY_MAX_TIMEOUT;
+        }
+    }
+}
+
+//
+// While messages are queued, have the poll wake when their links can send again.  Links whose event
+// fd is the descriptor they send on are watched for POLLOUT.  Any other link's event fd only signals
+// receives (shared memory and io_uring links use an eventfd, UDP listeners with receive workers a
+// pipe), so the poll's wait is bounded to retry them, backing off while they stay blocked.
+// Returns the timeout to poll with.
+//
+static int
+_athenaTransportLinkAdapter_WatchEgress(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int timeout)
+{
+    struct pollfd *pollfdReceiveList = athenaTransportLinkAdapter->pollfdReceiveList;
+    for (int index = 0; index < athenaTransportLinkAdapter->pollfdListSize; index++) {
+        pollfdReceiveList[index].events &= ~POLLOUT;
+    }
+    if (athenaTransportLinkAdapter->egressQueued == 0) {
+        athenaTransportLinkAdapter->egressRetryTimeout = EGRESS_RETRY_MIN_TIMEOUT;
+        return timeout;
+    }
+
+    bool retry = false;
+    for (int linkId = 0; linkId < athenaTransportLinkAdapter->egressSchedulerSize; linkId++) {
+        AthenaEgressScheduler *scheduler = athenaTransportLinkAdapter->egressScheduler[linkId];
+        if ((scheduler == NULL) || (athenaEgressScheduler_Depth(scheduler) == 0)) {
+            continue;
+        }
+        AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, linkId);
+        if (athenaTransportLink == NULL) {
+            continue;
+        }
+        _AthenaLinkRegistration *registration =
+            parcHashCodeTable_Get(athenaTransportLinkAdapter->linkNameTable, athenaTransportLink_GetName(athenaTransportLink));
+        if (athenaTransportLink_IsSendPollable(athenaTransportLink) && registration && (registration->pollfdIndex != -1)) {
+            pollfdReceiveList[registration->pollfdIndex].events |= POLLOUT;
+        } else {
+            retry = true;
+        }
+    }
+
+    if (retry && ((timeout < 0) || (timeout > athenaTransportLinkAdapter->egressRetryTimeout))) {
+        timeout = athenaTransportLinkAdapter->egressRetryTimeout;
+    }
+    return timeout;
+}
+
+//
+// Bound the poll's wait by when the shapers can next send an Interest they're holding.
+// Returns the timeout to poll with.
+//
+static int
+_athenaTransportLinkAdapter_WatchShapers(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int timeout)
+{
+    if (athenaTransportLinkAdapter->interestsHeld == 0) {
+        return timeout;
+    }
+    uint64_t now = parcClock_GetTime(athenaTransportLinkAdapter->clock);
+    for (int linkId = 0; linkId < athenaTransportLinkAdapter->interestShaperSize; linkId++) {
+        AthenaInterestShaper *shaper = athenaTransportLinkAdapter->interestShaper[linkId];
+        if (shaper) {
+            int64_t wait = athenaInterestShaper_TimeUntilNext(shaper, now);
+            if ((wait >= 0) && ((timeout < 0) || (wait < timeout))) {
+                timeout = (int) wait;
+            }
+        }
+    }
+    return timeout;
+}
+
+//
+// Send the Interests held by the shapers of links that now have capacity for them
+//
+static void
+_athenaTransportLinkAdapter_ReleaseShaped(AthenaTransportLinkAdapter *athenaTransportLinkAdapter)
+{
+    if (athenaTransportLinkAdapter->interestsHeld == 0) {
+        return;
+    }
+    uint64_t now = parcClock_GetTime(athenaTransportLinkAdapter->clock);
+    for (int linkId = 0; linkId < athenaTransportLinkAdapter->interestShaperSize; linkId++) {
+        AthenaInterestShaper *shaper = athenaTransportLinkAdapter->interestShaper[linkId];
+        if ((shaper == NULL) || (athenaInterestShaper_Depth(shaper) == 0)) {
+            continue;
+        }
+        PARCBitVector *linkVector = parcBitVector_Create();
+        parcBitVector_Set(linkVector, linkId);
+        CCNxMetaMessage *interest;
+        while ((interest = athenaInterestShaper_Next(shaper, now)) != NULL) {
+            athenaTransportLinkAdapter->interestsHeld--;
+            // Interests satisfied, expired or removed while they were held have no one waiting on them
+            if (athenaTransportLinkAdapter->releaseInterest &&
+                (athenaTransportLinkAdapter->releaseInterest(athenaTransportLinkAdapter->releaseInterestContext,
+                                                             interest, linkVector) == false)) {
+                athenaTransportLinkAdapter->stats.messageSend_InterestNotPending++;
+                ccnxMetaMessage_Release(&interest);
+                continue;
+            }
+            PARCBitVector *failedVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, interest, linkVector);
+            if (failedVector) { // the PIT entry expires as it would for a lost Interest
+                parcBitVector_Release(&failedVector);
+            }
+            ccnxMetaMessage_Release(&interest);
+        }
+        parcBitVector_Release(&linkVector);
+    }
+}
+
 int
 athenaTransportLinkAdapter_Poll(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int timeout)
 {
@@ -662,6 +1098,8 @@ athenaTransportLinkAdapter_Poll(AthenaTransportLinkAdapter *athenaTransportLinkA
     AthenaTransportLinkModule *athenaTransportLinkModule;
     int events = 0;
 
+    timeout = _athenaTransportLinkAdapter_WatchShapers(athenaTransportLinkAdapter, timeout);
+
     // Allow instances which have not registered an eventfd to mark their events
     if (athenaTransportLinkAdapter->moduleList) {
         for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->moduleList); index++) {
@@ -673,6 +1111,7 @@ athenaTransportLinkAdapter_Poll(AthenaTransportLinkAdapter *athenaTransportLinkA
     if (events) { // if we have existing events, poll doesn't need to block
         timeout = 0;
     }
+    timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, timeout);
 
     int result = poll(pollfdReceiveList, pollfdListSize, timeout);
     if (result < 0) {
@@ -692,6 +1131,9 @@ athenaTransportLinkAdapter_Poll(AthenaTransportLinkAdapter *athenaTransportLinkA
                     } else {
                         athenaTransportLink_ClearEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
                     }
+                    if (pollfdReceiveList[index].revents & POLLOUT) {
+                        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+                    }
                 }
             }
         }
@@ -724,34 +1166,22 @@ athenaTransportLinkAdapter_Poll(AthenaTransportLinkAdapter *athenaTransportLinkA
         }
         //events += result; // don't register send events
     }
+
+    _athenaTransportLinkAdapter_ReleaseShaped(athenaTransportLinkAdapter);
+    _athenaTransportLinkAdapter_ServiceEgress(athenaTransportLinkAdapter);
     return events;
 }
 
 int
 athenaTransportLinkAdapter_CloseByName(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, const char *linkName)
 {
-    if (athenaTransportLinkAdapter->listenerList) {
-        for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->listenerList); index++) {
-            AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->listenerList, index);
-            if (strcmp(athenaTransportLink_GetName(athenaTransportLink), linkName) == 0) {
-                athenaTransportLink_Close(athenaTransportLink);
-                return 0;
-            }
-        }
-    }
-    if (athenaTransportLinkAdapter->instanceList) {
-        for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->instanceList); index++) {
-            AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, index);
-            if (athenaTransportLink) {
-                if (strcmp(athenaTransportLink_GetName(athenaTransportLink), linkName) == 0) {
-                    athenaTransportLink_Close(athenaTransportLink);
-                    return 0;
-                }
-            }
-        }
+    _AthenaLinkRegistration *registration = parcHashCodeTable_Get(athenaTransportLinkAdapter->linkNameTable, linkName);
+    if (registration == NULL) {
+        errno = ENOENT;
+        return -1;
     }
-    errno = ENOENT;
-    return -1;
+    athenaTransportLink_Close(registration->athenaTransportLink);
+    return 0;
 }
 
 PARCBitVector *
@@ -810,9 +1240,32 @@ _retrieve_next_message(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, P
     return NULL;
 }
 
+//
+// Content Objects received on a link tell its shaper the size of the responses its Interests draw
+//
+void
+athenaTransportLinkAdapter_ContentObjectReceived(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                                 const PARCBitVector *ingressVector,
+                                                 size_t packetLength)
+{
+    AthenaInterestShaper *shaper = _interestShaper(athenaTransportLinkAdapter, parcBitVector_NextBitSet(ingressVector, 0));
+    if (shaper && athenaInterestShaper_GetBandwidth(shaper)) {
+        athenaInterestShaper_ContentObjectReceived(shaper, packetLength);
+    }
+}
+
+void
+athenaTransportLinkAdapter_SetReleaseInterestCallback(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                                      AthenaTransportLinkAdapter_ReleaseInterestCallback *releaseInterest,
+                                                      AthenaTransportLinkAdapter_ReleaseInterestCallbackContext releaseInterestContext)
+{
+    athenaTransportLinkAdapter->releaseInterest = releaseInterest;
+    athenaTransportLinkAdapter->releaseInterestContext = releaseInterestContext;
+}
+
 CCNxMetaMessage *
-athenaTransportLinkAdapter_Receive(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
-                                   PARCBitVector **resultVector, int timeout)
+athenaTransportLinkAdapter_ReceiveWireFormat(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                             PARCBitVector **resultVector, int timeout)
 {
     int linkId;
     *resultVector = parcBitVector_Create();
@@ -854,6 +1307,25 @@ athenaTransportLinkAdapter_Receive(AthenaTransportLinkAdapter *athenaTransportLi
     return NULL;
 }
 
+CCNxMetaMessage *
+athenaTransportLinkAdapter_Receive(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                   PARCBitVector **resultVector, int timeout)
+{
+    CCNxMetaMessage *ccnxMetaMessage = athenaTransportLinkAdapter_ReceiveWireFormat(athenaTransportLinkAdapter, resultVector, timeout);
+    if (ccnxMetaMessage && (athenaTransportLinkModule_DecodeMessage(ccnxMetaMessage) == false)) {
+        athenaTransportLinkAdapter->stats.messageReceive_DecodeFailed++;
+        parcLog_Error(athenaTransportLinkAdapter->log, "Failed to decode message received from %s.",
+                      athenaTransportLinkAdapter_LinkIdToName(athenaTransportLinkAdapter, parcBitVector_NextBitSet(*resultVector, 0)));
+        ccnxMetaMessage_Release(&ccnxMetaMessage);
+        parcBitVector_Release(resultVector);
+        errno = EBADMSG;
+    } else if (ccnxMetaMessage && ccnxMetaMessage_IsContentObject(ccnxMetaMessage)) {
+        PARCBuffer *wireFormatBuffer = ccnxWireFormatMessage_GetWireFormatBuffer(ccnxMetaMessage);
+        athenaTransportLinkAdapter_ContentObjectReceived(athenaTransportLinkAdapter, *resultVector, parcBuffer_Limit(wireFormatBuffer));
+    }
+    return ccnxMetaMessage;
+}
+
 PARCBitVector *
 athenaTransportLinkAdapter_Send(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
                                 CCNxMetaMessage *ccnxMetaMessage,
@@ -867,6 +1339,12 @@ athenaTransportLinkAdapter_Send(AthenaTransportLinkAdapter *athenaTransportLinkA
 
     PARCBitVector *resultVector = parcBitVector_Create();
 
+    // Encode the message once for all of the links it's going out on, each send references the same buffer
+    bool sharedWireFormat = (parcBitVector_NumberOfBitsSet(linkOutputVector) > 1);
+    if (sharedWireFormat && athenaTransportLinkModule_PrepareMessageBuffer(ccnxMetaMessage)) {
+        athenaTransportLinkAdapter->stats.messageSend_WireFormatPrepared++;
+    }
+
     while ((nextLinkToWrite = parcBitVector_NextBitSet(linkOutputVector, nextLinkToWrite)) >= 0) {
         athenaTransportLinkAdapter->stats.messageSend_Attempted++;
         if (nextLinkToWrite >= parcArrayList_Size(athenaTransportLinkAdapter->instanceList)) {
@@ -882,12 +1360,6 @@ athenaTransportLinkAdapter_Send(AthenaTransportLinkAdapter *athenaTransportLinkA
             nextLinkToWrite++;
             continue;
         }
-        if (!(athenaTransportLink_GetEvent(athenaTransportLink) & AthenaTransportLinkEvent_Send)) {
-            athenaTransportLinkAdapter->stats.messageSend_LinkNotAcceptingSendRequests++;
-            parcBitVector_Set(resultVector, nextLinkToWrite);
-            nextLinkToWrite++;
-            continue;
-        }
         // If we're sending an interest to a non-local link,
         // check that it has a sufficient hoplimit.
         if (ccnxMetaMessage_IsInterest(ccnxMetaMessage)) {
@@ -899,13 +1371,41 @@ athenaTransportLinkAdapter_Send(AthenaTransportLinkAdapter *athenaTransportLinkA
                 }
             }
         }
-        int result = athenaTransportLink_Send(athenaTransportLink, ccnxMetaMessage);
-        if (result == 0) {
-            athenaTransportLinkAdapter->stats.messageSent++;
-        } else {
+
+        bool acceptingSends = (athenaTransportLink_GetEvent(athenaTransportLink) & AthenaTransportLinkEvent_Send) != 0;
+        if (!acceptingSends) {
+            athenaTransportLinkAdapter->stats.messageSend_LinkNotAcceptingSendRequests++;
+        }
+
+        // Messages already queued on the link go first, the message is only sent directly if they've all gone
+        AthenaEgressScheduler *scheduler = _egressScheduler(athenaTransportLinkAdapter, nextLinkToWrite);
+        if (scheduler && acceptingSends && athenaEgressScheduler_Depth(scheduler)) {
+            _egressService(athenaTransportLinkAdapter, athenaTransportLink, scheduler);
+        }
+
+        bool sendNow = acceptingSends && ((scheduler == NULL) || (athenaEgressScheduler_Depth(scheduler) == 0));
+        if (sendNow) {
+            int result = athenaTransportLink_Send(athenaTransportLink, ccnxMetaMessage);
+            if (sharedWireFormat) {
+                athenaTransportLinkAdapter->stats.messageSend_WireFormatShared++;
+            }
+            if (result == 0) {
+                athenaTransportLinkAdapter->stats.messageSent++;
+                nextLinkToWrite++;
+                continue;
+            }
+        }
+
+        // Queue the message if the link is busy or ran out of buffer space for it
+        if (scheduler && (!sendNow || _sendWouldBlock(errno))) {
+            if (_egressEnqueue(athenaTransportLinkAdapter, scheduler, ccnxMetaMessage)) {
+                nextLinkToWrite++;
+                continue;
+            }
+        } else if (sendNow) {
             athenaTransportLinkAdapter->stats.messageSend_LinkSendFailed++;
-            parcBitVector_Set(resultVector, nextLinkToWrite);
         }
+        parcBitVector_Set(resultVector, nextLinkToWrite);
         nextLinkToWrite++;
     }
 
@@ -917,6 +1417,15 @@ athenaTransportLinkAdapter_Send(AthenaTransportLinkAdapter *athenaTransportLinkA
     return resultVector;
 }
 
+int
+athenaTransportLinkAdapter_LinkIdLimit(AthenaTransportLinkAdapter *athenaTransportLinkAdapter)
+{
+    if (athenaTransportLinkAdapter->instanceList == NULL) {
+        return 0;
+    }
+    return (int) parcArrayList_Size(athenaTransportLinkAdapter->instanceList);
+}
+
 const char *
 athenaTransportLinkAdapter_LinkIdToName(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, int linkId)
 {
@@ -935,18 +1444,11 @@ athenaTransportLinkAdapter_LinkIdToName(AthenaTransportLinkAdapter *athenaTransp
 int
 athenaTransportLinkAdapter_LinkNameToId(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, const char *linkName)
 {
-    if (athenaTransportLinkAdapter->instanceList == NULL) {
+    _AthenaLinkRegistration *registration = parcHashCodeTable_Get(athenaTransportLinkAdapter->linkNameTable, linkName);
+    if (registration == NULL) {
         return -1;
     }
-    for (int index = 0; index < parcArrayList_Size(athenaTransportLinkAdapter->instanceList); index++) {
-        AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, index);
-        if (athenaTransportLink) {
-            if (strcmp(athenaTransportLink_GetName(athenaTransportLink), linkName) == 0) {
-                return index;
-            }
-        }
-    }
-    return -1;
+    return registration->linkId;
 }
 
 bool
@@ -964,6 +1466,122 @@ athenaTransportLinkAdapter_IsNotLocal(AthenaTransportLinkAdapter *athenaTranspor
     return false;
 }
 
+int
+athenaTransportLinkAdapter_SetEgressClass(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                          const char *linkName,
+                                          AthenaEgressClass egressClass,
+                                          size_t weight,
+                                          size_t queueLimit)
+{
+    assertTrue(egressClass < AthenaEgressClass_Count, "Invalid egress class %d", egressClass);
+
+    if (linkName == NULL) {
+        athenaTransportLinkAdapter->egressDefault[egressClass].weight = weight ? weight : 1;
+        athenaTransportLinkAdapter->egressDefault[egressClass].queueLimit = queueLimit;
+        return 0;
+    }
+
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, linkName);
+    AthenaEgressScheduler *scheduler = (linkId == -1) ? NULL : _egressScheduler(athenaTransportLinkAdapter, linkId);
+    if (scheduler == NULL) {
+        errno = ENOENT;
+        return -1;
+    }
+    athenaEgressScheduler_Configure(scheduler, egressClass, weight, queueLimit);
+    return 0;
+}
+
+int
+athenaTransportLinkAdapter_SetInterestShaping(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                              const char *linkName,
+                                              uint64_t bandwidth,
+                                              uint64_t maxDelay)
+{
+    if (linkName == NULL) {
+        athenaTransportLinkAdapter->shapingDefault.bandwidth = bandwidth;
+        athenaTransportLinkAdapter->shapingDefault.maxDelay = maxDelay;
+        return 0;
+    }
+
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, linkName);
+    AthenaInterestShaper *shaper = (linkId == -1) ? NULL : _interestShaper(athenaTransportLinkAdapter, linkId);
+    if (shaper == NULL) {
+        errno = ENOENT;
+        return -1;
+    }
+    athenaInterestShaper_SetBandwidth(shaper, bandwidth);
+    athenaInterestShaper_SetMaxDelay(shaper, maxDelay);
+    return 0;
+}
+
+PARCBitVector *
+athenaTransportLinkAdapter_ShapeInterest(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                         CCNxMetaMessage *interest,
+                                         PARCBitVector *egressVector)
+{
+    PARCBitVector *congestedVector = NULL;
+
+    int linkId = 0;
+    while ((linkId = parcBitVector_NextBitSet(egressVector, linkId)) >= 0) {
+        AthenaInterestShaper *shaper = _interestShaper(athenaTransportLinkAdapter, linkId);
+        if (shaper && athenaInterestShaper_GetBandwidth(shaper)) {
+            uint64_t now = parcClock_GetTime(athenaTransportLinkAdapter->clock);
+            switch (athenaInterestShaper_Admit(shaper, interest, now)) {
+                case AthenaInterestShaper_Forward:
+                    break;
+                case AthenaInterestShaper_Held:
+                    // A held Interest is sent after the caller has moved on, it needs an encoding of its own
+                    athenaTransportLinkModule_PrepareMessageBuffer(interest);
+                    athenaTransportLinkAdapter->stats.messageSend_InterestShaped++;
+                    athenaTransportLinkAdapter->interestsHeld++;
+                    parcBitVector_Clear(egressVector, linkId);
+                    break;
+                case AthenaInterestShaper_Congested:
+                    athenaTransportLinkAdapter->stats.messageSend_InterestCongested++;
+                    if (congestedVector == NULL) {
+                        congestedVector = parcBitVector_Create();
+                    }
+                    parcBitVector_Set(congestedVector, linkId);
+                    parcBitVector_Clear(egressVector, linkId);
+                    break;
+            }
+        }
+        linkId++;
+    }
+    return congestedVector;
+}
+
+static PARCJSON *
+_create_shaper_json(AthenaInterestShaper *shaper)
+{
+    PARCJSON *jsonShaper = parcJSON_Create();
+    parcJSON_AddInteger(jsonShaper, "bandwidth", athenaInterestShaper_GetBandwidth(shaper));
+    parcJSON_AddInteger(jsonShaper, "maxDelay", athenaInterestShaper_GetMaxDelay(shaper));
+    parcJSON_AddInteger(jsonShaper, "objectSize", athenaInterestShaper_GetObjectSize(shaper));
+    parcJSON_AddInteger(jsonShaper, "depth", athenaInterestShaper_Depth(shaper));
+    parcJSON_AddInteger(jsonShaper, "forwarded", athenaInterestShaper_GetForwardedCount(shaper));
+    parcJSON_AddInteger(jsonShaper, "held", athenaInterestShaper_GetHeldCount(shaper));
+    parcJSON_AddInteger(jsonShaper, "congested", athenaInterestShaper_GetCongestedCount(shaper));
+    return jsonShaper;
+}
+
+static PARCJSON *
+_create_egress_json(AthenaEgressScheduler *scheduler)
+{
+    PARCJSON *jsonEgress = parcJSON_Create();
+    for (int egressClass = 0; egressClass < AthenaEgressClass_Count; egressClass++) {
+        PARCJSON *jsonClass = parcJSON_Create();
+        parcJSON_AddInteger(jsonClass, "weight", athenaEgressScheduler_GetWeight(scheduler, egressClass));
+        parcJSON_AddInteger(jsonClass, "queueLimit", athenaEgressScheduler_GetQueueLimit(scheduler, egressClass));
+        parcJSON_AddInteger(jsonClass, "queueDepth", athenaEgressScheduler_GetQueueDepth(scheduler, egressClass));
+        parcJSON_AddInteger(jsonClass, "sent", athenaEgressScheduler_GetSentCount(scheduler, egressClass));
+        parcJSON_AddInteger(jsonClass, "dropped", athenaEgressScheduler_GetDropCount(scheduler, egressClass));
+        parcJSON_AddObject(jsonEgress, athenaEgressScheduler_ClassName(egressClass), jsonClass);
+        parcJSON_Release(&jsonClass);
+    }
+    return jsonEgress;
+}
+
 static CCNxMetaMessage *
 _create_linkList_response(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, CCNxName *ccnxName)
 {
@@ -1004,6 +1622,19 @@ _create_linkList_response(AthenaTransportLinkAdapter *athenaTransportLinkAdapter
             parcJSON_AddBoolean(jsonItem, "notLocal", notLocal);
             parcJSON_AddBoolean(jsonItem, "localForced", localForced);
 
+            AthenaEgressScheduler *scheduler = _egressScheduler(athenaTransportLinkAdapter, index);
+            if (scheduler) {
+                PARCJSON *jsonEgress = _create_egress_json(scheduler);
+                parcJSON_AddObject(jsonItem, "egress", jsonEgress);
+                parcJSON_Release(&jsonEgress);
+            }
+            AthenaInterestShaper *shaper = _interestShaper(athenaTransportLinkAdapter, index);
+            if (shaper) {
+                PARCJSON *jsonShaper = _create_shaper_json(shaper);
+                parcJSON_AddObject(jsonItem, "shaper", jsonShaper);
+                parcJSON_Release(&jsonShaper);
+            }
+
             PARCJSONValue *jsonItemValue = parcJSONValue_CreateFromJSON(jsonItem);
             parcJSON_Release(&jsonItem);
 
@@ -70,6 +70,8 @@ typedef struct AthenaTransportLinkAdapter AthenaTransportLinkAdapter;
 
 #include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
 #include <ccnx/forwarder/athena/athena_TransportLink.h>
+#include <ccnx/forwarder/athena/athena_EgressScheduler.h>
+#include <ccnx/forwarder/athena/athena_InterestShaper.h>
 
 //
 // Transport Link Adapter interfaces
@@ -83,6 +85,8 @@ typedef struct AthenaTransportLinkAdapter AthenaTransportLinkAdapter;
 //
 //    athenaTransportLinkAdapter_Send
 //    athenaTransportLinkAdapter_Receive
+//    athenaTransportLinkAdapter_ReceiveWireFormat
+//    athenaTransportLinkAdapter_ContentObjectReceived
 //
 //    athenaTransportLinkAdapter_LinkIdToName
 //    athenaTransportLinkAdapter_LinkNameToId
@@ -200,6 +204,39 @@ CCNxMetaMessage *athenaTransportLinkAdapter_Receive(AthenaTransportLinkAdapter *
                                                     PARCBitVector **ingressVector,
                                                     int timeout);
 
+/**
+ * @abstract Receive the next available message without decoding it
+ * @discussion
+ *
+ * Links check a received packet's framing but leave it in its wire format, the caller decodes it with
+ * athenaTransportLinkModule_DecodeMessage if it wants more than an AthenaPacketDescriptor provides.
+ * Content Objects aren't parsed here, the caller that parses them reports their size to the Interest
+ * shaper of their link with athenaTransportLinkAdapter_ContentObjectReceived.
+ *
+ * @param [in] athenaTransportLinkAdapter link adapter instance
+ * @param [inout] ingressVector pointer to hold retrieved ingress vector
+ * @param [in] timeout miliseconds to wait for a message, -1 blocks until a message is available
+ * @return if successful, the undecoded message received, otherwise NULL
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBitVector *ingressVector;
+ *     CCNxMetaMessage *ccnxMessage = athenaTransportLinkAdapter_ReceiveWireFormat(tla, &ingressVector, 0);
+ *     if (ccnxMessage) {
+ *         if (athenaTransportLinkModule_DecodeMessage(ccnxMessage)) {
+ *             ...
+ *         }
+ *         parcBitVector_Release(&ingressVector);
+ *         ccnxMetaMessage_Release(&ccnxMessage);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxMetaMessage *athenaTransportLinkAdapter_ReceiveWireFormat(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                                              PARCBitVector **ingressVector,
+                                                              int timeout);
+
 /**
  * @abstract Send a message out the specified links
  * @discussion
@@ -213,6 +250,11 @@ CCNxMetaMessage *athenaTransportLinkAdapter_Receive(AthenaTransportLinkAdapter *
  * Decrements the hopcount on the message before delivery, if the incoming hopcount is 0 the message is sent along to the
  * transport stack links, but dropped from all others.
  *
+ * Each link has an egress queue for each traffic class (see AthenaEgressClass).  A message is sent immediately if the
+ * link has nothing queued and can take it, otherwise it is queued in its class and the link's queues are serviced in
+ * deficit round robin order as the link becomes writable.  A queued message counts as sent, a message dropped
+ * because its class queue is full counts as a failure.
+ *
  * @param [in] athenaTransportLinkAdapter link adapter instance
  * @param [in] ccnxMessage message to send
  * @param [in] egressLinkVector links to send message out on
@@ -319,6 +361,26 @@ int athenaTransportLinkAdapter_Poll(AthenaTransportLinkAdapter *athenaTransportL
 PARCBitVector *athenaTransportLinkAdapter_Close(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
                                                 PARCBitVector *linkVector);
 
+/**
+ * @abstract one more than the highest internal link identifier in use
+ * @discussion
+ *
+ * Link identifiers below the limit may be unused, their names are NULL.
+ *
+ * @param [in] athenaTransportLinkAdapter link adapter instance
+ * @return the link identifier limit
+ *
+ * Example:
+ * @code
+ * {
+ *     for (int linkId = 0; linkId < athenaTransportLinkAdapter_LinkIdLimit(tla); linkId++) {
+ *         const char *linkName = athenaTransportLinkAdapter_LinkIdToName(tla, linkId);
+ *     }
+ * }
+ * @endcode
+ */
+int athenaTransportLinkAdapter_LinkIdLimit(AthenaTransportLinkAdapter *athenaTransportLinkAdapter);
+
 /**
  * @abstract find the link name associated with an internal link identifier
  * @discussion
@@ -364,6 +426,151 @@ const char *athenaTransportLinkAdapter_LinkIdToName(AthenaTransportLinkAdapter *
 int athenaTransportLinkAdapter_LinkNameToId(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
                                             const char *linkName);
 
+/**
+ * @abstract set the weight and queue limit of an egress traffic class
+ * @discussion
+ *
+ * With a link name the class is changed on that link only.  With a NULL link name the defaults given to links
+ * created afterwards are changed, existing links keep their settings.  See athenaEgressScheduler_Configure
+ * for how weights and limits are applied.
+ *
+ * @param [in] athenaTransportLinkAdapter link adapter instance
+ * @param [in] linkName routable link to configure, or NULL for the defaults
+ * @param [in] egressClass traffic class
+ * @param [in] weight relative share of the link given to the class
+ * @param [in] queueLimit maximum number of messages queued in the class, 0 disables queueing
+ * @return 0 on success, -1 with errno set to ENOENT if there is no routable link with that name
+ *
+ * Example:
+ * @code
+ * {
+ *     // Give Interests on TCP_0 four times the share of Content Objects
+ *     athenaTransportLinkAdapter_SetEgressClass(athenaTransportLinkAdapter, "TCP_0", AthenaEgressClass_Interest, 4, 512);
+ * }
+ * @endcode
+ */
+int athenaTransportLinkAdapter_SetEgressClass(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                              const char *linkName,
+                                              AthenaEgressClass egressClass,
+                                              size_t weight,
+                                              size_t queueLimit);
+
+/**
+ * @abstract set the bandwidth Interests sent on a link are paced to
+ * @discussion
+ *
+ * With a link name the shaper of that link is changed.  With a NULL link name the settings given to links
+ * created afterwards are changed, existing links keep theirs.  Links are created with shaping disabled.
+ * See athenaInterestShaper_SetBandwidth for how Interests are paced.
+ *
+ * @param [in] athenaTransportLinkAdapter link adapter instance
+ * @param [in] linkName routable link to configure, or NULL for the defaults
+ * @param [in] bandwidth link capacity in bits per second, 0 disables shaping
+ * @param [in] maxDelay milliseconds an Interest can be held for before it's refused
+ * @return 0 on success, -1 with errno set to ENOENT if there is no routable link with that name
+ *
+ * Example:
+ * @code
+ * {
+ *     // Pace Interests on UDP_0 to a 10Mbps return path, holding them for at most 100ms
+ *     athenaTransportLinkAdapter_SetInterestShaping(athenaTransportLinkAdapter, "UDP_0", 10000000, 100);
+ * }
+ * @endcode
+ */
+int athenaTransportLinkAdapter_SetInterestShaping(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                                  const char *linkName,
+                                                  uint64_t bandwidth,
+                                                  uint64_t maxDelay);
+
+/**
+ * @abstract offer an Interest to the shapers of the links it's about to be forwarded on
+ * @discussion
+ *
+ * On return egressVector only holds the links that have capacity for the Interest's response now, the
+ * Interest is sent on those by the caller.  Links whose shaper held the Interest are removed from
+ * egressVector, the adapter sends it on them from athenaTransportLinkAdapter_Poll as their capacity
+ * allows.  Links that can't take the response within their maximum delay are removed and returned.
+ *
+ * @param [in] athenaTransportLinkAdapter link adapter instance
+ * @param [in] interest to be forwarded
+ * @param [in,out] egressVector links the Interest is forwarded on
+ * @return links that refused the Interest, which must be released, or NULL if there were none
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBitVector *congestedVector = athenaTransportLinkAdapter_ShapeInterest(athenaTransportLinkAdapter, interest, egressVector);
+ *     PARCBitVector *failedVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, interest, egressVector);
+ * }
+ * @endcode
+ */
+PARCBitVector *athenaTransportLinkAdapter_ShapeInterest(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                                        CCNxMetaMessage *interest,
+                                                        PARCBitVector *egressVector);
+
+/**
+ * @abstract report the size of a Content Object received by the caller of athenaTransportLinkAdapter_ReceiveWireFormat
+ * @discussion
+ *
+ * The shaper of the link the Content Object arrived on paces its Interests by the size of the responses
+ * they draw.  athenaTransportLinkAdapter_Receive reports the Content Objects it decodes itself.
+ *
+ * @param [in] athenaTransportLinkAdapter link adapter instance
+ * @param [in] ingressVector link the Content Object was received on
+ * @param [in] packetLength size of the Content Object in bytes
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaPacketDescriptor descriptor;
+ *     if (athenaPacketDescriptor_Parse(&descriptor, ccnxWireFormatMessage_GetWireFormatBuffer(ccnxMessage)) &&
+ *         (descriptor.packetType == AthenaPacketDescriptor_PacketType_ContentObject)) {
+ *         athenaTransportLinkAdapter_ContentObjectReceived(athenaTransportLinkAdapter, ingressVector, descriptor.packetLength);
+ *     }
+ * }
+ * @endcode
+ */
+void athenaTransportLinkAdapter_ContentObjectReceived(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                                      const PARCBitVector *ingressVector,
+                                                      size_t packetLength);
+
+/**
+ * @typedef AthenaTransportLinkAdapter_ReleaseInterestCallbackContext
+ * @brief context for the releaseInterest callback.
+ */
+typedef void *AthenaTransportLinkAdapter_ReleaseInterestCallbackContext;
+
+/**
+ * @typedef AthenaTransportLinkAdapter_ReleaseInterestCallback
+ * @brief called as a shaper releases an Interest it held, returns false if the Interest is no longer pending.
+ */
+typedef bool (AthenaTransportLinkAdapter_ReleaseInterestCallback)(AthenaTransportLinkAdapter_ReleaseInterestCallbackContext releaseInterestContext,
+                                                                  const CCNxInterest *interest,
+                                                                  const PARCBitVector *egressVector);
+
+/**
+ * @abstract set the callback consulted before a held Interest is sent
+ * @discussion
+ *
+ * An Interest can be satisfied, expire or be removed from the PIT while a shaper holds it.  The callback
+ * is given the Interest and the link it's about to be sent on, if it returns false the Interest is dropped
+ * instead of sent.  Without a callback held Interests are always sent.
+ *
+ * @param [in] athenaTransportLinkAdapter link adapter instance
+ * @param [in] releaseInterest callback, or NULL to remove it
+ * @param [in] releaseInterestContext context passed to the callback
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaTransportLinkAdapter_SetReleaseInterestCallback(athenaTransportLinkAdapter, _releaseShapedInterest, athena);
+ * }
+ * @endcode
+ */
+void athenaTransportLinkAdapter_SetReleaseInterestCallback(AthenaTransportLinkAdapter *athenaTransportLinkAdapter,
+                                                           AthenaTransportLinkAdapter_ReleaseInterestCallback *releaseInterest,
+                                                           AthenaTransportLinkAdapter_ReleaseInterestCallbackContext releaseInterestContext);
+
 /**
  * @abstract remove link by name
  * @discussion
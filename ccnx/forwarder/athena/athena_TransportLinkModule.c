@@ -66,6 +66,10 @@
 
 #include <ccnx/forwarder/athena/athena.h>
 #include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
+#include <ccnx/forwarder/athena/athena_PacketDescriptor.h>
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
 #include <parc/logging/parc_LogReporterTextStdout.h>
 
 
@@ -328,6 +332,9 @@ athenaTransportLinkModule_GetMessageIoVector(CCNxMetaMessage *message)
             ccnxCodecNetworkBuffer_PutBuffer(netbuff, buffer);
             iovec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
             ccnxCodecNetworkBuffer_Release(&netbuff);
+
+            // Keep it with the message so that any other link it's sent on shares this copy
+            ccnxWireFormatMessage_PutIoVec(message, iovec);
         }
     } else {
         iovec = ccnxCodecNetworkBufferIoVec_Acquire(iovec);
@@ -335,3 +342,83 @@ athenaTransportLinkModule_GetMessageIoVector(CCNxMetaMessage *message)
 
     return iovec;
 }
+
+bool
+athenaTransportLinkModule_PrepareMessageBuffer(CCNxMetaMessage *message)
+{
+    if (ccnxWireFormatMessage_GetWireFormatBuffer(message) != NULL) {
+        return false;
+    }
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxWireFormatMessage_GetIoVec(message);
+    if (iovec == NULL) {
+        athena_EncodeMessage(message);
+        iovec = ccnxWireFormatMessage_GetIoVec(message);
+    }
+    assertNotNull(iovec, "Null io vector");
+
+    // Copied even if it's a single vector, a wrapped buffer would not keep the encoding alive for
+    // links that hold on to it after the message has been released.
+    size_t iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(iovec);
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    PARCBuffer *buffer = parcBuffer_Allocate(ccnxCodecNetworkBufferIoVec_Length(iovec));
+    for (int i = 0; i < iovcnt; i++) {
+        parcBuffer_PutArray(buffer, array[i].iov_len, array[i].iov_base);
+    }
+    parcBuffer_Flip(buffer);
+
+    bool result = ccnxWireFormatMessage_PutWireFormatBuffer(message, buffer);
+    assertTrue(result, "ccnxWireFormatMessage_PutWireFormatBuffer failed");
+    parcBuffer_Release(&buffer);
+    return true;
+}
+
+CCNxMetaMessage *
+athenaTransportLinkModule_CreateMessageFromBuffer(PARCBuffer *wireFormatBuffer)
+{
+    AthenaPacketDescriptor descriptor;
+    if (athenaPacketDescriptor_Parse(&descriptor, wireFormatBuffer) == false) {
+        return NULL;
+    }
+
+    CCNxMetaMessage *result = NULL;
+    CCNxWireFormatMessage *message = ccnxWireFormatMessage_Create(wireFormatBuffer);
+    if (message != NULL) {
+        result = ccnxMetaMessage_Acquire(ccnxWireFormatMessage_GetDictionary(message));
+        ccnxWireFormatMessage_Release(&message);
+    }
+    return result;
+}
+
+bool
+athenaTransportLinkModule_DecodeMessage(CCNxMetaMessage *message)
+{
+    // Messages from receive threads may have been decoded there, the decoder always records the fixed header
+    if (ccnxTlvDictionary_GetBuffer(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_FixedHeader) != NULL) {
+        return true;
+    }
+
+    PARCBuffer *wireFormatBuffer = ccnxWireFormatMessage_GetWireFormatBuffer(message);
+    assertNotNull(wireFormatBuffer, "Message has no wire format to decode");
+
+    parcBuffer_SetPosition(wireFormatBuffer, 0);
+    return ccnxCodecTlvPacket_BufferDecode(wireFormatBuffer, message);
+}
+
+void
+athenaTransportLinkModule_SetMessageHopLimit(CCNxMetaMessage *message, uint8_t hopLimit)
+{
+    ccnxInterest_SetHopLimit(message, hopLimit);
+
+    PARCBuffer *wireFormatBuffer = ccnxWireFormatMessage_GetWireFormatBuffer(message);
+    if (wireFormatBuffer != NULL) {
+        athenaPacketDescriptor_SetHopLimit(wireFormatBuffer, hopLimit);
+    }
+
+    // A cached io vector is a separate copy of the encoding, the fixed header is in its first vector
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxWireFormatMessage_GetIoVec(message);
+    if ((iovec != NULL) && (ccnxCodecNetworkBufferIoVec_GetCount(iovec) > 0)) {
+        const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+        athenaPacketDescriptor_SetHopLimitArray(array[0].iov_base, array[0].iov_len, hopLimit);
+    }
+}
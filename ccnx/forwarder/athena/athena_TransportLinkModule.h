@@ -254,4 +254,89 @@ PARCBuffer *athenaTransportLinkModule_CreateMessageBuffer(CCNxMetaMessage *messa
 
 CCNxCodecNetworkBufferIoVec *athenaTransportLinkModule_GetMessageIoVector(CCNxMetaMessage *message);
 
+/**
+ * @abstract attach one contiguous wire format buffer to a message that is about to be sent on several links
+ * @discussion
+ *
+ * The message is encoded if it hasn't been, and its encoding is copied into a buffer the message owns.
+ * athenaTransportLinkModule_CreateMessageBuffer then returns a reference to that buffer for every link,
+ * rather than wrapping or flattening the encoding again for each.  Links must not modify its contents.
+ *
+ * @param [in] message to be sent
+ * @return true if a buffer was created, false if the message already had one
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaTransportLinkModule_PrepareMessageBuffer(message);
+ * }
+ * @endcode
+ */
+bool athenaTransportLinkModule_PrepareMessageBuffer(CCNxMetaMessage *message);
+
+/**
+ * @abstract create a message from a received wire format buffer without decoding it
+ * @discussion
+ *
+ * The packet's framing is checked with athenaPacketDescriptor_Parse and the message is created
+ * holding the buffer, with only its type known.  The forwarder decides from the wire format whether
+ * it needs the message at all before calling athenaTransportLinkModule_DecodeMessage.
+ *
+ * @param [in] wireFormatBuffer a single CCNx 1.0 packet, acquired by the message
+ * @return the undecoded message, or NULL if the packet is malformed
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxMetaMessage *ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+ *     if (ccnxMetaMessage == NULL) {
+ *         linkData->_stats.receive_DecodeFailed++;
+ *     }
+ *     parcBuffer_Release(&wireFormatBuffer);
+ * }
+ * @endcode
+ */
+CCNxMetaMessage *athenaTransportLinkModule_CreateMessageFromBuffer(PARCBuffer *wireFormatBuffer);
+
+/**
+ * @abstract fully decode a message created by athenaTransportLinkModule_CreateMessageFromBuffer
+ * @discussion
+ *
+ * Must be called before any of the message's fields are read through its dictionary.  A message
+ * that has already been decoded, for instance by a link's receive thread, is left as it is.
+ *
+ * @param [in] message received message
+ * @return true if the message decoded
+ *
+ * Example:
+ * @code
+ * {
+ *     if (athenaTransportLinkModule_DecodeMessage(ccnxMetaMessage) == false) {
+ *         ccnxMetaMessage_Release(&ccnxMetaMessage);
+ *     }
+ * }
+ * @endcode
+ */
+bool athenaTransportLinkModule_DecodeMessage(CCNxMetaMessage *message);
+
+/**
+ * @abstract set the hop limit of an Interest in its dictionary and in any encoding it carries
+ * @discussion
+ *
+ * The hop limit byte is patched in place in the fixed header of the message's wire format buffer,
+ * and of its cached io vector, so a received Interest is forwarded in the bytes it arrived in rather
+ * than being encoded again.  A message that hasn't been encoded yet picks the value up when it is.
+ *
+ * @param [in] message Interest to modify
+ * @param [in] hopLimit new hop limit
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaTransportLinkModule_SetMessageHopLimit(interest, ccnxInterest_GetHopLimit(interest) - 1);
+ * }
+ * @endcode
+ */
+void athenaTransportLinkModule_SetMessageHopLimit(CCNxMetaMessage *message, uint8_t hopLimit);
+
 #endif // libathena_TransportLinkModule_h
@@ -547,13 +547,10 @@ _ETHReceiveMessage(AthenaTransportLink *athenaTransportLink, struct ether_addr *
     if (wireFormatBuffer != NULL) {
         // Construct, and return a ccnxMetaMessage from the wire format buffer.
         parcBuffer_SetPosition(wireFormatBuffer, 0);
-        ccnxMetaMessage = ccnxMetaMessage_CreateFromWireFormatBuffer(wireFormatBuffer);
+        ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
         if (ccnxMetaMessage == NULL) {
             linkData->_stats.receive_DecodeFailed++;
             parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
-        } else if (ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage) == CCNxTlvDictionary_SchemaVersion_V0) {
-            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
-                          "received deprecated version %d message\n", ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage));
         } else {
             parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "received message (size=%d)",
                           parcBuffer_Remaining(wireFormatBuffer));
@@ -0,0 +1,1016 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/eventfd.h>
+
+#include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkModuleSHM.h>
+
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+
+static int _listenerBacklog = 16;
+
+#define SHM_SCHEME "shm"
+
+// Prefix of the abstract unix domain socket name the listener binds its channel to
+#define SHM_SOCKET_PREFIX "athena.shm."
+
+#define SHM_MAGIC 0x4154484d // "ATHM"
+#define SHM_VERSION 1
+
+// Bytes of message data in each direction, must be a power of two
+#define SHM_RING_SIZE (1 << 20)
+
+// Each record is a 32 bit length followed by the message, padded to keep the lengths aligned.
+// A record that would run past the end of the ring is preceded by a marker that skips to its start.
+#define SHM_RECORD_ALIGNMENT 8
+#define SHM_WRAP_MARKER UINT32_MAX
+
+//
+// A single producer, single consumer ring.  The producer only writes tail and the consumer only
+// writes head, both are free running byte counts kept on separate cache lines.
+//
+typedef struct _SHMRing {
+    uint64_t head __attribute__((aligned(LEVEL1_DCACHE_LINESIZE)));
+    uint64_t tail __attribute__((aligned(LEVEL1_DCACHE_LINESIZE)));
+    uint32_t closed __attribute__((aligned(LEVEL1_DCACHE_LINESIZE))); // set by the producer when it closes its end
+    uint8_t data[] __attribute__((aligned(LEVEL1_DCACHE_LINESIZE)));
+} _SHMRing;
+
+//
+// The shared segment is this header followed by the two rings.  The connecting end (0) produces into
+// ring 0 and the listening end (1) into ring 1, eventfd N is signalled when ring N becomes non-empty.
+//
+typedef struct _SHMSegmentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t ringSize;
+} __attribute__((aligned(LEVEL1_DCACHE_LINESIZE))) _SHMSegmentHeader;
+
+//
+// Sent by the connecting end along with the segment and eventfd descriptors
+//
+typedef struct _SHMHandshake {
+    uint32_t magic;
+    uint32_t serial;
+    pid_t pid;
+} _SHMHandshake;
+
+#define SHM_HANDSHAKE_FDS 3
+
+//
+// Private data for each link instance
+//
+typedef struct _SHMLinkData {
+    int fd; // unix domain socket, only used to set the link up and to detect the peer going away
+    int eventFd[2];
+    void *segment;
+    size_t segmentSize;
+    size_t ringSize;
+    _SHMRing *sendRing;
+    _SHMRing *receiveRing;
+    int sendEventFd;
+    int receiveEventFd;
+    char *channel;
+    struct {
+        size_t receive_BadMessageLength;
+        size_t receive_DecodeFailed;
+        size_t receive_PeerClosed;
+        size_t send_RingFull;
+        size_t send_Signal;
+        size_t send_Error;
+        size_t listener_HandshakeFailed;
+    } _stats;
+} _SHMLinkData;
+
+static _SHMLinkData *
+_SHMLinkData_Create()
+{
+    _SHMLinkData *linkData = parcMemory_AllocateAndClear(sizeof(_SHMLinkData));
+    assertNotNull(linkData, "Could not create private data for new link");
+    linkData->fd = -1;
+    linkData->eventFd[0] = linkData->eventFd[1] = -1;
+    return linkData;
+}
+
+static void
+_SHMLinkData_Destroy(_SHMLinkData **linkData)
+{
+    if ((*linkData)->segment) {
+        munmap((*linkData)->segment, (*linkData)->segmentSize);
+    }
+    for (int i = 0; i < 2; i++) {
+        if ((*linkData)->eventFd[i] != -1) {
+            close((*linkData)->eventFd[i]);
+        }
+    }
+    if ((*linkData)->fd != -1) {
+        close((*linkData)->fd);
+    }
+    if ((*linkData)->channel) {
+        parcMemory_Deallocate(&((*linkData)->channel));
+    }
+    parcMemory_Deallocate(linkData);
+}
+
+static size_t
+_ringStride(size_t ringSize)
+{
+    return sizeof(_SHMRing) + ringSize;
+}
+
+static size_t
+_segmentSize(size_t ringSize)
+{
+    return sizeof(_SHMSegmentHeader) + (2 * _ringStride(ringSize));
+}
+
+static _SHMRing *
+_segmentRing(void *segment, size_t ringSize, int ring)
+{
+    return (_SHMRing *) ((uint8_t *) segment + sizeof(_SHMSegmentHeader) + (ring * _ringStride(ringSize)));
+}
+
+static size_t
+_recordLength(size_t length)
+{
+    return (sizeof(uint32_t) + length + (SHM_RECORD_ALIGNMENT - 1)) & ~((size_t) SHM_RECORD_ALIGNMENT - 1);
+}
+
+/**
+ * @abstract copy a message into a ring
+ * @discussion
+ *
+ * The consumer only needs to be woken when it had already taken everything before this message,
+ * otherwise it's still draining the ring and will find the message when it gets to it.  Publishing
+ * the tail and then reading the head, while the consumer publishes the head and then reads the
+ * tail, guarantees that at least one side sees the other's update.
+ *
+ * @param [in] ring to copy into
+ * @param [in] ringSize size of the ring's data
+ * @param [in] buffer message to copy
+ * @param [in] length of the message
+ * @param [out] wakeup set if the consumer has to be signalled
+ * @return true if the message was queued, false if the ring doesn't have room for it
+ */
+static bool
+_ringPut(_SHMRing *ring, size_t ringSize, const uint8_t *buffer, size_t length, bool *wakeup)
+{
+    size_t recordLength = _recordLength(length);
+    uint64_t tail = ring->tail;
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    size_t offset = tail & (ringSize - 1);
+    size_t skip = 0;
+    if ((offset + recordLength) > ringSize) {
+        skip = ringSize - offset;
+    }
+    if (((tail + skip + recordLength) - head) > ringSize) {
+        return false;
+    }
+
+    if (skip) {
+        *(uint32_t *) &ring->data[offset] = SHM_WRAP_MARKER;
+        offset = 0;
+    }
+    *(uint32_t *) &ring->data[offset] = (uint32_t) length;
+    memcpy(&ring->data[offset + sizeof(uint32_t)], buffer, length);
+
+    __atomic_store_n(&ring->tail, tail + skip + recordLength, __ATOMIC_SEQ_CST);
+    *wakeup = (__atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) == tail);
+    return true;
+}
+
+static bool
+_ringIsEmpty(_SHMRing *ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) == __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @abstract copy the next message out of a ring
+ * @discussion
+ *
+ * The ring is writable by the peer, so the lengths are checked before they're used and the
+ * message is decoded from the copy.
+ *
+ * @param [in] ring to copy from
+ * @param [in] ringSize size of the ring's data
+ * @param [out] corrupt set if the ring holds a record that can't be valid
+ * @return the message, NULL if the ring is empty or corrupt
+ */
+static PARCBuffer *
+_ringGet(_SHMRing *ring, size_t ringSize, bool *corrupt)
+{
+    uint64_t head = ring->head;
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    *corrupt = false;
+
+    if (head == tail) {
+        return NULL;
+    }
+
+    size_t offset = head & (ringSize - 1);
+    uint32_t length = *(uint32_t *) &ring->data[offset];
+    if (length == SHM_WRAP_MARKER) {
+        head += ringSize - offset;
+        offset = 0;
+        length = *(uint32_t *) &ring->data[offset];
+    }
+    if (((offset + _recordLength(length)) > ringSize) || ((head + _recordLength(length)) > tail)) {
+        *corrupt = true;
+        return NULL;
+    }
+
+    PARCBuffer *wireFormatBuffer = parcBuffer_Allocate(length);
+    memcpy(parcBuffer_Overlay(wireFormatBuffer, 0), &ring->data[offset + sizeof(uint32_t)], length);
+
+    __atomic_store_n(&ring->head, head + _recordLength(length), __ATOMIC_SEQ_CST);
+    return wireFormatBuffer;
+}
+
+static bool
+_peerHasClosed(_SHMLinkData *linkData)
+{
+    if (__atomic_load_n(&linkData->receiveRing->closed, __ATOMIC_ACQUIRE)) {
+        return true;
+    }
+
+    // The peer may have exited without closing its end, which hangs up the setup socket
+    struct pollfd pollfd = { .fd = linkData->fd, .events = POLLIN };
+    if (poll(&pollfd, 1, 0) == 1) {
+        if (pollfd.revents & (POLLHUP | POLLERR)) {
+            return true;
+        }
+        char peekBuffer;
+        if (recv(linkData->fd, &peekBuffer, 1, MSG_PEEK | MSG_DONTWAIT) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char *
+_createNameFromLinkData(const _SHMLinkData *linkData, const _SHMHandshake *handshake)
+{
+    char nameBuffer[MAXPATHLEN];
+
+    if (handshake) {
+        sprintf(nameBuffer, "%s://%s<->%d.%u", SHM_SCHEME, linkData->channel, (int) handshake->pid, handshake->serial);
+    } else { // listener only
+        sprintf(nameBuffer, "%s://%s", SHM_SCHEME, linkData->channel);
+    }
+
+    return parcMemory_StringDuplicate(nameBuffer, strlen(nameBuffer));
+}
+
+static int
+_SHMSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMessage)
+{
+    _SHMLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    PARCBuffer *wireFormatBuffer = athenaTransportLinkModule_CreateMessageBuffer(ccnxMetaMessage);
+    parcBuffer_SetPosition(wireFormatBuffer, 0);
+    size_t length = parcBuffer_Limit(wireFormatBuffer);
+    const uint8_t *buffer = parcBuffer_Overlay(wireFormatBuffer, length);
+
+    parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
+                  "sending message (size=%zu)", length);
+
+    bool wakeup = false;
+    bool queued = _ringPut(linkData->sendRing, linkData->ringSize, buffer, length, &wakeup);
+    parcBuffer_Release(&wireFormatBuffer);
+
+    if (!queued) {
+        if (_peerHasClosed(linkData)) {
+            linkData->_stats.send_Error++;
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "send error, peer has closed the link");
+            errno = EPIPE;
+        } else {
+            linkData->_stats.send_RingFull++;
+            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "send ring full, message dropped");
+            errno = ENOBUFS;
+        }
+        return -1;
+    }
+
+    if (wakeup) {
+        linkData->_stats.send_Signal++;
+        eventfd_write(linkData->sendEventFd, 1);
+    }
+    return 0;
+}
+
+static CCNxMetaMessage *
+_SHMReceive(AthenaTransportLink *athenaTransportLink)
+{
+    _SHMLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    CCNxMetaMessage *ccnxMetaMessage = NULL;
+
+    bool corrupt;
+    PARCBuffer *wireFormatBuffer = _ringGet(linkData->receiveRing, linkData->ringSize, &corrupt);
+    if (corrupt) {
+        linkData->_stats.receive_BadMessageLength++;
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Framing error in the receive ring, closing link.");
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+        return NULL;
+    }
+
+    bool received = (wireFormatBuffer != NULL);
+    if (received) {
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "received message (size=%zu)", parcBuffer_Remaining(wireFormatBuffer));
+        ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+        if (ccnxMetaMessage == NULL) {
+            linkData->_stats.receive_DecodeFailed++;
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
+        }
+        parcBuffer_Release(&wireFormatBuffer);
+    }
+
+    // The eventfd only signals the ring becoming non-empty, so keep the receive event set while
+    // there's more to read and only clear the eventfd once the ring has been drained.
+    if (_ringIsEmpty(linkData->receiveRing)) {
+        eventfd_t count;
+        eventfd_read(linkData->receiveEventFd, &count);
+        if (!_ringIsEmpty(linkData->receiveRing)) {
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+        } else if (!received && _peerHasClosed(linkData)) {
+            linkData->_stats.receive_PeerClosed++;
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+        }
+    } else {
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+    }
+
+    return ccnxMetaMessage;
+}
+
+static void
+_SHMClose(AthenaTransportLink *athenaTransportLink)
+{
+    parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
+                 "link %s closed", athenaTransportLink_GetName(athenaTransportLink));
+    _SHMLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    // Let the peer know it won't be getting anything more
+    if (linkData->sendRing) {
+        __atomic_store_n(&linkData->sendRing->closed, 1, __ATOMIC_RELEASE);
+        eventfd_write(linkData->sendEventFd, 1);
+    }
+    _SHMLinkData_Destroy(&linkData);
+}
+
+// Attach the link data to its end of the segment
+static void
+_setRings(_SHMLinkData *linkData, int end)
+{
+    linkData->sendRing = _segmentRing(linkData->segment, linkData->ringSize, end);
+    linkData->receiveRing = _segmentRing(linkData->segment, linkData->ringSize, end ^ 1);
+    linkData->sendEventFd = linkData->eventFd[end];
+    linkData->receiveEventFd = linkData->eventFd[end ^ 1];
+}
+
+static void
+_setConnectLinkState(AthenaTransportLink *athenaTransportLink, _SHMLinkData *linkData)
+{
+    athenaTransportLink_SetPrivateData(athenaTransportLink, linkData);
+
+    // Register file descriptor to be polled.  This must be set before adding the link.
+    athenaTransportLink_SetEventFd(athenaTransportLink, linkData->receiveEventFd);
+
+    // The peer is always on this host
+    athenaTransportLink_SetLocal(athenaTransportLink, true);
+
+    // Allow messages to initially be sent
+    athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+}
+
+static int
+_channelAddress(const char *channel, struct sockaddr_un *address, socklen_t *addressLength)
+{
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+
+    // Leading nul for the abstract namespace, which needs no clean up when the listener goes away
+    int length = snprintf(&address->sun_path[1], sizeof(address->sun_path) - 1, "%s%s", SHM_SOCKET_PREFIX, channel);
+    if ((length < 0) || (length >= (sizeof(address->sun_path) - 1))) {
+        errno = EINVAL;
+        return -1;
+    }
+    *addressLength = (socklen_t) (offsetof(struct sockaddr_un, sun_path) + 1 + length);
+    return 0;
+}
+
+#define SHM_LISTENER_FLAG "listener"
+#define LINK_NAME_SPECIFIER "name%3D"
+#define LOCAL_LINK_FLAG "local%3D"
+
+typedef struct _URISpecificationParameters {
+    char *linkName;
+    const char *derivedLinkName;
+    char *channel;
+    bool listener;
+    int forceLocal;
+} _URISpecificationParameters;
+
+static void
+_URISpecificationParameters_Destroy(_URISpecificationParameters **parameters)
+{
+    if ((*parameters)->linkName) {
+        parcMemory_Deallocate(&((*parameters)->linkName));
+    }
+    if ((*parameters)->derivedLinkName) {
+        parcMemory_Deallocate(&((*parameters)->derivedLinkName));
+    }
+    if ((*parameters)->channel) {
+        parcMemory_Deallocate(&((*parameters)->channel));
+    }
+    parcMemory_Deallocate(parameters);
+}
+
+static _URISpecificationParameters *
+_URISpecificationParameters_Create(AthenaTransportLinkModule *athenaTransportLinkModule, PARCURI *connectionURI)
+{
+    _URISpecificationParameters *parameters = parcMemory_AllocateAndClear(sizeof(_URISpecificationParameters));
+
+    // The authority names the channel
+    const char *authorityString = parcURI_GetAuthority(connectionURI);
+    if ((authorityString == NULL) || (strlen(authorityString) == 0)) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unable to parse connection authority %s", authorityString);
+        errno = EINVAL;
+        _URISpecificationParameters_Destroy(&parameters);
+        return NULL;
+    }
+    parameters->channel = parcMemory_StringDuplicate(authorityString, strlen(authorityString));
+
+    PARCURIPath *remainder = parcURI_GetPath(connectionURI);
+    size_t segments = parcURIPath_Count(remainder);
+    for (int i = 0; i < segments; i++) {
+        PARCURISegment *segment = parcURIPath_Get(remainder, i);
+        const char *token = parcURISegment_ToString(segment);
+
+        if (strcasecmp(token, SHM_LISTENER_FLAG) == 0) {
+            parameters->listener = true;
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, LINK_NAME_SPECIFIER, strlen(LINK_NAME_SPECIFIER)) == 0) {
+            char specifiedLinkName[MAXPATHLEN];
+            if (sscanf(token, "%*[^%%]%%3D%s", specifiedLinkName) != 1) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper connection name specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parameters->linkName = parcMemory_StringDuplicate(specifiedLinkName, strlen(specifiedLinkName));
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, LOCAL_LINK_FLAG, strlen(LOCAL_LINK_FLAG)) == 0) {
+            char localFlag[MAXPATHLEN] = { 0 };
+            if (sscanf(token, "%*[^%%]%%3D%s", localFlag) == 1) {
+                if (strncasecmp(localFlag, "false", strlen("false")) == 0) {
+                    parameters->forceLocal = AthenaTransportLink_ForcedNonLocal;
+                } else if (strncasecmp(localFlag, "true", strlen("true")) == 0) {
+                    parameters->forceLocal = AthenaTransportLink_ForcedLocal;
+                }
+            }
+            if (parameters->forceLocal == 0) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper local specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unknown connection parameter (%s)", token);
+        _URISpecificationParameters_Destroy(&parameters);
+        parcMemory_Deallocate(&token);
+        errno = EINVAL;
+        return NULL;
+    }
+    return parameters;
+}
+
+// Serial numbers distinguish the connections made by this process
+static uint32_t _connectionSerial = 0;
+
+// Create the shared segment, backed by a shared memory object that's unlinked as soon as it's mapped
+static int
+_createSegment(AthenaTransportLinkModule *athenaTransportLinkModule, _SHMLinkData *linkData, uint32_t serial)
+{
+    char objectName[NAME_MAX];
+    snprintf(objectName, sizeof(objectName), "/%s%d.%u", SHM_SOCKET_PREFIX, (int) getpid(), serial);
+
+    int fd = shm_open(objectName, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "shm_open error (%s)", strerror(errno));
+        return -1;
+    }
+    shm_unlink(objectName);
+
+    linkData->ringSize = SHM_RING_SIZE;
+    linkData->segmentSize = _segmentSize(linkData->ringSize);
+    if (ftruncate(fd, linkData->segmentSize) == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "ftruncate error (%s)", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    void *segment = mmap(NULL, linkData->segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (segment == MAP_FAILED) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "mmap error (%s)", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    linkData->segment = segment;
+
+    _SHMSegmentHeader *header = (_SHMSegmentHeader *) segment;
+    header->magic = SHM_MAGIC;
+    header->version = SHM_VERSION;
+    header->ringSize = linkData->ringSize;
+    return fd;
+}
+
+static int
+_sendHandshake(int socketFd, const _SHMHandshake *handshake, const int fds[SHM_HANDSHAKE_FDS])
+{
+    struct iovec iov = { .iov_base = (void *) handshake, .iov_len = sizeof(*handshake) };
+    union {
+        char buffer[CMSG_SPACE(sizeof(int) * SHM_HANDSHAKE_FDS)];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr message = {
+        .msg_iov        = &iov,
+        .msg_iovlen     = 1,
+        .msg_control    = control.buffer,
+        .msg_controllen = sizeof(control.buffer),
+    };
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * SHM_HANDSHAKE_FDS);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * SHM_HANDSHAKE_FDS);
+
+    return (sendmsg(socketFd, &message, MSG_NOSIGNAL) == sizeof(*handshake)) ? 0 : -1;
+}
+
+// Returns the number of descriptors received, any received are owned by the caller
+static int
+_receiveHandshake(int socketFd, _SHMHandshake *handshake, int fds[SHM_HANDSHAKE_FDS])
+{
+    struct iovec iov = { .iov_base = handshake, .iov_len = sizeof(*handshake) };
+    union {
+        char buffer[CMSG_SPACE(sizeof(int) * SHM_HANDSHAKE_FDS)];
+        struct cmsghdr align;
+    } control;
+
+    struct msghdr message = {
+        .msg_iov        = &iov,
+        .msg_iovlen     = 1,
+        .msg_control    = control.buffer,
+        .msg_controllen = sizeof(control.buffer),
+    };
+
+    ssize_t length = recvmsg(socketFd, &message, MSG_CMSG_CLOEXEC);
+
+    int received = 0;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS)) {
+            received = (int) ((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+            if (received > SHM_HANDSHAKE_FDS) {
+                received = SHM_HANDSHAKE_FDS;
+            }
+            memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * received);
+        }
+    }
+
+    if ((length != sizeof(*handshake)) || (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) || (handshake->magic != SHM_MAGIC)) {
+        for (int i = 0; i < received; i++) {
+            close(fds[i]);
+        }
+        return -1;
+    }
+    return received;
+}
+
+static AthenaTransportLink *
+_SHMOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpecificationParameters *parameters)
+{
+    _SHMLinkData *linkData = _SHMLinkData_Create();
+    linkData->channel = parcMemory_StringDuplicate(parameters->channel, strlen(parameters->channel));
+
+    struct sockaddr_un address;
+    socklen_t addressLength;
+    if (_channelAddress(linkData->channel, &address, &addressLength) == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Channel name too long (%s)", linkData->channel);
+        _SHMLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    linkData->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (linkData->fd < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "socket error (%s)", strerror(errno));
+        _SHMLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    if (connect(linkData->fd, (struct sockaddr *) &address, addressLength) < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "connect error (%s)", strerror(errno));
+        int connectError = errno;
+        _SHMLinkData_Destroy(&linkData);
+        errno = connectError;
+        return NULL;
+    }
+
+    _SHMHandshake handshake = {
+        .magic  = SHM_MAGIC,
+        .serial = __atomic_fetch_add(&_connectionSerial, 1, __ATOMIC_RELAXED),
+        .pid    = getpid(),
+    };
+
+    int segmentFd = _createSegment(athenaTransportLinkModule, linkData, handshake.serial);
+    if (segmentFd == -1) {
+        _SHMLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        linkData->eventFd[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (linkData->eventFd[i] == -1) {
+            parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "eventfd error (%s)", strerror(errno));
+            close(segmentFd);
+            _SHMLinkData_Destroy(&linkData);
+            return NULL;
+        }
+    }
+
+    int fds[SHM_HANDSHAKE_FDS] = { segmentFd, linkData->eventFd[0], linkData->eventFd[1] };
+    int result = _sendHandshake(linkData->fd, &handshake, fds);
+    close(segmentFd);
+    if (result == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "handshake error (%s)", strerror(errno));
+        _SHMLinkData_Destroy(&linkData);
+        return NULL;
+    }
+    _setRings(linkData, 0);
+
+    parameters->derivedLinkName = _createNameFromLinkData(linkData, &handshake);
+
+    const char *linkName;
+    if (parameters->linkName == NULL) {
+        linkName = parameters->derivedLinkName;
+    } else {
+        linkName = parameters->linkName;
+    }
+
+    AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
+                                                                          _SHMSend,
+                                                                          _SHMReceive,
+                                                                          _SHMClose);
+    if (athenaTransportLink == NULL) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "athenaTransportLink_Create failed");
+        _SHMLinkData_Destroy(&linkData);
+        return athenaTransportLink;
+    }
+
+    athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
+    _setConnectLinkState(athenaTransportLink, linkData);
+
+    parcLog_Info(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                 "new link established: Name=\"%s\" (%s)", parameters->linkName, parameters->derivedLinkName);
+
+    return athenaTransportLink;
+}
+
+// Map the segment the connecting end passed, after checking it's big enough for the rings it describes
+static int
+_mapSegment(AthenaTransportLink *athenaTransportLink, _SHMLinkData *linkData, int segmentFd)
+{
+    struct stat status;
+    if ((fstat(segmentFd, &status) == -1) || (status.st_size < sizeof(_SHMSegmentHeader))) {
+        return -1;
+    }
+
+    void *segment = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, segmentFd, 0);
+    if (segment == MAP_FAILED) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "mmap error (%s)", strerror(errno));
+        return -1;
+    }
+    linkData->segment = segment;
+    linkData->segmentSize = status.st_size;
+
+    const _SHMSegmentHeader *header = (const _SHMSegmentHeader *) segment;
+    linkData->ringSize = header->ringSize;
+    if ((header->magic != SHM_MAGIC) || (header->version != SHM_VERSION) ||
+        (linkData->ringSize < SHM_RECORD_ALIGNMENT) || (linkData->ringSize & (linkData->ringSize - 1)) ||
+        (linkData->ringSize > status.st_size) || (_segmentSize(linkData->ringSize) > status.st_size)) {
+        return -1;
+    }
+    return 0;
+}
+
+static CCNxMetaMessage *
+_SHMReceiveListener(AthenaTransportLink *athenaTransportLink)
+{
+    _SHMLinkData *listenerData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    _SHMLinkData *newLinkData = _SHMLinkData_Create();
+    newLinkData->channel = parcMemory_StringDuplicate(listenerData->channel, strlen(listenerData->channel));
+
+    // Accept a new connection and take over the segment and eventfds it passes
+    newLinkData->fd = accept(listenerData->fd, NULL, NULL);
+    if (newLinkData->fd == -1) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "_SHMReceiveListener accept: %s", strerror(errno));
+        _SHMLinkData_Destroy(&newLinkData);
+        return NULL;
+    }
+
+    _SHMHandshake handshake;
+    int fds[SHM_HANDSHAKE_FDS];
+    int received = _receiveHandshake(newLinkData->fd, &handshake, fds);
+    if (received != SHM_HANDSHAKE_FDS) {
+        for (int i = 0; i < received; i++) {
+            close(fds[i]);
+        }
+        listenerData->_stats.listener_HandshakeFailed++;
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "_SHMReceiveListener handshake failed");
+        _SHMLinkData_Destroy(&newLinkData);
+        return NULL;
+    }
+    newLinkData->eventFd[0] = fds[1];
+    newLinkData->eventFd[1] = fds[2];
+
+    int result = _mapSegment(athenaTransportLink, newLinkData, fds[0]);
+    close(fds[0]);
+    if (result == -1) {
+        listenerData->_stats.listener_HandshakeFailed++;
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "_SHMReceiveListener invalid shared segment");
+        _SHMLinkData_Destroy(&newLinkData);
+        return NULL;
+    }
+    _setRings(newLinkData, 1);
+
+    // Clone a new link from the current listener.
+    const char *derivedLinkName = _createNameFromLinkData(newLinkData, &handshake);
+    AthenaTransportLink *newTransportLink = athenaTransportLink_Clone(athenaTransportLink,
+                                                                      derivedLinkName,
+                                                                      _SHMSend,
+                                                                      _SHMReceive,
+                                                                      _SHMClose);
+    if (newTransportLink == NULL) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "athenaTransportLink_Clone failed");
+        parcMemory_Deallocate(&derivedLinkName);
+        _SHMLinkData_Destroy(&newLinkData);
+        return NULL;
+    }
+
+    _setConnectLinkState(newTransportLink, newLinkData);
+
+    // Send the new link up to be added.
+    result = athenaTransportLink_AddLink(athenaTransportLink, newTransportLink);
+    if (result == -1) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "athenaTransportLinkModule_AddLink failed: %s", strerror(errno));
+        _SHMLinkData_Destroy(&newLinkData);
+        athenaTransportLink_Release(&newTransportLink);
+    } else {
+        parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
+                     "new link accepted by %s: %s", athenaTransportLink_GetName(athenaTransportLink), derivedLinkName);
+        // Pick up anything queued before the link was added
+        if (!_ringIsEmpty(newLinkData->receiveRing)) {
+            athenaTransportLink_SetEvent(newTransportLink, AthenaTransportLinkEvent_Receive);
+        }
+    }
+
+    parcMemory_Deallocate(&derivedLinkName);
+
+    // Could pass a message back here regarding the new link.
+    return NULL;
+}
+
+static AthenaTransportLink *
+_SHMOpenListener(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpecificationParameters *parameters)
+{
+    _SHMLinkData *linkData = _SHMLinkData_Create();
+    linkData->channel = parcMemory_StringDuplicate(parameters->channel, strlen(parameters->channel));
+
+    struct sockaddr_un address;
+    socklen_t addressLength;
+    if (_channelAddress(linkData->channel, &address, &addressLength) == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Channel name too long (%s)", linkData->channel);
+        _SHMLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    linkData->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (linkData->fd < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "socket error (%s)", strerror(errno));
+        _SHMLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    // bind and listen on the channel
+    int result = bind(linkData->fd, (struct sockaddr *) &address, addressLength);
+    if (result) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "bind error (%s)", strerror(errno));
+        int bindError = errno;
+        _SHMLinkData_Destroy(&linkData);
+        errno = bindError;
+        return NULL;
+    }
+    result = listen(linkData->fd, _listenerBacklog);
+    if (result) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "listen error (%s)", strerror(errno));
+        _SHMLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    parameters->derivedLinkName = _createNameFromLinkData(linkData, NULL);
+
+    const char *linkName;
+    if (parameters->linkName == NULL) {
+        linkName = parameters->derivedLinkName;
+    } else {
+        linkName = parameters->linkName;
+    }
+
+    // Listener doesn't require a send method.  The receive method is used to establish new connections.
+    AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
+                                                                          NULL,
+                                                                          _SHMReceiveListener,
+                                                                          _SHMClose);
+    if (athenaTransportLink == NULL) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "athenaTransportLink_Create failed");
+        _SHMLinkData_Destroy(&linkData);
+        return athenaTransportLink;
+    }
+
+    athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
+    athenaTransportLink_SetPrivateData(athenaTransportLink, linkData);
+    athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+
+    // Links established for listening are not used to route messages.
+    // They can be kept in a listener list that doesn't consume a linkId.
+    athenaTransportLink_SetRoutable(athenaTransportLink, false);
+
+    parcLog_Info(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                 "new listener established: Name=\"%s\" (%s)", parameters->linkName, parameters->derivedLinkName);
+
+    return athenaTransportLink;
+}
+
+static AthenaTransportLink *
+_SHMOpen(AthenaTransportLinkModule *athenaTransportLinkModule, PARCURI *connectionURI)
+{
+    AthenaTransportLink *result = 0;
+
+    _URISpecificationParameters *parameters = _URISpecificationParameters_Create(athenaTransportLinkModule, connectionURI);
+    if (parameters == NULL) {
+        char *connectionURIstring = parcURI_ToString(connectionURI);
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unable to parse connection URI specification (%s)", connectionURIstring);
+        parcMemory_Deallocate(&connectionURIstring);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    if (parameters->listener) {
+        result = _SHMOpenListener(athenaTransportLinkModule, parameters);
+    } else {
+        result = _SHMOpenConnection(athenaTransportLinkModule, parameters);
+    }
+
+    // forced IsLocal/IsNotLocal, mainly for testing
+    if (result && parameters->forceLocal) {
+        athenaTransportLink_ForceLocal(result, parameters->forceLocal);
+    }
+
+    _URISpecificationParameters_Destroy(&parameters);
+
+    return result;
+}
+
+static int
+_SHMPoll(AthenaTransportLink *athenaTransportLink, int timeout)
+{
+    return 0;
+}
+
+//
+// This function must be named "athenaTransportLinkModule" <module name> "_Init" so that
+// athenaTransportLinkAdapter can locate it to invoke initialization when it's loaded.  It's
+// named uniquely (as opposed to _init()) so that it can also be statically linked into Athena.
+//
+PARCArrayList *
+athenaTransportLinkModuleSHM_Init()
+{
+    // Shared memory module for links to applications on the same host.
+    AthenaTransportLinkModule *athenaTransportLinkModule;
+    PARCArrayList *moduleList = parcArrayList_Create(NULL);
+    assertNotNull(moduleList, "parcArrayList_Create failed to create module list");
+
+    athenaTransportLinkModule = athenaTransportLinkModule_Create("SHM",
+                                                                 _SHMOpen,
+                                                                 _SHMPoll);
+    assertNotNull(athenaTransportLinkModule, "parcMemory_AllocateAndClear failed allocate SHM athenaTransportLinkModule");
+    bool result = parcArrayList_Add(moduleList, athenaTransportLinkModule);
+    assertTrue(result == true, "parcArrayList_Add failed");
+
+    return moduleList;
+}
+
+void
+athenaTransportLinkModuleSHM_Fini()
+{
+}
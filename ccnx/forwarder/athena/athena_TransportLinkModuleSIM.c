@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/param.h>
+
+#include <parc/algol/parc_Deque.h>
+#include <parc/algol/parc_URIAuthority.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkModuleSIM.h>
+
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+
+struct athena_sim_channel {
+    char *name;
+    AthenaTransportLink *end[2];
+    AthenaTransportLinkModuleSIM_TransmitCallback *transmit;
+    AthenaTransportLinkModuleSIM_TransmitCallbackContext transmitContext;
+    struct athena_sim_channel *next;
+};
+
+// Channels are shared by every link adapter in the process
+static pthread_mutex_t _channelListLock = PTHREAD_MUTEX_INITIALIZER;
+static AthenaSIMChannel *_channelList = NULL;
+
+//
+// Private data for each link instance
+//
+typedef struct _SIMLinkData {
+    PARCDeque *queue;
+    AthenaSIMChannel *channel;
+    int end;
+    struct {
+        size_t send_NoPeer;
+        size_t receive_DecodeFailed;
+    } _stats;
+} _SIMLinkData;
+
+static _SIMLinkData *
+_SIMLinkData_Create(AthenaSIMChannel *channel, int end)
+{
+    _SIMLinkData *linkData = parcMemory_AllocateAndClear(sizeof(_SIMLinkData));
+    assertNotNull(linkData, "Could not create private data for new link");
+
+    linkData->queue = parcDeque_Create();
+    linkData->channel = channel;
+    linkData->end = end;
+
+    return linkData;
+}
+
+static void
+_SIMLinkData_Destroy(_SIMLinkData **linkData)
+{
+    while (parcDeque_Size((*linkData)->queue) > 0) {
+        PARCBuffer *wireFormatBuffer = parcDeque_RemoveFirst((*linkData)->queue);
+        parcBuffer_Release(&wireFormatBuffer);
+    }
+    parcDeque_Release(&((*linkData)->queue));
+    parcMemory_Deallocate(linkData);
+}
+
+// Must be called with the channel list locked
+static AthenaSIMChannel *
+_lookupChannel(const char *channelName, bool create)
+{
+    AthenaSIMChannel *channel = _channelList;
+    while ((channel != NULL) && (strcmp(channel->name, channelName) != 0)) {
+        channel = channel->next;
+    }
+
+    if ((channel == NULL) && create) {
+        channel = parcMemory_AllocateAndClear(sizeof(AthenaSIMChannel));
+        assertNotNull(channel, "Could not allocate a new channel");
+        channel->name = parcMemory_StringDuplicate(channelName, strlen(channelName));
+        channel->next = _channelList;
+        _channelList = channel;
+    }
+    return channel;
+}
+
+// Must be called with the channel list locked
+static void
+_releaseChannelIfUnused(AthenaSIMChannel *channel)
+{
+    if ((channel->end[0] != NULL) || (channel->end[1] != NULL)) {
+        return;
+    }
+
+    AthenaSIMChannel **previous = &_channelList;
+    while (*previous != channel) {
+        previous = &(*previous)->next;
+    }
+    *previous = channel->next;
+
+    parcMemory_Deallocate(&channel->name);
+    parcMemory_Deallocate(&channel);
+}
+
+static const char *
+_createNameFromLinkData(const _SIMLinkData *linkData)
+{
+    char nameBuffer[MAXPATHLEN];
+    const char *protocol = "sim";
+
+    sprintf(nameBuffer, "%s://%s/%d", protocol, linkData->channel->name, linkData->end);
+
+    return parcMemory_StringDuplicate(nameBuffer, strlen(nameBuffer));
+}
+
+static bool
+_queueMessage(AthenaTransportLink *athenaTransportLink, PARCBuffer *wireFormatBuffer)
+{
+    _SIMLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    parcDeque_Append(linkData->queue, parcBuffer_Acquire(wireFormatBuffer));
+
+    // Flag there's a message to pickup
+    athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+    return true;
+}
+
+static int
+_SIMSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMessage)
+{
+    _SIMLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    AthenaSIMChannel *channel = linkData->channel;
+    int peer = linkData->end ^ 1;
+
+    // The message buffer can wrap memory owned by the message, or be shared with other links whose
+    // receivers rewrite it in place, so each end gets its own copy.
+    PARCBuffer *messageBuffer = athenaTransportLinkModule_CreateMessageBuffer(ccnxMetaMessage);
+    PARCBuffer *wireFormatBuffer = parcBuffer_Copy(messageBuffer);
+    parcBuffer_Release(&messageBuffer);
+
+    int result = 0;
+    if (channel->transmit) {
+        channel->transmit(channel->transmitContext, channel, peer, wireFormatBuffer);
+    } else if (channel->end[peer] != NULL) {
+        _queueMessage(channel->end[peer], wireFormatBuffer);
+    } else {
+        linkData->_stats.send_NoPeer++;
+        errno = ENOTCONN;
+        result = -1;
+    }
+
+    parcBuffer_Release(&wireFormatBuffer);
+    return result;
+}
+
+static CCNxMetaMessage *
+_SIMReceive(AthenaTransportLink *athenaTransportLink)
+{
+    _SIMLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    CCNxMetaMessage *ccnxMetaMessage = NULL;
+
+    if (parcDeque_Size(linkData->queue) == 0) {
+        return NULL;
+    }
+    PARCBuffer *wireFormatBuffer = parcDeque_RemoveFirst(linkData->queue);
+
+    // Construct, and return a ccnxMetaMessage from the wire format buffer.
+    ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+    if (ccnxMetaMessage == NULL) {
+        linkData->_stats.receive_DecodeFailed++;
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
+    }
+    parcBuffer_Release(&wireFormatBuffer);
+
+    if (parcDeque_Size(linkData->queue) > 0) { // if there's another message, mark an event.
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+    }
+    return ccnxMetaMessage;
+}
+
+static void
+_SIMClose(AthenaTransportLink *athenaTransportLink)
+{
+    parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
+                 "link %s closed", athenaTransportLink_GetName(athenaTransportLink));
+    _SIMLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    pthread_mutex_lock(&_channelListLock);
+    linkData->channel->end[linkData->end] = NULL;
+    _releaseChannelIfUnused(linkData->channel);
+    pthread_mutex_unlock(&_channelListLock);
+
+    _SIMLinkData_Destroy(&linkData);
+}
+
+#define LINK_NAME_SPECIFIER "name%3D"
+#define LOCAL_LINK_FLAG "local%3D"
+
+static int
+_parseLinkName(const char *token, char *name)
+{
+    if (sscanf(token, "%*[^%%]%%3D%s", name) != 1) {
+        return -1;
+    }
+    return 0;
+}
+
+static int
+_parseLocalFlag(const char *token)
+{
+    int forceLocal = 0;
+    char localFlag[MAXPATHLEN] = { 0 };
+    if (sscanf(token, "%*[^%%]%%3D%s", localFlag) != 1) {
+        return 0;
+    }
+    if (strncasecmp(localFlag, "false", strlen("false")) == 0) {
+        forceLocal = AthenaTransportLink_ForcedNonLocal;
+    } else if (strncasecmp(localFlag, "true", strlen("true")) == 0) {
+        forceLocal = AthenaTransportLink_ForcedLocal;
+    }
+    return forceLocal;
+}
+
+static AthenaTransportLink *
+_SIMOpen(AthenaTransportLinkModule *athenaTransportLinkModule, PARCURI *connectionURI)
+{
+    // The authority names the channel the link is one end of
+    const char *authorityString = parcURI_GetAuthority(connectionURI);
+    if ((authorityString == NULL) || (strlen(authorityString) == 0)) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unable to parse connection authority %s", authorityString);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    int forceLocal = 0;
+    char specifiedLinkName[MAXPATHLEN] = { 0 };
+    const char *linkName = NULL;
+
+    // Parse connection segment parameters, Name and Local
+    PARCURIPath *remainder = parcURI_GetPath(connectionURI);
+    size_t segments = parcURIPath_Count(remainder);
+    for (int i = 0; i < segments; i++) {
+        PARCURISegment *segment = parcURIPath_Get(remainder, i);
+        const char *token = parcURISegment_ToString(segment);
+
+        if (strncasecmp(token, LINK_NAME_SPECIFIER, strlen(LINK_NAME_SPECIFIER)) == 0) {
+            if (_parseLinkName(token, specifiedLinkName) != 0) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper connection name specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                errno = EINVAL;
+                return NULL;
+            }
+            linkName = specifiedLinkName;
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, LOCAL_LINK_FLAG, strlen(LOCAL_LINK_FLAG)) == 0) {
+            forceLocal = _parseLocalFlag(token);
+            if (forceLocal == 0) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper local specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unknown connection parameter (%s)", token);
+        parcMemory_Deallocate(&token);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    pthread_mutex_lock(&_channelListLock);
+    AthenaSIMChannel *channel = _lookupChannel(authorityString, true);
+    int end = (channel->end[0] == NULL) ? 0 : ((channel->end[1] == NULL) ? 1 : -1);
+    if (end == -1) {
+        pthread_mutex_unlock(&_channelListLock);
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Both ends of channel %s are already open", authorityString);
+        errno = EBUSY;
+        return NULL;
+    }
+
+    _SIMLinkData *linkData = _SIMLinkData_Create(channel, end);
+
+    const char *derivedLinkName = _createNameFromLinkData(linkData);
+
+    if (linkName == NULL) {
+        linkName = derivedLinkName;
+    }
+
+    AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
+                                                                          _SIMSend,
+                                                                          _SIMReceive,
+                                                                          _SIMClose);
+    if (athenaTransportLink == NULL) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "athenaTransportLink_Create failed");
+        _releaseChannelIfUnused(channel);
+        pthread_mutex_unlock(&_channelListLock);
+        parcMemory_Deallocate(&derivedLinkName);
+        _SIMLinkData_Destroy(&linkData);
+        return athenaTransportLink;
+    }
+    channel->end[end] = athenaTransportLink;
+    pthread_mutex_unlock(&_channelListLock);
+
+    athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
+    athenaTransportLink_SetPrivateData(athenaTransportLink, linkData);
+    athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+
+    parcLog_Info(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                 "new link established: Name=\"%s\" (%s)", linkName, derivedLinkName);
+
+    parcMemory_Deallocate(&derivedLinkName);
+
+    // forced IsLocal/IsNotLocal, mainly for testing
+    if (athenaTransportLink && forceLocal) {
+        athenaTransportLink_ForceLocal(athenaTransportLink, forceLocal);
+    }
+
+    return athenaTransportLink;
+}
+
+static int
+_SIMPoll(AthenaTransportLink *athenaTransportLink, int timeout)
+{
+    return 0;
+}
+
+void
+athenaTransportLinkModuleSIM_SetTransmitCallback(const char *channelName,
+                                                 AthenaTransportLinkModuleSIM_TransmitCallback *callback,
+                                                 AthenaTransportLinkModuleSIM_TransmitCallbackContext context)
+{
+    pthread_mutex_lock(&_channelListLock);
+    AthenaSIMChannel *channel = _lookupChannel(channelName, callback != NULL);
+    if (channel != NULL) {
+        channel->transmit = callback;
+        channel->transmitContext = context;
+        // A channel set up ahead of its ends is kept until they have been opened and closed again
+        if (callback == NULL) {
+            _releaseChannelIfUnused(channel);
+        }
+    }
+    pthread_mutex_unlock(&_channelListLock);
+}
+
+bool
+athenaTransportLinkModuleSIM_Deliver(AthenaSIMChannel *channel, int destination, PARCBuffer *wireFormatBuffer)
+{
+    assertTrue((destination == 0) || (destination == 1), "Channel end %d out of range", destination);
+    if (channel->end[destination] == NULL) {
+        return false;
+    }
+    return _queueMessage(channel->end[destination], wireFormatBuffer);
+}
+
+//
+// This function must be named "athenaTransportLinkModule" <module name> "_Init" so that
+// athenaTransportLinkAdapter can locate it to invoke initialization when it's loaded.  It's
+// named uniquely (as opposed to _init()) so that it can also be statically linked into Athena.
+//
+PARCArrayList *
+athenaTransportLinkModuleSIM_Init()
+{
+    AthenaTransportLinkModule *athenaTransportLinkModule;
+    PARCArrayList *moduleInstanceList = parcArrayList_Create(NULL);
+    assertNotNull(moduleInstanceList, "parcArrayList_Create failed to create module list");
+
+    athenaTransportLinkModule = athenaTransportLinkModule_Create("SIM",
+                                                                 _SIMOpen,
+                                                                 _SIMPoll);
+    assertNotNull(athenaTransportLinkModule, "parcMemory_AllocateAndClear failed allocate SIM athenaTransportLinkModule");
+    bool result = parcArrayList_Add(moduleInstanceList, athenaTransportLinkModule);
+    assertTrue(result == true, "parcArrayList_Add failed");
+
+    return moduleInstanceList;
+}
+
+void
+athenaTransportLinkModuleSIM_Fini()
+{
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libathena_TransportLinkModuleSIM_h
+#define libathena_TransportLinkModuleSIM_h
+
+#include <parc/algol/parc_ArrayList.h>
+#include <parc/algol/parc_Buffer.h>
+
+/*
+ * In-memory simulation (SIM) link module
+ *
+ * A link is opened with "sim://<channel>[/name=<linkName>][/local=<bool>]".  The first two links
+ * opened on the same channel, from the same or from different link adapters in the process, are
+ * the two ends of a point to point link.  A message sent on one end is queued on the other end as
+ * a copy of its wire format buffer, without passing through the kernel.
+ *
+ * A transmit callback can be registered on a channel to take over delivery, which is how a
+ * simulator imposes latency, bandwidth and loss on the link.  Messages are then handed to the
+ * callback rather than the peer, and the callback later calls athenaTransportLinkModuleSIM_Deliver
+ * for those that arrive.
+ *
+ * Channels are not locked against concurrent sends, all adapters sharing a channel must be driven
+ * from the same thread.
+ *
+ *    athenaTransportLinkModuleSIM_Init
+ *    athenaTransportLinkModuleSIM_Fini
+ *
+ *    athenaTransportLinkModuleSIM_SetTransmitCallback
+ *    athenaTransportLinkModuleSIM_Deliver
+ */
+
+/**
+ * @typedef AthenaSIMChannel
+ * @brief A pair of link ends sharing a channel name
+ */
+struct athena_sim_channel;
+typedef struct athena_sim_channel AthenaSIMChannel;
+
+/**
+ * @typedef AthenaTransportLinkModuleSIM_TransmitCallback
+ * @brief Called with each message sent on a channel that has a transmit callback
+ *
+ * The destination is the end the message is addressed to, 0 for the first link opened on the
+ * channel and 1 for the second.  The buffer is only valid for the duration of the call, it must be
+ * acquired to be delivered later.
+ */
+typedef void *AthenaTransportLinkModuleSIM_TransmitCallbackContext;
+typedef void (AthenaTransportLinkModuleSIM_TransmitCallback)(AthenaTransportLinkModuleSIM_TransmitCallbackContext context,
+                                                             AthenaSIMChannel *channel, int destination,
+                                                             PARCBuffer *wireFormatBuffer);
+
+/**
+ * @abstract initialize in-memory simulation (SIM) specific link module
+ * @discussion
+ *
+ * @return list of modules
+ *
+ * Example:
+ * @code
+ * {
+ *
+ * }
+ * @endcode
+ */
+PARCArrayList *athenaTransportLinkModuleSIM_Init();
+
+/**
+ * @abstract finalize in-memory simulation (SIM) specific link module
+ * @discussion
+ *
+ * Example:
+ * @code
+ * {
+ *
+ * }
+ * @endcode
+ */
+void athenaTransportLinkModuleSIM_Fini();
+
+/**
+ * @abstract take over delivery of the messages sent on a channel
+ * @discussion
+ *
+ * May be called before either end of the channel is opened.  Passing a NULL callback restores
+ * direct delivery to the peer.  The channel is released once both of its ends have been closed,
+ * and the callback along with it.
+ *
+ * @param [in] channelName name of the channel, the authority of the link URI
+ * @param [in] callback called with each message sent on the channel
+ * @param [in] context passed to the callback
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaTransportLinkModuleSIM_SetTransmitCallback("link1", _transmit, simulator);
+ *
+ *     PARCURI *connectionURI = parcURI_Parse("sim://link1/name=toNode2");
+ *     athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+ *     parcURI_Release(&connectionURI);
+ * }
+ * @endcode
+ */
+void athenaTransportLinkModuleSIM_SetTransmitCallback(const char *channelName,
+                                                      AthenaTransportLinkModuleSIM_TransmitCallback *callback,
+                                                      AthenaTransportLinkModuleSIM_TransmitCallbackContext context);
+
+/**
+ * @abstract deliver a message to one end of a channel
+ * @discussion
+ *
+ * The message is queued on the link and picked up by the next receive on its link adapter.  It is
+ * silently dropped if that end of the channel is not open.
+ *
+ * @param [in] channel channel passed to the transmit callback
+ * @param [in] destination end of the channel to deliver to, 0 or 1
+ * @param [in] wireFormatBuffer message to deliver, a reference is acquired
+ * @return true if the message was queued
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaTransportLinkModuleSIM_Deliver(channel, destination, wireFormatBuffer);
+ *     parcBuffer_Release(&wireFormatBuffer);
+ * }
+ * @endcode
+ */
+bool athenaTransportLinkModuleSIM_Deliver(AthenaSIMChannel *channel, int destination, PARCBuffer *wireFormatBuffer);
+
+#endif // libathena_TransportLinkModuleSIM_h
@@ -70,7 +70,9 @@
 #include <arpa/inet.h>
 
 #include <parc/algol/parc_Network.h>
+#include <parc/algol/parc_Deque.h>
 #include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
+#include <ccnx/forwarder/athena/athena_IOUring.h>
 
 #include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
 #include <ccnx/common/ccnx_WireFormatMessage.h>
@@ -80,6 +82,9 @@ static int _listenerBacklog = 16;
 #define TCP_SCHEME "tcp"
 #define TCP6_SCHEME "tcp6"
 
+#define _TCP_RING_BUFFERS 32
+#define _TCP_RING_BUFFER_SIZE (1024 * 16)
+
 //
 // Platform support required for managing SIGPIPE.
 //
@@ -102,6 +107,12 @@ typedef struct _TCPLinkData {
     int fd;
     struct sockaddr_storage myAddress;
     struct sockaddr_storage peerAddress;
+    bool ioUring; // a listener creates a ring for each connection it accepts
+    AthenaIOUring *ring;
+    PARCDeque *queue; // messages received on the ring
+    uint8_t *partial; // received stream not yet framed into a message
+    size_t partialLength;
+    size_t partialSize;
     struct {
         size_t receive_ReadHeaderFailure;
         size_t receive_BadMessageLength;
@@ -128,6 +139,19 @@ _TCPLinkData_Create()
 static void
 _TCPLinkData_Destroy(_TCPLinkData **linkData)
 {
+    if ((*linkData)->ring) {
+        athenaIOUring_Release(&((*linkData)->ring));
+    }
+    if ((*linkData)->queue) {
+        while (parcDeque_Size((*linkData)->queue) > 0) {
+            CCNxMetaMessage *ccnxMetaMessage = parcDeque_RemoveFirst((*linkData)->queue);
+            ccnxMetaMessage_Release(&ccnxMetaMessage);
+        }
+        parcDeque_Release(&((*linkData)->queue));
+    }
+    if ((*linkData)->partial) {
+        parcMemory_Deallocate(&((*linkData)->partial));
+    }
     parcMemory_Deallocate(linkData);
 }
 
@@ -224,9 +248,46 @@ _writeLink(AthenaTransportLink *athenaTransportLink, void *buffer, size_t length
     return count;
 }
 
+//
+// Queue a message on the link's ring, it's issued when the module is next polled.  Whole messages are
+// queued, so a send that can't be queued is dropped without breaking the stream's framing.
+//
+static int
+_TCPSendRing(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMessage, PARCBuffer *wireFormatBuffer)
+{
+    struct _TCPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    // The send completes after the message may have been released.  A buffer wrapped around the
+    // message's single encoded io vector doesn't keep its memory alive, so the ring is given a copy.
+    PARCBuffer *buffer;
+    if ((ccnxWireFormatMessage_GetWireFormatBuffer(ccnxMetaMessage) == NULL) &&
+        (ccnxCodecNetworkBufferIoVec_GetCount(ccnxWireFormatMessage_GetIoVec(ccnxMetaMessage)) == 1)) {
+        buffer = parcBuffer_Copy(wireFormatBuffer);
+    } else {
+        buffer = parcBuffer_Acquire(wireFormatBuffer);
+    }
+
+    int result = athenaIOUring_Send(linkData->ring, buffer, NULL, 0);
+    if (result == -1) {
+        if (errno == ENOBUFS) {
+            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "send retry (%s)", strerror(errno));
+            linkData->_stats.send_Retry++;
+        } else {
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+            linkData->_stats.send_Error++;
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                          "send error, closing link (%s)", strerror(errno));
+        }
+    }
+    parcBuffer_Release(&buffer);
+    return result;
+}
+
 static int
 _TCPSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMessage)
 {
+    struct _TCPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
     if (ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage) == CCNxTlvDictionary_SchemaVersion_V0) {
         parcLog_Warning(athenaTransportLink_GetLogger(athenaTransportLink),
                         "sending deprecated version %d message\n", ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage));
@@ -242,6 +303,13 @@ _TCPSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMess
     parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
                   "sending message (size=%d)", length);
 
+    if (linkData->ring) {
+        parcBuffer_SetPosition(wireFormatBuffer, 0);
+        int result = _TCPSendRing(athenaTransportLink, ccnxMetaMessage, wireFormatBuffer);
+        parcBuffer_Release(&wireFormatBuffer);
+        return result;
+    }
+
     int writeCount = 0;
     // If a short write, attempt to write the remainder of the message
     while (writeCount < length) {
@@ -425,11 +493,7 @@ _TCPReceive(AthenaTransportLink *athenaTransportLink)
     parcBuffer_Flip(wireFormatBuffer);
 
     // Construct, and return a ccnxMetaMessage from the wire format buffer.
-    ccnxMetaMessage = ccnxMetaMessage_CreateFromWireFormatBuffer(wireFormatBuffer);
-    if (ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage) == CCNxTlvDictionary_SchemaVersion_V0) {
-        parcLog_Warning(athenaTransportLink_GetLogger(athenaTransportLink),
-                        "received deprecated version %d message\n", ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage));
-    }
+    ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
     if (ccnxMetaMessage == NULL) {
         linkData->_stats.receive_DecodeFailed++;
         parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
@@ -439,12 +503,160 @@ _TCPReceive(AthenaTransportLink *athenaTransportLink)
     return ccnxMetaMessage;
 }
 
+//
+// Append a received chunk of the stream to the data not yet framed into a message.
+//
+static void
+_appendPartial(_TCPLinkData *linkData, const uint8_t *data, size_t length)
+{
+    if ((linkData->partialLength + length) > linkData->partialSize) {
+        size_t newSize = (linkData->partialSize * 2) + length;
+        uint8_t *newPartial = parcMemory_Allocate(newSize);
+        assertNotNull(newPartial, "parcMemory_Allocate failed to allocate %zu bytes", newSize);
+        if (linkData->partial) {
+            memcpy(newPartial, linkData->partial, linkData->partialLength);
+            parcMemory_Deallocate(&linkData->partial);
+        }
+        linkData->partial = newPartial;
+        linkData->partialSize = newSize;
+    }
+    memcpy(&linkData->partial[linkData->partialLength], data, length);
+    linkData->partialLength += length;
+}
+
+//
+// Called by athenaIOUring_Reap with each chunk of the stream received on a link's ring.  Complete
+// messages are framed, decoded and queued for the link's receive method.
+//
+static void
+_TCPRingReceiveCallback(void *context, const uint8_t *data, size_t length,
+                        const struct sockaddr *peerAddress, socklen_t peerAddressLength, int error)
+{
+    AthenaTransportLink *athenaTransportLink = (AthenaTransportLink *) context;
+    struct _TCPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    // Nothing more is framed once the link is closing
+    if (athenaTransportLink_GetEvent(athenaTransportLink) & AthenaTransportLinkEvent_Error) {
+        return;
+    }
+
+    if (error) {
+        linkData->_stats.receive_ReadError++;
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "read error (%s)", strerror(error));
+        return;
+    }
+
+    // Our peer has hungup
+    if (length == 0) {
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+        return;
+    }
+
+    _appendPartial(linkData, data, length);
+
+    size_t fixedHeaderLength = ccnxCodecTlvPacket_MinimalHeaderLength();
+    size_t offset = 0;
+    while ((linkData->partialLength - offset) >= fixedHeaderLength) {
+        PARCBuffer *header = parcBuffer_Wrap(&linkData->partial[offset], fixedHeaderLength, 0, fixedHeaderLength);
+        size_t messageLength = ccnxCodecTlvPacket_GetPacketLength(header);
+        parcBuffer_Release(&header);
+
+        // There's no resynchronizing a stream once its framing is lost
+        if (messageLength < fixedHeaderLength) {
+            linkData->_stats.receive_BadMessageLength++;
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                          "Framing error, length less than required header (%zu < %zu), closing link.",
+                          messageLength, fixedHeaderLength);
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+            linkData->partialLength = 0;
+            return;
+        }
+        if ((linkData->partialLength - offset) < messageLength) {
+            break;
+        }
+
+        PARCBuffer *wireFormatBuffer = parcBuffer_Allocate(messageLength);
+        parcBuffer_PutArray(wireFormatBuffer, messageLength, &linkData->partial[offset]);
+        parcBuffer_Flip(wireFormatBuffer);
+        offset += messageLength;
+
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "received message (size=%zu)", messageLength);
+        CCNxMetaMessage *ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+        parcBuffer_Release(&wireFormatBuffer);
+        if (ccnxMetaMessage == NULL) {
+            linkData->_stats.receive_DecodeFailed++;
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
+            continue;
+        }
+        parcDeque_Append(linkData->queue, ccnxMetaMessage);
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+    }
+
+    // Keep the start of the next message
+    if (offset) {
+        memmove(linkData->partial, &linkData->partial[offset], linkData->partialLength - offset);
+        linkData->partialLength -= offset;
+    }
+}
+
+//
+// Reap the completions of a link's ring and return a message it received.
+//
+static CCNxMetaMessage *
+_TCPReceiveRing(AthenaTransportLink *athenaTransportLink)
+{
+    struct _TCPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    CCNxMetaMessage *ccnxMetaMessage = NULL;
+
+    athenaIOUring_Reap(linkData->ring);
+    if (parcDeque_Size(linkData->queue) > 0) {
+        ccnxMetaMessage = parcDeque_RemoveFirst(linkData->queue);
+        if (parcDeque_Size(linkData->queue) > 0) { // if there's another message, post an event.
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+        }
+    }
+    return ccnxMetaMessage;
+}
+
+//
+// Create an io_uring engine for a connection's socket.  If io_uring isn't available the link polls its socket.
+//
+static void
+_TCPRingCreate(PARCLog *logger, _TCPLinkData *linkData)
+{
+    linkData->ring = athenaIOUring_Create(linkData->fd, true, _TCP_RING_BUFFERS, _TCP_RING_BUFFER_SIZE);
+    if (linkData->ring == NULL) {
+        parcLog_Info(logger, "io_uring unavailable (%s), using poll", strerror(errno));
+        return;
+    }
+    linkData->queue = parcDeque_Create();
+    assertNotNull(linkData->queue, "Could not create data queue for new link");
+}
+
+//
+// Begin receiving on a connection's ring.  A link that can't receive is closed by the adapter.
+//
+static void
+_TCPRingReceive(AthenaTransportLink *athenaTransportLink, _TCPLinkData *linkData)
+{
+    athenaTransportLink_SetEventFd(athenaTransportLink, athenaIOUring_GetEventFd(linkData->ring));
+    if (athenaIOUring_Receive(linkData->ring, _TCPRingReceiveCallback, athenaTransportLink) == -1) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "Unable to receive on io_uring, closing link (%s)", strerror(errno));
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+    }
+}
+
 static void
 _TCPClose(AthenaTransportLink *athenaTransportLink)
 {
     parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
                  "link %s closed", athenaTransportLink_GetName(athenaTransportLink));
     _TCPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    if (linkData->ring) {
+        athenaIOUring_StopReceive(linkData->ring);
+    }
     close(linkData->fd);
     _TCPLinkData_Destroy(&linkData);
 }
@@ -456,6 +668,7 @@ _setConnectLinkState(AthenaTransportLink *athenaTransportLink, _TCPLinkData *lin
 
     // Register file descriptor to be polled.  This must be set before adding the link (case ???).
     athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+    athenaTransportLink_SetSendPollable(athenaTransportLink, true);
 
     // Determine and flag the link cost for forwarding messages.
     // Messages without sufficient hop count collateral will be dropped.
@@ -501,6 +714,7 @@ _setSocketOptions(AthenaTransportLinkModule *athenaTransportLinkModule, int fd)
 #define TCP_LISTENER_FLAG "listener"
 #define LINK_NAME_SPECIFIER "name%3D"
 #define LOCAL_LINK_FLAG "local%3D"
+#define IO_ENGINE "io%3D"
 
 static struct sockaddr_storage *
 _getSockaddr(const char *moduleName, const char *hostname, in_port_t port)
@@ -552,6 +766,7 @@ typedef struct _URISpecificationParameters {
     struct sockaddr_storage *destination;
     bool listener;
     int forceLocal;
+    bool ioUring;
 } _URISpecificationParameters;
 
 static void
@@ -657,6 +872,31 @@ _URISpecificationParameters_Create(AthenaTransportLinkModule *athenaTransportLin
             continue;
         }
 
+        if (strncasecmp(token, IO_ENGINE, strlen(IO_ENGINE)) == 0) {
+            char ioEngine[MAXPATHLEN] = { 0 };
+            if (sscanf(token, "%*[^%%]%%3D%s", ioEngine) != 1) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper io engine specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            } else if (strcasecmp(ioEngine, "uring") == 0) {
+                parameters->ioUring = true;
+            } else if (strcasecmp(ioEngine, "poll") == 0) {
+                parameters->ioUring = false;
+            } else {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Unknown io engine (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
         parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
                       "Unknown connection parameter (%s)", token);
         _URISpecificationParameters_Destroy(&parameters);
@@ -706,6 +946,14 @@ _TCPOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpe
         return NULL;
     }
 
+    AthenaTransportLink_ReceiveMethod *receiveMethod = _TCPReceive;
+    if (parameters->ioUring) {
+        _TCPRingCreate(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), linkData);
+        if (linkData->ring) {
+            receiveMethod = _TCPReceiveRing;
+        }
+    }
+
     parameters->derivedLinkName = _createNameFromLinkData(linkData);
 
     const char *linkName;
@@ -717,7 +965,7 @@ _TCPOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpe
 
     AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
                                                                           _TCPSend,
-                                                                          _TCPReceive,
+                                                                          receiveMethod,
                                                                           _TCPClose);
     if (athenaTransportLink == NULL) {
         parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
@@ -728,6 +976,9 @@ _TCPOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpe
 
     athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
     _setConnectLinkState(athenaTransportLink, linkData);
+    if (linkData->ring) {
+        _TCPRingReceive(athenaTransportLink, linkData);
+    }
 
     parcLog_Info(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
                  "new link established: Name=\"%s\" (%s)", parameters->linkName, parameters->derivedLinkName);
@@ -754,12 +1005,20 @@ _TCPReceiveListener(AthenaTransportLink *athenaTransportLink)
     // Get the bound local hostname and port.  The listening address may have been wildcarded.
     getsockname(newLinkData->fd, (struct sockaddr *) &newLinkData->myAddress, &addressLength);
 
+    AthenaTransportLink_ReceiveMethod *receiveMethod = _TCPReceive;
+    if (listenerData->ioUring) {
+        _TCPRingCreate(athenaTransportLink_GetLogger(athenaTransportLink), newLinkData);
+        if (newLinkData->ring) {
+            receiveMethod = _TCPReceiveRing;
+        }
+    }
+
     // Clone a new link from the current listener.
     const char *derivedLinkName = _createNameFromLinkData(newLinkData);
     AthenaTransportLink *newTransportLink = athenaTransportLink_Clone(athenaTransportLink,
                                                                       derivedLinkName,
                                                                       _TCPSend,
-                                                                      _TCPReceive,
+                                                                      receiveMethod,
                                                                       _TCPClose);
     if (newTransportLink == NULL) {
         parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
@@ -770,6 +1029,9 @@ _TCPReceiveListener(AthenaTransportLink *athenaTransportLink)
     }
 
     _setConnectLinkState(newTransportLink, newLinkData);
+    if (newLinkData->ring) {
+        _TCPRingReceive(newTransportLink, newLinkData);
+    }
 
     // Send the new link up to be added.
     int result = athenaTransportLink_AddLink(athenaTransportLink, newTransportLink);
@@ -798,6 +1060,7 @@ _TCPOpenListener(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpeci
     _TCPLinkData *linkData = _TCPLinkData_Create();
 
     linkData->myAddress = *(struct sockaddr_storage *)parameters->destination;
+    linkData->ioUring = parameters->ioUring;
 
     linkData->fd = socket(parameters->destination->ss_family, SOCK_STREAM, 0);
     if (linkData->fd < 0) {
@@ -921,6 +1184,13 @@ _TCPOpen(AthenaTransportLinkModule *athenaTransportLinkModule, PARCURI *connecti
 static int
 _TCPPoll(AthenaTransportLink *athenaTransportLink, int timeout)
 {
+    struct _TCPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    // Hand the sends queued since the last poll to the kernel as one batch
+    if (linkData->ring) {
+        athenaIOUring_Submit(linkData->ring);
+        return (int) parcDeque_Size(linkData->queue);
+    }
     return 0;
 }
 
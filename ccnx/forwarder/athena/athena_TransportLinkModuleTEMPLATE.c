@@ -175,7 +175,7 @@ _TemplateReceive(AthenaTransportLink *athenaTransportLink)
     }
 
     // Construct, and return a ccnxMetaMessage from the wire format buffer.
-    ccnxMetaMessage = ccnxMetaMessage_CreateFromWireFormatBuffer(wireFormatBuffer);
+    ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
     if (ccnxMetaMessage == NULL) {
         linkData->_stats.receive_DecodeFailed++;
         parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
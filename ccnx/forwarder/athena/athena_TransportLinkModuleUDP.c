@@ -66,17 +66,21 @@
 #include <netdb.h>
 #include <sys/param.h>
 #include <arpa/inet.h>
+#include <netinet/udp.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <time.h>
+#include <pthread.h>
 
 #include <parc/algol/parc_Network.h>
 #include <parc/algol/parc_Deque.h>
-#include <parc/algol/parc_HashCodeTable.h>
 #include <parc/algol/parc_Hash.h>
 #include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
 #include <ccnx/forwarder/athena/athena_Fragmenter.h>
+#include <ccnx/forwarder/athena/athena_IOUring.h>
 
 #include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
 
 #define UDP_SCHEME "udp"
 #define UDP6_SCHEME "udp6"
@@ -105,6 +109,33 @@ typedef struct _connectionPair {
     size_t mtu;
 } _connectionPair;
 
+//
+// A listener's peers, keyed on their full address.  Open addressing with linear probing, entries are
+// removed by shifting the rest of their probe sequence back so that no tombstones are left behind.
+//
+typedef struct _UDPPeerKey {
+    sa_family_t family;
+    in_port_t port;
+    uint32_t scopeId;
+    uint8_t address[16];
+} _UDPPeerKey;
+
+typedef struct _UDPPeerEntry {
+    _UDPPeerKey key;
+    AthenaTransportLink *athenaTransportLink; // NULL if the slot is empty
+    bool active; // received from since the last idle sweep
+} _UDPPeerEntry;
+
+typedef struct _UDPPeerTable {
+    _UDPPeerEntry *entries;
+    size_t capacity; // always a power of two
+    size_t count;
+} _UDPPeerTable;
+
+#define _UDP_PEER_TABLE_INITIAL_CAPACITY 64
+
+struct _UDPReceiveWorker;
+
 //
 // Private data for each link instance
 //
@@ -112,7 +143,21 @@ typedef struct _UDPLinkData {
     int fd;
     _connectionPair link;
     PARCDeque *queue;
-    PARCHashCodeTable *multiplexTable;
+    _UDPPeerTable *peerTable; // peers of a listener, or of one of its receive workers
+    _UDPPeerTable *listenerPeerTable; // the table a link created by a listener is registered in
+    time_t idleTimeout; // seconds without receiving before a listener's peer link is closed, 0 for never
+    time_t nextIdleSweep;
+    bool receiveFailed; // set on a read error, whoever is receiving on the link then closes it
+    struct _UDPReceiveWorker *workers;
+    size_t workerCount;
+    int workerHandoffFd;
+    int workerStopFd[2];
+    AthenaIOUring *ring; // io_uring engine, shared by a listener with the links it creates
+    bool segmentOffload; // fragment trains are sent as one segmented datagram (UDP_SEGMENT)
+    bool receiveOffload; // datagrams from a peer may arrive coalesced in one read (UDP_GRO)
+    uint8_t *train; // fragments being gathered for a segmented send
+    PARCDeque *coalesced; // messages split out of a coalesced read, still to be returned
+    struct sockaddr_storage coalescedPeerAddress;
     struct {
         size_t receive_ReadHeaderFailure;
         size_t receive_BadMessageLength;
@@ -121,20 +166,210 @@ typedef struct _UDPLinkData {
         size_t receive_ReadWouldBlock;
         size_t receive_ShortRead;
         size_t receive_DecodeFailed;
+        size_t receive_HandoffDropped;
         size_t send_ShortWrite;
         size_t send_SendRetry;
+        size_t send_SegmentOffloadFailed;
     } _stats;
     AthenaFragmenter *fragmenter;
 } _UDPLinkData;
 
+//
+// A listener opened with more than one socket receives on a group of SO_REUSEPORT sockets bound to the
+// same address, each serviced by its own worker thread.  The kernel steers each peer to one socket of the
+// group, so every worker keeps its own demux table.  Workers reassemble and decode messages in parallel
+// and hand them to the forwarder through a pipe, which is the listener's event fd.  New links
+// are created, and messages queued on them, by the forwarder when it reads the handoff.
+//
+typedef struct _UDPReceiveWorker {
+    _UDPLinkData *linkData; // socket, demux table and fragmenter for this worker
+    AthenaTransportLink *athenaTransportLink; // unregistered stand in for the listener, with the worker's own logger
+    size_t index;
+    int handoffFd;
+    int stopFd;
+    pthread_t thread;
+    bool started;
+} _UDPReceiveWorker;
+
+// Written atomically to the handoff pipe, it must be no larger than PIPE_BUF
+typedef struct _UDPReceiveHandoff {
+    CCNxMetaMessage *ccnxMetaMessage; // NULL if the worker stopped on a receive error
+    size_t worker;
+    struct sockaddr_storage peerAddress;
+} _UDPReceiveHandoff;
+
+#define _UDP_MAX_LISTENER_SOCKETS 64
+#define _UDP_HANDOFF_PIPE_SIZE (1024 * 1024)
+
 #define _UDP_DEFAULT_MTU_SIZE (1024 * 64)
 
+#define _UDP_RING_BUFFERS 64
+
+// Limits of a segmented send, the kernel refuses larger trains
+#define _UDP_TRAIN_MAX_SEGMENTS 64
+#define _UDP_TRAIN_MAX_BYTES 65507
+
+static time_t
+_monotonicSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec;
+}
+
+static void
+_UDPPeerKey_FromAddress(const struct sockaddr_storage *address, _UDPPeerKey *key)
+{
+    memset(key, 0, sizeof(_UDPPeerKey)); // keys are compared whole
+    key->family = address->ss_family;
+    if (address->ss_family == AF_INET) {
+        const struct sockaddr_in *address4 = (const struct sockaddr_in *) address;
+        key->port = address4->sin_port;
+        memcpy(key->address, &address4->sin_addr, sizeof(address4->sin_addr));
+    } else if (address->ss_family == AF_INET6) {
+        const struct sockaddr_in6 *address6 = (const struct sockaddr_in6 *) address;
+        key->port = address6->sin6_port;
+        key->scopeId = address6->sin6_scope_id;
+        memcpy(key->address, &address6->sin6_addr, sizeof(address6->sin6_addr));
+    } else {
+        assertTrue(0, "Unsupported address family %d\n", address->ss_family);
+    }
+}
+
+static size_t
+_UDPPeerTable_Slot(const _UDPPeerTable *peerTable, const _UDPPeerKey *key)
+{
+    return (size_t) parcHash64_Data(key, sizeof(_UDPPeerKey)) & (peerTable->capacity - 1);
+}
+
+static _UDPPeerTable *
+_UDPPeerTable_Create(size_t capacity)
+{
+    _UDPPeerTable *peerTable = parcMemory_AllocateAndClear(sizeof(_UDPPeerTable));
+    assertNotNull(peerTable, "parcMemory_AllocateAndClear failed to allocate peer table");
+    peerTable->capacity = capacity;
+    peerTable->entries = parcMemory_AllocateAndClear(sizeof(_UDPPeerEntry) * capacity);
+    assertNotNull(peerTable->entries, "parcMemory_AllocateAndClear failed to allocate %zu peer entries", capacity);
+    return peerTable;
+}
+
+static _UDPPeerEntry *
+_UDPPeerTable_Lookup(const _UDPPeerTable *peerTable, const _UDPPeerKey *key)
+{
+    size_t mask = peerTable->capacity - 1;
+    for (size_t slot = _UDPPeerTable_Slot(peerTable, key); peerTable->entries[slot].athenaTransportLink; slot = (slot + 1) & mask) {
+        if (memcmp(&peerTable->entries[slot].key, key, sizeof(_UDPPeerKey)) == 0) {
+            return &peerTable->entries[slot];
+        }
+    }
+    return NULL;
+}
+
+static _UDPPeerEntry *
+_UDPPeerTable_Place(_UDPPeerTable *peerTable, const _UDPPeerKey *key, AthenaTransportLink *athenaTransportLink)
+{
+    size_t mask = peerTable->capacity - 1;
+    size_t slot = _UDPPeerTable_Slot(peerTable, key);
+    while (peerTable->entries[slot].athenaTransportLink) {
+        slot = (slot + 1) & mask;
+    }
+    peerTable->entries[slot].key = *key;
+    peerTable->entries[slot].athenaTransportLink = athenaTransportLink;
+    peerTable->entries[slot].active = true;
+    peerTable->count++;
+    return &peerTable->entries[slot];
+}
+
+//
+// Add a peer that is not already in the table.  The table is kept at most half full.
+//
+static _UDPPeerEntry *
+_UDPPeerTable_Insert(_UDPPeerTable *peerTable, const _UDPPeerKey *key, AthenaTransportLink *athenaTransportLink)
+{
+    if ((peerTable->count + 1) * 2 > peerTable->capacity) {
+        _UDPPeerEntry *entries = peerTable->entries;
+        size_t capacity = peerTable->capacity;
+
+        peerTable->capacity = capacity * 2;
+        peerTable->entries = parcMemory_AllocateAndClear(sizeof(_UDPPeerEntry) * peerTable->capacity);
+        assertNotNull(peerTable->entries, "parcMemory_AllocateAndClear failed to allocate %zu peer entries", peerTable->capacity);
+        peerTable->count = 0;
+        for (size_t i = 0; i < capacity; i++) {
+            if (entries[i].athenaTransportLink) {
+                _UDPPeerEntry *entry = _UDPPeerTable_Place(peerTable, &entries[i].key, entries[i].athenaTransportLink);
+                entry->active = entries[i].active;
+            }
+        }
+        parcMemory_Deallocate(&entries);
+    }
+    return _UDPPeerTable_Place(peerTable, key, athenaTransportLink);
+}
+
+static bool
+_UDPPeerTable_Remove(_UDPPeerTable *peerTable, const _UDPPeerKey *key)
+{
+    _UDPPeerEntry *entry = _UDPPeerTable_Lookup(peerTable, key);
+    if (entry == NULL) {
+        return false;
+    }
+
+    // Shift back any following entries that would no longer be reachable across the emptied slot
+    size_t mask = peerTable->capacity - 1;
+    size_t empty = entry - peerTable->entries;
+    for (size_t slot = (empty + 1) & mask; peerTable->entries[slot].athenaTransportLink; slot = (slot + 1) & mask) {
+        size_t home = _UDPPeerTable_Slot(peerTable, &peerTable->entries[slot].key);
+        if (((slot - home) & mask) >= ((slot - empty) & mask)) {
+            peerTable->entries[empty] = peerTable->entries[slot];
+            empty = slot;
+        }
+    }
+    memset(&peerTable->entries[empty], 0, sizeof(_UDPPeerEntry));
+    peerTable->count--;
+    return true;
+}
+
+static void
+_UDPPeerTable_CloseLinks(_UDPPeerTable *peerTable, bool idleOnly)
+{
+    // Closing a link removes it from the table, so collect them first
+    AthenaTransportLink **closeList = parcMemory_AllocateAndClear(sizeof(AthenaTransportLink *) * (peerTable->count + 1));
+    assertNotNull(closeList, "parcMemory_AllocateAndClear failed to allocate close list");
+    size_t closeCount = 0;
+    for (size_t slot = 0; slot < peerTable->capacity; slot++) {
+        _UDPPeerEntry *entry = &peerTable->entries[slot];
+        if (entry->athenaTransportLink) {
+            if ((idleOnly == false) || (entry->active == false)) {
+                closeList[closeCount++] = entry->athenaTransportLink;
+            }
+            entry->active = false;
+        }
+    }
+    for (size_t i = 0; i < closeCount; i++) {
+        parcLog_Info(athenaTransportLink_GetLogger(closeList[i]), "closing %s link %s",
+                     idleOnly ? "idle" : "listener", athenaTransportLink_GetName(closeList[i]));
+        athenaTransportLink_Close(closeList[i]);
+    }
+    parcMemory_Deallocate(&closeList);
+}
+
+static void
+_UDPPeerTable_Destroy(_UDPPeerTable **peerTable)
+{
+    _UDPPeerTable_CloseLinks(*peerTable, false);
+    parcMemory_Deallocate(&((*peerTable)->entries));
+    parcMemory_Deallocate(peerTable);
+}
+
 static _UDPLinkData *
 _UDPLinkData_Create()
 {
     _UDPLinkData *linkData = parcMemory_AllocateAndClear(sizeof(_UDPLinkData));
     assertNotNull(linkData, "Could not create private data for new link");
     linkData->link.mtu = _UDP_DEFAULT_MTU_SIZE;
+    linkData->fd = -1;
+    linkData->workerHandoffFd = -1;
+    linkData->workerStopFd[0] = -1;
+    linkData->workerStopFd[1] = -1;
     return linkData;
 }
 
@@ -149,12 +384,25 @@ _UDPLinkData_Destroy(_UDPLinkData **linkData)
         }
         parcDeque_Release(&((*linkData)->queue));
     }
-    if ((*linkData)->multiplexTable) {
-        parcHashCodeTable_Destroy(&((*linkData)->multiplexTable));
+    if ((*linkData)->peerTable) {
+        _UDPPeerTable_Destroy(&((*linkData)->peerTable));
     }
     if ((*linkData)->fragmenter) {
         athenaFragmenter_Release(&((*linkData)->fragmenter));
     }
+    if ((*linkData)->ring) {
+        athenaIOUring_Release(&((*linkData)->ring));
+    }
+    if ((*linkData)->coalesced) {
+        while (parcDeque_Size((*linkData)->coalesced) > 0) {
+            CCNxMetaMessage *ccnxMetaMessage = parcDeque_RemoveFirst((*linkData)->coalesced);
+            ccnxMetaMessage_Release(&ccnxMetaMessage);
+        }
+        parcDeque_Release(&((*linkData)->coalesced));
+    }
+    if ((*linkData)->train) {
+        parcMemory_Deallocate(&((*linkData)->train));
+    }
     parcMemory_Deallocate(linkData);
 }
 
@@ -237,6 +485,35 @@ _encodingBufferIOVecToPARCBuffer(CCNxCodecEncodingBufferIOVec *encodingBufferIOV
     return buffer;
 }
 
+//
+// Account for the result of writing length bytes, returning -1 if the send failed.
+//
+static int
+_sendResult(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData, ssize_t writeCount, size_t length)
+{
+    // on error close the link, else return to retry a zero write
+    if (writeCount == -1) {
+        if ((errno == EAGAIN) || (errno == EINTR)) {
+            linkData->_stats.send_SendRetry++;
+            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "send retry (%s)", strerror(errno));
+        } else {
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                          "send error (%s)", strerror(errno));
+        }
+        return -1;
+    }
+
+    // Short write
+    if (writeCount != length) {
+        linkData->_stats.send_ShortWrite++;
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "short write");
+        return -1;
+    }
+
+    return 0;
+}
+
 static int
 _sendBuffer(AthenaTransportLink *athenaTransportLink, PARCBuffer *wireFormatBuffer)
 {
@@ -247,6 +524,23 @@ _sendBuffer(AthenaTransportLink *athenaTransportLink, PARCBuffer *wireFormatBuff
     parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
                   "sending message (size=%d)", length);
 
+    // Queue the send on the ring, it's issued when the module is next polled
+    if (linkData->ring) {
+        if (athenaIOUring_Send(linkData->ring, wireFormatBuffer, (struct sockaddr *) &linkData->link.peerAddress,
+                               SOCKADDR_IN_LEN(&linkData->link.peerAddress)) == -1) {
+            if (errno == ENOBUFS) {
+                linkData->_stats.send_SendRetry++;
+                parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "send retry (%s)", strerror(errno));
+            } else {
+                athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+                parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                              "send error (%s)", strerror(errno));
+            }
+            return -1;
+        }
+        return 0;
+    }
+
     ssize_t writeCount = 0;
 #ifdef LINUX_IGNORESIGPIPE
     writeCount = sendto(linkData->fd, buffer, length, MSG_NOSIGNAL,
@@ -256,28 +550,115 @@ _sendBuffer(AthenaTransportLink *athenaTransportLink, PARCBuffer *wireFormatBuff
                         (struct sockaddr *)&linkData->link.peerAddress, SOCKADDR_IN_LEN(&linkData->link.peerAddress));
 #endif
 
-    // on error close the link, else return to retry a zero write
-    if (writeCount == -1) {
-        if ((errno == EAGAIN) || (errno == EINTR)) {
-            linkData->_stats.send_SendRetry++;
-            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "send retry (%s)", strerror(errno));
-        } else {
-            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
-            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
-                          "send error (%s)", strerror(errno));
+    return _sendResult(athenaTransportLink, linkData, writeCount, length);
+}
+
+#ifdef UDP_SEGMENT
+//
+// Send a train of equal sized segments, of which only the last may be shorter, in one call which the
+// kernel splits into a datagram per segment.  If the device can't segment the train it's sent a
+// datagram at a time, and the link stops using segmentation offload.
+//
+static int
+_sendSegments(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData,
+              uint8_t *train, size_t length, size_t segmentSize)
+{
+    struct iovec iov = { .iov_base = train, .iov_len = length };
+    struct msghdr message = {
+        .msg_name = &linkData->link.peerAddress,
+        .msg_namelen = SOCKADDR_IN_LEN(&linkData->link.peerAddress),
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+    };
+    union {
+        char buffer[CMSG_SPACE(sizeof(uint16_t))];
+        struct cmsghdr align;
+    } control;
+
+    if (length > segmentSize) {
+        memset(&control, 0, sizeof(control));
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level = IPPROTO_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        *((uint16_t *) CMSG_DATA(cmsg)) = (uint16_t) segmentSize;
+    }
+
+    parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
+                  "sending fragment train (size=%zu, segment=%zu)", length, segmentSize);
+    ssize_t writeCount = sendmsg(linkData->fd, &message, MSG_NOSIGNAL);
+
+    if ((writeCount == -1) && (errno == EIO) && message.msg_control) {
+        linkData->_stats.send_SegmentOffloadFailed++;
+        linkData->segmentOffload = false;
+        parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
+                     "segmentation offload failed (%s), sending fragments individually", strerror(errno));
+        for (size_t offset = 0; offset < length; offset += segmentSize) {
+            if (_sendSegments(athenaTransportLink, linkData, train + offset, MIN(segmentSize, length - offset), segmentSize) == -1) {
+                return -1;
+            }
         }
-        return -1;
+        return 0;
     }
 
-    // Short write
-    if (writeCount != length) {
-        linkData->_stats.send_ShortWrite++;
-        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "short write");
-        return -1;
+    return _sendResult(athenaTransportLink, linkData, writeCount, length);
+}
+
+//
+// Fragment a message, gathering its fragments into trains that are each sent with a single segmented send.
+//
+static int
+_UDPSendFragmentTrains(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData, PARCBuffer *wireFormatBuffer)
+{
+    if (linkData->train == NULL) {
+        linkData->train = parcMemory_Allocate(_UDP_TRAIN_MAX_BYTES);
+        assertNotNull(linkData->train, "parcMemory_Allocate failed to allocate %d byte fragment train", _UDP_TRAIN_MAX_BYTES);
+    }
+
+    size_t trainLength = 0;
+    size_t segmentSize = 0;
+    size_t segments = 0;
+    int fragmentNumber = 0;
+    CCNxCodecEncodingBufferIOVec *ioFragment;
+
+    while ((ioFragment = athenaFragmenter_CreateFragment(linkData->fragmenter, wireFormatBuffer,
+                                                         linkData->link.mtu, fragmentNumber++))) {
+        size_t length = 0;
+        for (int i = 0; i < ioFragment->iovcnt; i++) {
+            length += ioFragment->iov[i].iov_len;
+        }
+
+        // Send the train we have if it's full, or if this fragment can't follow its segments.
+        // Only a train's last segment may be shorter than its first.
+        if (segments && ((length > segmentSize) || (trainLength % segmentSize) ||
+                         (segments == _UDP_TRAIN_MAX_SEGMENTS) || ((trainLength + length) > _UDP_TRAIN_MAX_BYTES))) {
+            if (_sendSegments(athenaTransportLink, linkData, linkData->train, trainLength, segmentSize) == -1) {
+                ccnxCodecEncodingBufferIOVec_Release(&ioFragment);
+                return -1;
+            }
+            trainLength = 0;
+            segments = 0;
+        }
+        if (segments == 0) {
+            segmentSize = length;
+        }
+
+        for (int i = 0; i < ioFragment->iovcnt; i++) {
+            memcpy(linkData->train + trainLength, ioFragment->iov[i].iov_base, ioFragment->iov[i].iov_len);
+            trainLength += ioFragment->iov[i].iov_len;
+        }
+        segments++;
+        ccnxCodecEncodingBufferIOVec_Release(&ioFragment);
     }
 
+    if (segments) {
+        return _sendSegments(athenaTransportLink, linkData, linkData->train, trainLength, segmentSize);
+    }
     return 0;
 }
+#endif // UDP_SEGMENT
 
 static int
 _UDPSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMessage)
@@ -291,6 +672,15 @@ _UDPSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMess
 
     // Get a wire format buffer and write it out.
     PARCBuffer *wireFormatBuffer = athenaTransportLinkModule_CreateMessageBuffer(ccnxMetaMessage);
+
+    // A ring send completes after the message may have been released.  A buffer wrapped around the
+    // message's single encoded io vector doesn't keep its memory alive, so the ring is given a copy.
+    if (linkData->ring && (ccnxWireFormatMessage_GetWireFormatBuffer(ccnxMetaMessage) == NULL) &&
+        (ccnxCodecNetworkBufferIoVec_GetCount(ccnxWireFormatMessage_GetIoVec(ccnxMetaMessage)) == 1)) {
+        PARCBuffer *ownedBuffer = parcBuffer_Copy(wireFormatBuffer);
+        parcBuffer_Release(&wireFormatBuffer);
+        wireFormatBuffer = ownedBuffer;
+    }
     parcBuffer_SetPosition(wireFormatBuffer, 0);
     size_t messageLength = parcBuffer_Limit(wireFormatBuffer);
     PARCBuffer *buffer = NULL;
@@ -298,6 +688,16 @@ _UDPSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMess
     int fragmentNumber = 0;
     CCNxCodecEncodingBufferIOVec *ioFragment = NULL;
 
+#ifdef UDP_SEGMENT
+    // Where the link negotiated segmentation offload, fragments go out in trains rather than one at a time
+    if ((messageLength > linkData->link.mtu) && linkData->fragmenter && linkData->segmentOffload &&
+        (linkData->link.mtu <= _UDP_TRAIN_MAX_BYTES)) {
+        _UDPSendFragmentTrains(athenaTransportLink, linkData, wireFormatBuffer);
+        parcBuffer_Release(&wireFormatBuffer);
+        return 0;
+    }
+#endif
+
     // Get initial IO vector message or message fragment if we need, and have, fragmentation support.
     if (messageLength <= linkData->link.mtu) {
         buffer = parcBuffer_Acquire(wireFormatBuffer);
@@ -342,12 +742,26 @@ _UDPSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMess
     return 0;
 }
 
+static void _UDPReceiveWorkers_Destroy(_UDPLinkData *linkData);
+
 static void
 _UDPClose(AthenaTransportLink *athenaTransportLink)
 {
     parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
                  "link %s closed", athenaTransportLink_GetName(athenaTransportLink));
     _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    if (linkData->listenerPeerTable) {
+        _UDPPeerKey key;
+        _UDPPeerKey_FromAddress(&linkData->link.peerAddress, &key);
+        _UDPPeerTable_Remove(linkData->listenerPeerTable, &key);
+    }
+    if (linkData->workers) {
+        _UDPReceiveWorkers_Destroy(linkData);
+    }
+    // Links created by a listener only send on its ring, the listener stops the receive
+    if (linkData->ring && (linkData->listenerPeerTable == NULL)) {
+        athenaIOUring_StopReceive(linkData->ring);
+    }
     close(linkData->fd);
     _UDPLinkData_Destroy(&linkData);
 }
@@ -376,6 +790,7 @@ _setConnectLinkState(AthenaTransportLink *athenaTransportLink, _UDPLinkData *lin
 
     // Register file descriptor to be polled.  This must be set before adding the link (case ???).
     athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+    athenaTransportLink_SetSendPollable(athenaTransportLink, true);
 
     // Determine and flag the link cost for forwarding messages.
     // Messages without sufficient hop count collateral will be dropped.
@@ -395,9 +810,8 @@ _setConnectLinkState(AthenaTransportLink *athenaTransportLink, _UDPLinkData *lin
 }
 
 static AthenaTransportLink *
-_cloneNewLink(AthenaTransportLink *athenaTransportLink, struct sockaddr_storage *peerAddress)
+_cloneNewLink(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData, struct sockaddr_storage *peerAddress)
 {
-    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
     _UDPLinkData *newLinkData = _UDPLinkData_Create();
 
     // Use the same fragmentation as our parent
@@ -410,11 +824,15 @@ _cloneNewLink(AthenaTransportLink *athenaTransportLink, struct sockaddr_storage
         }
     }
 
-    // Propagate our parents MTU
+    // Propagate our parents MTU, and whether its socket takes segmented sends
     newLinkData->link.mtu = linkData->link.mtu;
+    newLinkData->segmentOffload = linkData->segmentOffload;
 
-    // We use our parents fd to send, and receive demux'd messages from our parent on our queue
+    // We use our parents fd, or ring, to send, and receive demux'd messages from our parent on our queue
     newLinkData->fd = dup(linkData->fd);
+    if (linkData->ring) {
+        newLinkData->ring = athenaIOUring_Acquire(linkData->ring);
+    }
     newLinkData->queue = parcDeque_Create();
     assertNotNull(newLinkData->queue, "Could not create data queue for new link");
 
@@ -439,13 +857,21 @@ _cloneNewLink(AthenaTransportLink *athenaTransportLink, struct sockaddr_storage
 
     _setConnectLinkState(newTransportLink, newLinkData);
 
+    // Completions on a shared ring are reaped by the listener, there's nothing for us to poll
+    if (newLinkData->ring) {
+        athenaTransportLink_SetEventFd(newTransportLink, -1);
+    }
+
     // Send the new link up to be added.
     int result = athenaTransportLink_AddLink(athenaTransportLink, newTransportLink);
     if (result == -1) {
         parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
                       "athenaTransportLink_AddLink failed: %s", strerror(errno));
+        close(newLinkData->fd);
         _UDPLinkData_Destroy(&newLinkData);
         athenaTransportLink_Release(&newTransportLink);
+        parcMemory_Deallocate(&derivedLinkName);
+        return NULL;
     } else {
         parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
                      "new link accepted by %s: %s %s",
@@ -470,49 +896,39 @@ _queueMessage(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMet
     athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
 }
 
-static unsigned long
-_hashAddress(struct sockaddr_storage *address)
-{
-    if (address->ss_family == AF_INET) {
-        return ((unsigned long) ((struct sockaddr_in *)address)->sin_addr.s_addr << 32) |
-                                ((struct sockaddr_in *)address)->sin_port;
-    } else if (address->ss_family == AF_INET6) {
-        uint64_t sin6addrHash = parcHash64_Data(&((struct sockaddr_in6 *)address)->sin6_addr.s6_addr, 16);
-        return parcHash64_Data_Cumulative(&((struct sockaddr_in6 *)address)->sin6_port, sizeof(in_port_t), sin6addrHash);
-    } else {
-        assertTrue(0, "Unsupported address family %d\n", address->ss_family);
-    }
-    return 0;
-}
-
+//
+// Deliver a message to the link for its peer, linkData is that of the socket the message arrived on.
+//
 static void
-_demuxDelivery(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMessage, struct sockaddr_storage *peerAddress)
+_demuxDelivery(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData,
+               CCNxMetaMessage *ccnxMetaMessage, struct sockaddr_storage *peerAddress)
 {
-    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    _UDPPeerKey key;
+    _UDPPeerKey_FromAddress(peerAddress, &key);
 
-    AthenaTransportLink *demuxLink = parcHashCodeTable_Get(linkData->multiplexTable, (void *) _hashAddress(peerAddress));
+    _UDPPeerEntry *entry = _UDPPeerTable_Lookup(linkData->peerTable, &key);
 
     // If it's an unknown peer, try to create a new link
-    if (demuxLink == NULL) {
-        demuxLink = _cloneNewLink(athenaTransportLink, peerAddress);
-        if (demuxLink) {
-            parcHashCodeTable_Add(linkData->multiplexTable, (void *) _hashAddress(peerAddress), demuxLink);
-        }
-    }
+    if (entry == NULL) {
+        AthenaTransportLink *demuxLink = _cloneNewLink(athenaTransportLink, linkData, peerAddress);
 
-    // If there's no existing link and a new one can't be created, drop the message
-    if (demuxLink == NULL) {
-        ccnxMetaMessage_Release(&ccnxMetaMessage);
-        return;
+        // If there's no existing link and a new one can't be created, drop the message
+        if (demuxLink == NULL) {
+            ccnxMetaMessage_Release(&ccnxMetaMessage);
+            return;
+        }
+        entry = _UDPPeerTable_Insert(linkData->peerTable, &key, demuxLink);
+        struct _UDPLinkData *demuxLinkData = athenaTransportLink_GetPrivateData(demuxLink);
+        demuxLinkData->listenerPeerTable = linkData->peerTable;
     }
 
-    _queueMessage(demuxLink, ccnxMetaMessage);
+    entry->active = true;
+    _queueMessage(entry->athenaTransportLink, ccnxMetaMessage);
 }
 
 static void
-_flushLink(AthenaTransportLink *athenaTransportLink)
+_flushLink(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData)
 {
-    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
     char trash[MAXPATHLEN];
 
     // Flush link to attempt to resync our framing
@@ -525,9 +941,8 @@ _flushLink(AthenaTransportLink *athenaTransportLink)
 // Peek at the header and derive our total message length
 //
 static size_t
-_messageLengthFromHeader(AthenaTransportLink *athenaTransportLink)
+_messageLengthFromHeader(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData)
 {
-    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
 
     // Peek at our message header to determine the total length of buffer we need to allocate.
     size_t fixedHeaderLength = ccnxCodecTlvPacket_MinimalHeaderLength();
@@ -544,7 +959,7 @@ _messageLengthFromHeader(AthenaTransportLink *athenaTransportLink)
         } else {
             linkData->_stats.receive_ReadError++;
             parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "recv error (%s)", strerror(errno));
-            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+            linkData->receiveFailed = true;
         }
         return -1;
     }
@@ -573,7 +988,7 @@ _messageLengthFromHeader(AthenaTransportLink *athenaTransportLink)
         parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
                       "Framing error, length less than required header (%zu < %zu), flushing.",
                       messageLength, fixedHeaderLength);
-        _flushLink(athenaTransportLink);
+        _flushLink(athenaTransportLink, linkData);
         return -1;
     }
 
@@ -581,69 +996,12 @@ _messageLengthFromHeader(AthenaTransportLink *athenaTransportLink)
 }
 
 //
-// Receive a message from the specified link.
+// Reassemble a received packet into an undecoded message, the wire format buffer is consumed.
 //
 static CCNxMetaMessage *
-_UDPReceiveMessage(AthenaTransportLink *athenaTransportLink, struct sockaddr_storage *peerAddress)
+_UDPDecodeMessage(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData, PARCBuffer *wireFormatBuffer)
 {
-    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
     CCNxMetaMessage *ccnxMetaMessage = NULL;
-    size_t messageLength;
-
-    // If an MTU has been set, allocate a buffer of that size to avoid having to peek at the message,
-    // othersize derive the link from the header and allocate a buffer based on the message size.
-
-    if (linkData->link.mtu != 0) {
-        messageLength = linkData->link.mtu;
-    } else {
-        messageLength = _messageLengthFromHeader(athenaTransportLink);
-        if (messageLength <= 0) {
-            return NULL;
-        }
-    }
-
-    PARCBuffer *wireFormatBuffer = parcBuffer_Allocate(messageLength);
-
-    char *buffer = parcBuffer_Overlay(wireFormatBuffer, 0);
-    socklen_t peerAddressLength = sizeof(struct sockaddr_storage);
-    ssize_t readCount = recvfrom(linkData->fd, buffer, messageLength, 0, (struct sockaddr *) peerAddress, &peerAddressLength);
-    // Reset to the real expected message length from the header if we didn't already obtain it
-    if (linkData->link.mtu != 0) {
-        messageLength = ccnxCodecTlvPacket_GetPacketLength(wireFormatBuffer);
-    }
-
-    // On error mark the link to close or retry.
-    if (readCount == -1) {
-        parcBuffer_Release(&wireFormatBuffer);
-        if ((errno == EAGAIN) || (errno == EINTR)) {
-            linkData->_stats.receive_ReadRetry++;
-            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "recv retry (%s)", strerror(errno));
-        } else {
-            linkData->_stats.receive_ReadError++;
-            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
-            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "read error (%s)", strerror(errno));
-        }
-        return NULL;
-    }
-
-    // A zero read means either no more data is currently available or our peer hungup.
-    // Just return to retry as we'll detect EOF when we come back at the top of UDPReceive
-    if (readCount == 0) {
-        parcBuffer_Release(&wireFormatBuffer);
-        return NULL;
-    }
-
-    // If it was it a short read just return to retry later.
-    while (readCount < messageLength) {
-        linkData->_stats.receive_ShortRead++;
-        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "short read error (%s)", strerror(errno));
-        parcBuffer_Release(&wireFormatBuffer);
-        return NULL;
-    }
-
-    parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "received message (size=%d)", readCount);
-    parcBuffer_SetPosition(wireFormatBuffer, parcBuffer_Position(wireFormatBuffer) + readCount);
-    parcBuffer_Flip(wireFormatBuffer);
 
     // If it's not a fragment returns our passed in wireFormatBuffer, otherwise it owns the buffer and eventually
     // passes back the aggregated message after receiving all its fragments, returning NULL in the mean time.
@@ -651,13 +1009,10 @@ _UDPReceiveMessage(AthenaTransportLink *athenaTransportLink, struct sockaddr_sto
 
     if (wireFormatBuffer != NULL) {
         // Construct, and return a ccnxMetaMessage from the wire format buffer.
-        ccnxMetaMessage = ccnxMetaMessage_CreateFromWireFormatBuffer(wireFormatBuffer);
+        ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
         if (ccnxMetaMessage == NULL) {
             linkData->_stats.receive_DecodeFailed++;
             parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
-        } else if (ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage) == CCNxTlvDictionary_SchemaVersion_V0) {
-            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
-                          "received deprecated version %d message\n", ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage));
         }
         parcBuffer_Release(&wireFormatBuffer);
     }
@@ -666,26 +1021,358 @@ _UDPReceiveMessage(AthenaTransportLink *athenaTransportLink, struct sockaddr_sto
 }
 
 //
-// Receive a message from a point to point UDP tunnel.
+// Copy out, reassemble and decode a datagram received into memory the caller retains.
 //
 static CCNxMetaMessage *
-_UDPReceive(AthenaTransportLink *athenaTransportLink)
+_UDPDecodeDatagram(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData, const uint8_t *data, size_t length)
 {
-    struct sockaddr_storage peerAddress; // Unused
-    CCNxMetaMessage *ccnxMetaMessage = _UDPReceiveMessage(athenaTransportLink, &peerAddress);
-    return ccnxMetaMessage;
-}
+    if (length < ccnxCodecTlvPacket_MinimalHeaderLength()) {
+        linkData->_stats.receive_ReadHeaderFailure++;
+        return NULL;
+    }
 
-//
-// Receive and queue a message from a UDP listener.
-//
-static CCNxMetaMessage *
+    PARCBuffer *wireFormatBuffer = parcBuffer_Allocate(length);
+    parcBuffer_PutArray(wireFormatBuffer, length, data);
+    parcBuffer_Flip(wireFormatBuffer);
+
+    if (length < ccnxCodecTlvPacket_GetPacketLength(wireFormatBuffer)) {
+        linkData->_stats.receive_ShortRead++;
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "short read error");
+        parcBuffer_Release(&wireFormatBuffer);
+        return NULL;
+    }
+    parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "received message (size=%zu)", length);
+
+    return _UDPDecodeMessage(athenaTransportLink, linkData, wireFormatBuffer);
+}
+
+//
+// Receive from a link's socket.  If the kernel coalesced a run of datagrams from one peer into the read
+// (UDP_GRO), segmentSize is set to the size of each but the last, otherwise it's left at 0.
+//
+static ssize_t
+_receiveDatagrams(_UDPLinkData *linkData, char *buffer, size_t length, struct sockaddr_storage *peerAddress, size_t *segmentSize)
+{
+    struct iovec iov = { .iov_base = buffer, .iov_len = length };
+    struct msghdr message = {
+        .msg_name = peerAddress,
+        .msg_namelen = sizeof(struct sockaddr_storage),
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+    };
+    union {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+
+    if (linkData->receiveOffload) {
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+    }
+
+    ssize_t readCount = recvmsg(linkData->fd, &message, 0);
+
+#ifdef UDP_GRO
+    if ((readCount > 0) && message.msg_controllen) {
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            if ((cmsg->cmsg_level == IPPROTO_UDP) && (cmsg->cmsg_type == UDP_GRO)) {
+                int coalescedSize;
+                memcpy(&coalescedSize, CMSG_DATA(cmsg), sizeof(coalescedSize));
+                *segmentSize = (size_t) coalescedSize;
+            }
+        }
+    }
+#endif
+    return readCount;
+}
+
+//
+// Split a coalesced read back into its datagrams, queueing the messages they complete to be returned
+// by subsequent receives.
+//
+static void
+_UDPSplitCoalesced(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData,
+                   const uint8_t *data, size_t length, size_t segmentSize, struct sockaddr_storage *peerAddress)
+{
+    if (linkData->coalesced == NULL) {
+        linkData->coalesced = parcDeque_Create();
+        assertNotNull(linkData->coalesced, "Could not create coalesced message queue");
+    }
+    memcpy(&linkData->coalescedPeerAddress, peerAddress, sizeof(struct sockaddr_storage));
+
+    for (size_t offset = 0; offset < length; offset += segmentSize) {
+        CCNxMetaMessage *ccnxMetaMessage = _UDPDecodeDatagram(athenaTransportLink, linkData, data + offset,
+                                                              MIN(segmentSize, length - offset));
+        if (ccnxMetaMessage) {
+            parcDeque_Append(linkData->coalesced, ccnxMetaMessage);
+        }
+    }
+}
+
+static size_t
+_UDPCoalescedPending(_UDPLinkData *linkData)
+{
+    return linkData->coalesced ? parcDeque_Size(linkData->coalesced) : 0;
+}
+
+//
+// Receive a message from the socket of the specified link data, on behalf of athenaTransportLink.
+// A read error sets linkData->receiveFailed.
+//
+static CCNxMetaMessage *
+_UDPReceiveMessage(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData, struct sockaddr_storage *peerAddress)
+{
+    size_t messageLength;
+
+    // Messages split out of an earlier coalesced read are returned before reading again
+    if (_UDPCoalescedPending(linkData)) {
+        memcpy(peerAddress, &linkData->coalescedPeerAddress, sizeof(struct sockaddr_storage));
+        return parcDeque_RemoveFirst(linkData->coalesced);
+    }
+
+    // If an MTU has been set, allocate a buffer of that size to avoid having to peek at the message,
+    // othersize derive the link from the header and allocate a buffer based on the message size.
+    // A coalesced read can be as large as the largest datagram, whatever our MTU.
+
+    if (linkData->receiveOffload) {
+        messageLength = _UDP_DEFAULT_MTU_SIZE;
+    } else if (linkData->link.mtu != 0) {
+        messageLength = linkData->link.mtu;
+    } else {
+        messageLength = _messageLengthFromHeader(athenaTransportLink, linkData);
+        if (messageLength <= 0) {
+            return NULL;
+        }
+    }
+
+    PARCBuffer *wireFormatBuffer = parcBuffer_Allocate(messageLength);
+
+    char *buffer = parcBuffer_Overlay(wireFormatBuffer, 0);
+    size_t segmentSize = 0;
+    ssize_t readCount = _receiveDatagrams(linkData, buffer, messageLength, peerAddress, &segmentSize);
+    // Reset to the real expected message length from the header if we didn't already obtain it
+    if ((linkData->link.mtu != 0) || linkData->receiveOffload) {
+        messageLength = ccnxCodecTlvPacket_GetPacketLength(wireFormatBuffer);
+    }
+
+    // On error mark the link to close or retry.
+    if (readCount == -1) {
+        parcBuffer_Release(&wireFormatBuffer);
+        if ((errno == EAGAIN) || (errno == EINTR)) {
+            linkData->_stats.receive_ReadRetry++;
+            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "recv retry (%s)", strerror(errno));
+        } else {
+            linkData->_stats.receive_ReadError++;
+            linkData->receiveFailed = true;
+            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "read error (%s)", strerror(errno));
+        }
+        return NULL;
+    }
+
+    // A zero read means either no more data is currently available or our peer hungup.
+    // Just return to retry as we'll detect EOF when we come back at the top of UDPReceive
+    if (readCount == 0) {
+        parcBuffer_Release(&wireFormatBuffer);
+        return NULL;
+    }
+
+    if (segmentSize && (readCount > segmentSize)) {
+        _UDPSplitCoalesced(athenaTransportLink, linkData, (uint8_t *) buffer, readCount, segmentSize, peerAddress);
+        parcBuffer_Release(&wireFormatBuffer);
+        return _UDPCoalescedPending(linkData) ? parcDeque_RemoveFirst(linkData->coalesced) : NULL;
+    }
+
+    // If it was it a short read just return to retry later.
+    while (readCount < messageLength) {
+        linkData->_stats.receive_ShortRead++;
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "short read error (%s)", strerror(errno));
+        parcBuffer_Release(&wireFormatBuffer);
+        return NULL;
+    }
+
+    parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "received message (size=%d)", readCount);
+    parcBuffer_SetPosition(wireFormatBuffer, parcBuffer_Position(wireFormatBuffer) + readCount);
+    parcBuffer_Flip(wireFormatBuffer);
+
+    return _UDPDecodeMessage(athenaTransportLink, linkData, wireFormatBuffer);
+}
+
+//
+// Receive a message from a point to point UDP tunnel.
+//
+static CCNxMetaMessage *
+_UDPReceive(AthenaTransportLink *athenaTransportLink)
+{
+    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    struct sockaddr_storage peerAddress; // Unused
+    CCNxMetaMessage *ccnxMetaMessage = _UDPReceiveMessage(athenaTransportLink, linkData, &peerAddress);
+    if (_UDPCoalescedPending(linkData)) { // return the rest of a coalesced read before polling again
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+    }
+    if (linkData->receiveFailed) {
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+    }
+    return ccnxMetaMessage;
+}
+
+//
+// Receive and queue a message from a UDP listener.
+//
+static CCNxMetaMessage *
 _UDPReceiveListener(AthenaTransportLink *athenaTransportLink)
 {
+    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
     struct sockaddr_storage peerAddress;
-    CCNxMetaMessage *ccnxMetaMessage = _UDPReceiveMessage(athenaTransportLink, &peerAddress);
+    CCNxMetaMessage *ccnxMetaMessage = _UDPReceiveMessage(athenaTransportLink, linkData, &peerAddress);
     if (ccnxMetaMessage) {
-        _demuxDelivery(athenaTransportLink, ccnxMetaMessage, &peerAddress);
+        _demuxDelivery(athenaTransportLink, linkData, ccnxMetaMessage, &peerAddress);
+    }
+    if (_UDPCoalescedPending(linkData)) { // deliver the rest of a coalesced read before polling again
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Receive);
+    }
+    if (linkData->receiveFailed) {
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+    }
+    return NULL;
+}
+
+//
+// Receive and queue a message handed off by one of a listener's receive workers.
+//
+static CCNxMetaMessage *
+_UDPReceiveListenerHandoff(AthenaTransportLink *athenaTransportLink)
+{
+    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    _UDPReceiveHandoff handoff;
+
+    ssize_t readCount = read(linkData->fd, &handoff, sizeof(handoff));
+    if (readCount != sizeof(handoff)) {
+        return NULL;
+    }
+
+    _UDPReceiveWorker *worker = &linkData->workers[handoff.worker];
+    if (handoff.ccnxMetaMessage == NULL) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "receive worker %zu stopped on a read error, closing listener", handoff.worker);
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+        return NULL;
+    }
+
+    _demuxDelivery(athenaTransportLink, worker->linkData, handoff.ccnxMetaMessage, &handoff.peerAddress);
+    return NULL;
+}
+
+//
+// Called by athenaIOUring_Reap with each datagram received on a link's ring.  A listener demuxes the
+// message to the link for its peer, a point to point link queues it for itself.
+//
+static void
+_UDPRingReceiveCallback(void *context, const uint8_t *data, size_t length,
+                        const struct sockaddr *peerAddress, socklen_t peerAddressLength, int error)
+{
+    AthenaTransportLink *athenaTransportLink = (AthenaTransportLink *) context;
+    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    if (error) {
+        linkData->_stats.receive_ReadError++;
+        linkData->receiveFailed = true;
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "read error (%s)", strerror(error));
+        return;
+    }
+
+    CCNxMetaMessage *ccnxMetaMessage = _UDPDecodeDatagram(athenaTransportLink, linkData, data, length);
+    if (ccnxMetaMessage == NULL) {
+        return;
+    }
+
+    if (linkData->peerTable) {
+        struct sockaddr_storage peerStorage;
+        memcpy(&peerStorage, peerAddress, peerAddressLength);
+        _demuxDelivery(athenaTransportLink, linkData, ccnxMetaMessage, &peerStorage);
+    } else {
+        _queueMessage(athenaTransportLink, ccnxMetaMessage);
+    }
+}
+
+//
+// Reap the completions of a point to point link's ring and return a message it received.
+//
+static CCNxMetaMessage *
+_UDPReceiveRing(AthenaTransportLink *athenaTransportLink)
+{
+    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    athenaIOUring_Reap(linkData->ring);
+    if (linkData->receiveFailed) {
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+    }
+    return _UDPReceiveProxy(athenaTransportLink);
+}
+
+//
+// Reap the completions of a listener's ring, queueing received messages on the links of their peers.
+//
+static CCNxMetaMessage *
+_UDPReceiveListenerRing(AthenaTransportLink *athenaTransportLink)
+{
+    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    athenaIOUring_Reap(linkData->ring);
+    if (linkData->receiveFailed) {
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+    }
+    return NULL;
+}
+
+static void *
+_UDPReceiveWorker_Run(void *arg)
+{
+    _UDPReceiveWorker *worker = (_UDPReceiveWorker *) arg;
+    _UDPLinkData *linkData = worker->linkData;
+    struct pollfd pollfds[2] = {
+        { .fd = linkData->fd,     .events = POLLIN },
+        { .fd = worker->stopFd, .events = POLLIN },
+    };
+
+    while (true) {
+        // The rest of a coalesced read is handed off before waiting on the socket again
+        if (_UDPCoalescedPending(linkData) == 0) {
+            int result = poll(pollfds, 2, -1);
+            if (result == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                linkData->receiveFailed = true;
+            } else if (pollfds[1].revents) { // the listener is closing
+                break;
+            } else if (pollfds[0].revents == 0) {
+                continue;
+            }
+        }
+
+        _UDPReceiveHandoff handoff = { .worker = worker->index };
+        if (linkData->receiveFailed == false) {
+            handoff.ccnxMetaMessage = _UDPReceiveMessage(worker->athenaTransportLink, linkData, &handoff.peerAddress);
+
+            // Decode here, in parallel with the other workers, rather than on the forwarder thread
+            if (handoff.ccnxMetaMessage && (athenaTransportLinkModule_DecodeMessage(handoff.ccnxMetaMessage) == false)) {
+                linkData->_stats.receive_DecodeFailed++;
+                parcLog_Error(athenaTransportLink_GetLogger(worker->athenaTransportLink), "Failed to decode message from received packet.");
+                ccnxMetaMessage_Release(&handoff.ccnxMetaMessage);
+            }
+        }
+        if ((handoff.ccnxMetaMessage == NULL) && (linkData->receiveFailed == false)) {
+            continue;
+        }
+
+        // If the forwarder has fallen behind drop the message, as the socket would have.
+        if (write(worker->handoffFd, &handoff, sizeof(handoff)) != sizeof(handoff)) {
+            linkData->_stats.receive_HandoffDropped++;
+            if (handoff.ccnxMetaMessage) {
+                ccnxMetaMessage_Release(&handoff.ccnxMetaMessage);
+            }
+        }
+        if (linkData->receiveFailed) {
+            break;
+        }
     }
     return NULL;
 }
@@ -705,17 +1392,58 @@ _setSocketOptions(AthenaTransportLinkModule *athenaTransportLinkModule, int fd)
     return 0;
 }
 
+//
+// Negotiate segmentation offload on a link's socket.  Whichever direction the kernel doesn't support is
+// left off, and the link sends or receives a datagram per call in that direction.
+//
+static void
+_UDPOffloadNegotiate(AthenaTransportLinkModule *athenaTransportLinkModule, _UDPLinkData *linkData)
+{
+#ifdef UDP_SEGMENT
+    // Segment sizes are given per send, a zero socket default only probes for support
+    int segmentSize = 0;
+    linkData->segmentOffload = (setsockopt(linkData->fd, IPPROTO_UDP, UDP_SEGMENT, &segmentSize, sizeof(segmentSize)) == 0);
+#endif
+#ifdef UDP_GRO
+    int on = 1;
+    linkData->receiveOffload = (setsockopt(linkData->fd, IPPROTO_UDP, UDP_GRO, &on, sizeof(on)) == 0);
+#endif
+    parcLog_Debug(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                  "segmentation offload: send %s, receive %s",
+                  linkData->segmentOffload ? "on" : "off", linkData->receiveOffload ? "on" : "off");
+}
+
 typedef struct _URISpecificationParameters {
     char *linkName;
     const char *derivedLinkName;
     struct sockaddr_storage *source;
     struct sockaddr_storage *destination;
     bool listener;
+    size_t sockets;
+    size_t idleTimeout;
     size_t mtu;
     int forceLocal;
     char *fragmenterName;
+    bool ioUring;
+    bool offload;
 } _URISpecificationParameters;
 
+//
+// Create an io_uring engine for a link's socket.  Returns NULL if io_uring isn't available, in which
+// case the link polls its socket.
+//
+static AthenaIOUring *
+_UDPRingCreate(AthenaTransportLinkModule *athenaTransportLinkModule, _UDPLinkData *linkData)
+{
+    size_t bufferSize = linkData->link.mtu ? linkData->link.mtu : _UDP_DEFAULT_MTU_SIZE;
+    AthenaIOUring *ring = athenaIOUring_Create(linkData->fd, false, _UDP_RING_BUFFERS, bufferSize);
+    if (ring == NULL) {
+        parcLog_Info(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                     "io_uring unavailable (%s), using poll", strerror(errno));
+    }
+    return ring;
+}
+
 //
 // Open a UDP point to point connection.
 //
@@ -768,6 +1496,19 @@ _UDPOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpe
     }
     memcpy(&linkData->link.myAddress, &myAddress, myAddressLength);
 
+    AthenaTransportLink_ReceiveMethod *receiveMethod = _UDPReceive;
+    if (parameters->ioUring) {
+        linkData->ring = _UDPRingCreate(athenaTransportLinkModule, linkData);
+        if (linkData->ring) {
+            linkData->queue = parcDeque_Create();
+            assertNotNull(linkData->queue, "Could not create data queue for new link");
+            receiveMethod = _UDPReceiveRing;
+        }
+    }
+    if ((linkData->ring == NULL) && parameters->offload) {
+        _UDPOffloadNegotiate(athenaTransportLinkModule, linkData);
+    }
+
     parameters->derivedLinkName = _createNameFromLinkData(&linkData->link);
 
     const char *linkName;
@@ -779,7 +1520,7 @@ _UDPOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpe
 
     AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
                                                                           _UDPSend,
-                                                                          _UDPReceive,
+                                                                          receiveMethod,
                                                                           _UDPClose);
     if (athenaTransportLink == NULL) {
         parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
@@ -790,6 +1531,9 @@ _UDPOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpe
 
     athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
     _setConnectLinkState(athenaTransportLink, linkData);
+    if (linkData->ring) {
+        athenaTransportLink_SetEventFd(athenaTransportLink, athenaIOUring_GetEventFd(linkData->ring));
+    }
 
     // Enable Sends
     athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
@@ -800,23 +1544,233 @@ _UDPOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpe
     return athenaTransportLink;
 }
 
-static bool
-_connectionEquals(const void *a, const void *b)
+static int
+_setNonBlocking(AthenaTransportLinkModule *athenaTransportLinkModule, int fd)
 {
-    return (unsigned long *) a == (unsigned long *) b;
+    int flags = fcntl(fd, F_GETFL, NULL);
+    if (flags < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "fcntl failed to get non-blocking flag (%s)", strerror(errno));
+        return -1;
+    }
+    int result = fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    if (result) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "fcntl failed to set non-blocking flag (%s)", strerror(errno));
+        return -1;
+    }
+    return 0;
 }
 
-static HashCodeType
-_connectionHashCode(const void *a)
+//
+// Create a non-blocking socket bound to the listener address, optionally as a member of a SO_REUSEPORT group.
+//
+static int
+_openListenerSocket(AthenaTransportLinkModule *athenaTransportLinkModule, struct sockaddr_storage *address, bool reusePort)
 {
-    return (HashCodeType) a;
+    int fd = socket(address->ss_family, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "socket error (%s)", strerror(errno));
+        return -1;
+    }
+
+    int result = _setSocketOptions(athenaTransportLinkModule, fd);
+    if (result == 0) {
+        result = _setNonBlocking(athenaTransportLinkModule, fd);
+    }
+    if (result) {
+        close(fd);
+        return -1;
+    }
+
+    if (reusePort) {
+#ifdef SO_REUSEPORT
+        int on = 1;
+        result = setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (void *) &on, sizeof(on));
+        if (result) {
+            parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                          "setsockopt failed to set SO_REUSEPORT (%s)", strerror(errno));
+            close(fd);
+            return -1;
+        }
+#else
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "SO_REUSEPORT is not supported on this platform");
+        close(fd);
+        errno = ENOTSUP;
+        return -1;
+#endif
+    }
+
+    // bind to listen on requested address
+    result = bind(fd, (struct sockaddr *) address, SOCKADDR_IN_LEN(address));
+    if (result) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "bind error (%s)", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
 }
 
+//
+// Stop a listener's receive workers, then release their sockets, demux tables and any handed off messages.
+//
 static void
-_closeConnection(void **link)
+_UDPReceiveWorkers_Destroy(_UDPLinkData *linkData)
+{
+    if (linkData->workerStopFd[1] != -1) {
+        close(linkData->workerStopFd[1]); // wakes every worker with a hangup
+        linkData->workerStopFd[1] = -1;
+    }
+    bool started = false;
+    for (size_t i = 0; i < linkData->workerCount; i++) {
+        if (linkData->workers[i].started) {
+            pthread_join(linkData->workers[i].thread, NULL);
+            started = true;
+        }
+    }
+
+    // Only workers that were started can have handed off messages
+    if (started) {
+        _UDPReceiveHandoff handoff;
+        while (read(linkData->fd, &handoff, sizeof(handoff)) == sizeof(handoff)) {
+            if (handoff.ccnxMetaMessage) {
+                ccnxMetaMessage_Release(&handoff.ccnxMetaMessage);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < linkData->workerCount; i++) {
+        _UDPLinkData *workerData = linkData->workers[i].linkData;
+        if (workerData) {
+            if (workerData->fd != -1) {
+                close(workerData->fd);
+            }
+            _UDPLinkData_Destroy(&workerData);
+        }
+        if (linkData->workers[i].athenaTransportLink) {
+            athenaTransportLink_Release(&linkData->workers[i].athenaTransportLink);
+        }
+    }
+    if (linkData->workers) {
+        parcMemory_Deallocate(&linkData->workers);
+    }
+    linkData->workerCount = 0;
+
+    if (linkData->workerStopFd[0] != -1) {
+        close(linkData->workerStopFd[0]);
+        linkData->workerStopFd[0] = -1;
+    }
+    if (linkData->workerHandoffFd != -1) {
+        close(linkData->workerHandoffFd);
+        linkData->workerHandoffFd = -1;
+    }
+}
+
+//
+// Open the sockets and handoff pipe for a listener with receive workers.  The read end of the handoff
+// pipe becomes the listener's fd.  Workers are started once the listener is fully configured.
+//
+static int
+_UDPReceiveWorkers_Create(AthenaTransportLinkModule *athenaTransportLinkModule, _UDPLinkData *linkData, size_t sockets, bool offload)
+{
+    int handoffPipe[2];
+    if (pipe(handoffPipe) == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "pipe error (%s)", strerror(errno));
+        return -1;
+    }
+    linkData->fd = handoffPipe[0];
+    linkData->workerHandoffFd = handoffPipe[1];
+    if (_setNonBlocking(athenaTransportLinkModule, handoffPipe[0]) ||
+        _setNonBlocking(athenaTransportLinkModule, handoffPipe[1])) {
+        return -1;
+    }
+#ifdef F_SETPIPE_SZ
+    // Room for bursts while the forwarder is busy, failure just leaves the default size
+    (void) fcntl(handoffPipe[1], F_SETPIPE_SZ, _UDP_HANDOFF_PIPE_SIZE);
+#endif
+
+    if (pipe(linkData->workerStopFd) == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "pipe error (%s)", strerror(errno));
+        return -1;
+    }
+
+    linkData->workers = parcMemory_AllocateAndClear(sizeof(_UDPReceiveWorker) * sockets);
+    assertNotNull(linkData->workers, "parcMemory_AllocateAndClear failed to allocate %zu receive workers", sockets);
+    linkData->workerCount = sockets;
+
+    for (size_t i = 0; i < sockets; i++) {
+        _UDPReceiveWorker *worker = &linkData->workers[i];
+        worker->index = i;
+        worker->handoffFd = linkData->workerHandoffFd;
+        worker->stopFd = linkData->workerStopFd[0];
+
+        worker->linkData = _UDPLinkData_Create();
+        worker->linkData->link = linkData->link;
+        worker->linkData->peerTable = _UDPPeerTable_Create(_UDP_PEER_TABLE_INITIAL_CAPACITY);
+
+        worker->linkData->fd = _openListenerSocket(athenaTransportLinkModule, &linkData->link.myAddress, true);
+        if (worker->linkData->fd == -1) {
+            return -1;
+        }
+
+        // The first socket settles the port of the group when none was given, the rest bind to the same one
+        if (i == 0) {
+            socklen_t myAddressLength = sizeof(struct sockaddr_storage);
+            if (getsockname(worker->linkData->fd, (struct sockaddr *) &linkData->link.myAddress, &myAddressLength) != 0) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Failed to obtain endpoint information from getsockname (%s)", strerror(errno));
+                return -1;
+            }
+            memcpy(&worker->linkData->link.myAddress, &linkData->link.myAddress, sizeof(struct sockaddr_storage));
+        }
+        if (offload) {
+            _UDPOffloadNegotiate(athenaTransportLinkModule, worker->linkData);
+        }
+    }
+    return 0;
+}
+
+static int
+_UDPReceiveWorkers_Start(AthenaTransportLink *athenaTransportLink, const char *fragmenterName)
 {
-    AthenaTransportLink *athenaTransportLink = (AthenaTransportLink *) *link;
-    athenaTransportLink_Close(athenaTransportLink);
+    struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    for (size_t i = 0; i < linkData->workerCount; i++) {
+        _UDPReceiveWorker *worker = &linkData->workers[i];
+
+        // PARCLog isn't thread safe, so a worker logs, and reassembles, through a link of its own
+        char workerName[MAXPATHLEN];
+        snprintf(workerName, sizeof(workerName), "%s/worker%zu", athenaTransportLink_GetName(athenaTransportLink), i);
+        worker->athenaTransportLink = athenaTransportLink_Create(workerName, NULL, NULL, NULL);
+        if (worker->athenaTransportLink == NULL) {
+            return -1;
+        }
+        athenaTransportLink_SetLogLevel(worker->athenaTransportLink,
+                                        parcLog_GetLevel(athenaTransportLink_GetLogger(athenaTransportLink)));
+
+        // Each worker reassembles fragments from the peers on its own socket
+        if (fragmenterName) {
+            worker->linkData->fragmenter = athenaFragmenter_Create(worker->athenaTransportLink, fragmenterName);
+            if (worker->linkData->fragmenter == NULL) {
+                return -1;
+            }
+        }
+
+        int result = pthread_create(&worker->thread, NULL, _UDPReceiveWorker_Run, worker);
+        if (result != 0) {
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                          "Unable to start receive worker (%s)", strerror(result));
+            errno = result;
+            return -1;
+        }
+        worker->started = true;
+    }
+    return 0;
 }
 
 //
@@ -827,55 +1781,48 @@ static AthenaTransportLink *
 _UDPOpenListener(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpecificationParameters *parameters)
 {
     _UDPLinkData *linkData = _UDPLinkData_Create();
-    linkData->multiplexTable = parcHashCodeTable_Create(_connectionEquals, _connectionHashCode, NULL, _closeConnection);
-    assertNotNull(linkData->multiplexTable, "Could not create multiplex table for new listener");
 
     memcpy(&linkData->link.myAddress, parameters->destination, SOCKADDR_IN_LEN(parameters->destination));
     if (parameters->mtu) {
         linkData->link.mtu = parameters->mtu;
     }
-
-    linkData->fd = socket(linkData->link.myAddress.ss_family, SOCK_DGRAM, IPPROTO_UDP);
-    if (linkData->fd < 0) {
-        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
-                      "socket error (%s)", strerror(errno));
-        _UDPLinkData_Destroy(&linkData);
-        return NULL;
+    if (parameters->idleTimeout) {
+        linkData->idleTimeout = (time_t) parameters->idleTimeout;
+        linkData->nextIdleSweep = _monotonicSeconds() + linkData->idleTimeout;
     }
 
-    int result = _setSocketOptions(athenaTransportLinkModule, linkData->fd);
-    if (result) {
-        close(linkData->fd);
-        _UDPLinkData_Destroy(&linkData);
-        return NULL;
-    }
+    AthenaTransportLink_ReceiveMethod *receiveMethod;
+    if (parameters->sockets) {
+        if (_UDPReceiveWorkers_Create(athenaTransportLinkModule, linkData, parameters->sockets, parameters->offload) == -1) {
+            int createError = errno;
+            _UDPReceiveWorkers_Destroy(linkData);
+            if (linkData->fd != -1) {
+                close(linkData->fd);
+            }
+            _UDPLinkData_Destroy(&linkData);
+            errno = createError;
+            return NULL;
+        }
+        receiveMethod = _UDPReceiveListenerHandoff;
+    } else {
+        linkData->peerTable = _UDPPeerTable_Create(_UDP_PEER_TABLE_INITIAL_CAPACITY);
 
-    // Set non-blocking flag
-    int flags = fcntl(linkData->fd, F_GETFL, NULL);
-    if (flags < 0) {
-        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
-                      "fcntl failed to get non-blocking flag (%s)", strerror(errno));
-        close(linkData->fd);
-        _UDPLinkData_Destroy(&linkData);
-        return NULL;
-    }
-    result = fcntl(linkData->fd, F_SETFL, flags | O_NONBLOCK);
-    if (result) {
-        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
-                      "fcntl failed to set non-blocking flag (%s)", strerror(errno));
-        close(linkData->fd);
-        _UDPLinkData_Destroy(&linkData);
-        return NULL;
-    }
+        linkData->fd = _openListenerSocket(athenaTransportLinkModule, &linkData->link.myAddress, false);
+        if (linkData->fd == -1) {
+            _UDPLinkData_Destroy(&linkData);
+            return NULL;
+        }
+        receiveMethod = _UDPReceiveListener;
 
-    // bind to listen on requested address
-    result = bind(linkData->fd, (struct sockaddr *)&linkData->link.myAddress, SOCKADDR_IN_LEN(&linkData->link.myAddress));
-    if (result) {
-        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
-                      "bind error (%s)", strerror(errno));
-        close(linkData->fd);
-        _UDPLinkData_Destroy(&linkData);
-        return NULL;
+        if (parameters->ioUring) {
+            linkData->ring = _UDPRingCreate(athenaTransportLinkModule, linkData);
+            if (linkData->ring) {
+                receiveMethod = _UDPReceiveListenerRing;
+            }
+        }
+        if ((linkData->ring == NULL) && parameters->offload) {
+            _UDPOffloadNegotiate(athenaTransportLinkModule, linkData);
+        }
     }
 
     parameters->derivedLinkName = _createNameFromLinkData(&linkData->link);
@@ -890,11 +1837,14 @@ _UDPOpenListener(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpeci
     // Listener doesn't require a send method.  The receive method is used to establish new connections.
     AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
                                                                           NULL,
-                                                                          _UDPReceiveListener,
+                                                                          receiveMethod,
                                                                           _UDPClose);
     if (athenaTransportLink == NULL) {
         parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
                       "athenaTransportLink_Create failed");
+        if (linkData->workers) {
+            _UDPReceiveWorkers_Destroy(linkData);
+        }
         close(linkData->fd);
         _UDPLinkData_Destroy(&linkData);
         return athenaTransportLink;
@@ -902,14 +1852,19 @@ _UDPOpenListener(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpeci
 
     athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
     athenaTransportLink_SetPrivateData(athenaTransportLink, linkData);
-    athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+    if (linkData->ring) {
+        athenaTransportLink_SetEventFd(athenaTransportLink, athenaIOUring_GetEventFd(linkData->ring));
+    } else {
+        athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+    }
 
     // Links established for listening are not used to route messages.
     // They can be kept in a listener list that doesn't consume a linkId.
     athenaTransportLink_SetRoutable(athenaTransportLink, false);
 
     parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
-                 "new listener established: Name=\"%s\" (%s)", parameters->linkName, parameters->derivedLinkName);
+                 "new listener established: Name=\"%s\" (%s) sockets=%zu", parameters->linkName, parameters->derivedLinkName,
+                 parameters->sockets ? parameters->sockets : 1);
 
     return athenaTransportLink;
 }
@@ -920,6 +1875,10 @@ _UDPOpenListener(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpeci
 #define LINK_NAME_SPECIFIER "name%3D"
 #define LOCAL_LINK_FLAG "local%3D"
 #define FRAGMENTER "fragmenter%3D"
+#define LISTENER_SOCKETS "sockets%3D"
+#define LISTENER_IDLE_TIMEOUT "idle%3D"
+#define IO_ENGINE "io%3D"
+#define SEGMENTATION_OFFLOAD "offload%3D"
 
 static struct sockaddr_storage *
 _getSockaddr(const char *moduleName, const char *hostname, in_port_t port)
@@ -996,6 +1955,7 @@ _URISpecificationParameters_Create(AthenaTransportLinkModule *athenaTransportLin
 {
     const char *moduleName = parcURI_GetScheme(connectionURI);
     _URISpecificationParameters *parameters = parcMemory_AllocateAndClear(sizeof(_URISpecificationParameters));
+    parameters->offload = true;
 
     const char *authorityString = parcURI_GetAuthority(connectionURI);
     if (authorityString == NULL) {
@@ -1092,6 +2052,83 @@ _URISpecificationParameters_Create(AthenaTransportLinkModule *athenaTransportLin
             continue;
         }
 
+        if (strncasecmp(token, LISTENER_SOCKETS, strlen(LISTENER_SOCKETS)) == 0) {
+            if ((sscanf(token, "%*[^%%]%%3D%zu", &parameters->sockets) != 1) ||
+                (parameters->sockets == 0) || (parameters->sockets > _UDP_MAX_LISTENER_SOCKETS)) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper listener socket count specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, LISTENER_IDLE_TIMEOUT, strlen(LISTENER_IDLE_TIMEOUT)) == 0) {
+            if (sscanf(token, "%*[^%%]%%3D%zu", &parameters->idleTimeout) != 1) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper idle timeout specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, IO_ENGINE, strlen(IO_ENGINE)) == 0) {
+            char ioEngine[MAXPATHLEN] = { 0 };
+            if (sscanf(token, "%*[^%%]%%3D%s", ioEngine) != 1) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper io engine specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            } else if (strcasecmp(ioEngine, "uring") == 0) {
+                parameters->ioUring = true;
+            } else if (strcasecmp(ioEngine, "poll") == 0) {
+                parameters->ioUring = false;
+            } else {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Unknown io engine (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, SEGMENTATION_OFFLOAD, strlen(SEGMENTATION_OFFLOAD)) == 0) {
+            char offloadFlag[MAXPATHLEN] = { 0 };
+            if (sscanf(token, "%*[^%%]%%3D%s", offloadFlag) != 1) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper offload specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            } else if (strcasecmp(offloadFlag, "true") == 0) {
+                parameters->offload = true;
+            } else if (strcasecmp(offloadFlag, "false") == 0) {
+                parameters->offload = false;
+            } else {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper offload specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
         if (strncasecmp(token, LINK_NAME_SPECIFIER, strlen(LINK_NAME_SPECIFIER)) == 0) {
             char specifiedLinkName[MAXPATHLEN];
             if (sscanf(token, "%*[^%%]%%3D%s", specifiedLinkName) != 1) {
@@ -1142,6 +2179,24 @@ _URISpecificationParameters_Create(AthenaTransportLinkModule *athenaTransportLin
         return NULL;
     }
 
+    // Multiple receive sockets and idle peer timeouts only apply to listeners
+    if ((parameters->sockets || parameters->idleTimeout) && (parameters->listener == false)) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "A socket count or idle timeout can only be specified for a listener");
+        _URISpecificationParameters_Destroy(&parameters);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    // Receive workers each poll their own socket
+    if (parameters->sockets && parameters->ioUring) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "An io_uring listener can only have a single socket");
+        _URISpecificationParameters_Destroy(&parameters);
+        errno = EINVAL;
+        return NULL;
+    }
+
     return parameters;
 }
 
@@ -1183,20 +2238,78 @@ _UDPOpen(AthenaTransportLinkModule *athenaTransportLinkModule, PARCURI *connecti
         athenaTransportLink_ForceLocal(result, parameters->forceLocal);
     }
 
+    // Receiving on a ring begins once the link's configuration is complete
+    if (result && parameters->ioUring) {
+        struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(result);
+        if (linkData->ring && (athenaIOUring_Receive(linkData->ring, _UDPRingReceiveCallback, result) == -1)) {
+            int receiveError = errno;
+            parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                          "Failed to start receiving on %s: %s", parameters->linkName, strerror(errno));
+            athenaTransportLink_Close(result);
+            _URISpecificationParameters_Destroy(&parameters);
+            errno = receiveError;
+            return NULL;
+        }
+    }
+
+    // Receive workers start once the listener's configuration is complete
+    if (result && parameters->sockets) {
+        if (_UDPReceiveWorkers_Start(result, parameters->fragmenterName) == -1) {
+            int startError = errno;
+            parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                          "Failed to start receive workers for %s: %s", parameters->linkName, strerror(errno));
+            athenaTransportLink_Close(result);
+            _URISpecificationParameters_Destroy(&parameters);
+            errno = startError;
+            return NULL;
+        }
+    }
+
     _URISpecificationParameters_Destroy(&parameters);
 
     return result;
 }
 
+//
+// Close the links of a listener's peers that have not been received from since the last sweep.
+// Sweeps run once per idle timeout, so a peer is closed after between one and two timeouts of silence.
+//
+static void
+_idlePeerSweep(AthenaTransportLink *athenaTransportLink, _UDPLinkData *linkData)
+{
+    time_t now = _monotonicSeconds();
+    if (now < linkData->nextIdleSweep) {
+        return;
+    }
+    linkData->nextIdleSweep = now + linkData->idleTimeout;
+
+    if (linkData->workers) {
+        for (size_t i = 0; i < linkData->workerCount; i++) {
+            _UDPPeerTable_CloseLinks(linkData->workers[i].linkData->peerTable, true);
+        }
+    } else {
+        _UDPPeerTable_CloseLinks(linkData->peerTable, true);
+    }
+}
+
 static int
 _UDPPoll(AthenaTransportLink *athenaTransportLink, int timeout)
 {
     struct _UDPLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
 
+    if (linkData->idleTimeout) {
+        _idlePeerSweep(athenaTransportLink, linkData);
+    }
+
+    // Hand the sends queued since the last poll to the kernel as one batch
+    if (linkData->ring) {
+        athenaIOUring_Submit(linkData->ring);
+    }
+
     if (linkData->queue) {
-        return (int) parcDeque_Size(linkData->queue);
+        return (int) (parcDeque_Size(linkData->queue) + _UDPCoalescedPending(linkData));
     }
-    return 0;
+    return (int) _UDPCoalescedPending(linkData);
 }
 
 PARCArrayList *
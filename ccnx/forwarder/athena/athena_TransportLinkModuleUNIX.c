@@ -0,0 +1,657 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkModuleUNIX.h>
+
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+
+static int _listenerBacklog = 16;
+
+#define UNIX_SCHEME "unix"
+
+// Prefix of the abstract socket name a channel is bound to
+#define UNIX_SOCKET_PREFIX "athena.unix."
+
+// Largest message that can be received, the packet length field is 16 bits
+#define UNIX_MAX_MESSAGE_SIZE 65536
+
+//
+// Private data for each link instance
+//
+typedef struct _UNIXLinkData {
+    int fd;
+    char *channel;
+    pid_t peerPid;
+    uint8_t *receiveBuffer; // each message is read whole into this, then copied out at its actual size
+    struct {
+        size_t receive_ReadError;
+        size_t receive_ReadWouldBlock;
+        size_t receive_Truncated;
+        size_t receive_DecodeFailed;
+        size_t send_ShortWrite;
+        size_t send_Retry;
+        size_t send_Error;
+    } _stats;
+} _UNIXLinkData;
+
+static _UNIXLinkData *
+_UNIXLinkData_Create()
+{
+    _UNIXLinkData *linkData = parcMemory_AllocateAndClear(sizeof(_UNIXLinkData));
+    assertNotNull(linkData, "Could not create private data for new link");
+    linkData->fd = -1;
+    return linkData;
+}
+
+static void
+_UNIXLinkData_Destroy(_UNIXLinkData **linkData)
+{
+    if ((*linkData)->fd != -1) {
+        close((*linkData)->fd);
+    }
+    if ((*linkData)->receiveBuffer) {
+        parcMemory_Deallocate(&((*linkData)->receiveBuffer));
+    }
+    if ((*linkData)->channel) {
+        parcMemory_Deallocate(&((*linkData)->channel));
+    }
+    parcMemory_Deallocate(linkData);
+}
+
+/**
+ * @abstract create link name based on connection information
+ * @discussion
+ *
+ * Unix domain connections have no addresses of their own, so a connection is named by the process
+ * at the other end and the descriptor it uses here, which is unique for as long as the link is open.
+ *
+ * @param [in] linkData connection information
+ * @param [in] listener true if the link is the channel's listener
+ * @return allocated name, must be released with parcMemory_Deallocate()
+ */
+static const char *
+_createNameFromLinkData(const _UNIXLinkData *linkData, bool listener)
+{
+    char nameBuffer[MAXPATHLEN];
+
+    if (listener) {
+        sprintf(nameBuffer, "%s://%s", UNIX_SCHEME, linkData->channel);
+    } else {
+        sprintf(nameBuffer, "%s://%s<->%d.%d", UNIX_SCHEME, linkData->channel, (int) linkData->peerPid, linkData->fd);
+    }
+
+    return parcMemory_StringDuplicate(nameBuffer, strlen(nameBuffer));
+}
+
+static int
+_channelAddress(const char *channel, struct sockaddr_un *address, socklen_t *addressLength)
+{
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+
+    // Leading nul for the abstract namespace
+    int length = snprintf(&address->sun_path[1], sizeof(address->sun_path) - 1, "%s%s", UNIX_SOCKET_PREFIX, channel);
+    if ((length < 0) || (length >= (sizeof(address->sun_path) - 1))) {
+        errno = EINVAL;
+        return -1;
+    }
+    *addressLength = (socklen_t) (offsetof(struct sockaddr_un, sun_path) + 1 + length);
+    return 0;
+}
+
+static int
+_UNIXSend(AthenaTransportLink *athenaTransportLink, CCNxMetaMessage *ccnxMetaMessage)
+{
+    _UNIXLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    if (ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage) == CCNxTlvDictionary_SchemaVersion_V0) {
+        parcLog_Warning(athenaTransportLink_GetLogger(athenaTransportLink),
+                        "sending deprecated version %d message\n", ccnxTlvDictionary_GetSchemaVersion(ccnxMetaMessage));
+    }
+
+    // Get wire format and write it out as a single packet.
+    PARCBuffer *wireFormatBuffer = athenaTransportLinkModule_CreateMessageBuffer(ccnxMetaMessage);
+
+    parcBuffer_SetPosition(wireFormatBuffer, 0);
+    size_t length = parcBuffer_Limit(wireFormatBuffer);
+    char *buffer = parcBuffer_Overlay(wireFormatBuffer, length);
+
+    parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink),
+                  "sending message (size=%zu)", length);
+
+    ssize_t writeCount;
+    do {
+        writeCount = send(linkData->fd, buffer, length, MSG_NOSIGNAL);
+    } while ((writeCount == -1) && (errno == EINTR) && ++linkData->_stats.send_Retry);
+    parcBuffer_Release(&wireFormatBuffer);
+
+    if (writeCount == -1) {
+        if (errno == EAGAIN) {
+            linkData->_stats.send_Retry++;
+            parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "send retry (%s)", strerror(errno));
+        } else {
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+            linkData->_stats.send_Error++;
+            parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                          "send error, closing link (%s)", strerror(errno));
+        }
+        return -1;
+    }
+    if (writeCount != length) { // packets are sent whole or not at all
+        linkData->_stats.send_ShortWrite++;
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "short write");
+        return -1;
+    }
+    return 0;
+}
+
+static CCNxMetaMessage *
+_UNIXReceive(AthenaTransportLink *athenaTransportLink)
+{
+    _UNIXLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    CCNxMetaMessage *ccnxMetaMessage = NULL;
+
+    // MSG_TRUNC has recv return the full length of the packet, even if it was larger than the buffer
+    ssize_t readCount = recv(linkData->fd, linkData->receiveBuffer, UNIX_MAX_MESSAGE_SIZE, MSG_DONTWAIT | MSG_TRUNC);
+
+    if (readCount == -1) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            linkData->_stats.receive_ReadWouldBlock++;
+        } else {
+            linkData->_stats.receive_ReadError++;
+            athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+        }
+        parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "read error (%s)", strerror(errno));
+        return NULL;
+    }
+
+    // A zero length read on a sequenced packet socket means our peer has hungup.
+    if (readCount == 0) {
+        athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Error);
+        return NULL;
+    }
+
+    if (readCount > UNIX_MAX_MESSAGE_SIZE) {
+        linkData->_stats.receive_Truncated++;
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "Dropped message larger than the maximum message size (%zd > %d)", readCount, UNIX_MAX_MESSAGE_SIZE);
+        return NULL;
+    }
+
+    parcLog_Debug(athenaTransportLink_GetLogger(athenaTransportLink), "received message (size=%zd)", readCount);
+    PARCBuffer *wireFormatBuffer = parcBuffer_Allocate(readCount);
+    parcBuffer_PutArray(wireFormatBuffer, readCount, linkData->receiveBuffer);
+    parcBuffer_Flip(wireFormatBuffer);
+
+    // Construct, and return a ccnxMetaMessage from the wire format buffer.
+    ccnxMetaMessage = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+    if (ccnxMetaMessage == NULL) {
+        linkData->_stats.receive_DecodeFailed++;
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "Failed to decode message from received packet.");
+    }
+    parcBuffer_Release(&wireFormatBuffer);
+
+    return ccnxMetaMessage;
+}
+
+static void
+_UNIXClose(AthenaTransportLink *athenaTransportLink)
+{
+    parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
+                 "link %s closed", athenaTransportLink_GetName(athenaTransportLink));
+    _UNIXLinkData *linkData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+    _UNIXLinkData_Destroy(&linkData);
+}
+
+static void
+_setConnectLinkState(AthenaTransportLink *athenaTransportLink, _UNIXLinkData *linkData)
+{
+    athenaTransportLink_SetPrivateData(athenaTransportLink, linkData);
+
+    // Register file descriptor to be polled.  This must be set before adding the link.
+    athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+    athenaTransportLink_SetSendPollable(athenaTransportLink, true);
+
+    // The peer is always on this host
+    athenaTransportLink_SetLocal(athenaTransportLink, true);
+
+    // Allow messages to initially be sent
+    athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+}
+
+// Set up a connected socket's private data, used by both the connecting and the accepting end
+static void
+_setConnectLinkData(_UNIXLinkData *linkData)
+{
+    struct ucred credentials;
+    socklen_t credentialsLength = sizeof(credentials);
+    if (getsockopt(linkData->fd, SOL_SOCKET, SO_PEERCRED, &credentials, &credentialsLength) == 0) {
+        linkData->peerPid = credentials.pid;
+    }
+
+    linkData->receiveBuffer = parcMemory_Allocate(UNIX_MAX_MESSAGE_SIZE);
+    assertNotNull(linkData->receiveBuffer, "parcMemory_Allocate(%d) returned NULL", UNIX_MAX_MESSAGE_SIZE);
+}
+
+#define UNIX_LISTENER_FLAG "listener"
+#define LINK_NAME_SPECIFIER "name%3D"
+#define LOCAL_LINK_FLAG "local%3D"
+
+typedef struct _URISpecificationParameters {
+    char *linkName;
+    const char *derivedLinkName;
+    char *channel;
+    bool listener;
+    int forceLocal;
+} _URISpecificationParameters;
+
+static void
+_URISpecificationParameters_Destroy(_URISpecificationParameters **parameters)
+{
+    if ((*parameters)->linkName) {
+        parcMemory_Deallocate(&((*parameters)->linkName));
+    }
+    if ((*parameters)->derivedLinkName) {
+        parcMemory_Deallocate(&((*parameters)->derivedLinkName));
+    }
+    if ((*parameters)->channel) {
+        parcMemory_Deallocate(&((*parameters)->channel));
+    }
+    parcMemory_Deallocate(parameters);
+}
+
+static _URISpecificationParameters *
+_URISpecificationParameters_Create(AthenaTransportLinkModule *athenaTransportLinkModule, PARCURI *connectionURI)
+{
+    _URISpecificationParameters *parameters = parcMemory_AllocateAndClear(sizeof(_URISpecificationParameters));
+
+    // The authority names the channel
+    const char *authorityString = parcURI_GetAuthority(connectionURI);
+    if ((authorityString == NULL) || (strlen(authorityString) == 0)) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unable to parse connection authority %s", authorityString);
+        errno = EINVAL;
+        _URISpecificationParameters_Destroy(&parameters);
+        return NULL;
+    }
+    parameters->channel = parcMemory_StringDuplicate(authorityString, strlen(authorityString));
+
+    PARCURIPath *remainder = parcURI_GetPath(connectionURI);
+    size_t segments = parcURIPath_Count(remainder);
+    for (int i = 0; i < segments; i++) {
+        PARCURISegment *segment = parcURIPath_Get(remainder, i);
+        const char *token = parcURISegment_ToString(segment);
+
+        if (strcasecmp(token, UNIX_LISTENER_FLAG) == 0) {
+            parameters->listener = true;
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, LINK_NAME_SPECIFIER, strlen(LINK_NAME_SPECIFIER)) == 0) {
+            char specifiedLinkName[MAXPATHLEN];
+            if (sscanf(token, "%*[^%%]%%3D%s", specifiedLinkName) != 1) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper connection name specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parameters->linkName = parcMemory_StringDuplicate(specifiedLinkName, strlen(specifiedLinkName));
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        if (strncasecmp(token, LOCAL_LINK_FLAG, strlen(LOCAL_LINK_FLAG)) == 0) {
+            char localFlag[MAXPATHLEN] = { 0 };
+            if (sscanf(token, "%*[^%%]%%3D%s", localFlag) == 1) {
+                if (strncasecmp(localFlag, "false", strlen("false")) == 0) {
+                    parameters->forceLocal = AthenaTransportLink_ForcedNonLocal;
+                } else if (strncasecmp(localFlag, "true", strlen("true")) == 0) {
+                    parameters->forceLocal = AthenaTransportLink_ForcedLocal;
+                }
+            }
+            if (parameters->forceLocal == 0) {
+                parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                              "Improper local specification (%s)", token);
+                parcMemory_Deallocate(&token);
+                _URISpecificationParameters_Destroy(&parameters);
+                errno = EINVAL;
+                return NULL;
+            }
+            parcMemory_Deallocate(&token);
+            continue;
+        }
+
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unknown connection parameter (%s)", token);
+        _URISpecificationParameters_Destroy(&parameters);
+        parcMemory_Deallocate(&token);
+        errno = EINVAL;
+        return NULL;
+    }
+    return parameters;
+}
+
+static AthenaTransportLink *
+_UNIXOpenConnection(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpecificationParameters *parameters)
+{
+    _UNIXLinkData *linkData = _UNIXLinkData_Create();
+    linkData->channel = parcMemory_StringDuplicate(parameters->channel, strlen(parameters->channel));
+
+    struct sockaddr_un address;
+    socklen_t addressLength;
+    if (_channelAddress(linkData->channel, &address, &addressLength) == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Channel name too long (%s)", linkData->channel);
+        _UNIXLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    linkData->fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (linkData->fd < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "socket error (%s)", strerror(errno));
+        _UNIXLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    // Connect to the channel's listener
+    int result = connect(linkData->fd, (struct sockaddr *) &address, addressLength);
+    if (result < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule), "connect error (%s)", strerror(errno));
+        int connectError = errno;
+        _UNIXLinkData_Destroy(&linkData);
+        errno = connectError;
+        return NULL;
+    }
+    _setConnectLinkData(linkData);
+
+    parameters->derivedLinkName = _createNameFromLinkData(linkData, false);
+
+    const char *linkName;
+    if (parameters->linkName == NULL) {
+        linkName = parameters->derivedLinkName;
+    } else {
+        linkName = parameters->linkName;
+    }
+
+    AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
+                                                                          _UNIXSend,
+                                                                          _UNIXReceive,
+                                                                          _UNIXClose);
+    if (athenaTransportLink == NULL) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "athenaTransportLink_Create failed");
+        _UNIXLinkData_Destroy(&linkData);
+        return athenaTransportLink;
+    }
+
+    athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
+    _setConnectLinkState(athenaTransportLink, linkData);
+
+    parcLog_Info(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                 "new link established: Name=\"%s\" (%s)", parameters->linkName, parameters->derivedLinkName);
+
+    return athenaTransportLink;
+}
+
+static CCNxMetaMessage *
+_UNIXReceiveListener(AthenaTransportLink *athenaTransportLink)
+{
+    _UNIXLinkData *listenerData = athenaTransportLink_GetPrivateData(athenaTransportLink);
+
+    _UNIXLinkData *newLinkData = _UNIXLinkData_Create();
+    newLinkData->channel = parcMemory_StringDuplicate(listenerData->channel, strlen(listenerData->channel));
+
+    // Accept a new connection.
+    newLinkData->fd = accept4(listenerData->fd, NULL, NULL, SOCK_CLOEXEC);
+    if (newLinkData->fd == -1) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink), "_UNIXReceiveListener accept: %s", strerror(errno));
+        _UNIXLinkData_Destroy(&newLinkData);
+        return NULL;
+    }
+    _setConnectLinkData(newLinkData);
+
+    // Clone a new link from the current listener.
+    const char *derivedLinkName = _createNameFromLinkData(newLinkData, false);
+    AthenaTransportLink *newTransportLink = athenaTransportLink_Clone(athenaTransportLink,
+                                                                      derivedLinkName,
+                                                                      _UNIXSend,
+                                                                      _UNIXReceive,
+                                                                      _UNIXClose);
+    if (newTransportLink == NULL) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "athenaTransportLink_Clone failed");
+        parcMemory_Deallocate(&derivedLinkName);
+        _UNIXLinkData_Destroy(&newLinkData);
+        return NULL;
+    }
+
+    _setConnectLinkState(newTransportLink, newLinkData);
+
+    // Send the new link up to be added.
+    int result = athenaTransportLink_AddLink(athenaTransportLink, newTransportLink);
+    if (result == -1) {
+        parcLog_Error(athenaTransportLink_GetLogger(athenaTransportLink),
+                      "athenaTransportLinkModule_AddLink failed: %s", strerror(errno));
+        _UNIXLinkData_Destroy(&newLinkData);
+        athenaTransportLink_Release(&newTransportLink);
+    } else {
+        parcLog_Info(athenaTransportLink_GetLogger(athenaTransportLink),
+                     "new link accepted by %s: %s", athenaTransportLink_GetName(athenaTransportLink), derivedLinkName);
+    }
+
+    parcMemory_Deallocate(&derivedLinkName);
+
+    // Could pass a message back here regarding the new link.
+    return NULL;
+}
+
+static AthenaTransportLink *
+_UNIXOpenListener(AthenaTransportLinkModule *athenaTransportLinkModule, _URISpecificationParameters *parameters)
+{
+    _UNIXLinkData *linkData = _UNIXLinkData_Create();
+    linkData->channel = parcMemory_StringDuplicate(parameters->channel, strlen(parameters->channel));
+
+    struct sockaddr_un address;
+    socklen_t addressLength;
+    if (_channelAddress(linkData->channel, &address, &addressLength) == -1) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Channel name too long (%s)", linkData->channel);
+        _UNIXLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    linkData->fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (linkData->fd < 0) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "socket error (%s)", strerror(errno));
+        _UNIXLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    // bind and listen on the channel
+    int result = bind(linkData->fd, (struct sockaddr *) &address, addressLength);
+    if (result) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "bind error (%s)", strerror(errno));
+        int bindError = errno;
+        _UNIXLinkData_Destroy(&linkData);
+        errno = bindError;
+        return NULL;
+    }
+    result = listen(linkData->fd, _listenerBacklog);
+    if (result) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "listen error (%s)", strerror(errno));
+        _UNIXLinkData_Destroy(&linkData);
+        return NULL;
+    }
+
+    parameters->derivedLinkName = _createNameFromLinkData(linkData, true);
+
+    const char *linkName;
+    if (parameters->linkName == NULL) {
+        linkName = parameters->derivedLinkName;
+    } else {
+        linkName = parameters->linkName;
+    }
+
+    // Listener doesn't require a send method.  The receive method is used to establish new connections.
+    AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create(linkName,
+                                                                          NULL,
+                                                                          _UNIXReceiveListener,
+                                                                          _UNIXClose);
+    if (athenaTransportLink == NULL) {
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "athenaTransportLink_Create failed");
+        _UNIXLinkData_Destroy(&linkData);
+        return athenaTransportLink;
+    }
+
+    athenaTransportLink_SetLogLevel(athenaTransportLink, parcLog_GetLevel(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule)));
+    athenaTransportLink_SetPrivateData(athenaTransportLink, linkData);
+    athenaTransportLink_SetEventFd(athenaTransportLink, linkData->fd);
+
+    // Links established for listening are not used to route messages.
+    // They can be kept in a listener list that doesn't consume a linkId.
+    athenaTransportLink_SetRoutable(athenaTransportLink, false);
+
+    parcLog_Info(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                 "new listener established: Name=\"%s\" (%s)", parameters->linkName, parameters->derivedLinkName);
+
+    return athenaTransportLink;
+}
+
+static AthenaTransportLink *
+_UNIXOpen(AthenaTransportLinkModule *athenaTransportLinkModule, PARCURI *connectionURI)
+{
+    AthenaTransportLink *result = 0;
+
+    _URISpecificationParameters *parameters = _URISpecificationParameters_Create(athenaTransportLinkModule, connectionURI);
+    if (parameters == NULL) {
+        char *connectionURIstring = parcURI_ToString(connectionURI);
+        parcLog_Error(athenaTransportLinkModule_GetLogger(athenaTransportLinkModule),
+                      "Unable to parse connection URI specification (%s)", connectionURIstring);
+        parcMemory_Deallocate(&connectionURIstring);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    if (parameters->listener) {
+        result = _UNIXOpenListener(athenaTransportLinkModule, parameters);
+    } else {
+        result = _UNIXOpenConnection(athenaTransportLinkModule, parameters);
+    }
+
+    // forced IsLocal/IsNotLocal, mainly for testing
+    if (result && parameters->forceLocal) {
+        athenaTransportLink_ForceLocal(result, parameters->forceLocal);
+    }
+
+    _URISpecificationParameters_Destroy(&parameters);
+
+    return result;
+}
+
+static int
+_UNIXPoll(AthenaTransportLink *athenaTransportLink, int timeout)
+{
+    return 0;
+}
+
+//
+// This function must be named "athenaTransportLinkModule" <module name> "_Init" so that
+// athenaTransportLinkAdapter can locate it to invoke initialization when it's loaded.  It's
+// named uniquely (as opposed to _init()) so that it can also be statically linked into Athena.
+//
+PARCArrayList *
+athenaTransportLinkModuleUNIX_Init()
+{
+    // Unix domain socket module for links to applications on the same host.
+    AthenaTransportLinkModule *athenaTransportLinkModule;
+    PARCArrayList *moduleList = parcArrayList_Create(NULL);
+    assertNotNull(moduleList, "parcArrayList_Create failed to create module list");
+
+    athenaTransportLinkModule = athenaTransportLinkModule_Create("UNIX",
+                                                                 _UNIXOpen,
+                                                                 _UNIXPoll);
+    assertNotNull(athenaTransportLinkModule, "parcMemory_AllocateAndClear failed allocate UNIX athenaTransportLinkModule");
+    bool result = parcArrayList_Add(moduleList, athenaTransportLinkModule);
+    assertTrue(result == true, "parcArrayList_Add failed");
+
+    return moduleList;
+}
+
+void
+athenaTransportLinkModuleUNIX_Fini()
+{
+}
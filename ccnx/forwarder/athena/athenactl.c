@@ -64,6 +64,7 @@
 
 #include <sys/param.h>
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "athenactl.h"
 #include "athena_InterestControl.h"
@@ -80,6 +81,11 @@
 #define SUBCOMMAND_UNSET_DEBUG "debug"
 
 #define SUBCOMMAND_SET_LEVEL "level"
+#define SUBCOMMAND_SET_STRATEGY "strategy"
+#define SUBCOMMAND_SET_QUEUE "queue"
+#define SUBCOMMAND_SET_SHAPING "shaping"
+#define SUBCOMMAND_SET_OVERFLOW "overflow"
+#define SUBCOMMAND_SET_QUOTA "quota"
 
 #define COMMAND_ADD "add"
 #define SUBCOMMAND_ADD_LINK "link"
@@ -94,6 +100,9 @@
 #define SUBCOMMAND_LIST_ROUTES "routes"
 #define SUBCOMMAND_LIST_CONNECTIONS "connections"
 
+#define COMMAND_LOAD "load"
+#define SUBCOMMAND_LOAD_ROUTES "routes"
+
 #define COMMAND_REMOVE "remove"
 #define SUBCOMMAND_REMOVE_LINK "link"
 #define SUBCOMMAND_REMOVE_CONNECTION "connection"
@@ -253,7 +262,7 @@ static int
 _athenactl_AddRoute(PARCIdentity *identity, int argc, char **argv)
 {
     if (argc < 1) {
-        printf("usage: add route [<linkName>] <prefix>\n");
+        printf("usage: add route [<linkName>] <prefix> [<cost> [<weight>]]\n");
         return 1;
     }
 
@@ -263,18 +272,27 @@ _athenactl_AddRoute(PARCIdentity *identity, int argc, char **argv)
 
     char *linkName = NULL;
     char *prefix = NULL;
+    char *cost = NULL;
+    char *weight = NULL;
 
     if (argc == 1) {
         prefix = argv[0];
     } else {
         linkName = argv[0];
         prefix = argv[1];
+        if (argc > 2) {
+            cost = argv[2];
+        }
+        if (argc > 3) {
+            weight = argv[3];
+        }
     }
 
-    // passed in as <linkName> <prefix>, passed on as <prefix> <linkname>
+    // passed in as <linkName> <prefix> [<cost> [<weight>]], passed on as <prefix> <linkname> [<cost> [<weight>]]
     char routeArguments[MAXPATHLEN];
     if (linkName) {
-        sprintf(routeArguments, "%s %s", prefix, linkName);
+        snprintf(routeArguments, sizeof(routeArguments), "%s %s %s %s", prefix, linkName,
+                 cost ? cost : "", weight ? weight : "");
     } else {
         sprintf(routeArguments, "%s", prefix);
     }
@@ -307,18 +325,27 @@ _athenactl_RemoveRoute(PARCIdentity *identity, int argc, char **argv)
 
     char *linkName = NULL;
     char *prefix = NULL;
+    char *cost = NULL;
+    char *weight = NULL;
 
     if (argc == 1) {
         prefix = argv[0];
     } else {
         linkName = argv[0];
         prefix = argv[1];
+        if (argc > 2) {
+            cost = argv[2];
+        }
+        if (argc > 3) {
+            weight = argv[3];
+        }
     }
 
-    // passed in as <linkName> <prefix>, passed on as <prefix> <linkname>
+    // passed in as <linkName> <prefix> [<cost> [<weight>]], passed on as <prefix> <linkname> [<cost> [<weight>]]
     char routeArguments[MAXPATHLEN];
     if (linkName) {
-        sprintf(routeArguments, "%s %s", prefix, linkName);
+        snprintf(routeArguments, sizeof(routeArguments), "%s %s %s %s", prefix, linkName,
+                 cost ? cost : "", weight ? weight : "");
     } else {
         sprintf(routeArguments, "%s", prefix);
     }
@@ -472,7 +499,15 @@ _athenactl_ListFIB(PARCIdentity *identity, int argc, char **argv)
 
                 value = parcJSON_GetValueByName(valueObj, JSON_KEY_LINK);
                 char *linkString = parcBuffer_ToString(parcJSONValue_GetString(value));
-                printf("    %s -> %s\n", prefixString, linkString);
+                value = parcJSON_GetValueByName(valueObj, JSON_KEY_COST);
+                if (value != NULL) {
+                    int64_t cost = parcJSONValue_GetInteger(value);
+                    value = parcJSON_GetValueByName(valueObj, JSON_KEY_WEIGHT);
+                    int64_t weight = (value != NULL) ? parcJSONValue_GetInteger(value) : AthenaNexthop_DefaultWeight;
+                    printf("    %s -> %s (cost %" PRId64 ", weight %" PRId64 ")\n", prefixString, linkString, cost, weight);
+                } else {
+                    printf("    %s -> %s\n", prefixString, linkString);
+                }
                 parcMemory_Deallocate(&prefixString);
                 parcMemory_Deallocate(&linkString);
             }
@@ -605,6 +640,225 @@ _athenactl_SetLogLevel(PARCIdentity *identity, int argc, char **argv)
     return 0;
 }
 
+static int
+_athenactl_SetStrategy(PARCIdentity *identity, int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: set strategy <prefix> multicast/best-route/load-balance/random/adaptive\n");
+        return 1;
+    }
+
+    CCNxName *name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_FIBSetStrategy);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    char strategyArguments[MAXPATHLEN];
+    sprintf(strategyArguments, "%s %s", argv[0], argv[1]);
+    PARCBuffer *payload = parcBuffer_AllocateCString(strategyArguments);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    const char *result = athenactl_SendInterestControl(identity, interest);
+    if (result) {
+        printf("FIB: %s\n", result);
+        parcMemory_Deallocate(&result);
+    }
+
+    ccnxMetaMessage_Release(&interest);
+
+    return 0;
+}
+
+static int
+_athenactl_SetQueue(PARCIdentity *identity, int argc, char **argv)
+{
+    if (argc < 4) {
+        printf("usage: set queue <linkname/default> control/interest/interestReturn/contentObject <weight> <queue limit>\n");
+        return 1;
+    }
+
+    CCNxName *name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_LinkQueue);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    char queueArguments[MAXPATHLEN];
+    sprintf(queueArguments, "%s %s %s %s", argv[0], argv[1], argv[2], argv[3]);
+    PARCBuffer *payload = parcBuffer_AllocateCString(queueArguments);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    const char *result = athenactl_SendInterestControl(identity, interest);
+    if (result) {
+        printf("Link: %s\n", result);
+        parcMemory_Deallocate(&result);
+    }
+
+    ccnxMetaMessage_Release(&interest);
+
+    return 0;
+}
+
+static int
+_athenactl_SetShaping(PARCIdentity *identity, int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: set shaping <linkname/default> <bits per second> [<max delay ms>]\n");
+        return 1;
+    }
+
+    CCNxName *name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_LinkShape);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    char shapeArguments[MAXPATHLEN];
+    if (argc >= 3) {
+        sprintf(shapeArguments, "%s %s %s", argv[0], argv[1], argv[2]);
+    } else {
+        sprintf(shapeArguments, "%s %s", argv[0], argv[1]);
+    }
+    PARCBuffer *payload = parcBuffer_AllocateCString(shapeArguments);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    const char *result = athenactl_SendInterestControl(identity, interest);
+    if (result) {
+        printf("Link: %s\n", result);
+        parcMemory_Deallocate(&result);
+    }
+
+    ccnxMetaMessage_Release(&interest);
+
+    return 0;
+}
+
+static int
+_athenactl_SetOverflow(PARCIdentity *identity, int argc, char **argv)
+{
+    if (argc < 1) {
+        printf("usage: set overflow reject/evictOldest/evictSoonestExpiring\n");
+        return 1;
+    }
+
+    CCNxName *name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_PITOverflow);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    PARCBuffer *payload = parcBuffer_AllocateCString(argv[0]);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    const char *result = athenactl_SendInterestControl(identity, interest);
+    if (result) {
+        printf("PIT: %s\n", result);
+        parcMemory_Deallocate(&result);
+    }
+
+    ccnxMetaMessage_Release(&interest);
+
+    return 0;
+}
+
+static int
+_athenactl_SetQuota(PARCIdentity *identity, int argc, char **argv)
+{
+    if (argc < 1) {
+        printf("usage: set quota none/static/proportional [<limit>]\n");
+        return 1;
+    }
+
+    CCNxName *name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_PITQuota);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    char quotaArguments[MAXPATHLEN];
+    if (argc >= 2) {
+        sprintf(quotaArguments, "%s %s", argv[0], argv[1]);
+    } else {
+        sprintf(quotaArguments, "%s", argv[0]);
+    }
+    PARCBuffer *payload = parcBuffer_AllocateCString(quotaArguments);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    const char *result = athenactl_SendInterestControl(identity, interest);
+    if (result) {
+        printf("PIT: %s\n", result);
+        parcMemory_Deallocate(&result);
+    }
+
+    ccnxMetaMessage_Release(&interest);
+
+    return 0;
+}
+
+static char *
+_athenactl_ReadRouteFile(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    char *routes = NULL;
+    if ((fseek(file, 0, SEEK_END) == 0)) {
+        long size = ftell(file);
+        if ((size >= 0) && (fseek(file, 0, SEEK_SET) == 0)) {
+            routes = parcMemory_Allocate(size + 1);
+            assertNotNull(routes, "parcMemory_Allocate(%ld) returned NULL", size + 1);
+            size_t length = fread(routes, 1, size, file);
+            routes[length] = '\0';
+        }
+    }
+    fclose(file);
+
+    return routes;
+}
+
+static int
+_athenactl_LoadRoutes(PARCIdentity *identity, int argc, char **argv)
+{
+    if (argc < 1) {
+        printf("usage: load routes <route file>\n");
+        return 1;
+    }
+
+    // The routes are read here and sent as the payload, the forwarder doesn't read files for its peers
+    char *routes = _athenactl_ReadRouteFile(argv[0]);
+    if (routes == NULL) {
+        printf("Unable to read route file %s\n", argv[0]);
+        return 1;
+    }
+
+    CCNxName *name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_FIBLoad);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    PARCBuffer *payload = parcBuffer_AllocateCString(routes);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+    parcMemory_Deallocate(&routes);
+
+    const char *result = athenactl_SendInterestControl(identity, interest);
+    if (result) {
+        printf("FIB: %s\n", result);
+        parcMemory_Deallocate(&result);
+    }
+
+    ccnxMetaMessage_Release(&interest);
+
+    return 0;
+}
+
+static int
+_athenactl_Load(PARCIdentity *identity, int argc, char **argv)
+{
+    if ((argc >= 1) && (strcasecmp(argv[0], SUBCOMMAND_LOAD_ROUTES) == 0)) {
+        return _athenactl_LoadRoutes(identity, --argc, &argv[1]);
+    }
+    printf("usage: load routes <file>\n");
+    return 1;
+}
+
 static int
 _athenactl_UnSetDebug(PARCIdentity *identity, int argc, char **argv)
 {
@@ -627,7 +881,7 @@ static int
 _athenactl_Set(PARCIdentity *identity, int argc, char **argv)
 {
     if (argc < 1) {
-        printf("usage: set level/debug\n");
+        printf("usage: set level/debug/strategy/queue/shaping/overflow/quota\n");
         return 1;
     }
 
@@ -639,7 +893,22 @@ _athenactl_Set(PARCIdentity *identity, int argc, char **argv)
     if (strcasecmp(subcommand, SUBCOMMAND_SET_LEVEL) == 0) {
         return _athenactl_SetLogLevel(identity, --argc, &argv[1]);
     }
-    printf("usage: set level/debug\n");
+    if (strcasecmp(subcommand, SUBCOMMAND_SET_STRATEGY) == 0) {
+        return _athenactl_SetStrategy(identity, --argc, &argv[1]);
+    }
+    if (strcasecmp(subcommand, SUBCOMMAND_SET_QUEUE) == 0) {
+        return _athenactl_SetQueue(identity, --argc, &argv[1]);
+    }
+    if (strcasecmp(subcommand, SUBCOMMAND_SET_SHAPING) == 0) {
+        return _athenactl_SetShaping(identity, --argc, &argv[1]);
+    }
+    if (strcasecmp(subcommand, SUBCOMMAND_SET_OVERFLOW) == 0) {
+        return _athenactl_SetOverflow(identity, --argc, &argv[1]);
+    }
+    if (strcasecmp(subcommand, SUBCOMMAND_SET_QUOTA) == 0) {
+        return _athenactl_SetQuota(identity, --argc, &argv[1]);
+    }
+    printf("usage: set level/debug/strategy/queue/shaping/overflow/quota\n");
     return 1;
 }
 
@@ -753,7 +1022,7 @@ int
 athenactl_Command(PARCIdentity *identity, int argc, char **argv)
 {
     if (argc < 1) {
-        printf("commands: add/list/remove/set/unset/spawn/quit\n");
+        printf("commands: add/list/remove/load/set/unset/spawn/quit\n");
         return 1;
     }
 
@@ -768,6 +1037,9 @@ athenactl_Command(PARCIdentity *identity, int argc, char **argv)
     if (strcasecmp(command, COMMAND_REMOVE) == 0) {
         return _athenactl_Remove(identity, --argc, &argv[1]);
     }
+    if (strcasecmp(command, COMMAND_LOAD) == 0) {
+        return _athenactl_Load(identity, --argc, &argv[1]);
+    }
     if (strcasecmp(command, COMMAND_SET) == 0) {
         return _athenactl_Set(identity, --argc, &argv[1]);
     }
@@ -784,7 +1056,7 @@ athenactl_Command(PARCIdentity *identity, int argc, char **argv)
         return _athenactl_InputCommand(identity, argc, &argv[0]);
     }
     printf("athenactl: unknown command\n");
-    printf("commands: add/list/remove/set/unset/spawn/quit\n");
+    printf("commands: add/list/remove/load/set/unset/spawn/quit\n");
     printf("      or: <ccnx URI> <payload>\n");
     return 1;
 }
@@ -798,9 +1070,20 @@ athenactl_Usage(void)
     printf("            <options> == local=<true/false>\n");
     printf("        remove link <linkname>\n");
     printf("        list <links/routes>\n");
-    printf("        add route <linkname> lci:/<path>\n");
+    printf("        add route <linkname> lci:/<path> [<cost> [<weight>]]\n");
     printf("        remove route <linkname> lci:/<path>\n");
+    printf("        load routes <file>\n");
+    printf("            <file> == one \"lci:/<path> <linkname> [<cost> [<weight>]]\" per line, replaces all routes\n");
     printf("        set level <off/notice/info/debug/error/all>\n");
+    printf("        set strategy lci:/<path> <multicast/best-route/load-balance/random/adaptive>\n");
+    printf("        set queue <linkname/default> <control/interest/interestReturn/contentObject> <weight> <queue limit>\n");
+    printf("            egress queues are serviced in proportion to their weight, default sets the links created afterwards\n");
+    printf("        set shaping <linkname/default> <bits per second> [<max delay ms>]\n");
+    printf("            paces Interests so their Content Objects fit the link bandwidth, 0 disables shaping\n");
+    printf("        set overflow <reject/evictOldest/evictSoonestExpiring>\n");
+    printf("            how new Interests are handled when the PIT is full, rejected Interests are returned as Congestion\n");
+    printf("        set quota <none/static/proportional> [<limit>]\n");
+    printf("            limits the PIT entries each link may have pending, in entries or in percent of its share of the PIT\n");
     printf("        spawn <port>\n");
     printf("        quit\n");
     printf("        <ccnx URI> <payload>\n");
@@ -276,6 +276,14 @@ _parseCommandLine(Athena *athena, int argc, char **argv)
                 ccnxName_Release(&addLink);
             }
         }
+        // Local applications can connect over a unix domain socket, where the platform provides one
+        PARCURI *localURI = parcURI_Parse(AthenaDefaultLocalConnectionURI);
+        if (athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, localURI) != NULL) {
+            CCNxName *addLink = ccnxName_CreateFromCString(CCNxNameAthenaCommand_LinkConnect);
+            athenaInterestControl_LogConfigurationChange(athena, addLink, "%s", AthenaDefaultLocalConnectionURI);
+            ccnxName_Release(&addLink);
+        }
+        parcURI_Release(&localURI);
     }
 }
 
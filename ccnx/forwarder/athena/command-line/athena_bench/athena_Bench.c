@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#include <ccnx/forwarder/athena/athena.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
+
+#include "athena_Bench.h"
+
+uint64_t
+athenaBench_Now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+uint64_t
+athenaBench_TimerOverhead(void)
+{
+    static uint64_t overhead = UINT64_MAX;
+
+    if (overhead == UINT64_MAX) {
+        for (int i = 0; i < 1000; i++) {
+            uint64_t start = athenaBench_Now();
+            uint64_t elapsed = athenaBench_Now() - start;
+            if (elapsed < overhead) {
+                overhead = elapsed;
+            }
+        }
+    }
+    return overhead;
+}
+
+uint64_t
+athenaBench_Elapsed(uint64_t start)
+{
+    uint64_t elapsed = athenaBench_Now() - start;
+    uint64_t overhead = athenaBench_TimerOverhead();
+    return (elapsed > overhead) ? elapsed - overhead : 0;
+}
+
+size_t
+athenaBench_ResidentMemory(void)
+{
+    size_t result = 0;
+#ifdef __linux__
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm != NULL) {
+        unsigned long size;
+        unsigned long resident;
+        if (fscanf(statm, "%lu %lu", &size, &resident) == 2) {
+            result = resident * (size_t) sysconf(_SC_PAGESIZE);
+        }
+        fclose(statm);
+    }
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        result = usage.ru_maxrss; // bytes on Darwin
+    }
+#endif
+    return result;
+}
+
+static uint64_t _allocations = 0;
+
+static void *
+_countingAllocate(size_t size)
+{
+    _allocations++;
+    return parcStdlibMemory_Allocate(size);
+}
+
+static void *
+_countingAllocateAndClear(size_t size)
+{
+    _allocations++;
+    return parcStdlibMemory_AllocateAndClear(size);
+}
+
+static int
+_countingMemAlign(void **pointer, size_t alignment, size_t size)
+{
+    _allocations++;
+    return parcStdlibMemory_MemAlign(pointer, alignment, size);
+}
+
+static void *
+_countingReallocate(void *pointer, size_t newSize)
+{
+    _allocations++;
+    return parcStdlibMemory_Reallocate(pointer, newSize);
+}
+
+static char *
+_countingStringDuplicate(const char *string, size_t length)
+{
+    _allocations++;
+    return parcStdlibMemory_StringDuplicate(string, length);
+}
+
+static PARCMemoryInterface _countingMemory = {
+    .Allocate         = (uintptr_t) _countingAllocate,
+    .AllocateAndClear = (uintptr_t) _countingAllocateAndClear,
+    .MemAlign         = (uintptr_t) _countingMemAlign,
+    .Deallocate       = (uintptr_t) parcStdlibMemory_Deallocate,
+    .Reallocate       = (uintptr_t) _countingReallocate,
+    .StringDuplicate  = (uintptr_t) _countingStringDuplicate,
+    .Outstanding      = (uintptr_t) parcStdlibMemory_Outstanding
+};
+
+void
+athenaBench_CountAllocations(void)
+{
+    parcMemory_SetInterface(&_countingMemory);
+}
+
+uint64_t
+athenaBench_GetAllocations(void)
+{
+    return _allocations;
+}
+
+CCNxName *
+athenaBench_CreatePrefix(size_t route)
+{
+    char uri[64];
+    sprintf(uri, "lci:/bench/r%zu", route);
+
+    CCNxName *prefix = ccnxName_CreateFromCString(uri);
+    assertNotNull(prefix, "Failed to create prefix %s", uri);
+    return prefix;
+}
+
+CCNxName *
+athenaBench_CreateName(size_t nameLength, size_t routes, const char *tag, size_t sequence)
+{
+    assertTrue(nameLength >= 3, "Benchmark names need at least 3 segments");
+
+    char uri[64 + strlen(tag) + (nameLength * 24)];
+    int length = sprintf(uri, "lci:/bench/r%zu", sequence % routes);
+    for (size_t segment = 3; segment < nameLength; segment++) {
+        length += sprintf(&uri[length], "/s%zu", segment);
+    }
+    sprintf(&uri[length], "/%s%zu", tag, sequence);
+
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    assertNotNull(name, "Failed to create name %s", uri);
+    return name;
+}
+
+CCNxMetaMessage *
+athenaBench_CreateReceivedMessage(CCNxMetaMessage *message)
+{
+    PARCBuffer *wireFormatBuffer = athenaTransportLinkModule_CreateMessageBuffer(message);
+    CCNxMetaMessage *result = ccnxMetaMessage_CreateFromWireFormatBuffer(wireFormatBuffer);
+    assertNotNull(result, "Failed to decode benchmark message");
+    parcBuffer_Release(&wireFormatBuffer);
+    return result;
+}
+
+bool
+athenaBench_ParseSizes(const char *list, AthenaBenchSizes *sizes)
+{
+    sizes->count = 0;
+    while (*list) {
+        char *end;
+        size_t size = strtoul(list, &end, 10);
+        if (end == list) {
+            return false;
+        }
+        if ((*end == 'k') || (*end == 'K')) {
+            size *= 1000;
+            end++;
+        } else if ((*end == 'm') || (*end == 'M')) {
+            size *= 1000000;
+            end++;
+        }
+        if ((size == 0) || (sizes->count == AthenaBench_MaxSizes) || ((*end != ',') && (*end != '\0'))) {
+            return false;
+        }
+        sizes->size[sizes->count++] = size;
+        list = (*end == ',') ? end + 1 : end;
+    }
+    return sizes->count > 0;
+}
+
+static void
+_componentUsage(const char *program)
+{
+    printf("usage: %s [-s sizes] [-o operations] [-l nameLength] [-p payloadSize]\n", program);
+    printf("    -s | --sizes      Comma separated table sizes (default 1k,10k,100k,1M,10M)\n");
+    printf("    -o | --ops        Number of timed lookups at each size (default 100000)\n");
+    printf("    -l | --length     Number of name segments, at least 3 (default 6)\n");
+    printf("    -p | --payload    Content Object payload size in bytes (default 64)\n");
+}
+
+static struct option _componentOptions[] = {
+    { .name = "sizes",   .has_arg = required_argument, .flag = NULL, .val = 's' },
+    { .name = "ops",     .has_arg = required_argument, .flag = NULL, .val = 'o' },
+    { .name = "length",  .has_arg = required_argument, .flag = NULL, .val = 'l' },
+    { .name = "payload", .has_arg = required_argument, .flag = NULL, .val = 'p' },
+    { .name = "help",    .has_arg = no_argument,       .flag = NULL, .val = 'h' },
+    { .name = NULL,      .has_arg = 0,                 .flag = NULL, .val = 0   },
+};
+
+void
+athenaBench_ParseComponentOptions(const char *program, int argc, char **argv, AthenaBenchComponentConfig *config)
+{
+    int c;
+
+    athenaBench_ParseSizes("1k,10k,100k,1M,10M", &config->sizes);
+    config->operations = 100000;
+    config->nameLength = 6;
+    config->payloadSize = 64;
+
+    while ((c = getopt_long(argc, argv, "s:o:l:p:h", _componentOptions, NULL)) != -1) {
+        switch (c) {
+            case 's':
+                if (athenaBench_ParseSizes(optarg, &config->sizes) != true) {
+                    _componentUsage(program);
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'o':
+                config->operations = strtoul(optarg, NULL, 10);
+                break;
+            case 'l':
+                config->nameLength = strtoul(optarg, NULL, 10);
+                break;
+            case 'p':
+                config->payloadSize = strtoul(optarg, NULL, 10);
+                break;
+            case 'h':
+            default:
+                _componentUsage(program);
+                exit(EXIT_FAILURE);
+                break;
+        }
+    }
+
+    if ((argc - optind) || (config->nameLength < 3)) {
+        _componentUsage(program);
+        exit(EXIT_FAILURE);
+    }
+}
+
+uint64_t
+athenaBench_Random(uint64_t *state)
+{
+    // xorshift64*
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+void
+athenaBench_PrintHeader(FILE *output)
+{
+    fprintf(output, "%-12s %12s %14s %12s %14s\n", "stage", "packets", "packets/sec", "ns/packet", "allocs/packet");
+}
+
+void
+athenaBench_PrintStage(FILE *output, const char *stage, uint64_t packets, uint64_t elapsed, uint64_t allocations)
+{
+    if (packets == 0) {
+        fprintf(output, "%-12s %12d %14s %12s %14s\n", stage, 0, "-", "-", "-");
+        return;
+    }
+    double packetsPerSecond = (elapsed > 0) ? ((double) packets * 1e9) / (double) elapsed : 0.0;
+    fprintf(output, "%-12s %12" PRIu64 " %14.0f %12.1f %14.2f\n", stage, packets, packetsPerSecond,
+            (double) elapsed / (double) packets, (double) allocations / (double) packets);
+}
+
+void
+athenaBenchLatency_Init(AthenaBenchLatency *latency)
+{
+    memset(latency, 0, sizeof(AthenaBenchLatency));
+}
+
+void
+athenaBenchLatency_Record(AthenaBenchLatency *latency, uint64_t elapsed)
+{
+    size_t bucket = elapsed;
+    if (elapsed >= AthenaBenchLatency_SubBuckets) {
+        // 16 linear sub-buckets within each power of two from 16 up
+        int exponent = 63 - __builtin_clzll(elapsed);
+        size_t subBucket = (elapsed >> (exponent - 4)) & (AthenaBenchLatency_SubBuckets - 1);
+        bucket = AthenaBenchLatency_SubBuckets * (exponent - 3) + subBucket;
+    }
+    latency->bucket[bucket]++;
+    latency->count++;
+    latency->total += elapsed;
+}
+
+// The smallest value that falls into a bucket
+static uint64_t
+_athenaBenchLatency_BucketValue(size_t bucket)
+{
+    if (bucket < AthenaBenchLatency_SubBuckets) {
+        return bucket;
+    }
+    size_t exponent = (bucket / AthenaBenchLatency_SubBuckets) + 3;
+    size_t subBucket = bucket % AthenaBenchLatency_SubBuckets;
+    return (uint64_t) (AthenaBenchLatency_SubBuckets + subBucket) << (exponent - 4);
+}
+
+uint64_t
+athenaBenchLatency_Percentile(const AthenaBenchLatency *latency, double percentile)
+{
+    uint64_t rank = (uint64_t) ((percentile / 100.0) * (double) latency->count);
+    if (rank >= latency->count) {
+        rank = (latency->count > 0) ? latency->count - 1 : 0;
+    }
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < AthenaBenchLatency_Buckets; bucket++) {
+        seen += latency->bucket[bucket];
+        if (seen > rank) {
+            return _athenaBenchLatency_BucketValue(bucket);
+        }
+    }
+    return 0;
+}
+
+void
+athenaBench_PrintCSVHeader(FILE *output)
+{
+    fprintf(output, "component,operation,entries,operations,ops_per_sec,p50_ns,p99_ns,bytes_per_entry\n");
+}
+
+void
+athenaBench_PrintCSV(FILE *output, const char *component, const char *operation, size_t entries,
+                     const AthenaBenchLatency *latency, double bytesPerEntry)
+{
+    double operationsPerSecond = 0.0;
+    if (latency->total > 0) {
+        operationsPerSecond = ((double) latency->count * 1e9) / (double) latency->total;
+    }
+    fprintf(output, "%s,%s,%zu,%" PRIu64 ",%.0f,%" PRIu64 ",%" PRIu64 ",%.1f\n", component, operation, entries,
+            latency->count, operationsPerSecond, athenaBenchLatency_Percentile(latency, 50.0),
+            athenaBenchLatency_Percentile(latency, 99.0), bytesPerEntry);
+    fflush(output);
+}
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * Common support for the athena benchmark tools
+ *
+ * Benchmarks time a stage by bracketing it with athenaBench_Now and count the libparc allocations
+ * made within it with athenaBench_GetAllocations once athenaBench_CountAllocations has been called.
+ * Component benchmarks time each operation and collect the times in an AthenaBenchLatency histogram
+ * to report latency percentiles.
+ */
+#ifndef athena_Bench_h
+#define athena_Bench_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <ccnx/common/ccnx_Name.h>
+#include <ccnx/transport/common/transport_MetaMessage.h>
+
+/*
+ * Benchmark support interfaces
+ *
+ *    athenaBench_Now
+ *    athenaBench_TimerOverhead
+ *    athenaBench_Elapsed
+ *    athenaBench_ResidentMemory
+ *
+ *    athenaBench_CountAllocations
+ *    athenaBench_GetAllocations
+ *
+ *    athenaBench_CreatePrefix
+ *    athenaBench_CreateName
+ *    athenaBench_CreateReceivedMessage
+ *    athenaBench_ParseSizes
+ *    athenaBench_ParseComponentOptions
+ *    athenaBench_Random
+ *
+ *    athenaBench_PrintHeader
+ *    athenaBench_PrintStage
+ *
+ *    athenaBenchLatency_Init
+ *    athenaBenchLatency_Record
+ *    athenaBenchLatency_Percentile
+ *
+ *    athenaBench_PrintCSVHeader
+ *    athenaBench_PrintCSV
+ */
+
+// Log-linear histogram buckets, 16 per power of two, accurate to within 1/16th of a value
+#define AthenaBenchLatency_SubBuckets 16
+#define AthenaBenchLatency_Buckets    (AthenaBenchLatency_SubBuckets * 61)
+
+/**
+ * @typedef AthenaBenchLatency
+ * @brief histogram of operation times in nanoseconds
+ */
+typedef struct athena_bench_latency {
+    uint64_t count;
+    uint64_t total;
+    uint64_t bucket[AthenaBenchLatency_Buckets];
+} AthenaBenchLatency;
+
+/**
+ * @typedef AthenaBenchSizes
+ * @brief list of table sizes a component benchmark is run at
+ */
+#define AthenaBench_MaxSizes 16
+typedef struct athena_bench_sizes {
+    size_t count;
+    size_t size[AthenaBench_MaxSizes];
+} AthenaBenchSizes;
+
+/**
+ * @typedef AthenaBenchComponentConfig
+ * @brief options common to the component benchmarks
+ */
+typedef struct athena_bench_component_config {
+    AthenaBenchSizes sizes;
+    size_t operations;
+    size_t nameLength;
+    size_t payloadSize;
+} AthenaBenchComponentConfig;
+
+/**
+ * @abstract monotonic time in nanoseconds
+ * @discussion
+ * @return current time
+ * Example:
+ * @code
+ * {
+ *     uint64_t start = athenaBench_Now();
+ *     ...
+ *     uint64_t elapsed = athenaBench_Now() - start;
+ * }
+ * @endcode
+ */
+uint64_t athenaBench_Now(void);
+
+/**
+ * @abstract time taken by a pair of athenaBench_Now calls
+ * @discussion
+ * Measured once, used to take the cost of timing out of individually timed operations.
+ * @return timer overhead in nanoseconds
+ * Example:
+ * @code
+ * {
+ *     uint64_t start = athenaBench_Now();
+ *     ...
+ *     uint64_t elapsed = athenaBench_Now() - start - athenaBench_TimerOverhead();
+ * }
+ * @endcode
+ */
+uint64_t athenaBench_TimerOverhead(void);
+
+/**
+ * @abstract resident memory size of the process
+ * @discussion
+ * On platforms without /proc the peak resident size is returned instead.
+ * @return resident memory in bytes
+ * Example:
+ * @code
+ * {
+ *     size_t before = athenaBench_ResidentMemory();
+ *     ...
+ *     size_t used = athenaBench_ResidentMemory() - before;
+ * }
+ * @endcode
+ */
+size_t athenaBench_ResidentMemory(void);
+
+/**
+ * @abstract time since a single timed operation started, less the cost of timing it
+ * @discussion
+ * @param [in] start athenaBench_Now before the operation
+ * @return operation time in nanoseconds
+ * Example:
+ * @code
+ * {
+ *     uint64_t start = athenaBench_Now();
+ *     athenaFIB_AddRoute(athenaFIB, prefix, linkVector);
+ *     athenaBenchLatency_Record(&latency, athenaBench_Elapsed(start));
+ * }
+ * @endcode
+ */
+uint64_t athenaBench_Elapsed(uint64_t start);
+
+/**
+ * @abstract count every libparc memory allocation from here on
+ * @discussion
+ * Installs a libparc memory interface that passes through to the standard allocator and counts
+ * each allocation, reallocation and string duplication.  Call it before any objects are created.
+ * Example:
+ * @code
+ * {
+ *     athenaBench_CountAllocations();
+ *     uint64_t allocations = athenaBench_GetAllocations();
+ *     ...
+ *     allocations = athenaBench_GetAllocations() - allocations;
+ * }
+ * @endcode
+ */
+void athenaBench_CountAllocations(void);
+
+/**
+ * @abstract number of libparc allocations made since athenaBench_CountAllocations was called
+ * @discussion
+ * @return allocation count
+ * Example:
+ * @code
+ * {
+ *     uint64_t allocations = athenaBench_GetAllocations();
+ * }
+ * @endcode
+ */
+uint64_t athenaBench_GetAllocations(void);
+
+/**
+ * @abstract create a benchmark route prefix
+ * @discussion
+ * @param [in] route route number
+ * @return lci:/bench/r<route>
+ * Example:
+ * @code
+ * {
+ *     CCNxName *prefix = athenaBench_CreatePrefix(0);
+ *     athenaFIB_AddRoute(athenaFIB, prefix, linkVector);
+ *     ccnxName_Release(&prefix);
+ * }
+ * @endcode
+ */
+CCNxName *athenaBench_CreatePrefix(size_t route);
+
+/**
+ * @abstract create a benchmark name under one of a number of route prefixes
+ * @discussion
+ * Names are lci:/bench/r<route>/s3/.../<tag><sequence> where route is sequence modulo routes.
+ * @param [in] nameLength number of name segments, at least 3
+ * @param [in] routes number of route prefixes the names are spread over
+ * @param [in] tag distinguishes sets of names with the same sequence numbers
+ * @param [in] sequence sequence number
+ * @return new name
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = athenaBench_CreateName(6, 1000, "c", 42);
+ *     ...
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ */
+CCNxName *athenaBench_CreateName(size_t nameLength, size_t routes, const char *tag, size_t sequence);
+
+/**
+ * @abstract create a message in the form a transport link would hand it to the forwarder
+ * @discussion
+ * The message is encoded to its wire format and decoded again, as if it had just been received.
+ * @param [in] message message to encode
+ * @return decoded copy of the message, to be released by the caller
+ * Example:
+ * @code
+ * {
+ *     CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+ *     CCNxMetaMessage *received = athenaBench_CreateReceivedMessage(interest);
+ *     ccnxInterest_Release(&interest);
+ *     athena_ProcessMessage(athena, received, ingressVector);
+ *     ccnxMetaMessage_Release(&received);
+ * }
+ * @endcode
+ */
+CCNxMetaMessage *athenaBench_CreateReceivedMessage(CCNxMetaMessage *message);
+
+/**
+ * @abstract parse a comma separated list of table sizes
+ * @discussion
+ * Sizes may have a k or M suffix, as in 1k,10k,100k,1M,10M.
+ * @param [in] list string to parse
+ * @param [out] sizes parsed sizes
+ * @return true if the list was valid
+ * Example:
+ * @code
+ * {
+ *     AthenaBenchSizes sizes;
+ *     athenaBench_ParseSizes("1k,10k,100k", &sizes);
+ * }
+ * @endcode
+ */
+bool athenaBench_ParseSizes(const char *list, AthenaBenchSizes *sizes);
+
+/**
+ * @abstract parse the command line options of a component benchmark
+ * @discussion
+ * Prints the usage and exits if the options are not valid.
+ * @param [in] program name of the benchmark
+ * @param [in] argc argument count
+ * @param [in] argv arguments
+ * @param [out] config parsed options, with defaults for those not given
+ * Example:
+ * @code
+ * {
+ *     AthenaBenchComponentConfig config;
+ *     athenaBench_ParseComponentOptions("athena_bench_FIB", argc, argv, &config);
+ * }
+ * @endcode
+ */
+void athenaBench_ParseComponentOptions(const char *program, int argc, char **argv, AthenaBenchComponentConfig *config);
+
+/**
+ * @abstract pseudo random number sequence, repeatable from the same starting state
+ * @discussion
+ * @param [in,out] state generator state, any value but 0 to start with
+ * @return next number in the sequence
+ * Example:
+ * @code
+ * {
+ *     uint64_t state = 1;
+ *     size_t index = athenaBench_Random(&state) % entries;
+ * }
+ * @endcode
+ */
+uint64_t athenaBench_Random(uint64_t *state);
+
+/**
+ * @abstract print the column header for athenaBench_PrintStage
+ * @discussion
+ * @param [in] output stream to print to
+ * Example:
+ * @code
+ * {
+ *     athenaBench_PrintHeader(stdout);
+ * }
+ * @endcode
+ */
+void athenaBench_PrintHeader(FILE *output);
+
+/**
+ * @abstract print the throughput, time and allocations per packet of a benchmark stage
+ * @discussion
+ * @param [in] output stream to print to
+ * @param [in] stage name of the stage
+ * @param [in] packets number of packets processed in the stage
+ * @param [in] elapsed time spent processing them in nanoseconds
+ * @param [in] allocations number of allocations made processing them
+ * Example:
+ * @code
+ * {
+ *     athenaBench_PrintStage(stdout, "interest", packets, elapsed, allocations);
+ * }
+ * @endcode
+ */
+void athenaBench_PrintStage(FILE *output, const char *stage, uint64_t packets, uint64_t elapsed, uint64_t allocations);
+
+/**
+ * @abstract clear a latency histogram
+ * @discussion
+ * @param [in] latency histogram to clear
+ * Example:
+ * @code
+ * {
+ *     AthenaBenchLatency latency;
+ *     athenaBenchLatency_Init(&latency);
+ * }
+ * @endcode
+ */
+void athenaBenchLatency_Init(AthenaBenchLatency *latency);
+
+/**
+ * @abstract add an operation time to a latency histogram
+ * @discussion
+ * @param [in] latency histogram
+ * @param [in] elapsed operation time in nanoseconds
+ * Example:
+ * @code
+ * {
+ *     uint64_t start = athenaBench_Now();
+ *     ...
+ *     athenaBenchLatency_Record(&latency, athenaBench_Now() - start);
+ * }
+ * @endcode
+ */
+void athenaBenchLatency_Record(AthenaBenchLatency *latency, uint64_t elapsed);
+
+/**
+ * @abstract operation time below which a percentage of the recorded operations fall
+ * @discussion
+ * @param [in] latency histogram
+ * @param [in] percentile percentage, 0 to 100
+ * @return operation time in nanoseconds
+ * Example:
+ * @code
+ * {
+ *     uint64_t p99 = athenaBenchLatency_Percentile(&latency, 99.0);
+ * }
+ * @endcode
+ */
+uint64_t athenaBenchLatency_Percentile(const AthenaBenchLatency *latency, double percentile);
+
+/**
+ * @abstract print the column header for athenaBench_PrintCSV
+ * @discussion
+ * @param [in] output stream to print to
+ * Example:
+ * @code
+ * {
+ *     athenaBench_PrintCSVHeader(stdout);
+ * }
+ * @endcode
+ */
+void athenaBench_PrintCSVHeader(FILE *output);
+
+/**
+ * @abstract print a component benchmark result as a CSV line
+ * @discussion
+ * @param [in] output stream to print to
+ * @param [in] component component measured
+ * @param [in] operation operation measured
+ * @param [in] entries number of entries in the table while measuring
+ * @param [in] latency operation times
+ * @param [in] bytesPerEntry resident memory used per table entry
+ * Example:
+ * @code
+ * {
+ *     athenaBench_PrintCSV(stdout, "FIB", "lookup", entries, &latency, bytesPerEntry);
+ * }
+ * @endcode
+ */
+void athenaBench_PrintCSV(FILE *output, const char *component, const char *operation, size_t entries,
+                          const AthenaBenchLatency *latency, double bytesPerEntry);
+
+#endif // athena_Bench_h
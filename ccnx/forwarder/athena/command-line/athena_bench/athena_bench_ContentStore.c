@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * Athena content store benchmark
+ *
+ * For each table size fills an LRU content store, sized to hold every entry, with distinct Content
+ * Objects, timing athenaContentStore_PutContentObject, then times athenaContentStore_GetMatch of
+ * Interests for randomly chosen entries.  Results are printed as CSV.
+ */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena_ContentStore.h>
+#include <ccnx/forwarder/athena/athena_LRUContentStore.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+
+#include "athena_Bench.h"
+
+// Names are spread over this many prefixes, as they would be by the applications producing them
+#define BENCH_ROUTES 1000
+
+// The store accounts for each entry by its name and payload size, leave room for longer names
+static size_t
+_storeCapacityInMB(const AthenaBenchComponentConfig *config, size_t entries)
+{
+    CCNxName *name = athenaBench_CreateName(config->nameLength, BENCH_ROUTES, "c", entries);
+    char *nameString = ccnxName_ToString(name);
+    size_t entrySize = strlen(nameString) + config->payloadSize;
+    parcMemory_Deallocate(&nameString);
+    ccnxName_Release(&name);
+
+    return (((entries * entrySize) / (1024 * 1024)) * 2) + 1;
+}
+
+static void
+_benchContentStore(const AthenaBenchComponentConfig *config, size_t entries)
+{
+    PARCBuffer *payload = parcBuffer_Allocate(config->payloadSize);
+    memset(parcBuffer_Overlay(payload, 0), 0xA5, config->payloadSize);
+
+    size_t residentBefore = athenaBench_ResidentMemory();
+    AthenaLRUContentStoreConfig storeConfig;
+    storeConfig.capacityInMB = _storeCapacityInMB(config, entries);
+    AthenaContentStore *store = athenaContentStore_Create(&AthenaContentStore_LRUImplementation, &storeConfig);
+    assertNotNull(store, "Failed to create content store");
+
+    AthenaBenchLatency latency;
+    athenaBenchLatency_Init(&latency);
+    for (size_t sequence = 0; sequence < entries; sequence++) {
+        CCNxName *name = athenaBench_CreateName(config->nameLength, BENCH_ROUTES, "c", sequence);
+        CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+        CCNxMetaMessage *received = athenaBench_CreateReceivedMessage(contentObject);
+        ccnxContentObject_Release(&contentObject);
+        ccnxName_Release(&name);
+
+        uint64_t start = athenaBench_Now();
+        bool result = athenaContentStore_PutContentObject(store, received);
+        athenaBenchLatency_Record(&latency, athenaBench_Elapsed(start));
+        assertTrue(result, "Failed to store content object %zu", sequence);
+
+        ccnxMetaMessage_Release(&received);
+    }
+
+    size_t residentAfter = athenaBench_ResidentMemory();
+    double bytesPerEntry = 0.0;
+    if (residentAfter > residentBefore) {
+        bytesPerEntry = (double) (residentAfter - residentBefore) / (double) entries;
+    }
+    athenaBench_PrintCSV(stdout, "ContentStore", "put", entries, &latency, bytesPerEntry);
+
+    athenaBenchLatency_Init(&latency);
+    uint64_t random = 1;
+    for (size_t operation = 0; operation < config->operations; operation++) {
+        size_t sequence = athenaBench_Random(&random) % entries;
+        CCNxName *name = athenaBench_CreateName(config->nameLength, BENCH_ROUTES, "c", sequence);
+        CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+        ccnxName_Release(&name);
+
+        uint64_t start = athenaBench_Now();
+        CCNxContentObject *result = athenaContentStore_GetMatch(store, interest);
+        athenaBenchLatency_Record(&latency, athenaBench_Elapsed(start));
+        assertNotNull(result, "Expected content object %zu to be in the store", sequence);
+
+        ccnxInterest_Release(&interest);
+    }
+    athenaBench_PrintCSV(stdout, "ContentStore", "getMatch", entries, &latency, bytesPerEntry);
+
+    athenaContentStore_Release(&store);
+    parcBuffer_Release(&payload);
+}
+
+int
+main(int argc, char *argv[])
+{
+    AthenaBenchComponentConfig config;
+    athenaBench_ParseComponentOptions("athena_bench_ContentStore", argc, argv, &config);
+
+    athenaBench_PrintCSVHeader(stdout);
+    for (size_t i = 0; i < config.sizes.count; i++) {
+        _benchContentStore(&config, config.sizes.size[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * Athena FIB benchmark
+ *
+ * For each table size fills a FIB with distinct prefixes, timing athenaFIB_AddRoute, then times
+ * athenaFIB_Lookup and athenaFIB_LookupNexthops of longer names under randomly chosen prefixes.
+ * Results are printed as CSV.
+ */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <LongBow/runtime.h>
+
+#include <ccnx/forwarder/athena/athena_FIB.h>
+
+#include "athena_Bench.h"
+
+// Routes are spread over this many links
+#define BENCH_LINKS 8
+
+static void
+_benchLookup(AthenaFIB *fib, const AthenaBenchComponentConfig *config, size_t entries, bool nexthops,
+             double bytesPerEntry)
+{
+    AthenaBenchLatency latency;
+    athenaBenchLatency_Init(&latency);
+
+    uint64_t random = 1;
+    for (size_t operation = 0; operation < config->operations; operation++) {
+        size_t sequence = athenaBench_Random(&random) % entries;
+        CCNxName *name = athenaBench_CreateName(config->nameLength, entries, "c", sequence);
+
+        if (nexthops) {
+            uint64_t start = athenaBench_Now();
+            AthenaNexthopList *result = athenaFIB_LookupNexthops(fib, name, NULL);
+            athenaBenchLatency_Record(&latency, athenaBench_Elapsed(start));
+            assertNotNull(result, "Expected a route for name %zu", sequence);
+            athenaNexthopList_Release(&result);
+        } else {
+            uint64_t start = athenaBench_Now();
+            PARCBitVector *result = athenaFIB_Lookup(fib, name, NULL);
+            athenaBenchLatency_Record(&latency, athenaBench_Elapsed(start));
+            assertNotNull(result, "Expected a route for name %zu", sequence);
+            parcBitVector_Release(&result);
+        }
+        ccnxName_Release(&name);
+    }
+    athenaBench_PrintCSV(stdout, "FIB", nexthops ? "lookupNexthops" : "lookup", entries, &latency, bytesPerEntry);
+}
+
+static void
+_benchFIB(const AthenaBenchComponentConfig *config, size_t entries)
+{
+    PARCBitVector *linkVector[BENCH_LINKS];
+    for (int link = 0; link < BENCH_LINKS; link++) {
+        linkVector[link] = parcBitVector_Create();
+        parcBitVector_Set(linkVector[link], link);
+    }
+
+    size_t residentBefore = athenaBench_ResidentMemory();
+    AthenaFIB *fib = athenaFIB_CreateCapacity(entries);
+
+    AthenaBenchLatency latency;
+    athenaBenchLatency_Init(&latency);
+    for (size_t route = 0; route < entries; route++) {
+        CCNxName *prefix = athenaBench_CreatePrefix(route);
+
+        uint64_t start = athenaBench_Now();
+        bool result = athenaFIB_AddRoute(fib, prefix, linkVector[route % BENCH_LINKS]);
+        athenaBenchLatency_Record(&latency, athenaBench_Elapsed(start));
+        assertTrue(result, "Failed to add route %zu", route);
+
+        ccnxName_Release(&prefix);
+    }
+
+    size_t residentAfter = athenaBench_ResidentMemory();
+    double bytesPerEntry = 0.0;
+    if (residentAfter > residentBefore) {
+        bytesPerEntry = (double) (residentAfter - residentBefore) / (double) entries;
+    }
+    athenaBench_PrintCSV(stdout, "FIB", "add", entries, &latency, bytesPerEntry);
+
+    _benchLookup(fib, config, entries, false, bytesPerEntry);
+    _benchLookup(fib, config, entries, true, bytesPerEntry);
+
+    athenaFIB_Release(&fib);
+    for (int link = 0; link < BENCH_LINKS; link++) {
+        parcBitVector_Release(&linkVector[link]);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    AthenaBenchComponentConfig config;
+    athenaBench_ParseComponentOptions("athena_bench_FIB", argc, argv, &config);
+
+    athenaBench_PrintCSVHeader(stdout);
+    for (size_t i = 0; i < config.sizes.count; i++) {
+        _benchFIB(&config, config.sizes.size[i]);
+    }
+    return 0;
+}
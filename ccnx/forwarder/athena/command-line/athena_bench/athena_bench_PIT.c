@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * Athena PIT benchmark
+ *
+ * For each table size fills a PIT with distinct Interests, timing athenaPIT_AddInterest, then times
+ * athenaPIT_Match against randomly chosen entries.  Each matched entry is added back, untimed, so
+ * every match is made against a full table.  Results are printed as CSV.
+ */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <LongBow/runtime.h>
+
+#include <ccnx/forwarder/athena/athena_PIT.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+
+#include "athena_Bench.h"
+
+// Long enough that no entry expires during a run
+#define BENCH_INTEREST_LIFETIME (3600 * 1000)
+
+// Names are spread over this many prefixes, as they would be by the applications producing them
+#define BENCH_ROUTES 1000
+
+static void
+_addInterest(AthenaPIT *pit, const AthenaBenchComponentConfig *config, size_t sequence,
+             PARCBitVector *ingressVector, AthenaBenchLatency *latency)
+{
+    CCNxName *name = athenaBench_CreateName(config->nameLength, BENCH_ROUTES, "i", sequence);
+    CCNxInterest *interest = ccnxInterest_Create(name, BENCH_INTEREST_LIFETIME, NULL, NULL);
+    ccnxName_Release(&name);
+
+    PARCBitVector *expectedReturnVector;
+    uint64_t start = athenaBench_Now();
+    AthenaPITResolution result = athenaPIT_AddInterest(pit, interest, ingressVector, &expectedReturnVector);
+    uint64_t elapsed = athenaBench_Elapsed(start);
+    assertTrue(result == AthenaPITResolution_Forward, "Expected a new PIT entry for interest %zu", sequence);
+
+    if (latency != NULL) {
+        athenaBenchLatency_Record(latency, elapsed);
+    }
+    ccnxInterest_Release(&interest);
+}
+
+static void
+_benchPIT(const AthenaBenchComponentConfig *config, size_t entries)
+{
+    PARCBitVector *ingressVector = parcBitVector_Create();
+    parcBitVector_Set(ingressVector, 0);
+    PARCBitVector *producerVector = parcBitVector_Create();
+    parcBitVector_Set(producerVector, 1);
+
+    size_t residentBefore = athenaBench_ResidentMemory();
+    AthenaPIT *pit = athenaPIT_CreateCapacity(entries);
+
+    AthenaBenchLatency latency;
+    athenaBenchLatency_Init(&latency);
+    for (size_t sequence = 0; sequence < entries; sequence++) {
+        _addInterest(pit, config, sequence, ingressVector, &latency);
+    }
+
+    size_t residentAfter = athenaBench_ResidentMemory();
+    double bytesPerEntry = 0.0;
+    if (residentAfter > residentBefore) {
+        bytesPerEntry = (double) (residentAfter - residentBefore) / (double) entries;
+    }
+    athenaBench_PrintCSV(stdout, "PIT", "add", entries, &latency, bytesPerEntry);
+
+    athenaBenchLatency_Init(&latency);
+    uint64_t random = 1;
+    for (size_t operation = 0; operation < config->operations; operation++) {
+        size_t sequence = athenaBench_Random(&random) % entries;
+        CCNxName *name = athenaBench_CreateName(config->nameLength, BENCH_ROUTES, "i", sequence);
+
+        uint64_t start = athenaBench_Now();
+        PARCBitVector *egressVector = athenaPIT_Match(pit, name, NULL, NULL, producerVector);
+        athenaBenchLatency_Record(&latency, athenaBench_Elapsed(start));
+        assertTrue(parcBitVector_Equals(egressVector, ingressVector), "Expected interest %zu to match", sequence);
+
+        parcBitVector_Release(&egressVector);
+        ccnxName_Release(&name);
+        _addInterest(pit, config, sequence, ingressVector, NULL);
+    }
+    athenaBench_PrintCSV(stdout, "PIT", "match", entries, &latency, bytesPerEntry);
+
+    athenaPIT_Release(&pit);
+    parcBitVector_Release(&producerVector);
+    parcBitVector_Release(&ingressVector);
+}
+
+int
+main(int argc, char *argv[])
+{
+    AthenaBenchComponentConfig config;
+    athenaBench_ParseComponentOptions("athena_bench_PIT", argc, argv, &config);
+
+    athenaBench_PrintCSVHeader(stdout);
+    for (size_t i = 0; i < config.sizes.count; i++) {
+        _benchPIT(&config, config.sizes.size[i]);
+    }
+    return 0;
+}
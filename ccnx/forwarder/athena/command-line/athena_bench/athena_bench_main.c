@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * Athena forwarding benchmark
+ *
+ * Drives athena_ProcessMessage directly with synthetic Interests and Content Objects.  The forwarder
+ * is connected to three loopback (TEMPLATE) links: a consumer, a second consumer and a producer.
+ * Each batch of the workload runs through three stages:
+ *
+ *     interest  - Interests from the consumer, answered from the content store at the configured
+ *                 hit rate, otherwise added to the PIT and forwarded to the producer
+ *     aggregate - the same PIT bound Interests from the second consumer, aggregated in the PIT
+ *     content   - Content Objects from the producer satisfying the PIT, cached and forwarded to
+ *                 both consumers
+ *
+ * Only the athena_ProcessMessage calls are timed, which includes queuing the forwarded messages on
+ * the egress links.  Creating the messages and draining the links is done outside of the timing.
+ */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <inttypes.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+
+#include "athena_Bench.h"
+
+// Lifetime of the Interests preloaded into the PIT, long enough that none expire during a run
+#define BENCH_PENDING_LIFETIME (3600 * 1000)
+
+typedef struct bench_config {
+    size_t packets;
+    size_t batchSize;
+    size_t nameLength;
+    size_t fibSize;
+    size_t pitOccupancy;
+    size_t hitRate;
+    size_t payloadSize;
+    size_t storeSizeInMB;
+} _BenchConfig;
+
+typedef struct bench_stage {
+    const char *name;
+    uint64_t packets;
+    uint64_t elapsed;
+    uint64_t allocations;
+} _BenchStage;
+
+typedef struct bench {
+    _BenchConfig config;
+    Athena *athena;
+    PARCBitVector *consumer;
+    PARCBitVector *consumer2;
+    PARCBitVector *producer;
+    PARCBuffer *payload;
+} _Bench;
+
+static void
+_usage()
+{
+    printf("usage: athena_bench [-n packets] [-b batch] [-l nameLength] [-f fibSize] [-p pitOccupancy]\n");
+    printf("                    [-r hitRate] [-s payloadSize] [-c storeSize]\n");
+    printf("    -n | --packets    Number of Interests in the workload (default 100000)\n");
+    printf("    -b | --batch      Interests sent through all stages at a time (default 1000)\n");
+    printf("    -l | --length     Number of name segments, at least 3 (default 6)\n");
+    printf("    -f | --fib        Number of FIB routes the names are spread over (default 1000)\n");
+    printf("    -p | --pit        Number of unrelated Interests kept pending in the PIT (default 0)\n");
+    printf("    -r | --hitrate    Percentage of Interests answered from the content store (default 0)\n");
+    printf("    -s | --payload    Content Object payload size in bytes (default 1024)\n");
+    printf("    -c | --store      Size of the content store in mega bytes (default 64)\n");
+}
+
+static struct option options[] = {
+    { .name = "packets", .has_arg = required_argument, .flag = NULL, .val = 'n' },
+    { .name = "batch",   .has_arg = required_argument, .flag = NULL, .val = 'b' },
+    { .name = "length",  .has_arg = required_argument, .flag = NULL, .val = 'l' },
+    { .name = "fib",     .has_arg = required_argument, .flag = NULL, .val = 'f' },
+    { .name = "pit",     .has_arg = required_argument, .flag = NULL, .val = 'p' },
+    { .name = "hitrate", .has_arg = required_argument, .flag = NULL, .val = 'r' },
+    { .name = "payload", .has_arg = required_argument, .flag = NULL, .val = 's' },
+    { .name = "store",   .has_arg = required_argument, .flag = NULL, .val = 'c' },
+    { .name = "help",    .has_arg = no_argument,       .flag = NULL, .val = 'h' },
+    { .name = NULL,      .has_arg = 0,                 .flag = NULL, .val = 0   },
+};
+
+static void
+_parseCommandLine(_BenchConfig *config, int argc, char **argv)
+{
+    int c;
+
+    while ((c = getopt_long(argc, argv, "n:b:l:f:p:r:s:c:h", options, NULL)) != -1) {
+        switch (c) {
+            case 'n':
+                config->packets = strtoul(optarg, NULL, 10);
+                break;
+            case 'b':
+                config->batchSize = strtoul(optarg, NULL, 10);
+                break;
+            case 'l':
+                config->nameLength = strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                config->fibSize = strtoul(optarg, NULL, 10);
+                break;
+            case 'p':
+                config->pitOccupancy = strtoul(optarg, NULL, 10);
+                break;
+            case 'r':
+                config->hitRate = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                config->payloadSize = strtoul(optarg, NULL, 10);
+                break;
+            case 'c':
+                config->storeSizeInMB = strtoul(optarg, NULL, 10);
+                break;
+            case 'h':
+            default:
+                _usage();
+                exit(EXIT_FAILURE);
+                break;
+        }
+    }
+
+    if ((argc - optind) || (config->batchSize == 0) || (config->nameLength < 3) ||
+        (config->fibSize == 0) || (config->hitRate > 100)) {
+        _usage();
+        exit(EXIT_FAILURE);
+    }
+}
+
+static CCNxMetaMessage *
+_createInterest(const _BenchConfig *config, const char *tag, size_t sequence, uint32_t lifetime)
+{
+    CCNxName *name = athenaBench_CreateName(config->nameLength, config->fibSize, tag, sequence);
+    CCNxInterest *interest = ccnxInterest_Create(name, lifetime, NULL, NULL);
+    ccnxName_Release(&name);
+
+    CCNxMetaMessage *result = athenaBench_CreateReceivedMessage(interest);
+    ccnxInterest_Release(&interest);
+    return result;
+}
+
+static CCNxMetaMessage *
+_createContentObject(const _Bench *bench, const char *tag, size_t sequence)
+{
+    CCNxName *name = athenaBench_CreateName(bench->config.nameLength, bench->config.fibSize, tag, sequence);
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, bench->payload);
+    ccnxName_Release(&name);
+
+    CCNxMetaMessage *result = athenaBench_CreateReceivedMessage(contentObject);
+    ccnxContentObject_Release(&contentObject);
+    return result;
+}
+
+static PARCBitVector *
+_openLink(Athena *athena, const char *linkName)
+{
+    char linkSpecification[128];
+    sprintf(linkSpecification, "template:///name=%s/local=false", linkName);
+
+    PARCURI *connectionURI = parcURI_Parse(linkSpecification);
+    const char *result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+    assertNotNull(result, "Unable to open benchmark link %s", linkSpecification);
+    parcURI_Release(&connectionURI);
+
+    PARCBitVector *linkVector = parcBitVector_Create();
+    parcBitVector_Set(linkVector, athenaTransportLinkAdapter_LinkNameToId(athena->athenaTransportLinkAdapter, linkName));
+    return linkVector;
+}
+
+// Discard everything the forwarder sent to the loopback links
+static void
+_drainLinks(Athena *athena)
+{
+    PARCBitVector *ingressVector;
+    CCNxMetaMessage *message;
+    while ((message = athenaTransportLinkAdapter_Receive(athena->athenaTransportLinkAdapter, &ingressVector, 0)) != NULL) {
+        ccnxMetaMessage_Release(&message);
+        parcBitVector_Release(&ingressVector);
+    }
+}
+
+// Time athena_ProcessMessage over a set of messages, releasing them afterwards
+static void
+_runStage(_Bench *bench, _BenchStage *stage, CCNxMetaMessage **messages, size_t count, PARCBitVector *ingressVector)
+{
+    uint64_t allocations = athenaBench_GetAllocations();
+    uint64_t start = athenaBench_Now();
+    for (size_t i = 0; i < count; i++) {
+        athena_ProcessMessage(bench->athena, messages[i], ingressVector);
+    }
+    stage->elapsed += athenaBench_Now() - start;
+    stage->allocations += athenaBench_GetAllocations() - allocations;
+    stage->packets += count;
+
+    for (size_t i = 0; i < count; i++) {
+        ccnxMetaMessage_Release(&messages[i]);
+    }
+    _drainLinks(bench->athena);
+}
+
+static void
+_setup(_Bench *bench)
+{
+    const _BenchConfig *config = &bench->config;
+
+    bench->athena = athena_Create(config->storeSizeInMB);
+    parcLog_SetLevel(bench->athena->log, PARCLogLevel_Warning);
+    bench->consumer = _openLink(bench->athena, "consumer");
+    bench->consumer2 = _openLink(bench->athena, "consumer2");
+    bench->producer = _openLink(bench->athena, "producer");
+
+    bench->payload = parcBuffer_Allocate(config->payloadSize);
+    for (size_t i = 0; i < config->payloadSize; i++) {
+        parcBuffer_PutUint8(bench->payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(bench->payload);
+
+    for (size_t route = 0; route < config->fibSize; route++) {
+        CCNxName *prefix = athenaBench_CreatePrefix(route);
+        athenaFIB_AddRoute(bench->athena->athenaFIB, prefix, bench->producer);
+        ccnxName_Release(&prefix);
+    }
+
+    for (size_t i = 0; i < config->pitOccupancy; i++) {
+        CCNxMetaMessage *interest = _createInterest(config, "p", i, BENCH_PENDING_LIFETIME);
+        athena_ProcessMessage(bench->athena, interest, bench->consumer);
+        ccnxMetaMessage_Release(&interest);
+        if ((i % config->batchSize) == 0) {
+            _drainLinks(bench->athena);
+        }
+    }
+    _drainLinks(bench->athena);
+
+    size_t pending = athenaPIT_GetNumberOfTableEntries(bench->athena->athenaPIT);
+    if (pending < config->pitOccupancy) {
+        fprintf(stderr, "warning: the PIT only holds %zu of the %zu requested pending Interests\n",
+                pending, config->pitOccupancy);
+    }
+}
+
+static void
+_teardown(_Bench *bench)
+{
+    parcBuffer_Release(&bench->payload);
+    parcBitVector_Release(&bench->consumer);
+    parcBitVector_Release(&bench->consumer2);
+    parcBitVector_Release(&bench->producer);
+    athena_Release(&bench->athena);
+}
+
+static bool
+_isStoreHit(const _BenchConfig *config, size_t sequence)
+{
+    return (sequence % 100) < config->hitRate;
+}
+
+static void
+_run(_Bench *bench, _BenchStage *interestStage, _BenchStage *aggregateStage, _BenchStage *contentStage)
+{
+    const _BenchConfig *config = &bench->config;
+    CCNxMetaMessage **messages = parcMemory_Allocate(config->batchSize * sizeof(CCNxMetaMessage *));
+    assertNotNull(messages, "parcMemory_Allocate(%zu) returned NULL", config->batchSize * sizeof(CCNxMetaMessage *));
+
+    for (size_t first = 0; first < config->packets; first += config->batchSize) {
+        size_t last = first + config->batchSize;
+        if (last > config->packets) {
+            last = config->packets;
+        }
+
+        // Store the content the batch is to hit just before it is asked for so it can't have been evicted
+        for (size_t sequence = first; sequence < last; sequence++) {
+            if (_isStoreHit(config, sequence)) {
+                CCNxMetaMessage *contentObject = _createContentObject(bench, "c", sequence);
+                athenaContentStore_PutContentObject(bench->athena->athenaContentStore, contentObject);
+                ccnxMetaMessage_Release(&contentObject);
+            }
+        }
+
+        size_t count = 0;
+        for (size_t sequence = first; sequence < last; sequence++) {
+            messages[count++] = _createInterest(config, "c", sequence, CCNxInterestDefault_LifetimeMilliseconds);
+        }
+        _runStage(bench, interestStage, messages, count, bench->consumer);
+
+        count = 0;
+        for (size_t sequence = first; sequence < last; sequence++) {
+            if (!_isStoreHit(config, sequence)) {
+                messages[count++] = _createInterest(config, "c", sequence, CCNxInterestDefault_LifetimeMilliseconds);
+            }
+        }
+        _runStage(bench, aggregateStage, messages, count, bench->consumer2);
+
+        count = 0;
+        for (size_t sequence = first; sequence < last; sequence++) {
+            if (!_isStoreHit(config, sequence)) {
+                messages[count++] = _createContentObject(bench, "c", sequence);
+            }
+        }
+        _runStage(bench, contentStage, messages, count, bench->producer);
+    }
+
+    parcMemory_Deallocate(&messages);
+}
+
+int
+main(int argc, char *argv[])
+{
+    _Bench bench = {
+        .config     = {
+            .packets       = 100000,
+            .batchSize     = 1000,
+            .nameLength    = 6,
+            .fibSize       = 1000,
+            .pitOccupancy  = 0,
+            .hitRate       = 0,
+            .payloadSize   = 1024,
+            .storeSizeInMB = 64,
+        },
+    };
+    _parseCommandLine(&bench.config, argc, argv);
+
+    // Must be installed before anything is allocated through libparc
+    athenaBench_CountAllocations();
+
+    _setup(&bench);
+
+    _BenchStage interestStage = { .name = "interest" };
+    _BenchStage aggregateStage = { .name = "aggregate" };
+    _BenchStage contentStage = { .name = "content" };
+    _run(&bench, &interestStage, &aggregateStage, &contentStage);
+
+    printf("packets=%zu batch=%zu nameLength=%zu fibSize=%zu pitOccupancy=%zu hitRate=%zu%% payloadSize=%zu storeSize=%zuMB\n",
+           bench.config.packets, bench.config.batchSize, bench.config.nameLength, bench.config.fibSize,
+           bench.config.pitOccupancy, bench.config.hitRate, bench.config.payloadSize, bench.config.storeSizeInMB);
+    athenaBench_PrintHeader(stdout);
+    _BenchStage *stages[] = { &interestStage, &aggregateStage, &contentStage };
+    _BenchStage total = { .name = "total" };
+    for (int i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+        athenaBench_PrintStage(stdout, stages[i]->name, stages[i]->packets, stages[i]->elapsed, stages[i]->allocations);
+        total.packets += stages[i]->packets;
+        total.elapsed += stages[i]->elapsed;
+        total.allocations += stages[i]->allocations;
+    }
+    athenaBench_PrintStage(stdout, total.name, total.packets, total.elapsed, total.allocations);
+
+    _teardown(&bench);
+    return 0;
+}
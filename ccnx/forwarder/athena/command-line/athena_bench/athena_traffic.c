@@ -0,0 +1,617 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * Athena traffic generator and sink
+ *
+ * Measures a running forwarder end to end.  The producer opens a link to the forwarder, registers
+ * its prefix over that link and answers every Interest under the prefix with a Content Object of
+ * the configured size.  The consumer opens a second link and sends Interests under the prefix,
+ * either as fast as the pipeline window allows or paced at a fixed rate, and times each one until
+ * it is satisfied.  Both halves normally run in the same process, but either can be run on its own
+ * to put the producer behind a different forwarder.
+ *
+ * Names are <prefix>/<run>/<sequence>, the run identifier keeps a repeated run from being answered
+ * out of the forwarder's content store.  An Interest is counted lost when an InterestReturn comes
+ * back for it or when it is still unsatisfied after the Interest lifetime, a Content Object that
+ * arrives after its Interest was counted lost is reported as late.
+ */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <sys/param.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_URI.h>
+
+#include <ccnx/forwarder/athena/athena.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkAdapter.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_InterestReturn.h>
+
+#include "athena_Bench.h"
+
+#define TRAFFIC_CONSUMER_LINK "traffic_consumer"
+#define TRAFFIC_PRODUCER_LINK "traffic_producer"
+
+// How long to wait for the forwarder to acknowledge the producer's route registration
+#define TRAFFIC_REGISTRATION_TIMEOUT (2 * 1000)
+
+typedef struct traffic_config {
+    const char *connectionURI;
+    const char *prefix;
+    bool consumer;
+    bool producer;
+    size_t rate;
+    size_t window;
+    size_t payloadSize;
+    size_t duration;
+    size_t timeout;
+} _TrafficConfig;
+
+// An outstanding Interest, slots are indexed by sequence modulo the window size
+typedef struct traffic_slot {
+    uint64_t sequence;
+    uint64_t sent;
+    bool pending;
+} _TrafficSlot;
+
+typedef struct traffic_stats {
+    uint64_t sent;
+    uint64_t satisfied;
+    uint64_t returned;
+    uint64_t expired;
+    uint64_t late;
+    uint64_t answered;
+    uint64_t bytes;
+} _TrafficStats;
+
+typedef struct traffic {
+    _TrafficConfig config;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter;
+    PARCBitVector *consumer;
+    PARCBitVector *producer;
+    int consumerLinkId;
+    int producerLinkId;
+    bool linkClosed;
+    CCNxName *runName;
+    char *runPrefix;
+    size_t runSegments;
+    PARCBuffer *payload;
+    _TrafficSlot *slots;
+    size_t outstanding;
+    uint64_t nextSequence;
+    uint64_t nextSendTime;
+    _TrafficStats stats;
+    AthenaBenchLatency latency;
+} _Traffic;
+
+static void
+_usage()
+{
+    printf("usage: athena_traffic [-c <protocol>://<address>:<port>] [-m mode] [-n prefix] [-r rate] [-w window]\n");
+    printf("                      [-s payloadSize] [-d duration] [-t timeout]\n");
+    printf("    -c | --connect   Forwarder to connect to (default tcp://localhost:9695)\n");
+    printf("    -m | --mode      both, consumer or producer (default both)\n");
+    printf("    -n | --prefix    Name prefix of the traffic (default lci:/athena/traffic)\n");
+    printf("    -r | --rate      Interests sent per second, 0 to be limited by the window only (default 0)\n");
+    printf("    -w | --window    Maximum number of outstanding Interests (default 16)\n");
+    printf("    -s | --payload   Content Object payload size in bytes (default 1024)\n");
+    printf("    -d | --duration  Seconds to send Interests, or to answer them, for (default 10)\n");
+    printf("    -t | --timeout   Interest lifetime in milli seconds (default 1000)\n");
+}
+
+static struct option options[] = {
+    { .name = "connect",  .has_arg = required_argument, .flag = NULL, .val = 'c' },
+    { .name = "mode",     .has_arg = required_argument, .flag = NULL, .val = 'm' },
+    { .name = "prefix",   .has_arg = required_argument, .flag = NULL, .val = 'n' },
+    { .name = "rate",     .has_arg = required_argument, .flag = NULL, .val = 'r' },
+    { .name = "window",   .has_arg = required_argument, .flag = NULL, .val = 'w' },
+    { .name = "payload",  .has_arg = required_argument, .flag = NULL, .val = 's' },
+    { .name = "duration", .has_arg = required_argument, .flag = NULL, .val = 'd' },
+    { .name = "timeout",  .has_arg = required_argument, .flag = NULL, .val = 't' },
+    { .name = "help",     .has_arg = no_argument,       .flag = NULL, .val = 'h' },
+    { .name = NULL,       .has_arg = 0,                 .flag = NULL, .val = 0   },
+};
+
+static void
+_parseCommandLine(_TrafficConfig *config, int argc, char **argv)
+{
+    int c;
+
+    while ((c = getopt_long(argc, argv, "c:m:n:r:w:s:d:t:h", options, NULL)) != -1) {
+        switch (c) {
+            case 'c':
+                config->connectionURI = optarg;
+                break;
+            case 'm':
+                if (strcasecmp(optarg, "both") == 0) {
+                    config->consumer = true;
+                    config->producer = true;
+                } else if (strcasecmp(optarg, "consumer") == 0) {
+                    config->consumer = true;
+                    config->producer = false;
+                } else if (strcasecmp(optarg, "producer") == 0) {
+                    config->consumer = false;
+                    config->producer = true;
+                } else {
+                    _usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'n':
+                config->prefix = optarg;
+                break;
+            case 'r':
+                config->rate = strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                config->window = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                config->payloadSize = strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                config->duration = strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                config->timeout = strtoul(optarg, NULL, 10);
+                break;
+            case 'h':
+            default:
+                _usage();
+                exit(EXIT_FAILURE);
+                break;
+        }
+    }
+
+    if ((argc - optind) || (config->window == 0) || (config->timeout == 0)) {
+        _usage();
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Called by the link adapter when the forwarder closes one of our links
+static void
+_removeLink(void *context, PARCBitVector *linkVector)
+{
+    _Traffic *traffic = (_Traffic *) context;
+    traffic->linkClosed = true;
+}
+
+static PARCBitVector *
+_openLink(_Traffic *traffic, const char *linkName, int *linkId)
+{
+    char linkSpecification[MAXPATHLEN];
+    snprintf(linkSpecification, sizeof(linkSpecification), "%s/name=%s", traffic->config.connectionURI, linkName);
+
+    PARCURI *connectionURI = parcURI_Parse(linkSpecification);
+    if (connectionURI == NULL) {
+        fprintf(stderr, "Unable to parse %s\n", linkSpecification);
+        exit(EXIT_FAILURE);
+    }
+    const char *result = athenaTransportLinkAdapter_Open(traffic->athenaTransportLinkAdapter, connectionURI);
+    parcURI_Release(&connectionURI);
+    if (result == NULL) {
+        fprintf(stderr, "Unable to connect to %s\n", linkSpecification);
+        exit(EXIT_FAILURE);
+    }
+
+    *linkId = athenaTransportLinkAdapter_LinkNameToId(traffic->athenaTransportLinkAdapter, linkName);
+    PARCBitVector *linkVector = parcBitVector_Create();
+    parcBitVector_Set(linkVector, *linkId);
+    return linkVector;
+}
+
+static bool
+_fromLink(PARCBitVector *ingressVector, PARCBitVector *linkVector)
+{
+    return (linkVector != NULL) && parcBitVector_Contains(linkVector, ingressVector);
+}
+
+static void
+_send(_Traffic *traffic, CCNxMetaMessage *message, PARCBitVector *egressVector)
+{
+    athena_EncodeMessage(message);
+    PARCBitVector *failedLinks = athenaTransportLinkAdapter_Send(traffic->athenaTransportLinkAdapter, message, egressVector);
+    if (failedLinks) {
+        parcBitVector_Release(&failedLinks);
+    }
+}
+
+/**
+ * Register the traffic prefix with the forwarder over the producer link, the same request as
+ * "athenactl add route <prefix>", and wait for the forwarder's response.
+ */
+static void
+_registerPrefix(_Traffic *traffic)
+{
+    CCNxName *name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_FIBAddRoute);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    PARCBuffer *payload = parcBuffer_AllocateCString(traffic->config.prefix);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+    _send(traffic, interest, traffic->producer);
+    ccnxInterest_Release(&interest);
+
+    bool registered = false;
+    uint64_t deadline = athenaBench_Now() + (TRAFFIC_REGISTRATION_TIMEOUT * 1000000ULL);
+    while (!registered && !traffic->linkClosed && (athenaBench_Now() < deadline)) {
+        PARCBitVector *ingressVector;
+        CCNxMetaMessage *message = athenaTransportLinkAdapter_Receive(traffic->athenaTransportLinkAdapter, &ingressVector, 1);
+        if (message == NULL) {
+            continue;
+        }
+        if (ccnxMetaMessage_IsContentObject(message) && _fromLink(ingressVector, traffic->producer)) {
+            CCNxContentObject *contentObject = ccnxMetaMessage_GetContentObject(message);
+            if (ccnxName_StartsWith(ccnxContentObject_GetName(contentObject), name)) {
+                PARCBuffer *response = ccnxContentObject_GetPayload(contentObject);
+                char *responseString = response ? parcBuffer_ToString(response) : NULL;
+                printf("registration: %s\n", responseString ? responseString : "(no response)");
+                if (responseString) {
+                    parcMemory_Deallocate(&responseString);
+                }
+                registered = true;
+            }
+        }
+        ccnxMetaMessage_Release(&message);
+        parcBitVector_Release(&ingressVector);
+    }
+    ccnxName_Release(&name);
+
+    if (!registered) {
+        fprintf(stderr, "No response from the forwarder to registering %s\n", traffic->config.prefix);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void
+_answerInterest(_Traffic *traffic, CCNxInterest *interest, PARCBitVector *ingressVector)
+{
+    CCNxContentObject *contentObject =
+        ccnxContentObject_CreateWithNameAndPayload(ccnxInterest_GetName(interest), traffic->payload);
+    _send(traffic, contentObject, ingressVector);
+    ccnxContentObject_Release(&contentObject);
+    traffic->stats.answered++;
+}
+
+// Find the outstanding Interest a response is for, NULL if it is not one of ours or no longer pending
+static _TrafficSlot *
+_findSlot(_Traffic *traffic, const CCNxName *name)
+{
+    if ((ccnxName_GetSegmentCount(name) != (traffic->runSegments + 1)) || !ccnxName_StartsWith(name, traffic->runName)) {
+        return NULL;
+    }
+
+    CCNxNameSegment *segment = ccnxName_GetSegment(name, traffic->runSegments);
+    char *value = parcBuffer_ToString(ccnxNameSegment_GetValue(segment));
+    uint64_t sequence = strtoull(value, NULL, 10);
+    parcMemory_Deallocate(&value);
+
+    _TrafficSlot *slot = &traffic->slots[sequence % traffic->config.window];
+    if (!slot->pending || (slot->sequence != sequence)) {
+        traffic->stats.late++;
+        return NULL;
+    }
+    return slot;
+}
+
+static void
+_releaseSlot(_Traffic *traffic, _TrafficSlot *slot)
+{
+    slot->pending = false;
+    traffic->outstanding--;
+}
+
+static void
+_satisfyInterest(_Traffic *traffic, CCNxContentObject *contentObject, uint64_t now)
+{
+    _TrafficSlot *slot = _findSlot(traffic, ccnxContentObject_GetName(contentObject));
+    if (slot) {
+        athenaBenchLatency_Record(&traffic->latency, now - slot->sent);
+        PARCBuffer *payload = ccnxContentObject_GetPayload(contentObject);
+        traffic->stats.bytes += payload ? parcBuffer_Remaining(payload) : 0;
+        traffic->stats.satisfied++;
+        _releaseSlot(traffic, slot);
+    }
+}
+
+static void
+_returnInterest(_Traffic *traffic, CCNxInterestReturn *interestReturn)
+{
+    // The InterestReturn carries the original Interest's name
+    _TrafficSlot *slot = _findSlot(traffic, ccnxInterest_GetName(interestReturn));
+    if (slot) {
+        traffic->stats.returned++;
+        _releaseSlot(traffic, slot);
+    }
+}
+
+static void
+_expireInterests(_Traffic *traffic, uint64_t now)
+{
+    uint64_t lifetime = traffic->config.timeout * 1000000ULL;
+    for (size_t i = 0; (i < traffic->config.window) && (traffic->outstanding > 0); i++) {
+        _TrafficSlot *slot = &traffic->slots[i];
+        if (slot->pending && ((now - slot->sent) > lifetime)) {
+            traffic->stats.expired++;
+            _releaseSlot(traffic, slot);
+        }
+    }
+}
+
+// Send Interests while the window has room and, when pacing, while they are due
+static void
+_sendInterests(_Traffic *traffic, uint64_t now)
+{
+    uint64_t interval = traffic->config.rate ? (1000000000ULL / traffic->config.rate) : 0;
+
+    while (traffic->outstanding < traffic->config.window) {
+        if (interval && (now < traffic->nextSendTime)) {
+            break;
+        }
+        _TrafficSlot *slot = &traffic->slots[traffic->nextSequence % traffic->config.window];
+        if (slot->pending) {
+            break;
+        }
+
+        char nameString[MAXPATHLEN];
+        snprintf(nameString, sizeof(nameString), "%s/%" PRIu64, traffic->runPrefix, traffic->nextSequence);
+        CCNxName *name = ccnxName_CreateFromCString(nameString);
+        CCNxInterest *interest = ccnxInterest_Create(name, (uint32_t) traffic->config.timeout, NULL, NULL);
+        ccnxName_Release(&name);
+
+        slot->sequence = traffic->nextSequence++;
+        slot->sent = athenaBench_Now();
+        slot->pending = true;
+        traffic->outstanding++;
+        traffic->stats.sent++;
+
+        _send(traffic, interest, traffic->consumer);
+        ccnxInterest_Release(&interest);
+
+        if (interval) {
+            // Don't let a stalled window build up a burst of overdue Interests
+            traffic->nextSendTime = (traffic->nextSendTime + interval < now) ? now : traffic->nextSendTime + interval;
+        }
+    }
+}
+
+static void
+_receiveMessage(_Traffic *traffic, CCNxMetaMessage *message, PARCBitVector *ingressVector)
+{
+    if (ccnxMetaMessage_IsInterest(message)) {
+        if (_fromLink(ingressVector, traffic->producer)) {
+            _answerInterest(traffic, ccnxMetaMessage_GetInterest(message), ingressVector);
+        }
+    } else if (ccnxMetaMessage_IsContentObject(message)) {
+        if (_fromLink(ingressVector, traffic->consumer)) {
+            _satisfyInterest(traffic, ccnxMetaMessage_GetContentObject(message), athenaBench_Now());
+        }
+    } else if (ccnxMetaMessage_IsInterestReturn(message)) {
+        if (_fromLink(ingressVector, traffic->consumer)) {
+            _returnInterest(traffic, ccnxMetaMessage_GetInterestReturn(message));
+        }
+    }
+}
+
+static uint64_t
+_run(_Traffic *traffic)
+{
+    const _TrafficConfig *config = &traffic->config;
+    uint64_t start = athenaBench_Now();
+    uint64_t stop = start + (config->duration * 1000000000ULL);
+    // Once sending stops, give the last Interests their full lifetime to be satisfied
+    uint64_t drained = stop + (config->timeout * 1000000ULL);
+    uint64_t now = start;
+
+    traffic->nextSendTime = start;
+    while (!traffic->linkClosed) {
+        now = athenaBench_Now();
+        if (config->consumer) {
+            if (now < stop) {
+                _sendInterests(traffic, now);
+            } else if ((traffic->outstanding == 0) || (now >= drained)) {
+                break;
+            }
+            _expireInterests(traffic, now);
+        } else if (now >= stop) {
+            break;
+        }
+
+        PARCBitVector *ingressVector;
+        CCNxMetaMessage *message;
+        int timeout = 1;
+        while ((message = athenaTransportLinkAdapter_Receive(traffic->athenaTransportLinkAdapter, &ingressVector, timeout)) != NULL) {
+            _receiveMessage(traffic, message, ingressVector);
+            ccnxMetaMessage_Release(&message);
+            parcBitVector_Release(&ingressVector);
+            timeout = 0;
+        }
+    }
+
+    // Whatever is still outstanding was never answered
+    traffic->stats.expired += traffic->outstanding;
+    return now - start;
+}
+
+static void
+_report(const _Traffic *traffic, uint64_t elapsed)
+{
+    const _TrafficConfig *config = &traffic->config;
+    const _TrafficStats *stats = &traffic->stats;
+
+    printf("connect=%s prefix=%s rate=%zu window=%zu payloadSize=%zu duration=%zus timeout=%zums\n",
+           config->connectionURI, config->prefix, config->rate, config->window, config->payloadSize,
+           config->duration, config->timeout);
+    if (traffic->linkClosed) {
+        printf("warning: the forwarder closed a link during the run\n");
+    }
+
+    double seconds = elapsed / 1e9;
+    if (config->consumer) {
+        uint64_t lost = stats->returned + stats->expired;
+        printf("%10s %10s %10s %8s %10s %12s %12s %10s %10s %10s\n",
+               "sent", "satisfied", "lost", "loss", "late", "interests/s", "goodput", "p50", "p90", "p99");
+        printf("%10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %7.2f%% %10" PRIu64 " %12.0f %7.2f Mb/s %8.1fus %8.1fus %8.1fus\n",
+               stats->sent, stats->satisfied, lost, stats->sent ? (100.0 * lost / stats->sent) : 0.0, stats->late,
+               seconds > 0 ? (stats->satisfied / seconds) : 0.0,
+               seconds > 0 ? ((stats->bytes * 8) / seconds / 1e6) : 0.0,
+               athenaBenchLatency_Percentile(&traffic->latency, 50.0) / 1e3,
+               athenaBenchLatency_Percentile(&traffic->latency, 90.0) / 1e3,
+               athenaBenchLatency_Percentile(&traffic->latency, 99.0) / 1e3);
+        if (stats->returned) {
+            printf("%" PRIu64 " of the lost Interests were returned by the forwarder\n", stats->returned);
+        }
+    }
+    if (config->producer) {
+        printf("producer answered %" PRIu64 " Interests\n", stats->answered);
+    }
+}
+
+static void
+_setup(_Traffic *traffic)
+{
+    const _TrafficConfig *config = &traffic->config;
+
+    traffic->athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, traffic);
+
+    traffic->payload = parcBuffer_Allocate(config->payloadSize);
+    for (size_t i = 0; i < config->payloadSize; i++) {
+        parcBuffer_PutUint8(traffic->payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(traffic->payload);
+
+    char runPrefix[MAXPATHLEN];
+    snprintf(runPrefix, sizeof(runPrefix), "%s/run%08x", config->prefix,
+             (unsigned) ((athenaBench_Now() ^ getpid()) & 0xffffffff));
+    traffic->runPrefix = parcMemory_StringDuplicate(runPrefix, strlen(runPrefix));
+    traffic->runName = ccnxName_CreateFromCString(traffic->runPrefix);
+    if (traffic->runName == NULL) {
+        fprintf(stderr, "Unable to parse prefix %s\n", config->prefix);
+        exit(EXIT_FAILURE);
+    }
+    traffic->runSegments = ccnxName_GetSegmentCount(traffic->runName);
+
+    traffic->slots = parcMemory_AllocateAndClear(config->window * sizeof(_TrafficSlot));
+    athenaBenchLatency_Init(&traffic->latency);
+
+    if (config->producer) {
+        traffic->producer = _openLink(traffic, TRAFFIC_PRODUCER_LINK, &traffic->producerLinkId);
+        _registerPrefix(traffic);
+    }
+    if (config->consumer) {
+        traffic->consumer = _openLink(traffic, TRAFFIC_CONSUMER_LINK, &traffic->consumerLinkId);
+    }
+}
+
+static void
+_teardown(_Traffic *traffic)
+{
+    if (traffic->consumer) {
+        athenaTransportLinkAdapter_CloseByName(traffic->athenaTransportLinkAdapter, TRAFFIC_CONSUMER_LINK);
+        parcBitVector_Release(&traffic->consumer);
+    }
+    if (traffic->producer) {
+        athenaTransportLinkAdapter_CloseByName(traffic->athenaTransportLinkAdapter, TRAFFIC_PRODUCER_LINK);
+        parcBitVector_Release(&traffic->producer);
+    }
+    athenaTransportLinkAdapter_Destroy(&traffic->athenaTransportLinkAdapter);
+
+    parcMemory_Deallocate(&traffic->slots);
+    ccnxName_Release(&traffic->runName);
+    parcMemory_Deallocate(&traffic->runPrefix);
+    parcBuffer_Release(&traffic->payload);
+}
+
+int
+main(int argc, char *argv[])
+{
+    _Traffic *traffic = parcMemory_AllocateAndClear(sizeof(_Traffic));
+    assertNotNull(traffic, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_Traffic));
+    traffic->config = (_TrafficConfig) {
+        .connectionURI = "tcp://localhost:9695",
+        .prefix        = "lci:/athena/traffic",
+        .consumer      = true,
+        .producer      = true,
+        .rate          = 0,
+        .window        = 16,
+        .payloadSize   = 1024,
+        .duration      = 10,
+        .timeout       = 1000,
+    };
+    _parseCommandLine(&traffic->config, argc, argv);
+
+    _setup(traffic);
+    uint64_t elapsed = _run(traffic);
+    _report(traffic, elapsed);
+    _teardown(traffic);
+
+    parcMemory_Deallocate(&traffic);
+    return 0;
+}
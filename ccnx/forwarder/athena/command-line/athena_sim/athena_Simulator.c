@@ -0,0 +1,618 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
+#include <sys/time.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_URI.h>
+
+#include <ccnx/forwarder/athena/athena.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkModule.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkModuleSIM.h>
+
+#include "athena_Simulator.h"
+
+typedef enum {
+    _AthenaSimulatorEvent_Deliver, // a message arrives at one end of a link
+    _AthenaSimulatorEvent_Inject,  // an application sends a message to its forwarder
+    _AthenaSimulatorEvent_Timer
+} _AthenaSimulatorEventType;
+
+typedef struct athena_simulator_link _AthenaSimulatorLink;
+
+typedef struct athena_simulator_event {
+    uint64_t time;
+    uint64_t sequence; // orders events scheduled for the same time
+    _AthenaSimulatorEventType type;
+    _AthenaSimulatorLink *link;
+    int destination;
+    PARCBuffer *wireFormatBuffer;
+    AthenaSimulator_TimerCallback *callback;
+    AthenaSimulator_Context context;
+} _AthenaSimulatorEvent;
+
+// An application is attached through a link with only its forwarder end (0) open
+#define _AthenaSimulator_Application -1
+
+struct athena_simulator_link {
+    AthenaSimulator *simulator;
+    int index;
+    char channelName[64];
+    AthenaSIMChannel *channel;
+    int node[2];
+    int linkId[2];
+    AthenaSimulatorLinkConfig config;
+    uint64_t busyUntil[2]; // when each direction has finished sending what's been queued on it
+    AthenaSimulatorLinkStats stats;
+    AthenaSimulator_ApplicationCallback *callback;
+    AthenaSimulator_Context context;
+};
+
+struct athena_simulator {
+    uint64_t now;
+    uint64_t random;
+    uint32_t identifier;
+    PARCClock clock;
+
+    Athena **nodes;
+    size_t nodeCount;
+    size_t nodeCapacity;
+
+    _AthenaSimulatorLink **links;
+    size_t linkCount;
+    size_t linkCapacity;
+
+    // Binary min-heap ordered by time and sequence
+    _AthenaSimulatorEvent *events;
+    size_t eventCount;
+    size_t eventCapacity;
+    uint64_t nextSequence;
+};
+
+// Channel names are process wide, so each simulator gets a distinct prefix
+static uint32_t _simulatorCount = 0;
+
+static uint64_t
+_virtualClock_GetTime(const PARCClock *clock)
+{
+    const AthenaSimulator *simulator = (const AthenaSimulator *) clock->closure;
+    return simulator->now / 1000;
+}
+
+static void
+_virtualClock_GetTimeval(const PARCClock *clock, struct timeval *output)
+{
+    const AthenaSimulator *simulator = (const AthenaSimulator *) clock->closure;
+    output->tv_sec = simulator->now / 1000000;
+    output->tv_usec = simulator->now % 1000000;
+}
+
+// The clock is part of the simulator and lives as long as it does
+static PARCClock *
+_virtualClock_Acquire(const PARCClock *clock)
+{
+    return (PARCClock *) clock;
+}
+
+static void
+_virtualClock_Release(PARCClock **clockPtr)
+{
+    *clockPtr = NULL;
+}
+
+// Strategies on the simulated forwarders draw from the simulation's generator, keeping runs reproducible
+static uint64_t
+_athenaSimulator_StrategyRandom(void *context)
+{
+    return athenaSimulator_Random((AthenaSimulator *) context);
+}
+
+static bool
+_athenaSimulatorEvent_Before(const _AthenaSimulatorEvent *a, const _AthenaSimulatorEvent *b)
+{
+    return (a->time < b->time) || ((a->time == b->time) && (a->sequence < b->sequence));
+}
+
+static void
+_athenaSimulator_PushEvent(AthenaSimulator *simulator, _AthenaSimulatorEvent *event)
+{
+    if (simulator->eventCount == simulator->eventCapacity) {
+        size_t capacity = simulator->eventCapacity ? simulator->eventCapacity * 2 : 1024;
+        simulator->events = parcMemory_Reallocate(simulator->events, capacity * sizeof(_AthenaSimulatorEvent));
+        assertNotNull(simulator->events, "Unable to grow the simulator event queue to %zu events", capacity);
+        simulator->eventCapacity = capacity;
+    }
+
+    event->sequence = simulator->nextSequence++;
+    size_t index = simulator->eventCount++;
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!_athenaSimulatorEvent_Before(event, &simulator->events[parent])) {
+            break;
+        }
+        simulator->events[index] = simulator->events[parent];
+        index = parent;
+    }
+    simulator->events[index] = *event;
+}
+
+static void
+_athenaSimulator_PopEvent(AthenaSimulator *simulator, _AthenaSimulatorEvent *event)
+{
+    *event = simulator->events[0];
+    _AthenaSimulatorEvent last = simulator->events[--simulator->eventCount];
+
+    size_t index = 0;
+    for (;;) {
+        size_t child = (index * 2) + 1;
+        if (child >= simulator->eventCount) {
+            break;
+        }
+        if (((child + 1) < simulator->eventCount) &&
+            _athenaSimulatorEvent_Before(&simulator->events[child + 1], &simulator->events[child])) {
+            child++;
+        }
+        if (!_athenaSimulatorEvent_Before(&simulator->events[child], &last)) {
+            break;
+        }
+        simulator->events[index] = simulator->events[child];
+        index = child;
+    }
+    if (simulator->eventCount > 0) {
+        simulator->events[index] = last;
+    }
+}
+
+static void
+_athenaSimulator_Finalize(AthenaSimulator **simulatorPtr)
+{
+    AthenaSimulator *simulator = *simulatorPtr;
+
+    for (size_t i = 0; i < simulator->eventCount; i++) {
+        if (simulator->events[i].wireFormatBuffer) {
+            parcBuffer_Release(&simulator->events[i].wireFormatBuffer);
+        }
+    }
+    if (simulator->events) {
+        parcMemory_Deallocate(&simulator->events);
+    }
+
+    // Releasing a forwarder closes its links, which releases their channels
+    for (size_t node = 0; node < simulator->nodeCount; node++) {
+        athena_Release(&simulator->nodes[node]);
+    }
+    if (simulator->nodes) {
+        parcMemory_Deallocate(&simulator->nodes);
+    }
+
+    for (size_t link = 0; link < simulator->linkCount; link++) {
+        parcMemory_Deallocate(&simulator->links[link]);
+    }
+    if (simulator->links) {
+        parcMemory_Deallocate(&simulator->links);
+    }
+}
+
+parcObject_ExtendPARCObject(AthenaSimulator, _athenaSimulator_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementRelease(athenaSimulator, AthenaSimulator);
+
+AthenaSimulator *
+athenaSimulator_Create(uint64_t seed)
+{
+    AthenaSimulator *simulator = parcObject_CreateAndClearInstance(AthenaSimulator);
+    if (simulator != NULL) {
+        // xorshift state must not be zero
+        simulator->random = seed ? seed : 0x9e3779b97f4a7c15ULL;
+        simulator->identifier = __atomic_fetch_add(&_simulatorCount, 1, __ATOMIC_RELAXED);
+        simulator->clock = (PARCClock) {
+            .closure    = simulator,
+            .getTime    = _virtualClock_GetTime,
+            .getTimeval = _virtualClock_GetTimeval,
+            .acquire    = _virtualClock_Acquire,
+            .release    = _virtualClock_Release
+        };
+    }
+    return simulator;
+}
+
+uint64_t
+athenaSimulator_Random(AthenaSimulator *simulator)
+{
+    // xorshift64*
+    simulator->random ^= simulator->random >> 12;
+    simulator->random ^= simulator->random << 25;
+    simulator->random ^= simulator->random >> 27;
+    return simulator->random * 0x2545F4914F6CDD1DULL;
+}
+
+uint64_t
+athenaSimulator_Now(const AthenaSimulator *simulator)
+{
+    return simulator->now;
+}
+
+PARCClock *
+athenaSimulator_GetClock(AthenaSimulator *simulator)
+{
+    return &simulator->clock;
+}
+
+int
+athenaSimulator_AddNode(AthenaSimulator *simulator, size_t contentStoreSizeInMB)
+{
+    if (simulator->nodeCount == simulator->nodeCapacity) {
+        size_t capacity = simulator->nodeCapacity ? simulator->nodeCapacity * 2 : 64;
+        simulator->nodes = parcMemory_Reallocate(simulator->nodes, capacity * sizeof(Athena *));
+        assertNotNull(simulator->nodes, "Unable to grow the simulator node list to %zu nodes", capacity);
+        simulator->nodeCapacity = capacity;
+    }
+
+    Athena *athena = athena_Create(contentStoreSizeInMB);
+    athenaPIT_SetClock(athena->athenaPIT, &simulator->clock);
+    athena->strategyConfig = (AthenaBuiltInStrategyConfig) {
+        .clock         = &simulator->clock,
+        .random        = _athenaSimulator_StrategyRandom,
+        .randomContext = simulator
+    };
+    parcLog_SetLevel(athena->log, PARCLogLevel_Warning);
+    athenaTransportLinkAdapter_SetLogLevel(athena->athenaTransportLinkAdapter, PARCLogLevel_Warning);
+
+    simulator->nodes[simulator->nodeCount] = athena;
+    return (int) simulator->nodeCount++;
+}
+
+Athena *
+athenaSimulator_GetNode(AthenaSimulator *simulator, int node)
+{
+    assertTrue((node >= 0) && (node < simulator->nodeCount), "Node %d out of range", node);
+    return simulator->nodes[node];
+}
+
+size_t
+athenaSimulator_GetNodeCount(const AthenaSimulator *simulator)
+{
+    return simulator->nodeCount;
+}
+
+// Decide when a message sent on a link arrives, or whether it's lost, and queue its delivery
+static void
+_athenaSimulator_Transmit(AthenaTransportLinkModuleSIM_TransmitCallbackContext context,
+                          AthenaSIMChannel *channel, int destination, PARCBuffer *wireFormatBuffer)
+{
+    _AthenaSimulatorLink *link = (_AthenaSimulatorLink *) context;
+    AthenaSimulator *simulator = link->simulator;
+
+    link->channel = channel;
+    link->stats.sent++;
+
+    if ((link->config.loss > 0.0) &&
+        (((athenaSimulator_Random(simulator) >> 11) * (1.0 / 9007199254740992.0)) < link->config.loss)) {
+        link->stats.dropped++;
+        return;
+    }
+
+    int source = destination ^ 1;
+    uint64_t start = MAX(simulator->now, link->busyUntil[source]);
+    uint64_t transmission = 0;
+    if (link->config.bandwidth) {
+        transmission = ((parcBuffer_Remaining(wireFormatBuffer) * 8 * 1000000ULL) + link->config.bandwidth - 1) / link->config.bandwidth;
+    }
+    link->busyUntil[source] = start + transmission;
+
+    _AthenaSimulatorEvent event = {
+        .time             = start + transmission + link->config.latency,
+        .type             = _AthenaSimulatorEvent_Deliver,
+        .link             = link,
+        .destination      = destination,
+        .wireFormatBuffer = parcBuffer_Acquire(wireFormatBuffer),
+    };
+    _athenaSimulator_PushEvent(simulator, &event);
+}
+
+static _AthenaSimulatorLink *
+_athenaSimulator_CreateLink(AthenaSimulator *simulator, const AthenaSimulatorLinkConfig *config)
+{
+    if (simulator->linkCount == simulator->linkCapacity) {
+        size_t capacity = simulator->linkCapacity ? simulator->linkCapacity * 2 : 64;
+        simulator->links = parcMemory_Reallocate(simulator->links, capacity * sizeof(_AthenaSimulatorLink *));
+        assertNotNull(simulator->links, "Unable to grow the simulator link list to %zu links", capacity);
+        simulator->linkCapacity = capacity;
+    }
+
+    _AthenaSimulatorLink *link = parcMemory_AllocateAndClear(sizeof(_AthenaSimulatorLink));
+    assertNotNull(link, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_AthenaSimulatorLink));
+    link->simulator = simulator;
+    link->index = (int) simulator->linkCount;
+    link->node[0] = link->node[1] = _AthenaSimulator_Application;
+    link->linkId[0] = link->linkId[1] = -1;
+    if (config) {
+        link->config = *config;
+    }
+    snprintf(link->channelName, sizeof(link->channelName), "athenaSimulator%u.%d", simulator->identifier, link->index);
+    athenaTransportLinkModuleSIM_SetTransmitCallback(link->channelName, _athenaSimulator_Transmit, link);
+
+    simulator->links[simulator->linkCount++] = link;
+    return link;
+}
+
+// Open the next end of a link's channel on a forwarder
+static bool
+_athenaSimulator_OpenEnd(AthenaSimulator *simulator, _AthenaSimulatorLink *link, int end, int node, bool local)
+{
+    char linkName[MAXPATHLEN];
+    char linkSpecification[MAXPATHLEN];
+    snprintf(linkName, sizeof(linkName), "%s%d", local ? "application" : "link", link->index);
+    snprintf(linkSpecification, sizeof(linkSpecification), "sim://%s/name=%s/local=%s",
+             link->channelName, linkName, local ? "true" : "false");
+
+    Athena *athena = athenaSimulator_GetNode(simulator, node);
+    PARCURI *connectionURI = parcURI_Parse(linkSpecification);
+    const char *result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+    parcURI_Release(&connectionURI);
+    if (result == NULL) {
+        return false;
+    }
+
+    link->node[end] = node;
+    link->linkId[end] = athenaTransportLinkAdapter_LinkNameToId(athena->athenaTransportLinkAdapter, linkName);
+    return true;
+}
+
+int
+athenaSimulator_Connect(AthenaSimulator *simulator, int node0, int node1, const AthenaSimulatorLinkConfig *config)
+{
+    _AthenaSimulatorLink *link = _athenaSimulator_CreateLink(simulator, config);
+
+    if (!_athenaSimulator_OpenEnd(simulator, link, 0, node0, false) ||
+        !_athenaSimulator_OpenEnd(simulator, link, 1, node1, false)) {
+        return -1;
+    }
+    return link->index;
+}
+
+int
+athenaSimulator_AddApplication(AthenaSimulator *simulator, int node,
+                               AthenaSimulator_ApplicationCallback *callback, AthenaSimulator_Context context)
+{
+    _AthenaSimulatorLink *link = _athenaSimulator_CreateLink(simulator, NULL);
+    link->callback = callback;
+    link->context = context;
+
+    if (!_athenaSimulator_OpenEnd(simulator, link, 0, node, true)) {
+        return -1;
+    }
+    return link->index;
+}
+
+static _AthenaSimulatorLink *
+_athenaSimulator_GetLink(const AthenaSimulator *simulator, int link)
+{
+    assertTrue((link >= 0) && (link < simulator->linkCount), "Link %d out of range", link);
+    return simulator->links[link];
+}
+
+bool
+athenaSimulator_AddRoute(AthenaSimulator *simulator, int node, const CCNxName *prefix, int link)
+{
+    _AthenaSimulatorLink *simulatorLink = _athenaSimulator_GetLink(simulator, link);
+
+    int linkId;
+    if (simulatorLink->node[0] == node) {
+        linkId = simulatorLink->linkId[0];
+    } else if (simulatorLink->node[1] == node) {
+        linkId = simulatorLink->linkId[1];
+    } else {
+        return false;
+    }
+
+    PARCBitVector *linkVector = parcBitVector_Create();
+    parcBitVector_Set(linkVector, linkId);
+    bool result = athenaFIB_AddRoute(athenaSimulator_GetNode(simulator, node)->athenaFIB, prefix, linkVector);
+    parcBitVector_Release(&linkVector);
+    return result;
+}
+
+bool
+athenaSimulator_SetStrategy(AthenaSimulator *simulator, int node, const CCNxName *prefix, const char *strategyName)
+{
+    AthenaForwardingStrategyInterface *strategyInterface = athenaForwardingStrategy_LookupInterface(strategyName);
+    if (strategyInterface == NULL) {
+        return false;
+    }
+
+    Athena *athena = athenaSimulator_GetNode(simulator, node);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(strategyInterface, &athena->strategyConfig);
+    bool result = athenaFIB_SetStrategy(athena->athenaFIB, prefix, strategy);
+    athenaForwardingStrategy_Release(&strategy);
+    return result;
+}
+
+const AthenaSimulatorLinkStats *
+athenaSimulator_GetLinkStats(const AthenaSimulator *simulator, int link)
+{
+    return &_athenaSimulator_GetLink(simulator, link)->stats;
+}
+
+void
+athenaSimulator_Send(AthenaSimulator *simulator, int application, CCNxMetaMessage *message)
+{
+    _AthenaSimulatorLink *link = _athenaSimulator_GetLink(simulator, application);
+    assertTrue(link->node[1] == _AthenaSimulator_Application, "Link %d is not an application", application);
+
+    // The forwarder gets its own decoded copy, as it would from a real link
+    PARCBuffer *messageBuffer = athenaTransportLinkModule_CreateMessageBuffer(message);
+    _AthenaSimulatorEvent event = {
+        .time             = simulator->now,
+        .type             = _AthenaSimulatorEvent_Inject,
+        .link             = link,
+        .destination      = 0,
+        .wireFormatBuffer = parcBuffer_Copy(messageBuffer),
+    };
+    parcBuffer_Release(&messageBuffer);
+    _athenaSimulator_PushEvent(simulator, &event);
+}
+
+void
+athenaSimulator_Schedule(AthenaSimulator *simulator, uint64_t delay,
+                         AthenaSimulator_TimerCallback *callback, AthenaSimulator_Context context)
+{
+    _AthenaSimulatorEvent event = {
+        .time     = simulator->now + delay,
+        .type     = _AthenaSimulatorEvent_Timer,
+        .callback = callback,
+        .context  = context,
+    };
+    _athenaSimulator_PushEvent(simulator, &event);
+}
+
+// Process everything the forwarder's links have queued for it, including what it sends itself
+static void
+_athenaSimulator_DrainNode(AthenaSimulator *simulator, int node)
+{
+    Athena *athena = simulator->nodes[node];
+    PARCBitVector *ingressVector;
+    CCNxMetaMessage *message;
+
+    while ((message = athenaTransportLinkAdapter_Receive(athena->athenaTransportLinkAdapter, &ingressVector, 0)) != NULL) {
+        athena_ProcessMessage(athena, message, ingressVector);
+        parcBitVector_Release(&ingressVector);
+        ccnxMetaMessage_Release(&message);
+    }
+}
+
+static void
+_athenaSimulator_Deliver(AthenaSimulator *simulator, _AthenaSimulatorEvent *event)
+{
+    _AthenaSimulatorLink *link = event->link;
+    int node = link->node[event->destination];
+    size_t length = parcBuffer_Remaining(event->wireFormatBuffer);
+
+    if (node == _AthenaSimulator_Application) {
+        CCNxMetaMessage *message = ccnxMetaMessage_CreateFromWireFormatBuffer(event->wireFormatBuffer);
+        if (message) {
+            link->stats.delivered++;
+            link->stats.bytes += length;
+            link->callback(simulator, link->index, message, link->context);
+            ccnxMetaMessage_Release(&message);
+        }
+    } else if (athenaTransportLinkModuleSIM_Deliver(link->channel, event->destination, event->wireFormatBuffer)) {
+        link->stats.delivered++;
+        link->stats.bytes += length;
+        _athenaSimulator_DrainNode(simulator, node);
+    }
+}
+
+static void
+_athenaSimulator_Inject(AthenaSimulator *simulator, _AthenaSimulatorEvent *event)
+{
+    _AthenaSimulatorLink *link = event->link;
+    CCNxMetaMessage *message = ccnxMetaMessage_CreateFromWireFormatBuffer(event->wireFormatBuffer);
+    if (message) {
+        link->stats.sent++;
+        link->stats.delivered++;
+        link->stats.bytes += parcBuffer_Remaining(event->wireFormatBuffer);
+
+        Athena *athena = simulator->nodes[link->node[0]];
+        PARCBitVector *ingressVector = parcBitVector_Create();
+        parcBitVector_Set(ingressVector, link->linkId[0]);
+        athena_ProcessMessage(athena, message, ingressVector);
+        parcBitVector_Release(&ingressVector);
+        ccnxMetaMessage_Release(&message);
+    }
+}
+
+size_t
+athenaSimulator_Run(AthenaSimulator *simulator, uint64_t until)
+{
+    size_t processed = 0;
+
+    while ((simulator->eventCount > 0) && (simulator->events[0].time <= until)) {
+        _AthenaSimulatorEvent event;
+        _athenaSimulator_PopEvent(simulator, &event);
+        simulator->now = event.time;
+
+        switch (event.type) {
+            case _AthenaSimulatorEvent_Deliver:
+                _athenaSimulator_Deliver(simulator, &event);
+                break;
+            case _AthenaSimulatorEvent_Inject:
+                _athenaSimulator_Inject(simulator, &event);
+                break;
+            case _AthenaSimulatorEvent_Timer:
+                event.callback(simulator, event.context);
+                break;
+        }
+        if (event.wireFormatBuffer) {
+            parcBuffer_Release(&event.wireFormatBuffer);
+        }
+        processed++;
+    }
+
+    if ((until != UINT64_MAX) && (until > simulator->now)) {
+        simulator->now = until;
+    }
+    return processed;
+}
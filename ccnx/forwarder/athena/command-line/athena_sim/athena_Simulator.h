@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * In-process forwarder topology simulator
+ *
+ * A simulator holds any number of Athena forwarders, connected point to point by SIM links with a
+ * configured latency, bandwidth and loss.  Applications attach to a forwarder through a link of
+ * their own and exchange messages with it through callbacks.
+ *
+ * Nothing runs on its own.  Every message in flight and every application timer is an event on a
+ * single queue ordered by simulated time, and athenaSimulator_Run processes them in order, jumping
+ * the simulated clock from one event to the next.  The forwarders' PITs run on the simulated clock,
+ * so Interest lifetimes and response times are all in simulated time, and a run takes only as long
+ * as the forwarding work it contains rather than the time it simulates.
+ *
+ * A link serializes the messages sent in each direction at its bandwidth, so a message waits for
+ * the ones sent before it, and then arrives after the link latency.  Lost messages are dropped when
+ * they are sent.  Runs are deterministic for a given seed.
+ *
+ * The simulator relies on the SIM link module being linked into the executable, and on its symbols
+ * being exported so the link adapters find that copy rather than loading the shared library.
+ */
+#ifndef athena_Simulator_h
+#define athena_Simulator_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parc/algol/parc_Clock.h>
+
+#include <ccnx/forwarder/athena/athena.h>
+
+/*
+ * Simulator interfaces
+ *
+ *    athenaSimulator_Create
+ *    athenaSimulator_Release
+ *
+ *    athenaSimulator_AddNode
+ *    athenaSimulator_GetNode
+ *    athenaSimulator_GetNodeCount
+ *    athenaSimulator_Connect
+ *    athenaSimulator_AddRoute
+ *    athenaSimulator_SetStrategy
+ *    athenaSimulator_GetLinkStats
+ *
+ *    athenaSimulator_AddApplication
+ *    athenaSimulator_Send
+ *    athenaSimulator_Schedule
+ *
+ *    athenaSimulator_Now
+ *    athenaSimulator_GetClock
+ *    athenaSimulator_Random
+ *    athenaSimulator_Run
+ */
+
+/**
+ * @typedef AthenaSimulator
+ * @brief A set of forwarders and the links between them, run on a simulated clock
+ */
+struct athena_simulator;
+typedef struct athena_simulator AthenaSimulator;
+
+/**
+ * @typedef AthenaSimulatorLinkConfig
+ * @brief Characteristics of a simulated link, the same in both directions
+ */
+typedef struct athena_simulator_link_config {
+    uint64_t latency;   // propagation delay in microseconds
+    uint64_t bandwidth; // bits per second, 0 for unlimited
+    double loss;        // probability of a message being dropped, 0 to 1
+} AthenaSimulatorLinkConfig;
+
+/**
+ * @typedef AthenaSimulatorLinkStats
+ * @brief Messages carried by a simulated link, in both directions
+ */
+typedef struct athena_simulator_link_stats {
+    uint64_t sent;
+    uint64_t dropped;
+    uint64_t delivered;
+    uint64_t bytes;
+} AthenaSimulatorLinkStats;
+
+/**
+ * @typedef AthenaSimulator_ApplicationCallback
+ * @brief Called with each message a forwarder sends to an application
+ *
+ * The message is released after the callback returns, it must be acquired to be kept.
+ */
+typedef void *AthenaSimulator_Context;
+typedef void (AthenaSimulator_ApplicationCallback)(AthenaSimulator *simulator, int application,
+                                                   CCNxMetaMessage *message, AthenaSimulator_Context context);
+
+/**
+ * @typedef AthenaSimulator_TimerCallback
+ * @brief Called when a scheduled time is reached
+ */
+typedef void (AthenaSimulator_TimerCallback)(AthenaSimulator *simulator, AthenaSimulator_Context context);
+
+/**
+ * @abstract create an empty simulation
+ * @discussion
+ *
+ * @param [in] seed seed for the random number generator used to drop messages
+ * @return simulator instance
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaSimulator *simulator = athenaSimulator_Create(1);
+ *     ...
+ *     athenaSimulator_Release(&simulator);
+ * }
+ * @endcode
+ */
+AthenaSimulator *athenaSimulator_Create(uint64_t seed);
+
+/**
+ * @abstract release a simulation along with all of its forwarders
+ * @discussion
+ *
+ * Events still queued are discarded.
+ *
+ * @param [in] simulator instance
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaSimulator *simulator = athenaSimulator_Create(1);
+ *     ...
+ *     athenaSimulator_Release(&simulator);
+ * }
+ * @endcode
+ */
+void athenaSimulator_Release(AthenaSimulator **simulator);
+
+/**
+ * @abstract add a forwarder to the simulation
+ * @discussion
+ *
+ * The forwarder's PIT and the forwarding strategies bound on it, by athenaSimulator_SetStrategy or
+ * through its control interface, run on the simulated clock and draw from the simulation's random
+ * number generator.
+ *
+ * @param [in] simulator instance
+ * @param [in] contentStoreSizeInMB size of the forwarder's content store
+ * @return index of the new forwarder
+ *
+ * Example:
+ * @code
+ * {
+ *     int node = athenaSimulator_AddNode(simulator, 1);
+ * }
+ * @endcode
+ */
+int athenaSimulator_AddNode(AthenaSimulator *simulator, size_t contentStoreSizeInMB);
+
+/**
+ * @abstract get a simulated forwarder, to configure it or inspect its tables
+ * @discussion
+ *
+ * @param [in] simulator instance
+ * @param [in] node index of the forwarder
+ * @return forwarder instance, owned by the simulator
+ *
+ * Example:
+ * @code
+ * {
+ *     Athena *athena = athenaSimulator_GetNode(simulator, node);
+ *     size_t pending = athenaPIT_GetNumberOfPendingInterests(athena->athenaPIT);
+ * }
+ * @endcode
+ */
+Athena *athenaSimulator_GetNode(AthenaSimulator *simulator, int node);
+
+/**
+ * @abstract number of forwarders in the simulation
+ * @discussion
+ *
+ * @param [in] simulator instance
+ * @return number of forwarders
+ *
+ * Example:
+ * @code
+ * {
+ *     for (int node = 0; node < athenaSimulator_GetNodeCount(simulator); node++) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+size_t athenaSimulator_GetNodeCount(const AthenaSimulator *simulator);
+
+/**
+ * @abstract connect two forwarders with a simulated link
+ * @discussion
+ *
+ * @param [in] simulator instance
+ * @param [in] node0 index of the first forwarder
+ * @param [in] node1 index of the second forwarder
+ * @param [in] config characteristics of the link
+ * @return index of the new link, -1 if it could not be opened
+ *
+ * Example:
+ * @code
+ * {
+ *     AthenaSimulatorLinkConfig config = { .latency = 1000, .bandwidth = 100000000, .loss = 0.0 };
+ *     int link = athenaSimulator_Connect(simulator, node0, node1, &config);
+ * }
+ * @endcode
+ */
+int athenaSimulator_Connect(AthenaSimulator *simulator, int node0, int node1, const AthenaSimulatorLinkConfig *config);
+
+/**
+ * @abstract add a route on a forwarder through one of its links or applications
+ * @discussion
+ *
+ * @param [in] simulator instance
+ * @param [in] node index of the forwarder
+ * @param [in] prefix name prefix to route
+ * @param [in] link index of a link of the forwarder, or of an application attached to it
+ * @return true if the route was added
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *prefix = ccnxName_CreateFromCString("lci:/sim");
+ *     athenaSimulator_AddRoute(simulator, node, prefix, link);
+ *     ccnxName_Release(&prefix);
+ * }
+ * @endcode
+ */
+bool athenaSimulator_AddRoute(AthenaSimulator *simulator, int node, const CCNxName *prefix, int link);
+
+/**
+ * @abstract bind a forwarding strategy to a prefix on a forwarder
+ * @discussion
+ *
+ * The strategy measures simulated time and draws from the simulation's random number generator, as
+ * do strategies bound on the forwarder through its control interface.
+ *
+ * @param [in] simulator instance
+ * @param [in] node index of the forwarder
+ * @param [in] prefix name prefix the strategy applies to
+ * @param [in] strategyName name of a built-in strategy, e.g. "adaptive"
+ * @return true if the strategy was bound, false if the name is unknown
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *prefix = ccnxName_CreateFromCString("lci:/sim");
+ *     athenaSimulator_SetStrategy(simulator, node, prefix, "random");
+ *     ccnxName_Release(&prefix);
+ * }
+ * @endcode
+ */
+bool athenaSimulator_SetStrategy(AthenaSimulator *simulator, int node, const CCNxName *prefix, const char *strategyName);
+
+/**
+ * @abstract get the number of messages carried by a link
+ * @discussion
+ *
+ * @param [in] simulator instance
+ * @param [in] link index of the link
+ * @return link statistics, owned by the simulator
+ *
+ * Example:
+ * @code
+ * {
+ *     const AthenaSimulatorLinkStats *stats = athenaSimulator_GetLinkStats(simulator, link);
+ * }
+ * @endcode
+ */
+const AthenaSimulatorLinkStats *athenaSimulator_GetLinkStats(const AthenaSimulator *simulator, int link);
+
+/**
+ * @abstract attach an application to a forwarder
+ * @discussion
+ *
+ * The application's link has no latency, bandwidth limit or loss.  Producers add a route to the
+ * application with athenaSimulator_AddRoute.
+ *
+ * @param [in] simulator instance
+ * @param [in] node index of the forwarder
+ * @param [in] callback called with each message the forwarder sends to the application
+ * @param [in] context passed to the callback
+ * @return index of the application's link
+ *
+ * Example:
+ * @code
+ * {
+ *     int producer = athenaSimulator_AddApplication(simulator, node, _producerReceive, NULL);
+ *     athenaSimulator_AddRoute(simulator, node, prefix, producer);
+ * }
+ * @endcode
+ */
+int athenaSimulator_AddApplication(AthenaSimulator *simulator, int node,
+                                   AthenaSimulator_ApplicationCallback *callback, AthenaSimulator_Context context);
+
+/**
+ * @abstract send a message from an application to its forwarder
+ * @discussion
+ *
+ * The forwarder receives the message at the current simulated time, once the calling event has
+ * completed.
+ *
+ * @param [in] simulator instance
+ * @param [in] application index of the application's link
+ * @param [in] message message to send, it is encoded if it isn't already
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+ *     athenaSimulator_Send(simulator, consumer, interest);
+ *     ccnxInterest_Release(&interest);
+ * }
+ * @endcode
+ */
+void athenaSimulator_Send(AthenaSimulator *simulator, int application, CCNxMetaMessage *message);
+
+/**
+ * @abstract call a function at a later simulated time
+ * @discussion
+ *
+ * @param [in] simulator instance
+ * @param [in] delay microseconds from the current simulated time
+ * @param [in] callback function to call
+ * @param [in] context passed to the callback
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaSimulator_Schedule(simulator, 1000, _sendNextInterest, consumer);
+ * }
+ * @endcode
+ */
+void athenaSimulator_Schedule(AthenaSimulator *simulator, uint64_t delay,
+                              AthenaSimulator_TimerCallback *callback, AthenaSimulator_Context context);
+
+/**
+ * @abstract current simulated time
+ * @discussion
+ *
+ * @param [in] simulator instance
+ * @return microseconds since the simulation was created
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t sent = athenaSimulator_Now(simulator);
+ * }
+ * @endcode
+ */
+uint64_t athenaSimulator_Now(const AthenaSimulator *simulator);
+
+/**
+ * @abstract millisecond clock running on simulated time
+ * @discussion
+ *
+ * The forwarders' PITs and forwarding strategies already use this clock.  It can be passed to
+ * anything else that takes a PARCClock, and remains valid for the life of the simulator.
+ *
+ * @param [in] simulator instance
+ * @return clock instance
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t milliseconds = parcClock_GetTime(athenaSimulator_GetClock(simulator));
+ * }
+ * @endcode
+ */
+PARCClock *athenaSimulator_GetClock(AthenaSimulator *simulator);
+
+/**
+ * @abstract next value of the simulation's random number generator
+ * @discussion
+ *
+ * Applications drawing from the simulation's generator keep runs reproducible from the seed.
+ *
+ * @param [in] simulator instance
+ * @return uniformly distributed 64 bit value
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t item = athenaSimulator_Random(simulator) % catalogSize;
+ * }
+ * @endcode
+ */
+uint64_t athenaSimulator_Random(AthenaSimulator *simulator);
+
+/**
+ * @abstract process events in simulated time order
+ * @discussion
+ *
+ * Runs until the event queue is empty or the next event is after the given time.  The simulated
+ * clock is then advanced to the given time, unless it is UINT64_MAX.
+ *
+ * @param [in] simulator instance
+ * @param [in] until simulated time in microseconds to run to, UINT64_MAX to run until idle
+ * @return number of events processed
+ *
+ * Example:
+ * @code
+ * {
+ *     athenaSimulator_Run(simulator, athenaSimulator_Now(simulator) + 10 * 1000000);
+ * }
+ * @endcode
+ */
+size_t athenaSimulator_Run(AthenaSimulator *simulator, uint64_t until);
+
+#endif // athena_Simulator_h
@@ -0,0 +1,673 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+/*
+ * Athena topology simulator
+ *
+ * Builds a network of forwarders in a single process, connected by simulated links with the
+ * configured latency, bandwidth and loss, and runs a workload over it on a virtual clock.
+ *
+ * A producer application attached to node 0 answers every Interest under lci:/sim/content.  Each
+ * node routes the prefix over every neighbor on a shortest path towards node 0, and picks between
+ * them with the configured forwarding strategy.  Consumer applications, attached
+ * to nodes spread across the network, request lci:/sim/content/<rank> at a steady rate with the
+ * ranks drawn from a Zipf distribution over the catalog, so that popular content is cached on
+ * the way and served by the forwarders closer to the consumers.
+ *
+ * A consumer doesn't ask for content it's already waiting on, an Interest that's neither
+ * satisfied nor returned within its lifetime is counted as lost.
+ */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <math.h>
+#include <sys/time.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/forwarder/athena/athena.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_InterestReturn.h>
+
+#include "athena_Simulator.h"
+
+#define SIM_PREFIX "lci:/sim/content"
+
+typedef enum {
+    _SimTopology_Line,
+    _SimTopology_Tree,
+    _SimTopology_Grid,
+    _SimTopology_Random
+} _SimTopology;
+
+static const char *_simTopologyNames[] = { "line", "tree", "grid", "random" };
+
+typedef struct sim_config {
+    size_t nodes;
+    _SimTopology topology;
+    AthenaSimulatorLinkConfig link;
+    size_t consumers;
+    size_t rate;
+    size_t interests;
+    size_t catalog;
+    double alpha;
+    size_t storeSizeInMB;
+    size_t payloadSize;
+    size_t lifetime;
+    const char *strategy;
+    uint64_t seed;
+} _SimConfig;
+
+typedef struct sim_edge {
+    int node[2];
+    int link;
+} _SimEdge;
+
+typedef struct sim_stats {
+    uint64_t sent;
+    uint64_t coalesced;
+    uint64_t satisfied;
+    uint64_t returned;
+    uint64_t expired;
+    uint64_t answered;
+} _SimStats;
+
+typedef struct sim _Sim;
+
+typedef struct sim_consumer {
+    _Sim *sim;
+    int node;
+    int application;
+    size_t sent;
+    uint64_t *pending; // send time plus one by rank, zero when nothing is outstanding
+} _SimConsumer;
+
+struct sim {
+    _SimConfig config;
+    AthenaSimulator *simulator;
+
+    _SimEdge *edges;
+    size_t edgeCount;
+
+    int producer;
+    PARCBuffer *payload;
+    double *zipf; // cumulative distribution over the catalog ranks
+    _SimConsumer *consumers;
+
+    uint64_t *latency;
+    size_t latencyCount;
+    _SimStats stats;
+};
+
+static void
+_usage()
+{
+    printf("usage: athena_sim [-n nodes] [-t topology] [-l latency] [-b bandwidth] [-L loss] [-c consumers]\n");
+    printf("                  [-r rate] [-i interests] [-k catalog] [-a alpha] [-s storeSize] [-p payloadSize]\n");
+    printf("                  [-T lifetime] [-S strategy] [-x seed]\n");
+    printf("    -n | --nodes      Number of forwarders (default 100)\n");
+    printf("    -t | --topology   line, tree, grid or random (default tree)\n");
+    printf("    -l | --latency    Link latency in micro seconds (default 1000)\n");
+    printf("    -b | --bandwidth  Link bandwidth in Mb/s, 0 for unlimited (default 100)\n");
+    printf("    -L | --loss       Percentage of messages lost on each link (default 0)\n");
+    printf("    -c | --consumers  Number of consumer applications (default 10)\n");
+    printf("    -r | --rate       Interests sent per second by each consumer (default 100)\n");
+    printf("    -i | --interests  Interests sent by each consumer (default 1000)\n");
+    printf("    -k | --catalog    Number of distinct Content Objects (default 10000)\n");
+    printf("    -a | --alpha      Zipf exponent of the content popularity (default 0.8)\n");
+    printf("    -s | --store      Size of each content store in mega bytes (default 1)\n");
+    printf("    -p | --payload    Content Object payload size in bytes (default 1024)\n");
+    printf("    -T | --lifetime   Interest lifetime in milli seconds (default 4000)\n");
+    printf("    -S | --strategy   multicast, best-route, load-balance, random or adaptive (default best-route)\n");
+    printf("    -x | --seed       Random seed (default 1)\n");
+}
+
+static struct option options[] = {
+    { .name = "nodes",     .has_arg = required_argument, .flag = NULL, .val = 'n' },
+    { .name = "topology",  .has_arg = required_argument, .flag = NULL, .val = 't' },
+    { .name = "latency",   .has_arg = required_argument, .flag = NULL, .val = 'l' },
+    { .name = "bandwidth", .has_arg = required_argument, .flag = NULL, .val = 'b' },
+    { .name = "loss",      .has_arg = required_argument, .flag = NULL, .val = 'L' },
+    { .name = "consumers", .has_arg = required_argument, .flag = NULL, .val = 'c' },
+    { .name = "rate",      .has_arg = required_argument, .flag = NULL, .val = 'r' },
+    { .name = "interests", .has_arg = required_argument, .flag = NULL, .val = 'i' },
+    { .name = "catalog",   .has_arg = required_argument, .flag = NULL, .val = 'k' },
+    { .name = "alpha",     .has_arg = required_argument, .flag = NULL, .val = 'a' },
+    { .name = "store",     .has_arg = required_argument, .flag = NULL, .val = 's' },
+    { .name = "payload",   .has_arg = required_argument, .flag = NULL, .val = 'p' },
+    { .name = "lifetime",  .has_arg = required_argument, .flag = NULL, .val = 'T' },
+    { .name = "strategy",  .has_arg = required_argument, .flag = NULL, .val = 'S' },
+    { .name = "seed",      .has_arg = required_argument, .flag = NULL, .val = 'x' },
+    { .name = "help",      .has_arg = no_argument,       .flag = NULL, .val = 'h' },
+    { .name = NULL,        .has_arg = 0,                 .flag = NULL, .val = 0   },
+};
+
+static void
+_parseCommandLine(_SimConfig *config, int argc, char **argv)
+{
+    bool validTopology = true;
+    double loss = 0.0;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "n:t:l:b:L:c:r:i:k:a:s:p:T:S:x:h", options, NULL)) != -1) {
+        switch (c) {
+            case 'n':
+                config->nodes = strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                validTopology = false;
+                for (int i = 0; i < sizeof(_simTopologyNames) / sizeof(_simTopologyNames[0]); i++) {
+                    if (strcmp(optarg, _simTopologyNames[i]) == 0) {
+                        config->topology = (_SimTopology) i;
+                        validTopology = true;
+                    }
+                }
+                break;
+            case 'l':
+                config->link.latency = strtoull(optarg, NULL, 10);
+                break;
+            case 'b':
+                config->link.bandwidth = strtoull(optarg, NULL, 10) * 1000000ULL;
+                break;
+            case 'L':
+                loss = strtod(optarg, NULL);
+                config->link.loss = loss / 100.0;
+                break;
+            case 'c':
+                config->consumers = strtoul(optarg, NULL, 10);
+                break;
+            case 'r':
+                config->rate = strtoul(optarg, NULL, 10);
+                break;
+            case 'i':
+                config->interests = strtoul(optarg, NULL, 10);
+                break;
+            case 'k':
+                config->catalog = strtoul(optarg, NULL, 10);
+                break;
+            case 'a':
+                config->alpha = strtod(optarg, NULL);
+                break;
+            case 's':
+                config->storeSizeInMB = strtoul(optarg, NULL, 10);
+                break;
+            case 'p':
+                config->payloadSize = strtoul(optarg, NULL, 10);
+                break;
+            case 'T':
+                config->lifetime = strtoul(optarg, NULL, 10);
+                break;
+            case 'S':
+                config->strategy = optarg;
+                break;
+            case 'x':
+                config->seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'h':
+            default:
+                _usage();
+                exit(EXIT_FAILURE);
+                break;
+        }
+    }
+
+    bool validStrategy = (athenaForwardingStrategy_LookupInterface(config->strategy) != NULL);
+    if ((argc - optind) || !validTopology || !validStrategy || (config->nodes == 0) || (config->consumers == 0) ||
+        (config->rate == 0) || (config->catalog == 0) || (loss < 0.0) || (loss > 100.0)) {
+        _usage();
+        exit(EXIT_FAILURE);
+    }
+}
+
+static uint64_t
+_wallclock(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec * 1000000ULL) + now.tv_usec;
+}
+
+static double
+_uniform(_Sim *sim)
+{
+    return (athenaSimulator_Random(sim->simulator) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void
+_connect(_Sim *sim, int node0, int node1)
+{
+    int link = athenaSimulator_Connect(sim->simulator, node0, node1, &sim->config.link);
+    assertTrue(link >= 0, "Unable to connect node %d to node %d", node0, node1);
+    sim->edges = parcMemory_Reallocate(sim->edges, (sim->edgeCount + 1) * sizeof(_SimEdge));
+    sim->edges[sim->edgeCount++] = (_SimEdge) { .node = { node0, node1 }, .link = link };
+}
+
+static void
+_buildTopology(_Sim *sim)
+{
+    const _SimConfig *config = &sim->config;
+    int nodes = (int) config->nodes;
+
+    for (int node = 0; node < nodes; node++) {
+        athenaSimulator_AddNode(sim->simulator, config->storeSizeInMB);
+    }
+
+    switch (config->topology) {
+        case _SimTopology_Line:
+            for (int node = 1; node < nodes; node++) {
+                _connect(sim, node - 1, node);
+            }
+            break;
+        case _SimTopology_Tree:
+            for (int node = 1; node < nodes; node++) {
+                _connect(sim, (node - 1) / 2, node);
+            }
+            break;
+        case _SimTopology_Grid: {
+            int width = (int) ceil(sqrt(nodes));
+            for (int node = 0; node < nodes; node++) {
+                if (((node % width) + 1 < width) && (node + 1 < nodes)) {
+                    _connect(sim, node, node + 1);
+                }
+                if (node + width < nodes) {
+                    _connect(sim, node, node + width);
+                }
+            }
+            break;
+        }
+        case _SimTopology_Random:
+            // A random spanning tree, keeping the network connected, plus half as many extra links
+            for (int node = 1; node < nodes; node++) {
+                _connect(sim, (int) (athenaSimulator_Random(sim->simulator) % node), node);
+            }
+            for (int extra = 0; (nodes > 2) && (extra < nodes / 2); extra++) {
+                int node0 = (int) (athenaSimulator_Random(sim->simulator) % nodes);
+                int node1 = (int) (athenaSimulator_Random(sim->simulator) % nodes);
+                if (node0 != node1) {
+                    _connect(sim, node0, node1);
+                }
+            }
+            break;
+    }
+}
+
+// Route the content prefix at every node over each neighbor on a shortest path towards node 0,
+// the configured strategy chooses between them
+static void
+_buildRoutes(_Sim *sim)
+{
+    size_t nodes = sim->config.nodes;
+    int *queue = parcMemory_Allocate(nodes * sizeof(int));
+    size_t *distance = parcMemory_Allocate(nodes * sizeof(size_t));
+    CCNxName *prefix = ccnxName_CreateFromCString(SIM_PREFIX);
+
+    for (size_t node = 0; node < nodes; node++) {
+        distance[node] = SIZE_MAX;
+        athenaSimulator_SetStrategy(sim->simulator, (int) node, prefix, sim->config.strategy);
+    }
+    athenaSimulator_AddRoute(sim->simulator, 0, prefix, sim->producer);
+
+    size_t head = 0;
+    size_t tail = 0;
+    queue[tail++] = 0;
+    distance[0] = 0;
+    while (head < tail) {
+        int node = queue[head++];
+        for (size_t i = 0; i < sim->edgeCount; i++) {
+            const _SimEdge *edge = &sim->edges[i];
+            int neighbor;
+            if (edge->node[0] == node) {
+                neighbor = edge->node[1];
+            } else if (edge->node[1] == node) {
+                neighbor = edge->node[0];
+            } else {
+                continue;
+            }
+            if (distance[neighbor] == SIZE_MAX) {
+                distance[neighbor] = distance[node] + 1;
+                queue[tail++] = neighbor;
+            }
+            if (distance[neighbor] == distance[node] + 1) {
+                athenaSimulator_AddRoute(sim->simulator, neighbor, prefix, edge->link);
+            }
+        }
+    }
+
+    ccnxName_Release(&prefix);
+    parcMemory_Deallocate(&distance);
+    parcMemory_Deallocate(&queue);
+}
+
+static size_t
+_nameToRank(const CCNxName *name)
+{
+    CCNxNameSegment *segment = ccnxName_GetSegment(name, ccnxName_GetSegmentCount(name) - 1);
+    char *value = parcBuffer_ToString(ccnxNameSegment_GetValue(segment));
+    size_t rank = strtoul(value, NULL, 10);
+    parcMemory_Deallocate(&value);
+    return rank;
+}
+
+static void
+_producerReceive(AthenaSimulator *simulator, int application, CCNxMetaMessage *message, AthenaSimulator_Context context)
+{
+    _Sim *sim = (_Sim *) context;
+
+    if (ccnxMetaMessage_IsInterest(message)) {
+        CCNxInterest *interest = ccnxMetaMessage_GetInterest(message);
+        CCNxContentObject *contentObject =
+            ccnxContentObject_CreateWithNameAndPayload(ccnxInterest_GetName(interest), sim->payload);
+        athenaSimulator_Send(simulator, application, contentObject);
+        ccnxContentObject_Release(&contentObject);
+        sim->stats.answered++;
+    }
+}
+
+static void
+_consumerReceive(AthenaSimulator *simulator, int application, CCNxMetaMessage *message, AthenaSimulator_Context context)
+{
+    _SimConsumer *consumer = (_SimConsumer *) context;
+    _Sim *sim = consumer->sim;
+    const CCNxName *name;
+
+    if (ccnxMetaMessage_IsContentObject(message)) {
+        name = ccnxContentObject_GetName(ccnxMetaMessage_GetContentObject(message));
+    } else if (ccnxMetaMessage_IsInterestReturn(message)) {
+        // The InterestReturn carries the original Interest's name
+        name = ccnxInterest_GetName(ccnxMetaMessage_GetInterestReturn(message));
+    } else {
+        return;
+    }
+
+    size_t rank = _nameToRank(name);
+    if ((rank >= sim->config.catalog) || (consumer->pending[rank] == 0)) {
+        return;
+    }
+
+    if (ccnxMetaMessage_IsContentObject(message)) {
+        sim->latency[sim->latencyCount++] = athenaSimulator_Now(simulator) - (consumer->pending[rank] - 1);
+        sim->stats.satisfied++;
+    } else {
+        sim->stats.returned++;
+    }
+    consumer->pending[rank] = 0;
+}
+
+static size_t
+_zipfRank(_Sim *sim)
+{
+    double draw = _uniform(sim);
+    size_t low = 0;
+    size_t high = sim->config.catalog - 1;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (sim->zipf[middle] < draw) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void
+_consumerSend(AthenaSimulator *simulator, AthenaSimulator_Context context)
+{
+    _SimConsumer *consumer = (_SimConsumer *) context;
+    _Sim *sim = consumer->sim;
+    uint64_t now = athenaSimulator_Now(simulator);
+    uint64_t lifetime = sim->config.lifetime * 1000;
+
+    size_t rank = _zipfRank(sim);
+    if (consumer->pending[rank] && ((now - (consumer->pending[rank] - 1)) >= lifetime)) {
+        sim->stats.expired++;
+        consumer->pending[rank] = 0;
+    }
+
+    if (consumer->pending[rank]) {
+        sim->stats.coalesced++;
+    } else {
+        char nameString[64];
+        snprintf(nameString, sizeof(nameString), SIM_PREFIX "/%zu", rank);
+        CCNxName *name = ccnxName_CreateFromCString(nameString);
+        CCNxInterest *interest = ccnxInterest_Create(name, (uint32_t) sim->config.lifetime, NULL, NULL);
+        ccnxName_Release(&name);
+        athenaSimulator_Send(simulator, consumer->application, interest);
+        ccnxInterest_Release(&interest);
+        consumer->pending[rank] = now + 1;
+        sim->stats.sent++;
+    }
+
+    if (++consumer->sent < sim->config.interests) {
+        athenaSimulator_Schedule(simulator, 1000000 / sim->config.rate, _consumerSend, consumer);
+    }
+}
+
+static void
+_setup(_Sim *sim)
+{
+    const _SimConfig *config = &sim->config;
+
+    sim->simulator = athenaSimulator_Create(config->seed);
+    _buildTopology(sim);
+
+    sim->producer = athenaSimulator_AddApplication(sim->simulator, 0, _producerReceive, sim);
+    assertTrue(sim->producer >= 0, "Unable to attach the producer");
+    _buildRoutes(sim);
+
+    sim->payload = parcBuffer_Allocate(config->payloadSize);
+    for (size_t i = 0; i < config->payloadSize; i++) {
+        parcBuffer_PutUint8(sim->payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(sim->payload);
+
+    sim->zipf = parcMemory_Allocate(config->catalog * sizeof(double));
+    double total = 0.0;
+    for (size_t rank = 0; rank < config->catalog; rank++) {
+        total += 1.0 / pow(rank + 1, config->alpha);
+        sim->zipf[rank] = total;
+    }
+    for (size_t rank = 0; rank < config->catalog; rank++) {
+        sim->zipf[rank] /= total;
+    }
+
+    sim->latency = parcMemory_Allocate(config->consumers * config->interests * sizeof(uint64_t) + 1);
+
+    // Spread the consumers out from the far end of the network, starting them at random offsets
+    sim->consumers = parcMemory_AllocateAndClear(config->consumers * sizeof(_SimConsumer));
+    for (size_t i = 0; i < config->consumers; i++) {
+        _SimConsumer *consumer = &sim->consumers[i];
+        consumer->sim = sim;
+        consumer->node = (int) (config->nodes - 1 - ((i * config->nodes) / config->consumers));
+        consumer->application = athenaSimulator_AddApplication(sim->simulator, consumer->node, _consumerReceive, consumer);
+        assertTrue(consumer->application >= 0, "Unable to attach consumer %zu", i);
+        consumer->pending = parcMemory_AllocateAndClear(config->catalog * sizeof(uint64_t));
+        if (config->interests) {
+            athenaSimulator_Schedule(sim->simulator, athenaSimulator_Random(sim->simulator) % (1000000 / config->rate),
+                                     _consumerSend, consumer);
+        }
+    }
+}
+
+static void
+_teardown(_Sim *sim)
+{
+    for (size_t i = 0; i < sim->config.consumers; i++) {
+        parcMemory_Deallocate(&sim->consumers[i].pending);
+    }
+    parcMemory_Deallocate(&sim->consumers);
+    parcMemory_Deallocate(&sim->latency);
+    parcMemory_Deallocate(&sim->zipf);
+    parcMemory_Deallocate(&sim->edges);
+    parcBuffer_Release(&sim->payload);
+    athenaSimulator_Release(&sim->simulator);
+}
+
+static int
+_compareLatency(const void *a, const void *b)
+{
+    uint64_t left = *(const uint64_t *) a;
+    uint64_t right = *(const uint64_t *) b;
+    return (left > right) - (left < right);
+}
+
+static double
+_percentile(const uint64_t *sorted, size_t count, double percentile)
+{
+    if (count == 0) {
+        return 0.0;
+    }
+    size_t index = (size_t) ((percentile / 100.0) * (count - 1));
+    return sorted[index] / 1e3;
+}
+
+static void
+_report(_Sim *sim, uint64_t elapsed)
+{
+    const _SimConfig *config = &sim->config;
+    const _SimStats *stats = &sim->stats;
+
+    // Whatever is still outstanding was never answered
+    uint64_t expired = stats->expired;
+    for (size_t i = 0; i < config->consumers; i++) {
+        for (size_t rank = 0; rank < config->catalog; rank++) {
+            expired += (sim->consumers[i].pending[rank] != 0);
+        }
+    }
+
+    uint64_t linkMessages = 0;
+    uint64_t linkDrops = 0;
+    uint64_t linkBytes = 0;
+    for (size_t i = 0; i < sim->edgeCount; i++) {
+        const AthenaSimulatorLinkStats *linkStats = athenaSimulator_GetLinkStats(sim->simulator, sim->edges[i].link);
+        linkMessages += linkStats->sent;
+        linkDrops += linkStats->dropped;
+        linkBytes += linkStats->bytes;
+    }
+
+    qsort(sim->latency, sim->latencyCount, sizeof(uint64_t), _compareLatency);
+    double mean = 0.0;
+    for (size_t i = 0; i < sim->latencyCount; i++) {
+        mean += sim->latency[i];
+    }
+    mean = sim->latencyCount ? (mean / sim->latencyCount / 1e3) : 0.0;
+
+    double simulated = athenaSimulator_Now(sim->simulator) / 1e6;
+    double wall = elapsed / 1e6;
+
+    printf("nodes=%zu topology=%s links=%zu latency=%" PRIu64 "us bandwidth=%" PRIu64 "Mb/s loss=%.2f%%\n",
+           config->nodes, _simTopologyNames[config->topology], sim->edgeCount, config->link.latency,
+           config->link.bandwidth / 1000000, config->link.loss * 100.0);
+    printf("consumers=%zu rate=%zu interests=%zu catalog=%zu alpha=%.2f storeSize=%zuMB payloadSize=%zu lifetime=%zums strategy=%s seed=%" PRIu64 "\n",
+           config->consumers, config->rate, config->interests, config->catalog, config->alpha,
+           config->storeSizeInMB, config->payloadSize, config->lifetime, config->strategy, config->seed);
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+           "sent", "coalesced", "satisfied", "returned", "lost", "producer", "mean", "p50", "p99");
+    printf("%10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %9.1f%% %8.1fms %8.1fms %8.1fms\n",
+           stats->sent, stats->coalesced, stats->satisfied, stats->returned, expired,
+           stats->satisfied ? (100.0 * stats->answered / stats->satisfied) : 0.0, mean,
+           _percentile(sim->latency, sim->latencyCount, 50.0), _percentile(sim->latency, sim->latencyCount, 99.0));
+    printf("link messages=%" PRIu64 " dropped=%" PRIu64 " bytes=%" PRIu64 "\n", linkMessages, linkDrops, linkBytes);
+    printf("simulated %.3fs in %.3fs (%.1fx real time)\n", simulated, wall, wall > 0 ? (simulated / wall) : 0.0);
+}
+
+int
+main(int argc, char *argv[])
+{
+    _Sim sim = {
+        .config     = {
+            .nodes         = 100,
+            .topology      = _SimTopology_Tree,
+            .link          = {
+                .latency   = 1000,
+                .bandwidth = 100 * 1000000ULL,
+                .loss      = 0.0,
+            },
+            .consumers     = 10,
+            .rate          = 100,
+            .interests     = 1000,
+            .catalog       = 10000,
+            .alpha         = 0.8,
+            .storeSizeInMB = 1,
+            .payloadSize   = 1024,
+            .lifetime      = CCNxInterestDefault_LifetimeMilliseconds,
+            .strategy      = "best-route",
+            .seed          = 1,
+        },
+    };
+    _parseCommandLine(&sim.config, argc, argv);
+
+    _setup(&sim);
+
+    uint64_t start = _wallclock();
+    athenaSimulator_Run(sim.simulator, UINT64_MAX);
+    uint64_t elapsed = _wallclock() - start;
+
+    _report(&sim, elapsed);
+
+    _teardown(&sim);
+    return 0;
+}
@@ -58,6 +58,7 @@
  */
 
 #include "../athena.c"
+#include "../athena_TransportLinkAdapter.c"
 
 #include <LongBow/unit-test.h>
 
@@ -97,8 +98,12 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, athena_CreateRelease);
     LONGBOW_RUN_TEST_CASE(Global, athena_ProcessInterest);
     LONGBOW_RUN_TEST_CASE(Global, athena_ProcessContentObject);
+    LONGBOW_RUN_TEST_CASE(Global, athena_ProcessWireFormatMessage);
     LONGBOW_RUN_TEST_CASE(Global, athena_ProcessControl);
     LONGBOW_RUN_TEST_CASE(Global, athena_ProcessInterestReturn);
+    LONGBOW_RUN_TEST_CASE(Global, athena_ProcessInterestReturn_Retry);
+    LONGBOW_RUN_TEST_CASE(Global, athena_ProcessInterestReturn_RetryShaped);
+    LONGBOW_RUN_TEST_CASE(Global, athena_PITEviction_Queued);
     LONGBOW_RUN_TEST_CASE(Global, athena_ForwarderEngine);
 
     LONGBOW_RUN_TEST_CASE(Global, athena_ProcessControl_CPI_REGISTER_PREFIX);
@@ -268,6 +273,46 @@ LONGBOW_TEST_CASE(Global, athena_ProcessContentObject)
     athena_Release(&athena);
 }
 
+LONGBOW_TEST_CASE(Global, athena_ProcessWireFormatMessage)
+{
+    Athena *athena = athena_Create(100);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/cakes/and/pies");
+    PARCBuffer *payload = parcBuffer_WrapCString("this is a payload");
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    parcBuffer_Release(&payload);
+
+    PARCBitVector *ingressVector = parcBitVector_Create();
+    parcBitVector_Set(ingressVector, 0);
+
+    // Nothing is pending, the object is dropped without being decoded
+    PARCBuffer *wireFormatBuffer = athenaTransportLinkModule_CreateMessageBuffer(contentObject);
+    CCNxMetaMessage *received = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+    assertNotNull(received, "Expected an encoded Content Object to be accepted");
+    athena_ProcessWireFormatMessage(athena, received, ingressVector);
+    assertTrue(athena->stats.numDroppedUndecoded == 1, "Expected the unsolicited object to be dropped undecoded");
+    assertTrue(athena->stats.numProcessedContentObjects == 0, "Expected the unsolicited object not to be processed");
+    ccnxMetaMessage_Release(&received);
+
+    // An Interest that was never encoded can't be ruled out by name, so the object is decoded
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    PARCBitVector *expectedReturnVector;
+    athenaPIT_AddInterest(athena->athenaPIT, interest, ingressVector, &expectedReturnVector);
+    received = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+    athena_ProcessWireFormatMessage(athena, received, ingressVector);
+    assertTrue(athena->stats.numDroppedUndecoded == 1, "Expected the object not to be dropped");
+    assertTrue(athena->stats.numProcessedContentObjects == 1, "Expected the object to be decoded and processed");
+    ccnxMetaMessage_Release(&received);
+
+    // The store still holds the object, whose wire format refers to the encoding of contentObject
+    athena_Release(&athena);
+    parcBuffer_Release(&wireFormatBuffer);
+    parcBitVector_Release(&ingressVector);
+    ccnxInterest_Release(&interest);
+    ccnxContentObject_Release(&contentObject);
+    ccnxName_Release(&name);
+}
+
 LONGBOW_TEST_CASE(Global, athena_ProcessControl)
 {
     PARCURI *connectionURI;
@@ -400,6 +445,214 @@ LONGBOW_TEST_CASE(Global, athena_ProcessInterestReturn)
     athena_Release(&athena);
 }
 
+LONGBOW_TEST_CASE(Global, athena_ProcessInterestReturn_Retry)
+{
+    PARCURI *connectionURI;
+    Athena *athena = athena_Create(100);
+
+    connectionURI = parcURI_Parse("tcp://localhost:50100/listener/name=TCPListener");
+    const char *result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    const char *linkNames[] = { "TCP_0", "TCP_1", "TCP_2" };
+    PARCBitVector *linkVectors[3];
+    for (int i = 0; i < 3; i++) {
+        char uri[64];
+        sprintf(uri, "tcp://localhost:50100/name=%s", linkNames[i]);
+        connectionURI = parcURI_Parse(uri);
+        result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+        assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+        parcURI_Release(&connectionURI);
+
+        linkVectors[i] = parcBitVector_Create();
+        parcBitVector_Set(linkVectors[i], athenaTransportLinkAdapter_LinkNameToId(athena->athenaTransportLinkAdapter, linkNames[i]));
+    }
+
+    // Call _Receive() once to prime the links. Messages are dropped until _Receive() is called once.
+    PARCBitVector *linksRead = NULL;
+    CCNxMetaMessage *msg = athenaTransportLinkAdapter_Receive(athena->athenaTransportLinkAdapter, &linksRead, 0);
+    assertNull(msg, "Expected to NOT receive a message after the first call to _Receive()");
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/boose/roo/pie");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    CCNxInterestReturn *interestReturn = ccnxInterestReturn_Create(interest, CCNxInterestReturn_ReturnCode_NoRoute);
+    athena_EncodeMessage(interest);
+    athena_EncodeMessage(interestReturn);
+
+    // Only TCP_1 is known when the interest is first forwarded
+    athenaFIB_AddRoute(athena->athenaFIB, name, linkVectors[1]);
+    athena_ProcessMessage(athena, interest, linkVectors[0]);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(athena->athenaPIT) == 1, "Expected the interest to be pending");
+
+    // A return from a link the interest wasn't sent to is ignored
+    athena_ProcessMessage(athena, interestReturn, linkVectors[2]);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(athena->athenaPIT) == 1, "Expected the interest to remain pending");
+
+    // A return from TCP_1 retries the interest on the untried TCP_2 nexthop
+    athenaFIB_AddRoute(athena->athenaFIB, name, linkVectors[2]);
+    athena_ProcessMessage(athena, interestReturn, linkVectors[1]);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(athena->athenaPIT) == 1, "Expected the interest to be retried");
+
+    // Once TCP_2 returns as well all nexthops are exhausted and the PIT entry is removed
+    athena_ProcessMessage(athena, interestReturn, linkVectors[2]);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(athena->athenaPIT) == 0, "Expected the interest to be returned downstream");
+
+    for (int i = 0; i < 3; i++) {
+        parcBitVector_Release(&linkVectors[i]);
+    }
+    ccnxName_Release(&name);
+    ccnxInterest_Release(&interest);
+    ccnxInterestReturn_Release(&interestReturn);
+    athena_Release(&athena);
+}
+
+LONGBOW_TEST_CASE(Global, athena_ProcessInterestReturn_RetryShaped)
+{
+    PARCURI *connectionURI;
+    Athena *athena = athena_Create(100);
+
+    connectionURI = parcURI_Parse("tcp://localhost:50100/listener/name=TCPListener");
+    const char *result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    const char *linkNames[] = { "TCP_0", "TCP_1", "TCP_2" };
+    PARCBitVector *linkVectors[3];
+    for (int i = 0; i < 3; i++) {
+        char uri[64];
+        sprintf(uri, "tcp://localhost:50100/name=%s", linkNames[i]);
+        connectionURI = parcURI_Parse(uri);
+        result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+        assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+        parcURI_Release(&connectionURI);
+
+        linkVectors[i] = parcBitVector_Create();
+        parcBitVector_Set(linkVectors[i], athenaTransportLinkAdapter_LinkNameToId(athena->athenaTransportLinkAdapter, linkNames[i]));
+    }
+
+    PARCBitVector *linksRead = NULL;
+    CCNxMetaMessage *msg = athenaTransportLinkAdapter_Receive(athena->athenaTransportLinkAdapter, &linksRead, 0);
+    assertNull(msg, "Expected to NOT receive a message after the first call to _Receive()");
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/boose/roo/pie");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    CCNxInterestReturn *interestReturn = ccnxInterestReturn_Create(interest, CCNxInterestReturn_ReturnCode_NoRoute);
+    athena_EncodeMessage(interest);
+    athena_EncodeMessage(interestReturn);
+
+    athenaFIB_AddRoute(athena->athenaFIB, name, linkVectors[1]);
+    athena_ProcessMessage(athena, interest, linkVectors[0]);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(athena->athenaPIT) == 1, "Expected the interest to be pending");
+
+    // Use up the capacity of TCP_2, it refuses any further interest
+    int status = athenaTransportLinkAdapter_SetInterestShaping(athena->athenaTransportLinkAdapter, "TCP_2", 120000, 0);
+    assertTrue(status == 0, "Expected the link shaping to be set");
+    PARCBitVector *egressVector = parcBitVector_Copy(linkVectors[2]);
+    PARCBitVector *congestedVector =
+        athenaTransportLinkAdapter_ShapeInterest(athena->athenaTransportLinkAdapter, interest, egressVector);
+    assertNull(congestedVector, "Expected the first interest to be within the link's capacity");
+    parcBitVector_Release(&egressVector);
+
+    // The retry on TCP_2 is refused by its shaper, so all nexthops are exhausted
+    athenaFIB_AddRoute(athena->athenaFIB, name, linkVectors[2]);
+    athena_ProcessMessage(athena, interestReturn, linkVectors[1]);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(athena->athenaPIT) == 0,
+               "Expected the interest to be returned downstream rather than retried over capacity");
+
+    for (int i = 0; i < 3; i++) {
+        parcBitVector_Release(&linkVectors[i]);
+    }
+    ccnxName_Release(&name);
+    ccnxInterest_Release(&interest);
+    ccnxInterestReturn_Release(&interestReturn);
+    athena_Release(&athena);
+}
+
+LONGBOW_TEST_CASE(Global, athena_PITEviction_Queued)
+{
+    PARCURI *connectionURI;
+    Athena *athena = athena_Create(100);
+
+    // A single entry PIT, each new interest evicts the one before it
+    athenaPIT_Release(&athena->athenaPIT);
+    athena->athenaPIT = athenaPIT_CreateCapacity(1);
+    athenaPIT_SetEvictionCallback(athena->athenaPIT, _pitEviction, athena);
+    athenaPIT_SetOverflowPolicy(athena->athenaPIT, AthenaPITOverflowPolicy_EvictOldest);
+
+    connectionURI = parcURI_Parse("tcp://localhost:50100/listener/name=TCPListener");
+    const char *result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    const char *linkNames[] = { "TCP_0", "TCP_1" };
+    PARCBitVector *linkVectors[2];
+    for (int i = 0; i < 2; i++) {
+        char uri[64];
+        sprintf(uri, "tcp://localhost:50100/name=%s", linkNames[i]);
+        connectionURI = parcURI_Parse(uri);
+        result = athenaTransportLinkAdapter_Open(athena->athenaTransportLinkAdapter, connectionURI);
+        assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+        parcURI_Release(&connectionURI);
+
+        linkVectors[i] = parcBitVector_Create();
+        parcBitVector_Set(linkVectors[i], athenaTransportLinkAdapter_LinkNameToId(athena->athenaTransportLinkAdapter, linkNames[i]));
+    }
+
+    PARCBitVector *linksRead = NULL;
+    CCNxMetaMessage *msg = athenaTransportLinkAdapter_Receive(athena->athenaTransportLinkAdapter, &linksRead, 0);
+    assertNull(msg, "Expected to NOT receive a message after the first call to _Receive()");
+
+    // TCP_1 isn't accepting sends, interests forwarded to it are queued
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athena->athenaTransportLinkAdapter, "TCP_1");
+    AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athena->athenaTransportLinkAdapter->instanceList, linkId);
+    AthenaEgressScheduler *scheduler = _egressScheduler(athena->athenaTransportLinkAdapter, linkId);
+    athenaTransportLink_ClearEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+
+    CCNxName *prefix = ccnxName_CreateFromCString("lci:/boose");
+    athenaFIB_AddRoute(athena->athenaFIB, prefix, linkVectors[1]);
+    ccnxName_Release(&prefix);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/boose/roo/pie");
+    CCNxInterest *queuedInterest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(queuedInterest);
+    athena_ProcessMessage(athena, queuedInterest, linkVectors[0]);
+    assertTrue(athenaEgressScheduler_GetQueueDepth(scheduler, AthenaEgressClass_Interest) == 1,
+               "Expected the interest to be queued on the blocked link");
+
+    // The next interest evicts the queued one, which is returned to TCP_0
+    name = ccnxName_CreateFromCString("lci:/boose/roo/cake");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(interest);
+    size_t messagesSent = athena->athenaTransportLinkAdapter->stats.messageSent;
+    athena_ProcessMessage(athena, interest, linkVectors[0]);
+    assertTrue(athenaPIT_GetOverflowCount(athena->athenaPIT, AthenaPITOverflowPolicy_EvictOldest) == 1,
+               "Expected the queued interest to have been evicted");
+    assertTrue(athena->athenaTransportLinkAdapter->stats.messageSent == messagesSent + 1,
+               "Expected the InterestReturn to have been sent to TCP_0");
+
+    // The queued message is left as it was, an interest, rather than converted into the InterestReturn
+    assertTrue(ccnxMetaMessage_IsInterest(queuedInterest), "Expected the queued message to still be an interest");
+    AthenaPacketDescriptor descriptor;
+    assertTrue(athenaPacketDescriptor_Parse(&descriptor, ccnxWireFormatMessage_GetWireFormatBuffer(queuedInterest)),
+               "Expected the queued wire format to parse");
+    assertTrue(descriptor.packetType == AthenaPacketDescriptor_PacketType_Interest,
+               "Expected the queued wire format to still be an interest");
+
+    // Once TCP_1 is writable both queued interests go out
+    athenaTransportLinkAdapter_Poll(athena->athenaTransportLinkAdapter, 0);
+    assertTrue(athenaEgressScheduler_Depth(scheduler) == 0, "Expected the queue to be drained");
+
+    for (int i = 0; i < 2; i++) {
+        parcBitVector_Release(&linkVectors[i]);
+    }
+    ccnxInterest_Release(&interest);
+    ccnxInterest_Release(&queuedInterest);
+    athena_Release(&athena);
+}
+
 LONGBOW_TEST_CASE(Global, athena_ForwarderEngine)
 {
     // Create a new athena instance
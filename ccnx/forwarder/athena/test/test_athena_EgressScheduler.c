@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../athena_EgressScheduler.c"
+
+#include <LongBow/unit-test.h>
+
+#include <stdio.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_InterestReturn.h>
+
+/**
+ * Records the class of each message handed to it, blocking once its budget of sends is used
+ */
+typedef struct {
+    AthenaEgressClass order[64];
+    size_t count;
+    size_t budget;
+    AthenaEgressScheduler_SendResult result;
+} _TestSender;
+
+static AthenaEgressScheduler_SendResult
+_testSend(AthenaEgressScheduler_SendMethodContext context, CCNxMetaMessage *message)
+{
+    _TestSender *sender = (_TestSender *) context;
+    if (sender->count == sender->budget) {
+        return AthenaEgressScheduler_Blocked;
+    }
+    sender->order[sender->count++] = athenaEgressScheduler_Classify(message);
+    return sender->result;
+}
+
+typedef struct {
+    AthenaEgressScheduler *scheduler;
+    CCNxMetaMessage *interest;
+    CCNxMetaMessage *contentObject;
+} _TestData;
+
+LONGBOW_TEST_RUNNER(athena_EgressScheduler)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(athena_EgressScheduler)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_EgressScheduler)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaEgressScheduler_CreateRelease);
+    LONGBOW_RUN_TEST_CASE(Global, athenaEgressScheduler_Classify);
+    LONGBOW_RUN_TEST_CASE(Global, athenaEgressScheduler_ClassName);
+    LONGBOW_RUN_TEST_CASE(Global, athenaEgressScheduler_Enqueue_QueueLimit);
+    LONGBOW_RUN_TEST_CASE(Global, athenaEgressScheduler_Service_Weights);
+    LONGBOW_RUN_TEST_CASE(Global, athenaEgressScheduler_Service_Blocked);
+    LONGBOW_RUN_TEST_CASE(Global, athenaEgressScheduler_Service_Failed);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    _TestData *data = parcMemory_AllocateAndClear(sizeof(_TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear returned NULL");
+
+    data->scheduler = athenaEgressScheduler_Create();
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/test/egress");
+    data->interest = ccnxInterest_CreateSimple(name);
+    PARCBuffer *payload = parcBuffer_WrapCString("payload");
+    data->contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    athenaEgressScheduler_Release(&data->scheduler);
+    ccnxMetaMessage_Release(&data->interest);
+    ccnxMetaMessage_Release(&data->contentObject);
+    parcMemory_Deallocate(&data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, athenaEgressScheduler_CreateRelease)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaEgressScheduler *scheduler = athenaEgressScheduler_Create();
+    assertNotNull(scheduler, "Expected athenaEgressScheduler_Create to return a non-NULL value");
+    assertTrue(athenaEgressScheduler_Depth(scheduler) == 0, "Expected a new scheduler to be empty");
+    assertTrue(athenaEgressScheduler_GetWeight(scheduler, AthenaEgressClass_Interest) == AthenaEgressScheduler_DefaultWeight,
+               "Expected the default weight");
+    assertTrue(athenaEgressScheduler_GetQueueLimit(scheduler, AthenaEgressClass_Interest) == AthenaEgressScheduler_DefaultQueueLimit,
+               "Expected the default queue limit");
+
+    // Messages still queued are released with the scheduler
+    athenaEgressScheduler_Enqueue(scheduler, AthenaEgressClass_Interest, data->interest, 100);
+    athenaEgressScheduler_Release(&scheduler);
+    assertNull(scheduler, "Expected athenaEgressScheduler_Release to NULL the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, athenaEgressScheduler_Classify)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    assertTrue(athenaEgressScheduler_Classify(data->interest) == AthenaEgressClass_Interest,
+               "Expected an Interest to be classified as an Interest");
+    assertTrue(athenaEgressScheduler_Classify(data->contentObject) == AthenaEgressClass_ContentObject,
+               "Expected a Content Object to be classified as a Content Object");
+
+    CCNxInterestReturn *interestReturn =
+        ccnxInterestReturn_Create(data->interest, CCNxInterestReturn_ReturnCode_NoRoute);
+    assertTrue(athenaEgressScheduler_Classify(interestReturn) == AthenaEgressClass_InterestReturn,
+               "Expected an InterestReturn to be classified as an InterestReturn");
+    ccnxInterestReturn_Release(&interestReturn);
+}
+
+LONGBOW_TEST_CASE(Global, athenaEgressScheduler_ClassName)
+{
+    for (int egressClass = 0; egressClass < AthenaEgressClass_Count; egressClass++) {
+        AthenaEgressClass result;
+        const char *name = athenaEgressScheduler_ClassName(egressClass);
+        assertTrue(athenaEgressScheduler_ClassFromName(name, &result), "Expected %s to be found", name);
+        assertTrue(result == egressClass, "Expected %s to map back to its class", name);
+    }
+
+    AthenaEgressClass result;
+    assertTrue(athenaEgressScheduler_ClassFromName("CONTENTOBJECT", &result), "Expected names to ignore case");
+    assertFalse(athenaEgressScheduler_ClassFromName("bulk", &result), "Expected an unknown name not to be found");
+}
+
+LONGBOW_TEST_CASE(Global, athenaEgressScheduler_Enqueue_QueueLimit)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // More than the initial ring allocation so that it grows
+    athenaEgressScheduler_Configure(data->scheduler, AthenaEgressClass_ContentObject, 1, 20);
+    for (int i = 0; i < 20; i++) {
+        assertTrue(athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_ContentObject, data->contentObject, 1000),
+                   "Expected message %d to be queued", i);
+    }
+    assertFalse(athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_ContentObject, data->contentObject, 1000),
+                "Expected a message beyond the queue limit to be dropped");
+    assertTrue(athenaEgressScheduler_GetQueueDepth(data->scheduler, AthenaEgressClass_ContentObject) == 20, "Expected 20 queued");
+    assertTrue(athenaEgressScheduler_GetDropCount(data->scheduler, AthenaEgressClass_ContentObject) == 1, "Expected 1 drop");
+
+    // Other classes have their own limits
+    assertTrue(athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_Interest, data->interest, 100),
+               "Expected an Interest to be queued behind a full Content Object queue");
+
+    // A limit of 0 disables queueing
+    athenaEgressScheduler_Configure(data->scheduler, AthenaEgressClass_Control, 1, 0);
+    assertFalse(athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_Control, data->interest, 100),
+                "Expected a class with no queue to drop");
+    assertTrue(athenaEgressScheduler_Depth(data->scheduler) == 21, "Expected 21 queued in all");
+}
+
+LONGBOW_TEST_CASE(Global, athenaEgressScheduler_Service_Weights)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // Content Objects get twice the share of Interests, messages of both are 1000 bytes
+    athenaEgressScheduler_Configure(data->scheduler, AthenaEgressClass_ContentObject, 2, 64);
+    for (int i = 0; i < 6; i++) {
+        athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_ContentObject, data->contentObject, 1000);
+        athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_Interest, data->interest, 1000);
+    }
+
+    _TestSender sender = { .count = 0, .budget = 64, .result = AthenaEgressScheduler_Sent };
+    size_t sent = athenaEgressScheduler_Service(data->scheduler, _testSend, &sender);
+    assertTrue(sent == 12, "Expected all 12 messages to be sent, got %zu", sent);
+    assertTrue(athenaEgressScheduler_Depth(data->scheduler) == 0, "Expected the queues to be empty");
+
+    // Round 1: Interest credit 1500 sends 1, Content Object credit 3000 sends 3
+    // Round 2: Interest credit 2000 sends 2, Content Object credit 3000 sends the last 3
+    // Rounds 3 and 4: Interests alone, with 1500 and then 2000 bytes of credit, send the last 3
+    AthenaEgressClass expected[] = {
+        AthenaEgressClass_Interest,
+        AthenaEgressClass_ContentObject, AthenaEgressClass_ContentObject, AthenaEgressClass_ContentObject,
+        AthenaEgressClass_Interest, AthenaEgressClass_Interest,
+        AthenaEgressClass_ContentObject, AthenaEgressClass_ContentObject, AthenaEgressClass_ContentObject,
+        AthenaEgressClass_Interest, AthenaEgressClass_Interest, AthenaEgressClass_Interest,
+    };
+    for (int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        assertTrue(sender.order[i] == expected[i], "Unexpected class %s sent at %d",
+                   athenaEgressScheduler_ClassName(sender.order[i]), i);
+    }
+    assertTrue(athenaEgressScheduler_GetSentCount(data->scheduler, AthenaEgressClass_Interest) == 6, "Expected 6 Interests sent");
+}
+
+LONGBOW_TEST_CASE(Global, athenaEgressScheduler_Service_Blocked)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    for (int i = 0; i < 4; i++) {
+        athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_ContentObject, data->contentObject, 500);
+        athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_Interest, data->interest, 1000);
+    }
+
+    // The link blocks after two sends, the first Interest and the first Content Object
+    _TestSender sender = { .count = 0, .budget = 2, .result = AthenaEgressScheduler_Sent };
+    size_t sent = athenaEgressScheduler_Service(data->scheduler, _testSend, &sender);
+    assertTrue(sent == 2, "Expected 2 messages sent before blocking, got %zu", sent);
+    assertTrue(athenaEgressScheduler_Depth(data->scheduler) == 6, "Expected the blocked message to stay queued");
+
+    // Servicing resumes in the same round, the Content Object class still has credit for two more
+    sender.budget = 64;
+    sent = athenaEgressScheduler_Service(data->scheduler, _testSend, &sender);
+    assertTrue(sent == 6, "Expected the remaining 6 messages sent, got %zu", sent);
+    assertTrue(sender.order[2] == AthenaEgressClass_ContentObject, "Expected to resume with the blocked Content Object");
+    assertTrue(sender.order[3] == AthenaEgressClass_ContentObject, "Expected the round's credit to carry over the block");
+    assertTrue(sender.order[4] == AthenaEgressClass_Interest, "Expected the next round to start with Interests");
+}
+
+LONGBOW_TEST_CASE(Global, athenaEgressScheduler_Service_Failed)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_Interest, data->interest, 100);
+    athenaEgressScheduler_Enqueue(data->scheduler, AthenaEgressClass_Interest, data->interest, 100);
+
+    _TestSender sender = { .count = 0, .budget = 64, .result = AthenaEgressScheduler_Failed };
+    size_t sent = athenaEgressScheduler_Service(data->scheduler, _testSend, &sender);
+    assertTrue(sent == 0, "Expected no messages counted as sent");
+    assertTrue(athenaEgressScheduler_Depth(data->scheduler) == 0, "Expected failed messages to be removed");
+    assertTrue(athenaEgressScheduler_GetDropCount(data->scheduler, AthenaEgressClass_Interest) == 2, "Expected 2 drops");
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(athena_EgressScheduler);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -108,11 +108,17 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_Create);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_AcquireRelease);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_AddRoute);
+    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_AddRouteWithCost);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_Lookup);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_Lookup_EmptyPath);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_DeleteRoute);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_RemoveLink);
+    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_RemoveLink_Index);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_CreateEntryList);
+    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_LoadRoutes);
+    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_LoadRoutes_Error);
+    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_SwapRoutes);
+    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_SetStrategy);
     LONGBOW_RUN_TEST_CASE(Global, athenaFIB_ProcessMessage);
 //    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_Equals);
 //    LONGBOW_RUN_TEST_CASE(Global, athenaFIB_NotEquals);
@@ -198,6 +204,51 @@ LONGBOW_TEST_CASE(Global, athenaFIB_AddRoute)
     athenaFIB_AddRoute(data->testFIB, data->testName1, data->testVector1);
 }
 
+LONGBOW_TEST_CASE(Global, athenaFIB_AddRouteWithCost)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaFIB_AddRouteWithCost(data->testFIB, data->testName1, data->testVector1, 20, 1);
+    athenaFIB_AddRouteWithCost(data->testFIB, data->testName1, data->testVector3, 20, 3);
+    athenaFIB_AddRouteWithCost(data->testFIB, data->testName1, data->testVector2, 10, 1);
+
+    // Nexthops come back cheapest first
+    AthenaNexthopList *nexthops = athenaFIB_LookupNexthops(data->testFIB, data->testName4, NULL);
+    assertNotNull(nexthops, "Expected a nexthop list for a prefix match");
+    assertTrue(athenaNexthopList_Size(nexthops) == 3, "Expected 3 nexthops");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 0) == 42, "Expected the lowest cost nexthop first");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 1) == 0, "Expected equal cost nexthops in link order");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 2) == 23, "Expected equal cost nexthops in link order");
+    assertTrue(athenaNexthopList_GetWeight(nexthops, 2) == 3, "Expected the weight to be kept");
+    athenaNexthopList_Release(&nexthops);
+
+    // The ingress link is left out without disturbing the order
+    nexthops = athenaFIB_LookupNexthops(data->testFIB, data->testName1, data->testVector2);
+    assertTrue(athenaNexthopList_Size(nexthops) == 2, "Expected the ingress link to be excluded");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 0) == 0, "Expected the next lowest cost nexthop first");
+    athenaNexthopList_Release(&nexthops);
+
+    // Re-adding a nexthop changes its cost
+    athenaFIB_AddRouteWithCost(data->testFIB, data->testName1, data->testVector2, 30, 1);
+    nexthops = athenaFIB_LookupNexthops(data->testFIB, data->testName1, NULL);
+    assertTrue(athenaNexthopList_Size(nexthops) == 3, "Expected no duplicate nexthop");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 2) == 42, "Expected the re-added nexthop to be ranked last");
+    athenaNexthopList_Release(&nexthops);
+
+    PARCList *entryList = athenaFIB_CreateEntryList(data->testFIB);
+    for (size_t i = 0; i < parcList_Size(entryList); i++) {
+        AthenaFIBListEntry *entry = parcList_GetAtIndex(entryList, i);
+        if (athenaFIBListEntry_GetLinkId(entry) == 23) {
+            assertTrue(athenaFIBListEntry_GetCost(entry) == 20, "Expected the entry list to report the cost");
+            assertTrue(athenaFIBListEntry_GetWeight(entry) == 3, "Expected the entry list to report the weight");
+        }
+    }
+    parcList_Release(&entryList);
+
+    nexthops = athenaFIB_LookupNexthops(data->testFIB, data->testName2, NULL);
+    assertNull(nexthops, "Expected no nexthops without a matching route");
+}
+
 LONGBOW_TEST_CASE(Global, athenaFIB_Lookup)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -332,6 +383,32 @@ LONGBOW_TEST_CASE(Global, athenaFIB_RemoveLink)
     parcBitVector_Release(&result);
 }
 
+LONGBOW_TEST_CASE(Global, athenaFIB_RemoveLink_Index)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaFIB_AddRoute(data->testFIB, data->testName1, data->testVector12);
+    athenaFIB_AddRoute(data->testFIB, data->testName2, data->testVector2);
+    athenaFIB_AddRoute(data->testFIB, data->testName4, data->testVector2);
+    athenaFIB_DeleteRoute(data->testFIB, data->testName4, data->testVector2);
+
+    athenaFIB_RemoveLink(data->testFIB, data->testVector2);
+    assertNull(data->testFIB->linkRoutes[42].first, "Expected no routes left on the removed link");
+    assertNull(data->testFIB->linkRoutes[42].last, "Expected no routes left on the removed link");
+
+    PARCBitVector *result = athenaFIB_Lookup(data->testFIB, data->testName1, NULL);
+    assertTrue(parcBitVector_Equals(result, data->testVector1), "Expected the remaining link to be routed");
+    parcBitVector_Release(&result);
+    result = athenaFIB_Lookup(data->testFIB, data->testName2, NULL);
+    assertNull(result, "Expected the prefix routed only over the removed link to be removed");
+
+    assertFalse(athenaFIB_DeleteRoute(data->testFIB, data->testName1, data->testVector2),
+                "Expected no route left to delete on the removed link");
+    assertTrue(athenaFIB_DeleteRoute(data->testFIB, data->testName1, data->testVector1),
+               "Expected the route on the remaining link to be deleted");
+    assertNull(data->testFIB->linkRoutes[0].first, "Expected no routes left on link 0");
+}
+
 LONGBOW_TEST_CASE(Global, athenaFIB_CreateEntryList)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -366,6 +443,129 @@ LONGBOW_TEST_CASE(Global, athenaFIB_CreateEntryList)
     parcList_Release(&entryList);
 }
 
+// Resolve link names of the form "link<id>"
+static int
+_testResolveLinkName(AthenaFIB_LinkResolverContext context, const char *linkName)
+{
+    int linkId;
+    if (sscanf(linkName, "link%d", &linkId) != 1) {
+        return -1;
+    }
+    return linkId;
+}
+
+LONGBOW_TEST_CASE(Global, athenaFIB_LoadRoutes)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    const char *routes =
+        "# prefix link [cost [weight]]\n"
+        "lci:/a/b/c link0\n"
+        "\n"
+        "lci:/a/b/c link42 5 3\n"
+        "lci:/a/b/a link42\n"
+        "lci:/ link23";
+    size_t errorLine = 0;
+    ssize_t loaded = athenaFIB_LoadRoutes(data->testFIB, routes, _testResolveLinkName, NULL, &errorLine);
+    assertTrue(loaded == 4, "Expected 4 routes to be loaded, got %zd", loaded);
+
+    AthenaNexthopList *nexthops = athenaFIB_LookupNexthops(data->testFIB, data->testName1, NULL);
+    assertTrue(athenaNexthopList_Size(nexthops) == 2, "Expected both routes for the same prefix");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 0) == 0, "Expected the default cost route first");
+    assertTrue(athenaNexthopList_GetCost(nexthops, 1) == 5, "Expected the loaded cost");
+    assertTrue(athenaNexthopList_GetWeight(nexthops, 1) == 3, "Expected the loaded weight");
+    athenaNexthopList_Release(&nexthops);
+
+    PARCBitVector *result = athenaFIB_Lookup(data->testFIB, data->testName2, NULL);
+    assertTrue(parcBitVector_Equals(result, data->testVector2), "Expected lookup to equal test vector");
+    parcBitVector_Release(&result);
+
+    CCNxName *unrouted = ccnxName_CreateFromCString("lci:/x/y");
+    result = athenaFIB_Lookup(data->testFIB, unrouted, NULL);
+    assertTrue(parcBitVector_Equals(result, data->testVector3), "Expected the loaded default route");
+    parcBitVector_Release(&result);
+    ccnxName_Release(&unrouted);
+
+    // Routes for a link are only recorded once for link removal
+    athenaFIB_LoadRoutes(data->testFIB, "lci:/a/b/c link0\n", _testResolveLinkName, NULL, NULL);
+    _AthenaFIBLinkRoutes *linkRoutes = &data->testFIB->linkRoutes[0];
+    assertTrue(linkRoutes->first == linkRoutes->last, "Expected no duplicate route for link 0");
+}
+
+LONGBOW_TEST_CASE(Global, athenaFIB_LoadRoutes_Error)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    size_t errorLine = 0;
+    ssize_t loaded = athenaFIB_LoadRoutes(data->testFIB, "lci:/a/b/c link0\nlci:/a/b/a\n", _testResolveLinkName, NULL, &errorLine);
+    assertTrue(loaded == -1, "Expected a route without a link to fail");
+    assertTrue(errorLine == 2, "Expected the error on line 2, got %zu", errorLine);
+
+    loaded = athenaFIB_LoadRoutes(data->testFIB, "lci:/a/b/a unknown\n", _testResolveLinkName, NULL, &errorLine);
+    assertTrue(loaded == -1, "Expected a route with an unknown link to fail");
+    assertTrue(errorLine == 1, "Expected the error on line 1, got %zu", errorLine);
+
+    loaded = athenaFIB_LoadRoutes(data->testFIB, "/a/b/a link0\n", _testResolveLinkName, NULL, &errorLine);
+    assertTrue(loaded == -1, "Expected a route with an invalid prefix to fail");
+}
+
+LONGBOW_TEST_CASE(Global, athenaFIB_SwapRoutes)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaForwardingStrategy *bestRoute = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_BestRouteImplementation, NULL);
+    athenaFIB_SetStrategy(data->testFIB, data->testName1, bestRoute);
+    athenaForwardingStrategy_Release(&bestRoute);
+    athenaFIB_AddRoute(data->testFIB, data->testName1, data->testVector1);
+
+    AthenaFIB *newFIB = athenaFIB_CreateCapacity(16);
+    athenaFIB_AddRoute(newFIB, data->testName2, data->testVector2);
+    athenaFIB_AddRoute(newFIB, data->testName3, data->testVector3);
+
+    athenaFIB_SwapRoutes(data->testFIB, newFIB);
+
+    PARCBitVector *result = athenaFIB_Lookup(data->testFIB, data->testName2, NULL);
+    assertTrue(parcBitVector_Equals(result, data->testVector2), "Expected the swapped in route");
+    parcBitVector_Release(&result);
+    result = athenaFIB_Lookup(data->testFIB, data->testName1, NULL);
+    assertTrue(parcBitVector_Equals(result, data->testVector3), "Expected the old route to be replaced by the default");
+    parcBitVector_Release(&result);
+
+    AthenaForwardingStrategy *strategy = athenaFIB_GetStrategy(data->testFIB, data->testName1);
+    assertTrue(strcmp(athenaForwardingStrategy_GetName(strategy), "best-route") == 0, "Expected strategies to be kept");
+
+    result = athenaFIB_Lookup(newFIB, data->testName1, NULL);
+    assertTrue(parcBitVector_Equals(result, data->testVector1), "Expected the previous routes in the other FIB");
+    parcBitVector_Release(&result);
+
+    athenaFIB_Release(&newFIB);
+}
+
+LONGBOW_TEST_CASE(Global, athenaFIB_SetStrategy)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaForwardingStrategy *strategy = athenaFIB_GetStrategy(data->testFIB, data->testName4);
+    assertTrue(strcmp(athenaForwardingStrategy_GetName(strategy), "multicast") == 0, "Expected multicast as the default strategy");
+
+    AthenaForwardingStrategy *bestRoute = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_BestRouteImplementation, NULL);
+    athenaFIB_SetStrategy(data->testFIB, data->testName1, bestRoute);
+    athenaForwardingStrategy_Release(&bestRoute);
+
+    // a/b/c/d inherits the strategy bound to a/b/c, a/b/a still uses the default
+    strategy = athenaFIB_GetStrategy(data->testFIB, data->testName4);
+    assertTrue(strcmp(athenaForwardingStrategy_GetName(strategy), "best-route") == 0, "Expected best-route for a longer name");
+    strategy = athenaFIB_GetStrategy(data->testFIB, data->testName2);
+    assertTrue(strcmp(athenaForwardingStrategy_GetName(strategy), "multicast") == 0, "Expected multicast for an unbound name");
+
+    AthenaForwardingStrategy *random = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_RandomImplementation, NULL);
+    athenaFIB_SetStrategy(data->testFIB, data->testName3, random);
+    athenaForwardingStrategy_Release(&random);
+
+    strategy = athenaFIB_GetStrategy(data->testFIB, data->testName2);
+    assertTrue(strcmp(athenaForwardingStrategy_GetName(strategy), "random") == 0, "Expected the new default strategy");
+}
+
 LONGBOW_TEST_CASE(Global, athenaFIB_ProcessMessage)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
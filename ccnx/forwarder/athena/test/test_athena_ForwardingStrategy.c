@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../athena_ForwardingStrategy.c"
+#include "../athena_ForwardingStrategies.c"
+
+#include <LongBow/unit-test.h>
+
+#include <stdio.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+static
+struct timeval _TestClockTimeval = {
+    .tv_sec  = 0,
+    .tv_usec = 0
+};
+
+static void
+_testClock_GetTimeval(const PARCClock *dummy __attribute__((unused)), struct timeval *output)
+{
+    output->tv_sec = _TestClockTimeval.tv_sec;
+    output->tv_usec = _TestClockTimeval.tv_usec;
+}
+
+static uint64_t
+_testClock_GetTime(const PARCClock *clock)
+{
+    struct timeval tv;
+    _testClock_GetTimeval(clock, &tv);
+    uint64_t t = tv.tv_sec * 1000 + tv.tv_usec / 1000;
+
+    return t;
+}
+
+static PARCClock *
+_testClock_Acquire(const PARCClock *clock)
+{
+    return (PARCClock *) clock;
+}
+
+static void
+_testClock_Release(PARCClock **clockPtr)
+{
+    *clockPtr = NULL;
+}
+
+static PARCClock _TestClock = {
+    .closure    = NULL,
+    .getTime    = _testClock_GetTime,
+    .getTimeval = _testClock_GetTimeval,
+    .acquire    = _testClock_Acquire,
+    .release    = _testClock_Release
+};
+
+static void
+_testClock_Advance(uint64_t milliseconds)
+{
+    uint64_t usec = _TestClockTimeval.tv_usec + milliseconds * 1000;
+    _TestClockTimeval.tv_sec += usec / 1000000;
+    _TestClockTimeval.tv_usec = usec % 1000000;
+}
+
+typedef struct test_data {
+    CCNxInterest *interest;
+    AthenaNexthopList *nexthops;
+} TestData;
+
+LONGBOW_TEST_RUNNER(athena_ForwardingStrategy)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(athena_ForwardingStrategy)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_ForwardingStrategy)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_CreateRelease);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_LookupInterface);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Multicast);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_BestRoute);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_BestRoute_Cost);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_LoadBalance);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_LoadBalance_Cost);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Random);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Random_Weighted);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Random_Callback);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_PrefersFastest);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_Timeout);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_Loss);
+    LONGBOW_RUN_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_LinkRemoved);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%lu) returned NULL", sizeof(TestData));
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/a/b/c");
+    data->interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    data->nexthops = athenaNexthopList_Create();
+    athenaNexthopList_Set(data->nexthops, 3, AthenaNexthop_DefaultCost, AthenaNexthop_DefaultWeight);
+    athenaNexthopList_Set(data->nexthops, 5, AthenaNexthop_DefaultCost, AthenaNexthop_DefaultWeight);
+    athenaNexthopList_Set(data->nexthops, 42, AthenaNexthop_DefaultCost, AthenaNexthop_DefaultWeight);
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxInterest_Release(&data->interest);
+    athenaNexthopList_Release(&data->nexthops);
+    parcMemory_Deallocate((void **) &data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_CreateRelease)
+{
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_LoadBalanceImplementation, NULL);
+    assertNotNull(strategy, "Expected athenaForwardingStrategy_Create to return a non-NULL value");
+
+    AthenaForwardingStrategy *acquired = athenaForwardingStrategy_Acquire(strategy);
+    athenaForwardingStrategy_Release(&acquired);
+    assertNull(acquired, "Expected athenaForwardingStrategy_Release to NULL the pointer");
+
+    athenaForwardingStrategy_Release(&strategy);
+    assertNull(strategy, "Expected athenaForwardingStrategy_Release to NULL the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_LookupInterface)
+{
+    assertTrue(athenaForwardingStrategy_LookupInterface("multicast") == &AthenaForwardingStrategy_MulticastImplementation,
+               "Expected to find the multicast strategy");
+    assertTrue(athenaForwardingStrategy_LookupInterface("best-route") == &AthenaForwardingStrategy_BestRouteImplementation,
+               "Expected to find the best-route strategy");
+    assertTrue(athenaForwardingStrategy_LookupInterface("Load-Balance") == &AthenaForwardingStrategy_LoadBalanceImplementation,
+               "Expected to find the load-balance strategy");
+    assertTrue(athenaForwardingStrategy_LookupInterface("random") == &AthenaForwardingStrategy_RandomImplementation,
+               "Expected to find the random strategy");
+    assertTrue(athenaForwardingStrategy_LookupInterface("adaptive") == &AthenaForwardingStrategy_AdaptiveImplementation,
+               "Expected to find the adaptive strategy");
+    assertNull(athenaForwardingStrategy_LookupInterface("unknown"), "Expected no strategy for an unknown name");
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Multicast)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_MulticastImplementation, NULL);
+
+    PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+    assertTrue(parcBitVector_Equals(egress, athenaNexthopList_GetVector(data->nexthops)), "Expected all nexthops to be selected");
+    parcBitVector_Release(&egress);
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_BestRoute)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_BestRouteImplementation, NULL);
+
+    for (int i = 0; i < 3; i++) {
+        PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+        assertTrue(parcBitVector_NumberOfBitsSet(egress) == 1, "Expected a single nexthop to be selected");
+        assertTrue(parcBitVector_Get(egress, 3) == 1, "Expected the first nexthop to be selected");
+        parcBitVector_Release(&egress);
+    }
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_BestRoute_Cost)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_BestRouteImplementation, NULL);
+
+    // Make the highest numbered link the cheapest
+    athenaNexthopList_Set(data->nexthops, 42, 0, AthenaNexthop_DefaultWeight);
+
+    PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+    assertTrue(parcBitVector_NumberOfBitsSet(egress) == 1, "Expected a single nexthop to be selected");
+    assertTrue(parcBitVector_Get(egress, 42) == 1, "Expected the lowest cost nexthop to be selected");
+    parcBitVector_Release(&egress);
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_LoadBalance)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_LoadBalanceImplementation, NULL);
+
+    int expected[] = { 3, 5, 42, 3 };
+    for (int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+        assertTrue(parcBitVector_NumberOfBitsSet(egress) == 1, "Expected a single nexthop to be selected");
+        assertTrue(parcBitVector_Get(egress, expected[i]) == 1, "Expected nexthop %d to be selected", expected[i]);
+        parcBitVector_Release(&egress);
+    }
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_LoadBalance_Cost)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_LoadBalanceImplementation, NULL);
+
+    // Link 5 is a backup, load is only shared between the lowest cost nexthops
+    athenaNexthopList_Set(data->nexthops, 5, AthenaNexthop_DefaultCost + 1, AthenaNexthop_DefaultWeight);
+
+    int expected[] = { 3, 42, 3, 42 };
+    for (int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+        assertTrue(parcBitVector_NumberOfBitsSet(egress) == 1, "Expected a single nexthop to be selected");
+        assertTrue(parcBitVector_Get(egress, expected[i]) == 1, "Expected nexthop %d to be selected", expected[i]);
+        parcBitVector_Release(&egress);
+    }
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Random)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_RandomImplementation, NULL);
+
+    for (int i = 0; i < 100; i++) {
+        PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+        assertTrue(parcBitVector_NumberOfBitsSet(egress) == 1, "Expected a single nexthop to be selected");
+        assertTrue(parcBitVector_Contains(athenaNexthopList_GetVector(data->nexthops), egress), "Expected the selection to be one of the nexthops");
+        parcBitVector_Release(&egress);
+    }
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Random_Weighted)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_RandomImplementation, NULL);
+
+    // Link 3 carries 8 times the load of link 42, link 5 is a backup and never used
+    athenaNexthopList_Set(data->nexthops, 3, AthenaNexthop_DefaultCost, 8);
+    athenaNexthopList_Set(data->nexthops, 5, AthenaNexthop_DefaultCost + 1, 100);
+
+    int selected[43] = { 0 };
+    for (int i = 0; i < 900; i++) {
+        PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+        assertTrue(parcBitVector_NumberOfBitsSet(egress) == 1, "Expected a single nexthop to be selected");
+        selected[parcBitVector_NextBitSet(egress, 0)]++;
+        parcBitVector_Release(&egress);
+    }
+
+    assertTrue(selected[5] == 0, "Expected the higher cost nexthop not to be selected");
+    assertTrue(selected[3] + selected[42] == 900, "Expected only the lowest cost nexthops to be selected");
+    assertTrue(selected[3] > 4 * selected[42], "Expected the weights to skew the selection (%d vs %d)", selected[3], selected[42]);
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+static uint64_t
+_testRandom(void *context)
+{
+    uint64_t *value = (uint64_t *) context;
+    return (*value)++;
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Random_Callback)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    uint64_t value = 0;
+    AthenaBuiltInStrategyConfig config = { .random = _testRandom, .randomContext = &value };
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_RandomImplementation, &config);
+
+    // Link 3 carries 2 times the load of link 42, the choices follow the configured random source
+    athenaNexthopList_Set(data->nexthops, 3, AthenaNexthop_DefaultCost, 2);
+    athenaNexthopList_Set(data->nexthops, 5, AthenaNexthop_DefaultCost + 1, 1);
+    int expected[] = { 3, 3, 42, 3, 3, 42 };
+    for (int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+        assertTrue(parcBitVector_Get(egress, expected[i]) == 1, "Expected selection %d to be link %d", i, expected[i]);
+        parcBitVector_Release(&egress);
+    }
+    assertTrue(value == 6, "Expected a random value to be drawn for each selection");
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+static AthenaForwardingStrategy *
+_createAdaptiveStrategy(TestData *data)
+{
+    AthenaBuiltInStrategyConfig config = { .clock = &_TestClock };
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_AdaptiveImplementation, &config);
+
+    CCNxName *name = ccnxInterest_GetName(data->interest);
+    athenaForwardingStrategy_InterestSatisfied(strategy, name, 3, 80);
+    athenaForwardingStrategy_InterestSatisfied(strategy, name, 5, 2);
+
+    return strategy;
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_PrefersFastest)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = _createAdaptiveStrategy(data);
+    CCNxName *name = ccnxInterest_GetName(data->interest);
+
+    int probes = 0;
+    for (int i = 0; i < 2 * ADAPTIVE_PROBE_INTERVAL; i++) {
+        PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+        assertTrue(parcBitVector_Get(egress, 5) == 1, "Expected the fastest nexthop to be selected");
+        if (parcBitVector_NumberOfBitsSet(egress) > 1) {
+            probes++;
+        }
+        parcBitVector_Release(&egress);
+
+        _testClock_Advance(2);
+        athenaForwardingStrategy_InterestSatisfied(strategy, name, 5, 2);
+    }
+    assertTrue(probes == 2, "Expected an alternate nexthop to be probed every %d interests, got %d probes", ADAPTIVE_PROBE_INTERVAL, probes);
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_Timeout)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = _createAdaptiveStrategy(data);
+
+    PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+    assertTrue(parcBitVector_Get(egress, 5) == 1, "Expected the fastest nexthop to be selected");
+    parcBitVector_Release(&egress);
+
+    // No response from the fastest nexthop within its retransmission timeout, fail over to the next best
+    _testClock_Advance(ADAPTIVE_MIN_RTO + 1);
+
+    egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+    assertTrue(parcBitVector_Get(egress, 5) == 0, "Expected the unresponsive nexthop to be passed over");
+    assertTrue(parcBitVector_Get(egress, 3) == 1, "Expected the next fastest nexthop to be selected");
+    parcBitVector_Release(&egress);
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_Loss)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaBuiltInStrategyConfig config = { .clock = &_TestClock };
+    AthenaForwardingStrategy *strategy = athenaForwardingStrategy_Create(&AthenaForwardingStrategy_AdaptiveImplementation, &config);
+    CCNxName *name = ccnxInterest_GetName(data->interest);
+
+    athenaForwardingStrategy_InterestSatisfied(strategy, name, 3, 10);
+    athenaForwardingStrategy_InterestSatisfied(strategy, name, 5, 12);
+
+    PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+    assertTrue(parcBitVector_Get(egress, 3) == 1, "Expected the fastest nexthop to be selected");
+    parcBitVector_Release(&egress);
+
+    athenaForwardingStrategy_InterestFailed(strategy, name, 3);
+
+    egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+    assertTrue(parcBitVector_Get(egress, 5) == 1, "Expected the lossy nexthop to be passed over");
+    parcBitVector_Release(&egress);
+
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+LONGBOW_TEST_CASE(Global, athenaForwardingStrategy_Adaptive_LinkRemoved)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    AthenaForwardingStrategy *strategy = _createAdaptiveStrategy(data);
+
+    // A link opened with the id of a removed one starts out unmeasured
+    athenaForwardingStrategy_LinkRemoved(strategy, 5);
+
+    PARCBitVector *egress = athenaForwardingStrategy_SelectEgress(strategy, data->interest, data->nexthops);
+    assertTrue(parcBitVector_Get(egress, 5) == 0, "Expected the removed link's measurements to be dropped");
+    assertTrue(parcBitVector_Get(egress, 3) == 1, "Expected the remaining measured nexthop to be selected");
+    parcBitVector_Release(&egress);
+
+    athenaForwardingStrategy_LinkRemoved(strategy, 1000); // never measured
+    athenaForwardingStrategy_Release(&strategy);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(athena_ForwardingStrategy);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
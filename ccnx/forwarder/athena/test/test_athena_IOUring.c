@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include "../athena_IOUring.c"
+#include <LongBow/unit-test.h>
+
+#include <poll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+LONGBOW_TEST_RUNNER(athena_IOUring)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+/*
+ * If the kernel doesn't support io_uring, we cannot run any of these tests.
+ */
+static bool
+_checkForIOUringAvailability(void)
+{
+    bool result = false;
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd != -1) {
+        AthenaIOUring *athenaIOUring = athenaIOUring_Create(fd, false, 1, 64);
+        if (athenaIOUring) {
+            athenaIOUring_Release(&athenaIOUring);
+            result = true;
+        }
+        close(fd);
+    }
+    return result;
+}
+
+LONGBOW_TEST_RUNNER_SETUP(athena_IOUring)
+{
+    if (_checkForIOUringAvailability() == true) {
+        return LONGBOW_STATUS_SUCCEEDED;
+    } else {
+        exit(77);
+        return LONGBOW_STATUS_SETUP_SKIPTESTS;
+    }
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_IOUring)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaIOUring_CreateRelease);
+    LONGBOW_RUN_TEST_CASE(Global, athenaIOUring_DatagramSendReceive);
+    LONGBOW_RUN_TEST_CASE(Global, athenaIOUring_DatagramBufferReuse);
+    LONGBOW_RUN_TEST_CASE(Global, athenaIOUring_StreamSendReceive);
+    LONGBOW_RUN_TEST_CASE(Global, athenaIOUring_ReleaseWithSendsOutstanding);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+typedef struct _ReceiveContext {
+    uint8_t data[8192];
+    size_t length;
+    size_t messages;
+    bool endOfStream;
+    int error;
+    struct sockaddr_storage peerAddress;
+} _ReceiveContext;
+
+static void
+_receiveCallback(void *context, const uint8_t *data, size_t length,
+                 const struct sockaddr *peerAddress, socklen_t peerAddressLength, int error)
+{
+    _ReceiveContext *receiveContext = (_ReceiveContext *) context;
+    if (error) {
+        receiveContext->error = error;
+        return;
+    }
+    if ((length == 0) && (peerAddress == NULL)) {
+        receiveContext->endOfStream = true;
+        return;
+    }
+    if ((receiveContext->length + length) <= sizeof(receiveContext->data)) {
+        memcpy(&receiveContext->data[receiveContext->length], data, length);
+    }
+    receiveContext->length += length;
+    receiveContext->messages++;
+    if (peerAddress) {
+        memcpy(&receiveContext->peerAddress, peerAddress, peerAddressLength);
+    }
+}
+
+static int
+_boundUDPSocket(struct sockaddr_in *address)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    assertTrue(fd != -1, "socket failed (%s)", strerror(errno));
+    memset(address, 0, sizeof(struct sockaddr_in));
+    address->sin_family = AF_INET;
+    address->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int result = bind(fd, (struct sockaddr *) address, sizeof(struct sockaddr_in));
+    assertTrue(result == 0, "bind failed (%s)", strerror(errno));
+    socklen_t addressLength = sizeof(struct sockaddr_in);
+    getsockname(fd, (struct sockaddr *) address, &addressLength);
+    return fd;
+}
+
+//
+// Reap the ring until the context has received the expected number of bytes, or a second has passed.
+//
+static void
+_reapUntil(AthenaIOUring *athenaIOUring, _ReceiveContext *receiveContext, size_t length)
+{
+    struct pollfd pollfd = { .fd = athenaIOUring_GetEventFd(athenaIOUring), .events = POLLIN };
+    for (int attempts = 0; (attempts < 100) && (receiveContext->length < length); attempts++) {
+        poll(&pollfd, 1, 10);
+        athenaIOUring_Reap(athenaIOUring);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, athenaIOUring_CreateRelease)
+{
+    struct sockaddr_in address;
+    int fd = _boundUDPSocket(&address);
+
+    AthenaIOUring *athenaIOUring = athenaIOUring_Create(fd, false, 8, 1500);
+    assertNotNull(athenaIOUring, "athenaIOUring_Create failed (%s)", strerror(errno));
+    assertTrue(athenaIOUring_GetEventFd(athenaIOUring) != -1, "athenaIOUring_GetEventFd returned an invalid descriptor");
+    assertTrue(athenaIOUring_GetSendFailures(athenaIOUring) == 0, "New ring has send failures");
+
+    AthenaIOUring *reference = athenaIOUring_Acquire(athenaIOUring);
+    athenaIOUring_Release(&reference);
+    assertNull(reference, "athenaIOUring_Release did not clear the reference");
+
+    // The ring holds its own descriptor, the socket can be closed first
+    close(fd);
+    int result = athenaIOUring_Receive(athenaIOUring, _receiveCallback, NULL);
+    assertTrue(result == 0, "athenaIOUring_Receive failed (%s)", strerror(errno));
+    athenaIOUring_Submit(athenaIOUring);
+
+    athenaIOUring_Release(&athenaIOUring);
+    assertNull(athenaIOUring, "athenaIOUring_Release did not clear the reference");
+}
+
+LONGBOW_TEST_CASE(Global, athenaIOUring_DatagramSendReceive)
+{
+    struct sockaddr_in ringAddress;
+    int ringFd = _boundUDPSocket(&ringAddress);
+    struct sockaddr_in peerAddress;
+    int peerFd = _boundUDPSocket(&peerAddress);
+
+    AthenaIOUring *athenaIOUring = athenaIOUring_Create(ringFd, false, 8, 1500);
+    assertNotNull(athenaIOUring, "athenaIOUring_Create failed (%s)", strerror(errno));
+
+    _ReceiveContext receiveContext = { .length = 0 };
+    int result = athenaIOUring_Receive(athenaIOUring, _receiveCallback, &receiveContext);
+    assertTrue(result == 0, "athenaIOUring_Receive failed (%s)", strerror(errno));
+    athenaIOUring_Submit(athenaIOUring);
+
+    const char *message = "a message for the ring";
+    ssize_t writeCount = sendto(peerFd, message, strlen(message), 0, (struct sockaddr *) &ringAddress, sizeof(ringAddress));
+    assertTrue(writeCount == strlen(message), "sendto failed (%s)", strerror(errno));
+
+    _reapUntil(athenaIOUring, &receiveContext, strlen(message));
+    assertTrue(receiveContext.messages == 1, "Expected one message, received %zu", receiveContext.messages);
+    assertTrue(memcmp(receiveContext.data, message, strlen(message)) == 0, "Received message doesn't match");
+    assertTrue(((struct sockaddr_in *) &receiveContext.peerAddress)->sin_port == peerAddress.sin_port,
+               "Received message has the wrong peer address");
+
+    // A datagram larger than the ring's buffers is dropped
+    char oversize[2000] = { 0 };
+    sendto(peerFd, oversize, sizeof(oversize), 0, (struct sockaddr *) &ringAddress, sizeof(ringAddress));
+    sendto(peerFd, message, strlen(message), 0, (struct sockaddr *) &ringAddress, sizeof(ringAddress));
+    _reapUntil(athenaIOUring, &receiveContext, 2 * strlen(message));
+    assertTrue(receiveContext.messages == 2, "Expected the oversize message to be dropped");
+
+    PARCBuffer *buffer = parcBuffer_WrapCString("a message from the ring");
+    result = athenaIOUring_Send(athenaIOUring, buffer, (struct sockaddr *) &peerAddress, sizeof(peerAddress));
+    assertTrue(result == 0, "athenaIOUring_Send failed (%s)", strerror(errno));
+    parcBuffer_Release(&buffer);
+    athenaIOUring_Submit(athenaIOUring);
+
+    char readBuffer[64];
+    struct pollfd pollfd = { .fd = peerFd, .events = POLLIN };
+    poll(&pollfd, 1, 1000);
+    ssize_t readCount = recv(peerFd, readBuffer, sizeof(readBuffer), MSG_DONTWAIT);
+    assertTrue(readCount == strlen("a message from the ring"), "Unexpected read count %zd", readCount);
+    assertTrue(memcmp(readBuffer, "a message from the ring", readCount) == 0, "Sent message doesn't match");
+
+    athenaIOUring_Release(&athenaIOUring);
+    close(ringFd);
+    close(peerFd);
+}
+
+LONGBOW_TEST_CASE(Global, athenaIOUring_DatagramBufferReuse)
+{
+    struct sockaddr_in ringAddress;
+    int ringFd = _boundUDPSocket(&ringAddress);
+    struct sockaddr_in peerAddress;
+    int peerFd = _boundUDPSocket(&peerAddress);
+
+    // Far more messages than buffers, the receive is posted again as buffers are returned
+    AthenaIOUring *athenaIOUring = athenaIOUring_Create(ringFd, false, 4, 1500);
+    assertNotNull(athenaIOUring, "athenaIOUring_Create failed (%s)", strerror(errno));
+
+    _ReceiveContext receiveContext = { .length = 0 };
+    athenaIOUring_Receive(athenaIOUring, _receiveCallback, &receiveContext);
+    athenaIOUring_Submit(athenaIOUring);
+
+    size_t messageCount = 100;
+    for (size_t i = 0; i < messageCount; i++) {
+        sendto(peerFd, &i, sizeof(i), 0, (struct sockaddr *) &ringAddress, sizeof(ringAddress));
+        if ((i % 8) == 7) {
+            _reapUntil(athenaIOUring, &receiveContext, (i + 1) * sizeof(i));
+        }
+    }
+    _reapUntil(athenaIOUring, &receiveContext, messageCount * sizeof(size_t));
+    assertTrue(receiveContext.messages == messageCount, "Expected %zu messages, received %zu", messageCount, receiveContext.messages);
+    assertTrue(receiveContext.error == 0, "Receive failed (%s)", strerror(receiveContext.error));
+
+    athenaIOUring_Release(&athenaIOUring);
+    close(ringFd);
+    close(peerFd);
+}
+
+LONGBOW_TEST_CASE(Global, athenaIOUring_StreamSendReceive)
+{
+    int fds[2];
+    int result = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assertTrue(result == 0, "socketpair failed (%s)", strerror(errno));
+
+    AthenaIOUring *athenaIOUring = athenaIOUring_Create(fds[0], true, 4, 256);
+    assertNotNull(athenaIOUring, "athenaIOUring_Create failed (%s)", strerror(errno));
+
+    _ReceiveContext receiveContext = { .length = 0 };
+    athenaIOUring_Receive(athenaIOUring, _receiveCallback, &receiveContext);
+    athenaIOUring_Submit(athenaIOUring);
+
+    // Sends are issued in the order they were queued
+    size_t sendCount = 512;
+    for (uint32_t i = 0; i < sendCount; i++) {
+        PARCBuffer *buffer = parcBuffer_Allocate(sizeof(i));
+        parcBuffer_PutUint32(buffer, i);
+        parcBuffer_Flip(buffer);
+        while (athenaIOUring_Send(athenaIOUring, buffer, NULL, 0) == -1) {
+            assertTrue(errno == ENOBUFS, "athenaIOUring_Send failed (%s)", strerror(errno));
+            usleep(1000);
+        }
+        parcBuffer_Release(&buffer);
+    }
+    athenaIOUring_Submit(athenaIOUring);
+
+    uint8_t readBuffer[4 * 512];
+    size_t readLength = 0;
+    while (readLength < sizeof(readBuffer)) {
+        struct pollfd pollfd = { .fd = fds[1], .events = POLLIN };
+        assertTrue(poll(&pollfd, 1, 1000) == 1, "Timed out waiting for sends");
+        ssize_t readCount = read(fds[1], &readBuffer[readLength], sizeof(readBuffer) - readLength);
+        assertTrue(readCount > 0, "read failed (%s)", strerror(errno));
+        readLength += readCount;
+        athenaIOUring_Reap(athenaIOUring);
+    }
+    for (uint32_t i = 0; i < sendCount; i++) {
+        uint32_t value = ((uint32_t) readBuffer[i * 4] << 24) | ((uint32_t) readBuffer[i * 4 + 1] << 16) |
+                         ((uint32_t) readBuffer[i * 4 + 2] << 8) | readBuffer[i * 4 + 3];
+        assertTrue(value == i, "Send %u arrived out of order, found %u", i, value);
+    }
+
+    // A stream is received in chunks no larger than the ring's buffers
+    uint8_t writeBuffer[1024];
+    for (size_t i = 0; i < sizeof(writeBuffer); i++) {
+        writeBuffer[i] = (uint8_t) i;
+    }
+    ssize_t writeCount = write(fds[1], writeBuffer, sizeof(writeBuffer));
+    assertTrue(writeCount == sizeof(writeBuffer), "write failed (%s)", strerror(errno));
+    _reapUntil(athenaIOUring, &receiveContext, sizeof(writeBuffer));
+    assertTrue(receiveContext.length == sizeof(writeBuffer), "Expected %zu bytes, received %zu", sizeof(writeBuffer), receiveContext.length);
+    assertTrue(memcmp(receiveContext.data, writeBuffer, sizeof(writeBuffer)) == 0, "Received stream doesn't match");
+
+    // Our peer hanging up ends the stream
+    close(fds[1]);
+    struct pollfd pollfd = { .fd = athenaIOUring_GetEventFd(athenaIOUring), .events = POLLIN };
+    for (int attempts = 0; (attempts < 100) && (receiveContext.endOfStream == false); attempts++) {
+        poll(&pollfd, 1, 10);
+        athenaIOUring_Reap(athenaIOUring);
+    }
+    assertTrue(receiveContext.endOfStream, "End of stream was not reported");
+
+    athenaIOUring_Release(&athenaIOUring);
+    close(fds[0]);
+}
+
+LONGBOW_TEST_CASE(Global, athenaIOUring_ReleaseWithSendsOutstanding)
+{
+    int fds[2];
+    int result = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assertTrue(result == 0, "socketpair failed (%s)", strerror(errno));
+
+    AthenaIOUring *athenaIOUring = athenaIOUring_Create(fds[0], true, 4, 256);
+    assertNotNull(athenaIOUring, "athenaIOUring_Create failed (%s)", strerror(errno));
+
+    // Our peer never reads, so sends stall once the socket's buffer fills
+    size_t failures = 0;
+    for (int i = 0; i < 1024; i++) {
+        PARCBuffer *buffer = parcBuffer_Allocate(4096);
+        parcBuffer_SetPosition(buffer, 4096);
+        parcBuffer_Flip(buffer);
+        if (athenaIOUring_Send(athenaIOUring, buffer, NULL, 0) == -1) {
+            assertTrue(errno == ENOBUFS, "athenaIOUring_Send failed (%s)", strerror(errno));
+            failures++;
+        }
+        parcBuffer_Release(&buffer);
+        athenaIOUring_Submit(athenaIOUring);
+    }
+    assertTrue(failures > 0, "Expected sends to fail once the ring was full");
+    assertTrue(athenaIOUring_GetSendFailures(athenaIOUring) == failures, "Send failures were not counted");
+
+    // Outstanding sends are cancelled and their buffers released, checked by the fixture teardown
+    athenaIOUring_Release(&athenaIOUring);
+    close(fds[0]);
+    close(fds[1]);
+}
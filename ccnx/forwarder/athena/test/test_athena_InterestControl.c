@@ -63,6 +63,7 @@
 
 #include <errno.h>
 #include <pthread.h>
+#include <unistd.h>
 
 #include <parc/algol/parc_SafeMemory.h>
 
@@ -116,6 +117,14 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+static void
+_waitForRouteLoad(Athena *athena)
+{
+    while (athenaInterestControl_SwapLoadedRoutes(athena)) {
+        usleep(1000);
+    }
+}
+
 LONGBOW_TEST_CASE(Global, athenaInterestControl_FIB)
 {
     const char *linkSpecification;
@@ -208,6 +217,71 @@ LONGBOW_TEST_CASE(Global, athenaInterestControl_FIB)
 
     ccnxMetaMessage_Release(&interest);
 
+    name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_FIBLoad);
+    interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    linkSpecification = "# routes\nlci:/foo/bar TCP_0\nlci:/foo/baz TCP_0 10 2\n"; // replaces the routes added above
+
+    payload = parcBuffer_AllocateCString(linkSpecification);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    athena_EncodeMessage(interest);
+
+    athenaInterestControl(athena, interest, ingressVector);
+    _waitForRouteLoad(athena);
+
+    ccnxMetaMessage_Release(&interest);
+
+    name = ccnxName_CreateFromCString("lci:/foo/baz");
+    PARCBitVector *egressVector = athenaFIB_Lookup(athena->athenaFIB, name, NULL);
+    assertNotNull(egressVector, "Expected loaded route to be in the FIB");
+    parcBitVector_Release(&egressVector);
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_FIBLoad);
+    interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    linkSpecification = "lci:/foo/qux TCP_0\nlci:/foo/quux unknownLink\n"; // unknown link, FIB left unchanged
+
+    payload = parcBuffer_AllocateCString(linkSpecification);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    athena_EncodeMessage(interest);
+
+    athenaInterestControl(athena, interest, ingressVector);
+    _waitForRouteLoad(athena);
+
+    ccnxMetaMessage_Release(&interest);
+
+    name = ccnxName_CreateFromCString("lci:/foo/qux");
+    egressVector = athenaFIB_Lookup(athena->athenaFIB, name, NULL);
+    assertNull(egressVector, "Expected a failed load to leave the FIB unchanged");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_FIBLoad);
+    interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    linkSpecification = "/etc/passwd"; // file paths aren't opened, this is an invalid route
+
+    payload = parcBuffer_AllocateCString(linkSpecification);
+    ccnxInterest_SetPayload(interest, payload);
+    parcBuffer_Release(&payload);
+
+    athena_EncodeMessage(interest);
+
+    athenaInterestControl(athena, interest, ingressVector);
+    _waitForRouteLoad(athena);
+
+    ccnxMetaMessage_Release(&interest);
+
+    name = ccnxName_CreateFromCString("lci:/foo/baz");
+    egressVector = athenaFIB_Lookup(athena->athenaFIB, name, NULL);
+    assertNotNull(egressVector, "Expected a path given as routes to leave the FIB unchanged");
+    parcBitVector_Release(&egressVector);
+    ccnxName_Release(&name);
+
     name = ccnxName_CreateFromCString(CCNxNameAthenaCommand_FIBLookup);
     interest = ccnxInterest_CreateSimple(name);
     ccnxName_Release(&name);
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../athena_InterestShaper.c"
+
+#include <LongBow/unit-test.h>
+
+#include <stdio.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+
+//
+// 1.2Mbps carries 150 1500 byte Content Objects a second, one every 10ms,
+// and its 50ms burst allowance covers 5 of them.
+//
+#define TEST_BANDWIDTH 1200000
+#define TEST_INTERVAL 10
+#define TEST_BURST 5
+
+typedef struct {
+    AthenaInterestShaper *shaper;
+    CCNxMetaMessage *interest;
+} _TestData;
+
+LONGBOW_TEST_RUNNER(athena_InterestShaper)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(athena_InterestShaper)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_InterestShaper)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaInterestShaper_CreateRelease);
+    LONGBOW_RUN_TEST_CASE(Global, athenaInterestShaper_Admit_Unshaped);
+    LONGBOW_RUN_TEST_CASE(Global, athenaInterestShaper_Admit_Burst);
+    LONGBOW_RUN_TEST_CASE(Global, athenaInterestShaper_Admit_Congested);
+    LONGBOW_RUN_TEST_CASE(Global, athenaInterestShaper_Next_Paced);
+    LONGBOW_RUN_TEST_CASE(Global, athenaInterestShaper_Next_ShapingDisabled);
+    LONGBOW_RUN_TEST_CASE(Global, athenaInterestShaper_ContentObjectReceived);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    _TestData *data = parcMemory_AllocateAndClear(sizeof(_TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear returned NULL");
+
+    data->shaper = athenaInterestShaper_Create();
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/test/shaper");
+    data->interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    athenaInterestShaper_Release(&data->shaper);
+    ccnxMetaMessage_Release(&data->interest);
+    parcMemory_Deallocate(&data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, athenaInterestShaper_CreateRelease)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaInterestShaper *shaper = athenaInterestShaper_Create();
+    assertNotNull(shaper, "Expected athenaInterestShaper_Create to return a non-NULL value");
+    assertTrue(athenaInterestShaper_GetBandwidth(shaper) == 0, "Expected a new shaper to be disabled");
+    assertTrue(athenaInterestShaper_GetMaxDelay(shaper) == AthenaInterestShaper_DefaultMaxDelay, "Expected the default delay");
+    assertTrue(athenaInterestShaper_GetObjectSize(shaper) == AthenaInterestShaper_DefaultObjectSize, "Expected the default size");
+    assertTrue(athenaInterestShaper_TimeUntilNext(shaper, 0) == -1, "Expected no Interests held");
+
+    // Interests still held are released with the shaper
+    athenaInterestShaper_SetBandwidth(shaper, TEST_BANDWIDTH);
+    athenaInterestShaper_SetMaxDelay(shaper, 1000);
+    for (int i = 0; i < TEST_BURST + 1; i++) {
+        athenaInterestShaper_Admit(shaper, data->interest, 0);
+    }
+    assertTrue(athenaInterestShaper_Depth(shaper) == 1, "Expected an Interest to be held");
+    athenaInterestShaper_Release(&shaper);
+    assertNull(shaper, "Expected athenaInterestShaper_Release to NULL the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, athenaInterestShaper_Admit_Unshaped)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    for (int i = 0; i < 100; i++) {
+        assertTrue(athenaInterestShaper_Admit(data->shaper, data->interest, 0) == AthenaInterestShaper_Forward,
+                   "Expected Interest %d to be forwarded without a bandwidth", i);
+    }
+    assertTrue(athenaInterestShaper_GetForwardedCount(data->shaper) == 100, "Expected 100 forwarded");
+}
+
+LONGBOW_TEST_CASE(Global, athenaInterestShaper_Admit_Burst)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaInterestShaper_SetBandwidth(data->shaper, TEST_BANDWIDTH);
+    for (int i = 0; i < TEST_BURST; i++) {
+        assertTrue(athenaInterestShaper_Admit(data->shaper, data->interest, 1000) == AthenaInterestShaper_Forward,
+                   "Expected Interest %d to be forwarded within the burst", i);
+    }
+    assertTrue(athenaInterestShaper_Admit(data->shaper, data->interest, 1000) == AthenaInterestShaper_Held,
+               "Expected an Interest beyond the burst to be held");
+    assertTrue(athenaInterestShaper_TimeUntilNext(data->shaper, 1000) == TEST_INTERVAL,
+               "Expected the held Interest to wait for one interval");
+
+    // A held Interest keeps later ones behind it even once there's capacity
+    assertTrue(athenaInterestShaper_Admit(data->shaper, data->interest, 1000 + TEST_INTERVAL) == AthenaInterestShaper_Held,
+               "Expected an Interest to be held behind one already waiting");
+    assertTrue(athenaInterestShaper_GetHeldCount(data->shaper) == 2, "Expected 2 held");
+}
+
+LONGBOW_TEST_CASE(Global, athenaInterestShaper_Admit_Congested)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // Capacity for the burst and then one Interest per interval of the maximum delay
+    athenaInterestShaper_SetBandwidth(data->shaper, TEST_BANDWIDTH);
+    athenaInterestShaper_SetMaxDelay(data->shaper, 3 * TEST_INTERVAL);
+    for (int i = 0; i < TEST_BURST + 3; i++) {
+        assertFalse(athenaInterestShaper_Admit(data->shaper, data->interest, 0) == AthenaInterestShaper_Congested,
+                    "Expected Interest %d to be accepted", i);
+    }
+    assertTrue(athenaInterestShaper_Admit(data->shaper, data->interest, 0) == AthenaInterestShaper_Congested,
+               "Expected an Interest beyond the maximum delay to be refused");
+    assertTrue(athenaInterestShaper_GetCongestedCount(data->shaper) == 1, "Expected 1 refused");
+    assertTrue(athenaInterestShaper_Depth(data->shaper) == 3, "Expected a refused Interest not to be held");
+
+    // Without a delay only the burst is accepted
+    athenaInterestShaper_SetMaxDelay(data->shaper, 0);
+    assertTrue(athenaInterestShaper_Admit(data->shaper, data->interest, 0) == AthenaInterestShaper_Congested,
+               "Expected an Interest to be refused without a delay");
+}
+
+LONGBOW_TEST_CASE(Global, athenaInterestShaper_Next_Paced)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaInterestShaper_SetBandwidth(data->shaper, TEST_BANDWIDTH);
+    for (int i = 0; i < TEST_BURST + 2; i++) {
+        athenaInterestShaper_Admit(data->shaper, data->interest, 0);
+    }
+    assertNull(athenaInterestShaper_Next(data->shaper, TEST_INTERVAL - 1), "Expected nothing to send before an interval");
+
+    CCNxMetaMessage *interest = athenaInterestShaper_Next(data->shaper, TEST_INTERVAL);
+    assertTrue(interest == data->interest, "Expected the held Interest after an interval");
+    ccnxMetaMessage_Release(&interest);
+    assertNull(athenaInterestShaper_Next(data->shaper, TEST_INTERVAL), "Expected one Interest per interval");
+    assertTrue(athenaInterestShaper_TimeUntilNext(data->shaper, TEST_INTERVAL) == TEST_INTERVAL,
+               "Expected the next Interest an interval later");
+
+    interest = athenaInterestShaper_Next(data->shaper, 2 * TEST_INTERVAL);
+    assertNotNull(interest, "Expected the second held Interest after two intervals");
+    ccnxMetaMessage_Release(&interest);
+    assertTrue(athenaInterestShaper_TimeUntilNext(data->shaper, 2 * TEST_INTERVAL) == -1, "Expected no Interests held");
+}
+
+LONGBOW_TEST_CASE(Global, athenaInterestShaper_Next_ShapingDisabled)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaInterestShaper_SetBandwidth(data->shaper, TEST_BANDWIDTH);
+    for (int i = 0; i < TEST_BURST + 3; i++) {
+        athenaInterestShaper_Admit(data->shaper, data->interest, 0);
+    }
+    assertTrue(athenaInterestShaper_Depth(data->shaper) == 3, "Expected 3 held");
+
+    // Turning shaping off lets everything held go at once
+    athenaInterestShaper_SetBandwidth(data->shaper, 0);
+    assertTrue(athenaInterestShaper_TimeUntilNext(data->shaper, 0) == 0, "Expected held Interests to go now");
+    for (int i = 0; i < 3; i++) {
+        CCNxMetaMessage *interest = athenaInterestShaper_Next(data->shaper, 0);
+        assertNotNull(interest, "Expected held Interest %d to be released", i);
+        ccnxMetaMessage_Release(&interest);
+    }
+    assertTrue(athenaInterestShaper_Depth(data->shaper) == 0, "Expected no Interests held");
+}
+
+LONGBOW_TEST_CASE(Global, athenaInterestShaper_ContentObjectReceived)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    for (int i = 0; i < 64; i++) {
+        athenaInterestShaper_ContentObjectReceived(data->shaper, 150);
+    }
+    size_t objectSize = athenaInterestShaper_GetObjectSize(data->shaper);
+    assertTrue((objectSize >= 150) && (objectSize < 160), "Expected the average to approach 150, got %zu", objectSize);
+
+    // Smaller responses leave room for ten times the Interests
+    athenaInterestShaper_SetBandwidth(data->shaper, TEST_BANDWIDTH);
+    int forwarded = 0;
+    while (athenaInterestShaper_Admit(data->shaper, data->interest, 0) == AthenaInterestShaper_Forward) {
+        forwarded++;
+    }
+    assertTrue(forwarded >= 47 && forwarded <= 50, "Expected about 50 Interests in the burst, got %d", forwarded);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(athena_InterestShaper);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
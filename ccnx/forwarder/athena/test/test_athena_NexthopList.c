@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../athena_NexthopList.c"
+
+#include <LongBow/unit-test.h>
+
+#include <stdio.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+LONGBOW_TEST_RUNNER(athena_NexthopList)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(athena_NexthopList)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_NexthopList)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaNexthopList_CreateRelease);
+    LONGBOW_RUN_TEST_CASE(Global, athenaNexthopList_Set);
+    LONGBOW_RUN_TEST_CASE(Global, athenaNexthopList_Set_Update);
+    LONGBOW_RUN_TEST_CASE(Global, athenaNexthopList_Clear);
+    LONGBOW_RUN_TEST_CASE(Global, athenaNexthopList_Copy);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    AthenaNexthopList *nexthops = athenaNexthopList_Create();
+    longBowTestCase_SetClipBoardData(testCase, nexthops);
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    AthenaNexthopList *nexthops = longBowTestCase_GetClipBoardData(testCase);
+    athenaNexthopList_Release(&nexthops);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, athenaNexthopList_CreateRelease)
+{
+    AthenaNexthopList *nexthops = athenaNexthopList_Create();
+    assertNotNull(nexthops, "Expected athenaNexthopList_Create to return a non-NULL value");
+    assertTrue(athenaNexthopList_Size(nexthops) == 0, "Expected a new list to be empty");
+
+    AthenaNexthopList *acquired = athenaNexthopList_Acquire(nexthops);
+    athenaNexthopList_Release(&acquired);
+    assertNull(acquired, "Expected athenaNexthopList_Release to NULL the pointer");
+
+    athenaNexthopList_Release(&nexthops);
+    assertNull(nexthops, "Expected athenaNexthopList_Release to NULL the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, athenaNexthopList_Set)
+{
+    AthenaNexthopList *nexthops = longBowTestCase_GetClipBoardData(testCase);
+
+    // More nexthops than the initial allocation, out of order
+    int linkIds[] = { 9, 2, 7, 4, 1, 8 };
+    uint32_t costs[] = { 5, 5, 1, 3, 5, 0 };
+    for (int i = 0; i < sizeof(linkIds) / sizeof(linkIds[0]); i++) {
+        athenaNexthopList_Set(nexthops, linkIds[i], costs[i], 0);
+    }
+
+    int expected[] = { 8, 7, 4, 1, 2, 9 };
+    assertTrue(athenaNexthopList_Size(nexthops) == 6, "Expected 6 nexthops, got %zu", athenaNexthopList_Size(nexthops));
+    for (int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        assertTrue(athenaNexthopList_GetLinkId(nexthops, i) == expected[i], "Expected link %d at index %d", expected[i], i);
+        assertTrue(athenaNexthopList_GetWeight(nexthops, i) == 1, "Expected a zero weight to be stored as 1");
+        assertTrue(parcBitVector_Get(athenaNexthopList_GetVector(nexthops), expected[i]) == 1, "Expected link %d in the vector", expected[i]);
+    }
+    assertTrue(parcBitVector_NumberOfBitsSet(athenaNexthopList_GetVector(nexthops)) == 6, "Expected the vector to match the list");
+}
+
+LONGBOW_TEST_CASE(Global, athenaNexthopList_Set_Update)
+{
+    AthenaNexthopList *nexthops = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaNexthopList_Set(nexthops, 1, 10, 1);
+    athenaNexthopList_Set(nexthops, 2, 20, 1);
+    athenaNexthopList_Set(nexthops, 1, 30, 4);
+
+    assertTrue(athenaNexthopList_Size(nexthops) == 2, "Expected an update not to add a nexthop");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 0) == 2, "Expected the updated nexthop to be re-ranked");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 1) == 1, "Expected the updated nexthop to be re-ranked");
+    assertTrue(athenaNexthopList_GetCost(nexthops, 1) == 30, "Expected the updated cost");
+    assertTrue(athenaNexthopList_GetWeight(nexthops, 1) == 4, "Expected the updated weight");
+}
+
+LONGBOW_TEST_CASE(Global, athenaNexthopList_Clear)
+{
+    AthenaNexthopList *nexthops = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaNexthopList_Set(nexthops, 1, 10, 1);
+    athenaNexthopList_Set(nexthops, 2, 20, 1);
+    athenaNexthopList_Set(nexthops, 3, 30, 1);
+
+    assertTrue(athenaNexthopList_Clear(nexthops, 2), "Expected to clear a nexthop in the list");
+    assertFalse(athenaNexthopList_Clear(nexthops, 2), "Expected clearing a missing nexthop to fail");
+    assertTrue(athenaNexthopList_Size(nexthops) == 2, "Expected 2 nexthops after clearing");
+    assertTrue(athenaNexthopList_GetLinkId(nexthops, 1) == 3, "Expected the remaining nexthops to keep their order");
+    assertTrue(parcBitVector_Get(athenaNexthopList_GetVector(nexthops), 2) == 0, "Expected the link cleared from the vector");
+}
+
+LONGBOW_TEST_CASE(Global, athenaNexthopList_Copy)
+{
+    AthenaNexthopList *nexthops = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaNexthopList_Set(nexthops, 1, 10, 1);
+    athenaNexthopList_Set(nexthops, 2, 20, 2);
+
+    AthenaNexthopList *copy = athenaNexthopList_Copy(nexthops);
+    athenaNexthopList_Clear(copy, 1);
+
+    assertTrue(athenaNexthopList_Size(nexthops) == 2, "Expected the original to be unchanged by the copy");
+    assertTrue(athenaNexthopList_Size(copy) == 1, "Expected the copy to be changed");
+    assertTrue(athenaNexthopList_GetWeight(copy, 0) == 2, "Expected the copy to keep the weight");
+    assertTrue(parcBitVector_Get(athenaNexthopList_GetVector(nexthops), 1) == 1, "Expected the original vector to be unchanged");
+
+    athenaNexthopList_Release(&copy);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(athena_NexthopList);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -64,6 +64,7 @@
 #include <LongBow/unit-test.h>
 
 #include <stdio.h>
+#include <inttypes.h>
 
 #include <parc/algol/parc_SafeMemory.h>
 #include <parc/algol/parc_StdlibMemory.h>
@@ -188,14 +189,26 @@ LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_AddInterest);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_RemoveInterest);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_ReturnInterest);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Match_NoRestriction);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Match_KeyIdRestriction);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Match_ContentHashRestriction);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Match_Nameless);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Match_MultipleRestrictions);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_MayMatchName);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_MeasurementCallback);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_InterestSent);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_CreateCapacity);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_PurgeExpired);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Overflow_Reject);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Overflow_EvictOldest);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Overflow_EvictSoonestExpiring);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_Overflow_EvictTwin);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_OverflowPolicyName);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_LinkQuota_Static);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_LinkQuota_Proportional);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_RemoveLink);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPIT_RemoveLink_Index);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_LinkCleanupFromMatch);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_GetNumberOfTableEntries);
     LONGBOW_RUN_TEST_CASE(Global, athenaPIT_GetNumberOfPendingInterests);
@@ -529,6 +542,67 @@ LONGBOW_TEST_CASE(Global, athenaPIT_RemoveInterest)
     assertTrue(interestCount == 0, "Expect there to be 0 interest");
 }
 
+LONGBOW_TEST_CASE(Global, athenaPIT_ReturnInterest)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(data->testPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expect AddInterest() result to be Forward");
+
+    // Forwarded upstream on links 23 and 42
+    parcBitVector_SetVector(expectedReturnVector, data->testVector2);
+    parcBitVector_SetVector(expectedReturnVector, data->testVector3);
+
+    CCNxInterestReturn *interestReturn =
+        ccnxInterestReturn_Create(data->testInterest1, CCNxInterestReturn_ReturnCode_NoRoute);
+
+    CCNxInterest *pendingInterest = NULL;
+    PARCBitVector *returnVector = NULL;
+    PARCBitVector *attemptedVector = NULL;
+
+    // A return from a link the interest was not forwarded to is ignored
+    PARCBitVector *downstreamVector =
+        athenaPIT_ReturnInterest(data->testPIT, interestReturn, data->testVector1,
+                                 &pendingInterest, &returnVector, &attemptedVector);
+    assertNull(downstreamVector, "Expect a return from an unexpected link to be ignored");
+
+    downstreamVector =
+        athenaPIT_ReturnInterest(data->testPIT, interestReturn, data->testVector2,
+                                 &pendingInterest, &returnVector, &attemptedVector);
+    assertNotNull(downstreamVector, "Expect a return from an egress link to be accepted");
+    assertTrue(parcBitVector_Equals(downstreamVector, data->testVector1), "Expect the downstream vector to be the ingress");
+    assertTrue(parcBitVector_Equals(returnVector, data->testVector3), "Expect the interest to be outstanding on link 23 only");
+    assertTrue(parcBitVector_NumberOfBitsSet(attemptedVector) == 2, "Expect both upstream links to have been attempted");
+    assertNotNull(pendingInterest, "Expect the pending interest to be returned");
+    ccnxInterest_Release(&pendingInterest);
+    parcBitVector_Release(&attemptedVector);
+    parcBitVector_Release(&downstreamVector);
+
+    // A second return from the same link is no longer expected
+    downstreamVector =
+        athenaPIT_ReturnInterest(data->testPIT, interestReturn, data->testVector2,
+                                 &pendingInterest, &returnVector, &attemptedVector);
+    assertNull(downstreamVector, "Expect a duplicate return to be ignored");
+
+    downstreamVector =
+        athenaPIT_ReturnInterest(data->testPIT, interestReturn, data->testVector3,
+                                 &pendingInterest, &returnVector, &attemptedVector);
+    assertNotNull(downstreamVector, "Expect a return from an egress link to be accepted");
+    assertTrue(parcBitVector_NumberOfBitsSet(returnVector) == 0, "Expect no outstanding links");
+    assertTrue(parcBitVector_Contains(attemptedVector, data->testVector2), "Expect link 42 to remain attempted");
+
+    bool result = athenaPIT_RemoveInterest(data->testPIT, pendingInterest, downstreamVector);
+    assertTrue(result, "Expect RemoveInterest() of the returned interest to succeed");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(data->testPIT) == 0, "Expect the PIT to be empty");
+
+    ccnxInterest_Release(&pendingInterest);
+    parcBitVector_Release(&attemptedVector);
+    parcBitVector_Release(&downstreamVector);
+    ccnxInterestReturn_Release(&interestReturn);
+}
+
 LONGBOW_TEST_CASE(Global, athenaPIT_Match_NoRestriction)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -721,13 +795,144 @@ LONGBOW_TEST_CASE(Global, athenaPIT_Match_MultipleRestrictions)
     parcBitVector_Release(&backLinkVector);
 }
 
+static int _measurementCount;
+static int _measurementLinkId;
+static bool _measurementSatisfied;
+static uint64_t _measurementResponseTime;
+
+static void
+_testMeasurementCallback(AthenaPIT_MeasurementCallbackContext context, const CCNxInterest *interest,
+                         int linkId, bool satisfied, uint64_t responseTime)
+{
+    _measurementCount++;
+    _measurementLinkId = linkId;
+    _measurementSatisfied = satisfied;
+    _measurementResponseTime = responseTime;
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_MayMatchName)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaPacketDescriptor content1;
+    AthenaPacketDescriptor content2;
+    assertTrue(athenaPacketDescriptor_Parse(&content1, ccnxWireFormatMessage_GetWireFormatBuffer(data->testContent1)),
+               "Expected to parse content 1");
+    assertTrue(athenaPacketDescriptor_Parse(&content2, ccnxWireFormatMessage_GetWireFormatBuffer(data->testContent2)),
+               "Expected to parse content 2");
+
+    assertFalse(athenaPIT_MayMatchName(data->testPIT, content1.name, content1.nameLength),
+                "Expected no match in an empty PIT");
+
+    // A received Interest is counted by its wire format name
+    CCNxInterest *receivedInterest = _createReceivedContent(data->testInterest1);
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(data->testPIT, receivedInterest, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expect AddInterest() result to be Forward");
+    assertTrue(athenaPIT_MayMatchName(data->testPIT, content1.name, content1.nameLength),
+               "Expected content 1 to match the received Interest");
+    assertFalse(athenaPIT_MayMatchName(data->testPIT, content2.name, content2.nameLength),
+                "Expected content 2 not to match");
+
+    // An Interest that was never encoded makes the filter inconclusive until it's removed
+    addResult = athenaPIT_AddInterest(data->testPIT, data->testInterest2, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expect AddInterest() result to be Forward");
+    assertTrue(athenaPIT_MayMatchName(data->testPIT, content2.name, content2.nameLength),
+               "Expected an unencoded Interest to make the filter inconclusive");
+    assertTrue(athenaPIT_RemoveInterest(data->testPIT, data->testInterest2, data->testVector1),
+               "Expected to remove Interest 2");
+    assertFalse(athenaPIT_MayMatchName(data->testPIT, content2.name, content2.nameLength),
+                "Expected content 2 not to match once Interest 2 is removed");
+
+    // Satisfying the entry uncounts it
+    PARCBitVector *backLinkVector =
+        athenaPIT_Match(data->testPIT, ccnxContentObject_GetName(data->testContent1), NULL, NULL, data->testVector2);
+    assertTrue(parcBitVector_Equals(backLinkVector, data->testVector1), "Expect to find match to forward to");
+    parcBitVector_Release(&backLinkVector);
+    assertFalse(athenaPIT_MayMatchName(data->testPIT, content1.name, content1.nameLength),
+                "Expected no match once the entry is satisfied");
+
+    ccnxInterest_Release(&receivedInterest);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_MeasurementCallback)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    _measurementCount = 0;
+    athenaPIT_SetMeasurementCallback(data->testPIT, _testMeasurementCallback, NULL);
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(data->testPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expect AddInterest() result to be Forward");
+
+    // Forwarded upstream on links 23 and 42
+    parcBitVector_SetVector(expectedReturnVector, data->testVector2);
+    parcBitVector_SetVector(expectedReturnVector, data->testVector3);
+
+    // Satisfied from link 42
+    CCNxContentObject *object1 = data->testContent1;
+    CCNxName *name1 = ccnxContentObject_GetName(object1);
+    PARCBuffer *keyId1 = ccnxContentObject_GetKeyId(object1);
+    PARCBuffer *contentId1 = _createMessageHash(object1);
+    PARCBitVector *backLinkVector = athenaPIT_Match(data->testPIT, name1, keyId1, contentId1, data->testVector2);
+    assertTrue(parcBitVector_Equals(backLinkVector, data->testVector1), "Expect to find match to forward to");
+    parcBitVector_Release(&backLinkVector);
+    parcBuffer_Release(&contentId1);
+
+    assertTrue(_measurementCount == 1, "Expect a single measurement report, got %d", _measurementCount);
+    assertTrue(_measurementLinkId == 42, "Expect the measurement for link 42, got %d", _measurementLinkId);
+    assertTrue(_measurementSatisfied, "Expect the measurement to report a satisfied interest");
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_InterestSent)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    athenaPIT_SetClock(data->testPIT, parcClock_Test());
+    _measurementCount = 0;
+    athenaPIT_SetMeasurementCallback(data->testPIT, _testMeasurementCallback, NULL);
+
+    assertFalse(athenaPIT_InterestSent(data->testPIT, data->testInterest1, data->testVector2),
+                "Expect an interest that isn't pending to be refused");
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(data->testPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expect AddInterest() result to be Forward");
+    parcBitVector_SetVector(expectedReturnVector, data->testVector3);
+
+    // Returned by link 23 after 30ms and retried on link 42
+    _TestClockTimeval.tv_usec += 30 * 1000;
+    parcBitVector_ClearVector(expectedReturnVector, data->testVector3);
+    parcBitVector_SetVector(expectedReturnVector, data->testVector2);
+    assertTrue(athenaPIT_InterestSent(data->testPIT, data->testInterest1, data->testVector2),
+               "Expect the pending interest to be found");
+
+    // Satisfied from link 42 10ms after the retry
+    _TestClockTimeval.tv_usec += 10 * 1000;
+    CCNxContentObject *object1 = data->testContent1;
+    PARCBuffer *contentId1 = _createMessageHash(object1);
+    PARCBitVector *backLinkVector = athenaPIT_Match(data->testPIT, ccnxContentObject_GetName(object1),
+                                                    ccnxContentObject_GetKeyId(object1), contentId1, data->testVector2);
+    parcBitVector_Release(&backLinkVector);
+    parcBuffer_Release(&contentId1);
+
+    assertTrue(_measurementCount == 1, "Expect a single measurement report, got %d", _measurementCount);
+    assertTrue(_measurementLinkId == 42, "Expect the measurement for link 42, got %d", _measurementLinkId);
+    assertTrue(_measurementResponseTime == 10, "Expect the response time from the retry, got %" PRIu64,
+               _measurementResponseTime);
+}
+
 LONGBOW_TEST_CASE(Global, athenaPIT_CreateCapacity)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
 
     AthenaPIT *limitedPIT = athenaPIT_CreateCapacity(1);
 
-    limitedPIT->clock = parcClock_Test();
+    athenaPIT_SetClock(limitedPIT, parcClock_Test());
 
     PARCBitVector *expectedReturnVector;
     AthenaPITResolution addResult =
@@ -744,7 +949,7 @@ LONGBOW_TEST_CASE(Global, athenaPIT_CreateCapacity)
 
     addResult =
         athenaPIT_AddInterest(limitedPIT, data->testInterest1WithKeyId, data->testVector2, &expectedReturnVector);
-    assertTrue(addResult == AthenaPITResolution_Error, "Expected error result");
+    assertTrue(addResult == AthenaPITResolution_Congested, "Expected congested result");
 
     athenaPIT_Release(&limitedPIT);
 }
@@ -755,7 +960,7 @@ LONGBOW_TEST_CASE(Global, athenaPIT_PurgeExpired)
 
     AthenaPIT *limitedPIT = athenaPIT_CreateCapacity(1);
 
-    limitedPIT->clock = parcClock_Test();
+    athenaPIT_SetClock(limitedPIT, parcClock_Test());
 
     PARCBitVector *expectedReturnVector;
     AthenaPITResolution addResult =
@@ -783,7 +988,7 @@ LONGBOW_TEST_CASE(Global, athenaPIT_PurgeExpired)
 
     addResult =
         athenaPIT_AddInterest(limitedPIT, data->testInterest2, data->testVector2, &expectedReturnVector);
-    assertTrue(addResult == AthenaPITResolution_Error, "Expected error result");
+    assertTrue(addResult == AthenaPITResolution_Congested, "Expected congested result");
 
     // Expire the pit entry
     _TestClockTimeval.tv_usec += 1000 * 1000;
@@ -795,6 +1000,281 @@ LONGBOW_TEST_CASE(Global, athenaPIT_PurgeExpired)
     athenaPIT_Release(&limitedPIT);
 }
 
+// Fill a PIT of capacity 2 with testInterest1, added first, and testInterest2, added 50ms later.  The
+// lifetime of testInterest1 is then extended so testInterest2 expires first.
+static AthenaPIT *
+_createFullPIT(TestData *data, AthenaPITOverflowPolicy policy)
+{
+    AthenaPIT *limitedPIT = athenaPIT_CreateCapacity(2);
+    athenaPIT_SetClock(limitedPIT, parcClock_Test());
+    athenaPIT_SetOverflowPolicy(limitedPIT, policy);
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+
+    _TestClockTimeval.tv_usec += 50 * 1000;
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest2, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+
+    _TestClockTimeval.tv_usec += 10 * 1000;
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(limitedPIT) == 2, "Expect a full PIT");
+
+    return limitedPIT;
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_Overflow_Reject)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaPIT *limitedPIT = _createFullPIT(data, AthenaPITOverflowPolicy_Reject);
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1WithKeyId, data->testVector2, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Congested, "Expected congested result");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(limitedPIT) == 2, "Expect the PIT to be unchanged");
+    assertTrue(athenaPIT_GetNumberOfPendingInterests(limitedPIT) == 2, "Expect 2 pending interests");
+
+    // Aggregation doesn't need a new entry
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1, data->testVector2, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Aggregated, "Expected aggregated result");
+
+    assertTrue(athenaPIT_GetOverflowCount(limitedPIT, AthenaPITOverflowPolicy_Reject) == 1, "Expect 1 rejection");
+    assertTrue(athenaPIT_GetOverflowCount(limitedPIT, AthenaPITOverflowPolicy_EvictOldest) == 0, "Expect no evictions");
+
+    athenaPIT_Release(&limitedPIT);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_Overflow_EvictOldest)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaPIT *limitedPIT = _createFullPIT(data, AthenaPITOverflowPolicy_EvictOldest);
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1WithKeyId, data->testVector2, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(limitedPIT) == 2, "Expect a full PIT");
+    assertTrue(athenaPIT_GetNumberOfPendingInterests(limitedPIT) == 2, "Expect 2 pending interests");
+    assertTrue(athenaPIT_GetOverflowCount(limitedPIT, AthenaPITOverflowPolicy_EvictOldest) == 1, "Expect 1 eviction");
+
+    assertFalse(athenaPIT_RemoveInterest(limitedPIT, data->testInterest1, data->testVector1),
+                "Expect the oldest entry to have been evicted");
+    assertTrue(athenaPIT_RemoveInterest(limitedPIT, data->testInterest2, data->testVector1),
+               "Expect the newer entry to be pending");
+
+    // Expired entries are purged before anything is evicted
+    _TestClockTimeval.tv_usec += 1000 * 1000;
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest2, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(limitedPIT) == 2, "Expect 2 PIT entries");
+    assertTrue(athenaPIT_GetOverflowCount(limitedPIT, AthenaPITOverflowPolicy_EvictOldest) == 1, "Expect 1 eviction");
+    assertTrue(athenaPIT_RemoveInterest(limitedPIT, data->testInterest2, data->testVector1),
+               "Expect the unexpired entry to be pending");
+
+    athenaPIT_Release(&limitedPIT);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_Overflow_EvictSoonestExpiring)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaPIT *limitedPIT = _createFullPIT(data, AthenaPITOverflowPolicy_EvictSoonestExpiring);
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1WithKeyId, data->testVector2, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(limitedPIT) == 2, "Expect a full PIT");
+    assertTrue(athenaPIT_GetOverflowCount(limitedPIT, AthenaPITOverflowPolicy_EvictSoonestExpiring) == 1,
+               "Expect 1 eviction");
+
+    assertFalse(athenaPIT_RemoveInterest(limitedPIT, data->testInterest2, data->testVector1),
+                "Expect the soonest expiring entry to have been evicted");
+    assertTrue(athenaPIT_RemoveInterest(limitedPIT, data->testInterest1, data->testVector1),
+               "Expect the extended entry to be pending");
+
+    // Entries dropped with a removed link aren't eviction candidates
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest2, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    athenaPIT_RemoveLink(limitedPIT, data->testVector2);
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1WithKeyId, data->testVector2, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_RemoveInterest(limitedPIT, data->testInterest1, data->testVector1),
+               "Expect the entry added last to be pending");
+    assertFalse(athenaPIT_RemoveInterest(limitedPIT, data->testInterest2, data->testVector1),
+                "Expect the soonest expiring entry to have been evicted");
+
+    athenaPIT_Release(&limitedPIT);
+}
+
+typedef struct test_eviction {
+    int count;
+    PARCBitVector *ingress;
+} _TestEviction;
+
+static void
+_testEvictionCallback(AthenaPIT_EvictionCallbackContext context, CCNxInterest *interest, PARCBitVector *ingressVector)
+{
+    _TestEviction *eviction = (_TestEviction *) context;
+    eviction->count++;
+    parcBitVector_SetVector(eviction->ingress, ingressVector);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_Overflow_EvictTwin)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaPIT *limitedPIT = athenaPIT_CreateCapacity(2);
+    athenaPIT_SetOverflowPolicy(limitedPIT, AthenaPITOverflowPolicy_EvictOldest);
+    _TestEviction eviction = { .count = 0, .ingress = parcBitVector_Create() };
+    athenaPIT_SetEvictionCallback(limitedPIT, _testEvictionCallback, &eviction);
+
+    // An interest with a ContentObjectHashRestriction fills the PIT with its named and nameless entries
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1WithContentId, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(limitedPIT) == 2, "Expect a full PIT");
+
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest2, data->testVector2, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(limitedPIT) == 1, "Expect the nameless entry to be evicted too");
+    assertTrue(athenaPIT_GetNumberOfPendingInterests(limitedPIT) == 1, "Expect 1 pending interest");
+    assertTrue(athenaPIT_GetOverflowCount(limitedPIT, AthenaPITOverflowPolicy_EvictOldest) == 1, "Expect 1 eviction");
+
+    assertTrue(eviction.count == 1, "Expect the evicted interest to be reported once, was %d", eviction.count);
+    assertTrue(parcBitVector_Equals(eviction.ingress, data->testVector1), "Expect the evicted interest's ingress link");
+
+    assertFalse(athenaPIT_RemoveInterest(limitedPIT, data->testInterest1WithContentId, data->testVector1),
+                "Expect the evicted interest to be gone");
+
+    parcBitVector_Release(&eviction.ingress);
+    athenaPIT_Release(&limitedPIT);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_OverflowPolicyName)
+{
+    for (int i = 0; i < AthenaPITOverflowPolicy_Count; i++) {
+        AthenaPITOverflowPolicy policy;
+        assertTrue(athenaPIT_OverflowPolicyFromName(athenaPIT_OverflowPolicyName(i), &policy),
+                   "Expect policy %d to be found by name", i);
+        assertTrue(policy == i, "Expect policy %d, got %d", i, policy);
+    }
+
+    AthenaPITOverflowPolicy policy;
+    assertTrue(athenaPIT_OverflowPolicyFromName("EVICTOLDEST", &policy), "Expect names to be matched ignoring case");
+    assertTrue(policy == AthenaPITOverflowPolicy_EvictOldest, "Expect EvictOldest");
+    assertFalse(athenaPIT_OverflowPolicyFromName("drop", &policy), "Expect an unknown name to be refused");
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_LinkQuota_Static)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    assertTrue(athenaPIT_GetLinkQuota(data->testPIT, 0) == SIZE_MAX, "Expect no quota by default");
+    athenaPIT_SetLinkQuota(data->testPIT, AthenaPITLinkQuotaMode_Static, 1);
+    assertTrue(athenaPIT_CheckLinkQuota(data->testPIT, data->testVector1), "Expect an idle link to be within its quota");
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(data->testPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetLinkPendingCount(data->testPIT, 0) == 1, "Expect 1 entry pending on link 0");
+
+    assertFalse(athenaPIT_CheckLinkQuota(data->testPIT, data->testVector1), "Expect link 0 to be at its quota");
+    assertFalse(athenaPIT_CheckLinkQuota(data->testPIT, data->testVector12), "Expect any link at its quota to refuse");
+    assertTrue(athenaPIT_CheckLinkQuota(data->testPIT, data->testVector2), "Expect link 42 to be within its quota");
+    assertTrue(athenaPIT_GetLinkQuotaRejectCount(data->testPIT) == 2, "Expect 2 refused interests");
+
+    // Only interests needing a new entry are refused
+    addResult = athenaPIT_AddInterest(data->testPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected a retransmission to be accepted");
+    addResult = athenaPIT_AddInterest(data->testPIT, data->testInterest2, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Congested, "Expected a new interest over the quota to be refused");
+    assertTrue(athenaPIT_GetLinkQuotaRejectCount(data->testPIT) == 3, "Expect 3 refused interests");
+
+    // Interests under the exempt prefix are accepted over the quota
+    CCNxName *prefix = ccnxName_CreateFromCString("lci:/test/content2");
+    athenaPIT_SetLinkQuotaExemptPrefix(data->testPIT, prefix);
+    ccnxName_Release(&prefix);
+    addResult = athenaPIT_AddInterest(data->testPIT, data->testInterest2, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected an exempt interest to be accepted");
+    athenaPIT_SetLinkQuotaExemptPrefix(data->testPIT, NULL);
+    athenaPIT_RemoveInterest(data->testPIT, data->testInterest2, data->testVector1);
+
+    athenaPIT_RemoveInterest(data->testPIT, data->testInterest1, data->testVector1);
+    assertTrue(athenaPIT_GetLinkPendingCount(data->testPIT, 0) == 0, "Expect nothing pending on link 0");
+    assertTrue(athenaPIT_CheckLinkQuota(data->testPIT, data->testVector1), "Expect link 0 to be within its quota");
+
+    // An interest with a content object hash restriction counts once, not for its nameless entry too
+    addResult =
+        athenaPIT_AddInterest(data->testPIT, data->testInterest1WithContentId, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetLinkPendingCount(data->testPIT, 0) == 1, "Expect 1 entry pending on link 0");
+    athenaPIT_RemoveLink(data->testPIT, data->testVector1);
+    assertTrue(athenaPIT_GetLinkPendingCount(data->testPIT, 0) == 0, "Expect nothing pending on link 0");
+
+    athenaPIT_SetLinkQuota(data->testPIT, AthenaPITLinkQuotaMode_None, 0);
+    assertTrue(athenaPIT_GetLinkQuota(data->testPIT, 0) == SIZE_MAX, "Expect the quota to be removed");
+}
+
+LONGBOW_TEST_CASE(Global, athenaPIT_LinkQuota_Proportional)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    AthenaPIT *limitedPIT = athenaPIT_CreateCapacity(4);
+    athenaPIT_SetLinkQuota(limitedPIT, AthenaPITLinkQuotaMode_Proportional, 100);
+    assertTrue(athenaPIT_GetLinkQuota(limitedPIT, 0) == 4, "Expect the only link to get the whole PIT");
+
+    PARCBitVector *expectedReturnVector;
+    AthenaPITResolution addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetLinkQuota(limitedPIT, 0) == 4, "Expect the only active link to get the whole PIT");
+    assertTrue(athenaPIT_GetLinkQuota(limitedPIT, 42) == 2, "Expect a new link to get half of the PIT");
+
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest2, data->testVector2, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertTrue(athenaPIT_GetLinkQuota(limitedPIT, 0) == 2, "Expect 2 active links to share the PIT");
+
+    addResult =
+        athenaPIT_AddInterest(limitedPIT, data->testInterest1WithKeyId, data->testVector1, &expectedReturnVector);
+    assertTrue(addResult == AthenaPITResolution_Forward, "Expected forward result");
+    assertFalse(athenaPIT_CheckLinkQuota(limitedPIT, data->testVector1), "Expect link 0 to be at its share");
+    assertTrue(athenaPIT_CheckLinkQuota(limitedPIT, data->testVector3), "Expect link 23 to be within its share");
+    assertTrue(athenaPIT_GetLinkQuota(limitedPIT, 23) == 1, "Expect a third link to get a third of the PIT");
+
+    // Links are no longer active once nothing is pending on them
+    athenaPIT_RemoveLink(limitedPIT, data->testVector2);
+    assertTrue(athenaPIT_GetLinkQuota(limitedPIT, 0) == 4, "Expect the remaining link to get the whole PIT");
+    assertTrue(athenaPIT_CheckLinkQuota(limitedPIT, data->testVector1), "Expect link 0 to be within its share");
+
+    athenaPIT_SetLinkQuota(limitedPIT, AthenaPITLinkQuotaMode_Proportional, 25);
+    assertFalse(athenaPIT_CheckLinkQuota(limitedPIT, data->testVector1), "Expect link 0 to exceed a quarter of the PIT");
+
+    athenaPIT_Release(&limitedPIT);
+}
+
 LONGBOW_TEST_CASE(Global, athenaPIT_RemoveLink)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -869,6 +1349,35 @@ LONGBOW_TEST_CASE(Global, athenaPIT_RemoveLink)
     parcBitVector_Release(&backLinkVector);
 }
 
+LONGBOW_TEST_CASE(Global, athenaPIT_RemoveLink_Index)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // The content id restricted interest also adds a nameless entry, both are pending on link 0
+    PARCBitVector *expectedReturnVector;
+    athenaPIT_AddInterest(data->testPIT, data->testInterest1WithContentId, data->testVector1, &expectedReturnVector);
+    athenaPIT_AddInterest(data->testPIT, data->testInterest1WithKeyId, data->testVector2, &expectedReturnVector);
+    athenaPIT_AddInterest(data->testPIT, data->testInterest1, data->testVector1, &expectedReturnVector);
+    athenaPIT_AddInterest(data->testPIT, data->testInterest1, data->testVector2, &expectedReturnVector);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(data->testPIT) == 4, "Expected 4 table entries");
+
+    // Removing the interest from one of its links only unindexes that link
+    athenaPIT_RemoveInterest(data->testPIT, data->testInterest1, data->testVector2);
+    assertTrue(athenaPIT_GetNumberOfTableEntries(data->testPIT) == 4, "Expected 4 table entries");
+
+    assertTrue(athenaPIT_RemoveLink(data->testPIT, data->testVector1), "Expected True result from RemoveLink()");
+    assertNull(data->testPIT->linkIndex[0], "Expected no entries left pending on the removed link");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(data->testPIT) == 1,
+               "Expected only the entry pending on another link, got %zu",
+               athenaPIT_GetNumberOfTableEntries(data->testPIT));
+
+    assertTrue(athenaPIT_RemoveLink(data->testPIT, data->testVector2), "Expected True result from RemoveLink()");
+    assertNull(data->testPIT->linkIndex[42], "Expected no entries left pending on the removed link");
+    assertTrue(athenaPIT_GetNumberOfTableEntries(data->testPIT) == 0, "Expected an empty table");
+    assertTrue(parcTreeMap_Size(data->testPIT->timeoutTable) == 0,
+               "Expected the removed entries to be out of the timeout table");
+}
+
 LONGBOW_TEST_CASE(Global, athenaPIT_GetNumberOfTableEntries)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
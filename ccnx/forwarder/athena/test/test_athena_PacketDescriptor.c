@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../athena_PacketDescriptor.c"
+
+#include <LongBow/unit-test.h>
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+
+LONGBOW_TEST_RUNNER(athena_PacketDescriptor)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(athena_PacketDescriptor)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_PacketDescriptor)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaPacketDescriptor_Parse_Interest);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPacketDescriptor_Parse_ContentObject);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPacketDescriptor_Parse_Truncated);
+    LONGBOW_RUN_TEST_CASE(Global, athenaPacketDescriptor_ParseArray_Malformed);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// Encode a message into one contiguous buffer, as a link would receive it
+static PARCBuffer *
+_encodeMessage(CCNxMetaMessage *message)
+{
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncode(message, signer);
+    parcSigner_Release(&signer);
+
+    size_t iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(iovec);
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    PARCBuffer *buffer = parcBuffer_Allocate(ccnxCodecNetworkBufferIoVec_Length(iovec));
+    for (int i = 0; i < iovcnt; i++) {
+        parcBuffer_PutArray(buffer, array[i].iov_len, array[i].iov_base);
+    }
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+
+    return parcBuffer_Flip(buffer);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPacketDescriptor_Parse_Interest)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    PARCBuffer *keyId = parcBuffer_WrapCString("keyhash");
+    CCNxInterest *interest = ccnxInterest_Create(name, 1234, keyId, NULL);
+    ccnxInterest_SetHopLimit(interest, 7);
+    PARCBuffer *wireFormatBuffer = _encodeMessage(interest);
+
+    // The position is ignored, the packet is read from the start of the buffer
+    parcBuffer_SetPosition(wireFormatBuffer, parcBuffer_Limit(wireFormatBuffer));
+
+    AthenaPacketDescriptor descriptor;
+    assertTrue(athenaPacketDescriptor_Parse(&descriptor, wireFormatBuffer), "Expected an encoded Interest to parse");
+    assertTrue(parcBuffer_Position(wireFormatBuffer) == parcBuffer_Limit(wireFormatBuffer), "Expected the position to be unchanged");
+
+    assertTrue(descriptor.packetType == AthenaPacketDescriptor_PacketType_Interest,
+               "Expected an Interest packet type, got %d", descriptor.packetType);
+    assertTrue(descriptor.packetLength == parcBuffer_Limit(wireFormatBuffer),
+               "Expected the packet length to be the encoded length");
+    assertTrue(descriptor.hopLimit == 7, "Expected hop limit 7, got %d", descriptor.hopLimit);
+    assertTrue(parcBuffer_GetAtIndex(wireFormatBuffer, descriptor.hopLimitOffset) == 7,
+               "Expected the hop limit offset to locate the hop limit");
+    assertTrue(descriptor.hasLifetime && (descriptor.lifetime == 1234),
+               "Expected lifetime 1234, got %" PRIu64, descriptor.lifetime);
+    assertTrue(athenaPacketDescriptor_HasName(&descriptor), "Expected the Interest to have a name");
+    assertNotNull(descriptor.keyIdRestriction, "Expected a KeyId restriction");
+    assertNull(descriptor.objectHashRestriction, "Expected no content object hash restriction");
+
+    parcBuffer_Release(&wireFormatBuffer);
+    ccnxInterest_Release(&interest);
+    parcBuffer_Release(&keyId);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPacketDescriptor_Parse_ContentObject)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    PARCBuffer *payload = parcBuffer_WrapCString("payload");
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+
+    PARCBuffer *interestBuffer = _encodeMessage(interest);
+    PARCBuffer *contentBuffer = _encodeMessage(contentObject);
+
+    AthenaPacketDescriptor interestDescriptor;
+    AthenaPacketDescriptor contentDescriptor;
+    assertTrue(athenaPacketDescriptor_Parse(&interestDescriptor, interestBuffer), "Expected an encoded Interest to parse");
+    assertTrue(athenaPacketDescriptor_Parse(&contentDescriptor, contentBuffer), "Expected an encoded Content Object to parse");
+
+    assertTrue(contentDescriptor.packetType == AthenaPacketDescriptor_PacketType_ContentObject,
+               "Expected a Content Object packet type, got %d", contentDescriptor.packetType);
+    assertNull(contentDescriptor.keyIdRestriction, "Expected no restrictions on a Content Object");
+
+    // Equal names have equal wire formats, which is what the PIT's name filter relies on
+    assertTrue(contentDescriptor.nameLength == interestDescriptor.nameLength, "Expected equal name lengths");
+    assertTrue(memcmp(contentDescriptor.name, interestDescriptor.name, contentDescriptor.nameLength) == 0,
+               "Expected equal wire format names");
+
+    parcBuffer_Release(&contentBuffer);
+    parcBuffer_Release(&interestBuffer);
+    ccnxContentObject_Release(&contentObject);
+    parcBuffer_Release(&payload);
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPacketDescriptor_Parse_Truncated)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    PARCBuffer *wireFormatBuffer = _encodeMessage(interest);
+
+    AthenaPacketDescriptor descriptor;
+    size_t length = parcBuffer_Limit(wireFormatBuffer);
+    const uint8_t *packet = parcBuffer_Overlay(wireFormatBuffer, 0);
+    for (size_t i = 0; i < length; i++) {
+        assertFalse(athenaPacketDescriptor_ParseArray(&descriptor, packet, i), "Expected a packet truncated to %zu bytes to fail", i);
+    }
+    assertTrue(athenaPacketDescriptor_ParseArray(&descriptor, packet, length), "Expected the whole packet to parse");
+
+    parcBuffer_Release(&wireFormatBuffer);
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, athenaPacketDescriptor_ParseArray_Malformed)
+{
+    // Interest with a 2 byte lifetime and a name of one 2 byte segment
+    uint8_t packet[] = {
+        0x01, 0x00, 0x00, 0x1e, 0x05, 0x00, 0x00, 0x0e,
+        0x00, 0x01, 0x00, 0x02, 0x0f, 0xa0,
+        0x00, 0x01, 0x00, 0x0a,
+        0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02, 'a', 'b'
+    };
+    packet[3] = sizeof(packet);
+
+    AthenaPacketDescriptor descriptor;
+    assertTrue(athenaPacketDescriptor_ParseArray(&descriptor, packet, sizeof(packet)), "Expected the packet to parse");
+    assertTrue(descriptor.lifetime == 4000, "Expected lifetime 4000, got %" PRIu64, descriptor.lifetime);
+    assertTrue(descriptor.name == &packet[22], "Expected the name to point into the packet");
+    assertTrue(descriptor.nameLength == 6, "Expected a 6 byte name, got %zu", descriptor.nameLength);
+
+    assertTrue(athenaPacketDescriptor_SetHopLimitArray(packet, sizeof(packet), 3), "Expected the hop limit to be set");
+    assertTrue(athenaPacketDescriptor_ParseArray(&descriptor, packet, sizeof(packet)) && (descriptor.hopLimit == 3),
+               "Expected the hop limit to be rewritten in place");
+    assertFalse(athenaPacketDescriptor_SetHopLimitArray(packet, 4, 2), "Expected a short fixed header to be left alone");
+
+    packet[0] = 0x00;
+    assertFalse(athenaPacketDescriptor_ParseArray(&descriptor, packet, sizeof(packet)), "Expected an unknown version to fail");
+    packet[0] = 0x01;
+
+    packet[7] = 0x04;
+    assertFalse(athenaPacketDescriptor_ParseArray(&descriptor, packet, sizeof(packet)), "Expected a short header length to fail");
+    packet[7] = 0x0e;
+
+    packet[21] = 0x20;
+    assertFalse(athenaPacketDescriptor_ParseArray(&descriptor, packet, sizeof(packet)), "Expected an overrunning name to fail");
+    packet[21] = 0x06;
+
+    packet[17] = 0x20;
+    assertFalse(athenaPacketDescriptor_ParseArray(&descriptor, packet, sizeof(packet)), "Expected an overrunning message to fail");
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(athena_PacketDescriptor);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -94,6 +94,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLink_GetSetPrivateData);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLink_AddRemoveCallback);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_SetGetEventFd);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_SendPollable);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_Routable);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_IsNotLocal);
 }
@@ -268,6 +269,19 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_SetGetEventFd)
     athenaTransportLink_Release(&athenaTransportLink);
 }
 
+LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_SendPollable)
+{
+    AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create("test", _send_method, _receive_method, _close_method);
+    assertNotNull(athenaTransportLink, "athenaTransportLink_Create failed");
+    assertFalse(athenaTransportLink_IsSendPollable(athenaTransportLink), "Expected a new link not to be send pollable");
+    athenaTransportLink_SetEventFd(athenaTransportLink, 3);
+    athenaTransportLink_SetSendPollable(athenaTransportLink, true);
+    assertTrue(athenaTransportLink_IsSendPollable(athenaTransportLink), "athenaTransportLink_SetSendPollable failed");
+    athenaTransportLink_SetEventFd(athenaTransportLink, 4);
+    assertFalse(athenaTransportLink_IsSendPollable(athenaTransportLink), "Expected a new event fd to clear the flag");
+    athenaTransportLink_Release(&athenaTransportLink);
+}
+
 LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_Routable)
 {
     AthenaTransportLink *athenaTransportLink = athenaTransportLink_Create("test", _send_method, _receive_method, _close_method);
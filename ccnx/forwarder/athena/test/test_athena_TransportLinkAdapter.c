@@ -92,8 +92,13 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_SendReceive);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_LoadLookupRemoveModule);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_NameToIdToName);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_LinkIdReuse);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_IsNotLocal);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_ListLinks);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_EgressQueue);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_EgressWatch);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_SetEgressClass);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_ShapeInterest);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkAdapter_SetLogLevel);
 }
 
@@ -229,6 +234,73 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_NameToIdToName)
     athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
 }
 
+LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_LinkIdReuse)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    _LoadModule(athenaTransportLinkAdapter, "TCP");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/Listener/name=TCP_0");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_2");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_0");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open allowed a link with the name of a listener");
+    parcURI_Release(&connectionURI);
+
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_1");
+    assertTrue(linkId != -1, "athenaTransportLinkAdapter_LinkNameToId failed to find TCP_1");
+
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "TCP_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "TCP_1");
+    assertTrue(closeResult == -1, "athenaTransportLinkAdapter_CloseByName closed a link twice");
+    assertTrue(athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_1") == -1,
+               "athenaTransportLinkAdapter_LinkNameToId found a closed link");
+
+    // The vacated id is handed to the next routable link
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_3");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    int reusedLinkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_3");
+    assertTrue(reusedLinkId == linkId, "Expected TCP_3 to reuse link id %d, got %d", linkId, reusedLinkId);
+
+    // The lowest vacated id is reused first, whatever order the links were closed in
+    int higherLinkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_2");
+    assertTrue(higherLinkId > linkId, "Expected TCP_2 to have a higher link id than %d, got %d", linkId, higherLinkId);
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "TCP_3");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "TCP_2");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_4");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    reusedLinkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_4");
+    assertTrue(reusedLinkId == linkId, "Expected TCP_4 to reuse the lowest link id %d, got %d", linkId, reusedLinkId);
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
 LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_AddRemoveLink)
 {
     PARCURI *connectionURI;
@@ -338,6 +410,10 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_SendReceive)
 
     resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, sendMessage, linkVector);
     assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    assertTrue(athenaTransportLinkAdapter->stats.messageSend_WireFormatPrepared == 1,
+               "Expected one wire format buffer for all links, created %zu", athenaTransportLinkAdapter->stats.messageSend_WireFormatPrepared);
+    assertTrue(athenaTransportLinkAdapter->stats.messageSend_WireFormatShared == 3,
+               "Expected three sends of the shared buffer, sent %zu", athenaTransportLinkAdapter->stats.messageSend_WireFormatShared);
 
     usleep(1000);
 
@@ -380,6 +456,8 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_SendReceive)
 
     resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, sendMessage, linkVector);
     assertTrue(parcBitVector_NumberOfBitsSet(resultVector) == 2, "athenaTransportLinkAdapter_Send should have partially failed");
+    assertTrue(athenaTransportLinkAdapter->stats.messageSend_WireFormatPrepared == 1,
+               "The message's wire format buffer should have been reused, created %zu", athenaTransportLinkAdapter->stats.messageSend_WireFormatPrepared);
     parcBitVector_Release(&linkVector);
     parcBitVector_Release(&resultVector);
 
@@ -491,6 +569,268 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_ListLinks)
     athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
 }
 
+LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_EgressQueue)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    _LoadModule(athenaTransportLinkAdapter, "TCP");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/listener/name=TCPListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_0");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_0");
+    AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, linkId);
+    AthenaEgressScheduler *scheduler = _egressScheduler(athenaTransportLinkAdapter, linkId);
+    assertNotNull(scheduler, "Expected a routable link to have egress queues");
+
+    PARCBitVector *linkVector = parcBitVector_Create();
+    parcBitVector_Set(linkVector, linkId);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    // A link that isn't accepting sends has the message queued rather than failed
+    athenaTransportLink_ClearEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+    PARCBitVector *resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, linkVector);
+    assertNull(resultVector, "Expected a queued message not to be reported as failed");
+    assertTrue(athenaEgressScheduler_GetQueueDepth(scheduler, AthenaEgressClass_Interest) == 1, "Expected the Interest to be queued");
+    assertTrue(athenaTransportLinkAdapter->egressQueued == 1, "Expected the adapter to count the queued message");
+
+    // A full class queue fails the send
+    athenaTransportLinkAdapter_SetEgressClass(athenaTransportLinkAdapter, "TCP_0", AthenaEgressClass_Interest, 1, 1);
+    resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, linkVector);
+    assertNotNull(resultVector, "Expected a message beyond the queue limit to fail");
+    assertTrue(parcBitVector_Get(resultVector, linkId) == 1, "Expected the link to be reported as failed");
+    parcBitVector_Release(&resultVector);
+    assertTrue(athenaEgressScheduler_GetDropCount(scheduler, AthenaEgressClass_Interest) == 1, "Expected the drop to be counted");
+
+    // Once the link is writable the queue is drained by the adapter's poll
+    athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 0);
+    assertTrue(athenaEgressScheduler_Depth(scheduler) == 0, "Expected the queue to be drained");
+    assertTrue(athenaTransportLinkAdapter->egressQueued == 0, "Expected the adapter count to be drained");
+    assertTrue(athenaEgressScheduler_GetSentCount(scheduler, AthenaEgressClass_Interest) == 1, "Expected the queued Interest sent");
+
+    // With nothing queued the message goes straight out
+    resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, linkVector);
+    assertNull(resultVector, "Expected the send to succeed");
+    assertTrue(athenaEgressScheduler_Depth(scheduler) == 0, "Expected a direct send not to be queued");
+
+    // Messages still queued when the adapter goes away are released with it
+    athenaTransportLink_ClearEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+    resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, linkVector);
+    assertNull(resultVector, "Expected a queued message not to be reported as failed");
+
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+    parcBitVector_Release(&linkVector);
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_EgressWatch)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    _LoadModule(athenaTransportLinkAdapter, "TCP");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/listener/name=TCPListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_0");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_0");
+    AthenaTransportLink *athenaTransportLink = parcArrayList_Get(athenaTransportLinkAdapter->instanceList, linkId);
+    _AthenaLinkRegistration *registration = parcHashCodeTable_Get(athenaTransportLinkAdapter->linkNameTable, "TCP_0");
+    struct pollfd *pollfd = &athenaTransportLinkAdapter->pollfdReceiveList[registration->pollfdIndex];
+
+    // Nothing queued, the poll's wait is left alone
+    int timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, -1);
+    assertTrue(timeout == -1, "Expected no timeout with nothing queued, got %d", timeout);
+
+    PARCBitVector *linkVector = parcBitVector_Create();
+    parcBitVector_Set(linkVector, linkId);
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    athenaTransportLink_ClearEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+    PARCBitVector *resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, linkVector);
+    assertNull(resultVector, "Expected a queued message not to be reported as failed");
+
+    // A TCP link sends on its event fd, the poll waits for it to become writable
+    assertTrue(athenaTransportLink_IsSendPollable(athenaTransportLink), "Expected a TCP link to be send pollable");
+    timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, -1);
+    assertTrue(timeout == -1, "Expected no timed retry for a pollable link, got %d", timeout);
+    assertTrue(pollfd->events & POLLOUT, "Expected the link's event fd to be polled for POLLOUT");
+
+    // Links that can't be polled for sends are retried, backing off while nothing is sent
+    athenaTransportLink_SetSendPollable(athenaTransportLink, false);
+    timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, -1);
+    assertTrue(timeout == EGRESS_RETRY_MIN_TIMEOUT, "Expected a timed retry, got %d", timeout);
+    assertFalse(pollfd->events & POLLOUT, "Expected the link's event fd not to be polled for POLLOUT");
+    _athenaTransportLinkAdapter_ServiceEgress(athenaTransportLinkAdapter);
+    timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, -1);
+    assertTrue(timeout == 2 * EGRESS_RETRY_MIN_TIMEOUT, "Expected the retry to back off, got %d", timeout);
+    for (int i = 0; i < 16; i++) {
+        _athenaTransportLinkAdapter_ServiceEgress(athenaTransportLinkAdapter);
+    }
+    timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, -1);
+    assertTrue(timeout == EGRESS_RETRY_MAX_TIMEOUT, "Expected the retry to be capped, got %d", timeout);
+    timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, 5);
+    assertTrue(timeout == 5, "Expected a shorter wait to be kept, got %d", timeout);
+
+    // Once the queue drains the retries start over
+    athenaTransportLink_SetEvent(athenaTransportLink, AthenaTransportLinkEvent_Send);
+    _athenaTransportLinkAdapter_ServiceEgress(athenaTransportLinkAdapter);
+    assertTrue(athenaTransportLinkAdapter->egressQueued == 0, "Expected the queue to be drained");
+    assertTrue(athenaTransportLinkAdapter->egressRetryTimeout == EGRESS_RETRY_MIN_TIMEOUT, "Expected the retry timeout to be reset");
+    timeout = _athenaTransportLinkAdapter_WatchEgress(athenaTransportLinkAdapter, -1);
+    assertTrue(timeout == -1, "Expected no timeout with nothing queued, got %d", timeout);
+
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+    parcBitVector_Release(&linkVector);
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_SetEgressClass)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    _LoadModule(athenaTransportLinkAdapter, "TCP");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/listener/name=TCPListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    // Defaults apply to links created afterwards
+    int status = athenaTransportLinkAdapter_SetEgressClass(athenaTransportLinkAdapter, NULL, AthenaEgressClass_Interest, 4, 32);
+    assertTrue(status == 0, "Expected the defaults to be set");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_0");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    AthenaEgressScheduler *scheduler =
+        _egressScheduler(athenaTransportLinkAdapter, athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_0"));
+    assertTrue(athenaEgressScheduler_GetWeight(scheduler, AthenaEgressClass_Interest) == 4, "Expected the default weight");
+    assertTrue(athenaEgressScheduler_GetQueueLimit(scheduler, AthenaEgressClass_Interest) == 32, "Expected the default queue limit");
+
+    status = athenaTransportLinkAdapter_SetEgressClass(athenaTransportLinkAdapter, "TCP_0", AthenaEgressClass_ContentObject, 2, 8);
+    assertTrue(status == 0, "Expected the link class to be set");
+    assertTrue(athenaEgressScheduler_GetWeight(scheduler, AthenaEgressClass_ContentObject) == 2, "Expected the link weight");
+
+    // Listeners have no egress queues
+    status = athenaTransportLinkAdapter_SetEgressClass(athenaTransportLinkAdapter, "TCPListener", AthenaEgressClass_Interest, 1, 1);
+    assertTrue((status == -1) && (errno == ENOENT), "Expected a listener to be rejected");
+    status = athenaTransportLinkAdapter_SetEgressClass(athenaTransportLinkAdapter, "TCP_9", AthenaEgressClass_Interest, 1, 1);
+    assertTrue((status == -1) && (errno == ENOENT), "Expected an unknown link to be rejected");
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+static bool
+_releaseInterest(void *context, const CCNxInterest *interest, const PARCBitVector *egressVector)
+{
+    int *releaseCount = (int *) context;
+    (*releaseCount)++;
+    return false;
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_ShapeInterest)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    _LoadModule(athenaTransportLinkAdapter, "TCP");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/listener/name=TCPListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    // 120Kbps has room for one 1500 byte Content Object every 100ms, Interests beyond it aren't held
+    int status = athenaTransportLinkAdapter_SetInterestShaping(athenaTransportLinkAdapter, NULL, 120000, 0);
+    assertTrue(status == 0, "Expected the defaults to be set");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:50200/name=TCP_0");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_0");
+    AthenaInterestShaper *shaper = _interestShaper(athenaTransportLinkAdapter, linkId);
+    assertNotNull(shaper, "Expected a routable link to have an Interest shaper");
+    assertTrue(athenaInterestShaper_GetBandwidth(shaper) == 120000, "Expected the default bandwidth");
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    PARCBitVector *egressVector = parcBitVector_Create();
+    parcBitVector_Set(egressVector, linkId);
+    PARCBitVector *congestedVector = athenaTransportLinkAdapter_ShapeInterest(athenaTransportLinkAdapter, ccnxMetaMessage, egressVector);
+    assertNull(congestedVector, "Expected the first Interest to be within the link's capacity");
+    assertTrue(parcBitVector_Get(egressVector, linkId) == 1, "Expected the Interest to be sent now");
+
+    congestedVector = athenaTransportLinkAdapter_ShapeInterest(athenaTransportLinkAdapter, ccnxMetaMessage, egressVector);
+    assertNotNull(congestedVector, "Expected the second Interest to be refused");
+    assertTrue(parcBitVector_Get(congestedVector, linkId) == 1, "Expected the link to be reported as congested");
+    assertTrue(parcBitVector_NumberOfBitsSet(egressVector) == 0, "Expected the link removed from the egress vector");
+    parcBitVector_Release(&congestedVector);
+
+    // With a delay allowed the Interest beyond the link's capacity is held, and released with the adapter
+    status = athenaTransportLinkAdapter_SetInterestShaping(athenaTransportLinkAdapter, "TCP_0", 120000, 1000);
+    assertTrue(status == 0, "Expected the link shaping to be set");
+    for (int i = 0; i < 2; i++) {
+        parcBitVector_Set(egressVector, linkId);
+        congestedVector = athenaTransportLinkAdapter_ShapeInterest(athenaTransportLinkAdapter, ccnxMetaMessage, egressVector);
+        assertNull(congestedVector, "Expected Interest %d to be accepted", i);
+    }
+    assertTrue(parcBitVector_NumberOfBitsSet(egressVector) == 0, "Expected the held Interest removed from the egress vector");
+    assertTrue(athenaTransportLinkAdapter->interestsHeld == 1, "Expected the adapter to count the held Interest");
+
+    // A held Interest that is no longer pending is dropped when the shaper releases it
+    int releaseCount = 0;
+    athenaTransportLinkAdapter_SetReleaseInterestCallback(athenaTransportLinkAdapter, _releaseInterest, &releaseCount);
+    for (int i = 0; (i < 20) && (athenaTransportLinkAdapter->interestsHeld > 0); i++) {
+        athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 50);
+    }
+    assertTrue(athenaTransportLinkAdapter->interestsHeld == 0, "Expected the held Interest to be released");
+    assertTrue(releaseCount == 1, "Expected the release callback to be consulted once, was %d", releaseCount);
+    assertTrue(athenaTransportLinkAdapter->stats.messageSend_InterestNotPending == 1, "Expected the Interest to be dropped");
+
+    status = athenaTransportLinkAdapter_SetInterestShaping(athenaTransportLinkAdapter, "TCPListener", 120000, 0);
+    assertTrue((status == -1) && (errno == ENOENT), "Expected a listener to be rejected");
+
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+    parcBitVector_Release(&egressVector);
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
 LONGBOW_TEST_CASE(Global, athenaTransportLinkAdapter_SetLogLevel)
 {
     PARCURI *connectionURI;
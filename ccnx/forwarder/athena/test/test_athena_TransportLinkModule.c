@@ -93,6 +93,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModule_SetAddRemoveLinkCallback);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModule_CreateMessageBuffer);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModule_GetMessageIoVector);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModule_PrepareMessageBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModule_SetMessageHopLimit);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -276,6 +278,72 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkModule_GetMessageIoVector)
     ccnxInterest_Release(&interest);
 }
 
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModule_PrepareMessageBuffer)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/local/forwarder/Module");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    assertTrue(athenaTransportLinkModule_PrepareMessageBuffer(interest), "Expected a wire format buffer to be created");
+    assertFalse(athenaTransportLinkModule_PrepareMessageBuffer(interest), "Expected the existing wire format buffer to be kept");
+
+    // Every link is given the same buffer, with the same contents as the encoding
+    PARCBuffer *buffer = athenaTransportLinkModule_CreateMessageBuffer(interest);
+    PARCBuffer *sharedBuffer = athenaTransportLinkModule_CreateMessageBuffer(interest);
+    assertTrue(buffer == sharedBuffer, "Expected the shared wire format buffer");
+    CCNxCodecNetworkBufferIoVec *iovec = athenaTransportLinkModule_GetMessageIoVector(interest);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(iovec) == parcBuffer_Remaining(buffer),
+               "Wire format buffer length differs from the encoding");
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    parcBuffer_Release(&sharedBuffer);
+    parcBuffer_Release(&buffer);
+    ccnxInterest_Release(&interest);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModule_SetMessageHopLimit)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/local/forwarder/Module");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    ccnxInterest_SetHopLimit(interest, 5);
+
+    // Receive a copy of the encoded Interest
+    PARCBuffer *encoding = athenaTransportLinkModule_CreateMessageBuffer(interest);
+    PARCBuffer *wireFormatBuffer = parcBuffer_Copy(encoding);
+    parcBuffer_Release(&encoding);
+    CCNxMetaMessage *received = athenaTransportLinkModule_CreateMessageFromBuffer(wireFormatBuffer);
+    assertNotNull(received, "Expected the encoded Interest to be accepted");
+    assertTrue(athenaTransportLinkModule_DecodeMessage(received), "Expected the received Interest to decode");
+    assertTrue(ccnxInterest_GetHopLimit(received) == 5, "Expected the decoded hop limit");
+    assertTrue(athenaTransportLinkModule_DecodeMessage(received), "Expected a decoded Interest to be left as it is");
+    assertTrue(ccnxInterest_GetHopLimit(received) == 5, "Expected the decoded hop limit to be unchanged");
+
+    // Cache an io vector copy of the wire format as a link sending it would
+    CCNxCodecNetworkBufferIoVec *iovec = athenaTransportLinkModule_GetMessageIoVector(received);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+
+    athenaTransportLinkModule_SetMessageHopLimit(received, 4);
+    assertTrue(ccnxInterest_GetHopLimit(received) == 4, "Expected the dictionary hop limit to be set");
+
+    AthenaPacketDescriptor descriptor;
+    assertTrue(athenaPacketDescriptor_Parse(&descriptor, wireFormatBuffer), "Expected the patched buffer to parse");
+    assertTrue(descriptor.hopLimit == 4, "Expected the wire format hop limit to be patched, got %d", descriptor.hopLimit);
+
+    // Links are given the received bytes, not a new encoding
+    PARCBuffer *sendBuffer = athenaTransportLinkModule_CreateMessageBuffer(received);
+    assertTrue(sendBuffer == wireFormatBuffer, "Expected the received wire format buffer to be sent");
+    parcBuffer_Release(&sendBuffer);
+
+    iovec = athenaTransportLinkModule_GetMessageIoVector(received);
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    assertTrue(((uint8_t *) array[0].iov_base)[descriptor.hopLimitOffset] == 4, "Expected the cached io vector to be patched");
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+
+    ccnxMetaMessage_Release(&received);
+    parcBuffer_Release(&wireFormatBuffer);
+    ccnxInterest_Release(&interest);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
 }
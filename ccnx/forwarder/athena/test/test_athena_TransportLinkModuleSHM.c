@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include "../athena_TransportLinkModuleSHM.c"
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <ccnx/forwarder/athena/athena.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkAdapter.h>
+
+LONGBOW_TEST_RUNNER(athena_TransportLinkModuleSHM)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(athena_TransportLinkModuleSHM)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_TransportLinkModuleSHM)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleSHM_OpenClose);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleSHM_SendReceive);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+void
+_removeLink(void *context, PARCBitVector *parcBitVector)
+{
+    assertNull(context, "_removeLink called with a non null argument");
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleSHM_OpenClose)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    connectionURI = parcURI_Parse("shm:///name=SHM_1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect a missing channel");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/Listene/name=SHM_1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect bad argument");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/Listener/name=");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect bad name specification");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/name=SHM_1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open connected without a listener");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/Listener/name=SHMListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/Listener/name=SHMListener2");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open opened a second listener on a channel");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/name=SHM_1/local=maybe");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect invalid local flag");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/name=SHM_1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "SHM_1");
+    assertFalse(athenaTransportLinkAdapter_IsNotLocal(athenaTransportLinkAdapter, linkId), "Shared memory link not local");
+
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SHM_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SHMListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    // The channel can be listened on again once it's been closed
+    connectionURI = parcURI_Parse("shm://athenaTest/Listener/name=SHMListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SHMListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleSHM_SendReceive)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    connectionURI = parcURI_Parse("shm://athenaTest/Listener/name=SHMListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("shm://athenaTest/name=SHM_1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    // Accept the connection
+    athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 0);
+    CCNxMetaMessage *ccnxMetaMessage;
+    PARCBitVector *resultVector;
+    ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 0);
+    assertNull(ccnxMetaMessage, "Unexpected message while accepting the connection");
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+
+    PARCBitVector *sendVector = parcBitVector_Create();
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "SHM_1");
+    parcBitVector_Set(sendVector, linkId);
+
+    // Send more than one message, each is read out of the ring on its own
+    for (int i = 0; i < 3; i++) {
+        resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, sendVector);
+        assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    }
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+    parcBitVector_Release(&sendVector);
+
+    for (int i = 0; i < 3; i++) {
+        ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, -1);
+        assertNotNull(ccnxMetaMessage, "athenaTransportLinkAdapter_Receive failed to provide message %d", i);
+        assertTrue(parcBitVector_NumberOfBitsSet(resultVector) == 1, "athenaTransportLinkAdapter_Receive return message with more than one ingress link");
+        assertFalse(parcBitVector_Get(resultVector, linkId) == 1, "Message was received on the link it was sent on");
+        assertTrue(ccnxMetaMessage_IsInterest(ccnxMetaMessage), "Expected to receive an interest");
+        parcBitVector_Release(&resultVector);
+        ccnxMetaMessage_Release(&ccnxMetaMessage);
+    }
+
+    ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 0);
+    assertNull(ccnxMetaMessage, "Received more messages than were sent");
+
+    // Closing one end takes down the other
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SHM_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 0);
+    assertNull(ccnxMetaMessage, "athenaTransportLinkAdapter_Receive should have failed");
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SHMListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _ringPutGet);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Local, _ringPutGet)
+{
+    size_t ringSize = 256;
+    _SHMRing *ring = parcMemory_AllocateAndClear(sizeof(_SHMRing) + ringSize);
+    assertNotNull(ring, "parcMemory_AllocateAndClear failed");
+
+    uint8_t message[100];
+    bool wakeup;
+    bool corrupt;
+
+    PARCBuffer *buffer = _ringGet(ring, ringSize, &corrupt);
+    assertNull(buffer, "Message read from an empty ring");
+    assertFalse(corrupt, "Empty ring reported as corrupt");
+
+    // Messages of varying size, wrapping around the end of the ring many times
+    for (int i = 0; i < 1000; i++) {
+        size_t length = 1 + ((i * 37) % sizeof(message));
+        memset(message, i, length);
+
+        bool queued = _ringPut(ring, ringSize, message, length, &wakeup);
+        assertTrue(queued, "_ringPut failed on an empty ring");
+        assertTrue(wakeup, "Consumer wasn't woken for a message on an empty ring");
+
+        // A second copy may not fit, depending on where the first one wrapped
+        queued = _ringPut(ring, ringSize, message, length, &wakeup);
+        assertFalse(queued && wakeup, "Consumer was woken for a message on a non-empty ring");
+
+        for (int copy = 0; copy < (queued ? 2 : 1); copy++) {
+            buffer = _ringGet(ring, ringSize, &corrupt);
+            assertNotNull(buffer, "_ringGet failed to return message %d", i);
+            assertTrue(parcBuffer_Remaining(buffer) == length, "Expected a %zu byte message, got %zu", length, parcBuffer_Remaining(buffer));
+            assertTrue(parcBuffer_GetUint8(buffer) == (uint8_t) i, "Message contents were not preserved");
+            parcBuffer_Release(&buffer);
+        }
+        assertTrue(_ringIsEmpty(ring), "Ring not empty after reading all messages");
+    }
+
+    // A full ring refuses messages rather than overwriting them
+    size_t queuedCount = 0;
+    while (_ringPut(ring, ringSize, message, 32, &wakeup)) {
+        queuedCount++;
+    }
+    size_t capacity = ringSize / _recordLength(32);
+    assertTrue((queuedCount == capacity) || (queuedCount == capacity - 1),
+               "Expected %zu messages to fit, less one if they wrapped, got %zu", capacity, queuedCount);
+
+    // A length that runs past the data written is rejected
+    ring->head = ring->tail;
+    *(uint32_t *) &ring->data[ring->tail & (ringSize - 1)] = 64;
+    ring->tail += _recordLength(8);
+    buffer = _ringGet(ring, ringSize, &corrupt);
+    assertNull(buffer, "_ringGet returned a corrupt message");
+    assertTrue(corrupt, "_ringGet failed to detect a corrupt message");
+
+    parcMemory_Deallocate(&ring);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(athena_TransportLinkModuleSHM);
+    exit(longBowMain(argc, argv, testRunner, NULL));
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include "../athena_TransportLinkModuleSIM.c"
+#include <LongBow/unit-test.h>
+#include <stdio.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <ccnx/forwarder/athena/athena.h>
+#include <ccnx/forwarder/athena/athena_TransportLinkAdapter.h>
+
+LONGBOW_TEST_RUNNER(athena_TransportLinkModuleSIM)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(athena_TransportLinkModuleSIM)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(athena_TransportLinkModuleSIM)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleSIM_OpenClose);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleSIM_SendReceive);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+void
+_removeLink(void *context, PARCBitVector *parcBitVector)
+{
+    assertNull(context, "_removeLink called with a non null argument");
+}
+
+static const char *
+_openLink(AthenaTransportLinkAdapter *athenaTransportLinkAdapter, const char *linkSpecificationURI)
+{
+    PARCURI *connectionURI = parcURI_Parse(linkSpecificationURI);
+    const char *result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    parcURI_Release(&connectionURI);
+    return result;
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleSIM_OpenClose)
+{
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    athenaTransportLinkAdapter_SetLogLevel(athenaTransportLinkAdapter, PARCLogLevel_Debug);
+
+    const char *result = _openLink(athenaTransportLinkAdapter, "sim:///name=SIM_0");
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect a missing channel");
+
+    result = _openLink(athenaTransportLinkAdapter, "sim://channel/name=");
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect bad name argument");
+
+    result = _openLink(athenaTransportLinkAdapter, "sim://channel/local=");
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect bad local argument");
+
+    result = _openLink(athenaTransportLinkAdapter, "sim://channel/name=SIM_0/local=false");
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+
+    result = _openLink(athenaTransportLinkAdapter, "sim://channel/name=SIM_1/local=true");
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed to open the second end (%s)", strerror(errno));
+
+    result = _openLink(athenaTransportLinkAdapter, "sim://channel/name=SIM_2");
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open opened a third end of a channel");
+
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SIM_0");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    // The closed end can be reopened
+    result = _openLink(athenaTransportLinkAdapter, "sim://channel/name=SIM_2");
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed to reopen a closed end (%s)", strerror(errno));
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SIM_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "SIM_2");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleSIM_SendReceive)
+{
+    // Each end of the channel is on its own adapter, as it would be on two simulated forwarders
+    AthenaTransportLinkAdapter *adapter0 = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    AthenaTransportLinkAdapter *adapter1 = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+
+    const char *result = _openLink(adapter0, "sim://pair/name=SIM_0");
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    result = _openLink(adapter1, "sim://pair/name=SIM_1");
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+
+    PARCBitVector *sendVector = parcBitVector_Create();
+    parcBitVector_Set(sendVector, athenaTransportLinkAdapter_LinkNameToId(adapter0, "SIM_0"));
+    PARCBitVector *resultVector = athenaTransportLinkAdapter_Send(adapter0, ccnxMetaMessage, sendVector);
+    assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    parcBitVector_Release(&sendVector);
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+
+    // Nothing comes back on the sending end
+    CCNxMetaMessage *received = athenaTransportLinkAdapter_Receive(adapter0, &resultVector, 0);
+    assertNull(received, "athenaTransportLinkAdapter_Receive received a message on the sending end");
+
+    received = athenaTransportLinkAdapter_Receive(adapter1, &resultVector, 0);
+    assertNotNull(received, "athenaTransportLinkAdapter_Receive failed to receive the message on the peer");
+    assertTrue(ccnxMetaMessage_IsInterest(received), "Expected to receive an interest");
+    assertTrue(parcBitVector_Get(resultVector, athenaTransportLinkAdapter_LinkNameToId(adapter1, "SIM_1")) == 1,
+               "Message received on the wrong link");
+    parcBitVector_Release(&resultVector);
+    ccnxMetaMessage_Release(&received);
+
+    received = athenaTransportLinkAdapter_Receive(adapter1, &resultVector, 0);
+    assertNull(received, "athenaTransportLinkAdapter_Receive received extraneous message");
+
+    // With the peer gone, sends fail
+    int closeResult = athenaTransportLinkAdapter_CloseByName(adapter1, "SIM_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    name = ccnxName_CreateFromCString("lci:/foo/bar");
+    ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+    sendVector = parcBitVector_Create();
+    parcBitVector_Set(sendVector, athenaTransportLinkAdapter_LinkNameToId(adapter0, "SIM_0"));
+    resultVector = athenaTransportLinkAdapter_Send(adapter0, ccnxMetaMessage, sendVector);
+    assertNotNull(resultVector, "athenaTransportLinkAdapter_Send succeeded without a peer");
+    parcBitVector_Release(&resultVector);
+    parcBitVector_Release(&sendVector);
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(adapter0, "SIM_0");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&adapter0);
+    athenaTransportLinkAdapter_Destroy(&adapter1);
+}
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _SIMSend_TransmitCallback);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+typedef struct {
+    AthenaSIMChannel *channel;
+    int destination;
+    PARCBuffer *wireFormatBuffer;
+} _TransmitRecord;
+
+static void
+_transmit(void *context, AthenaSIMChannel *channel, int destination, PARCBuffer *wireFormatBuffer)
+{
+    _TransmitRecord *record = (_TransmitRecord *) context;
+    record->channel = channel;
+    record->destination = destination;
+    record->wireFormatBuffer = parcBuffer_Acquire(wireFormatBuffer);
+}
+
+static AthenaTransportLink *
+_open(AthenaTransportLinkModule *athenaTransportLinkModule, const char *linkSpecificationURI)
+{
+    PARCURI *connectionURI = parcURI_Parse(linkSpecificationURI);
+    AthenaTransportLink *athenaTransportLink = _SIMOpen(athenaTransportLinkModule, connectionURI);
+    parcURI_Release(&connectionURI);
+    return athenaTransportLink;
+}
+
+LONGBOW_TEST_CASE(Local, _SIMSend_TransmitCallback)
+{
+    // The adapter may load the shared library copy of the module, so drive this copy directly
+    PARCArrayList *moduleList = athenaTransportLinkModuleSIM_Init();
+    AthenaTransportLinkModule *athenaTransportLinkModule = parcArrayList_Get(moduleList, 0);
+
+    _TransmitRecord record = { NULL, -1, NULL };
+    athenaTransportLinkModuleSIM_SetTransmitCallback("simulated", _transmit, &record);
+
+    AthenaTransportLink *end0 = _open(athenaTransportLinkModule, "sim://simulated/name=SIM_0");
+    assertNotNull(end0, "_SIMOpen failed (%s)", strerror(errno));
+    AthenaTransportLink *end1 = _open(athenaTransportLinkModule, "sim://simulated/name=SIM_1");
+    assertNotNull(end1, "_SIMOpen failed (%s)", strerror(errno));
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+
+    int sendResult = athenaTransportLink_Send(end1, ccnxMetaMessage);
+    assertTrue(sendResult == 0, "athenaTransportLink_Send failed");
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+
+    // The message went to the callback instead of the peer
+    assertNotNull(record.wireFormatBuffer, "Transmit callback was not called");
+    assertTrue(record.destination == 0, "Expected the message to be addressed to end 0, got %d", record.destination);
+    CCNxMetaMessage *received = athenaTransportLink_Receive(end0);
+    assertNull(received, "Message was delivered without the transmit callback");
+
+    bool delivered = athenaTransportLinkModuleSIM_Deliver(record.channel, record.destination, record.wireFormatBuffer);
+    assertTrue(delivered, "athenaTransportLinkModuleSIM_Deliver failed");
+    parcBuffer_Release(&record.wireFormatBuffer);
+
+    assertTrue(athenaTransportLink_GetEvent(end0) & AthenaTransportLinkEvent_Receive, "Delivery did not flag a receive event");
+    received = athenaTransportLink_Receive(end0);
+    assertNotNull(received, "Delivered message was not received");
+    assertTrue(ccnxMetaMessage_IsInterest(received), "Expected to receive an interest");
+    ccnxMetaMessage_Release(&received);
+
+    // Delivery to a closed end is dropped
+    AthenaSIMChannel *channel = record.channel;
+    athenaTransportLink_Close(end0);
+    PARCBuffer *buffer = parcBuffer_Allocate(1);
+    delivered = athenaTransportLinkModuleSIM_Deliver(channel, 0, buffer);
+    assertFalse(delivered, "athenaTransportLinkModuleSIM_Deliver delivered to a closed end");
+    parcBuffer_Release(&buffer);
+
+    athenaTransportLink_Close(end1);
+    assertNull(_channelList, "Channel was not released after both ends were closed");
+
+    athenaTransportLinkModule_Destroy(&athenaTransportLinkModule);
+    parcArrayList_Destroy(&moduleList);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(athena_TransportLinkModuleSIM);
+    exit(longBowMain(argc, argv, testRunner, NULL));
+}
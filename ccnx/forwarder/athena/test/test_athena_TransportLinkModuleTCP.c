@@ -89,6 +89,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleTCP_SendReceive);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleTCP6_SendReceive);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleTCP_Local);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleTCP_IOUring);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -375,6 +376,83 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleTCP_Local)
     athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
 }
 
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleTCP_IOUring)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:40000/Listener/name=TCPListener/io=epoll");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect an unknown io engine");
+    parcURI_Release(&connectionURI);
+
+    // If io_uring isn't available the links fall back to poll, and the exchange is the same
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:40000/Listener/name=TCPListener/io=uring");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("tcp://127.0.0.1:40000/name=TCP_1/io=uring");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 0);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+
+    // Several messages are queued before the ring is submitted, and framed again by the receiver
+    PARCBitVector *sendVector = parcBitVector_Create();
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "TCP_1");
+    parcBitVector_Set(sendVector, linkId);
+
+    int sendCount = 3;
+    PARCBitVector *resultVector;
+    for (int i = 0; i < sendCount; i++) {
+        resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, sendVector);
+        assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    }
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+    parcBitVector_Release(&sendVector);
+
+    int receiveCount = 0;
+    int acceptedLinkId = -1;
+    for (int attempts = 0; (attempts < 100) && (receiveCount < sendCount); attempts++) {
+        ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 10);
+        if (ccnxMetaMessage) {
+            assertTrue(parcBitVector_NumberOfBitsSet(resultVector) == 1, "athenaTransportLinkAdapter_Receive return message with more than one ingress link");
+            acceptedLinkId = parcBitVector_NextBitSet(resultVector, 0);
+            assertTrue(acceptedLinkId != linkId, "Message was received on the link it was sent on");
+            parcBitVector_Release(&resultVector);
+            ccnxMetaMessage_Release(&ccnxMetaMessage);
+            receiveCount++;
+        }
+    }
+    assertTrue(receiveCount == sendCount, "Expected %d messages, received %d", sendCount, receiveCount);
+
+    // Closing the connection is seen by the accepted link
+    const char *acceptedLinkName = athenaTransportLinkAdapter_LinkIdToName(athenaTransportLinkAdapter, acceptedLinkId);
+    assertNotNull(acceptedLinkName, "Accepted link was not created");
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "TCP_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    for (int attempts = 0; (attempts < 100) && athenaTransportLinkAdapter_LinkIdToName(athenaTransportLinkAdapter, acceptedLinkId); attempts++) {
+        ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 10);
+        assertNull(ccnxMetaMessage, "Unexpected message received");
+    }
+    assertNull(athenaTransportLinkAdapter_LinkIdToName(athenaTransportLinkAdapter, acceptedLinkId), "Accepted link was not closed");
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "TCPListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
 }
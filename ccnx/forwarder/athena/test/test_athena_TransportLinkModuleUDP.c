@@ -93,6 +93,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleUDP_MTU);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleUDP_P2P);
     LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleUDP_Local);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleUDP_ListenerSockets);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleUDP_IdlePeers);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleUDP_IOUring);
+    LONGBOW_RUN_TEST_CASE(Global, athenaTransportLinkModuleUDP_SegmentationOffload);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -750,8 +754,331 @@ LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleUDP_Local)
     athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
 }
 
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleUDP_ListenerSockets)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    athenaTransportLinkAdapter_SetLogLevel(athenaTransportLinkAdapter, PARCLogLevel_Debug);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/sockets=0");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect an improper socket count");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/name=UDP_1/sockets=4");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open accepted a socket count for a connection");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/sockets=4");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    // Each connection has its own port, and may be steered to a different listener socket
+    const char *linkNames[] = { "UDP_1", "UDP_2", "UDP_3" };
+    size_t linkCount = sizeof(linkNames) / sizeof(linkNames[0]);
+    PARCBitVector *sendVector = parcBitVector_Create();
+    for (int i = 0; i < linkCount; i++) {
+        char linkSpecificationURI[MAXPATHLEN];
+        sprintf(linkSpecificationURI, "udp://127.0.0.1:40000/name=%s", linkNames[i]);
+        connectionURI = parcURI_Parse(linkSpecificationURI);
+        result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+        assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+        parcURI_Release(&connectionURI);
+        parcBitVector_Set(sendVector, athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, linkNames[i]));
+    }
+
+    athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 0);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+
+    PARCBitVector *resultVector;
+    resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, sendVector);
+    assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+
+    // Messages are received on worker threads, so allow for them to be handed off
+    PARCBitVector *ingressVector = parcBitVector_Create();
+    for (int attempts = 0; (attempts < 100) && (parcBitVector_NumberOfBitsSet(ingressVector) < linkCount); attempts++) {
+        ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 10);
+        if (ccnxMetaMessage) {
+            assertTrue(parcBitVector_NumberOfBitsSet(resultVector) == 1, "athenaTransportLinkAdapter_Receive return message with more than one ingress link");
+            parcBitVector_SetVector(ingressVector, resultVector);
+            parcBitVector_Release(&resultVector);
+            ccnxMetaMessage_Release(&ccnxMetaMessage);
+        }
+    }
+    assertTrue(parcBitVector_NumberOfBitsSet(ingressVector) == linkCount,
+               "Expected a message from each of %zu peers, received %u", linkCount, parcBitVector_NumberOfBitsSet(ingressVector));
+    assertFalse(parcBitVector_Contains(ingressVector, sendVector), "Messages were received on the links they were sent on");
+    parcBitVector_Release(&ingressVector);
+    parcBitVector_Release(&sendVector);
+
+    // Closing the listener stops its receive workers
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDPListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    for (int i = 0; i < linkCount; i++) {
+        closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, linkNames[i]);
+        assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+    }
+
+    // The port is released with the last socket of the group
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDPListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleUDP_IdlePeers)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    athenaTransportLinkAdapter_SetLogLevel(athenaTransportLinkAdapter, PARCLogLevel_Debug);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/idle=");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect an improper idle timeout");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/name=UDP_1/idle=1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open accepted an idle timeout for a connection");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/idle=1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/name=UDP_1");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 0);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+
+    PARCBitVector *sendVector = parcBitVector_Create();
+    parcBitVector_Set(sendVector, athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "UDP_1"));
+
+    PARCBitVector *resultVector;
+    resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, sendVector);
+    assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+    parcBitVector_Release(&sendVector);
+
+    usleep(1000);
+
+    ccnxMetaMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 0);
+    assertNotNull(ccnxMetaMessage, "athenaTransportLinkAdapter_Receive failed to provide message");
+    int peerLinkId = parcBitVector_NextBitSet(resultVector, 0);
+    assertNotNull(athenaTransportLinkAdapter_LinkIdToName(athenaTransportLinkAdapter, peerLinkId), "Peer link was not created");
+    parcBitVector_Release(&resultVector);
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+
+    // Nothing more is sent, so the peer's link is closed within two idle timeouts
+    for (int i = 0; (i < 30) && athenaTransportLinkAdapter_LinkIdToName(athenaTransportLinkAdapter, peerLinkId); i++) {
+        athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 100);
+    }
+    assertNull(athenaTransportLinkAdapter_LinkIdToName(athenaTransportLinkAdapter, peerLinkId), "Idle peer link was not closed");
+
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDPListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDP_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleUDP_IOUring)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    athenaTransportLinkAdapter_SetLogLevel(athenaTransportLinkAdapter, PARCLogLevel_Debug);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/io=epoll");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect an unknown io engine");
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/sockets=4/io=uring");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open accepted io_uring with receive workers");
+    parcURI_Release(&connectionURI);
+
+    // If io_uring isn't available the links fall back to poll, and the exchange is the same
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/io=uring");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/name=UDP_1/io=uring");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+    parcURI_Release(&connectionURI);
+
+    athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 0);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+    CCNxMetaMessage *ccnxMetaMessage = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+    athena_EncodeMessage(ccnxMetaMessage);
+
+    PARCBitVector *sendVector = parcBitVector_Create();
+    int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "UDP_1");
+    parcBitVector_Set(sendVector, linkId);
+
+    PARCBitVector *resultVector;
+    resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, sendVector);
+    assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    parcBitVector_Release(&sendVector);
+
+    // Sends are queued on the ring until the module is polled
+    CCNxMetaMessage *receivedMessage = NULL;
+    for (int attempts = 0; (attempts < 100) && (receivedMessage == NULL); attempts++) {
+        receivedMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 10);
+    }
+    assertNotNull(receivedMessage, "athenaTransportLinkAdapter_Receive failed to provide message");
+    int peerLinkId = parcBitVector_NextBitSet(resultVector, 0);
+    assertTrue(peerLinkId != linkId, "Message was received on the link it was sent on");
+    parcBitVector_Release(&resultVector);
+    ccnxMetaMessage_Release(&receivedMessage);
+
+    // Reply on the link the listener created for its peer, which sends on the listener's ring
+    sendVector = parcBitVector_Create();
+    parcBitVector_Set(sendVector, peerLinkId);
+    resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, ccnxMetaMessage, sendVector);
+    assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+    parcBitVector_Release(&sendVector);
+    ccnxMetaMessage_Release(&ccnxMetaMessage);
+
+    for (int attempts = 0; (attempts < 100) && (receivedMessage == NULL); attempts++) {
+        receivedMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 10);
+    }
+    assertNotNull(receivedMessage, "athenaTransportLinkAdapter_Receive failed to provide message");
+    assertTrue(parcBitVector_NextBitSet(resultVector, 0) == linkId, "Reply was not received on the connection");
+    parcBitVector_Release(&resultVector);
+    ccnxMetaMessage_Release(&receivedMessage);
+
+    int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDPListener");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDP_1");
+    assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
+LONGBOW_TEST_CASE(Global, athenaTransportLinkModuleUDP_SegmentationOffload)
+{
+    PARCURI *connectionURI;
+    const char *result;
+    size_t mtu = 1500;
+    char linkSpecificationURI[MAXPATHLEN];
+    const char *offload[] = { "true", "false" };
+
+    AthenaTransportLinkAdapter *athenaTransportLinkAdapter = athenaTransportLinkAdapter_Create(_removeLink, NULL);
+    assertNotNull(athenaTransportLinkAdapter, "athenaTransportLinkAdapter_Create returned NULL");
+
+    connectionURI = parcURI_Parse("udp://127.0.0.1:40000/Listener/name=UDPListener/offload=maybe");
+    result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+    assertTrue(result == NULL, "athenaTransportLinkAdapter_Open failed to detect an improper offload specification");
+    parcURI_Release(&connectionURI);
+
+    // Trains of fragments arrive the same whether or not they were segmented and coalesced by the kernel.
+    // The links the listener creates hold its socket open, so each pass uses its own port.
+    for (int i = 0; i < sizeof(offload) / sizeof(offload[0]); i++) {
+        sprintf(linkSpecificationURI, "udp://127.0.0.1:%d/Listener/name=UDPListener/mtu=%zu/fragmenter=BEFS/offload=%s",
+                40000 + i, mtu, offload[i]);
+        connectionURI = parcURI_Parse(linkSpecificationURI);
+        result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+        assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+        parcURI_Release(&connectionURI);
+
+        sprintf(linkSpecificationURI, "udp://127.0.0.1:%d/name=UDP_1/mtu=%zu/fragmenter=BEFS/offload=%s",
+                40000 + i, mtu, offload[i]);
+        connectionURI = parcURI_Parse(linkSpecificationURI);
+        result = athenaTransportLinkAdapter_Open(athenaTransportLinkAdapter, connectionURI);
+        assertTrue(result != NULL, "athenaTransportLinkAdapter_Open failed (%s)", strerror(errno));
+        parcURI_Release(&connectionURI);
+
+        athenaTransportLinkAdapter_Poll(athenaTransportLinkAdapter, 0);
+
+        CCNxName *name = ccnxName_CreateFromCString("lci:/foo/bar");
+        CCNxMetaMessage *sendMessage = ccnxInterest_CreateSimple(name);
+        ccnxName_Release(&name);
+
+        size_t largePayloadSize = 32 * 1024;
+        char largePayload[largePayloadSize];
+        memset(largePayload, 0, largePayloadSize);
+        PARCBuffer *payload = parcBuffer_Wrap((void *)largePayload, largePayloadSize, 0, largePayloadSize);
+        ccnxInterest_SetPayload(sendMessage, payload);
+        parcBuffer_Release(&payload);
+        athena_EncodeMessage(sendMessage);
+
+        PARCBitVector *sendVector = parcBitVector_Create();
+        int linkId = athenaTransportLinkAdapter_LinkNameToId(athenaTransportLinkAdapter, "UDP_1");
+        parcBitVector_Set(sendVector, linkId);
+
+        // Two messages back to back, which may be read together
+        PARCBitVector *resultVector;
+        resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, sendMessage, sendVector);
+        assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+        resultVector = athenaTransportLinkAdapter_Send(athenaTransportLinkAdapter, sendMessage, sendVector);
+        assertNull(resultVector, "athenaTransportLinkAdapter_Send failed");
+        parcBitVector_Release(&sendVector);
+        ccnxMetaMessage_Release(&sendMessage);
+
+        for (int received = 0; received < 2; received++) {
+            CCNxMetaMessage *receivedMessage = NULL;
+            for (int attempts = 0; (attempts < 100) && (receivedMessage == NULL); attempts++) {
+                receivedMessage = athenaTransportLinkAdapter_Receive(athenaTransportLinkAdapter, &resultVector, 10);
+            }
+            assertNotNull(receivedMessage, "athenaTransportLinkAdapter_Receive failed to reassemble message %d (offload=%s)",
+                          received, offload[i]);
+            assertTrue(parcBitVector_NextBitSet(resultVector, 0) != linkId, "Message was received on the link it was sent on");
+            parcBitVector_Release(&resultVector);
+            ccnxMetaMessage_Release(&receivedMessage);
+        }
+
+        int closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDPListener");
+        assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+
+        closeResult = athenaTransportLinkAdapter_CloseByName(athenaTransportLinkAdapter, "UDP_1");
+        assertTrue(closeResult == 0, "athenaTransportLinkAdapter_CloseByName failed (%s)", strerror(errno));
+    }
+
+    athenaTransportLinkAdapter_Destroy(&athenaTransportLinkAdapter);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
+    LONGBOW_RUN_TEST_CASE(Local, _UDPPeerTable);
+    LONGBOW_RUN_TEST_CASE(Local, _UDPReceiveWorkers_EphemeralPort);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -769,6 +1096,86 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_CASE(Local, _UDPPeerTable)
+{
+    _UDPPeerTable *peerTable = _UDPPeerTable_Create(_UDP_PEER_TABLE_INITIAL_CAPACITY);
+    size_t peerCount = 1000;
+    _UDPPeerKey keys[peerCount];
+
+    // IPv4 peers share addresses and differ by port, IPv6 peers differ only in their address
+    for (size_t i = 0; i < peerCount; i++) {
+        struct sockaddr_storage address = { 0 };
+        if (i % 2) {
+            struct sockaddr_in *address4 = (struct sockaddr_in *) &address;
+            address4->sin_family = AF_INET;
+            address4->sin_port = htons(40000 + (i % 100));
+            address4->sin_addr.s_addr = htonl(INADDR_LOOPBACK + (i / 100));
+        } else {
+            struct sockaddr_in6 *address6 = (struct sockaddr_in6 *) &address;
+            address6->sin6_family = AF_INET6;
+            address6->sin6_port = htons(40000);
+            address6->sin6_addr.s6_addr[14] = (uint8_t) (i >> 8);
+            address6->sin6_addr.s6_addr[15] = (uint8_t) i;
+        }
+        _UDPPeerKey_FromAddress(&address, &keys[i]);
+        assertNull(_UDPPeerTable_Lookup(peerTable, &keys[i]), "Found peer %zu before it was added", i);
+        _UDPPeerTable_Insert(peerTable, &keys[i], (AthenaTransportLink *) (keys + i));
+    }
+    assertTrue(peerTable->count == peerCount, "Expected %zu peers, table has %zu", peerCount, peerTable->count);
+    assertTrue(peerTable->capacity >= 2 * peerCount, "Table grew to only %zu entries", peerTable->capacity);
+
+    // Removing every other peer must leave the remainder reachable
+    for (size_t i = 0; i < peerCount; i += 2) {
+        assertTrue(_UDPPeerTable_Remove(peerTable, &keys[i]), "Failed to remove peer %zu", i);
+    }
+    for (size_t i = 0; i < peerCount; i++) {
+        _UDPPeerEntry *entry = _UDPPeerTable_Lookup(peerTable, &keys[i]);
+        if (i % 2) {
+            assertNotNull(entry, "Peer %zu lost after removals", i);
+            assertTrue(entry->athenaTransportLink == (AthenaTransportLink *) (keys + i), "Peer %zu has the wrong link", i);
+        } else {
+            assertNull(entry, "Removed peer %zu still found", i);
+        }
+    }
+    assertFalse(_UDPPeerTable_Remove(peerTable, &keys[0]), "Removed a peer twice");
+
+    for (size_t i = 1; i < peerCount; i += 2) {
+        assertTrue(_UDPPeerTable_Remove(peerTable, &keys[i]), "Failed to remove peer %zu", i);
+    }
+    assertTrue(peerTable->count == 0, "Table not empty after removing all peers");
+
+    _UDPPeerTable_Destroy(&peerTable);
+}
+
+LONGBOW_TEST_CASE(Local, _UDPReceiveWorkers_EphemeralPort)
+{
+    AthenaTransportLinkModule *athenaTransportLinkModule = athenaTransportLinkModule_Create("UDP", NULL, NULL);
+    _UDPLinkData *linkData = _UDPLinkData_Create();
+
+    struct sockaddr_in *myAddress = (struct sockaddr_in *) &linkData->link.myAddress;
+    myAddress->sin_family = AF_INET;
+    myAddress->sin_port = 0;
+    myAddress->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int result = _UDPReceiveWorkers_Create(athenaTransportLinkModule, linkData, 4, false);
+    assertTrue(result == 0, "_UDPReceiveWorkers_Create failed (%s)", strerror(errno));
+    assertTrue(myAddress->sin_port != 0, "Expected the listener to take the port the first socket was given");
+
+    // Every socket of the group is bound to the same port
+    for (size_t i = 0; i < linkData->workerCount; i++) {
+        struct sockaddr_in boundAddress;
+        socklen_t boundAddressLength = sizeof(boundAddress);
+        getsockname(linkData->workers[i].linkData->fd, (struct sockaddr *) &boundAddress, &boundAddressLength);
+        assertTrue(boundAddress.sin_port == myAddress->sin_port, "Worker %zu bound to port %u rather than %u",
+                   i, ntohs(boundAddress.sin_port), ntohs(myAddress->sin_port));
+    }
+
+    _UDPReceiveWorkers_Destroy(linkData);
+    close(linkData->fd);
+    _UDPLinkData_Destroy(&linkData);
+    athenaTransportLinkModule_Destroy(&athenaTransportLinkModule);
+}
+
 int
 main(int argc, char *argv[])
 {